@@ -155,13 +155,22 @@ void LayoutTuner::Tune() {
   // Continue till signal is not false
   while (layout_tuning_stop == false) {
     // Go over all tables
-    for (auto table : tables) {
-      // Transform
+    for (size_t table_itr = 0; table_itr < tables.size(); table_itr++) {
+      auto table = tables[table_itr];
+
+      // Transform the next few tile groups. A tile group is made immutable
+      // when it is first visited, and converted when it is visited again.
       auto tile_group_count = table->GetTileGroupCount();
-      auto tile_group_offset = rand() % tile_group_count;
+      auto &tile_group_offset = last_tile_group_offsets[table_itr];
+      for (oid_t tile_group_itr = 0;
+           tile_group_itr < tile_group_batch_size &&
+           tile_group_itr < tile_group_count;
+           tile_group_itr++) {
+        tile_group_offset = (tile_group_offset + 1) % tile_group_count;
 
-      LOG_TRACE("Transforming tile group at offset: %lu", tile_group_offset);
-      table->TransformTileGroup(tile_group_offset, theta);
+        LOG_TRACE("Transforming tile group at offset: %u", tile_group_offset);
+        table->TransformTileGroup(tile_group_offset, theta);
+      }
 
       // Update partitioning periodically
       UpdateDefaultPartition(table);
@@ -179,6 +188,23 @@ void LayoutTuner::Stop() {
   // Stop thread
   layout_tuner_thread.join();
 
+  // Report the tables whose tile groups have been transformed
+  for (auto table : tables) {
+    if (table->GetTransformedTileGroupCount() != 0) {
+      LOG_INFO("Table %s : %lu tile groups transformed, scans read %.2lfx "
+               "fewer bytes",
+               table->GetName().c_str(),
+               table->GetTransformedTileGroupCount(),
+               table->GetTransformScanBytesRatio());
+    }
+    if (table->GetCompressedTileGroupCount() != 0) {
+      LOG_INFO("Table %s : %lu tile groups compressed, encoded columns "
+               "%.2lfx smaller",
+               table->GetName().c_str(), table->GetCompressedTileGroupCount(),
+               table->GetCompressionRatio());
+    }
+  }
+
   LOG_INFO("Stopped layout tuner");
 }
 
@@ -188,6 +214,7 @@ void LayoutTuner::AddTable(storage::DataTable* table) {
     LOG_TRACE("Layout tuner adding table : %p", table);
 
     tables.push_back(table);
+    last_tile_group_offsets.push_back(0);
   }
 }
 
@@ -195,6 +222,7 @@ void LayoutTuner::ClearTables() {
   {
     std::lock_guard<std::mutex> lock(layout_tuner_mutex);
     tables.clear();
+    last_tile_group_offsets.clear();
   }
 }
 
@@ -18,6 +18,7 @@
 #include "catalog/query_metrics_catalog.h"
 #include "catalog/table_metrics_catalog.h"
 #include "catalog/index_metrics_catalog.h"
+#include "codegen/query_cache.h"
 #include "common/exception.h"
 #include "common/macros.h"
 #include "expression/date_functions.h"
@@ -491,6 +492,9 @@ ResultType Catalog::CreateIndex(oid_t database_oid, oid_t table_oid,
           index_oid, index_name, table_oid, index_type, index_constraint,
           unique_keys, key_attrs, pool_.get(), txn);
 
+      // Queries compiled before may have a better plan now
+      codegen::QueryCache::GetInstance().InvalidateTable(table_oid);
+
       LOG_TRACE("Successfully add index for table %s contains %d indexes",
                 table->GetName().c_str(), (int)table->GetValidIndexCount());
 
@@ -641,6 +645,9 @@ ResultType Catalog::DropTable(oid_t database_oid, oid_t table_oid,
     // STEP 4
     database->DropTableWithOid(table_oid);
 
+    // Compiled queries must not outlive the table they read
+    codegen::QueryCache::GetInstance().InvalidateTable(table_oid);
+
     return ResultType::SUCCESS;
   } catch (CatalogException &e) {
     LOG_TRACE("Can't find database %d! Return RESULT_FAILURE", database_oid);
@@ -682,6 +689,9 @@ ResultType Catalog::DropIndex(oid_t index_oid, concurrency::Transaction *txn) {
       // drop record in pg_index
       IndexCatalog::GetInstance()->DeleteIndex(index_oid, txn);
 
+      // Compiled queries may have been planned with the index
+      codegen::QueryCache::GetInstance().InvalidateTable(table_oid);
+
       LOG_TRACE("Successfully drop index %d for table %s", index_oid,
                 table->GetName().c_str());
 
@@ -16,7 +16,9 @@
 #include "catalog/foreign_key.h"
 #include "storage/database.h"
 #include "storage/data_table.h"
+#include "concurrency/epoch_manager_factory.h"
 #include "concurrency/transaction_manager_factory.h"
+#include "storage/tile_group.h"
 
 namespace peloton {
 namespace catalog {
@@ -38,13 +40,49 @@ void Manager::AddTileGroup(const oid_t oid,
                            std::shared_ptr<storage::TileGroup> location) {
 
   // add/update the catalog reference to the tile group
+  tile_group_ptr_locator_.Update(oid, location.get());
   tile_group_locator_.Update(oid, location);
 }
 
 void Manager::DropTileGroup(const oid_t oid) {
-  
+  auto tile_group = tile_group_locator_.Find(oid);
+
   // drop the catalog reference to the tile group
+  tile_group_ptr_locator_.Erase(oid, nullptr);
   tile_group_locator_.Erase(oid, empty_tile_group_);
+
+  if (tile_group == nullptr) {
+    return;
+  }
+
+  RetireTileGroup(std::move(tile_group));
+}
+
+void Manager::ReplaceTileGroup(const oid_t oid,
+                               std::shared_ptr<storage::TileGroup> location) {
+  auto tile_group = tile_group_locator_.Find(oid);
+
+  AddTileGroup(oid, location);
+
+  if (tile_group == nullptr) {
+    return;
+  }
+
+  RetireTileGroup(std::move(tile_group));
+}
+
+void Manager::RetireTileGroup(std::shared_ptr<storage::TileGroup> tile_group) {
+  // transactions that are running may still access the tile group through
+  // a raw pointer, keep it until they end
+  // the epoch is read under the lock, so the list stays ordered by it and
+  // only its front has to be looked at
+  auto &epoch_manager = concurrency::EpochManagerFactory::GetInstance();
+  {
+    std::lock_guard<std::mutex> lock(dropped_tile_groups_lock_);
+    dropped_tile_groups_.emplace_back(epoch_manager.GetCurrentEpochStartCid(),
+                                      std::move(tile_group));
+  }
+  ReclaimDroppedTileGroups(epoch_manager.GetMaxCommittedCid());
 }
 
 std::shared_ptr<storage::TileGroup> Manager::GetTileGroup(const oid_t oid) {
@@ -55,10 +93,35 @@ std::shared_ptr<storage::TileGroup> Manager::GetTileGroup(const oid_t oid) {
   return location;
 }
 
+storage::TileGroupHeader *Manager::GetTileGroupHeader(const oid_t oid) const {
+  auto tile_group = GetTileGroupPtr(oid);
+  if (tile_group == nullptr) {
+    return nullptr;
+  }
+  return tile_group->GetHeader();
+}
+
+void Manager::ReclaimDroppedTileGroups(const cid_t &max_committed_cid) {
+  std::vector<std::shared_ptr<storage::TileGroup>> reclaimed;
+  {
+    std::lock_guard<std::mutex> lock(dropped_tile_groups_lock_);
+    while (dropped_tile_groups_.empty() == false &&
+           dropped_tile_groups_.front().first < max_committed_cid) {
+      reclaimed.push_back(std::move(dropped_tile_groups_.front().second));
+      dropped_tile_groups_.pop_front();
+    }
+  }
+  // the tile groups are freed here, outside of the lock
+}
+
 // used for logging test
 void Manager::ClearTileGroup() {
 
+  tile_group_ptr_locator_.Clear(nullptr);
   tile_group_locator_.Clear(empty_tile_group_);
+
+  std::lock_guard<std::mutex> lock(dropped_tile_groups_lock_);
+  dropped_tile_groups_.clear();
 }
 
 
@@ -172,6 +172,69 @@ void Aggregation::CreateInitialValues(
   }
 }
 
+//===----------------------------------------------------------------------===//
+// Combine the current value of a SUM, MIN or MAX aggregate with another value,
+// either the next input value or the partial aggregate of another worker.
+// NULLs are ignored: if either side is NULL, the other side is taken as is, and
+// the values are only combined if neither of them is NULL. The result is NULL
+// only if both sides are.
+//===----------------------------------------------------------------------===//
+codegen::Value Aggregation::CombineValues(CodeGen &codegen,
+                                          ExpressionType aggregate_type,
+                                          const codegen::Value &curr,
+                                          const codegen::Value &other) const {
+  // Input values may come without their null bit
+  llvm::Value *curr_null = curr.GetNull() != nullptr
+                               ? curr.GetNull()
+                               : codegen::Value::SetNullValue(codegen, curr);
+  llvm::Value *other_null = other.GetNull() != nullptr
+                                ? other.GetNull()
+                                : codegen::Value::SetNullValue(codegen, other);
+
+  codegen::Value non_null, combined;
+  If has_null{codegen, codegen->CreateOr(curr_null, other_null)};
+  {
+    // Take the other side only if it is the one that isn't NULL. Otherwise,
+    // keep the current value, which is NULL if both of them are.
+    auto other_val = other.GetType() == curr.GetType()
+                         ? other
+                         : other.CastTo(codegen, curr.GetType());
+    llvm::Value *take_other =
+        codegen->CreateAnd(curr_null, codegen->CreateNot(other_null));
+    llvm::Value *val = codegen->CreateSelect(take_other, other_val.GetValue(),
+                                             curr.GetValue());
+    llvm::Value *len = nullptr;
+    if (curr.GetLength() != nullptr) {
+      len = codegen->CreateSelect(take_other, other_val.GetLength(),
+                                  curr.GetLength());
+    }
+    non_null = codegen::Value{curr.GetType(), val, len};
+  }
+  has_null.ElseBlock();
+  {
+    switch (aggregate_type) {
+      case ExpressionType::AGGREGATE_SUM:
+        combined = curr.Add(codegen, other);
+        break;
+      case ExpressionType::AGGREGATE_MIN:
+        combined = curr.Min(codegen, other);
+        break;
+      case ExpressionType::AGGREGATE_MAX:
+        combined = curr.Max(codegen, other);
+        break;
+      default: {
+        std::string message = StringUtil::Format(
+            "Unexpected aggregate type [%s] when combining aggregates",
+            ExpressionTypeToString(aggregate_type).c_str());
+        LOG_ERROR("%s", message.c_str());
+        throw Exception{EXCEPTION_TYPE_UNKNOWN_TYPE, message};
+      }
+    }
+  }
+  has_null.EndIf();
+  return has_null.BuildPHI(non_null, combined);
+}
+
 //===----------------------------------------------------------------------===//
 // Advance each of the aggregates stored in the provided storage space. We
 // use the storage format class to determine the location of each of the
@@ -181,31 +244,19 @@ void Aggregation::CreateInitialValues(
 void Aggregation::AdvanceValues(
     CodeGen &codegen, llvm::Value *storage_space,
     const std::vector<codegen::Value> &next_vals) const {
-  // TODO: Handle null
   for (const auto &aggregate_info : aggregate_infos_) {
     // Loop over all aggregates, advancing each
     uint32_t source = aggregate_info.source_index;
     codegen::Value next;
     switch (aggregate_info.aggregate_type) {
-      case ExpressionType::AGGREGATE_SUM: {
-        PL_ASSERT(source < std::numeric_limits<uint32_t>::max());
-        auto curr = storage_.GetValueAt(codegen, storage_space,
-                                        aggregate_info.storage_index);
-        next = curr.Add(codegen, next_vals[source]);
-        break;
-      }
-      case ExpressionType::AGGREGATE_MIN: {
-        PL_ASSERT(source < std::numeric_limits<uint32_t>::max());
-        auto curr = storage_.GetValueAt(codegen, storage_space,
-                                        aggregate_info.storage_index);
-        next = curr.Min(codegen, next_vals[source]);
-        break;
-      }
+      case ExpressionType::AGGREGATE_SUM:
+      case ExpressionType::AGGREGATE_MIN:
       case ExpressionType::AGGREGATE_MAX: {
         PL_ASSERT(source < std::numeric_limits<uint32_t>::max());
         auto curr = storage_.GetValueAt(codegen, storage_space,
                                         aggregate_info.storage_index);
-        next = curr.Max(codegen, next_vals[source]);
+        next = CombineValues(codegen, aggregate_info.aggregate_type, curr,
+                             next_vals[source]);
         break;
       }
       case ExpressionType::AGGREGATE_COUNT: {
@@ -248,6 +299,72 @@ void Aggregation::AdvanceValues(
   }
 }
 
+
+//===----------------------------------------------------------------------===//
+// Merge the partial aggregates stored in the other storage space into the ones
+// in the provided storage space. This is used to combine the aggregates that
+// parallel workers computed over disjoint parts of the input. Counts are added
+// up, while sums, minimums and maximums are combined like input values, so a
+// worker that only saw NULLs doesn't affect them. Averages are derived from
+// their sum and count, so there is nothing to merge for them.
+//===----------------------------------------------------------------------===//
+void Aggregation::MergeValues(CodeGen &codegen, llvm::Value *storage_space,
+                              llvm::Value *other_storage_space) const {
+  for (const auto &aggregate_info : aggregate_infos_) {
+    codegen::Value next;
+    switch (aggregate_info.aggregate_type) {
+      case ExpressionType::AGGREGATE_SUM:
+      case ExpressionType::AGGREGATE_MIN:
+      case ExpressionType::AGGREGATE_MAX: {
+        auto curr = storage_.GetValueAt(codegen, storage_space,
+                                        aggregate_info.storage_index);
+        auto other = storage_.GetValueAt(codegen, other_storage_space,
+                                         aggregate_info.storage_index);
+        next = CombineValues(codegen, aggregate_info.aggregate_type, curr,
+                             other);
+        break;
+      }
+      case ExpressionType::AGGREGATE_COUNT: {
+        auto curr = storage_.GetValueAt(codegen, storage_space,
+                                        aggregate_info.storage_index);
+        auto other = storage_.GetValueAt(codegen, other_storage_space,
+                                         aggregate_info.storage_index);
+        next = curr.Add(codegen, other);
+        break;
+      }
+      case ExpressionType::AGGREGATE_COUNT_STAR: {
+        // Only the COUNT(*) stored in the first slot is physically stored
+        if (aggregate_info.source_index !=
+            std::numeric_limits<uint32_t>::max()) {
+          continue;
+        }
+        auto curr = storage_.GetValueAt(codegen, storage_space,
+                                        aggregate_info.storage_index);
+        auto other = storage_.GetValueAt(codegen, other_storage_space,
+                                         aggregate_info.storage_index);
+        next = curr.Add(codegen, other);
+        break;
+      }
+      case ExpressionType::AGGREGATE_AVG: {
+        // AVG() aggregates aren't physically stored
+        continue;
+      }
+      default: {
+        std::string message = StringUtil::Format(
+            "Unexpected aggregate type [%s] when merging aggregator",
+            ExpressionTypeToString(aggregate_info.aggregate_type).c_str());
+        LOG_ERROR("%s", message.c_str());
+        throw Exception{EXCEPTION_TYPE_UNKNOWN_TYPE, message};
+      }
+    }
+
+    // StoreValue the merged value in the appropriate slot
+    PL_ASSERT(next.GetType() != type::Type::TypeId::INVALID);
+    storage_.SetValueAt(codegen, storage_space, aggregate_info.storage_index,
+                        next);
+  }
+}
+
 //===----------------------------------------------------------------------===//
 // This function will finalize the aggregates stored in the provided storage
 // space.  Finalization essentially means computing the final values of the
@@ -15,6 +15,7 @@
 #include "codegen/values_runtime_proxy.h"
 #include "codegen/value_proxy.h"
 #include "common/logger.h"
+#include "executor/result_sink.h"
 #include "planner/binding_context.h"
 
 namespace peloton {
@@ -43,18 +44,25 @@ WrappedTuple &WrappedTuple::operator=(const WrappedTuple &o) {
 //===----------------------------------------------------------------------===//
 
 BufferingConsumer::BufferingConsumer(const std::vector<oid_t> &cols,
-                                     planner::BindingContext &context) {
+                                     planner::BindingContext &context,
+                                     executor::ResultSink *sink) {
   for (oid_t col_id : cols) {
     output_ais_.push_back(context.Find(col_id));
   }
   state.output = &tuples_;
+  state.sink = sink;
 }
 
 // Append the array of values (i.e., a tuple) into the consumer's buffer of
-// output tuples.
+// output tuples, or hand it to the sink. The generated code is the same
+// either way, so compiled queries can be cached regardless of the consumer.
 void BufferingConsumer::BufferTuple(char *state, type::Value *vals,
                                     uint32_t num_vals) {
   BufferingState *buffer_state = reinterpret_cast<BufferingState *>(state);
+  if (buffer_state->sink != nullptr) {
+    buffer_state->sink->AddRow(vals, num_vals);
+    return;
+  }
   buffer_state->output->emplace_back(vals, num_vals);
 }
 
@@ -26,6 +26,41 @@ namespace codegen {
 
 static std::atomic<uint64_t> kIdCounter{0};
 
+namespace {
+
+//===----------------------------------------------------------------------===//
+// A memory manager that tallies up the size of the code and data sections the
+// JIT allocates for a module, so callers can tell how much memory a compiled
+// query holds on to.
+//===----------------------------------------------------------------------===//
+class SizeTrackingMemoryManager : public llvm::SectionMemoryManager {
+ public:
+  explicit SizeTrackingMemoryManager(uint64_t &code_size)
+      : code_size_(code_size) {}
+
+  uint8_t *allocateCodeSection(uintptr_t size, unsigned alignment,
+                               unsigned section_id,
+                               llvm::StringRef section_name) override {
+    code_size_ += size;
+    return llvm::SectionMemoryManager::allocateCodeSection(
+        size, alignment, section_id, section_name);
+  }
+
+  uint8_t *allocateDataSection(uintptr_t size, unsigned alignment,
+                               unsigned section_id,
+                               llvm::StringRef section_name,
+                               bool is_read_only) override {
+    code_size_ += size;
+    return llvm::SectionMemoryManager::allocateDataSection(
+        size, alignment, section_id, section_name, is_read_only);
+  }
+
+ private:
+  uint64_t &code_size_;
+};
+
+}  // anonymous namespace
+
 //===----------------------------------------------------------------------===//
 // Constructor
 //===----------------------------------------------------------------------===//
@@ -36,6 +71,7 @@ CodeContext::CodeContext()
       builder_(*context_),
       func_(nullptr),
       opt_pass_manager_(module_),
+      code_size_(0),
       jit_engine_(nullptr) {
   // Initialize JIT stuff
   llvm::InitializeNativeTarget();
@@ -50,7 +86,8 @@ CodeContext::CodeContext()
   jit_engine_.reset(llvm::EngineBuilder(std::move(m))
                         .setEngineKind(llvm::EngineKind::JIT)
                         .setMCJITMemoryManager(
-                             llvm::make_unique<llvm::SectionMemoryManager>())
+                             llvm::make_unique<SizeTrackingMemoryManager>(
+                                 code_size_))
                         .setMCPU(llvm::sys::getHostCPUName())
                         .setErrorStr(&err_str_)
                         .create());
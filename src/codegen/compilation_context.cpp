@@ -22,9 +22,11 @@ namespace codegen {
 
 // Constructor
 CompilationContext::CompilationContext(Query &query,
-                                       QueryResultConsumer &result_consumer)
+                                       QueryResultConsumer &result_consumer,
+                                       const PlanFingerprint *fingerprint)
     : query_(query),
       result_consumer_(result_consumer),
+      fingerprint_(fingerprint),
       codegen_(query_.GetCodeContext()) {
   // Allocate a catalog and transaction instance in the runtime state
   auto &runtime_state = GetRuntimeState();
@@ -35,6 +37,12 @@ CompilationContext::CompilationContext(Query &query,
   auto *catalog_ptr_type = CatalogProxy::GetType(codegen_)->getPointerTo();
   catalog_state_id_ = runtime_state.RegisterState("catalog", catalog_ptr_type);
 
+  // The parameter buffer is always registered (before the consumer's state)
+  // so the layout of the leading state is the same for all queries
+  auto *parameters_type = codegen_.Int64Type()->getPointerTo();
+  parameters_state_id_ =
+      runtime_state.RegisterState("queryParameters", parameters_type);
+
   // Let the query consumer modify the runtime state object
   result_consumer_.Prepare(*this);
 }
@@ -60,13 +68,14 @@ void CompilationContext::Produce(const planner::AbstractPlan &op) {
 }
 
 // Generate all plan functions for the given query
-void CompilationContext::GeneratePlan(QueryCompiler::CompileStats *stats) {
+void CompilationContext::GeneratePlan(const planner::AbstractPlan &root,
+                                      QueryCompiler::CompileStats *stats) {
   // Start timing
   Timer<std::ratio<1, 1000>> timer;
   timer.Start();
 
   // First we prepare the translators for all the operators in the tree
-  Prepare(query_.GetPlan(), main_pipeline_);
+  Prepare(root, main_pipeline_);
 
   if (stats != nullptr) {
     timer.Stop();
@@ -84,7 +93,7 @@ void CompilationContext::GeneratePlan(QueryCompiler::CompileStats *stats) {
   llvm::Function *init = GenerateInitFunction();
 
   // Generate the plan() function
-  llvm::Function *plan = GeneratePlanFunction(query_.GetPlan());
+  llvm::Function *plan = GeneratePlanFunction(root);
 
   // Generate the  tearDown() function
   llvm::Function *tear_down = GenerateTearDownFunction();
@@ -129,6 +138,11 @@ llvm::Value *CompilationContext::GetTransactionPtr() {
   return GetRuntimeState().LoadStateValue(codegen_, txn_state_id_);
 }
 
+// Get the parameter buffer pointer from the runtime state
+llvm::Value *CompilationContext::GetQueryParametersPtr() {
+  return GetRuntimeState().LoadStateValue(codegen_, parameters_state_id_);
+}
+
 // Generate code for the init() function of the query
 llvm::Function *CompilationContext::GenerateInitFunction() {
   // Create function definition
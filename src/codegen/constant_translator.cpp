@@ -12,6 +12,9 @@
 
 #include "codegen/constant_translator.h"
 
+#include "codegen/compilation_context.h"
+#include "codegen/plan_fingerprint.h"
+#include "codegen/type.h"
 #include "expression/constant_value_expression.h"
 #include "type/value_peeker.h"
 
@@ -21,11 +24,23 @@ namespace codegen {
 // Constructor
 ConstantTranslator::ConstantTranslator(
     const expression::ConstantValueExpression &exp, CompilationContext &ctx)
-    : ExpressionTranslator(exp, ctx) {}
+    : ExpressionTranslator(exp, ctx),
+      context_(ctx),
+      is_parameter_(false),
+      parameter_slot_(0) {
+  const auto *fingerprint = ctx.GetPlanFingerprint();
+  if (fingerprint != nullptr) {
+    is_parameter_ = fingerprint->GetParameterSlot(exp, parameter_slot_);
+  }
+}
 
 // Return an LLVM value for our constant (i.e., a compile-time constant)
 codegen::Value ConstantTranslator::DeriveValue(CodeGen &codegen,
                                                RowBatch::Row &) const {
+  if (is_parameter_) {
+    return LoadParameter(codegen);
+  }
+
   // Pull out the constant from the expression
   const type::Value &constant =
       GetExpressionAs<expression::ConstantValueExpression>().GetValue();
@@ -76,5 +91,33 @@ codegen::Value ConstantTranslator::DeriveValue(CodeGen &codegen,
   return codegen::Value{constant.GetTypeId(), val, len};
 }
 
+// Return an LLVM value for our constant that is read from the parameter buffer
+codegen::Value ConstantTranslator::LoadParameter(CodeGen &codegen) const {
+  const type::Value &constant =
+      GetExpressionAs<expression::ConstantValueExpression>().GetValue();
+
+  llvm::Type *val_type = nullptr, *len_type = nullptr;
+  Type::GetTypeForMaterialization(codegen, constant.GetTypeId(), val_type,
+                                  len_type);
+
+  // Every parameter starts in its own 8-byte slot. Variable length values keep
+  // their length in the following slot.
+  llvm::Value *parameters = context_.GetQueryParametersPtr();
+  llvm::Value *val_ptr = codegen->CreateConstInBoundsGEP1_32(
+      codegen.Int64Type(), parameters, parameter_slot_);
+  llvm::Value *val = codegen->CreateLoad(
+      codegen->CreateBitCast(val_ptr, val_type->getPointerTo()));
+
+  llvm::Value *len = nullptr;
+  if (len_type != nullptr) {
+    llvm::Value *len_ptr = codegen->CreateConstInBoundsGEP1_32(
+        codegen.Int64Type(), parameters, parameter_slot_ + 1);
+    len = codegen->CreateLoad(
+        codegen->CreateBitCast(len_ptr, len_type->getPointerTo()));
+  }
+
+  return codegen::Value{constant.GetTypeId(), val, len};
+}
+
 }  // namespace codegen
 }  // namespace peloton
\ No newline at end of file
@@ -0,0 +1,430 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// filter_runtime.cpp
+//
+// Identification: src/codegen/filter_runtime.cpp
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "codegen/filter_runtime.h"
+
+#include <immintrin.h>
+#include <cstring>
+#include <limits>
+
+#include "common/exception.h"
+#include "storage/packed_column.h"
+
+namespace peloton {
+namespace codegen {
+
+namespace {
+
+//===----------------------------------------------------------------------===//
+// The comparisons, in scalar and AVX2 form. The AVX2 forms compare all lanes
+// of two vectors and return a bitmask with a bit set for every lane where the
+// comparison holds.
+//
+// The scalar forms are written as the negation of the opposite comparison
+// (e.g., "not greater or equal" for less than). This gives the same result
+// as the unordered floating point comparisons the generated code uses for
+// decimals, and doesn't change anything for integers.
+//===----------------------------------------------------------------------===//
+
+struct LessThan {
+  template <typename T>
+  static bool Compare(T l, T r) {
+    return !(l >= r);
+  }
+  __attribute__((target("avx2"))) static uint32_t MaskInt32(__m256i l,
+                                                             __m256i r) {
+    return _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(r, l)));
+  }
+  __attribute__((target("avx2"))) static uint32_t MaskInt64(__m256i l,
+                                                             __m256i r) {
+    return _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpgt_epi64(r, l)));
+  }
+  __attribute__((target("avx2"))) static uint32_t MaskDouble(__m256d l,
+                                                              __m256d r) {
+    return _mm256_movemask_pd(_mm256_cmp_pd(l, r, _CMP_NGE_UQ));
+  }
+};
+
+struct LessThanOrEqual {
+  template <typename T>
+  static bool Compare(T l, T r) {
+    return !(l > r);
+  }
+  __attribute__((target("avx2"))) static uint32_t MaskInt32(__m256i l,
+                                                             __m256i r) {
+    return ~_mm256_movemask_ps(
+               _mm256_castsi256_ps(_mm256_cmpgt_epi32(l, r))) & 0xFF;
+  }
+  __attribute__((target("avx2"))) static uint32_t MaskInt64(__m256i l,
+                                                             __m256i r) {
+    return ~_mm256_movemask_pd(
+               _mm256_castsi256_pd(_mm256_cmpgt_epi64(l, r))) & 0xF;
+  }
+  __attribute__((target("avx2"))) static uint32_t MaskDouble(__m256d l,
+                                                              __m256d r) {
+    return _mm256_movemask_pd(_mm256_cmp_pd(l, r, _CMP_NGT_UQ));
+  }
+};
+
+struct Equal {
+  template <typename T>
+  static bool Compare(T l, T r) {
+    return !(l < r || l > r);
+  }
+  __attribute__((target("avx2"))) static uint32_t MaskInt32(__m256i l,
+                                                             __m256i r) {
+    return _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(l, r)));
+  }
+  __attribute__((target("avx2"))) static uint32_t MaskInt64(__m256i l,
+                                                             __m256i r) {
+    return _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(l, r)));
+  }
+  __attribute__((target("avx2"))) static uint32_t MaskDouble(__m256d l,
+                                                              __m256d r) {
+    return _mm256_movemask_pd(_mm256_cmp_pd(l, r, _CMP_EQ_UQ));
+  }
+};
+
+struct NotEqual {
+  template <typename T>
+  static bool Compare(T l, T r) {
+    return !(l == r);
+  }
+  __attribute__((target("avx2"))) static uint32_t MaskInt32(__m256i l,
+                                                             __m256i r) {
+    return ~_mm256_movemask_ps(
+               _mm256_castsi256_ps(_mm256_cmpeq_epi32(l, r))) & 0xFF;
+  }
+  __attribute__((target("avx2"))) static uint32_t MaskInt64(__m256i l,
+                                                             __m256i r) {
+    return ~_mm256_movemask_pd(
+               _mm256_castsi256_pd(_mm256_cmpeq_epi64(l, r))) & 0xF;
+  }
+  __attribute__((target("avx2"))) static uint32_t MaskDouble(__m256d l,
+                                                              __m256d r) {
+    return _mm256_movemask_pd(_mm256_cmp_pd(l, r, _CMP_NEQ_UQ));
+  }
+};
+
+struct GreaterThan {
+  template <typename T>
+  static bool Compare(T l, T r) {
+    return !(l <= r);
+  }
+  __attribute__((target("avx2"))) static uint32_t MaskInt32(__m256i l,
+                                                             __m256i r) {
+    return _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(l, r)));
+  }
+  __attribute__((target("avx2"))) static uint32_t MaskInt64(__m256i l,
+                                                             __m256i r) {
+    return _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpgt_epi64(l, r)));
+  }
+  __attribute__((target("avx2"))) static uint32_t MaskDouble(__m256d l,
+                                                              __m256d r) {
+    return _mm256_movemask_pd(_mm256_cmp_pd(l, r, _CMP_NLE_UQ));
+  }
+};
+
+struct GreaterThanOrEqual {
+  template <typename T>
+  static bool Compare(T l, T r) {
+    return !(l < r);
+  }
+  __attribute__((target("avx2"))) static uint32_t MaskInt32(__m256i l,
+                                                             __m256i r) {
+    return ~_mm256_movemask_ps(
+               _mm256_castsi256_ps(_mm256_cmpgt_epi32(r, l))) & 0xFF;
+  }
+  __attribute__((target("avx2"))) static uint32_t MaskInt64(__m256i l,
+                                                             __m256i r) {
+    return ~_mm256_movemask_pd(
+               _mm256_castsi256_pd(_mm256_cmpgt_epi64(r, l))) & 0xF;
+  }
+  __attribute__((target("avx2"))) static uint32_t MaskDouble(__m256d l,
+                                                              __m256d r) {
+    return _mm256_movemask_pd(_mm256_cmp_pd(l, r, _CMP_NLT_UQ));
+  }
+};
+
+//===----------------------------------------------------------------------===//
+// The permutations that move the TIDs of the lanes set in an 8-bit mask to the
+// front of a vector, in order
+//===----------------------------------------------------------------------===//
+struct CompressTable {
+  alignas(32) uint32_t permutations[256][8];
+
+  CompressTable() {
+    for (uint32_t mask = 0; mask < 256; mask++) {
+      uint32_t pos = 0;
+      for (uint32_t lane = 0; lane < 8; lane++) {
+        if (mask & (1u << lane)) {
+          permutations[mask][pos++] = lane;
+        }
+      }
+      while (pos < 8) {
+        permutations[mask][pos++] = 0;
+      }
+    }
+  }
+};
+
+const CompressTable &GetCompressTable() {
+  static const CompressTable compress_table;
+  return compress_table;
+}
+
+// Write the TIDs of the lanes set in the mask to the given position of the
+// selection vector, and return how many there are. This always writes a full
+// vector, so the position must not be after the TIDs that were loaded.
+__attribute__((target("avx2"))) inline uint32_t CompressTIDs(
+    const CompressTable &table, __m256i tids, uint32_t mask, uint32_t *out) {
+  __m256i permutation = _mm256_load_si256(
+      reinterpret_cast<const __m256i *>(table.permutations[mask]));
+  _mm256_storeu_si256(reinterpret_cast<__m256i *>(out),
+                      _mm256_permutevar8x32_epi32(tids, permutation));
+  return static_cast<uint32_t>(__builtin_popcount(mask));
+}
+
+//===----------------------------------------------------------------------===//
+// The scalar kernel. It filters the TIDs in the selection vector starting at
+// position 'start', writing the ones that pass starting at position 'out'.
+//===----------------------------------------------------------------------===//
+template <typename T, typename Cmp>
+uint32_t ScalarFilter(const char *column, uint32_t stride, T value,
+                      uint32_t *selection_vector, uint32_t start,
+                      uint32_t num_selected, uint32_t out) {
+  for (uint32_t i = start; i < num_selected; i++) {
+    uint32_t tid = selection_vector[i];
+    T col_val;
+    std::memcpy(&col_val, column + static_cast<uint64_t>(tid) * stride,
+                sizeof(T));
+    selection_vector[out] = tid;
+    out += Cmp::Compare(col_val, value);
+  }
+  return out;
+}
+
+//===----------------------------------------------------------------------===//
+// The AVX2 kernels. They filter eight TIDs at a time, and leave the remainder
+// to the scalar kernel. The gathers address the column with 32-bit offsets.
+//===----------------------------------------------------------------------===//
+template <typename Cmp>
+__attribute__((target("avx2"))) uint32_t AVX2Filter(
+    const char *column, uint32_t stride, int32_t value,
+    uint32_t *selection_vector, uint32_t num_selected) {
+  const auto &compress_table = GetCompressTable();
+  const auto *base = reinterpret_cast<const int *>(column);
+  const __m256i strides = _mm256_set1_epi32(stride);
+  const __m256i values = _mm256_set1_epi32(value);
+
+  uint32_t out = 0, i = 0;
+  for (; i + 8 <= num_selected; i += 8) {
+    __m256i tids = _mm256_loadu_si256(
+        reinterpret_cast<const __m256i *>(selection_vector + i));
+    __m256i offsets = _mm256_mullo_epi32(tids, strides);
+    __m256i col_vals = _mm256_i32gather_epi32(base, offsets, 1);
+    uint32_t mask = Cmp::MaskInt32(col_vals, values);
+    out += CompressTIDs(compress_table, tids, mask, selection_vector + out);
+  }
+  return ScalarFilter<int32_t, Cmp>(column, stride, value, selection_vector, i,
+                                    num_selected, out);
+}
+
+template <typename Cmp>
+__attribute__((target("avx2"))) uint32_t AVX2Filter(
+    const char *column, uint32_t stride, int64_t value,
+    uint32_t *selection_vector, uint32_t num_selected) {
+  const auto &compress_table = GetCompressTable();
+  const auto *base = reinterpret_cast<const long long *>(column);
+  const __m256i strides = _mm256_set1_epi32(stride);
+  const __m256i values = _mm256_set1_epi64x(value);
+
+  uint32_t out = 0, i = 0;
+  for (; i + 8 <= num_selected; i += 8) {
+    __m256i tids = _mm256_loadu_si256(
+        reinterpret_cast<const __m256i *>(selection_vector + i));
+    __m256i offsets = _mm256_mullo_epi32(tids, strides);
+    __m256i lo_vals =
+        _mm256_i32gather_epi64(base, _mm256_castsi256_si128(offsets), 1);
+    __m256i hi_vals =
+        _mm256_i32gather_epi64(base, _mm256_extracti128_si256(offsets, 1), 1);
+    uint32_t mask = Cmp::MaskInt64(lo_vals, values) |
+                    (Cmp::MaskInt64(hi_vals, values) << 4);
+    out += CompressTIDs(compress_table, tids, mask, selection_vector + out);
+  }
+  return ScalarFilter<int64_t, Cmp>(column, stride, value, selection_vector, i,
+                                    num_selected, out);
+}
+
+template <typename Cmp>
+__attribute__((target("avx2"))) uint32_t AVX2Filter(
+    const char *column, uint32_t stride, double value,
+    uint32_t *selection_vector, uint32_t num_selected) {
+  const auto &compress_table = GetCompressTable();
+  const auto *base = reinterpret_cast<const double *>(column);
+  const __m256i strides = _mm256_set1_epi32(stride);
+  const __m256d values = _mm256_set1_pd(value);
+  const __m256d zeros = _mm256_setzero_pd();
+  const __m256d all_lanes = _mm256_cmp_pd(zeros, zeros, _CMP_EQ_OQ);
+
+  uint32_t out = 0, i = 0;
+  for (; i + 8 <= num_selected; i += 8) {
+    __m256i tids = _mm256_loadu_si256(
+        reinterpret_cast<const __m256i *>(selection_vector + i));
+    __m256i offsets = _mm256_mullo_epi32(tids, strides);
+    __m256d lo_vals = _mm256_mask_i32gather_pd(
+        zeros, base, _mm256_castsi256_si128(offsets), all_lanes, 1);
+    __m256d hi_vals = _mm256_mask_i32gather_pd(
+        zeros, base, _mm256_extracti128_si256(offsets, 1), all_lanes, 1);
+    uint32_t mask = Cmp::MaskDouble(lo_vals, values) |
+                    (Cmp::MaskDouble(hi_vals, values) << 4);
+    out += CompressTIDs(compress_table, tids, mask, selection_vector + out);
+  }
+  return ScalarFilter<double, Cmp>(column, stride, value, selection_vector, i,
+                                   num_selected, out);
+}
+
+// Can we use the AVX2 kernels on the given selection vector?
+bool CanUseAVX2(uint32_t stride, const uint32_t *selection_vector,
+                uint32_t num_selected) {
+  static const bool kHasAVX2 = __builtin_cpu_supports("avx2");
+  if (!kHasAVX2 || num_selected < 8) {
+    return false;
+  }
+
+  // The TIDs are sorted, so the last one has the largest offset
+  uint64_t max_offset =
+      static_cast<uint64_t>(selection_vector[num_selected - 1]) * stride;
+  return max_offset <=
+         static_cast<uint64_t>(std::numeric_limits<int32_t>::max());
+}
+
+template <typename T, typename Cmp>
+uint32_t Filter(const char *column, uint32_t stride, T value,
+                uint32_t *selection_vector, uint32_t num_selected) {
+  if (CanUseAVX2(stride, selection_vector, num_selected)) {
+    return AVX2Filter<Cmp>(column, stride, value, selection_vector,
+                           num_selected);
+  }
+  return ScalarFilter<T, Cmp>(column, stride, value, selection_vector, 0,
+                              num_selected, 0);
+}
+
+//===----------------------------------------------------------------------===//
+// The kernel for packed columns, see FilterRuntime::FilterPacked()
+//===----------------------------------------------------------------------===//
+template <typename Cmp>
+uint32_t PackedFilter(const char *column, uint32_t bits, int64_t base,
+                      int64_t value, uint32_t *selection_vector,
+                      uint32_t num_selected) {
+  const auto *words = reinterpret_cast<const uint64_t *>(column);
+  uint32_t out = 0;
+  for (uint32_t i = 0; i < num_selected; i++) {
+    uint32_t tid = selection_vector[i];
+    int64_t col_val =
+        base + static_cast<int64_t>(
+                   storage::PackedColumn::GetOffset(words, bits, tid));
+    selection_vector[out] = tid;
+    out += Cmp::Compare(col_val, value);
+  }
+  return out;
+}
+
+template <typename T>
+uint32_t FilterByComparison(const char *column, uint32_t stride,
+                            ExpressionType comparison, T value,
+                            uint32_t *selection_vector,
+                            uint32_t num_selected) {
+  switch (comparison) {
+    case ExpressionType::COMPARE_LESSTHAN:
+      return Filter<T, LessThan>(column, stride, value, selection_vector,
+                                 num_selected);
+    case ExpressionType::COMPARE_LESSTHANOREQUALTO:
+      return Filter<T, LessThanOrEqual>(column, stride, value,
+                                        selection_vector, num_selected);
+    case ExpressionType::COMPARE_EQUAL:
+      return Filter<T, Equal>(column, stride, value, selection_vector,
+                              num_selected);
+    case ExpressionType::COMPARE_NOTEQUAL:
+      return Filter<T, NotEqual>(column, stride, value, selection_vector,
+                                 num_selected);
+    case ExpressionType::COMPARE_GREATERTHAN:
+      return Filter<T, GreaterThan>(column, stride, value, selection_vector,
+                                    num_selected);
+    case ExpressionType::COMPARE_GREATERTHANOREQUALTO:
+      return Filter<T, GreaterThanOrEqual>(column, stride, value,
+                                           selection_vector, num_selected);
+    default: {
+      throw Exception{"Comparison " + ExpressionTypeToString(comparison) +
+                      " can't be used in a vectorized filter"};
+    }
+  }
+}
+
+}  // anonymous namespace
+
+uint32_t FilterRuntime::FilterInteger(const char *column, uint32_t stride,
+                                      ExpressionType comparison, int32_t value,
+                                      uint32_t *selection_vector,
+                                      uint32_t num_selected) {
+  return FilterByComparison<int32_t>(column, stride, comparison, value,
+                                     selection_vector, num_selected);
+}
+
+uint32_t FilterRuntime::FilterBigInt(const char *column, uint32_t stride,
+                                     ExpressionType comparison, int64_t value,
+                                     uint32_t *selection_vector,
+                                     uint32_t num_selected) {
+  return FilterByComparison<int64_t>(column, stride, comparison, value,
+                                     selection_vector, num_selected);
+}
+
+uint32_t FilterRuntime::FilterDecimal(const char *column, uint32_t stride,
+                                      ExpressionType comparison, double value,
+                                      uint32_t *selection_vector,
+                                      uint32_t num_selected) {
+  return FilterByComparison<double>(column, stride, comparison, value,
+                                    selection_vector, num_selected);
+}
+
+uint32_t FilterRuntime::FilterPacked(const char *column, uint32_t bits,
+                                     int64_t base, ExpressionType comparison,
+                                     int64_t value, uint32_t *selection_vector,
+                                     uint32_t num_selected) {
+  switch (comparison) {
+    case ExpressionType::COMPARE_LESSTHAN:
+      return PackedFilter<LessThan>(column, bits, base, value,
+                                    selection_vector, num_selected);
+    case ExpressionType::COMPARE_LESSTHANOREQUALTO:
+      return PackedFilter<LessThanOrEqual>(column, bits, base, value,
+                                           selection_vector, num_selected);
+    case ExpressionType::COMPARE_EQUAL:
+      return PackedFilter<Equal>(column, bits, base, value, selection_vector,
+                                 num_selected);
+    case ExpressionType::COMPARE_NOTEQUAL:
+      return PackedFilter<NotEqual>(column, bits, base, value,
+                                    selection_vector, num_selected);
+    case ExpressionType::COMPARE_GREATERTHAN:
+      return PackedFilter<GreaterThan>(column, bits, base, value,
+                                       selection_vector, num_selected);
+    case ExpressionType::COMPARE_GREATERTHANOREQUALTO:
+      return PackedFilter<GreaterThanOrEqual>(column, bits, base, value,
+                                              selection_vector, num_selected);
+    default: {
+      throw Exception{"Comparison " + ExpressionTypeToString(comparison) +
+                      " can't be used in a vectorized filter"};
+    }
+  }
+}
+
+}  // namespace codegen
+}  // namespace peloton
@@ -0,0 +1,140 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// filter_runtime_proxy.cpp
+//
+// Identification: src/codegen/filter_runtime_proxy.cpp
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "codegen/filter_runtime_proxy.h"
+
+namespace peloton {
+namespace codegen {
+
+namespace {
+
+// All the filter kernels have the same signature, apart from the type of the
+// constant they compare the column with
+llvm::Function *RegisterFilterFunction(CodeGen &codegen,
+                                       const std::string &fn_name,
+                                       llvm::Type *value_type) {
+  // Has the function already been registered?
+  llvm::Function *llvm_fn = codegen.LookupFunction(fn_name);
+  if (llvm_fn != nullptr) {
+    return llvm_fn;
+  }
+
+  std::vector<llvm::Type *> arg_types = {
+      codegen.CharPtrType(),                // column
+      codegen.Int32Type(),                  // stride
+      codegen.Int32Type(),                  // comparison
+      value_type,                           // value
+      codegen.Int32Type()->getPointerTo(),  // selection_vector
+      codegen.Int32Type()};                 // num_selected
+  auto *fn_type =
+      llvm::FunctionType::get(codegen.Int32Type(), arg_types, false);
+  return codegen.RegisterFunction(fn_name, fn_type);
+}
+
+}  // anonymous namespace
+
+//===----------------------------------------------------------------------===//
+// FILTER INTEGER
+//===----------------------------------------------------------------------===//
+
+const std::string &FilterRuntimeProxy::_FilterInteger::GetFunctionName() {
+  static const std::string kFilterIntegerFnName =
+      "_ZN7peloton7codegen13FilterRuntime13FilterIntegerEPKcjNS_"
+      "14ExpressionTypeEiPjj";
+  return kFilterIntegerFnName;
+}
+
+llvm::Function *FilterRuntimeProxy::_FilterInteger::GetFunction(
+    CodeGen &codegen) {
+  return RegisterFilterFunction(codegen, GetFunctionName(),
+                                codegen.Int32Type());
+}
+
+//===----------------------------------------------------------------------===//
+// FILTER BIGINT
+//===----------------------------------------------------------------------===//
+
+const std::string &FilterRuntimeProxy::_FilterBigInt::GetFunctionName() {
+  static const std::string kFilterBigIntFnName =
+#ifdef __APPLE__
+      "_ZN7peloton7codegen13FilterRuntime12FilterBigIntEPKcjNS_"
+      "14ExpressionTypeExPjj";
+#else
+      "_ZN7peloton7codegen13FilterRuntime12FilterBigIntEPKcjNS_"
+      "14ExpressionTypeElPjj";
+#endif
+  return kFilterBigIntFnName;
+}
+
+llvm::Function *FilterRuntimeProxy::_FilterBigInt::GetFunction(
+    CodeGen &codegen) {
+  return RegisterFilterFunction(codegen, GetFunctionName(),
+                                codegen.Int64Type());
+}
+
+//===----------------------------------------------------------------------===//
+// FILTER DECIMAL
+//===----------------------------------------------------------------------===//
+
+const std::string &FilterRuntimeProxy::_FilterDecimal::GetFunctionName() {
+  static const std::string kFilterDecimalFnName =
+      "_ZN7peloton7codegen13FilterRuntime13FilterDecimalEPKcjNS_"
+      "14ExpressionTypeEdPjj";
+  return kFilterDecimalFnName;
+}
+
+llvm::Function *FilterRuntimeProxy::_FilterDecimal::GetFunction(
+    CodeGen &codegen) {
+  return RegisterFilterFunction(codegen, GetFunctionName(),
+                                codegen.DoubleType());
+}
+
+//===----------------------------------------------------------------------===//
+// FILTER PACKED
+//===----------------------------------------------------------------------===//
+
+const std::string &FilterRuntimeProxy::_FilterPacked::GetFunctionName() {
+  static const std::string kFilterPackedFnName =
+#ifdef __APPLE__
+      "_ZN7peloton7codegen13FilterRuntime12FilterPackedEPKcjxNS_"
+      "14ExpressionTypeExPjj";
+#else
+      "_ZN7peloton7codegen13FilterRuntime12FilterPackedEPKcjlNS_"
+      "14ExpressionTypeElPjj";
+#endif
+  return kFilterPackedFnName;
+}
+
+llvm::Function *FilterRuntimeProxy::_FilterPacked::GetFunction(
+    CodeGen &codegen) {
+  // Has the function already been registered?
+  const std::string &fn_name = GetFunctionName();
+  llvm::Function *llvm_fn = codegen.LookupFunction(fn_name);
+  if (llvm_fn != nullptr) {
+    return llvm_fn;
+  }
+
+  std::vector<llvm::Type *> arg_types = {
+      codegen.CharPtrType(),                // column
+      codegen.Int32Type(),                  // bits
+      codegen.Int64Type(),                  // base
+      codegen.Int32Type(),                  // comparison
+      codegen.Int64Type(),                  // value
+      codegen.Int32Type()->getPointerTo(),  // selection_vector
+      codegen.Int32Type()};                 // num_selected
+  auto *fn_type =
+      llvm::FunctionType::get(codegen.Int32Type(), arg_types, false);
+  return codegen.RegisterFunction(fn_name, fn_type);
+}
+
+}  // namespace codegen
+}  // namespace peloton
@@ -29,8 +29,10 @@ GlobalGroupByTranslator::GlobalGroupByTranslator(
       child_pipeline_(this) {
   LOG_DEBUG("Constructing GlobalGroupByTranslator ...");
 
-  // Prepare the child in the new child pipeline
+  // Prepare the child in the new child pipeline. Partial aggregates can be
+  // merged, so the child can run in parallel.
   context.Prepare(*plan_.GetChild(0), child_pipeline_);
+  child_pipeline_.SetParallel();
 
   // Prepare all the aggregating expressions
   auto &aggregates = plan_.GetUniqueAggTerms();
@@ -135,6 +137,58 @@ void GlobalGroupByTranslator::Consume(ConsumerContext &,
   uninitialized.EndIf();
 }
 
+// A worker starts out with an empty buffer
+void GlobalGroupByTranslator::InitializeWorkerState() const {
+  auto &codegen = GetCodeGen();
+  auto *mat_buffer = LoadStatePtr(mat_buffer_id_);
+  auto *mat_buffer_type = codegen.LookupTypeByName(kMatBufferTypeName);
+  auto *initialized =
+      codegen->CreateConstInBoundsGEP2_32(mat_buffer_type, mat_buffer, 0, 1);
+  codegen->CreateStore(codegen.Const8(0), initialized);
+}
+
+// Merge the partial aggregates of the worker into our buffer. A worker that
+// didn't see any input has nothing to merge. If our buffer is still empty, the
+// worker's aggregates are taken as they are.
+void GlobalGroupByTranslator::MergeWorkerState(
+    llvm::Value *worker_state) const {
+  auto &codegen = GetCodeGen();
+  auto &runtime_state = GetCompilationContext().GetRuntimeState();
+  auto *mat_buffer_type = codegen.LookupTypeByName(kMatBufferTypeName);
+
+  auto *mat_buffer = LoadStatePtr(mat_buffer_id_);
+  auto *worker_buffer =
+      runtime_state.LoadStatePtr(codegen, mat_buffer_id_, worker_state);
+
+  auto *worker_initialized =
+      codegen->CreateConstInBoundsGEP2_32(mat_buffer_type, worker_buffer, 0, 1);
+  If worker_has_values{codegen,
+                       codegen->CreateICmpEQ(
+                           codegen.Const8(1),
+                           codegen->CreateLoad(worker_initialized))};
+  {
+    auto *initialized =
+        codegen->CreateConstInBoundsGEP2_32(mat_buffer_type, mat_buffer, 0, 1);
+    If uninitialized{codegen,
+                     codegen->CreateICmpEQ(codegen.Const8(0),
+                                           codegen->CreateLoad(initialized))};
+    {
+      // Copy the worker's aggregates, including the initialized bit
+      codegen->CreateStore(codegen->CreateLoad(worker_buffer), mat_buffer);
+    }
+    uninitialized.ElseBlock();
+    {
+      auto *buf = codegen->CreateConstInBoundsGEP2_32(mat_buffer_type,
+                                                      mat_buffer, 0, 0);
+      auto *worker_buf = codegen->CreateConstInBoundsGEP2_32(
+          mat_buffer_type, worker_buffer, 0, 0);
+      aggregation_.MergeValues(codegen, buf, worker_buf);
+    }
+    uninitialized.EndIf();
+  }
+  worker_has_values.EndIf();
+}
+
 //===----------------------------------------------------------------------===//
 // Get the stringified name of this global group-by
 //===----------------------------------------------------------------------===//
@@ -64,8 +64,10 @@ HashGroupByTranslator::HashGroupByTranslator(
   hash_table_id_ = runtime_state.RegisterState(
       "groupBy", OAHashTableProxy::GetType(codegen));
 
-  // Prepare the input operator to this group by
+  // Prepare the input operator to this group by. Groups of parallel workers
+  // can be merged, so the input can be produced in parallel.
   context.Prepare(*group_by_.GetChild(0), child_pipeline_);
+  child_pipeline_.SetParallel();
 
   // Prepare the predicate if one exists
   if (group_by_.GetPredicate() != nullptr) {
@@ -248,6 +250,26 @@ void HashGroupByTranslator::TearDownState() {
   hash_table_.Destroy(GetCodeGen(), LoadStatePtr(hash_table_id_));
 }
 
+// Every parallel worker aggregates into a hash table of its own
+void HashGroupByTranslator::InitializeWorkerState() const {
+  hash_table_.Init(GetCodeGen(), LoadStatePtr(hash_table_id_));
+}
+
+// Merge all the groups of the worker's hash table into the main hash table
+void HashGroupByTranslator::MergeWorkerState(llvm::Value *worker_state) const {
+  auto &codegen = GetCodeGen();
+  auto &runtime_state = GetCompilationContext().GetRuntimeState();
+  llvm::Value *worker_hash_table =
+      runtime_state.LoadStatePtr(codegen, hash_table_id_, worker_state);
+  MergeWorkerGroups merger{hash_table_, aggregation_,
+                           LoadStatePtr(hash_table_id_)};
+  hash_table_.Iterate(codegen, worker_hash_table, merger);
+}
+
+void HashGroupByTranslator::TearDownWorkerState() const {
+  hash_table_.Destroy(GetCodeGen(), LoadStatePtr(hash_table_id_));
+}
+
 // Get the stringified name of this hash-based group-by
 std::string HashGroupByTranslator::GetName() const { return "HashGroupBy"; }
 
@@ -425,5 +447,60 @@ llvm::Value *HashGroupByTranslator::ConsumerInsert::GetValueSize(
   return codegen.Const32(aggregation_.GetAggregatesStorageSize());
 }
 
+//===----------------------------------------------------------------------===//
+// MERGE WORKER GROUPS
+//===----------------------------------------------------------------------===//
+
+// Constructor
+HashGroupByTranslator::MergeWorkerGroups::MergeWorkerGroups(
+    const OAHashTable &hash_table, const Aggregation &aggregation,
+    llvm::Value *ht_ptr)
+    : hash_table_(hash_table), aggregation_(aggregation), ht_ptr_(ht_ptr) {}
+
+// Find the worker's group in the main hash table, creating it if needed
+void HashGroupByTranslator::MergeWorkerGroups::ProcessEntry(
+    CodeGen &codegen, const std::vector<codegen::Value> &keys,
+    llvm::Value *values) const {
+  MergeProbe probe{aggregation_, values};
+  MergeInsert insert{aggregation_, values};
+  hash_table_.ProbeOrInsert(codegen, ht_ptr_, nullptr, keys, probe, insert);
+}
+
+//===----------------------------------------------------------------------===//
+// MERGE PROBE
+//===----------------------------------------------------------------------===//
+
+// Constructor
+HashGroupByTranslator::MergeProbe::MergeProbe(const Aggregation &aggregation,
+                                              llvm::Value *worker_vals)
+    : aggregation_(aggregation), worker_vals_(worker_vals) {}
+
+// The group exists in both hash tables, merge the aggregates
+void HashGroupByTranslator::MergeProbe::ProcessEntry(
+    CodeGen &codegen, llvm::Value *data_area) const {
+  aggregation_.MergeValues(codegen, data_area, worker_vals_);
+}
+
+//===----------------------------------------------------------------------===//
+// MERGE INSERT
+//===----------------------------------------------------------------------===//
+
+// Constructor
+HashGroupByTranslator::MergeInsert::MergeInsert(const Aggregation &aggregation,
+                                                llvm::Value *worker_vals)
+    : aggregation_(aggregation), worker_vals_(worker_vals) {}
+
+// The group is new, the worker's aggregates become the initial aggregates
+void HashGroupByTranslator::MergeInsert::StoreValue(CodeGen &codegen,
+                                                    llvm::Value *space) const {
+  codegen->CreateMemCpy(space, worker_vals_,
+                        aggregation_.GetAggregatesStorageSize(), 1);
+}
+
+llvm::Value *HashGroupByTranslator::MergeInsert::GetValueSize(
+    CodeGen &codegen) const {
+  return codegen.Const32(aggregation_.GetAggregatesStorageSize());
+}
+
 }  // namespace codegen
 }  // namespace peloton
\ No newline at end of file
@@ -0,0 +1,276 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// index_scan_iterator_proxy.cpp
+//
+// Identification: src/codegen/index_scan_iterator_proxy.cpp
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "codegen/index_scan_iterator_proxy.h"
+
+#include "codegen/tile_group_proxy.h"
+#include "codegen/transaction_proxy.h"
+#include "codegen/utils/index_scan_iterator.h"
+
+namespace peloton {
+namespace codegen {
+
+llvm::Type *IndexScanIteratorProxy::GetType(CodeGen &codegen) {
+  static const std::string kIteratorTypeName =
+      "peloton::codegen::utils::IndexScanIterator";
+
+  auto *iterator_type = codegen.LookupTypeByName(kIteratorTypeName);
+  if (iterator_type != nullptr) {
+    return iterator_type;
+  }
+
+  // The iterator is only ever touched through its methods, but it lives in the
+  // runtime state and needs the same size and alignment as the real class
+  static_assert(alignof(utils::IndexScanIterator) <= sizeof(uint64_t),
+                "IndexScanIterator needs more than 8-byte alignment");
+  static const uint32_t kNumWords =
+      (sizeof(utils::IndexScanIterator) + sizeof(uint64_t) - 1) /
+      sizeof(uint64_t);
+  auto *words = llvm::ArrayType::get(codegen.Int64Type(), kNumWords);
+  iterator_type = llvm::StructType::create(codegen.GetContext(), {words},
+                                           kIteratorTypeName);
+  return iterator_type;
+}
+
+//===--------------------------------------------------------------------===//
+// The proxy for codegen::utils::IndexScanIterator::Init()
+//===--------------------------------------------------------------------===//
+const std::string &IndexScanIteratorProxy::_Init::GetFunctionName() {
+  static const std::string kInitFnName =
+#ifdef __APPLE__
+      "_ZN7peloton7codegen5utils17IndexScanIterator4InitERKNS_7planner13IndexScanPlanE";
+#else
+      "_ZN7peloton7codegen5utils17IndexScanIterator4InitERKNS_7planner13IndexScanPlanE";
+#endif
+  return kInitFnName;
+}
+
+llvm::Function *IndexScanIteratorProxy::_Init::GetFunction(
+    CodeGen &codegen) {
+  const std::string &fn_name = GetFunctionName();
+
+  // Has the function already been registered?
+  llvm::Function *llvm_fn = codegen.LookupFunction(fn_name);
+  if (llvm_fn != nullptr) {
+    return llvm_fn;
+  }
+
+  // The function hasn't been registered, let's do it now ...
+  auto *iterator_ptr_type =
+      IndexScanIteratorProxy::GetType(codegen)->getPointerTo();
+  std::vector<llvm::Type *> fn_args = {
+      iterator_ptr_type, codegen.CharPtrType()};
+  llvm::FunctionType *fn_type =
+      llvm::FunctionType::get(codegen.VoidType(), fn_args, false);
+  return codegen.RegisterFunction(fn_name, fn_type);
+}
+
+//===--------------------------------------------------------------------===//
+// The proxy for codegen::utils::IndexScanIterator::GetKeyValues()
+//===--------------------------------------------------------------------===//
+const std::string &IndexScanIteratorProxy::_GetKeyValues::GetFunctionName() {
+  static const std::string kGetKeyValuesFnName =
+#ifdef __APPLE__
+      "_ZN7peloton7codegen5utils17IndexScanIterator12GetKeyValuesEv";
+#else
+      "_ZN7peloton7codegen5utils17IndexScanIterator12GetKeyValuesEv";
+#endif
+  return kGetKeyValuesFnName;
+}
+
+llvm::Function *IndexScanIteratorProxy::_GetKeyValues::GetFunction(
+    CodeGen &codegen) {
+  const std::string &fn_name = GetFunctionName();
+
+  // Has the function already been registered?
+  llvm::Function *llvm_fn = codegen.LookupFunction(fn_name);
+  if (llvm_fn != nullptr) {
+    return llvm_fn;
+  }
+
+  // The function hasn't been registered, let's do it now ...
+  auto *iterator_ptr_type =
+      IndexScanIteratorProxy::GetType(codegen)->getPointerTo();
+  std::vector<llvm::Type *> fn_args = {iterator_ptr_type};
+  llvm::FunctionType *fn_type =
+      llvm::FunctionType::get(codegen.CharPtrType(), fn_args, false);
+  return codegen.RegisterFunction(fn_name, fn_type);
+}
+
+//===--------------------------------------------------------------------===//
+// The proxy for codegen::utils::IndexScanIterator::BindKeyValues()
+//===--------------------------------------------------------------------===//
+const std::string &IndexScanIteratorProxy::_BindKeyValues::GetFunctionName() {
+  static const std::string kBindKeyValuesFnName =
+#ifdef __APPLE__
+      "_ZN7peloton7codegen5utils17IndexScanIterator13BindKeyValuesEv";
+#else
+      "_ZN7peloton7codegen5utils17IndexScanIterator13BindKeyValuesEv";
+#endif
+  return kBindKeyValuesFnName;
+}
+
+llvm::Function *IndexScanIteratorProxy::_BindKeyValues::GetFunction(
+    CodeGen &codegen) {
+  const std::string &fn_name = GetFunctionName();
+
+  // Has the function already been registered?
+  llvm::Function *llvm_fn = codegen.LookupFunction(fn_name);
+  if (llvm_fn != nullptr) {
+    return llvm_fn;
+  }
+
+  // The function hasn't been registered, let's do it now ...
+  auto *iterator_ptr_type =
+      IndexScanIteratorProxy::GetType(codegen)->getPointerTo();
+  std::vector<llvm::Type *> fn_args = {iterator_ptr_type};
+  llvm::FunctionType *fn_type =
+      llvm::FunctionType::get(codegen.VoidType(), fn_args, false);
+  return codegen.RegisterFunction(fn_name, fn_type);
+}
+
+//===--------------------------------------------------------------------===//
+// The proxy for codegen::utils::IndexScanIterator::Scan()
+//===--------------------------------------------------------------------===//
+const std::string &IndexScanIteratorProxy::_Scan::GetFunctionName() {
+  static const std::string kScanFnName =
+#ifdef __APPLE__
+      "_ZN7peloton7codegen5utils17IndexScanIterator4ScanERNS_11concurrency11TransactionEj";
+#else
+      "_ZN7peloton7codegen5utils17IndexScanIterator4ScanERNS_11concurrency11TransactionEj";
+#endif
+  return kScanFnName;
+}
+
+llvm::Function *IndexScanIteratorProxy::_Scan::GetFunction(
+    CodeGen &codegen) {
+  const std::string &fn_name = GetFunctionName();
+
+  // Has the function already been registered?
+  llvm::Function *llvm_fn = codegen.LookupFunction(fn_name);
+  if (llvm_fn != nullptr) {
+    return llvm_fn;
+  }
+
+  // The function hasn't been registered, let's do it now ...
+  auto *iterator_ptr_type =
+      IndexScanIteratorProxy::GetType(codegen)->getPointerTo();
+  std::vector<llvm::Type *> fn_args = {
+      iterator_ptr_type,
+      TransactionProxy::GetType(codegen)->getPointerTo(),
+      codegen.Int32Type()};
+  llvm::FunctionType *fn_type =
+      llvm::FunctionType::get(codegen.Int32Type(), fn_args, false);
+  return codegen.RegisterFunction(fn_name, fn_type);
+}
+
+//===--------------------------------------------------------------------===//
+// The proxy for codegen::utils::IndexScanIterator::GetTileGroup()
+//===--------------------------------------------------------------------===//
+const std::string &IndexScanIteratorProxy::_GetTileGroup::GetFunctionName() {
+  static const std::string kGetTileGroupFnName =
+#ifdef __APPLE__
+      "_ZNK7peloton7codegen5utils17IndexScanIterator12GetTileGroupEj";
+#else
+      "_ZNK7peloton7codegen5utils17IndexScanIterator12GetTileGroupEj";
+#endif
+  return kGetTileGroupFnName;
+}
+
+llvm::Function *IndexScanIteratorProxy::_GetTileGroup::GetFunction(
+    CodeGen &codegen) {
+  const std::string &fn_name = GetFunctionName();
+
+  // Has the function already been registered?
+  llvm::Function *llvm_fn = codegen.LookupFunction(fn_name);
+  if (llvm_fn != nullptr) {
+    return llvm_fn;
+  }
+
+  // The function hasn't been registered, let's do it now ...
+  auto *iterator_ptr_type =
+      IndexScanIteratorProxy::GetType(codegen)->getPointerTo();
+  std::vector<llvm::Type *> fn_args = {iterator_ptr_type, codegen.Int32Type()};
+  llvm::FunctionType *fn_type = llvm::FunctionType::get(
+      TileGroupProxy::GetType(codegen)->getPointerTo(), fn_args, false);
+  return codegen.RegisterFunction(fn_name, fn_type);
+}
+
+//===--------------------------------------------------------------------===//
+// The proxy for codegen::utils::IndexScanIterator::GetTuples()
+//===--------------------------------------------------------------------===//
+const std::string &IndexScanIteratorProxy::_GetTuples::GetFunctionName() {
+  static const std::string kGetTuplesFnName =
+#ifdef __APPLE__
+      "_ZNK7peloton7codegen5utils17IndexScanIterator9GetTuplesEjPj";
+#else
+      "_ZNK7peloton7codegen5utils17IndexScanIterator9GetTuplesEjPj";
+#endif
+  return kGetTuplesFnName;
+}
+
+llvm::Function *IndexScanIteratorProxy::_GetTuples::GetFunction(
+    CodeGen &codegen) {
+  const std::string &fn_name = GetFunctionName();
+
+  // Has the function already been registered?
+  llvm::Function *llvm_fn = codegen.LookupFunction(fn_name);
+  if (llvm_fn != nullptr) {
+    return llvm_fn;
+  }
+
+  // The function hasn't been registered, let's do it now ...
+  auto *iterator_ptr_type =
+      IndexScanIteratorProxy::GetType(codegen)->getPointerTo();
+  std::vector<llvm::Type *> fn_args = {
+      iterator_ptr_type,
+      codegen.Int32Type(),
+      codegen.Int32Type()->getPointerTo()};
+  llvm::FunctionType *fn_type =
+      llvm::FunctionType::get(codegen.Int32Type(), fn_args, false);
+  return codegen.RegisterFunction(fn_name, fn_type);
+}
+
+//===--------------------------------------------------------------------===//
+// The proxy for codegen::utils::IndexScanIterator::Destroy()
+//===--------------------------------------------------------------------===//
+const std::string &IndexScanIteratorProxy::_Destroy::GetFunctionName() {
+  static const std::string kDestroyFnName =
+#ifdef __APPLE__
+      "_ZN7peloton7codegen5utils17IndexScanIterator7DestroyEv";
+#else
+      "_ZN7peloton7codegen5utils17IndexScanIterator7DestroyEv";
+#endif
+  return kDestroyFnName;
+}
+
+llvm::Function *IndexScanIteratorProxy::_Destroy::GetFunction(
+    CodeGen &codegen) {
+  const std::string &fn_name = GetFunctionName();
+
+  // Has the function already been registered?
+  llvm::Function *llvm_fn = codegen.LookupFunction(fn_name);
+  if (llvm_fn != nullptr) {
+    return llvm_fn;
+  }
+
+  // The function hasn't been registered, let's do it now ...
+  auto *iterator_ptr_type =
+      IndexScanIteratorProxy::GetType(codegen)->getPointerTo();
+  std::vector<llvm::Type *> fn_args = {iterator_ptr_type};
+  llvm::FunctionType *fn_type =
+      llvm::FunctionType::get(codegen.VoidType(), fn_args, false);
+  return codegen.RegisterFunction(fn_name, fn_type);
+}
+
+}  // namespace codegen
+}  // namespace peloton
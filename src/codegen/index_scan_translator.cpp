@@ -0,0 +1,299 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// index_scan_translator.cpp
+//
+// Identification: src/codegen/index_scan_translator.cpp
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "codegen/index_scan_translator.h"
+
+#include "codegen/index_scan_iterator_proxy.h"
+#include "codegen/loop.h"
+#include "codegen/runtime_functions_proxy.h"
+#include "codegen/value_proxy.h"
+#include "codegen/values_runtime_proxy.h"
+#include "index/index.h"
+#include "planner/index_scan_plan.h"
+#include "storage/data_table.h"
+
+namespace peloton {
+namespace codegen {
+
+//===----------------------------------------------------------------------===//
+// INDEX SCAN TRANSLATOR
+//===----------------------------------------------------------------------===//
+
+// Constructor
+IndexScanTranslator::IndexScanTranslator(const planner::IndexScanPlan &scan,
+                                         CompilationContext &context,
+                                         Pipeline &pipeline)
+    : OperatorTranslator(context, pipeline),
+      scan_(scan),
+      tile_group_(*scan_.GetTable()->GetSchema()) {
+  LOG_DEBUG("Constructing IndexScanTranslator ...");
+
+  // The restriction, if one exists
+  const auto *predicate = GetScanPlan().GetPredicate();
+  if (predicate != nullptr) {
+    context.Prepare(*predicate);
+  }
+
+  auto &codegen = GetCodeGen();
+  auto &runtime_state = context.GetRuntimeState();
+  iterator_id_ = runtime_state.RegisterState(
+      "indexScan", IndexScanIteratorProxy::GetType(codegen));
+  selection_vector_id_ = runtime_state.RegisterState(
+      "indexScanSelVec",
+      codegen.VectorType(codegen.Int32Type(), Vector::kDefaultVectorSize),
+      true);
+
+  // The layouts of the tile groups the tuples are in live on the stack, so
+  // that an index scan inside a nested loop doesn't allocate them every time
+  uint32_t num_columns = GetTable().GetSchema()->GetColumnCount();
+  column_layouts_id_ = runtime_state.RegisterState(
+      "indexScanLayouts",
+      codegen.VectorType(
+          RuntimeFunctionsProxy::_ColumnLayoutInfo::GetType(codegen),
+          num_columns),
+      true);
+
+  LOG_DEBUG("Finished constructing IndexScanTranslator ...");
+}
+
+// Set up the iterator for the plan. The plan outlives the compiled query.
+void IndexScanTranslator::InitializeState() {
+  auto &codegen = GetCodeGen();
+  llvm::Value *plan_ptr = codegen->CreateIntToPtr(
+      codegen.Const64(reinterpret_cast<int64_t>(&GetScanPlan())),
+      codegen.CharPtrType());
+  codegen.CallFunc(IndexScanIteratorProxy::_Init::GetFunction(codegen),
+                   {LoadStatePtr(iterator_id_), plan_ptr});
+}
+
+// Produce!
+void IndexScanTranslator::Produce() const {
+  auto &codegen = GetCodeGen();
+  auto &compilation_ctx = GetCompilationContext();
+
+  LOG_DEBUG("IndexScan on [%u] starting to produce tuples ...",
+            GetTable().GetOid());
+
+  llvm::Value *iterator_ptr = LoadStatePtr(iterator_id_);
+  llvm::Value *column_layouts = LoadStateValue(column_layouts_id_);
+
+  // The output buffer for the scan
+  Vector selection_vector{LoadStateValue(selection_vector_id_),
+                          Vector::kDefaultVectorSize, codegen.Int32Type()};
+
+  // Look up the index
+  llvm::Value *num_batches = codegen.CallFunc(
+      IndexScanIteratorProxy::_Scan::GetFunction(codegen),
+      {iterator_ptr, compilation_ctx.GetTransactionPtr(),
+       codegen.Const32(selection_vector.GetCapacity())});
+
+  // Push every batch of tuples the lookup found through the pipeline
+  llvm::Value *batch_idx = codegen.Const32(0);
+  Loop batch_loop{codegen,
+                  codegen->CreateICmpULT(batch_idx, num_batches),
+                  {{"batchIdx", batch_idx}}};
+  {
+    batch_idx = batch_loop.GetLoopVar(0);
+
+    // Get the tile group of the batch and the TIDs of its tuples
+    llvm::Value *tile_group_ptr = codegen.CallFunc(
+        IndexScanIteratorProxy::_GetTileGroup::GetFunction(codegen),
+        {iterator_ptr, batch_idx});
+    llvm::Value *num_tuples = codegen.CallFunc(
+        IndexScanIteratorProxy::_GetTuples::GetFunction(codegen),
+        {iterator_ptr, batch_idx, selection_vector.GetVectorPtr()});
+    selection_vector.SetNumElements(num_tuples);
+
+    TileGroup::TileGroupAccess tile_group_access =
+        tile_group_.GetAccess(codegen, tile_group_ptr, column_layouts);
+
+    // Filter the tuples by the predicate (if one exists)
+    if (GetScanPlan().GetPredicate() != nullptr) {
+      FilterRowsByPredicate(codegen, tile_group_access, selection_vector);
+    }
+
+    // Setup the (filtered) row batch with accessors for the output columns
+    RowBatch batch{compilation_ctx, codegen.Const32(0), num_tuples,
+                   selection_vector, true};
+
+    std::vector<const planner::AttributeInfo *> ais;
+    GetScanPlan().GetAttributes(ais);
+    const auto &output_col_ids = GetScanPlan().GetColumnIds();
+
+    std::vector<AttributeAccess> attribute_accesses;
+    for (oid_t col_idx = 0; col_idx < output_col_ids.size(); col_idx++) {
+      attribute_accesses.emplace_back(tile_group_access,
+                                      ais[output_col_ids[col_idx]]);
+    }
+    for (oid_t col_idx = 0; col_idx < output_col_ids.size(); col_idx++) {
+      batch.AddAttribute(ais[output_col_ids[col_idx]],
+                         &attribute_accesses[col_idx]);
+    }
+
+    // Push the batch into the pipeline
+    ConsumerContext context{compilation_ctx, GetPipeline()};
+    context.Consume(batch);
+
+    // Move to the next batch, unless the pipeline is done
+    batch_idx = codegen->CreateAdd(batch_idx, codegen.Const32(1));
+    llvm::Value *more_batches = codegen->CreateICmpULT(batch_idx, num_batches);
+    llvm::Value *done = GetPipeline().IsDone(codegen);
+    if (done != nullptr) {
+      more_batches = codegen->CreateAnd(more_batches, codegen->CreateNot(done));
+    }
+    batch_loop.LoopEnd(more_batches, {batch_idx});
+  }
+
+  LOG_DEBUG("IndexScan on [%u] finished producing tuples ...",
+            GetTable().GetOid());
+}
+
+// Release everything the iterator holds
+void IndexScanTranslator::TearDownState() {
+  auto &codegen = GetCodeGen();
+  codegen.CallFunc(IndexScanIteratorProxy::_Destroy::GetFunction(codegen),
+                   {LoadStatePtr(iterator_id_)});
+}
+
+// Get the stringified name of this scan
+std::string IndexScanTranslator::GetName() const {
+  return "IndexScan('" + GetTable().GetName() + "', '" +
+         GetScanPlan().GetIndex()->GetName() + "')";
+}
+
+// Write the values into the iterator's key values, then let the iterator
+// rebuild the keys it looks up the index with
+void IndexScanTranslator::BindKeyValues(
+    CodeGen &codegen, const std::vector<uint32_t> &key_indexes,
+    const std::vector<codegen::Value> &values) const {
+  PL_ASSERT(key_indexes.size() == values.size());
+
+  llvm::Value *iterator_ptr = LoadStatePtr(iterator_id_);
+  llvm::Value *key_values = codegen->CreateBitCast(
+      codegen.CallFunc(
+          IndexScanIteratorProxy::_GetKeyValues::GetFunction(codegen),
+          {iterator_ptr}),
+      ValueProxy::GetType(codegen)->getPointerTo());
+
+  for (uint32_t i = 0; i < values.size(); i++) {
+    const auto &val = values[i];
+    llvm::Value *idx = codegen.Const64(key_indexes[i]);
+    switch (val.GetType()) {
+      case type::Type::TypeId::TINYINT: {
+        codegen.CallFunc(
+            ValuesRuntimeProxy::_OutputTinyInt::GetFunction(codegen),
+            {key_values, idx, val.GetValue()});
+        break;
+      }
+      case type::Type::TypeId::SMALLINT: {
+        codegen.CallFunc(
+            ValuesRuntimeProxy::_OutputSmallInt::GetFunction(codegen),
+            {key_values, idx, val.GetValue()});
+        break;
+      }
+      case type::Type::TypeId::DATE:
+      case type::Type::TypeId::INTEGER: {
+        codegen.CallFunc(
+            ValuesRuntimeProxy::_OutputInteger::GetFunction(codegen),
+            {key_values, idx, val.GetValue()});
+        break;
+      }
+      case type::Type::TypeId::TIMESTAMP: {
+        codegen.CallFunc(
+            ValuesRuntimeProxy::_OutputTimestamp::GetFunction(codegen),
+            {key_values, idx, val.GetValue()});
+        break;
+      }
+      case type::Type::TypeId::BIGINT: {
+        codegen.CallFunc(
+            ValuesRuntimeProxy::_OutputBigInt::GetFunction(codegen),
+            {key_values, idx, val.GetValue()});
+        break;
+      }
+      case type::Type::TypeId::DECIMAL: {
+        codegen.CallFunc(
+            ValuesRuntimeProxy::_OutputDouble::GetFunction(codegen),
+            {key_values, idx, val.GetValue()});
+        break;
+      }
+      case type::Type::TypeId::VARCHAR: {
+        codegen.CallFunc(
+            ValuesRuntimeProxy::_OutputVarchar::GetFunction(codegen),
+            {key_values, idx, val.GetValue(), val.GetLength()});
+        break;
+      }
+      default: {
+        std::string msg = StringUtil::Format(
+            "Can't bind value type '%s' to an index key",
+            TypeIdToString(val.GetType()).c_str());
+        throw Exception{msg};
+      }
+    }
+  }
+
+  codegen.CallFunc(
+      IndexScanIteratorProxy::_BindKeyValues::GetFunction(codegen),
+      {iterator_ptr});
+}
+
+// Filter the rows of the batch in the selection vector by the predicate
+void IndexScanTranslator::FilterRowsByPredicate(
+    CodeGen &codegen, const TileGroup::TileGroupAccess &access,
+    Vector &selection_vector) const {
+  const auto *predicate = GetScanPlan().GetPredicate();
+
+  RowBatch batch{GetCompilationContext(), codegen.Const32(0),
+                 selection_vector.GetNumElements(), selection_vector, true};
+
+  // Setup the row batch with attribute accessors for the predicate
+  std::unordered_set<const planner::AttributeInfo *> used_attributes;
+  predicate->GetUsedAttributes(used_attributes);
+
+  std::vector<AttributeAccess> attribute_accessors;
+  for (const auto *ai : used_attributes) {
+    attribute_accessors.emplace_back(access, ai);
+  }
+  for (auto &accessor : attribute_accessors) {
+    batch.AddAttribute(accessor.GetAttributeRef(), &accessor);
+  }
+
+  // Iterate over the batch using a scalar loop
+  batch.Iterate(codegen, [&](RowBatch::Row &row) {
+    // Evaluate the predicate to determine row validity
+    codegen::Value valid_row = row.DeriveValue(codegen, *predicate);
+
+    // Set the validity of the row
+    row.SetValidity(codegen, valid_row.GetValue());
+  });
+}
+
+// Table accessor
+const storage::DataTable &IndexScanTranslator::GetTable() const {
+  return *scan_.GetTable();
+}
+
+//===----------------------------------------------------------------------===//
+// ATTRIBUTE ACCESS
+//===----------------------------------------------------------------------===//
+
+IndexScanTranslator::AttributeAccess::AttributeAccess(
+    const TileGroup::TileGroupAccess &access, const planner::AttributeInfo *ai)
+    : tile_group_access_(access), ai_(ai) {}
+
+codegen::Value IndexScanTranslator::AttributeAccess::Access(
+    CodeGen &codegen, RowBatch::Row &row) {
+  auto raw_row = tile_group_access_.GetRow(row.GetTID(codegen));
+  return raw_row.LoadColumn(codegen, ai_->attribute_id);
+}
+
+}  // namespace codegen
+}  // namespace peloton
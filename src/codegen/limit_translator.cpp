@@ -0,0 +1,100 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// limit_translator.cpp
+//
+// Identification: src/codegen/limit_translator.cpp
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "codegen/limit_translator.h"
+
+#include "codegen/if.h"
+#include "common/logger.h"
+#include "planner/limit_plan.h"
+
+namespace peloton {
+namespace codegen {
+
+//===----------------------------------------------------------------------===//
+// LIMIT TRANSLATOR
+//===----------------------------------------------------------------------===//
+
+// Constructor
+LimitTranslator::LimitTranslator(const planner::LimitPlan &plan,
+                                 CompilationContext &context,
+                                 Pipeline &pipeline)
+    : OperatorTranslator(context, pipeline), plan_(plan) {
+  LOG_DEBUG("Constructing LimitTranslator ...");
+
+  // The child feeds us rows in the same pipeline
+  context.Prepare(*plan.GetChild(0), pipeline);
+
+  // Workers with private copies of the counter would each let through up to
+  // the limit, so the rows must all be counted by one thread
+  pipeline.SetSerial();
+
+  auto &codegen = GetCodeGen();
+  auto &runtime_state = context.GetRuntimeState();
+  count_id_ = runtime_state.RegisterState("limitCount", codegen.Int64Type());
+
+  LOG_DEBUG("Finished constructing LimitTranslator ...");
+}
+
+// No rows have been seen
+void LimitTranslator::InitializeState() {
+  auto &codegen = GetCodeGen();
+  codegen->CreateStore(codegen.Const64(0), LoadStatePtr(count_id_));
+}
+
+// Let the child produce the rows
+void LimitTranslator::Produce() const {
+  GetCompilationContext().Produce(*GetPlan().GetChild(0));
+}
+
+// Count the row, and send it to the parent if it's between the offset and the
+// limit
+void LimitTranslator::Consume(ConsumerContext &context,
+                              RowBatch::Row &row) const {
+  auto &codegen = GetCodeGen();
+
+  llvm::Value *count_ptr = LoadStatePtr(count_id_);
+  llvm::Value *count =
+      codegen->CreateAdd(codegen->CreateLoad(count_ptr), codegen.Const64(1));
+  codegen->CreateStore(count, count_ptr);
+
+  const auto &plan = GetPlan();
+  uint64_t offset = plan.GetOffset();
+  uint64_t end = offset + plan.GetLimit();
+  llvm::Value *in_range = codegen->CreateAnd(
+      codegen->CreateICmpUGT(count, codegen.Const64(offset)),
+      codegen->CreateICmpULE(count, codegen.Const64(end)));
+
+  If is_in_range{codegen, in_range};
+  {
+    // Send the row up to the parent
+    context.Consume(row);
+  }
+  is_in_range.EndIf();
+}
+
+// Once offset + limit rows were counted, the rest would be dropped anyway
+llvm::Value *LimitTranslator::IsDone() const {
+  auto &codegen = GetCodeGen();
+  const auto &plan = GetPlan();
+  uint64_t end = plan.GetOffset() + plan.GetLimit();
+  return codegen->CreateICmpUGE(LoadStateValue(count_id_),
+                                codegen.Const64(end));
+}
+
+// Get the stringified name of this limit
+std::string LimitTranslator::GetName() const {
+  return "Limit(" + std::to_string(GetPlan().GetLimit()) + ", " +
+         std::to_string(GetPlan().GetOffset()) + ")";
+}
+
+}  // namespace codegen
+}  // namespace peloton
@@ -0,0 +1,326 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// merge_join_translator.cpp
+//
+// Identification: src/codegen/merge_join_translator.cpp
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "codegen/merge_join_translator.h"
+
+#include "codegen/loop.h"
+#include "codegen/sorter_proxy.h"
+#include "codegen/vector.h"
+#include "codegen/vectorized_loop.h"
+#include "common/logger.h"
+#include "planner/merge_join_plan.h"
+
+namespace peloton {
+namespace codegen {
+
+//===----------------------------------------------------------------------===//
+// MERGE JOIN TRANSLATOR
+//===----------------------------------------------------------------------===//
+
+// Constructor
+MergeJoinTranslator::MergeJoinTranslator(const planner::MergeJoinPlan &join,
+                                         CompilationContext &context,
+                                         Pipeline &pipeline)
+    : OperatorTranslator(context, pipeline),
+      join_(join),
+      left_pipeline_(this),
+      right_pipeline_(this) {
+  LOG_DEBUG("Constructing MergeJoinTranslator ...");
+
+  PL_ASSERT(join.GetJoinType() == JoinType::INNER);
+
+  auto &codegen = GetCodeGen();
+  auto &runtime_state = context.GetRuntimeState();
+
+  // Prepare translators for the left and right input operators
+  context.Prepare(*join.GetChild(0), left_pipeline_);
+  context.Prepare(*join.GetChild(1), right_pipeline_);
+
+  // Prepare the expressions of the join clauses, and the predicate
+  const auto &join_clauses = *join.GetJoinClauses();
+  PL_ASSERT(!join_clauses.empty());
+  num_keys_ = static_cast<uint32_t>(join_clauses.size());
+
+  std::vector<type::Type::TypeId> left_types, right_types;
+  for (const auto &join_clause : join_clauses) {
+    context.Prepare(*join_clause.left_);
+    context.Prepare(*join_clause.right_);
+    left_types.push_back(join_clause.left_->GetValueType());
+    right_types.push_back(join_clause.right_->GetValueType());
+  }
+
+  auto *predicate = join.GetPredicate();
+  if (predicate != nullptr) {
+    context.Prepare(*predicate);
+  }
+
+  // Every side is buffered with the keys first, followed by the attributes
+  // the join produces from that side
+  for (const auto *left_ai : join.GetLeftAttributes()) {
+    left_types.push_back(left_ai->type);
+  }
+  for (const auto *right_ai : join.GetRightAttributes()) {
+    right_types.push_back(right_ai->type);
+  }
+  left_buffer_ = Sorter{codegen, left_types};
+  right_buffer_ = Sorter{codegen, right_types};
+
+  left_buffer_id_ = runtime_state.RegisterState(
+      "mjLeftBuffer", SorterProxy::GetType(codegen));
+  right_buffer_id_ = runtime_state.RegisterState(
+      "mjRightBuffer", SorterProxy::GetType(codegen));
+
+  selection_vector_id_ = runtime_state.RegisterState(
+      "mjSelVec",
+      codegen.VectorType(codegen.Int32Type(), Vector::kDefaultVectorSize),
+      true);
+
+  LOG_DEBUG("Finished constructing MergeJoinTranslator ...");
+}
+
+// Initialize the buffers of both sides. They are never sorted, the children
+// already produce sorted input.
+void MergeJoinTranslator::InitializeState() {
+  auto &codegen = GetCodeGen();
+  left_buffer_.Init(codegen, LoadStatePtr(left_buffer_id_), nullptr);
+  right_buffer_.Init(codegen, LoadStatePtr(right_buffer_id_), nullptr);
+}
+
+//===----------------------------------------------------------------------===//
+// Once both sides are buffered, we merge them with the following logic:
+//
+// r = 0
+// for (l = 0; l < nl && r < nr; l++) {
+//   while (r < nr && right[r] < left[l]) r++
+//   end = r
+//   while (end < nr && right[end] == left[l]) end++
+//   join left[l] with right[r, end)
+// }
+//
+// The scan of the right side restarts at the first match of the previous left
+// row, so duplicate keys on both sides produce all their pairs.
+//===----------------------------------------------------------------------===//
+void MergeJoinTranslator::Produce() const {
+  // Let both children produce their tuples, which we buffer
+  GetCompilationContext().Produce(*join_.GetChild(0));
+  GetCompilationContext().Produce(*join_.GetChild(1));
+
+  auto &codegen = GetCodeGen();
+  auto *left_buffer_ptr = LoadStatePtr(left_buffer_id_);
+  auto *right_buffer_ptr = LoadStatePtr(right_buffer_id_);
+
+  llvm::Value *num_left =
+      left_buffer_.GetNumberOfStoredTuples(codegen, left_buffer_ptr);
+  llvm::Value *num_right =
+      right_buffer_.GetNumberOfStoredTuples(codegen, right_buffer_ptr);
+
+  llvm::Value *left_idx = codegen.Const32(0);
+  llvm::Value *right_idx = codegen.Const32(0);
+  llvm::Value *merge_cond =
+      codegen->CreateAnd(codegen->CreateICmpULT(left_idx, num_left),
+                         codegen->CreateICmpULT(right_idx, num_right));
+  Loop merge_loop{codegen, merge_cond, {{"l", left_idx}, {"r", right_idx}}};
+  {
+    left_idx = merge_loop.GetLoopVar(0);
+    right_idx = merge_loop.GetLoopVar(1);
+
+    // Pull out the current left row
+    auto left_access = left_buffer_.GetAccess(codegen, left_buffer_ptr);
+    auto &left_row = left_access.GetRow(left_idx);
+    std::vector<codegen::Value> left_keys, left_vals;
+    for (uint32_t i = 0; i < num_keys_; i++) {
+      left_keys.push_back(left_row.LoadColumn(codegen, i));
+    }
+    for (uint32_t i = 0; i < join_.GetLeftAttributes().size(); i++) {
+      left_vals.push_back(left_row.LoadColumn(codegen, num_keys_ + i));
+    }
+
+    // Find the run of right rows with the same keys
+    llvm::Value *match_start =
+        AdvanceRight(codegen, left_keys, num_right, right_idx, false);
+    llvm::Value *match_end =
+        AdvanceRight(codegen, left_keys, num_right, match_start, true);
+
+    ProduceMatches(codegen, left_vals, match_start, match_end);
+
+    left_idx = codegen->CreateAdd(left_idx, codegen.Const32(1));
+    merge_cond =
+        codegen->CreateAnd(codegen->CreateICmpULT(left_idx, num_left),
+                           codegen->CreateICmpULT(match_start, num_right));
+    merge_loop.LoopEnd(merge_cond, {left_idx, match_start});
+  }
+}
+
+// Buffer the rows of either side
+void MergeJoinTranslator::Consume(ConsumerContext &context,
+                                  RowBatch::Row &row) const {
+  auto &codegen = GetCodeGen();
+
+  bool from_left = &context.GetPipeline() == &left_pipeline_;
+  const auto &ais =
+      from_left ? join_.GetLeftAttributes() : join_.GetRightAttributes();
+
+  std::vector<codegen::Value> tuple;
+  for (const auto &join_clause : *join_.GetJoinClauses()) {
+    const auto &key = from_left ? join_clause.left_ : join_clause.right_;
+    tuple.push_back(row.DeriveValue(codegen, *key));
+  }
+  for (const auto *ai : ais) {
+    tuple.push_back(row.DeriveValue(codegen, ai));
+  }
+
+  if (from_left) {
+    left_buffer_.Append(codegen, LoadStatePtr(left_buffer_id_), tuple);
+  } else {
+    right_buffer_.Append(codegen, LoadStatePtr(right_buffer_id_), tuple);
+  }
+}
+
+// Cleanup by destroying both buffers
+void MergeJoinTranslator::TearDownState() {
+  auto &codegen = GetCodeGen();
+  left_buffer_.Destroy(codegen, LoadStatePtr(left_buffer_id_));
+  right_buffer_.Destroy(codegen, LoadStatePtr(right_buffer_id_));
+}
+
+std::string MergeJoinTranslator::GetName() const {
+  return "MergeJoin::Inner";
+}
+
+llvm::Value *MergeJoinTranslator::CompareKeys(
+    CodeGen &codegen, const std::vector<codegen::Value> &left_keys,
+    llvm::Value *right_idx) const {
+  auto right_access =
+      right_buffer_.GetAccess(codegen, LoadStatePtr(right_buffer_id_));
+  auto &right_row = right_access.GetRow(right_idx);
+
+  // The first key that differs decides
+  codegen::Value result =
+      left_keys[0].CompareForSort(codegen, right_row.LoadColumn(codegen, 0));
+  const codegen::Value zero{type::Type::TypeId::INTEGER, codegen.Const32(0)};
+  for (uint32_t i = 1; i < num_keys_; i++) {
+    auto comp_result =
+        left_keys[i].CompareForSort(codegen, right_row.LoadColumn(codegen, i));
+    auto prev_zero = result.CompareEq(codegen, zero);
+    result = codegen::Value{
+        type::Type::TypeId::INTEGER,
+        codegen->CreateSelect(prev_zero.GetValue(), comp_result.GetValue(),
+                              result.GetValue())};
+  }
+  return result.GetValue();
+}
+
+llvm::Value *MergeJoinTranslator::AdvanceRight(
+    CodeGen &codegen, const std::vector<codegen::Value> &left_keys,
+    llvm::Value *num_right, llvm::Value *right_idx, bool equal) const {
+  // Both parts of the condition are evaluated, so past the end we compare
+  // against the last right row. The result doesn't matter then.
+  auto advance_cond = [&](llvm::Value *idx) {
+    llvm::Value *in_bounds = codegen->CreateICmpULT(idx, num_right);
+    llvm::Value *last_idx = codegen->CreateSub(num_right, codegen.Const32(1));
+    llvm::Value *safe_idx = codegen->CreateSelect(in_bounds, idx, last_idx);
+    llvm::Value *cmp = CompareKeys(codegen, left_keys, safe_idx);
+    llvm::Value *keep_going =
+        equal ? codegen->CreateICmpEQ(cmp, codegen.Const32(0))
+              : codegen->CreateICmpSGT(cmp, codegen.Const32(0));
+    return codegen->CreateAnd(in_bounds, keep_going);
+  };
+
+  Loop advance_loop{codegen, advance_cond(right_idx), {{"r", right_idx}}};
+  {
+    llvm::Value *next_idx = codegen->CreateAdd(advance_loop.GetLoopVar(0),
+                                               codegen.Const32(1));
+    advance_loop.LoopEnd(advance_cond(next_idx), {next_idx});
+  }
+
+  std::vector<llvm::Value *> final_vals;
+  advance_loop.CollectFinalLoopVariables(final_vals);
+  return final_vals[0];
+}
+
+void MergeJoinTranslator::ProduceMatches(
+    CodeGen &codegen, const std::vector<codegen::Value> &left_vals,
+    llvm::Value *start, llvm::Value *end) const {
+  auto &compilation_context = GetCompilationContext();
+  Vector selection_vector{LoadStateValue(selection_vector_id_),
+                          Vector::kDefaultVectorSize, codegen.Int32Type()};
+
+  // The run of right rows can be longer than the selection vector
+  llvm::Value *num_matches = codegen->CreateSub(end, start);
+  VectorizedLoop match_loop{
+      codegen, num_matches, selection_vector.GetCapacity(), {}};
+  {
+    auto curr_range = match_loop.GetCurrentRange();
+
+    // The rows of the batch are the indexes of the rows in the right buffer
+    RowBatch batch{compilation_context,
+                   codegen->CreateAdd(start, curr_range.start),
+                   codegen->CreateAdd(start, curr_range.end), selection_vector,
+                   false};
+
+    auto right_access =
+        right_buffer_.GetAccess(codegen, LoadStatePtr(right_buffer_id_));
+    std::vector<BufferAttributeAccess> right_accessors;
+    const auto &right_ais = join_.GetRightAttributes();
+    for (uint32_t i = 0; i < right_ais.size(); i++) {
+      right_accessors.emplace_back(right_access, num_keys_ + i);
+    }
+    for (uint32_t i = 0; i < right_ais.size(); i++) {
+      batch.AddAttribute(right_ais[i], &right_accessors[i]);
+    }
+
+    std::vector<ConstantAttributeAccess> left_accessors;
+    const auto &left_ais = join_.GetLeftAttributes();
+    for (uint32_t i = 0; i < left_ais.size(); i++) {
+      left_accessors.emplace_back(left_vals[i]);
+    }
+    for (uint32_t i = 0; i < left_ais.size(); i++) {
+      batch.AddAttribute(left_ais[i], &left_accessors[i]);
+    }
+
+    // Filter the pairs by the predicate
+    const auto *predicate = join_.GetPredicate();
+    if (predicate != nullptr) {
+      batch.Iterate(codegen, [&](RowBatch::Row &row) {
+        codegen::Value valid_row = row.DeriveValue(codegen, *predicate);
+        row.SetValidity(codegen, valid_row.GetValue());
+      });
+    }
+
+    // Send the batch up
+    ConsumerContext context{compilation_context, GetPipeline()};
+    context.Consume(batch);
+
+    match_loop.LoopEnd(codegen, {});
+  }
+}
+
+//===----------------------------------------------------------------------===//
+// ATTRIBUTE ACCESS
+//===----------------------------------------------------------------------===//
+
+MergeJoinTranslator::BufferAttributeAccess::BufferAttributeAccess(
+    Sorter::SorterAccess &buffer_access, uint32_t col_index)
+    : buffer_access_(buffer_access), col_index_(col_index) {}
+
+Value MergeJoinTranslator::BufferAttributeAccess::Access(CodeGen &codegen,
+                                                         RowBatch::Row &row) {
+  auto &buffered_row = buffer_access_.GetRow(row.GetTID(codegen));
+  return buffered_row.LoadColumn(codegen, col_index_);
+}
+
+MergeJoinTranslator::ConstantAttributeAccess::ConstantAttributeAccess(
+    const codegen::Value &value)
+    : value_(value) {}
+
+}  // namespace codegen
+}  // namespace peloton
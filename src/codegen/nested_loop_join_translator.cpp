@@ -0,0 +1,253 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// nested_loop_join_translator.cpp
+//
+// Identification: src/codegen/nested_loop_join_translator.cpp
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "codegen/nested_loop_join_translator.h"
+
+#include <algorithm>
+
+#include "codegen/if.h"
+#include "codegen/index_scan_translator.h"
+#include "codegen/sorter_proxy.h"
+#include "common/logger.h"
+#include "planner/index_scan_plan.h"
+#include "planner/nested_loop_join_plan.h"
+
+namespace peloton {
+namespace codegen {
+
+//===----------------------------------------------------------------------===//
+// NESTED LOOP JOIN TRANSLATOR
+//===----------------------------------------------------------------------===//
+
+// Constructor
+NestedLoopJoinTranslator::NestedLoopJoinTranslator(
+    const planner::NestedLoopJoinPlan &join, CompilationContext &context,
+    Pipeline &pipeline)
+    : OperatorTranslator(context, pipeline),
+      join_(join),
+      left_pipeline_(this),
+      index_scan_(nullptr) {
+  LOG_DEBUG("Constructing NestedLoopJoinTranslator ...");
+
+  PL_ASSERT(join.GetJoinType() == JoinType::INNER);
+
+  const auto &left_join_cols = join.GetJoinColumnsLeft();
+  const auto &right_join_cols = join.GetJoinColumnsRight();
+  PL_ASSERT(left_join_cols.size() == right_join_cols.size());
+
+  // If the right side is an index scan with a key on every join column, the
+  // join values of every left tuple can be used to look up the index
+  const auto &right = *join.GetChild(1);
+  bool use_index = !right_join_cols.empty() &&
+                   right.GetPlanNodeType() == PlanNodeType::INDEXSCAN;
+  if (use_index) {
+    const auto &index_scan = static_cast<const planner::IndexScanPlan &>(right);
+    const auto &column_ids = index_scan.GetColumnIds();
+    const auto &key_column_ids = index_scan.GetKeyColumnIds();
+    for (oid_t right_join_col : right_join_cols) {
+      PL_ASSERT(right_join_col < column_ids.size());
+      auto iter = std::find(key_column_ids.begin(), key_column_ids.end(),
+                            column_ids[right_join_col]);
+      if (iter == key_column_ids.end()) {
+        use_index = false;
+        break;
+      }
+      key_indexes_.push_back(
+          static_cast<uint32_t>(iter - key_column_ids.begin()));
+    }
+  }
+
+  // Prepare translators for the left and right input operators
+  context.Prepare(*join.GetChild(0), left_pipeline_);
+  context.Prepare(right, pipeline);
+
+  // Prepare the predicate
+  auto *predicate = join.GetPredicate();
+  if (predicate != nullptr) {
+    context.Prepare(*predicate);
+  }
+
+  // Collect the (unique) attributes we need from the left side
+  left_ais_ = join.GetJoinAttributesLeft();
+  for (const auto *left_ai : join.GetLeftAttributes()) {
+    if (std::find(left_ais_.begin(), left_ais_.end(), left_ai) ==
+        left_ais_.end()) {
+      left_ais_.push_back(left_ai);
+    }
+  }
+
+  if (use_index) {
+    index_scan_ = static_cast<const IndexScanTranslator *>(
+        context.GetTranslator(right));
+  } else {
+    key_indexes_.clear();
+
+    // Buffer the left side. Worker threads would read the buffer through a
+    // private copy of the runtime state, so the right side isn't parallel.
+    pipeline.SetSerial();
+
+    auto &codegen = GetCodeGen();
+    std::vector<type::Type::TypeId> left_types;
+    for (const auto *left_ai : left_ais_) {
+      left_types.push_back(left_ai->type);
+    }
+    buffer_ = Sorter{codegen, left_types};
+    buffer_id_ = context.GetRuntimeState().RegisterState(
+        "nljBuffer", SorterProxy::GetType(codegen));
+  }
+
+  LOG_DEBUG("Finished constructing NestedLoopJoinTranslator ...");
+}
+
+// Initialize the buffer of left tuples. It is never sorted.
+void NestedLoopJoinTranslator::InitializeState() {
+  if (!IsIndexJoin()) {
+    buffer_.Init(GetCodeGen(), LoadStatePtr(buffer_id_), nullptr);
+  }
+}
+
+// Produce!
+void NestedLoopJoinTranslator::Produce() const {
+  // Let the left child produce tuples. For index joins, the right side is
+  // produced from within the left side.
+  GetCompilationContext().Produce(*join_.GetChild(0));
+
+  // Let the right child produce the tuples we join with the buffered ones
+  if (!IsIndexJoin()) {
+    GetCompilationContext().Produce(*join_.GetChild(1));
+  }
+}
+
+// Consume the tuples produced by a child operator
+void NestedLoopJoinTranslator::Consume(ConsumerContext &context,
+                                       RowBatch::Row &row) const {
+  if (IsFromLeftChild(context)) {
+    ConsumeFromLeft(context, row);
+  } else {
+    ConsumeFromRight(context, row);
+  }
+}
+
+// The given row is coming from the left child. Either look up the matching
+// rows of the right side in the index, or buffer it.
+void NestedLoopJoinTranslator::ConsumeFromLeft(ConsumerContext &,
+                                               RowBatch::Row &row) const {
+  auto &codegen = GetCodeGen();
+
+  std::vector<codegen::Value> left_vals;
+  for (const auto *left_ai : left_ais_) {
+    left_vals.push_back(row.DeriveValue(codegen, left_ai));
+  }
+
+  if (!IsIndexJoin()) {
+    buffer_.Append(codegen, LoadStatePtr(buffer_id_), left_vals);
+    return;
+  }
+
+  // Look up the index with the values of the join columns
+  std::vector<codegen::Value> key_vals{
+      left_vals.begin(), left_vals.begin() + key_indexes_.size()};
+  index_scan_->BindKeyValues(codegen, key_indexes_, key_vals);
+
+  // The rows the index scan produces come back in ConsumeFromRight()
+  left_vals_ = left_vals;
+  GetCompilationContext().Produce(*join_.GetChild(1));
+  left_vals_.clear();
+}
+
+// The given row is from the right child. Join it with the left side.
+void NestedLoopJoinTranslator::ConsumeFromRight(ConsumerContext &context,
+                                                RowBatch::Row &row) const {
+  // The index lookup only found rows that match the current left row
+  if (IsIndexJoin()) {
+    JoinRows(context, row, left_vals_, false);
+    return;
+  }
+
+  // Try every buffered left row
+  struct JoinBuffered : public Sorter::IterateCallback {
+    const NestedLoopJoinTranslator &translator;
+    ConsumerContext &context;
+    RowBatch::Row &row;
+
+    JoinBuffered(const NestedLoopJoinTranslator &t, ConsumerContext &c,
+                 RowBatch::Row &r)
+        : translator(t), context(c), row(r) {}
+
+    void ProcessEntry(CodeGen &,
+                      const std::vector<codegen::Value> &vals) const override {
+      translator.JoinRows(context, row, vals, true);
+    }
+  };
+
+  JoinBuffered join_buffered{*this, context, row};
+  buffer_.Iterate(GetCodeGen(), LoadStatePtr(buffer_id_), join_buffered);
+}
+
+void NestedLoopJoinTranslator::JoinRows(
+    ConsumerContext &context, RowBatch::Row &row,
+    const std::vector<codegen::Value> &left_vals,
+    bool check_join_columns) const {
+  auto &codegen = GetCodeGen();
+
+  // Put the left values directly into the row
+  PL_ASSERT(left_vals.size() == left_ais_.size());
+  for (uint32_t i = 0; i < left_ais_.size(); i++) {
+    codegen::Value left_val = left_vals[i];
+    row.RegisterAttributeValue(left_ais_[i], left_val);
+  }
+
+  // The join columns must be equal, and the predicate must hold
+  codegen::Value valid_row;
+  if (check_join_columns) {
+    const auto &right_join_ais = join_.GetJoinAttributesRight();
+    for (uint32_t i = 0; i < right_join_ais.size(); i++) {
+      auto right_val = row.DeriveValue(codegen, right_join_ais[i]);
+      auto equal = left_vals[i].CompareEq(codegen, right_val);
+      valid_row = i == 0 ? equal : valid_row.LogicalAnd(codegen, equal);
+    }
+  }
+  auto *predicate = join_.GetPredicate();
+  if (predicate != nullptr) {
+    auto pred_val = row.DeriveValue(codegen, *predicate);
+    valid_row = valid_row.GetValue() == nullptr
+                    ? pred_val
+                    : valid_row.LogicalAnd(codegen, pred_val);
+  }
+
+  if (valid_row.GetValue() != nullptr) {
+    If is_valid_row{codegen, valid_row.GetValue()};
+    {
+      // Send row up to the parent
+      context.Consume(row);
+    }
+    is_valid_row.EndIf();
+  } else {
+    // Send the row up to the parent
+    context.Consume(row);
+  }
+}
+
+// Cleanup by destroying the buffer of left tuples
+void NestedLoopJoinTranslator::TearDownState() {
+  if (!IsIndexJoin()) {
+    buffer_.Destroy(GetCodeGen(), LoadStatePtr(buffer_id_));
+  }
+}
+
+std::string NestedLoopJoinTranslator::GetName() const {
+  return IsIndexJoin() ? "IndexNestedLoopJoin::Inner"
+                       : "NestedLoopJoin::Inner";
+}
+
+}  // namespace codegen
+}  // namespace peloton
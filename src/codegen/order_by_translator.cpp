@@ -36,6 +36,10 @@ OrderByTranslator::OrderByTranslator(const planner::OrderByPlan &plan,
   // Prepare the child
   context.Prepare(*plan.GetChild(0), child_pipeline_);
 
+  // The child can run in parallel. Every worker collects its input in a sorter
+  // of its own, and the sorters are concatenated and sorted once at the end.
+  child_pipeline_.SetParallel();
+
   auto &codegen = GetCodeGen();
 
   // Register the sorter instance
@@ -257,6 +261,25 @@ void OrderByTranslator::TearDownState() {
   sorter_.Destroy(GetCodeGen(), LoadStatePtr(sorter_id_));
 }
 
+// Every parallel worker materializes its input into a sorter of its own
+void OrderByTranslator::InitializeWorkerState() const {
+  sorter_.Init(GetCodeGen(), LoadStatePtr(sorter_id_), compare_func_);
+}
+
+// Move the worker's tuples into the main sorter. Everything is sorted at once
+// when the input has been consumed.
+void OrderByTranslator::MergeWorkerState(llvm::Value *worker_state) const {
+  auto &codegen = GetCodeGen();
+  auto &runtime_state = GetCompilationContext().GetRuntimeState();
+  sorter_.TransferFrom(
+      codegen, LoadStatePtr(sorter_id_),
+      runtime_state.LoadStatePtr(codegen, sorter_id_, worker_state));
+}
+
+void OrderByTranslator::TearDownWorkerState() const {
+  sorter_.Destroy(GetCodeGen(), LoadStatePtr(sorter_id_));
+}
+
 std::string OrderByTranslator::GetName() const { return "OrderBy"; }
 
 //===----------------------------------------------------------------------===//
@@ -12,16 +12,21 @@
 
 #include "codegen/pipeline.h"
 
+#include "codegen/codegen.h"
 #include "codegen/operator_translator.h"
 
 namespace peloton {
 namespace codegen {
 
+std::atomic<uint32_t> Pipeline::kDegreeOfParallelism{1};
+
 // Constructor
-Pipeline::Pipeline() : pipeline_index_(0) {}
+Pipeline::Pipeline()
+    : pipeline_index_(0), parallel_(false), serial_(false) {}
 
 // Constructor
-Pipeline::Pipeline(const OperatorTranslator *translator) {
+Pipeline::Pipeline(const OperatorTranslator *translator)
+    : parallel_(false), serial_(false) {
   Add(translator);
 }
 
@@ -97,6 +102,33 @@ uint32_t Pipeline::GetTranslatorStage(
   return GetNumStages() - stage - 1;
 }
 
+void Pipeline::SetParallel() { parallel_ = true; }
+
+void Pipeline::SetSerial() { serial_ = true; }
+
+// The degree of parallelism is read once, when the pipeline is compiled
+bool Pipeline::IsParallel() const {
+  return parallel_ && !serial_ && GetDegreeOfParallelism() > 1;
+}
+
+uint32_t Pipeline::GetDegreeOfParallelism() const {
+  return kDegreeOfParallelism.load();
+}
+
+// The pipeline is done once any of its operators is
+llvm::Value *Pipeline::IsDone(CodeGen &codegen) const {
+  llvm::Value *done = nullptr;
+  for (const auto *translator : pipeline_) {
+    llvm::Value *translator_done = translator->IsDone();
+    if (translator_done == nullptr) {
+      continue;
+    }
+    done = (done == nullptr) ? translator_done
+                             : codegen->CreateOr(done, translator_done);
+  }
+  return done;
+}
+
 // Get the stringified version of this pipeline
 std::string Pipeline::GetInfo() const {
   std::string result;
@@ -111,6 +143,11 @@ std::string Pipeline::GetInfo() const {
       result.append(" -> ");
     }
   }
+  if (IsParallel()) {
+    result.append(" (parallel: ")
+        .append(std::to_string(GetDegreeOfParallelism()))
+        .append(" threads)");
+  }
   return result;
 }
 
@@ -0,0 +1,373 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// plan_fingerprint.cpp
+//
+// Identification: src/codegen/plan_fingerprint.cpp
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "codegen/plan_fingerprint.h"
+
+#include <cstring>
+
+#include "catalog/schema.h"
+#include "codegen/pipeline.h"
+#include "expression/constant_value_expression.h"
+#include "expression/tuple_value_expression.h"
+#include "planner/aggregate_plan.h"
+#include "planner/hash_join_plan.h"
+#include "planner/hash_plan.h"
+#include "planner/limit_plan.h"
+#include "planner/merge_join_plan.h"
+#include "planner/nested_loop_join_plan.h"
+#include "planner/order_by_plan.h"
+#include "planner/projection_plan.h"
+#include "planner/seq_scan_plan.h"
+#include "storage/data_table.h"
+#include "type/value_peeker.h"
+
+namespace peloton {
+namespace codegen {
+
+// Constructor
+PlanFingerprint::PlanFingerprint(const planner::AbstractPlan &plan,
+                                 const std::vector<oid_t> &output_columns)
+    : cacheable_(true) {
+  // The degree of parallelism changes the code generated for scans
+  Append(Pipeline::kDegreeOfParallelism.load());
+
+  AddColumnIds(output_columns);
+  AddPlan(plan);
+
+  BuildParameterStorage();
+}
+
+bool PlanFingerprint::GetParameterSlot(
+    const expression::ConstantValueExpression &constant,
+    uint32_t &slot) const {
+  auto iter = parameter_slots_.find(&constant);
+  if (iter == parameter_slots_.end()) {
+    return false;
+  }
+  slot = iter->second;
+  return true;
+}
+
+void PlanFingerprint::AddPlan(const planner::AbstractPlan &plan) {
+  Append(plan.GetPlanNodeType());
+
+  switch (plan.GetPlanNodeType()) {
+    case PlanNodeType::SEQSCAN: {
+      auto &scan = static_cast<const planner::SeqScanPlan &>(plan);
+      auto *table = scan.GetTable();
+      Append(table->GetDatabaseOid());
+      Append(table->GetOid());
+      table_oids_.push_back(table->GetOid());
+      AddExpression(scan.GetPredicate());
+      AddColumnIds(scan.GetColumnIds());
+      break;
+    }
+    case PlanNodeType::PROJECTION: {
+      auto &projection = static_cast<const planner::ProjectionPlan &>(plan);
+      AddProjectInfo(projection.GetProjectInfo());
+      AddSchema(projection.GetSchema());
+      AddColumnIds(projection.GetColumnIds());
+      break;
+    }
+    case PlanNodeType::HASHJOIN: {
+      auto &join = static_cast<const planner::HashJoinPlan &>(plan);
+      Append(join.GetJoinType());
+      AddExpression(join.GetPredicate());
+      AddProjectInfo(join.GetProjInfo());
+      AddSchema(join.GetSchema());
+      std::vector<const expression::AbstractExpression *> keys;
+      join.GetLeftHashKeys(keys);
+      join.GetRightHashKeys(keys);
+      Append(keys.size());
+      for (const auto *key : keys) {
+        AddExpression(key);
+      }
+      AddColumnIds(join.GetOuterHashIds());
+      break;
+    }
+    case PlanNodeType::NESTLOOP: {
+      auto &join = static_cast<const planner::NestedLoopJoinPlan &>(plan);
+      Append(join.GetJoinType());
+      AddExpression(join.GetPredicate());
+      AddProjectInfo(join.GetProjInfo());
+      AddSchema(join.GetSchema());
+      AddColumnIds(join.GetJoinColumnsLeft());
+      AddColumnIds(join.GetJoinColumnsRight());
+      break;
+    }
+    case PlanNodeType::MERGEJOIN: {
+      auto &join = static_cast<const planner::MergeJoinPlan &>(plan);
+      Append(join.GetJoinType());
+      AddExpression(join.GetPredicate());
+      AddProjectInfo(join.GetProjInfo());
+      AddSchema(join.GetSchema());
+      Append(join.GetJoinClauses()->size());
+      for (const auto &join_clause : *join.GetJoinClauses()) {
+        AddExpression(join_clause.left_.get());
+        AddExpression(join_clause.right_.get());
+        Append(join_clause.reversed_);
+      }
+      break;
+    }
+    case PlanNodeType::HASH: {
+      auto &hash = static_cast<const planner::HashPlan &>(plan);
+      Append(hash.GetHashKeys().size());
+      for (const auto &key : hash.GetHashKeys()) {
+        AddExpression(key.get());
+      }
+      break;
+    }
+    case PlanNodeType::AGGREGATE_V2: {
+      auto &aggregate = static_cast<const planner::AggregatePlan &>(plan);
+      Append(aggregate.GetAggregateStrategy());
+      AddExpression(aggregate.GetPredicate());
+      AddProjectInfo(aggregate.GetProjectInfo());
+      Append(aggregate.GetUniqueAggTerms().size());
+      for (const auto &agg_term : aggregate.GetUniqueAggTerms()) {
+        Append(agg_term.aggtype);
+        Append(agg_term.distinct);
+        Append(agg_term.agg_ai.type);
+        AddExpression(agg_term.expression);
+      }
+      AddColumnIds(aggregate.GetGroupbyColIds());
+      AddSchema(aggregate.GetOutputSchema());
+      break;
+    }
+    case PlanNodeType::ORDERBY: {
+      auto &order_by = static_cast<const planner::OrderByPlan &>(plan);
+      AddColumnIds(order_by.GetSortKeys());
+      for (bool descend : order_by.GetDescendFlags()) {
+        Append(descend);
+      }
+      AddColumnIds(order_by.GetOutputColumnIds());
+      Append(order_by.GetUnderlyingOrder());
+      Append(order_by.GetLimit());
+      Append(order_by.GetLimitNumber());
+      Append(order_by.GetLimitOffset());
+      break;
+    }
+    case PlanNodeType::LIMIT: {
+      // The limit and offset are compiled into the code
+      auto &limit = static_cast<const planner::LimitPlan &>(plan);
+      Append(limit.GetLimit());
+      Append(limit.GetOffset());
+      break;
+    }
+    default: {
+      cacheable_ = false;
+      return;
+    }
+  }
+
+  Append(plan.GetChildren().size());
+  for (const auto &child : plan.GetChildren()) {
+    AddPlan(*child);
+  }
+}
+
+void PlanFingerprint::AddExpression(const expression::AbstractExpression *exp) {
+  if (exp == nullptr) {
+    Append(ExpressionType::INVALID);
+    return;
+  }
+
+  Append(exp->GetExpressionType());
+  Append(exp->GetValueType());
+
+  switch (exp->GetExpressionType()) {
+    case ExpressionType::VALUE_CONSTANT: {
+      AddParameter(
+          *static_cast<const expression::ConstantValueExpression *>(exp));
+      break;
+    }
+    case ExpressionType::VALUE_TUPLE: {
+      auto *tve = static_cast<const expression::TupleValueExpression *>(exp);
+      Append(tve->GetTupleId());
+      Append(tve->GetColumnId());
+      break;
+    }
+    case ExpressionType::COMPARE_EQUAL:
+    case ExpressionType::COMPARE_NOTEQUAL:
+    case ExpressionType::COMPARE_LESSTHAN:
+    case ExpressionType::COMPARE_GREATERTHAN:
+    case ExpressionType::COMPARE_LESSTHANOREQUALTO:
+    case ExpressionType::COMPARE_GREATERTHANOREQUALTO:
+    case ExpressionType::CONJUNCTION_AND:
+    case ExpressionType::CONJUNCTION_OR:
+    case ExpressionType::OPERATOR_PLUS:
+    case ExpressionType::OPERATOR_MINUS:
+    case ExpressionType::OPERATOR_MULTIPLY:
+    case ExpressionType::OPERATOR_DIVIDE:
+    case ExpressionType::OPERATOR_MOD:
+    case ExpressionType::OPERATOR_UNARY_MINUS: {
+      // Fully described by their type and their children
+      break;
+    }
+    default: {
+      cacheable_ = false;
+      return;
+    }
+  }
+
+  Append(exp->GetChildrenSize());
+  for (size_t i = 0; i < exp->GetChildrenSize(); i++) {
+    AddExpression(exp->GetChild(i));
+  }
+}
+
+void PlanFingerprint::AddParameter(
+    const expression::ConstantValueExpression &constant) {
+  type::Value value = constant.GetValue();
+
+  // The type of the constant is part of the structure, its value isn't
+  Append(value.GetTypeId());
+
+  uint32_t num_slots = 0;
+  switch (value.GetTypeId()) {
+    case type::Type::TypeId::TINYINT:
+    case type::Type::TypeId::SMALLINT:
+    case type::Type::TypeId::INTEGER:
+    case type::Type::TypeId::BIGINT:
+    case type::Type::TypeId::DECIMAL:
+    case type::Type::TypeId::DATE:
+    case type::Type::TypeId::TIMESTAMP: {
+      num_slots = 1;
+      break;
+    }
+    case type::Type::TypeId::VARCHAR: {
+      num_slots = 2;
+      break;
+    }
+    default: {
+      // Not something the code generator can produce
+      cacheable_ = false;
+      return;
+    }
+  }
+
+  parameter_slots_[&constant] = parameter_storage_.size();
+  parameter_storage_.resize(parameter_storage_.size() + num_slots, 0);
+  parameters_.push_back(value);
+}
+
+void PlanFingerprint::AddProjectInfo(const planner::ProjectInfo *project_info) {
+  if (project_info == nullptr) {
+    Append(false);
+    return;
+  }
+  Append(true);
+
+  const auto &target_list = project_info->GetTargetList();
+  Append(target_list.size());
+  for (const auto &target : target_list) {
+    Append(target.first);
+    Append(target.second.attribute_info.type);
+    AddExpression(target.second.expr);
+  }
+
+  const auto &direct_map_list = project_info->GetDirectMapList();
+  Append(direct_map_list.size());
+  for (const auto &direct_map : direct_map_list) {
+    Append(direct_map.first);
+    Append(direct_map.second.first);
+    Append(direct_map.second.second);
+  }
+}
+
+void PlanFingerprint::AddSchema(const catalog::Schema *schema) {
+  if (schema == nullptr) {
+    Append(false);
+    return;
+  }
+  Append(true);
+
+  Append(schema->GetColumnCount());
+  for (oid_t col_id = 0; col_id < schema->GetColumnCount(); col_id++) {
+    Append(schema->GetType(col_id));
+    Append(schema->IsInlined(col_id));
+  }
+}
+
+void PlanFingerprint::AddColumnIds(const std::vector<oid_t> &column_ids) {
+  Append(column_ids.size());
+  key_.append(reinterpret_cast<const char *>(column_ids.data()),
+              column_ids.size() * sizeof(oid_t));
+}
+
+void PlanFingerprint::BuildParameterStorage() {
+  uint32_t slot = 0;
+  for (const auto &value : parameters_) {
+    char *dst = reinterpret_cast<char *>(&parameter_storage_[slot]);
+    switch (value.GetTypeId()) {
+      case type::Type::TypeId::TINYINT: {
+        int8_t val = type::ValuePeeker::PeekTinyInt(value);
+        PL_MEMCPY(dst, &val, sizeof(val));
+        break;
+      }
+      case type::Type::TypeId::SMALLINT: {
+        int16_t val = type::ValuePeeker::PeekSmallInt(value);
+        PL_MEMCPY(dst, &val, sizeof(val));
+        break;
+      }
+      case type::Type::TypeId::INTEGER: {
+        int32_t val = type::ValuePeeker::PeekInteger(value);
+        PL_MEMCPY(dst, &val, sizeof(val));
+        break;
+      }
+      case type::Type::TypeId::BIGINT: {
+        int64_t val = type::ValuePeeker::PeekBigInt(value);
+        PL_MEMCPY(dst, &val, sizeof(val));
+        break;
+      }
+      case type::Type::TypeId::DECIMAL: {
+        double val = type::ValuePeeker::PeekDouble(value);
+        PL_MEMCPY(dst, &val, sizeof(val));
+        break;
+      }
+      case type::Type::TypeId::DATE: {
+        int32_t val = type::ValuePeeker::PeekDate(value);
+        PL_MEMCPY(dst, &val, sizeof(val));
+        break;
+      }
+      case type::Type::TypeId::TIMESTAMP: {
+        uint64_t val = type::ValuePeeker::PeekTimestamp(value);
+        PL_MEMCPY(dst, &val, sizeof(val));
+        break;
+      }
+      case type::Type::TypeId::VARCHAR: {
+        // Same as what the constant translator compiles in: the characters
+        // and the length of the string without its terminator. A NULL string
+        // is a null pointer with a length of zero, which is how the generated
+        // code recognizes NULL strings.
+        const char *str = nullptr;
+        int32_t len = 0;
+        if (!value.IsNull()) {
+          str = type::ValuePeeker::PeekVarchar(value);
+          len = strlen(str);
+        }
+        PL_MEMCPY(dst, &str, sizeof(str));
+        PL_MEMCPY(dst + sizeof(uint64_t), &len, sizeof(len));
+        slot++;
+        break;
+      }
+      default: {
+        PL_ASSERT(false);
+        break;
+      }
+    }
+    slot++;
+  }
+  PL_ASSERT(slot == parameter_storage_.size());
+}
+
+}  // namespace codegen
+}  // namespace peloton
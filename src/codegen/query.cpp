@@ -19,19 +19,15 @@ namespace peloton {
 namespace codegen {
 
 // Constructor
-Query::Query(const planner::AbstractPlan &query_plan)
-    : query_plan_(query_plan) {}
+Query::Query() : runtime_state_size_(0) {}
 
 // Execute the query on the given database (and within the provided transaction)
 // This really involves calling the init(), plan() and tearDown() functions, in
 // that order. We also need to correctly handle cases where _any_ of those
 // functions throw exceptions.
 void Query::Execute(concurrency::Transaction &txn, char *consumer_arg,
-                    RuntimeStats *stats) {
-  CodeGen codegen{GetCodeContext()};
-
-  llvm::Type *runtime_state_type = runtime_state_.FinalizeType(codegen);
-  uint64_t parameter_size = codegen.SizeOf(runtime_state_type);
+                    RuntimeStats *stats, const char *parameters) {
+  uint64_t parameter_size = runtime_state_size_;
   PL_ASSERT(parameter_size % 8 == 0);
 
   // Allocate some space for the function arguments
@@ -47,6 +43,7 @@ void Query::Execute(concurrency::Transaction &txn, char *consumer_arg,
   struct FunctionArguments {
     concurrency::Transaction *txn;
     catalog::Catalog *catalog;
+    const char *parameters;
     char *consumer_arg;
     char rest[0];
   } PACKED;
@@ -55,6 +52,7 @@ void Query::Execute(concurrency::Transaction &txn, char *consumer_arg,
   auto *func_args = reinterpret_cast<FunctionArguments *>(param_data.get());
   func_args->txn = &txn;
   func_args->catalog = catalog::Catalog::GetInstance();
+  func_args->parameters = parameters;
   func_args->consumer_arg = consumer_arg;
 
   // Timer
@@ -109,6 +107,13 @@ void Query::Execute(concurrency::Transaction &txn, char *consumer_arg,
 }
 
 bool Query::Prepare(const QueryFunctions &query_funcs) {
+  // The size of the state the functions take won't change anymore
+  {
+    CodeGen codegen{GetCodeContext()};
+    llvm::Type *runtime_state_type = runtime_state_.FinalizeType(codegen);
+    runtime_state_size_ = codegen.SizeOf(runtime_state_type);
+  }
+
   LOG_TRACE("Going to JIT the query ...");
 
   // Compile the code
@@ -0,0 +1,168 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// query_cache.cpp
+//
+// Identification: src/codegen/query_cache.cpp
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "codegen/query_cache.h"
+
+#include <algorithm>
+
+#include "codegen/plan_fingerprint.h"
+#include "codegen/query.h"
+#include "common/logger.h"
+#include "configuration/configuration.h"
+#include "statistics/backend_stats_context.h"
+
+namespace peloton {
+namespace codegen {
+
+// Global singleton
+QueryCache &QueryCache::GetInstance() {
+  static QueryCache query_cache;
+  return query_cache;
+}
+
+// Constructor
+QueryCache::QueryCache()
+    : code_size_(0), code_size_budget_(FLAGS_codegen_cache_size) {}
+
+std::shared_ptr<Query> QueryCache::Find(const PlanFingerprint &fingerprint) {
+  if (!fingerprint.IsCacheable()) {
+    return nullptr;
+  }
+
+  std::shared_ptr<Query> query;
+  double saved_compile_ms = 0.0;
+  {
+    std::lock_guard<std::mutex> lock{latch_};
+    auto iter = index_.find(fingerprint.GetKey());
+    if (iter != index_.end()) {
+      // Move the entry to the front of the LRU list
+      entries_.splice(entries_.begin(), entries_, iter->second);
+      query = iter->second->query;
+      saved_compile_ms = iter->second->compile_ms;
+    }
+  }
+
+  if (FLAGS_stats_mode != STATS_TYPE_INVALID) {
+    auto *stats_context = stats::BackendStatsContext::GetInstance();
+    if (query != nullptr) {
+      stats_context->IncrementQueryCacheHits(
+          static_cast<int64_t>(saved_compile_ms * 1000));
+    } else {
+      stats_context->IncrementQueryCacheMisses();
+    }
+  }
+
+  return query;
+}
+
+void QueryCache::Insert(const PlanFingerprint &fingerprint,
+                        const std::shared_ptr<Query> &query,
+                        double compile_ms) {
+  if (!fingerprint.IsCacheable()) {
+    return;
+  }
+
+  uint64_t code_size = query->GetCodeContext().GetCodeSize();
+  uint32_t num_evicted = 0;
+  {
+    std::lock_guard<std::mutex> lock{latch_};
+
+    // Another thread may have compiled the same plan in the meantime
+    auto iter = index_.find(fingerprint.GetKey());
+    if (iter != index_.end()) {
+      Remove(iter->second);
+    }
+
+    // Don't bother with queries that would push everything else out
+    if (code_size_budget_ == 0 || code_size > code_size_budget_) {
+      LOG_DEBUG("Query with %lu bytes of code exceeds the cache budget",
+                code_size);
+      return;
+    }
+
+    entries_.push_front(Entry{fingerprint.GetKey(), query,
+                              fingerprint.GetTableOids(), code_size,
+                              compile_ms});
+    index_[fingerprint.GetKey()] = entries_.begin();
+    code_size_ += code_size;
+
+    size_t num_entries = entries_.size();
+    EvictToBudget();
+    num_evicted = num_entries - entries_.size();
+  }
+
+  if (num_evicted > 0 && FLAGS_stats_mode != STATS_TYPE_INVALID) {
+    auto *stats_context = stats::BackendStatsContext::GetInstance();
+    for (uint32_t i = 0; i < num_evicted; i++) {
+      stats_context->IncrementQueryCacheEvictions();
+    }
+  }
+}
+
+void QueryCache::InvalidateTable(oid_t table_oid) {
+  std::lock_guard<std::mutex> lock{latch_};
+  for (auto iter = entries_.begin(); iter != entries_.end();) {
+    const auto &table_oids = iter->table_oids;
+    auto next = std::next(iter);
+    if (std::find(table_oids.begin(), table_oids.end(), table_oid) !=
+        table_oids.end()) {
+      Remove(iter);
+    }
+    iter = next;
+  }
+}
+
+void QueryCache::Clear() {
+  std::lock_guard<std::mutex> lock{latch_};
+  entries_.clear();
+  index_.clear();
+  code_size_ = 0;
+}
+
+size_t QueryCache::GetCount() const {
+  std::lock_guard<std::mutex> lock{latch_};
+  return entries_.size();
+}
+
+uint64_t QueryCache::GetCodeSize() const {
+  std::lock_guard<std::mutex> lock{latch_};
+  return code_size_;
+}
+
+uint64_t QueryCache::GetCodeSizeBudget() const {
+  std::lock_guard<std::mutex> lock{latch_};
+  return code_size_budget_;
+}
+
+void QueryCache::SetCodeSizeBudget(uint64_t budget) {
+  std::lock_guard<std::mutex> lock{latch_};
+  code_size_budget_ = budget;
+  EvictToBudget();
+}
+
+void QueryCache::Remove(EntryIterator iter) {
+  PL_ASSERT(code_size_ >= iter->code_size);
+  code_size_ -= iter->code_size;
+  index_.erase(iter->key);
+  entries_.erase(iter);
+}
+
+void QueryCache::EvictToBudget() {
+  // A budget of zero evicts even queries without any code
+  while (!entries_.empty() &&
+         (code_size_ > code_size_budget_ || code_size_budget_ == 0)) {
+    Remove(std::prev(entries_.end()));
+  }
+}
+
+}  // namespace codegen
+}  // namespace peloton
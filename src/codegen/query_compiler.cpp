@@ -16,6 +16,7 @@
 #include "planner/seq_scan_plan.h"
 #include "planner/aggregate_plan.h"
 #include "planner/hash_join_plan.h"
+#include "planner/merge_join_plan.h"
 
 namespace peloton {
 namespace codegen {
@@ -26,15 +27,15 @@ QueryCompiler::QueryCompiler() : next_id_(0) {}
 // Compile the given query statement
 std::unique_ptr<Query> QueryCompiler::Compile(
     const planner::AbstractPlan &root, QueryResultConsumer &result_consumer,
-    CompileStats *stats) {
+    CompileStats *stats, const PlanFingerprint *fingerprint) {
   // The query statement we compile
-  std::unique_ptr<Query> query{new Query(root)};
+  std::unique_ptr<Query> query{new Query()};
 
   // Set up the compilation context
-  CompilationContext context{*query, result_consumer};
+  CompilationContext context{*query, result_consumer, fingerprint};
 
   // Perform the compilation
-  context.GeneratePlan(stats);
+  context.GeneratePlan(root, stats);
 
   // Return the compiled query statement
   return query;
@@ -50,7 +51,9 @@ bool QueryCompiler::IsSupported(const planner::AbstractPlan &plan,
                                 const planner::AbstractPlan *parent) {
   switch (plan.GetPlanNodeType()) {
     case PlanNodeType::SEQSCAN:
+    case PlanNodeType::INDEXSCAN:
     case PlanNodeType::ORDERBY:
+    case PlanNodeType::LIMIT:
     case PlanNodeType::AGGREGATE_V2: {
       break;
     }
@@ -66,6 +69,15 @@ bool QueryCompiler::IsSupported(const planner::AbstractPlan &plan,
         break;
       }
     }
+    case PlanNodeType::NESTLOOP:
+    case PlanNodeType::MERGEJOIN: {
+      const auto &join = static_cast<const planner::AbstractJoinPlan &>(plan);
+      // Right now, only support inner joins
+      if (join.GetJoinType() == JoinType::INNER) {
+        break;
+      }
+      return false;
+    }
     case PlanNodeType::HASH: {
       // Right now, only support hash's in hash-joins
       if (parent != nullptr &&
@@ -78,15 +90,29 @@ bool QueryCompiler::IsSupported(const planner::AbstractPlan &plan,
 
   // Check the predicate is compilable
   const expression::AbstractExpression *pred = nullptr;
-  if (plan.GetPlanNodeType() == PlanNodeType::SEQSCAN) {
-    auto &scan_plan = static_cast<const planner::SeqScanPlan &>(plan);
+  if (plan.GetPlanNodeType() == PlanNodeType::SEQSCAN ||
+      plan.GetPlanNodeType() == PlanNodeType::INDEXSCAN) {
+    auto &scan_plan = static_cast<const planner::AbstractScan &>(plan);
     pred = scan_plan.GetPredicate();
   } else if (plan.GetPlanNodeType() == PlanNodeType::AGGREGATE_V2) {
     auto &order_by_plan = static_cast<const planner::AggregatePlan &>(plan);
     pred = order_by_plan.GetPredicate();
-  } else if (plan.GetPlanNodeType() == PlanNodeType::HASHJOIN) {
-    auto &order_by_plan = static_cast<const planner::HashJoinPlan &>(plan);
-    pred = order_by_plan.GetPredicate();
+  } else if (plan.GetPlanNodeType() == PlanNodeType::HASHJOIN ||
+             plan.GetPlanNodeType() == PlanNodeType::NESTLOOP ||
+             plan.GetPlanNodeType() == PlanNodeType::MERGEJOIN) {
+    auto &join_plan = static_cast<const planner::AbstractJoinPlan &>(plan);
+    pred = join_plan.GetPredicate();
+  }
+
+  // The join clauses of merge joins are compiled too
+  if (plan.GetPlanNodeType() == PlanNodeType::MERGEJOIN) {
+    auto &join_plan = static_cast<const planner::MergeJoinPlan &>(plan);
+    for (const auto &join_clause : *join_plan.GetJoinClauses()) {
+      if (!IsExpressionSupported(*join_clause.left_) ||
+          !IsExpressionSupported(*join_clause.right_)) {
+        return false;
+      }
+    }
   }
 
   if (pred != nullptr && !IsExpressionSupported(*pred)) {
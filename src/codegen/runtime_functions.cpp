@@ -14,8 +14,18 @@
 
 #include <nmmintrin.h>
 
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <vector>
+
 #include "common/exception.h"
+#include "common/init.h"
 #include "common/logger.h"
+#include "common/thread_pool.h"
+#include "concurrency/transaction.h"
 #include "storage/data_table.h"
 #include "storage/tile_group.h"
 #include "storage/tile.h"
@@ -84,16 +94,159 @@ void RuntimeFunctions::GetTileGroupLayout(const storage::TileGroup *tile_group,
     // Now grab the column information
     auto *tile = tile_group->GetTile(tile_offset);
     auto *tile_schema = tile->GetSchema();
+    auto *packed_column = tile->GetPackedColumn(tile_column_offset);
+    if (packed_column != nullptr) {
+      infos[col_idx].column = reinterpret_cast<char *>(
+          const_cast<uint64_t *>(packed_column->GetWords()));
+      infos[col_idx].stride = 0;
+      infos[col_idx].is_columnar = true;
+      infos[col_idx].packed_bits = packed_column->GetBits();
+      infos[col_idx].packed_base = packed_column->GetBase();
+      continue;
+    }
     infos[col_idx].column =
         tile->GetTupleLocation(0) + tile_schema->GetOffset(tile_column_offset);
     infos[col_idx].stride = tile_schema->GetLength();
     infos[col_idx].is_columnar = tile_schema->GetColumnCount() == 1;
+    infos[col_idx].packed_bits = 0;
+    infos[col_idx].packed_base = 0;
     LOG_DEBUG("Col [%u] start: %p, stride: %u, columnar: %s", col_idx,
               infos[col_idx].column, infos[col_idx].stride,
               infos[col_idx].is_columnar ? "true" : "false");
   }
 }
 
+//===----------------------------------------------------------------------===//
+// Run a parallel scan over all the tile groups in the table.
+//
+// Every worker gets its own copy of the runtime state, which it initializes
+// with init_func() before scanning anything. The calling thread acts as the
+// first worker, the others are tasks of the global thread pool. Workers
+// repeatedly grab the next tile group to scan from a shared counter, so
+// faster workers simply end up scanning more of the table. When all workers
+// are finished, their state is merged into the main state one after the
+// other.
+//
+// If any worker throws, the remaining workers stop at the next tile group, all
+// worker state is cleaned up and the first exception is rethrown.
+//===----------------------------------------------------------------------===//
+void RuntimeFunctions::ExecuteParallelScan(
+    char *state, uint64_t state_size, storage::DataTable *table,
+    concurrency::Transaction *txn, uint32_t num_threads,
+    ScanMorselFunction scan_func, WorkerStateFunction init_func,
+    MergeWorkerStateFunction merge_func, WorkerStateFunction tear_down_func) {
+  const uint64_t num_tile_groups = table->GetTileGroupCount();
+
+  // There is no point in having more workers than tile groups
+  uint64_t num_workers = std::min<uint64_t>(num_threads, num_tile_groups);
+  num_workers = std::max<uint64_t>(num_workers, 1);
+
+  LOG_DEBUG("Scanning %lu tile groups of table %u with %lu workers",
+            num_tile_groups, table->GetOid(), num_workers);
+
+  // Set up the private state of every worker
+  std::vector<std::unique_ptr<char[]>> worker_states;
+  try {
+    for (uint64_t i = 0; i < num_workers; i++) {
+      std::unique_ptr<char[]> worker_state{new char[state_size]};
+      PL_MEMCPY(worker_state.get(), state, state_size);
+      init_func(worker_state.get());
+      worker_states.push_back(std::move(worker_state));
+    }
+  } catch (...) {
+    for (auto &worker_state : worker_states) {
+      tear_down_func(worker_state.get());
+    }
+    throw;
+  }
+
+  // The progress of the scan. The tasks of the thread pool hold on to it, as
+  // a task may only start after the scan is over.
+  struct ScanProgress {
+    std::atomic<uint64_t> next_tile_group{0};
+    std::mutex mutex;
+    std::condition_variable done_cv;
+    // the workers that are scanning on a thread of the pool
+    uint32_t running_workers = 0;
+    // set once the calling thread is done, workers that start later quit
+    bool closed = false;
+  };
+  auto progress = std::make_shared<ScanProgress>();
+  std::vector<std::exception_ptr> errors(num_workers);
+
+  auto worker = [&](uint64_t worker_id) {
+    char *worker_state = worker_states[worker_id].get();
+    try {
+      uint64_t tile_group = progress->next_tile_group++;
+      while (tile_group < num_tile_groups) {
+        scan_func(worker_state, table, tile_group, tile_group + 1);
+        tile_group = progress->next_tile_group++;
+      }
+    } catch (...) {
+      errors[worker_id] = std::current_exception();
+      // Make every other worker stop at its next tile group
+      progress->next_tile_group = num_tile_groups;
+    }
+  };
+
+  // The workers record their reads in the read-write set of the transaction
+  txn->SetParallelReads(num_workers > 1);
+
+  // Submit the other workers to the thread pool. The pool may be busy, or
+  // even run this scan on one of its threads, so the calling thread doesn't
+  // wait for a worker that has not started when it runs out of tile groups.
+  for (uint64_t i = 1; i < num_workers; i++) {
+    thread_pool.SubmitTask([progress, &worker, i] {
+      {
+        std::lock_guard<std::mutex> lock{progress->mutex};
+        if (progress->closed) {
+          return;
+        }
+        progress->running_workers++;
+      }
+      worker(i);
+      std::lock_guard<std::mutex> lock{progress->mutex};
+      progress->running_workers--;
+      progress->done_cv.notify_all();
+    });
+  }
+
+  // This thread is the first worker
+  worker(0);
+
+  // Wait for the workers that are still scanning
+  {
+    std::unique_lock<std::mutex> lock{progress->mutex};
+    progress->closed = true;
+    progress->done_cv.wait(
+        lock, [&progress] { return progress->running_workers == 0; });
+  }
+  txn->SetParallelReads(false);
+
+  // Merge the results of all the workers into the main state, unless the scan
+  // failed. Either way, clean up all the worker state.
+  std::exception_ptr error;
+  for (uint64_t i = 0; i < num_workers; i++) {
+    if (error == nullptr && errors[i] != nullptr) {
+      error = errors[i];
+    }
+  }
+  for (uint64_t i = 0; i < num_workers; i++) {
+    try {
+      if (error == nullptr) {
+        merge_func(state, worker_states[i].get());
+      }
+    } catch (...) {
+      error = std::current_exception();
+    }
+    tear_down_func(worker_states[i].get());
+  }
+
+  if (error != nullptr) {
+    std::rethrow_exception(error);
+  }
+}
+
 void RuntimeFunctions::ThrowDivideByZeroException() {
   throw DivideByZeroException("ERROR: division by zero");
 }
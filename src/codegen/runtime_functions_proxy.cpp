@@ -81,7 +81,8 @@ llvm::Type *RuntimeFunctionsProxy::_ColumnLayoutInfo::GetType(
 
   // struct RuntimeFunctions::ColumnLayoutInfo
   std::vector<llvm::Type *> elements = {
-      codegen.CharPtrType(), codegen.Int32Type(), codegen.BoolType()};
+      codegen.CharPtrType(), codegen.Int32Type(), codegen.BoolType(),
+      codegen.Int32Type(), codegen.Int64Type()};
   cli_type = llvm::StructType::create(codegen.GetContext(), elements,
                                       kColumnLayoutInfoType);
   return cli_type;
@@ -116,6 +117,42 @@ llvm::Function *RuntimeFunctionsProxy::_GetTileGroupLayout::GetFunction(
   return codegen.RegisterFunction(kGetTileGroupLayoutFnName, fn_type);
 }
 
+//===----------------------------------------------------------------------===//
+// Get the LLVM function definition/wrapper to
+// RuntimeFunctions::ExecuteParallelScan()
+//===----------------------------------------------------------------------===//
+llvm::Function *RuntimeFunctionsProxy::_ExecuteParallelScan::GetFunction(
+    CodeGen &codegen) {
+  static const std::string kExecuteParallelScanFnName =
+#ifdef __APPLE__
+      "_ZN7peloton7codegen16RuntimeFunctions19ExecuteParallelScanEPcmPNS_"
+      "7storage9DataTableEPNS_11concurrency11TransactionEjPFvS2_S5_mmEPFvS2_"
+      "EPFvS2_S2_ESC_";
+#else
+      "_ZN7peloton7codegen16RuntimeFunctions19ExecuteParallelScanEPcmPNS_"
+      "7storage9DataTableEPNS_11concurrency11TransactionEjPFvS2_S5_mmEPFvS2_"
+      "EPFvS2_S2_ESC_";
+#endif
+  auto *parallel_scan_func = codegen.LookupFunction(kExecuteParallelScanFnName);
+  if (parallel_scan_func != nullptr) {
+    return parallel_scan_func;
+  }
+  // Not cached, create the type. The transaction and the generated functions
+  // are passed in as opaque pointers.
+  std::vector<llvm::Type *> fn_args = {
+      codegen.CharPtrType(),
+      codegen.Int64Type(),
+      DataTableProxy::GetType(codegen)->getPointerTo(),
+      codegen.CharPtrType(),
+      codegen.Int32Type(),
+      codegen.CharPtrType(),
+      codegen.CharPtrType(),
+      codegen.CharPtrType(),
+      codegen.CharPtrType()};
+  auto *fn_type = llvm::FunctionType::get(codegen.VoidType(), fn_args, false);
+  return codegen.RegisterFunction(kExecuteParallelScanFnName, fn_type);
+}
+
 //===----------------------------------------------------------------------===//
 // Get the LLVM function definition/wrapper to
 // RuntimeFunctions::ThrowDivideByZeroException()
@@ -38,9 +38,14 @@ Sorter::Sorter(CodeGen &codegen,
 // Just make a call to utils::Sorter::Init(...)
 void Sorter::Init(CodeGen &codegen, llvm::Value *sorter_ptr,
                   llvm::Value *comparison_func) const {
+  auto *init_func = SorterProxy::_Init::GetFunction(codegen);
+  if (comparison_func == nullptr) {
+    auto *func_ptr_type = llvm::cast<llvm::PointerType>(
+        init_func->getFunctionType()->getParamType(1));
+    comparison_func = codegen.NullPtr(func_ptr_type);
+  }
   auto *tuple_size = codegen.Const32(storage_format_.GetStorageSize());
-  codegen.CallFunc(SorterProxy::_Init::GetFunction(codegen),
-                   {sorter_ptr, comparison_func, tuple_size});
+  codegen.CallFunc(init_func, {sorter_ptr, comparison_func, tuple_size});
 }
 
 // Append the given tuple into the sorter instance
@@ -57,6 +62,14 @@ void Sorter::Append(CodeGen &codegen, llvm::Value *sorter_ptr,
   }
 }
 
+// Just make a call to utils::Sorter::TransferFrom(...). This copies the tuples
+// of the other sorter instance into this one and frees the other one.
+void Sorter::TransferFrom(CodeGen &codegen, llvm::Value *sorter_ptr,
+                          llvm::Value *other_sorter_ptr) const {
+  auto *transfer_func = SorterProxy::_TransferFrom::GetFunction(codegen);
+  codegen.CallFunc(transfer_func, {sorter_ptr, other_sorter_ptr});
+}
+
 // Just make a call to utils::Sorter::Sort(...). This actually sorts the data
 // that has been inserted into the sorter instance.
 void Sorter::Sort(CodeGen &codegen, llvm::Value *sorter_ptr) const {
@@ -152,6 +165,11 @@ llvm::Value *Sorter::GetNumberOfStoredTuples(CodeGen &codegen,
   return codegen->CreateTruncOrBitCast(num_tuples, codegen.Int32Type());
 }
 
+Sorter::SorterAccess Sorter::GetAccess(CodeGen &codegen,
+                                       llvm::Value *sorter_ptr) const {
+  return SorterAccess{*this, GetStartPosition(codegen, sorter_ptr)};
+}
+
 // Pull out the 'start_pos_' instance member from the provided Sorter instance
 llvm::Value *Sorter::GetStartPosition(CodeGen &codegen,
                                       llvm::Value *sorter_ptr) const {
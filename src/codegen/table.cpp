@@ -52,30 +52,43 @@ llvm::Value *Table::GetTileGroup(CodeGen &codegen, llvm::Value *table_ptr,
 // scan consumer.
 void Table::GenerateScan(CodeGen &codegen, llvm::Value *table_ptr,
                          ScanConsumer &consumer) const {
-  DoGenerateScan(codegen, table_ptr, 1, consumer);
+  DoGenerateScan(codegen, table_ptr, codegen.Const64(0),
+                 GetTileGroupCount(codegen, table_ptr), 1, consumer);
 }
 
 // Generate a vectorized scan
 void Table::GenerateVectorizedScan(CodeGen &codegen, llvm::Value *table_ptr,
                                    uint32_t vector_size,
                                    ScanConsumer &consumer) const {
-  DoGenerateScan(codegen, table_ptr, vector_size, consumer);
+  DoGenerateScan(codegen, table_ptr, codegen.Const64(0),
+                 GetTileGroupCount(codegen, table_ptr), vector_size, consumer);
 }
 
-// Generate a scan over all tile groups
+// Generate a vectorized scan over a range of tile groups
+void Table::GenerateVectorizedScan(CodeGen &codegen, llvm::Value *table_ptr,
+                                   llvm::Value *tile_group_begin,
+                                   llvm::Value *tile_group_end,
+                                   uint32_t vector_size,
+                                   ScanConsumer &consumer) const {
+  DoGenerateScan(codegen, table_ptr, tile_group_begin, tile_group_end,
+                 vector_size, consumer);
+}
+
+// Generate a scan over the tile groups in the range [begin, end)
 void Table::DoGenerateScan(CodeGen &codegen, llvm::Value *table_ptr,
-                           uint32_t vector_size, ScanConsumer &consumer) const {
+                           llvm::Value *tile_group_begin,
+                           llvm::Value *tile_group_end, uint32_t vector_size,
+                           ScanConsumer &consumer) const {
   // First get the columns from the table the consumer needs. For every column,
   // we'll need to have a ColumnInfoLayout struct
   llvm::Value *column_layouts = codegen->CreateAlloca(
       RuntimeFunctionsProxy::_ColumnLayoutInfo::GetType(codegen),
       codegen.Const32(table_.GetSchema()->GetColumnCount()));
 
-  // Get the number of tile groups in the given table
-  llvm::Value *tile_group_idx = codegen.Const64(0);
-  llvm::Value *num_tile_groups = GetTileGroupCount(codegen, table_ptr);
+  llvm::Value *tile_group_idx = tile_group_begin;
+  llvm::Value *num_tile_groups = tile_group_end;
 
-  // Iterate over all tile groups in the table
+  // Iterate over all tile groups in the range
   Loop loop{codegen,
             codegen->CreateICmpULT(tile_group_idx, num_tile_groups),
             {{"tileGroupIdx", tile_group_idx}}};
@@ -101,10 +114,16 @@ void Table::DoGenerateScan(CodeGen &codegen, llvm::Value *table_ptr,
     // Invoke the consumer to let her know that we're done with this tile group
     consumer.TileGroupFinish(codegen, tile_group_ptr);
 
-    // Move to next tile group in the table
+    // Move to next tile group in the table, unless the consumer is done
     tile_group_idx = codegen->CreateAdd(tile_group_idx, codegen.Const64(1));
-    loop.LoopEnd(codegen->CreateICmpULT(tile_group_idx, num_tile_groups),
-                 {tile_group_idx});
+    llvm::Value *more_tile_groups =
+        codegen->CreateICmpULT(tile_group_idx, num_tile_groups);
+    llvm::Value *done = consumer.IsDone(codegen);
+    if (done != nullptr) {
+      more_tile_groups =
+          codegen->CreateAnd(more_tile_groups, codegen->CreateNot(done));
+    }
+    loop.LoopEnd(more_tile_groups, {tile_group_idx});
   }
 }
 
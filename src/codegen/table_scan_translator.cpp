@@ -14,13 +14,36 @@
 
 #include "codegen/if.h"
 #include "codegen/catalog_proxy.h"
+#include "codegen/filter_runtime_proxy.h"
+#include "codegen/function_builder.h"
+#include "codegen/runtime_functions_proxy.h"
 #include "codegen/transaction_runtime_proxy.h"
+#include "codegen/type.h"
+#include "expression/expression_util.h"
+#include "expression/tuple_value_expression.h"
 #include "planner/seq_scan_plan.h"
 #include "storage/data_table.h"
 
 namespace peloton {
 namespace codegen {
 
+namespace {
+
+// Collect the conjuncts of the given predicate
+void CollectConjuncts(
+    const expression::AbstractExpression &predicate,
+    std::vector<const expression::AbstractExpression *> &conjuncts) {
+  if (predicate.GetExpressionType() == ExpressionType::CONJUNCTION_AND) {
+    for (uint32_t i = 0; i < predicate.GetChildrenSize(); i++) {
+      CollectConjuncts(*predicate.GetChild(i), conjuncts);
+    }
+  } else {
+    conjuncts.push_back(&predicate);
+  }
+}
+
+}  // anonymous namespace
+
 //===----------------------------------------------------------------------===//
 // TABLE SCAN TRANSLATOR
 //===----------------------------------------------------------------------===//
@@ -71,18 +94,126 @@ void TableScanTranslator::Produce() const {
                        {catalog_ptr, codegen.Const32(table.GetDatabaseOid()),
                         codegen.Const32(table.GetOid())});
 
-  // The output buffer for the scan
-  Vector selection_vector{LoadStateValue(selection_vector_id_),
-                          Vector::kDefaultVectorSize, codegen.Int32Type()};
-
-  // Do the vectorized scan
-  ScanConsumer scan_consumer{*this, selection_vector};
-  table_.GenerateVectorizedScan(codegen, table_ptr,
-                                selection_vector.GetCapacity(), scan_consumer);
+  if (GetPipeline().IsParallel()) {
+    ProduceParallel(table_ptr);
+  } else {
+    // The output buffer for the scan
+    Vector selection_vector{LoadStateValue(selection_vector_id_),
+                            Vector::kDefaultVectorSize, codegen.Int32Type()};
+
+    // Do the vectorized scan
+    ScanConsumer scan_consumer{*this, selection_vector};
+    table_.GenerateVectorizedScan(codegen, table_ptr,
+                                  selection_vector.GetCapacity(),
+                                  scan_consumer);
+  }
 
   LOG_DEBUG("TableScan on [%u] finished producing tuples ...", table.GetOid());
 }
 
+// Produce the tuples of the table using multiple threads.
+//
+// The body of the scan is moved into its own function that scans a range of
+// tile groups, along with everything the operators after the scan in this
+// pipeline do with the tuples. The scan function runs on a worker's private
+// copy of the runtime state and creates its own local state. The operators in
+// the pipeline set up and merge their state in the worker functions we
+// generate here. The plan function itself only calls into the runtime, which
+// hands out tile groups to the workers and merges their results.
+void TableScanTranslator::ProduceParallel(llvm::Value *table_ptr) const {
+  auto &codegen = GetCodeGen();
+  auto &code_context = codegen.GetCodeContext();
+  auto &runtime_state = GetCompilationContext().GetRuntimeState();
+  const auto &translators = GetPipeline().GetTranslators();
+
+  auto *runtime_state_type = runtime_state.FinalizeType(codegen);
+  auto *runtime_state_ptr_type = runtime_state_type->getPointerTo();
+  auto fn_prefix = "_" + std::to_string(code_context.GetID()) + "_scan" +
+                   std::to_string(GetTable().GetOid());
+
+  LOG_DEBUG("TableScan on [%u] will run with %u threads", GetTable().GetOid(),
+            GetPipeline().GetDegreeOfParallelism());
+
+  // The function that initializes the state of a worker
+  FunctionBuilder init_fn{code_context,
+                          fn_prefix + "WorkerInit",
+                          codegen.VoidType(),
+                          {{"runtimeState", runtime_state_ptr_type}}};
+  {
+    for (const auto *translator : translators) {
+      translator->InitializeWorkerState();
+    }
+    init_fn.ReturnAndFinish();
+  }
+
+  // The function that scans a range of tile groups
+  FunctionBuilder scan_fn{code_context,
+                          fn_prefix + "Morsel",
+                          codegen.VoidType(),
+                          {{"runtimeState", runtime_state_ptr_type},
+                           {"table", table_ptr->getType()},
+                           {"tileGroupBegin", codegen.Int64Type()},
+                           {"tileGroupEnd", codegen.Int64Type()}}};
+  {
+    // Local state belongs to the function it is created in
+    auto saved_local_state = runtime_state.SaveLocalState();
+    runtime_state.CreateLocalState(codegen);
+
+    Vector selection_vector{LoadStateValue(selection_vector_id_),
+                            Vector::kDefaultVectorSize, codegen.Int32Type()};
+
+    ScanConsumer scan_consumer{*this, selection_vector};
+    table_.GenerateVectorizedScan(
+        codegen, scan_fn.GetArgumentByName("table"),
+        scan_fn.GetArgumentByName("tileGroupBegin"),
+        scan_fn.GetArgumentByName("tileGroupEnd"),
+        selection_vector.GetCapacity(), scan_consumer);
+    scan_fn.ReturnAndFinish();
+
+    runtime_state.RestoreLocalState(saved_local_state);
+  }
+
+  // The function that merges the state of a worker into the main state
+  FunctionBuilder merge_fn{code_context,
+                           fn_prefix + "WorkerMerge",
+                           codegen.VoidType(),
+                           {{"runtimeState", runtime_state_ptr_type},
+                            {"workerState", runtime_state_ptr_type}}};
+  {
+    llvm::Value *worker_state = merge_fn.GetArgumentByName("workerState");
+    for (const auto *translator : translators) {
+      translator->MergeWorkerState(worker_state);
+    }
+    merge_fn.ReturnAndFinish();
+  }
+
+  // The function that cleans up the state of a worker
+  FunctionBuilder tear_down_fn{code_context,
+                               fn_prefix + "WorkerTearDown",
+                               codegen.VoidType(),
+                               {{"runtimeState", runtime_state_ptr_type}}};
+  {
+    for (const auto *translator : translators) {
+      translator->TearDownWorkerState();
+    }
+    tear_down_fn.ReturnAndFinish();
+  }
+
+  // Let the runtime run the scan
+  auto *char_ptr_type = codegen.CharPtrType();
+  codegen.CallFunc(
+      RuntimeFunctionsProxy::_ExecuteParallelScan::GetFunction(codegen),
+      {codegen->CreateBitCast(codegen.GetState(), char_ptr_type),
+       codegen.Const64(codegen.SizeOf(runtime_state_type)), table_ptr,
+       codegen->CreateBitCast(GetCompilationContext().GetTransactionPtr(),
+                              char_ptr_type),
+       codegen.Const32(GetPipeline().GetDegreeOfParallelism()),
+       codegen->CreateBitCast(scan_fn.GetFunction(), char_ptr_type),
+       codegen->CreateBitCast(init_fn.GetFunction(), char_ptr_type),
+       codegen->CreateBitCast(merge_fn.GetFunction(), char_ptr_type),
+       codegen->CreateBitCast(tear_down_fn.GetFunction(), char_ptr_type)});
+}
+
 // Get the stringified name of this scan
 std::string TableScanTranslator::GetName() const {
   std::string name = "Scan('" + GetTable().GetName() + "'";
@@ -195,20 +326,32 @@ void TableScanTranslator::ScanConsumer::FilterRowsByPredicate(
   auto &compilation_ctx = translator_.GetCompilationContext();
   RowBatch batch{compilation_ctx, tid_start, tid_end, selection_vector, true};
 
-  // First, check if the predicate is SIMDable
+  // First, filter the rows by all the conjuncts of the predicate we can run
+  // through the vectorized filter kernels. Keep the rest for the scalar loop.
   const auto *predicate = GetPredicate();
 
-  if (predicate->IsSIMDable()) {
-    // The predicate is SIMDable, do it here
-    /*
-    SIMDFilterRows(batch, access);
+  std::vector<const expression::AbstractExpression *> conjuncts;
+  CollectConjuncts(*predicate, conjuncts);
+
+  std::vector<const expression::AbstractExpression *> remaining;
+  for (const auto *conjunct : conjuncts) {
+    if (!conjunct->IsSIMDable() ||
+        !SIMDFilterRows(codegen, batch, access, *conjunct, selection_vector)) {
+      remaining.push_back(conjunct);
+    }
+  }
+
+  if (remaining.empty()) {
     return;
-    */
+  } else if (remaining.size() == conjuncts.size()) {
+    remaining = {predicate};
   }
 
-  // Determine the attributes the predicate needs
+  // Determine the attributes the remaining conjuncts need
   std::unordered_set<const planner::AttributeInfo *> used_attributes;
-  predicate->GetUsedAttributes(used_attributes);
+  for (const auto *conjunct : remaining) {
+    conjunct->GetUsedAttributes(used_attributes);
+  }
 
   // Setup the row batch with attribute accessors for the predicate
   std::vector<AttributeAccess> attribute_accessors;
@@ -222,14 +365,138 @@ void TableScanTranslator::ScanConsumer::FilterRowsByPredicate(
 
   // Iterate over the batch using a scalar loop
   batch.Iterate(codegen, [&](RowBatch::Row &row) {
-    // Evaluate the predicate to determine row validity
-    codegen::Value valid_row = row.DeriveValue(codegen, *predicate);
+    // Evaluate the remaining conjuncts to determine row validity
+    codegen::Value valid_row = row.DeriveValue(codegen, *remaining[0]);
+    for (uint32_t i = 1; i < remaining.size(); i++) {
+      auto conjunct_val = row.DeriveValue(codegen, *remaining[i]);
+      valid_row = valid_row.LogicalAnd(codegen, conjunct_val);
+    }
 
     // Set the validity of the row
     row.SetValidity(codegen, valid_row.GetValue());
   });
 }
 
+bool TableScanTranslator::ScanConsumer::SIMDFilterRows(
+    CodeGen &codegen, RowBatch &batch, const TileGroup::TileGroupAccess &access,
+    const expression::AbstractExpression &conjunct,
+    Vector &selection_vector) const {
+  // We only handle comparisons of a column with a constant
+  auto comparison = conjunct.GetExpressionType();
+  switch (comparison) {
+    case ExpressionType::COMPARE_EQUAL:
+    case ExpressionType::COMPARE_NOTEQUAL:
+    case ExpressionType::COMPARE_LESSTHAN:
+    case ExpressionType::COMPARE_LESSTHANOREQUALTO:
+    case ExpressionType::COMPARE_GREATERTHAN:
+    case ExpressionType::COMPARE_GREATERTHANOREQUALTO:
+      break;
+    default:
+      return false;
+  }
+
+  const auto *column = conjunct.GetChild(0);
+  const auto *constant = conjunct.GetChild(1);
+  if (column->GetExpressionType() == ExpressionType::VALUE_CONSTANT &&
+      constant->GetExpressionType() == ExpressionType::VALUE_TUPLE) {
+    // The constant is on the left, flip the comparison around
+    std::swap(column, constant);
+    comparison = expression::ExpressionUtil::FlipComparison(comparison);
+  }
+  if (column->GetExpressionType() != ExpressionType::VALUE_TUPLE ||
+      constant->GetExpressionType() != ExpressionType::VALUE_CONSTANT) {
+    return false;
+  }
+
+  // Pick the kernel for the type of the column. The constant is converted to
+  // the type of the column, so it can't be wider than the column.
+  const auto *ai =
+      static_cast<const expression::TupleValueExpression *>(column)
+          ->GetAttributeRef();
+  auto const_type = constant->GetValueType();
+  llvm::Function *filter_fn = nullptr;
+  llvm::Type *value_type = nullptr;
+  switch (ai->type) {
+    case type::Type::TypeId::INTEGER:
+    case type::Type::TypeId::DATE: {
+      if (!Type::IsIntegral(const_type) ||
+          Type::GetFixedSizeForType(const_type) > sizeof(int32_t)) {
+        return false;
+      }
+      filter_fn = FilterRuntimeProxy::_FilterInteger::GetFunction(codegen);
+      value_type = codegen.Int32Type();
+      break;
+    }
+    case type::Type::TypeId::BIGINT:
+    case type::Type::TypeId::TIMESTAMP: {
+      if (!Type::IsIntegral(const_type)) {
+        return false;
+      }
+      filter_fn = FilterRuntimeProxy::_FilterBigInt::GetFunction(codegen);
+      value_type = codegen.Int64Type();
+      break;
+    }
+    case type::Type::TypeId::DECIMAL: {
+      if (!Type::IsIntegral(const_type) &&
+          const_type != type::Type::TypeId::DECIMAL) {
+        return false;
+      }
+      filter_fn = FilterRuntimeProxy::_FilterDecimal::GetFunction(codegen);
+      value_type = codegen.DoubleType();
+      break;
+    }
+    default: { return false; }
+  }
+
+  // Constants don't depend on the row, any row will do to derive the value
+  auto row = batch.GetRowAt(codegen.Const32(0));
+  llvm::Value *value = row.DeriveValue(codegen, *constant).GetValue();
+  if (value_type == codegen.DoubleType()) {
+    if (value->getType() != value_type) {
+      value = codegen->CreateSIToFP(value, value_type);
+    }
+  } else {
+    value = codegen->CreateSExtOrBitCast(value, value_type);
+  }
+
+  // Let the kernel compact the selection vector
+  const auto &layout = access.GetLayout(ai->attribute_id);
+  llvm::Value *comparison_val =
+      codegen.Const32(static_cast<int32_t>(comparison));
+  llvm::Value *sel_vec = selection_vector.GetVectorPtr();
+  llvm::Value *num_elements = selection_vector.GetNumElements();
+  if (value_type == codegen.DoubleType()) {
+    llvm::Value *num_selected = codegen.CallFunc(
+        filter_fn, {layout.col_start_ptr, layout.col_stride, comparison_val,
+                    value, sel_vec, num_elements});
+    selection_vector.SetNumElements(num_selected);
+    return true;
+  }
+
+  // The integer columns of compressed tile groups are packed, and filtered
+  // by their own kernel
+  llvm::Value *is_packed =
+      codegen->CreateICmpNE(layout.packed_bits, codegen.Const32(0));
+  llvm::Value *packed_selected = nullptr;
+  If column_is_packed{codegen, is_packed, "packed"};
+  {
+    packed_selected = codegen.CallFunc(
+        FilterRuntimeProxy::_FilterPacked::GetFunction(codegen),
+        {layout.col_start_ptr, layout.packed_bits, layout.packed_base,
+         comparison_val,
+         codegen->CreateSExtOrBitCast(value, codegen.Int64Type()), sel_vec,
+         num_elements});
+  }
+  column_is_packed.ElseBlock("unpacked");
+  llvm::Value *plain_selected = codegen.CallFunc(
+      filter_fn, {layout.col_start_ptr, layout.col_stride, comparison_val,
+                  value, sel_vec, num_elements});
+  column_is_packed.EndIf();
+  selection_vector.SetNumElements(
+      column_is_packed.BuildPHI(packed_selected, plain_selected));
+  return true;
+}
+
 //===----------------------------------------------------------------------===//
 // ATTRIBUTE ACCESS
 //===----------------------------------------------------------------------===//
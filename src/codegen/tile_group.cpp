@@ -23,6 +23,7 @@
 #include "codegen/vector.h"
 #include "codegen/vectorized_loop.h"
 #include "codegen/type.h"
+#include "storage/packed_column.h"
 #include "type/type.h"
 
 namespace peloton {
@@ -76,10 +77,21 @@ void TileGroup::GenerateVectorizedTidScan(CodeGen &codegen,
   {
     VectorizedLoop::Range curr_range = loop.GetCurrentRange();
 
-    // Pass the vector to the consumer
+    // Pass the vector to the consumer, the rest of the vectors are skipped
+    // once it is done
     TileGroupAccess tile_group_access{*this, col_layouts};
-    consumer.ProcessTuples(codegen, curr_range.start, curr_range.end,
-                           tile_group_access);
+    llvm::Value *done = consumer.IsDone(codegen);
+    if (done == nullptr) {
+      consumer.ProcessTuples(codegen, curr_range.start, curr_range.end,
+                             tile_group_access);
+    } else {
+      If is_not_done{codegen, codegen->CreateNot(done)};
+      {
+        consumer.ProcessTuples(codegen, curr_range.start, curr_range.end,
+                               tile_group_access);
+      }
+      is_not_done.EndIf();
+    }
 
     loop.LoopEnd(codegen, {});
   }
@@ -101,6 +113,7 @@ llvm::Value *TileGroup::GetNumTuples(CodeGen &codegen,
 // 1. The starting memory address (where the first value of the column is)
 // 2. The stride length
 // 3. Whether the column is in columnar layout
+// 4. The bits and the base of the column, if it is packed
 //===----------------------------------------------------------------------===//
 std::vector<TileGroup::ColumnLayout> TileGroup::GetColumnLayouts(
     CodeGen &codegen, llvm::Value *tile_group_ptr,
@@ -111,7 +124,7 @@ std::vector<TileGroup::ColumnLayout> TileGroup::GetColumnLayouts(
       RuntimeFunctionsProxy::_GetTileGroupLayout::GetFunction(codegen),
       {tile_group_ptr, column_layout_infos, codegen.Const32(num_cols)});
 
-  // Collect <start, stride, is_columnar> triplets of all columns
+  // Collect <start, stride, is_columnar, bits, base> of all columns
   std::vector<TileGroup::ColumnLayout> layouts;
   auto *layout_type =
       RuntimeFunctionsProxy::_ColumnLayoutInfo::GetType(codegen);
@@ -122,11 +135,26 @@ std::vector<TileGroup::ColumnLayout> TileGroup::GetColumnLayouts(
         layout_type, column_layout_infos, col_id, 1));
     auto *columnar = codegen->CreateLoad(codegen->CreateConstInBoundsGEP2_32(
         layout_type, column_layout_infos, col_id, 2));
-    layouts.push_back(ColumnLayout{col_id, start, stride, columnar});
+    auto *packed_bits = codegen->CreateLoad(codegen->CreateConstInBoundsGEP2_32(
+        layout_type, column_layout_infos, col_id, 3));
+    auto *packed_base = codegen->CreateLoad(codegen->CreateConstInBoundsGEP2_32(
+        layout_type, column_layout_infos, col_id, 4));
+    layouts.push_back(ColumnLayout{col_id, start, stride, columnar, packed_bits,
+                                   packed_base});
   }
   return layouts;
 }
 
+// Access the columns of the given tile group directly, rather than as part of a
+// scan over all of its tuples
+TileGroup::TileGroupAccess TileGroup::GetAccess(
+    CodeGen &codegen, llvm::Value *tile_group_ptr,
+    llvm::Value *column_layouts) const {
+  return TileGroupAccess{*this,
+                         GetColumnLayouts(codegen, tile_group_ptr,
+                                          column_layouts)};
+}
+
 // Load a given column for the row with the given TID
 codegen::Value TileGroup::LoadColumn(CodeGen &codegen, llvm::Value *tid,
                                      const TileGroup::ColumnLayout &layout,
@@ -163,10 +191,49 @@ codegen::Value TileGroup::LoadColumn(CodeGen &codegen, llvm::Value *tid,
     PL_ASSERT(col_len_type == nullptr);
 
     if (vector_size > 1) {
+      // Only plain columns are loaded in vectors, packed ones never are
       llvm::Type *vector_type = llvm::VectorType::get(col_type, vector_size);
       val = codegen->CreateAlignedLoad(
           codegen->CreateBitCast(col_address, vector_type->getPointerTo()),
           Vector::kDefaultVectorAlignment);
+    } else if (storage::PackedColumn::IsPackable(column.GetType())) {
+      // The column may be packed, see storage::PackedColumn::GetOffset()
+      llvm::Value *is_packed =
+          codegen->CreateICmpNE(layout.packed_bits, codegen.Const32(0));
+      llvm::Value *packed_val = nullptr;
+      If column_is_packed{codegen, is_packed, "packed"};
+      {
+        llvm::Value *bits =
+            codegen->CreateZExt(layout.packed_bits, codegen.Int64Type());
+        llvm::Value *bit = codegen->CreateMul(
+            codegen->CreateZExt(tid, codegen.Int64Type()), bits);
+        llvm::Value *shift = codegen->CreateAnd(bit, codegen.Const64(63));
+        llvm::Value *word_ptr = codegen->CreateInBoundsGEP(
+            codegen.Int64Type(),
+            codegen->CreateBitCast(layout.col_start_ptr,
+                                   codegen.Int64Type()->getPointerTo()),
+            codegen->CreateLShr(bit, codegen.Const64(6)));
+        llvm::Value *low = codegen->CreateLShr(
+            codegen->CreateLoad(codegen.Int64Type(), word_ptr), shift);
+        // Shifting by 64 is undefined, so the high word is shifted twice
+        llvm::Value *high = codegen->CreateLoad(
+            codegen.Int64Type(),
+            codegen->CreateConstInBoundsGEP1_32(codegen.Int64Type(), word_ptr,
+                                                1));
+        high = codegen->CreateShl(
+            codegen->CreateShl(high, codegen.Const64(1)),
+            codegen->CreateSub(codegen.Const64(63), shift));
+        llvm::Value *mask = codegen->CreateSub(
+            codegen->CreateShl(codegen.Const64(1), bits), codegen.Const64(1));
+        llvm::Value *offset =
+            codegen->CreateAnd(codegen->CreateOr(low, high), mask);
+        packed_val = codegen->CreateTruncOrBitCast(
+            codegen->CreateAdd(layout.packed_base, offset), col_type);
+      }
+      column_is_packed.ElseBlock("unpacked");
+      llvm::Value *plain_val = codegen->CreateLoad(col_type, col_address);
+      column_is_packed.EndIf();
+      val = column_is_packed.BuildPHI(packed_val, plain_val);
     } else {
       val = codegen->CreateLoad(col_type, col_address);
     }
@@ -44,7 +44,9 @@ uint32_t TransactionRuntime::PerformVectorizedRead(
 
   uint32_t tile_group_idx = tile_group.GetTileGroupId();
 
-  // Perform a read operation for every visible tuple we found
+  // Perform a read operation for every visible tuple we found. The workers of
+  // a parallel scan share the transaction, which latches its read-write set
+  // for each recorded read.
   uint32_t end_idx = out_idx;
   out_idx = 0;
   for (uint32_t idx = 0; idx < end_idx; idx++) {
@@ -20,7 +20,11 @@
 #include "codegen/global_group_by_translator.h"
 #include "codegen/hash_group_by_translator.h"
 #include "codegen/hash_join_translator.h"
+#include "codegen/index_scan_translator.h"
+#include "codegen/limit_translator.h"
+#include "codegen/merge_join_translator.h"
 #include "codegen/negation_translator.h"
+#include "codegen/nested_loop_join_translator.h"
 #include "codegen/order_by_translator.h"
 #include "codegen/projection_translator.h"
 #include "codegen/table_scan_translator.h"
@@ -33,6 +37,10 @@
 #include "expression/aggregate_expression.h"
 #include "planner/aggregate_plan.h"
 #include "planner/hash_join_plan.h"
+#include "planner/index_scan_plan.h"
+#include "planner/limit_plan.h"
+#include "planner/merge_join_plan.h"
+#include "planner/nested_loop_join_plan.h"
 #include "planner/order_by_plan.h"
 #include "planner/projection_plan.h"
 #include "planner/seq_scan_plan.h"
@@ -53,6 +61,11 @@ std::unique_ptr<OperatorTranslator> TranslatorFactory::CreateTranslator(
       translator = new TableScanTranslator(scan, context, pipeline);
       break;
     }
+    case PlanNodeType::INDEXSCAN: {
+      auto &scan = static_cast<const planner::IndexScanPlan &>(plan_node);
+      translator = new IndexScanTranslator(scan, context, pipeline);
+      break;
+    }
     case PlanNodeType::PROJECTION: {
       auto &projection =
           static_cast<const planner::ProjectionPlan &>(plan_node);
@@ -64,6 +77,16 @@ std::unique_ptr<OperatorTranslator> TranslatorFactory::CreateTranslator(
       translator = new HashJoinTranslator(join, context, pipeline);
       break;
     }
+    case PlanNodeType::NESTLOOP: {
+      auto &join = static_cast<const planner::NestedLoopJoinPlan &>(plan_node);
+      translator = new NestedLoopJoinTranslator(join, context, pipeline);
+      break;
+    }
+    case PlanNodeType::MERGEJOIN: {
+      auto &join = static_cast<const planner::MergeJoinPlan &>(plan_node);
+      translator = new MergeJoinTranslator(join, context, pipeline);
+      break;
+    }
     case PlanNodeType::AGGREGATE_V2: {
       const auto &aggregate_plan =
           static_cast<const planner::AggregatePlan &>(plan_node);
@@ -84,6 +107,11 @@ std::unique_ptr<OperatorTranslator> TranslatorFactory::CreateTranslator(
       translator = new OrderByTranslator(order_by, context, pipeline);
       break;
     }
+    case PlanNodeType::LIMIT: {
+      auto &limit = static_cast<const planner::LimitPlan &>(plan_node);
+      translator = new LimitTranslator(limit, context, pipeline);
+      break;
+    }
     default: {
       throw Exception{"We don't have a translator for plan node type: " +
                       PlanNodeTypeToString(plan_node.GetPlanNodeType())};
@@ -0,0 +1,251 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// index_scan_iterator.cpp
+//
+// Identification: src/codegen/utils/index_scan_iterator.cpp
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "codegen/utils/index_scan_iterator.h"
+
+#include <algorithm>
+#include <new>
+
+#include "catalog/manager.h"
+#include "common/container_tuple.h"
+#include "common/logger.h"
+#include "concurrency/transaction.h"
+#include "concurrency/transaction_manager_factory.h"
+#include "index/index.h"
+#include "planner/index_scan_plan.h"
+#include "storage/masked_tuple.h"
+#include "storage/tile_group.h"
+#include "storage/tile_group_header.h"
+
+namespace peloton {
+namespace codegen {
+namespace utils {
+
+IndexScanIterator::IndexScanIterator(const planner::IndexScanPlan &plan)
+    : index_(plan.GetIndex()),
+      index_predicate_(plan.GetIndexPredicate()),
+      key_column_ids_(plan.GetKeyColumnIds()),
+      expr_types_(plan.GetExprTypes()),
+      left_open_(plan.GetLeftOpen()),
+      right_open_(plan.GetRightOpen()),
+      limit_(plan.GetLimit()),
+      limit_number_(plan.GetLimitNumber()),
+      limit_offset_(plan.GetLimitOffset()),
+      descend_(plan.GetDescend()),
+      acquire_owner_(plan.IsForUpdate()) {
+  for (const auto &value : plan.GetValues()) {
+    values_.push_back(value.Copy());
+  }
+}
+
+void IndexScanIterator::Init(const planner::IndexScanPlan &plan) {
+  PL_ASSERT(plan.GetIndex() != nullptr);
+  new (this) IndexScanIterator(plan);
+}
+
+char *IndexScanIterator::GetKeyValues() {
+  return reinterpret_cast<char *>(values_.data());
+}
+
+void IndexScanIterator::BindKeyValues() {
+  index_predicate_.GetConjunctionListToSetup()[0].SetTupleColumnValue(
+      index_.get(), key_column_ids_, values_);
+}
+
+uint32_t IndexScanIterator::Scan(concurrency::Transaction &txn,
+                                 uint32_t max_batch_size) {
+  PL_ASSERT(max_batch_size > 0);
+  tids_.clear();
+  batches_.clear();
+
+  // Look up the index
+  std::vector<ItemPointer *> tuple_location_ptrs;
+  const auto *conjunction = &index_predicate_.GetConjunctionList()[0];
+  if (key_column_ids_.empty()) {
+    index_->ScanAllKeys(tuple_location_ptrs);
+  } else if (limit_) {
+    auto direction =
+        descend_ ? ScanDirectionType::BACKWARD : ScanDirectionType::FORWARD;
+    index_->ScanLimit(values_, key_column_ids_, expr_types_, direction,
+                      tuple_location_ptrs, conjunction, limit_number_,
+                      limit_offset_);
+  } else {
+    index_->Scan(values_, key_column_ids_, expr_types_,
+                 ScanDirectionType::FORWARD, tuple_location_ptrs, conjunction);
+  }
+
+  LOG_TRACE("Index %s returned %lu tuples", index_->GetName().c_str(),
+            tuple_location_ptrs.size());
+
+  // Find the version of every tuple the transaction can see
+  std::vector<ItemPointer> visible_locations;
+  for (auto *tuple_location_ptr : tuple_location_ptrs) {
+    if (!CollectVisibleVersion(txn, *tuple_location_ptr, visible_locations)) {
+      return 0;
+    }
+  }
+
+  CheckOpenRanges(visible_locations);
+
+  // Split the tuples into runs in the same tile group, keeping them in the
+  // order of the index
+  auto &manager = catalog::Manager::GetInstance();
+  for (const auto &location : visible_locations) {
+    if (batches_.empty() ||
+        batches_.back().tile_group->GetTileGroupId() != location.block ||
+        batches_.back().end - batches_.back().start == max_batch_size) {
+      uint32_t pos = static_cast<uint32_t>(tids_.size());
+      batches_.push_back(Batch{manager.GetTileGroup(location.block), pos, pos});
+    }
+    tids_.push_back(location.offset);
+    batches_.back().end++;
+  }
+
+  return static_cast<uint32_t>(batches_.size());
+}
+
+storage::TileGroup *IndexScanIterator::GetTileGroup(uint32_t batch_idx) const {
+  PL_ASSERT(batch_idx < batches_.size());
+  return batches_[batch_idx].tile_group.get();
+}
+
+uint32_t IndexScanIterator::GetTuples(uint32_t batch_idx,
+                                      uint32_t *selection_vector) const {
+  PL_ASSERT(batch_idx < batches_.size());
+  const auto &batch = batches_[batch_idx];
+  std::copy(tids_.begin() + batch.start, tids_.begin() + batch.end,
+            selection_vector);
+  return batch.end - batch.start;
+}
+
+void IndexScanIterator::Destroy() { this->~IndexScanIterator(); }
+
+// Walk the version chain starting at the given location until we find the
+// version visible to the transaction. This is the same traversal the
+// interpreted index scan executor does.
+bool IndexScanIterator::CollectVisibleVersion(
+    concurrency::Transaction &txn, ItemPointer tuple_location,
+    std::vector<ItemPointer> &visible_locations) const {
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto &manager = catalog::Manager::GetInstance();
+
+  auto tile_group = manager.GetTileGroup(tuple_location.block);
+  auto *tile_group_header = tile_group->GetHeader();
+
+  size_t chain_length = 0;
+  while (true) {
+    ++chain_length;
+
+    auto visibility =
+        txn_manager.IsVisible(&txn, tile_group_header, tuple_location.offset);
+
+    if (visibility == VisibilityType::DELETED) {
+      return true;
+    }
+
+    if (visibility == VisibilityType::OK) {
+      // Only the primary key of a tuple can't change between its versions
+      if (index_->GetIndexType() != IndexConstraintType::PRIMARY_KEY) {
+        expression::ContainerTuple<storage::TileGroup> candidate(
+            tile_group.get(), tuple_location.offset);
+        auto &indexed_columns = index_->GetKeySchema()->GetIndexedColumns();
+        storage::MaskedTuple key_tuple(&candidate, indexed_columns);
+        if (!index_->Compare(key_tuple, key_column_ids_, expr_types_,
+                             values_)) {
+          return true;
+        }
+      }
+
+      if (!txn_manager.PerformRead(&txn, tuple_location, acquire_owner_)) {
+        txn_manager.SetTransactionResult(&txn, ResultType::FAILURE);
+        return false;
+      }
+      visible_locations.push_back(tuple_location);
+      return true;
+    }
+
+    PL_ASSERT(visibility == VisibilityType::INVISIBLE);
+
+    bool is_acquired = (tile_group_header->GetTransactionId(
+                            tuple_location.offset) == INITIAL_TXN_ID);
+    bool is_alive = (tile_group_header->GetEndCommitId(
+                         tuple_location.offset) <= txn.GetBeginCommitId());
+    if (is_acquired && is_alive) {
+      // Someone else modified the version chain, start over from its head
+      tuple_location =
+          *(tile_group_header->GetIndirection(tuple_location.offset));
+      chain_length = 0;
+    } else {
+      tuple_location = tile_group_header->GetNextItemPointer(
+          tuple_location.offset);
+      if (tuple_location.IsNull()) {
+        // An aborted version without any other versions is fine, anything
+        // else means the chain is missing the visible version
+        if (chain_length == 1) {
+          return true;
+        }
+        txn_manager.SetTransactionResult(&txn, ResultType::FAILURE);
+        return false;
+      }
+    }
+
+    tile_group = manager.GetTileGroup(tuple_location.block);
+    tile_group_header = tile_group->GetHeader();
+  }
+}
+
+void IndexScanIterator::CheckOpenRanges(
+    std::vector<ItemPointer> &tuple_locations) const {
+  // A hash index has no key order and returns all of its values for anything
+  // other than a point query, so every tuple must be checked
+  if (index_->GetIndexMethodType() == IndexType::HASH &&
+      !key_column_ids_.empty() &&
+      !index_predicate_.GetConjunctionList()[0].IsPointQuery()) {
+    tuple_locations.erase(
+        std::remove_if(tuple_locations.begin(), tuple_locations.end(),
+                       [this](const ItemPointer &tuple_location) {
+                         return !CheckKeyConditions(tuple_location);
+                       }),
+        tuple_locations.end());
+    return;
+  }
+
+  // Otherwise, only tuples with keys at either end of the range can be wrong
+  if (left_open_) {
+    auto first = std::find_if(tuple_locations.begin(), tuple_locations.end(),
+                              [this](const ItemPointer &tuple_location) {
+                                return CheckKeyConditions(tuple_location);
+                              });
+    tuple_locations.erase(tuple_locations.begin(), first);
+  }
+  if (right_open_) {
+    while (!tuple_locations.empty() &&
+           !CheckKeyConditions(tuple_locations.back())) {
+      tuple_locations.pop_back();
+    }
+  }
+}
+
+bool IndexScanIterator::CheckKeyConditions(
+    const ItemPointer &tuple_location) const {
+  auto tile_group =
+      catalog::Manager::GetInstance().GetTileGroup(tuple_location.block);
+  expression::ContainerTuple<storage::TileGroup> tuple(tile_group.get(),
+                                                       tuple_location.offset);
+  auto &indexed_columns = index_->GetKeySchema()->GetIndexedColumns();
+  storage::MaskedTuple key_tuple(&tuple, indexed_columns);
+  return index_->Compare(key_tuple, key_column_ids_, expr_types_, values_);
+}
+
+}  // namespace utils
+}  // namespace codegen
+}  // namespace peloton
@@ -65,6 +65,26 @@ char *Sorter::StoreInputTuple() {
   return ret;
 }
 
+// Append the tuples of the other sorter to our buffer, growing it as needed,
+// and release the other sorter's buffer. Both sorters must store tuples of the
+// same format.
+void Sorter::TransferFrom(Sorter &other) {
+  PL_ASSERT(buffer_start_ != nullptr);
+  PL_ASSERT(tuple_size_ == other.tuple_size_);
+
+  uint64_t other_used_size = other.GetUsedSpace();
+  while (GetAllocatedSpace() - GetUsedSpace() <= other_used_size) {
+    Resize();
+  }
+
+  if (other_used_size > 0) {
+    PL_MEMCPY(buffer_pos_, other.buffer_start_, other_used_size);
+    buffer_pos_ += other_used_size;
+  }
+
+  other.Destroy();
+}
+
 // Sort the buffer
 void Sorter::Sort() {
   // Nothing to sort if nothing has been stored
@@ -72,6 +92,9 @@ void Sorter::Sort() {
     return;
   }
 
+  // Sorters used only to buffer tuples don't have a comparison function
+  PL_ASSERT(cmp_func_ != nullptr);
+
   // Time it
   Timer<std::ratio<1, 1000>> timer;
   timer.Start();
@@ -24,6 +24,7 @@
 
 #include <google/protobuf/stubs/common.h>
 
+#include <algorithm>
 #include <thread>
 
 namespace peloton {
@@ -38,7 +39,15 @@ void PelotonInit::Initialize() {
   MAX_CONCURRENCY = 10;
 
   // set max thread number.
-  thread_pool.Initialize(0, std::thread::hardware_concurrency() + 3);
+  // statements running on the pool keep a quarter of the workers for the
+  // fast lane, so short statements don't queue behind analytical ones.
+  size_t pool_size = std::thread::hardware_concurrency();
+  size_t reserved_worker_count = 0;
+  if (FLAGS_execution_pool && pool_size > 1) {
+    reserved_worker_count = std::max<size_t>(1, pool_size / 4);
+  }
+  thread_pool.Initialize(pool_size, pool_size + 3, false,
+                         reserved_worker_count);
 
   int parallelism = (std::thread::hardware_concurrency() + 3) / 4;
   storage::DataTable::SetActiveTileGroupCount(parallelism);
@@ -0,0 +1,248 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// thread_pool.cpp
+//
+// Identification: src/common/thread_pool.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "common/thread_pool.h"
+
+#include <pthread.h>
+
+namespace peloton {
+
+namespace {
+
+// The pool and the id of the worker running on this thread, if any
+thread_local ThreadPool *current_pool = nullptr;
+thread_local size_t current_worker_id = 0;
+
+size_t PriorityIndex(TaskPriorityType priority) {
+  switch (priority) {
+    case TaskPriorityType::HIGH:
+      return 0;
+    case TaskPriorityType::LOW:
+      return 2;
+    default:
+      return 1;
+  }
+}
+
+void PinToCore(size_t core) {
+#ifdef __linux__
+  cpu_set_t cpuset;
+  CPU_ZERO(&cpuset);
+  CPU_SET(core, &cpuset);
+  pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpuset);
+#else
+  (void)core;
+#endif
+}
+
+}  // anonymous namespace
+
+constexpr size_t ThreadPool::kNumPriorities;
+
+void ThreadPool::Initialize(const size_t &pool_size,
+                            const size_t &dedicated_thread_count,
+                            const bool pin_threads,
+                            const size_t &reserved_worker_count) {
+  PL_ASSERT(reserved_worker_count == 0 || reserved_worker_count < pool_size);
+  current_thread_count_ = 0;
+  pool_size_ = pool_size;
+  dedicated_thread_count_ = dedicated_thread_count;
+  dedicated_threads_.resize(dedicated_thread_count_);
+  reserved_worker_count_ = reserved_worker_count;
+
+  is_running_ = true;
+  workers_.clear();
+  for (size_t i = 0; i < pool_size_; ++i) {
+    workers_.emplace_back(new Worker());
+    workers_[i]->reserved = i >= pool_size_ - reserved_worker_count_;
+  }
+  // Start the workers only after all of them exist, they steal from each other
+  for (size_t i = 0; i < pool_size_; ++i) {
+    workers_[i]->thread =
+        std::thread(&ThreadPool::RunWorker, this, i, pin_threads);
+  }
+}
+
+void ThreadPool::Shutdown() {
+  // always join lastly created threads first.
+  size_t thread_count = current_thread_count_.load();
+  for (size_t i = 0; i < thread_count; ++i) {
+    dedicated_threads_[(thread_count - 1 - i)]->join();
+  }
+  current_thread_count_ = 0;
+  StopWorkers();
+}
+
+void ThreadPool::StopWorkers() {
+  {
+    std::lock_guard<std::mutex> lock(idle_mutex_);
+    is_running_ = false;
+  }
+  idle_cv_.notify_all();
+  reserved_idle_cv_.notify_all();
+  for (auto &worker : workers_) {
+    if (worker->thread.joinable()) {
+      worker->thread.join();
+    }
+  }
+  workers_.clear();
+  pool_size_ = 0;
+  reserved_worker_count_ = 0;
+}
+
+void ThreadPool::Enqueue(TaskPriorityType priority, Task &&task) {
+  if (workers_.empty()) {
+    task();
+    return;
+  }
+
+  size_t priority_index = PriorityIndex(priority);
+  bool high_priority = priority == TaskPriorityType::HIGH;
+
+  // Tasks spawned by a worker stay with that worker, they are likely to touch
+  // the same data. A reserved worker hands the tasks it can't run to the
+  // others, and only HIGH priority tasks go to the reserved workers.
+  bool spawned = current_pool == this &&
+                 (high_priority || !workers_[current_worker_id]->reserved);
+  size_t worker_id = current_worker_id;
+  if (!spawned) {
+    size_t worker_count = high_priority
+                              ? workers_.size()
+                              : workers_.size() - reserved_worker_count_;
+    worker_id =
+        next_worker_.fetch_add(1, std::memory_order_relaxed) % worker_count;
+  }
+  auto &worker = *workers_[worker_id];
+  worker.lock.Lock();
+  if (spawned) {
+    worker.tasks[priority_index].push_back(std::move(task));
+  } else {
+    worker.submitted[priority_index].push_back(std::move(task));
+  }
+  worker.lock.Unlock();
+
+  // An idle worker either sees the new count before it goes to sleep, or is
+  // counted as idle here and gets notified
+  if (high_priority) {
+    pending_high_task_count_.fetch_add(1);
+  }
+  pending_task_count_.fetch_add(1);
+  if (idle_worker_count_.load() > 0) {
+    { std::lock_guard<std::mutex> lock(idle_mutex_); }
+    idle_cv_.notify_one();
+  }
+  if (high_priority && idle_reserved_worker_count_.load() > 0) {
+    { std::lock_guard<std::mutex> lock(idle_mutex_); }
+    reserved_idle_cv_.notify_one();
+  }
+}
+
+void ThreadPool::TakeTask(size_t priority) {
+  if (priority == PriorityIndex(TaskPriorityType::HIGH)) {
+    pending_high_task_count_.fetch_sub(1);
+  }
+  pending_task_count_.fetch_sub(1);
+}
+
+bool ThreadPool::PopTask(size_t worker_id, Task &task) {
+  auto &worker = *workers_[worker_id];
+  worker.lock.Lock();
+  for (size_t priority = 0; priority < kNumPriorities; priority++) {
+    // the newest task spawned here, or else the oldest task submitted
+    auto &tasks = worker.tasks[priority];
+    auto &submitted = worker.submitted[priority];
+    if (!tasks.empty()) {
+      task = std::move(tasks.back());
+      tasks.pop_back();
+    } else if (!submitted.empty()) {
+      task = std::move(submitted.front());
+      submitted.pop_front();
+    } else {
+      continue;
+    }
+    worker.lock.Unlock();
+    TakeTask(priority);
+    return true;
+  }
+  worker.lock.Unlock();
+  return false;
+}
+
+bool ThreadPool::StealTask(size_t worker_id, Task &task) {
+  size_t worker_count = workers_.size();
+  size_t priority_count = workers_[worker_id]->reserved ? 1 : kNumPriorities;
+  for (size_t priority = 0; priority < priority_count; priority++) {
+    for (size_t i = 1; i < worker_count; i++) {
+      auto &victim = *workers_[(worker_id + i) % worker_count];
+      // Do not wait for busy victims, there are others to steal from
+      if (!victim.lock.TryLock()) {
+        continue;
+      }
+      auto &tasks = victim.tasks[priority];
+      auto &submitted = victim.submitted[priority];
+      if (!submitted.empty()) {
+        task = std::move(submitted.front());
+        submitted.pop_front();
+      } else if (!tasks.empty()) {
+        task = std::move(tasks.front());
+        tasks.pop_front();
+      } else {
+        victim.lock.Unlock();
+        continue;
+      }
+      victim.lock.Unlock();
+      TakeTask(priority);
+      return true;
+    }
+  }
+  return false;
+}
+
+void ThreadPool::RunWorker(size_t worker_id, bool pin_thread) {
+  if (pin_thread) {
+    PinToCore(worker_id % std::thread::hardware_concurrency());
+  }
+  current_pool = this;
+  current_worker_id = worker_id;
+
+  // A reserved worker only waits for the HIGH priority tasks
+  bool reserved = workers_[worker_id]->reserved;
+  auto &pending_task_count =
+      reserved ? pending_high_task_count_ : pending_task_count_;
+  auto &idle_cv = reserved ? reserved_idle_cv_ : idle_cv_;
+  auto &idle_worker_count =
+      reserved ? idle_reserved_worker_count_ : idle_worker_count_;
+
+  Task task;
+  while (true) {
+    if (PopTask(worker_id, task) || StealTask(worker_id, task)) {
+      task();
+      task = nullptr;
+      continue;
+    }
+
+    std::unique_lock<std::mutex> lock(idle_mutex_);
+    idle_worker_count.fetch_add(1);
+    idle_cv.wait(lock, [this, &pending_task_count] {
+      return pending_task_count.load() > 0 || !is_running_.load();
+    });
+    idle_worker_count.fetch_sub(1);
+    // Run everything that was queued before stopping
+    if (!is_running_.load() && pending_task_count.load() == 0) {
+      break;
+    }
+  }
+
+  current_pool = nullptr;
+}
+
+}  // End peloton namespace
@@ -16,17 +16,46 @@
 namespace peloton {
 namespace concurrency {
 
+  void DecentralizedEpochManager::RegisterThread(const size_t thread_id) {
+    local_epoch_lock_.Lock();
+
+    if (thread_id >= local_epoch_storage_.size()) {
+      local_epoch_storage_.resize(thread_id + 1);
+    }
+    auto &local_epoch = local_epoch_storage_[thread_id];
+    if (local_epoch == nullptr) {
+      local_epoch.reset(new LocalEpoch(thread_id));
+    } else {
+      local_epoch->Reset();
+    }
+    local_epochs_.Update(thread_id, local_epoch.get());
+
+    if (thread_id >= local_epoch_count_.load()) {
+      local_epoch_count_ = thread_id + 1;
+    }
+
+    local_epoch_lock_.Unlock();
+  }
+
+  void DecentralizedEpochManager::DeregisterThread(const size_t thread_id) {
+    local_epoch_lock_.Lock();
+
+    // keep the local epoch, the garbage collector may be reading it.
+    local_epochs_.Update(thread_id, nullptr);
+
+    local_epoch_lock_.Unlock();
+  }
 
   // enter epoch with thread id
   cid_t DecentralizedEpochManager::EnterEpoch(const size_t thread_id) {
 
-    PL_ASSERT(local_epochs_.find(thread_id) != local_epochs_.end());
+    auto local_epoch = GetLocalEpoch(thread_id);
 
     while (true) {
       uint64_t epoch_id = GetCurrentGlobalEpoch();
 
       // enter the corresponding local epoch.
-      bool rt = local_epochs_.at(thread_id)->EnterEpoch(epoch_id);
+      bool rt = local_epoch->EnterEpoch(epoch_id);
       // if successfully enter local epoch
       if (rt == true) {
     
@@ -40,21 +69,19 @@ namespace concurrency {
   // enter epoch with thread id
   cid_t DecentralizedEpochManager::EnterEpochRO(const size_t thread_id) {
 
-    PL_ASSERT(local_epochs_.find(thread_id) != local_epochs_.end());
+    uint64_t epoch_id = current_global_epoch_ro_.load();
 
-    local_epochs_.at(thread_id)->EnterEpochRO(current_global_epoch_ro_);
+    GetLocalEpoch(thread_id)->EnterEpochRO(epoch_id);
 
-    return (current_global_epoch_ro_ << 32) | 0x0;
+    return (epoch_id << 32) | 0x0;
   }
 
   void DecentralizedEpochManager::ExitEpoch(const size_t thread_id, const cid_t begin_cid) {
 
-    PL_ASSERT(local_epochs_.find(thread_id) != local_epochs_.end());
-
     uint64_t epoch_id = ExtractEpochId(begin_cid);
 
     // exit from the corresponding local epoch.
-    local_epochs_.at(thread_id)->ExitEpoch(epoch_id);
+    GetLocalEpoch(thread_id)->ExitEpoch(epoch_id);
  
   }
 
@@ -62,10 +89,18 @@ namespace concurrency {
   uint64_t DecentralizedEpochManager::GetMaxCommittedEpochId() {
     uint64_t global_max_committed_eid = UINT64_MAX;
     
+    uint64_t current_global_epoch = GetCurrentGlobalEpoch();
+    size_t local_epoch_count = local_epoch_count_.load();
+
     // for all the local epoch contexts, obtain the minimum max committed epoch id.
-    for (auto &local_epoch_itr : local_epochs_) {
-      
-      uint64_t local_max_committed_eid = local_epoch_itr.second->GetMaxCommittedEpochId(current_global_epoch_);
+    for (size_t thread_id = 0; thread_id < local_epoch_count; ++thread_id) {
+      auto local_epoch = local_epochs_.Find(thread_id);
+      if (local_epoch == nullptr) {
+        continue;
+      }
+
+      uint64_t local_max_committed_eid =
+          local_epoch->GetMaxCommittedEpochId(current_global_epoch);
       
       if (local_max_committed_eid < global_max_committed_eid) {
         global_max_committed_eid = local_max_committed_eid;
@@ -75,9 +110,12 @@ namespace concurrency {
     // if we observe that thte global_max_committed_eid is larger than current_global_epoch_ro,
     // then it means the current thread's progress is too slow.
     // we should directly update it to global_max_committed_eid + 1.
-    if (global_max_committed_eid != UINT64_MAX && 
-        global_max_committed_eid >= current_global_epoch_ro_) {
-      current_global_epoch_ro_ = global_max_committed_eid + 1;
+    // the read-only epoch never moves backwards, even with concurrent callers.
+    if (global_max_committed_eid != UINT64_MAX) {
+      uint64_t epoch_ro = current_global_epoch_ro_.load();
+      while (global_max_committed_eid >= epoch_ro &&
+             current_global_epoch_ro_.compare_exchange_weak(
+                 epoch_ro, global_max_committed_eid + 1) == false);
     }
 
     return global_max_committed_eid;
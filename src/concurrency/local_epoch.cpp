@@ -2,7 +2,7 @@
 //
 //                         Peloton
 //
-// centralized_epoch_manager.cpp
+// local_epoch.cpp
 //
 // Identification: src/concurrency/local_epoch.cpp
 //
@@ -10,110 +10,89 @@
 //
 //===----------------------------------------------------------------------===//
 
-#include "concurrency/decentralized_epoch_manager.h"
+#include "concurrency/local_epoch.h"
+
+#include "common/macros.h"
 
 
 namespace peloton {
 namespace concurrency {
 
-  bool LocalEpoch::EnterEpoch(const uint64_t epoch_id) {
-    epoch_lock_.Lock();
-    // if this thread is never used or GC'd
-    if (epoch_lower_bound_ == UINT64_MAX) {
-      epoch_lower_bound_ = epoch_id - 1;
-    } else if (epoch_lower_bound_ >= epoch_id) {
-    // epoch_lower_bound_ has already been updated by the GC.
-    // have to grab a newer epoch_id.
-      epoch_lock_.Unlock();
-      return false;
-    } 
-
-    auto epoch_map_itr = epoch_map_.find(epoch_id);
-    // check whether the corresponding epoch exists.
-    if (epoch_map_itr == epoch_map_.end()) {
-
-      std::shared_ptr<Epoch> epoch_ptr(new Epoch(epoch_id, 1));
+  constexpr size_t LocalEpoch::kEpochRingSize;
+  constexpr size_t LocalEpoch::kTxnCountBits;
+  constexpr uint64_t LocalEpoch::kTxnCountMask;
+
+  void LocalEpoch::AddTransaction(const uint64_t epoch_id) {
+    auto &slot = GetSlot(epoch_id);
+    uint64_t old_slot = slot.load();
+    uint64_t new_slot;
+    do {
+      uint64_t txn_count = GetSlotTxnCount(old_slot);
+      PL_ASSERT(txn_count < kTxnCountMask);
+      uint64_t slot_epoch_id = epoch_id;
+      // keep the older epoch if another one still runs in this slot
+      if (txn_count != 0 && GetSlotEpochId(old_slot) < epoch_id) {
+        slot_epoch_id = GetSlotEpochId(old_slot);
+      }
+      new_slot = (slot_epoch_id << kTxnCountBits) | (txn_count + 1);
+    } while (slot.compare_exchange_weak(old_slot, new_slot) == false);
+  }
 
-      epoch_queue_.push(epoch_ptr);
-      epoch_map_[epoch_id] = epoch_ptr;
+  bool LocalEpoch::EnterEpoch(const uint64_t epoch_id) {
+    AddTransaction(epoch_id);
 
-    } else {
-      epoch_map_itr->second->txn_count_++;
+    // the garbage collector may have already decided that this epoch is
+    // committed on this thread. it either sees the transaction above, or we
+    // see its guard here, in which case we have to grab a newer epoch_id.
+    if (epoch_id < epoch_guard_.load()) {
+      ExitEpoch(epoch_id);
+      return false;
     }
-
-    epoch_lock_.Unlock();
     return true;
   }
-  
+
   // the input parameter is the global read-only epoch id.
+  // it is older than any epoch the garbage collector may reclaim, so a
+  // read-only transaction can always enter it.
   void LocalEpoch::EnterEpochRO(const uint64_t epoch_id) {
-    epoch_lock_.Lock();
-    // if this thread is never used or GC'd
-    if (epoch_lower_bound_ == UINT64_MAX) {
-      epoch_lower_bound_ = epoch_id - 1;
-    } else if (epoch_lower_bound_ >= epoch_id) {
-      epoch_lower_bound_ = epoch_id - 1;
-    }
-
-    if (epoch_map_.find(epoch_id) == epoch_map_.end()) {
-
-      std::shared_ptr<Epoch> epoch_ptr(new Epoch(epoch_id, 1));
-
-      epoch_queue_.push(epoch_ptr);
-      epoch_map_[epoch_id] = epoch_ptr;
-
-    } else {
-      epoch_map_.at(epoch_id)->txn_count_++;
-    }
-
-    epoch_lock_.Unlock();
+    AddTransaction(epoch_id);
   }
 
-
   void LocalEpoch::ExitEpoch(const uint64_t epoch_id) {
-    epoch_lock_.Lock();
-
-    PL_ASSERT(epoch_map_.find(epoch_id) != epoch_map_.end());
-    epoch_map_.at(epoch_id)->txn_count_--;
+    auto &slot = GetSlot(epoch_id);
+    uint64_t old_slot = slot.load();
+    uint64_t new_slot;
+    do {
+      PL_ASSERT(GetSlotTxnCount(old_slot) != 0);
+      PL_ASSERT(GetSlotEpochId(old_slot) <= epoch_id);
+      new_slot = old_slot - 1;
+    } while (slot.compare_exchange_weak(old_slot, new_slot) == false);
+  }
 
-    while (epoch_queue_.size() != 0) {
-      auto &epoch_ptr = epoch_queue_.top();
-      if (epoch_ptr->txn_count_ == 0) {
-        epoch_map_.erase(epoch_ptr->epoch_id_);
-        epoch_queue_.pop();
-      } else {
-        PL_ASSERT(epoch_ptr->epoch_id_ > epoch_lower_bound_);
-        epoch_lower_bound_ = epoch_ptr->epoch_id_ - 1;
-        break;
+  uint64_t LocalEpoch::GetMaxCommittedEpochId(const uint64_t current_epoch_id) {
+    // publish the guard before looking at the slots, see EnterEpoch.
+    uint64_t guard = epoch_guard_.load();
+    while (guard < current_epoch_id &&
+           epoch_guard_.compare_exchange_weak(guard, current_epoch_id) ==
+               false);
+
+    // the oldest epoch that still has a running transaction.
+    // if there is none, every epoch before the current one is committed.
+    uint64_t min_epoch_id = current_epoch_id;
+    for (auto &slot : epoch_ring_) {
+      uint64_t value = slot.load();
+      if (GetSlotTxnCount(value) != 0 && GetSlotEpochId(value) < min_epoch_id) {
+        min_epoch_id = GetSlotEpochId(value);
       }
     }
-
-    epoch_lock_.Unlock();
+    return min_epoch_id - 1;
   }
 
-  uint64_t LocalEpoch::GetMaxCommittedEpochId(const uint64_t epoch_id) {
-    epoch_lock_.Lock();
-    // there's no epoch in this thread.
-    // which indicates that this thread is used or GC'd for some time.
-    if (epoch_queue_.size() == 0) {
-      epoch_lower_bound_ = epoch_id - 1;
-    } else {
-      while (epoch_queue_.size() != 0) {
-        auto &epoch_ptr = epoch_queue_.top();
-        if (epoch_ptr->txn_count_ == 0) {
-          epoch_map_.erase(epoch_ptr->epoch_id_);
-          epoch_queue_.pop();
-        } else {
-          PL_ASSERT(epoch_ptr->epoch_id_ > epoch_lower_bound_);
-          epoch_lower_bound_ = epoch_ptr->epoch_id_ - 1;
-          break;
-        }
-      }
+  void LocalEpoch::Reset() {
+    epoch_guard_ = 0;
+    for (auto &slot : epoch_ring_) {
+      slot = 0;
     }
-    uint64_t ret = epoch_lower_bound_;
-    
-    epoch_lock_.Unlock();
-    return ret;
   }
 
 }
@@ -0,0 +1,93 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// read_write_set.cpp
+//
+// Identification: src/concurrency/read_write_set.cpp
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "concurrency/read_write_set.h"
+
+#include <algorithm>
+
+#include "common/macros.h"
+
+namespace peloton {
+namespace concurrency {
+
+constexpr uint32_t ReadWriteSet::kEmptySlot;
+constexpr size_t ReadWriteSet::kInitialSlotCount;
+constexpr size_t ReadWriteSet::kMaxRetainedSlotCount;
+
+ReadWriteSet::ReadWriteSet()
+    : slots_(kInitialSlotCount, kEmptySlot), slot_bits_(6) {
+  PL_ASSERT((1ul << slot_bits_) == kInitialSlotCount);
+}
+
+RWType *ReadWriteSet::Find(const ItemPointer &location) {
+  size_t mask = slots_.size() - 1;
+  for (size_t slot = GetSlot(location);; slot = (slot + 1) & mask) {
+    uint32_t entry_id = slots_[slot];
+    if (entry_id == kEmptySlot) {
+      return nullptr;
+    }
+    auto &entry = entries_[entry_id];
+    if (entry.location.block == location.block &&
+        entry.location.offset == location.offset) {
+      return &entry.type;
+    }
+  }
+}
+
+void ReadWriteSet::Insert(const ItemPointer &location, RWType type) {
+  PL_ASSERT(Find(location) == nullptr);
+
+  // Keep the load factor under 1/2
+  if ((entries_.size() + 1) * 2 > slots_.size()) {
+    Grow();
+  }
+
+  size_t mask = slots_.size() - 1;
+  size_t slot = GetSlot(location);
+  while (slots_[slot] != kEmptySlot) {
+    slot = (slot + 1) & mask;
+  }
+  slots_[slot] = static_cast<uint32_t>(entries_.size());
+  entries_.emplace_back(location, type);
+}
+
+void ReadWriteSet::Clear() {
+  if (entries_.empty()) {
+    return;
+  }
+  entries_.clear();
+  if (slots_.size() > kMaxRetainedSlotCount) {
+    slots_.assign(kInitialSlotCount, kEmptySlot);
+    slots_.shrink_to_fit();
+    entries_.shrink_to_fit();
+    slot_bits_ = 6;
+  } else {
+    std::fill(slots_.begin(), slots_.end(), kEmptySlot);
+  }
+}
+
+void ReadWriteSet::Grow() {
+  slot_bits_++;
+  slots_.assign(1ul << slot_bits_, kEmptySlot);
+
+  size_t mask = slots_.size() - 1;
+  for (uint32_t entry_id = 0; entry_id < entries_.size(); entry_id++) {
+    size_t slot = GetSlot(entries_[entry_id].location);
+    while (slots_[slot] != kEmptySlot) {
+      slot = (slot + 1) & mask;
+    }
+    slots_[slot] = entry_id;
+  }
+}
+
+}  // End concurrency namespace
+}  // End peloton namespace
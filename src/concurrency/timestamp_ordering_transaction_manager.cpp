@@ -12,18 +12,69 @@
 
 #include "concurrency/timestamp_ordering_transaction_manager.h"
 
+#include <memory>
+#include <vector>
+
 #include "catalog/manager.h"
 #include "common/exception.h"
 #include "common/logger.h"
 #include "common/platform.h"
 #include "concurrency/transaction.h"
+#include "concurrency/transaction_manager_factory.h"
+#include "configuration/configuration.h"
 #include "gc/gc_manager_factory.h"
 #include "logging/log_manager.h"
 #include "logging/records/transaction_record.h"
+#include "storage/tile_group.h"
 
 namespace peloton {
 namespace concurrency {
 
+namespace {
+
+// Ended transactions are kept for reuse by the next transactions of the same
+// thread, so that a new transaction does not have to allocate its read-write
+// set again
+constexpr size_t kMaxPooledTransactionCount = 16;
+thread_local std::vector<std::unique_ptr<Transaction>> transaction_pool;
+
+Transaction *AllocateTransaction(const cid_t &begin_cid,
+                                 const size_t thread_id, const bool readonly,
+                                 const IsolationLevelType isolation_level) {
+  if (transaction_pool.empty()) {
+    return new Transaction(begin_cid, thread_id, readonly, isolation_level);
+  }
+  Transaction *txn = transaction_pool.back().release();
+  transaction_pool.pop_back();
+  txn->Init(begin_cid, thread_id, readonly, isolation_level);
+  return txn;
+}
+
+void ReleaseTransaction(Transaction *txn) {
+  if (transaction_pool.size() < kMaxPooledTransactionCount) {
+    transaction_pool.emplace_back(txn);
+  } else {
+    delete txn;
+  }
+}
+
+// the varlen columns whose data a version shares with another version of the
+// same tuple, see TileGroup::CopyVersion(). the versions only share data when
+// the updates copy them, so the columns are not compared otherwise.
+uint64_t GetSharedVarlenColumns(const ItemPointer &location,
+                                const ItemPointer &other) {
+  if (FLAGS_shared_version_columns == false) {
+    return 0;
+  }
+  auto &manager = catalog::Manager::GetInstance();
+  return manager.GetTileGroupPtr(location.block)
+      ->GetSharedVarlenColumns(location.offset,
+                               manager.GetTileGroupPtr(other.block),
+                               other.offset);
+}
+
+}  // anonymous namespace
+
 // timestamp ordering requires a spinlock field for protecting the atomic access
 // to txn_id field and last_reader_cid field.
 Spinlock *TimestampOrderingTransactionManager::GetSpinlockField(
@@ -84,16 +135,59 @@ void TimestampOrderingTransactionManager::InitTupleReserved(
   *(cid_t *)(reserved_area + LAST_READER_OFFSET) = 0;
 }
 
+// the slot is marked before the commit id is taken. a snapshot whose begin
+// commit id was taken before the mark gets a smaller commit id than the
+// writer, so the snapshots that have to wait for the writer always find it.
+size_t TimestampOrderingTransactionManager::EnterSnapshotCommit(
+    const size_t thread_id, cid_t &end_commit_id) {
+  size_t commit_slot = thread_id % COMMIT_SLOT_COUNT;
+  while (true) {
+    cid_t free_slot = MAX_CID;
+    if (commit_slots_[commit_slot].compare_exchange_strong(free_slot,
+                                                           INVALID_CID)) {
+      break;
+    }
+    commit_slot = (commit_slot + 1) % COMMIT_SLOT_COUNT;
+  }
+
+  end_commit_id = EpochManagerFactory::GetInstance().GetCurrentEpochCommitId();
+  commit_slots_[commit_slot] = end_commit_id;
+  return commit_slot;
+}
+
+void TimestampOrderingTransactionManager::ExitSnapshotCommit(
+    const size_t commit_slot) {
+  commit_slots_[commit_slot] = MAX_CID;
+}
+
+// writers never wait for snapshots, and a snapshot only waits for the
+// writers that are installing the versions it has to see.
+void TimestampOrderingTransactionManager::WaitForSnapshotCommits(
+    const cid_t snapshot_cid) {
+  for (auto &commit_slot : commit_slots_) {
+    cid_t commit_id = commit_slot.load();
+    while (commit_id == INVALID_CID || commit_id < snapshot_cid) {
+      _mm_pause();
+      commit_id = commit_slot.load();
+    }
+  }
+}
+
 Transaction *TimestampOrderingTransactionManager::BeginTransaction(const size_t thread_id) {
 
   auto &log_manager = logging::LogManager::GetInstance();
   log_manager.PrepareLogging();
 
   Transaction *txn = nullptr;
+  auto isolation_level = TransactionManagerFactory::GetIsolationLevel();
 
   // transaction processing with centralized epoch manager
   cid_t begin_cid = EpochManagerFactory::GetInstance().EnterEpoch(thread_id);
-  txn = new Transaction(begin_cid, thread_id);
+  if (isolation_level == IsolationLevelType::SNAPSHOT) {
+    // do not take a snapshot in the middle of a commit
+    WaitForSnapshotCommits(begin_cid);
+  }
+  txn = AllocateTransaction(begin_cid, thread_id, false, isolation_level);
 
   if (FLAGS_stats_mode != STATS_TYPE_INVALID) {
     stats::BackendStatsContext::GetInstance()
@@ -109,7 +203,8 @@ Transaction *TimestampOrderingTransactionManager::BeginReadonlyTransaction(const
 
   // transaction processing with centralized epoch manager
   cid_t begin_cid = EpochManagerFactory::GetInstance().EnterEpochRO(thread_id);
-  txn = new Transaction(begin_cid, thread_id, true);
+  txn = AllocateTransaction(begin_cid, thread_id, true,
+                            IsolationLevelType::FULL);
 
   if (FLAGS_stats_mode != STATS_TYPE_INVALID) {
     stats::BackendStatsContext::GetInstance()
@@ -134,11 +229,10 @@ void TimestampOrderingTransactionManager::EndTransaction(
   if (current_txn->GetResult() == ResultType::SUCCESS) {
     if (current_txn->IsGCSetEmpty() != true) {
       gc::GCManagerFactory::GetInstance().
-          RecycleTransaction(current_txn->GetGCSetPtr(), current_txn->GetBeginCommitId());
+          RecycleTransaction(current_txn->GetGCSetPtr(), current_txn->GetEndCommitId());
     }
     // Log the transaction's commit
-    // For time stamp ordering, every transaction only has one timestamp
-    log_manager.LogCommitTransaction(current_txn->GetBeginCommitId());
+    log_manager.LogCommitTransaction(current_txn->GetEndCommitId());
   } else {
     if (current_txn->IsGCSetEmpty() != true) {
       gc::GCManagerFactory::GetInstance().
@@ -147,7 +241,7 @@ void TimestampOrderingTransactionManager::EndTransaction(
     log_manager.DoneLogging();
   }
 
-  delete current_txn;
+  ReleaseTransaction(current_txn);
   current_txn = nullptr;
   
   if (FLAGS_stats_mode != STATS_TYPE_INVALID) {
@@ -166,7 +260,7 @@ void TimestampOrderingTransactionManager::EndReadonlyTransaction(
     current_txn->GetThreadId(), 
     current_txn->GetBeginCommitId());
   
-  delete current_txn;
+  ReleaseTransaction(current_txn);
   current_txn = nullptr;
   
   if (FLAGS_stats_mode != STATS_TYPE_INVALID) {
@@ -190,7 +284,7 @@ bool TimestampOrderingTransactionManager::IsOccupied(
   ItemPointer &position = *((ItemPointer *)position_ptr);
 
   auto tile_group_header =
-      catalog::Manager::GetInstance().GetTileGroup(position.block)->GetHeader();
+      catalog::Manager::GetInstance().GetTileGroupHeader(position.block);
   auto tuple_id = position.offset;
 
   txn_id_t tuple_txn_id = tile_group_header->GetTransactionId(tuple_id);
@@ -326,6 +420,35 @@ VisibilityType TimestampOrderingTransactionManager::IsVisible(
   }
 }
 
+// this function checks the visibility of a whole range of a tile group.
+// versions that are not owned by any transaction are checked right here
+// against the commit ids of the transaction, without going through
+// IsVisible(). this is the case for almost all the versions in a table.
+void TimestampOrderingTransactionManager::GetVisibleTuples(
+    Transaction *const current_txn,
+    const storage::TileGroupHeader *const tile_group_header,
+    const oid_t tuple_count, std::vector<oid_t> &visible_tuples) {
+  cid_t txn_begin_cid = current_txn->GetBeginCommitId();
+  visible_tuples.reserve(visible_tuples.size() + tuple_count);
+
+  for (oid_t tuple_id = 0; tuple_id < tuple_count; tuple_id++) {
+    txn_id_t tuple_txn_id = tile_group_header->GetTransactionId(tuple_id);
+    cid_t tuple_begin_cid = tile_group_header->GetBeginCommitId(tuple_id);
+
+    if (tuple_txn_id == INITIAL_TXN_ID &&
+        !CidIsInDirtyRange(tuple_begin_cid)) {
+      cid_t tuple_end_cid = tile_group_header->GetEndCommitId(tuple_id);
+      // the tuple is visible if it is activated and not invalidated.
+      if (txn_begin_cid >= tuple_begin_cid && txn_begin_cid < tuple_end_cid) {
+        visible_tuples.push_back(tuple_id);
+      }
+    } else if (IsVisible(current_txn, tile_group_header, tuple_id) ==
+               VisibilityType::OK) {
+      visible_tuples.push_back(tuple_id);
+    }
+  }
+}
+
 // check whether the current transaction owns the tuple.
 // this function is called by update/delete executors.
 bool TimestampOrderingTransactionManager::IsOwner(
@@ -356,6 +479,11 @@ bool TimestampOrderingTransactionManager::IsOwnable(
     const oid_t &tuple_id) {
   auto tuple_txn_id = tile_group_header->GetTransactionId(tuple_id);
   auto tuple_end_cid = tile_group_header->GetEndCommitId(tuple_id);
+  if (current_txn->GetIsolationLevel() == IsolationLevelType::SNAPSHOT) {
+    // only the latest version can be owned, a newer version means that some
+    // other transaction has committed a write to this tuple first.
+    return tuple_txn_id == INITIAL_TXN_ID && tuple_end_cid == MAX_CID;
+  }
   return tuple_txn_id == INITIAL_TXN_ID &&
          tuple_end_cid > current_txn->GetBeginCommitId();
 }
@@ -366,6 +494,20 @@ bool TimestampOrderingTransactionManager::AcquireOwnership(
     const oid_t &tuple_id) {
   auto txn_id = current_txn->GetTransactionId();
 
+  if (current_txn->GetIsolationLevel() == IsolationLevelType::SNAPSHOT) {
+    // reads are not tracked, only concurrent writers can conflict.
+    if (tile_group_header->SetAtomicTransactionId(tuple_id, txn_id) == false) {
+      return false;
+    }
+    // a writer sets the end commit id of the version before it releases the
+    // ownership, so a version that has been replaced in between is seen here.
+    if (tile_group_header->GetEndCommitId(tuple_id) != MAX_CID) {
+      tile_group_header->SetTransactionId(tuple_id, INITIAL_TXN_ID);
+      return false;
+    }
+    return true;
+  }
+
   // to acquire the ownership, we must guarantee that no other transactions that
   // has read
   // the tuple has a larger timestamp than the current transaction.
@@ -400,7 +542,7 @@ void TimestampOrderingTransactionManager::YieldOwnership(
     UNUSED_ATTRIBUTE Transaction *const current_txn, const oid_t &tile_group_id,
     const oid_t &tuple_id) {
   auto &manager = catalog::Manager::GetInstance();
-  auto tile_group_header = manager.GetTileGroup(tile_group_id)->GetHeader();
+  auto tile_group_header = manager.GetTileGroupHeader(tile_group_id);
   PL_ASSERT(IsOwner(current_txn, tile_group_header, tuple_id));
   tile_group_header->SetTransactionId(tuple_id, INITIAL_TXN_ID);
 }
@@ -418,8 +560,7 @@ bool TimestampOrderingTransactionManager::PerformRead(
 
   LOG_TRACE("PerformRead (%u, %u)\n", location.block, location.offset);
   auto &manager = catalog::Manager::GetInstance();
-  auto tile_group = manager.GetTileGroup(tile_group_id);
-  auto tile_group_header = tile_group->GetHeader();
+  auto tile_group_header = manager.GetTileGroupHeader(tile_group_id);
 
   // Check if it's select for update before we check the ownership and modify
   // the
@@ -439,11 +580,15 @@ bool TimestampOrderingTransactionManager::PerformRead(
     current_txn->RecordReadOwn(location);
   }
 
-  // if the current transaction has already owned this tuple, then perform read
-  // directly.
-  if (IsOwner(current_txn, tile_group_header, tuple_id) == true) {
-    PL_ASSERT(GetLastReaderCommitId(tile_group_header, tuple_id) <=
-              current_txn->GetBeginCommitId());
+  auto isolation_level = current_txn->GetIsolationLevel();
+
+  // if the current transaction has already owned this tuple, or does not need
+  // to protect its reads (snapshot isolation), then perform read directly.
+  if (isolation_level == IsolationLevelType::SNAPSHOT ||
+      IsOwner(current_txn, tile_group_header, tuple_id) == true) {
+    PL_ASSERT(isolation_level == IsolationLevelType::SNAPSHOT ||
+              GetLastReaderCommitId(tile_group_header, tuple_id) <=
+                  current_txn->GetBeginCommitId());
     // Increment table read op stats
     if (FLAGS_stats_mode != STATS_TYPE_INVALID) {
       stats::BackendStatsContext::GetInstance()->IncrementTableReads(
@@ -455,7 +600,10 @@ bool TimestampOrderingTransactionManager::PerformRead(
   // reader cid.
   if (SetLastReaderCommitId(tile_group_header, tuple_id,
                             current_txn->GetBeginCommitId()) == true) {
-    current_txn->RecordRead(location);
+    // only full serializability keeps the reads in the read-write set.
+    if (isolation_level != IsolationLevelType::REPEATABLE_READ) {
+      current_txn->RecordRead(location);
+    }
     // Increment table read op stats
     if (FLAGS_stats_mode != STATS_TYPE_INVALID) {
       stats::BackendStatsContext::GetInstance()->IncrementTableReads(
@@ -479,7 +627,7 @@ void TimestampOrderingTransactionManager::PerformInsert(
   oid_t tuple_id = location.offset;
 
   auto &manager = catalog::Manager::GetInstance();
-  auto tile_group_header = manager.GetTileGroup(tile_group_id)->GetHeader();
+  auto tile_group_header = manager.GetTileGroupHeader(tile_group_id);
   auto transaction_id = current_txn->GetTransactionId();
 
   // check MVCC info
@@ -517,12 +665,9 @@ void TimestampOrderingTransactionManager::PerformUpdate(
   LOG_TRACE("Performing Write new tuple %u %u", new_location.block,
             new_location.offset);
 
-  auto tile_group_header = catalog::Manager::GetInstance()
-                               .GetTileGroup(old_location.block)
-                               ->GetHeader();
-  auto new_tile_group_header = catalog::Manager::GetInstance()
-                                   .GetTileGroup(new_location.block)
-                                   ->GetHeader();
+  auto &manager = catalog::Manager::GetInstance();
+  auto tile_group_header = manager.GetTileGroupHeader(old_location.block);
+  auto new_tile_group_header = manager.GetTileGroupHeader(new_location.block);
 
   auto transaction_id = current_txn->GetTransactionId();
   // if we can perform update, then we must have already locked the older
@@ -556,9 +701,8 @@ void TimestampOrderingTransactionManager::PerformUpdate(
   COMPILER_MEMORY_FENCE;
 
   if (old_prev.IsNull() == false) {
-    auto old_prev_tile_group_header = catalog::Manager::GetInstance()
-                                          .GetTileGroup(old_prev.block)
-                                          ->GetHeader();
+    auto old_prev_tile_group_header =
+        manager.GetTileGroupHeader(old_prev.block);
 
     // once everything is set, we can allow traversing the new version.
     old_prev_tile_group_header->SetNextItemPointer(old_prev.offset,
@@ -611,7 +755,7 @@ void TimestampOrderingTransactionManager::PerformUpdate(
   oid_t tuple_id = location.offset;
 
   auto &manager = catalog::Manager::GetInstance();
-  auto tile_group_header = manager.GetTileGroup(tile_group_id)->GetHeader();
+  auto tile_group_header = manager.GetTileGroupHeader(tile_group_id);
 
   PL_ASSERT(tile_group_header->GetTransactionId(tuple_id) ==
             current_txn->GetTransactionId());
@@ -639,12 +783,9 @@ void TimestampOrderingTransactionManager::PerformDelete(
 
   LOG_TRACE("Performing Delete");
 
-  auto tile_group_header = catalog::Manager::GetInstance()
-                               .GetTileGroup(old_location.block)
-                               ->GetHeader();
-  auto new_tile_group_header = catalog::Manager::GetInstance()
-                                   .GetTileGroup(new_location.block)
-                                   ->GetHeader();
+  auto &manager = catalog::Manager::GetInstance();
+  auto tile_group_header = manager.GetTileGroupHeader(old_location.block);
+  auto new_tile_group_header = manager.GetTileGroupHeader(new_location.block);
 
   auto transaction_id = current_txn->GetTransactionId();
 
@@ -679,9 +820,8 @@ void TimestampOrderingTransactionManager::PerformDelete(
   COMPILER_MEMORY_FENCE;
 
   if (old_prev.IsNull() == false) {
-    auto old_prev_tile_group_header = catalog::Manager::GetInstance()
-                                          .GetTileGroup(old_prev.block)
-                                          ->GetHeader();
+    auto old_prev_tile_group_header =
+        manager.GetTileGroupHeader(old_prev.block);
 
     old_prev_tile_group_header->SetNextItemPointer(old_prev.offset,
                                                    new_location);
@@ -732,7 +872,7 @@ void TimestampOrderingTransactionManager::PerformDelete(
   oid_t tuple_id = location.offset;
 
   auto &manager = catalog::Manager::GetInstance();
-  auto tile_group_header = manager.GetTileGroup(tile_group_id)->GetHeader();
+  auto tile_group_header = manager.GetTileGroupHeader(tile_group_id);
 
   PL_ASSERT(tile_group_header->GetTransactionId(tuple_id) ==
             current_txn->GetTransactionId());
@@ -769,19 +909,34 @@ ResultType TimestampOrderingTransactionManager::CommitTransaction(
   auto &manager = catalog::Manager::GetInstance();
   auto &log_manager = logging::LogManager::GetInstance();
 
+  auto &rw_set = current_txn->GetReadWriteSet();
+
   // generate transaction id.
-  cid_t end_commit_id = current_txn->GetBeginCommitId();
+  // under snapshot isolation, the writes of the transaction become visible to
+  // the snapshots taken after it commits, so it gets a fresh commit id. the
+  // commit id stays in its commit slot until all the new versions are
+  // installed.
+  bool snapshot_commit =
+      current_txn->GetIsolationLevel() == IsolationLevelType::SNAPSHOT &&
+      !rw_set.empty();
+  size_t commit_slot = 0;
+  cid_t end_commit_id;
+  if (snapshot_commit) {
+    commit_slot =
+        EnterSnapshotCommit(current_txn->GetThreadId(), end_commit_id);
+  } else {
+    end_commit_id = current_txn->GetBeginCommitId();
+  }
+  current_txn->SetEndCommitId(end_commit_id);
   log_manager.LogBeginTransaction(end_commit_id);
 
-  auto &rw_set = current_txn->GetReadWriteSet();
-
   auto gc_set = current_txn->GetGCSetPtr();
 
   oid_t database_id = 0;
   if (FLAGS_stats_mode != STATS_TYPE_INVALID) {
     if (!rw_set.empty()) {
-      database_id =
-          manager.GetTileGroup(rw_set.begin()->first)->GetDatabaseId();
+      database_id = manager.GetTileGroup(rw_set.begin()->location.block)
+                        ->GetDatabaseId();
     }
   }
 
@@ -789,125 +944,146 @@ ResultType TimestampOrderingTransactionManager::CommitTransaction(
   // 1. install a new version for update operations;
   // 2. install an empty version for delete operations;
   // 3. install a new tuple for insert operations.
-  for (auto &tile_group_entry : rw_set) {
-    oid_t tile_group_id = tile_group_entry.first;
-    auto tile_group = manager.GetTileGroup(tile_group_id);
-    auto tile_group_header = tile_group->GetHeader();
-    for (auto &tuple_entry : tile_group_entry.second) {
-      auto tuple_slot = tuple_entry.first;
-      if (tuple_entry.second == RWType::READ_OWN) {
-        // A read operation has acquired ownership but hasn't done any further
-        // update/delete yet
-        // Yield the ownership
-        YieldOwnership(current_txn, tile_group_id, tuple_slot);
-      } else if (tuple_entry.second == RWType::UPDATE) {
-        // we must guarantee that, at any time point, only one version is
-        // visible.
-        ItemPointer new_version =
-            tile_group_header->GetPrevItemPointer(tuple_slot);
-
-        PL_ASSERT(new_version.IsNull() == false);
-
-        auto cid = tile_group_header->GetEndCommitId(tuple_slot);
-        PL_ASSERT(cid > end_commit_id);
-        auto new_tile_group_header =
-            manager.GetTileGroup(new_version.block)->GetHeader();
-        new_tile_group_header->SetBeginCommitId(new_version.offset,
-                                                end_commit_id);
-        new_tile_group_header->SetEndCommitId(new_version.offset, cid);
-
-        COMPILER_MEMORY_FENCE;
-
-        tile_group_header->SetEndCommitId(tuple_slot, end_commit_id);
-
-        // we should set the version before releasing the lock.
-        COMPILER_MEMORY_FENCE;
-
-        new_tile_group_header->SetTransactionId(new_version.offset,
-                                                INITIAL_TXN_ID);
-        tile_group_header->SetTransactionId(tuple_slot, INITIAL_TXN_ID);
-
-        // add to gc set.
-        gc_set->operator[](tile_group_id)[tuple_slot] = false;
-
-        // add to log manager
-        log_manager.LogUpdate(
-            end_commit_id, ItemPointer(tile_group_id, tuple_slot), new_version);
-
-      } else if (tuple_entry.second == RWType::DELETE) {
-        ItemPointer new_version =
-            tile_group_header->GetPrevItemPointer(tuple_slot);
-
-        auto cid = tile_group_header->GetEndCommitId(tuple_slot);
-        PL_ASSERT(cid > end_commit_id);
-        auto new_tile_group_header =
-            manager.GetTileGroup(new_version.block)->GetHeader();
-        new_tile_group_header->SetBeginCommitId(new_version.offset,
-                                                end_commit_id);
-        new_tile_group_header->SetEndCommitId(new_version.offset, cid);
-
-        COMPILER_MEMORY_FENCE;
-
-        tile_group_header->SetEndCommitId(tuple_slot, end_commit_id);
-
-        // we should set the version before releasing the lock.
-        COMPILER_MEMORY_FENCE;
-
-        new_tile_group_header->SetTransactionId(new_version.offset,
-                                                INVALID_TXN_ID);
-        tile_group_header->SetTransactionId(tuple_slot, INITIAL_TXN_ID);
-
-        // add to gc set.
-        // we need to recycle both old and new versions.
-        // we require the GC to delete tuple from index only once.
-        // recycle old version, delete from index
-        gc_set->operator[](tile_group_id)[tuple_slot] = true;
-        // recycle new version (which is an empty version), do not delete from index
-        gc_set->operator[](new_version.block)[new_version.offset] = false;
-
-        // add to log manager
-        log_manager.LogDelete(end_commit_id,
-                              ItemPointer(tile_group_id, tuple_slot));
-
-      } else if (tuple_entry.second == RWType::INSERT) {
-        PL_ASSERT(tile_group_header->GetTransactionId(tuple_slot) ==
-                  current_txn->GetTransactionId());
-        // set the begin commit id to persist insert
-        tile_group_header->SetBeginCommitId(tuple_slot, end_commit_id);
-        tile_group_header->SetEndCommitId(tuple_slot, MAX_CID);
-
-        // we should set the version before releasing the lock.
-        COMPILER_MEMORY_FENCE;
-
-        tile_group_header->SetTransactionId(tuple_slot, INITIAL_TXN_ID);
-
-        // nothing to be added to gc set.
-
-        // add to log manager
-        log_manager.LogInsert(end_commit_id,
-                              ItemPointer(tile_group_id, tuple_slot));
-
-      } else if (tuple_entry.second == RWType::INS_DEL) {
-        PL_ASSERT(tile_group_header->GetTransactionId(tuple_slot) ==
-                  current_txn->GetTransactionId());
-
-        tile_group_header->SetBeginCommitId(tuple_slot, MAX_CID);
-        tile_group_header->SetEndCommitId(tuple_slot, MAX_CID);
+  // the entries of a tile group are usually recorded one after another
+  oid_t tile_group_id = INVALID_OID;
+  storage::TileGroupHeader *tile_group_header = nullptr;
+  for (auto &entry : rw_set) {
+    if (entry.location.block != tile_group_id) {
+      tile_group_id = entry.location.block;
+      tile_group_header = manager.GetTileGroupHeader(tile_group_id);
+    }
+    auto tuple_slot = entry.location.offset;
+    if (entry.type == RWType::READ_OWN) {
+      // A read operation has acquired ownership but hasn't done any further
+      // update/delete yet
+      // Yield the ownership
+      YieldOwnership(current_txn, tile_group_id, tuple_slot);
+    } else if (entry.type == RWType::UPDATE) {
+      // we must guarantee that, at any time point, only one version is
+      // visible.
+      ItemPointer new_version =
+          tile_group_header->GetPrevItemPointer(tuple_slot);
+
+      PL_ASSERT(new_version.IsNull() == false);
+
+      auto cid = tile_group_header->GetEndCommitId(tuple_slot);
+      PL_ASSERT(cid > end_commit_id);
+      auto new_tile_group_header =
+          manager.GetTileGroupHeader(new_version.block);
+      new_tile_group_header->SetBeginCommitId(new_version.offset,
+                                              end_commit_id);
+      new_tile_group_header->SetEndCommitId(new_version.offset, cid);
+
+      COMPILER_MEMORY_FENCE;
+
+      tile_group_header->SetEndCommitId(tuple_slot, end_commit_id);
+
+      // we should set the version before releasing the lock.
+      COMPILER_MEMORY_FENCE;
+
+      new_tile_group_header->SetTransactionId(new_version.offset,
+                                              INITIAL_TXN_ID);
+      tile_group_header->SetTransactionId(tuple_slot, INITIAL_TXN_ID);
+
+      // add to gc set.
+      // the new version takes over the varlen data it shares with the old
+      // version, the rest of the old version is reclaimed.
+      ItemPointer old_version(tile_group_id, tuple_slot);
+      auto shared_columns = GetSharedVarlenColumns(old_version, new_version);
+      if (shared_columns != 0) {
+        manager.GetTileGroupPtr(new_version.block)
+            ->AdoptVarlenColumns(new_version.offset,
+                                 manager.GetTileGroupPtr(tile_group_id),
+                                 shared_columns);
+      }
+      gc_set->emplace_back(old_version, false, shared_columns);
 
-        // we should set the version before releasing the lock.
-        COMPILER_MEMORY_FENCE;
+      // add to log manager
+      log_manager.LogUpdate(
+          end_commit_id, ItemPointer(tile_group_id, tuple_slot), new_version);
 
-        // set the begin commit id to persist insert
-        tile_group_header->SetTransactionId(tuple_slot, INVALID_TXN_ID);
+    } else if (entry.type == RWType::DELETE) {
+      ItemPointer new_version =
+          tile_group_header->GetPrevItemPointer(tuple_slot);
 
-        // add to gc set.
-        gc_set->operator[](tile_group_id)[tuple_slot] = true;
+      auto cid = tile_group_header->GetEndCommitId(tuple_slot);
+      PL_ASSERT(cid > end_commit_id);
+      auto new_tile_group_header =
+          manager.GetTileGroupHeader(new_version.block);
+      new_tile_group_header->SetBeginCommitId(new_version.offset,
+                                              end_commit_id);
+      new_tile_group_header->SetEndCommitId(new_version.offset, cid);
 
-        // no log is needed for this case
-      }
+      COMPILER_MEMORY_FENCE;
+
+      tile_group_header->SetEndCommitId(tuple_slot, end_commit_id);
+
+      // we should set the version before releasing the lock.
+      COMPILER_MEMORY_FENCE;
+
+      new_tile_group_header->SetTransactionId(new_version.offset,
+                                              INVALID_TXN_ID);
+      tile_group_header->SetTransactionId(tuple_slot, INITIAL_TXN_ID);
+
+      // add to gc set.
+      // we need to recycle both old and new versions.
+      // we require the GC to delete tuple from index only once.
+      // recycle old version, delete from index
+      gc_set->emplace_back(ItemPointer(tile_group_id, tuple_slot), true);
+      // recycle new version (which is an empty version), do not delete from
+      // index. if the transaction updated the tuple before deleting it, the
+      // new version shares the varlen data of the old version.
+      gc_set->emplace_back(
+          new_version, false,
+          GetSharedVarlenColumns(new_version,
+                                 ItemPointer(tile_group_id, tuple_slot)));
+
+      // add to log manager
+      log_manager.LogDelete(end_commit_id,
+                            ItemPointer(tile_group_id, tuple_slot));
+
+    } else if (entry.type == RWType::INSERT) {
+      PL_ASSERT(tile_group_header->GetTransactionId(tuple_slot) ==
+                current_txn->GetTransactionId());
+      // set the begin commit id to persist insert
+      tile_group_header->SetBeginCommitId(tuple_slot, end_commit_id);
+      tile_group_header->SetEndCommitId(tuple_slot, MAX_CID);
+
+      // we should set the version before releasing the lock.
+      COMPILER_MEMORY_FENCE;
+
+      tile_group_header->SetTransactionId(tuple_slot, INITIAL_TXN_ID);
+
+      // nothing to be added to gc set.
+
+      // add to log manager
+      log_manager.LogInsert(end_commit_id,
+                            ItemPointer(tile_group_id, tuple_slot));
+
+    } else if (entry.type == RWType::INS_DEL) {
+      PL_ASSERT(tile_group_header->GetTransactionId(tuple_slot) ==
+                current_txn->GetTransactionId());
+
+      tile_group_header->SetBeginCommitId(tuple_slot, MAX_CID);
+      tile_group_header->SetEndCommitId(tuple_slot, MAX_CID);
+
+      // we should set the version before releasing the lock.
+      COMPILER_MEMORY_FENCE;
+
+      // set the begin commit id to persist insert
+      tile_group_header->SetTransactionId(tuple_slot, INVALID_TXN_ID);
+
+      // add to gc set.
+      gc_set->emplace_back(ItemPointer(tile_group_id, tuple_slot), true);
+
+      // no log is needed for this case
     }
   }
 
+  if (snapshot_commit) {
+    ExitSnapshotCommit(commit_slot);
+  }
+
   ResultType result = current_txn->GetResult();
 
   EndTransaction(current_txn);
@@ -936,160 +1112,167 @@ ResultType TimestampOrderingTransactionManager::AbortTransaction(
   oid_t database_id = 0;
   if (FLAGS_stats_mode != STATS_TYPE_INVALID) {
     if (!rw_set.empty()) {
-      database_id =
-          manager.GetTileGroup(rw_set.begin()->first)->GetDatabaseId();
+      database_id = manager.GetTileGroup(rw_set.begin()->location.block)
+                        ->GetDatabaseId();
     }
   }
 
-  for (auto &tile_group_entry : rw_set) {
-    oid_t tile_group_id = tile_group_entry.first;
-    auto tile_group = manager.GetTileGroup(tile_group_id);
-    auto tile_group_header = tile_group->GetHeader();
-
-    for (auto &tuple_entry : tile_group_entry.second) {
-      auto tuple_slot = tuple_entry.first;
-      if (tuple_entry.second == RWType::READ_OWN) {
-        // A read operation has acquired ownership but hasn't done any further
-        // update/delete yet
-        // Yield the ownership
-        YieldOwnership(current_txn, tile_group_id, tuple_slot);
-      } else if (tuple_entry.second == RWType::UPDATE) {
-        ItemPointer new_version =
-            tile_group_header->GetPrevItemPointer(tuple_slot);
-
-        auto new_tile_group_header =
-            manager.GetTileGroup(new_version.block)->GetHeader();
-
-        // these two fields can be set at any time.
-        new_tile_group_header->SetBeginCommitId(new_version.offset, MAX_CID);
-        new_tile_group_header->SetEndCommitId(new_version.offset, MAX_CID);
-
-        COMPILER_MEMORY_FENCE;
-
-        // as the aborted version has already been placed in the version chain,
-        // we need to unlink it by resetting the item pointers.
-        auto old_prev =
-            new_tile_group_header->GetPrevItemPointer(new_version.offset);
-
-        // check whether the previous version exists.
-        if (old_prev.IsNull() == true) {
-          PL_ASSERT(tile_group_header->GetEndCommitId(tuple_slot) == MAX_CID);
-          // if we updated the latest version.
-          // We must first adjust the head pointer
-          // before we unlink the aborted version from version list
-          ItemPointer *index_entry_ptr =
-              tile_group_header->GetIndirection(tuple_slot);
-          UNUSED_ATTRIBUTE auto res = AtomicUpdateItemPointer(
-              index_entry_ptr, ItemPointer(tile_group_id, tuple_slot));
-          PL_ASSERT(res == true);
-        }
-        //////////////////////////////////////////////////
-
-        // we should set the version before releasing the lock.
-        COMPILER_MEMORY_FENCE;
-
-        new_tile_group_header->SetTransactionId(new_version.offset,
-                                                INVALID_TXN_ID);
-
-        if (old_prev.IsNull() == false) {
-          auto old_prev_tile_group_header = catalog::Manager::GetInstance()
-                                                .GetTileGroup(old_prev.block)
-                                                ->GetHeader();
-          old_prev_tile_group_header->SetNextItemPointer(
-              old_prev.offset, ItemPointer(tile_group_id, tuple_slot));
-          tile_group_header->SetPrevItemPointer(tuple_slot, old_prev);
-        } else {
-          tile_group_header->SetPrevItemPointer(tuple_slot,
-                                                INVALID_ITEMPOINTER);
-        }
-
-        // we should set the version before releasing the lock.
-        COMPILER_MEMORY_FENCE;
-
-        tile_group_header->SetTransactionId(tuple_slot, INITIAL_TXN_ID);
-
-        // add to gc set.
-        gc_set->operator[](new_version.block)[new_version.offset] = false;
-
-      } else if (tuple_entry.second == RWType::DELETE) {
-        ItemPointer new_version =
-            tile_group_header->GetPrevItemPointer(tuple_slot);
-
-        auto new_tile_group_header =
-            manager.GetTileGroup(new_version.block)->GetHeader();
+  // the entries of a tile group are usually recorded one after another
+  oid_t tile_group_id = INVALID_OID;
+  storage::TileGroupHeader *tile_group_header = nullptr;
+  for (auto &entry : rw_set) {
+    if (entry.location.block != tile_group_id) {
+      tile_group_id = entry.location.block;
+      tile_group_header = manager.GetTileGroupHeader(tile_group_id);
+    }
+    auto tuple_slot = entry.location.offset;
+    if (entry.type == RWType::READ_OWN) {
+      // A read operation has acquired ownership but hasn't done any further
+      // update/delete yet
+      // Yield the ownership
+      YieldOwnership(current_txn, tile_group_id, tuple_slot);
+    } else if (entry.type == RWType::UPDATE) {
+      ItemPointer new_version =
+          tile_group_header->GetPrevItemPointer(tuple_slot);
+
+      auto new_tile_group_header =
+          manager.GetTileGroupHeader(new_version.block);
+
+      // these two fields can be set at any time.
+      new_tile_group_header->SetBeginCommitId(new_version.offset, MAX_CID);
+      new_tile_group_header->SetEndCommitId(new_version.offset, MAX_CID);
+
+      COMPILER_MEMORY_FENCE;
+
+      // as the aborted version has already been placed in the version chain,
+      // we need to unlink it by resetting the item pointers.
+      auto old_prev =
+          new_tile_group_header->GetPrevItemPointer(new_version.offset);
+
+      // check whether the previous version exists.
+      if (old_prev.IsNull() == true) {
+        PL_ASSERT(tile_group_header->GetEndCommitId(tuple_slot) == MAX_CID);
+        // if we updated the latest version.
+        // We must first adjust the head pointer
+        // before we unlink the aborted version from version list
+        ItemPointer *index_entry_ptr =
+            tile_group_header->GetIndirection(tuple_slot);
+        UNUSED_ATTRIBUTE auto res = AtomicUpdateItemPointer(
+            index_entry_ptr, ItemPointer(tile_group_id, tuple_slot));
+        PL_ASSERT(res == true);
+      }
+      //////////////////////////////////////////////////
 
-        new_tile_group_header->SetBeginCommitId(new_version.offset, MAX_CID);
-        new_tile_group_header->SetEndCommitId(new_version.offset, MAX_CID);
+      // we should set the version before releasing the lock.
+      COMPILER_MEMORY_FENCE;
 
-        COMPILER_MEMORY_FENCE;
+      new_tile_group_header->SetTransactionId(new_version.offset,
+                                              INVALID_TXN_ID);
 
-        // as the aborted version has already been placed in the version chain,
-        // we need to unlink it by resetting the item pointers.
-        auto old_prev =
-            new_tile_group_header->GetPrevItemPointer(new_version.offset);
+      if (old_prev.IsNull() == false) {
+        auto old_prev_tile_group_header =
+            manager.GetTileGroupHeader(old_prev.block);
+        old_prev_tile_group_header->SetNextItemPointer(
+            old_prev.offset, ItemPointer(tile_group_id, tuple_slot));
+        tile_group_header->SetPrevItemPointer(tuple_slot, old_prev);
+      } else {
+        tile_group_header->SetPrevItemPointer(tuple_slot,
+                                              INVALID_ITEMPOINTER);
+      }
 
-        // check whether the previous version exists.
-        if (old_prev.IsNull() == true) {
-          // if we updated the latest version.
-          // We must first adjust the head pointer
-          // before we unlink the aborted version from version list
-          ItemPointer *index_entry_ptr =
-              tile_group_header->GetIndirection(tuple_slot);
-          UNUSED_ATTRIBUTE auto res = AtomicUpdateItemPointer(
-              index_entry_ptr, ItemPointer(tile_group_id, tuple_slot));
-          PL_ASSERT(res == true);
-        }
-        //////////////////////////////////////////////////
+      // we should set the version before releasing the lock.
+      COMPILER_MEMORY_FENCE;
+
+      tile_group_header->SetTransactionId(tuple_slot, INITIAL_TXN_ID);
+
+      // add to gc set.
+      // the varlen data the new version shares is owned by the old version.
+      gc_set->emplace_back(
+          new_version, false,
+          GetSharedVarlenColumns(new_version,
+                                 ItemPointer(tile_group_id, tuple_slot)));
+
+    } else if (entry.type == RWType::DELETE) {
+      ItemPointer new_version =
+          tile_group_header->GetPrevItemPointer(tuple_slot);
+
+      auto new_tile_group_header =
+          manager.GetTileGroupHeader(new_version.block);
+
+      new_tile_group_header->SetBeginCommitId(new_version.offset, MAX_CID);
+      new_tile_group_header->SetEndCommitId(new_version.offset, MAX_CID);
+
+      COMPILER_MEMORY_FENCE;
+
+      // as the aborted version has already been placed in the version chain,
+      // we need to unlink it by resetting the item pointers.
+      auto old_prev =
+          new_tile_group_header->GetPrevItemPointer(new_version.offset);
+
+      // check whether the previous version exists.
+      if (old_prev.IsNull() == true) {
+        // if we updated the latest version.
+        // We must first adjust the head pointer
+        // before we unlink the aborted version from version list
+        ItemPointer *index_entry_ptr =
+            tile_group_header->GetIndirection(tuple_slot);
+        UNUSED_ATTRIBUTE auto res = AtomicUpdateItemPointer(
+            index_entry_ptr, ItemPointer(tile_group_id, tuple_slot));
+        PL_ASSERT(res == true);
+      }
+      //////////////////////////////////////////////////
 
-        // we should set the version before releasing the lock.
-        COMPILER_MEMORY_FENCE;
+      // we should set the version before releasing the lock.
+      COMPILER_MEMORY_FENCE;
 
-        new_tile_group_header->SetTransactionId(new_version.offset,
-                                                INVALID_TXN_ID);
+      new_tile_group_header->SetTransactionId(new_version.offset,
+                                              INVALID_TXN_ID);
 
-        if (old_prev.IsNull() == false) {
-          auto old_prev_tile_group_header = catalog::Manager::GetInstance()
-                                                .GetTileGroup(old_prev.block)
-                                                ->GetHeader();
-          old_prev_tile_group_header->SetNextItemPointer(
-              old_prev.offset, ItemPointer(tile_group_id, tuple_slot));
-        }
+      if (old_prev.IsNull() == false) {
+        auto old_prev_tile_group_header =
+            manager.GetTileGroupHeader(old_prev.block);
+        old_prev_tile_group_header->SetNextItemPointer(
+            old_prev.offset, ItemPointer(tile_group_id, tuple_slot));
+      }
 
-        tile_group_header->SetPrevItemPointer(tuple_slot, old_prev);
+      tile_group_header->SetPrevItemPointer(tuple_slot, old_prev);
 
-        // we should set the version before releasing the lock.
-        COMPILER_MEMORY_FENCE;
+      // we should set the version before releasing the lock.
+      COMPILER_MEMORY_FENCE;
 
-        tile_group_header->SetTransactionId(tuple_slot, INITIAL_TXN_ID);
+      tile_group_header->SetTransactionId(tuple_slot, INITIAL_TXN_ID);
 
-        // add to gc set.
-        gc_set->operator[](new_version.block)[new_version.offset] = false;
+      // add to gc set.
+      // the varlen data the new version shares is owned by the old version.
+      gc_set->emplace_back(
+          new_version, false,
+          GetSharedVarlenColumns(new_version,
+                                 ItemPointer(tile_group_id, tuple_slot)));
 
-      } else if (tuple_entry.second == RWType::INSERT) {
-        tile_group_header->SetBeginCommitId(tuple_slot, MAX_CID);
-        tile_group_header->SetEndCommitId(tuple_slot, MAX_CID);
+    } else if (entry.type == RWType::INSERT) {
+      tile_group_header->SetBeginCommitId(tuple_slot, MAX_CID);
+      tile_group_header->SetEndCommitId(tuple_slot, MAX_CID);
 
-        // we should set the version before releasing the lock.
-        COMPILER_MEMORY_FENCE;
+      // we should set the version before releasing the lock.
+      COMPILER_MEMORY_FENCE;
 
-        tile_group_header->SetTransactionId(tuple_slot, INVALID_TXN_ID);
+      tile_group_header->SetTransactionId(tuple_slot, INVALID_TXN_ID);
 
-        // add to gc set.
-        // delete from index
-        gc_set->operator[](tile_group_id)[tuple_slot] = true;
+      // add to gc set.
+      // delete from index
+      gc_set->emplace_back(ItemPointer(tile_group_id, tuple_slot), true);
 
-      } else if (tuple_entry.second == RWType::INS_DEL) {
-        tile_group_header->SetBeginCommitId(tuple_slot, MAX_CID);
-        tile_group_header->SetEndCommitId(tuple_slot, MAX_CID);
+    } else if (entry.type == RWType::INS_DEL) {
+      tile_group_header->SetBeginCommitId(tuple_slot, MAX_CID);
+      tile_group_header->SetEndCommitId(tuple_slot, MAX_CID);
 
-        // we should set the version before releasing the lock.
-        COMPILER_MEMORY_FENCE;
+      // we should set the version before releasing the lock.
+      COMPILER_MEMORY_FENCE;
 
-        tile_group_header->SetTransactionId(tuple_slot, INVALID_TXN_ID);
+      tile_group_header->SetTransactionId(tuple_slot, INVALID_TXN_ID);
 
-        // add to gc set.
-        gc_set->operator[](tile_group_id)[tuple_slot] = true;
-      }
+      // add to gc set.
+      gc_set->emplace_back(ItemPointer(tile_group_id, tuple_slot), true);
     }
   }
 
@@ -37,7 +37,11 @@ void PrintConfiguration(){
   LOG_INFO("%30s: %10s",  "Socket Family", FLAGS_socket_family.c_str());
   LOG_INFO("%30s: %10lu", "Statistics", FLAGS_stats_mode);
   LOG_INFO("%30s: %10lu", "Max Connections", FLAGS_max_connections);
+  LOG_INFO("%30s: %10s",  "Connection Dispatch", FLAGS_connection_dispatch.c_str());
   LOG_INFO("%30s: %10s",  "Code-generation", FLAGS_codegen ? "on" : "off");
+  LOG_INFO("%30s: %10lu", "Compiled Query Cache Size", FLAGS_codegen_cache_size);
+  LOG_INFO("%30s: %10s",  "Vectorized Execution", FLAGS_vectorized_execution ? "on" : "off");
+  LOG_INFO("%30s: %10s",  "Execution Pool", FLAGS_execution_pool ? "on" : "off");
 
   LOG_INFO(" ");
   LOG_INFO("%30s", "//===---------------------------------------------------===//");
@@ -67,6 +71,11 @@ DEFINE_string(socket_family,
               "AF_INET",
               "Socket family (default: AF_INET)");
 
+DEFINE_string(connection_dispatch,
+              "round_robin",
+              "How new connections are spread over the worker threads: "
+              "round_robin, least_loaded or reuseport (default: round_robin)");
+
 //===----------------------------------------------------------------------===//
 // RESOURCE USAGE
 //===----------------------------------------------------------------------===//
@@ -107,6 +116,12 @@ DEFINE_bool(layout_tuner,
             false,
             "Enable layout tuner (default: false)");
 
+DEFINE_bool(compress_frozen_tile_groups,
+            false,
+            "Dictionary encode the uninlined varlen columns of the tile "
+            "groups frozen by the layout tuner, fixed-width columns are not "
+            "encoded (default: false)");
+
 //===----------------------------------------------------------------------===//
 //
 //===----------------------------------------------------------------------===//
@@ -115,6 +130,30 @@ DEFINE_bool(codegen,
             true,
             "Enable code-generation for query execution (default: true)");
 
+DEFINE_uint64(codegen_cache_size,
+              64 * 1024 * 1024,
+              "Code size budget of the compiled query cache in bytes, "
+              "0 disables the cache (default: 64MB)");
+
+//===----------------------------------------------------------------------===//
+// EXECUTION
+//===----------------------------------------------------------------------===//
+
+DEFINE_bool(vectorized_execution,
+            false,
+            "Evaluate scans in the interpreted executors a tile group at a "
+            "time (default: false)");
+
+DEFINE_bool(shared_version_columns,
+            false,
+            "Let the new version of an update share the unmodified varlen "
+            "columns with the old version (default: false)");
+
+DEFINE_bool(execution_pool,
+            false,
+            "Run the statements on the thread pool, so that the network "
+            "threads only parse and send (default: false)");
+
 // Layout mode
 int peloton_layout_mode = peloton::LAYOUT_TYPE_ROW;
 
@@ -135,6 +174,9 @@ int64_t peloton_wait_timeout;
 
 int peloton_flush_frequency_micros;
 
+// Bytes written that close a group commit window early (0 is no limit)
+int peloton_group_commit_bytes;
+
 int peloton_flush_mode;
 
 // pcommit latency (for NVM WBL)
@@ -29,50 +29,98 @@ class Database;
 class IndirectionArray;
 }
 
+namespace concurrency{
+class LocalEpoch;
+}
+
+LOCK_FREE_ARRAY_TEMPLATE_ARGUMENTS
+constexpr std::size_t LOCK_FREE_ARRAY_TYPE::kFirstSegmentBits;
+
+LOCK_FREE_ARRAY_TEMPLATE_ARGUMENTS
+constexpr std::size_t LOCK_FREE_ARRAY_TYPE::kMaxSegmentCount;
+
 LOCK_FREE_ARRAY_TEMPLATE_ARGUMENTS
 LOCK_FREE_ARRAY_TYPE::LockFreeArray(){
-  lock_free_array.reset(new lock_free_array_t());
+  for (auto &segment : segments_) {
+    segment.store(nullptr, std::memory_order_relaxed);
+  }
 }
 
 LOCK_FREE_ARRAY_TEMPLATE_ARGUMENTS
 LOCK_FREE_ARRAY_TYPE::~LockFreeArray(){
+  for (auto &segment : segments_) {
+    delete[] segment.load();
+  }
+}
+
+LOCK_FREE_ARRAY_TEMPLATE_ARGUMENTS
+ValueType *LOCK_FREE_ARRAY_TYPE::GetOrAllocateSegment(
+    const std::size_t &segment) {
+  PL_ASSERT(segment < kMaxSegmentCount);
+  ValueType *entries = segments_[segment].load(std::memory_order_acquire);
+  if (entries != nullptr) {
+    return entries;
+  }
+
+  // Threads that write to the same new segment race to install it, the
+  // losers free theirs
+  ValueType *new_entries = new ValueType[GetSegmentSize(segment)]();
+  if (segments_[segment].compare_exchange_strong(entries, new_entries,
+                                                 std::memory_order_acq_rel)) {
+    return new_entries;
+  }
+  delete[] new_entries;
+  return entries;
 }
 
 LOCK_FREE_ARRAY_TEMPLATE_ARGUMENTS
 bool LOCK_FREE_ARRAY_TYPE::Update(const std::size_t &offset, ValueType value){
-  PL_ASSERT(offset <= LOCK_FREE_ARRAY_MAX_SIZE);
   LOG_TRACE("Update at %lu", lock_free_array_offset.load());
-  lock_free_array->at(offset) =  value;
+  std::size_t segment, position;
+  Locate(offset, segment, position);
+  GetOrAllocateSegment(segment)[position] = value;
   return true;
 }
 
 LOCK_FREE_ARRAY_TEMPLATE_ARGUMENTS
 bool LOCK_FREE_ARRAY_TYPE::Append(ValueType value){
   LOG_TRACE("Appended at %lu", lock_free_array_offset.load());
-  lock_free_array->at(lock_free_array_offset++) = value;
+  std::size_t segment, position;
+  Locate(lock_free_array_offset++, segment, position);
+  GetOrAllocateSegment(segment)[position] = value;
   return true;
 }
 
 LOCK_FREE_ARRAY_TEMPLATE_ARGUMENTS
 bool LOCK_FREE_ARRAY_TYPE::Erase(const std::size_t &offset, const ValueType& invalid_value){
-  PL_ASSERT(offset <= LOCK_FREE_ARRAY_MAX_SIZE);
   LOG_TRACE("Erase at %lu", offset);
-  lock_free_array->at(offset) =  invalid_value;
+  std::size_t segment, position;
+  Locate(offset, segment, position);
+  ValueType *entries = segments_[segment].load(std::memory_order_acquire);
+  // nothing was ever written there
+  if (entries != nullptr) {
+    entries[position] = invalid_value;
+  }
   return true;
 }
 
 LOCK_FREE_ARRAY_TEMPLATE_ARGUMENTS
 ValueType LOCK_FREE_ARRAY_TYPE::Find(const std::size_t &offset) const{
-  PL_ASSERT(offset <= LOCK_FREE_ARRAY_MAX_SIZE);
   LOG_TRACE("Find at %lu", offset);
-  auto value = lock_free_array->at(offset);
+  std::size_t segment, position;
+  Locate(offset, segment, position);
+  PL_ASSERT(segment < kMaxSegmentCount);
+  ValueType *entries = segments_[segment].load(std::memory_order_acquire);
+  if (entries == nullptr) {
+    return ValueType();
+  }
+  auto value = entries[position];
   return value;
 }
 
 LOCK_FREE_ARRAY_TEMPLATE_ARGUMENTS
 ValueType LOCK_FREE_ARRAY_TYPE::FindValid(const std::size_t &offset,
                                           const ValueType& invalid_value) const {
-  PL_ASSERT(offset <= LOCK_FREE_ARRAY_MAX_SIZE);
   LOG_TRACE("Find Valid at %lu", offset);
 
   std::size_t valid_array_itr = 0;
@@ -81,7 +129,7 @@ ValueType LOCK_FREE_ARRAY_TYPE::FindValid(const std::size_t &offset,
   for(array_itr = 0;
       array_itr < lock_free_array_offset;
       array_itr++){
-    auto value = lock_free_array->at(array_itr);
+    auto value = Find(array_itr);
     if (value != invalid_value) {
       // Check offset
       if(valid_array_itr == offset) {
@@ -103,17 +151,23 @@ size_t LOCK_FREE_ARRAY_TYPE::GetSize() const{
 
 LOCK_FREE_ARRAY_TEMPLATE_ARGUMENTS
 bool LOCK_FREE_ARRAY_TYPE::IsEmpty() const{
-  return lock_free_array->empty();
+  return lock_free_array_offset == 0;
 }
 
 LOCK_FREE_ARRAY_TEMPLATE_ARGUMENTS
 void LOCK_FREE_ARRAY_TYPE::Clear(const ValueType& invalid_value) {
 
-  // Set invalid value for all elements and reset lock_free_array_offset
-  for(std::size_t array_itr = 0;
-      array_itr < lock_free_array_offset;
-      array_itr++){
-    lock_free_array->at(array_itr) = invalid_value;
+  // Set invalid value for all elements, including the ones written with
+  // Update() beyond the appended ones
+  for (std::size_t segment = 0; segment < kMaxSegmentCount; segment++) {
+    ValueType *entries = segments_[segment].load();
+    if (entries == nullptr) {
+      continue;
+    }
+    std::size_t segment_size = GetSegmentSize(segment);
+    for (std::size_t position = 0; position < segment_size; position++) {
+      entries[position] = invalid_value;
+    }
   }
 
   // Reset sentinel
@@ -129,7 +183,7 @@ bool LOCK_FREE_ARRAY_TYPE::Contains(const ValueType& value) {
   for(std::size_t array_itr = 0;
       array_itr < lock_free_array_offset;
       array_itr++){
-    auto array_value = lock_free_array->at(array_itr);
+    auto array_value = Find(array_itr);
     // Check array value
     if(array_value == value) {
       exists = true;
@@ -140,6 +194,17 @@ bool LOCK_FREE_ARRAY_TYPE::Contains(const ValueType& value) {
   return exists;
 }
 
+LOCK_FREE_ARRAY_TEMPLATE_ARGUMENTS
+size_t LOCK_FREE_ARRAY_TYPE::GetMemoryFootprint() const {
+  size_t footprint = 0;
+  for (std::size_t segment = 0; segment < kMaxSegmentCount; segment++) {
+    if (segments_[segment].load() != nullptr) {
+      footprint += GetSegmentSize(segment) * sizeof(ValueType);
+    }
+  }
+  return footprint;
+}
+
 // Explicit template instantiation
 template class LockFreeArray<std::shared_ptr<oid_t>>;
 
@@ -147,10 +212,14 @@ template class LockFreeArray<std::shared_ptr<index::Index>>;
 
 template class LockFreeArray<std::shared_ptr<storage::TileGroup>>;
 
+template class LockFreeArray<storage::TileGroup *>;
+
 template class LockFreeArray<std::shared_ptr<storage::Database>>;
 
 template class LockFreeArray<std::shared_ptr<storage::IndirectionArray>>;
 
 template class LockFreeArray<oid_t>;
 
+template class LockFreeArray<concurrency::LocalEpoch *>;
+
 }  // End peloton namespace
@@ -18,10 +18,14 @@
 #include <vector>
 
 #include "type/types.h"
+#include "executor/executor_context.h"
 #include "executor/logical_tile.h"
 #include "executor/logical_tile_factory.h"
 #include "expression/abstract_expression.h"
 #include "common/container_tuple.h"
+#include "concurrency/transaction.h"
+#include "gc/gc_manager_factory.h"
+#include "statistics/backend_stats_context.h"
 #include "storage/data_table.h"
 #include "storage/tile_group.h"
 
@@ -57,5 +61,15 @@ bool AbstractScanExecutor::DInit() {
   return true;
 }
 
+void AbstractScanExecutor::VersionChainTraversed(size_t chain_length) {
+  if (FLAGS_stats_mode != STATS_TYPE_INVALID) {
+    stats::BackendStatsContext::GetInstance()->IncrementVersionChainTraversals(
+        chain_length);
+  }
+  auto current_txn = executor_context_->GetTransaction();
+  gc::GCManagerFactory::GetInstance().VersionChainTraversed(
+      current_txn->GetThreadId(), chain_length);
+}
+
 }  // namespace executor
 }  // namespace peloton
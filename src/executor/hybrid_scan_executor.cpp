@@ -380,8 +380,8 @@ bool HybridScanExecutor::ExecPrimaryIndexLookup() {
     }
 
     auto &manager = catalog::Manager::GetInstance();
-    auto tile_group = manager.GetTileGroup(tuple_location.block);
-    auto tile_group_header = tile_group.get()->GetHeader();
+    auto tile_group = manager.GetTileGroupPtr(tuple_location.block);
+    auto tile_group_header = tile_group->GetHeader();
 
     // perform transaction read
     size_t chain_length = 0;
@@ -425,10 +425,11 @@ bool HybridScanExecutor::ExecPrimaryIndexLookup() {
           }
         }
 
-        tile_group = manager.GetTileGroup(tuple_location.block);
-        tile_group_header = tile_group.get()->GetHeader();
+        tile_group = manager.GetTileGroupPtr(tuple_location.block);
+        tile_group_header = tile_group->GetHeader();
       }
     }
+    VersionChainTraversed(chain_length);
   }
 
   // Construct a logical tile for each block
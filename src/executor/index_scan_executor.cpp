@@ -12,6 +12,7 @@
 
 #include "executor/index_scan_executor.h"
 
+#include <algorithm>
 #include <memory>
 #include <numeric>
 #include <utility>
@@ -215,8 +216,8 @@ bool IndexScanExecutor::ExecPrimaryIndexLookup() {
   // for every tuple that is found in the index.
   for (auto tuple_location_ptr : tuple_location_ptrs) {
     ItemPointer tuple_location = *tuple_location_ptr;
-    auto tile_group = manager.GetTileGroup(tuple_location.block);
-    auto tile_group_header = tile_group.get()->GetHeader();
+    auto tile_group = manager.GetTileGroupPtr(tuple_location.block);
+    auto tile_group_header = tile_group->GetHeader();
     size_t chain_length = 0;
 
 #ifdef LOG_TRACE_ENABLED
@@ -248,7 +249,7 @@ bool IndexScanExecutor::ExecPrimaryIndexLookup() {
         if (predicate_ != nullptr) {
           LOG_TRACE("perform prediate evaluate");
           expression::ContainerTuple<storage::TileGroup> tuple(
-              tile_group.get(), tuple_location.offset);
+              tile_group, tuple_location.offset);
           eval =
               predicate_->Evaluate(&tuple, nullptr, executor_context_).IsTrue();
         }
@@ -290,8 +291,8 @@ bool IndexScanExecutor::ExecPrimaryIndexLookup() {
           // from scratch.
           tuple_location =
               *(tile_group_header->GetIndirection(tuple_location.offset));
-          tile_group = manager.GetTileGroup(tuple_location.block);
-          tile_group_header = tile_group.get()->GetHeader();
+          tile_group = manager.GetTileGroupPtr(tuple_location.block);
+          tile_group_header = tile_group->GetHeader();
           chain_length = 0;
           continue;
         }
@@ -315,12 +316,13 @@ bool IndexScanExecutor::ExecPrimaryIndexLookup() {
         }
 
         // search for next version.
-        tile_group = manager.GetTileGroup(tuple_location.block);
-        tile_group_header = tile_group.get()->GetHeader();
+        tile_group = manager.GetTileGroupPtr(tuple_location.block);
+        tile_group_header = tile_group->GetHeader();
         continue;
       }
     }
     LOG_TRACE("Traverse length: %d\n", (int)chain_length);
+    VersionChainTraversed(chain_length);
   }
 #ifdef LOG_TRACE_ENABLED
   LOG_TRACE("Examined %d tuples from index %s", num_tuples_examined,
@@ -427,7 +429,7 @@ bool IndexScanExecutor::ExecSecondaryIndexLookup() {
   // we got for each tuple and check whether its the same to avoid having
   // to go back to the catalog each time.
   oid_t last_block = INVALID_OID;
-  std::shared_ptr<storage::TileGroup> tile_group;
+  storage::TileGroup *tile_group = nullptr;
   storage::TileGroupHeader *tile_group_header = nullptr;
 
 #ifdef LOG_TRACE_ENABLED
@@ -438,8 +440,8 @@ bool IndexScanExecutor::ExecSecondaryIndexLookup() {
   for (auto tuple_location_ptr : tuple_location_ptrs) {
     ItemPointer tuple_location = *tuple_location_ptr;
     if (tuple_location.block != last_block) {
-      tile_group = manager.GetTileGroup(tuple_location.block);
-      tile_group_header = tile_group.get()->GetHeader();
+      tile_group = manager.GetTileGroupPtr(tuple_location.block);
+      tile_group_header = tile_group->GetHeader();
     }
 #ifdef LOG_TRACE_ENABLED
     else
@@ -473,7 +475,7 @@ bool IndexScanExecutor::ExecSecondaryIndexLookup() {
 
         // Further check if the version has the secondary key
         expression::ContainerTuple<storage::TileGroup> candidate_tuple(
-            tile_group.get(), tuple_location.offset);
+            tile_group, tuple_location.offset);
 
         LOG_TRACE("candidate_tuple size: %s",
                   candidate_tuple.GetInfo().c_str());
@@ -536,8 +538,8 @@ bool IndexScanExecutor::ExecSecondaryIndexLookup() {
           // from scratch.
           tuple_location =
               *(tile_group_header->GetIndirection(tuple_location.offset));
-          tile_group = manager.GetTileGroup(tuple_location.block);
-          tile_group_header = tile_group.get()->GetHeader();
+          tile_group = manager.GetTileGroupPtr(tuple_location.block);
+          tile_group_header = tile_group->GetHeader();
           chain_length = 0;
           continue;
         }
@@ -565,11 +567,12 @@ bool IndexScanExecutor::ExecSecondaryIndexLookup() {
         }
 
         // search for next version.
-        tile_group = manager.GetTileGroup(tuple_location.block);
-        tile_group_header = tile_group.get()->GetHeader();
+        tile_group = manager.GetTileGroupPtr(tuple_location.block);
+        tile_group_header = tile_group->GetHeader();
       }
     }
     LOG_TRACE("Traverse length: %d\n", (int)chain_length);
+    VersionChainTraversed(chain_length);
   }
 #ifdef LOG_TRACE_ENABLED
   LOG_TRACE("Examined %d tuples from index %s [num_blocks_reused=%d]",
@@ -609,6 +612,21 @@ bool IndexScanExecutor::ExecSecondaryIndexLookup() {
 
 void IndexScanExecutor::CheckOpenRangeWithReturnedTuples(
     std::vector<ItemPointer> &tuple_locations) {
+  // A hash index has no key order and returns all of its values for
+  // anything other than a point query, so every tuple must be checked
+  if (index_->GetIndexMethodType() == IndexType::HASH &&
+      key_column_ids_.size() > 0 &&
+      index_predicate_.GetConjunctionList()[0].IsPointQuery() == false) {
+    LOG_TRACE("Checking all tuples returned from hash index");
+    tuple_locations.erase(
+        std::remove_if(tuple_locations.begin(), tuple_locations.end(),
+                       [this](const ItemPointer &tuple_location) {
+                         return CheckKeyConditions(tuple_location) == false;
+                       }),
+        tuple_locations.end());
+    return;
+  }
+
   while (left_open_) {
     LOG_TRACE("Range left open!");
     auto tuple_location_itr = tuple_locations.begin();
@@ -641,8 +659,8 @@ bool IndexScanExecutor::CheckKeyConditions(const ItemPointer &tuple_location) {
 
   auto &manager = catalog::Manager::GetInstance();
 
-  auto tile_group = manager.GetTileGroup(tuple_location.block);
-  expression::ContainerTuple<storage::TileGroup> tuple(tile_group.get(),
+  auto tile_group = manager.GetTileGroupPtr(tuple_location.block);
+  expression::ContainerTuple<storage::TileGroup> tuple(tile_group,
                                                        tuple_location.offset);
 
   // This is the end of loop
@@ -152,6 +152,33 @@ storage::Tile *LogicalTile::GetBaseTile(oid_t column_id) {
   return schema_[column_id].base_tile.get();
 }
 
+/**
+ * @brief Get a view of the raw values of an inlined column.
+ * @param column_id Column id of the column.
+ *
+ * @return The view of the column.
+ */
+LogicalTile::ColumnChunk LogicalTile::GetColumnChunk(
+    const oid_t column_id) const {
+  PL_ASSERT(column_id < schema_.size());
+
+  const ColumnInfo &cp = schema_[column_id];
+  const storage::Tile *base_tile = cp.base_tile.get();
+  const catalog::Schema *base_schema = base_tile->GetSchema();
+  PL_ASSERT(base_schema->IsInlined(cp.origin_column_id));
+
+  auto packed = base_tile->GetPackedColumn(cp.origin_column_id);
+  if (packed != nullptr) {
+    return ColumnChunk{nullptr, 0, &position_lists_[cp.position_list_idx],
+                       base_schema->GetType(cp.origin_column_id), packed};
+  }
+  return ColumnChunk{
+      base_tile->GetTupleLocation(0) +
+          base_schema->GetOffset(cp.origin_column_id),
+      base_schema->GetLength(), &position_lists_[cp.position_list_idx],
+      base_schema->GetType(cp.origin_column_id), nullptr};
+}
+
 /**
  * @brief Get the value at the specified field.
  * @param tuple_id Tuple id of the specified field (row/position).
@@ -171,7 +198,7 @@ type::Value LogicalTile::GetValue(oid_t tuple_id, oid_t column_id) {
 
   if (base_tuple_id == NULL_OID) {
     return type::ValueFactory::GetNullValueByType(
-        base_tile->GetSchema()->GetType(column_id));
+        base_tile->GetSchema()->GetType(cp.origin_column_id));
   } else {
     return base_tile->GetValue(base_tuple_id, cp.origin_column_id);
   }
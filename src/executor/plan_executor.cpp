@@ -13,6 +13,8 @@
 #include "executor/plan_executor.h"
 
 #include "codegen/buffering_consumer.h"
+#include "codegen/plan_fingerprint.h"
+#include "codegen/query_cache.h"
 #include "codegen/query_compiler.h"
 #include "codegen/query.h"
 #include "common/logger.h"
@@ -49,6 +51,20 @@ ExecuteResult PlanExecutor::ExecutePlan(const planner::AbstractPlan *plan,
                                         const std::vector<type::Value> &params,
                                         std::vector<StatementResult> &result,
                                         const std::vector<int> &result_format) {
+  result.clear();
+  BufferingResultSink sink{result_format, result};
+  return ExecutePlan(plan, txn, params, sink);
+}
+
+/**
+ * @brief Build a executor tree and execute it, pushing every result row into
+ * the sink as soon as the root executor returns it.
+ * @return status of execution.
+ */
+ExecuteResult PlanExecutor::ExecutePlan(const planner::AbstractPlan *plan,
+                                        concurrency::Transaction *txn,
+                                        const std::vector<type::Value> &params,
+                                        ResultSink &sink) {
   ExecuteResult p_status;
   if (plan == nullptr) return p_status;
 
@@ -78,7 +94,9 @@ ExecuteResult PlanExecutor::ExecutePlan(const planner::AbstractPlan *plan,
 
     if (status == true) {
       LOG_TRACE("Running the executor tree");
-      result.clear();
+
+      // The values of the current row, reused across rows
+      std::vector<type::Value> row;
 
       // Execute the tree until we get result tiles from root node
       while (status == true) {
@@ -91,21 +109,15 @@ ExecuteResult PlanExecutor::ExecutePlan(const planner::AbstractPlan *plan,
           LOG_TRACE("Final Answer: %s",
                     logical_tile->GetInfo().c_str());  // Printing the answers
 
-          std::vector<std::vector<std::string>> answer_tuples;
-          answer_tuples = std::move(
-              logical_tile->GetAllValuesAsStrings(result_format, false));
-
-          // Construct the returned results
-          for (auto &tuple : answer_tuples) {
-            unsigned int col_index = 0;
-            for (unsigned int i = 0; i < logical_tile->GetColumnCount(); i++) {
-              auto res = StatementResult();
-              PlanExecutor::copyFromTo(tuple[col_index++], res.second);
-              if (tuple[col_index - 1].c_str() != nullptr) {
-                LOG_TRACE("column content: %s", tuple[col_index - 1].c_str());
-              }
-              result.push_back(std::move(res));
+          // Hand the rows to the sink
+          auto column_count = logical_tile->GetColumnCount();
+          for (oid_t tuple_id : *logical_tile) {
+            row.clear();
+            for (oid_t column_itr = 0; column_itr < column_count;
+                 column_itr++) {
+              row.push_back(logical_tile->GetValue(tuple_id, column_itr));
             }
+            sink.AddRow(row.data(), column_count);
           }
         }
       }
@@ -126,36 +138,32 @@ ExecuteResult PlanExecutor::ExecutePlan(const planner::AbstractPlan *plan,
   } else {
     LOG_TRACE("Compiling and executing query ...");
 
-    result.clear();
-
     // Bind: casting const should be removed with later refactoring executor
     planner::AbstractPlan *planp = const_cast<planner::AbstractPlan *>(plan);
     planner::BindingContext context;
     planp->PerformBinding(context);
 
+    // The compiled code pushes the rows straight into the sink
     std::vector<oid_t> columns;
     plan->GetOutputColumns(columns);
-    codegen::BufferingConsumer consumer{columns, context};
-
-    // Compile the query
-    codegen::QueryCompiler compiler;
-    auto query = compiler.Compile(*plan, consumer);
+    codegen::BufferingConsumer consumer{columns, context, &sink};
+
+    // Reuse the code compiled for an earlier plan of the same shape, if any.
+    // The fingerprint carries this plan's constants to the compiled code.
+    codegen::PlanFingerprint fingerprint{*plan, columns};
+    auto &query_cache = codegen::QueryCache::GetInstance();
+    std::shared_ptr<codegen::Query> query = query_cache.Find(fingerprint);
+    if (query == nullptr) {
+      // Compile the query
+      codegen::QueryCompiler compiler;
+      codegen::QueryCompiler::CompileStats compile_stats;
+      query = compiler.Compile(*plan, consumer, &compile_stats, &fingerprint);
+      query_cache.Insert(fingerprint, query, compile_stats.TotalMs());
+    }
 
     // Execute the query
-    query->Execute(*txn, reinterpret_cast<char *>(consumer.GetState()));
-
-    // Iterate over results
-    const auto &results = consumer.GetOutputTuples();
-    for (const auto &tuple : results) {
-      for (uint32_t i = 0; i < tuple.tuple_.size(); i++) {
-        auto res = StatementResult();
-        auto column_val = tuple.GetValue(i);
-        auto str = column_val.IsNull() ? "" : column_val.ToString();
-        PlanExecutor::copyFromTo(str, res.second);
-        LOG_TRACE("column content: [%s]", str.c_str());
-        result.push_back(std::move(res));
-      }
-    }
+    query->Execute(*txn, reinterpret_cast<char *>(consumer.GetState()),
+                   nullptr, fingerprint.GetParameterStorage());
 
     // This is 0 since codegen currently support SELECT only
     p_status.m_processed = 0;
@@ -0,0 +1,206 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// result_sink.cpp
+//
+// Identification: src/executor/result_sink.cpp
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "executor/result_sink.h"
+
+#include <algorithm>
+#include <limits>
+
+#include "common/exception.h"
+
+namespace peloton {
+namespace executor {
+
+namespace {
+
+// Append the value in network byte order
+template <class T>
+void PutBigEndian(T value, std::vector<unsigned char> &output) {
+  auto bytes = reinterpret_cast<const unsigned char *>(&value);
+  output.insert(output.end(), bytes, bytes + sizeof(T));
+  std::reverse(output.end() - sizeof(T), output.end());
+}
+
+// The days from 1970-01-01 to the given date of the proleptic Gregorian
+// calendar
+int64_t DaysFromCivil(int64_t year, int64_t month, int64_t day) {
+  year -= (month <= 2);
+  int64_t era = (year >= 0 ? year : year - 399) / 400;
+  int64_t year_of_era = year - era * 400;
+  int64_t day_of_year =
+      (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+  int64_t day_of_era =
+      year_of_era * 365 + year_of_era / 4 - year_of_era / 100 + day_of_year;
+  return era * 146097 + day_of_era - 719468;
+}
+
+// Postgres timestamps count the microseconds since 2000-01-01. Peloton packs
+// the fields of the timestamp, see TimestampType::ToString().
+int64_t GetPostgresTimestamp(uint64_t timestamp) {
+  int64_t micro = timestamp % 1000000;
+  timestamp /= 1000000;
+  int64_t seconds_of_day = timestamp % 100000;
+  timestamp /= 100000;
+  int64_t year = timestamp % 10000;
+  timestamp /= 10000;
+  // skip the time zone, the column is a timestamp without time zone
+  timestamp /= 27;
+  int64_t day = timestamp % 32;
+  timestamp /= 32;
+  int64_t month = timestamp;
+
+  const int64_t postgres_epoch_days = 10957;
+  int64_t days = DaysFromCivil(year, month, day) - postgres_epoch_days;
+  return (days * 86400 + seconds_of_day) * 1000000 + micro;
+}
+
+// The value of an integer type as an integer of the given width. Throws if
+// the value is not an integer, or is out of the range of the width.
+template <class T>
+T GetInteger(const type::Value &value, type::Type::TypeId field_type) {
+  int64_t integer;
+  switch (value.GetTypeId()) {
+    case type::Type::BOOLEAN:
+    case type::Type::TINYINT:
+      integer = value.GetAs<int8_t>();
+      break;
+    case type::Type::SMALLINT:
+      integer = value.GetAs<int16_t>();
+      break;
+    case type::Type::INTEGER:
+      integer = value.GetAs<int32_t>();
+      break;
+    case type::Type::BIGINT:
+      integer = value.GetAs<int64_t>();
+      break;
+    default:
+      throw ConversionException("Can't send a " +
+                                TypeIdToString(value.GetTypeId()) +
+                                " value as a binary " +
+                                TypeIdToString(field_type));
+  }
+  if (integer < std::numeric_limits<T>::min() ||
+      integer > std::numeric_limits<T>::max()) {
+    throw ValueOutOfRangeException(integer, value.GetTypeId(), field_type);
+  }
+  return static_cast<T>(integer);
+}
+
+// The Postgres type of the values of the given type, the same as
+// TrafficCop::GetColumnFieldForValueType() describes them
+oid_t GetFieldType(type::Type::TypeId type_id) {
+  switch (type_id) {
+    case type::Type::BOOLEAN:
+    case type::Type::TINYINT:
+      return static_cast<oid_t>(PostgresValueType::BOOLEAN);
+    case type::Type::SMALLINT:
+      return static_cast<oid_t>(PostgresValueType::SMALLINT);
+    case type::Type::INTEGER:
+      return static_cast<oid_t>(PostgresValueType::INTEGER);
+    case type::Type::BIGINT:
+      return static_cast<oid_t>(PostgresValueType::BIGINT);
+    case type::Type::DECIMAL:
+      return static_cast<oid_t>(PostgresValueType::DOUBLE);
+    case type::Type::TIMESTAMP:
+      return static_cast<oid_t>(PostgresValueType::TIMESTAMPS);
+    default:
+      return static_cast<oid_t>(PostgresValueType::TEXT);
+  }
+}
+
+}  // namespace
+
+int ResultSink::GetResultFormat(oid_t field_type, int format) {
+  if (format == 0) {
+    return 0;
+  }
+  switch (static_cast<PostgresValueType>(field_type)) {
+    case PostgresValueType::BOOLEAN:
+    case PostgresValueType::SMALLINT:
+    case PostgresValueType::INTEGER:
+    case PostgresValueType::BIGINT:
+    case PostgresValueType::DOUBLE:
+    case PostgresValueType::TIMESTAMPS:
+      return 1;
+    default:
+      return 0;
+  }
+}
+
+void ResultSink::SerializeValue(const type::Value &value, oid_t field_type,
+                                int format,
+                                std::vector<unsigned char> &output) {
+  if (value.IsNull() == true) {
+    return;
+  }
+
+  // The value is encoded as the type the column is described as, which is
+  // not always its own type. COUNT is described as an INTEGER, for instance,
+  // but produces BIGINT values.
+  if (GetResultFormat(field_type, format) != 0) {
+    switch (static_cast<PostgresValueType>(field_type)) {
+      case PostgresValueType::BOOLEAN:
+        output.push_back(GetInteger<int8_t>(value, type::Type::TINYINT));
+        return;
+      case PostgresValueType::SMALLINT:
+        PutBigEndian(GetInteger<int16_t>(value, type::Type::SMALLINT), output);
+        return;
+      case PostgresValueType::INTEGER:
+        PutBigEndian(GetInteger<int32_t>(value, type::Type::INTEGER), output);
+        return;
+      case PostgresValueType::BIGINT:
+        PutBigEndian(GetInteger<int64_t>(value, type::Type::BIGINT), output);
+        return;
+      case PostgresValueType::DOUBLE: {
+        // float8 is sent as the bits of the IEEE 754 double
+        double decimal = (value.GetTypeId() == type::Type::DECIMAL)
+                             ? value.GetAs<double>()
+                             : GetInteger<int64_t>(value, type::Type::DECIMAL);
+        PutBigEndian(decimal, output);
+        return;
+      }
+      case PostgresValueType::TIMESTAMPS:
+        if (value.GetTypeId() != type::Type::TIMESTAMP) {
+          throw ConversionException(
+              "Can't send a " + TypeIdToString(value.GetTypeId()) +
+              " value as a binary TIMESTAMP");
+        }
+        PutBigEndian(GetPostgresTimestamp(value.GetAs<uint64_t>()), output);
+        return;
+      default:
+        break;
+    }
+  }
+
+  auto str = value.ToString();
+  output.insert(output.end(), str.begin(), str.end());
+}
+
+void ResultSink::SerializeValue(const type::Value &value, int format,
+                                std::vector<unsigned char> &output) {
+  SerializeValue(value, GetFieldType(value.GetTypeId()), format, output);
+}
+
+void BufferingResultSink::AddRow(const type::Value *values,
+                                 uint32_t num_values) {
+  for (uint32_t column_itr = 0; column_itr < num_values; column_itr++) {
+    StatementResult res;
+    int format = (column_itr < result_format_.size())
+                     ? result_format_[column_itr]
+                     : 0;
+    SerializeValue(values[column_itr], format, res.second);
+    result_.push_back(std::move(res));
+  }
+}
+
+}  // namespace executor
+}  // namespace peloton
@@ -28,6 +28,7 @@
 #include "expression/constant_value_expression.h"
 #include "expression/comparison_expression.h"
 #include "common/container_tuple.h"
+#include "configuration/configuration.h"
 #include "planner/create_plan.h"
 #include "storage/data_table.h"
 #include "storage/tile_group_header.h"
@@ -65,6 +66,8 @@ bool SeqScanExecutor::DInit() {
 
   old_predicate_ = predicate_;
 
+  vectorized_ = FLAGS_vectorized_execution;
+
   if (target_table_ != nullptr) {
     table_tile_group_count_ = target_table_->GetTileGroupCount();
 
@@ -100,7 +103,9 @@ bool SeqScanExecutor::DExecute() {
     while (children_[0]->Execute()) {
       std::unique_ptr<LogicalTile> tile(children_[0]->GetOutput());
 
-      if (predicate_ != nullptr) {
+      if (predicate_ != nullptr && vectorized_) {
+        FilterTileBatch(tile.get());
+      } else if (predicate_ != nullptr) {
         // Invalidate tuples that don't satisfy the predicate.
         for (oid_t tuple_id : *tile) {
           expression::ContainerTuple<LogicalTile> tuple(tile.get(), tuple_id);
@@ -166,32 +171,21 @@ bool SeqScanExecutor::DExecute() {
       // Construct position list by looping through tile group
       // and applying the predicate.
       std::vector<oid_t> position_list;
-      for (oid_t tuple_id = 0; tuple_id < active_tuple_count; tuple_id++) {
-        ItemPointer location(tile_group->GetTileGroupId(), tuple_id);
-
-        auto visibility = transaction_manager.IsVisible(
-            current_txn, tile_group_header, tuple_id);
-
-        // check transaction visibility
-        if (visibility == VisibilityType::OK) {
-          // if the tuple is visible, then perform predicate evaluation.
-          if (predicate_ == nullptr) {
-            position_list.push_back(tuple_id);
-            auto res = transaction_manager.PerformRead(current_txn, location,
-                                                       acquire_owner);
-            if (!res) {
-              transaction_manager.SetTransactionResult(current_txn,
-                                                       ResultType::FAILURE);
-              return res;
-            }
-          } else {
-            expression::ContainerTuple<storage::TileGroup> tuple(
-                tile_group.get(), tuple_id);
-            LOG_TRACE("Evaluate predicate for a tuple");
-            auto eval =
-                predicate_->Evaluate(&tuple, nullptr, executor_context_);
-            LOG_TRACE("Evaluation result: %s", eval.GetInfo().c_str());
-            if (eval.IsTrue()) {
+      if (vectorized_) {
+        if (!ScanTileGroupBatch(tile_group, position_list)) {
+          return false;
+        }
+      } else {
+        for (oid_t tuple_id = 0; tuple_id < active_tuple_count; tuple_id++) {
+          ItemPointer location(tile_group->GetTileGroupId(), tuple_id);
+
+          auto visibility = transaction_manager.IsVisible(
+              current_txn, tile_group_header, tuple_id);
+
+          // check transaction visibility
+          if (visibility == VisibilityType::OK) {
+            // if the tuple is visible, then perform predicate evaluation.
+            if (predicate_ == nullptr) {
               position_list.push_back(tuple_id);
               auto res = transaction_manager.PerformRead(current_txn, location,
                                                          acquire_owner);
@@ -199,8 +193,25 @@ bool SeqScanExecutor::DExecute() {
                 transaction_manager.SetTransactionResult(current_txn,
                                                          ResultType::FAILURE);
                 return res;
-              } else {
-                LOG_TRACE("Sequential Scan Predicate Satisfied");
+              }
+            } else {
+              expression::ContainerTuple<storage::TileGroup> tuple(
+                  tile_group.get(), tuple_id);
+              LOG_TRACE("Evaluate predicate for a tuple");
+              auto eval =
+                  predicate_->Evaluate(&tuple, nullptr, executor_context_);
+              LOG_TRACE("Evaluation result: %s", eval.GetInfo().c_str());
+              if (eval.IsTrue()) {
+                position_list.push_back(tuple_id);
+                auto res = transaction_manager.PerformRead(
+                    current_txn, location, acquire_owner);
+                if (!res) {
+                  transaction_manager.SetTransactionResult(current_txn,
+                                                           ResultType::FAILURE);
+                  return res;
+                } else {
+                  LOG_TRACE("Sequential Scan Predicate Satisfied");
+                }
               }
             }
           }
@@ -226,6 +237,74 @@ bool SeqScanExecutor::DExecute() {
   return false;
 }
 
+void SeqScanExecutor::FilterTileBatch(LogicalTile *tile) {
+  std::vector<oid_t> tuple_ids(tile->begin(), tile->end());
+  std::vector<oid_t> selection = tuple_ids;
+  predicate_->EvaluateBatch(tile, selection, executor_context_);
+
+  // Both lists are sorted, the tuples missing in the selection failed
+  auto selected = selection.begin();
+  for (oid_t tuple_id : tuple_ids) {
+    if (selected != selection.end() && *selected == tuple_id) {
+      ++selected;
+    } else {
+      tile->RemoveVisibility(tuple_id);
+    }
+  }
+}
+
+bool SeqScanExecutor::ScanTileGroupBatch(
+    const std::shared_ptr<storage::TileGroup> &tile_group,
+    std::vector<oid_t> &position_list) {
+  concurrency::TransactionManager &transaction_manager =
+      concurrency::TransactionManagerFactory::GetInstance();
+
+  bool acquire_owner = GetPlanNode<planner::AbstractScan>().IsForUpdate();
+  auto current_txn = executor_context_->GetTransaction();
+
+  // Check the visibility of all the tuples in one pass over the header
+  std::vector<oid_t> visible_tuples;
+  transaction_manager.GetVisibleTuples(current_txn, tile_group->GetHeader(),
+                                       tile_group->GetNextTupleSlot(),
+                                       visible_tuples);
+
+  // Evaluate the predicate over all the visible tuples. The predicate refers
+  // to the columns of the table, so the logical tile has all of them.
+  if (predicate_ != nullptr && !visible_tuples.empty()) {
+    std::vector<oid_t> all_column_ids(
+        target_table_->GetSchema()->GetColumnCount());
+    std::iota(all_column_ids.begin(), all_column_ids.end(), 0);
+
+    std::unique_ptr<LogicalTile> tile(LogicalTileFactory::GetTile());
+    tile->AddColumns(tile_group, all_column_ids);
+    tile->AddPositionList(LogicalTile::PositionList(visible_tuples));
+
+    std::vector<oid_t> selection(visible_tuples.size());
+    std::iota(selection.begin(), selection.end(), 0);
+    predicate_->EvaluateBatch(tile.get(), selection, executor_context_);
+
+    for (auto &tuple_id : selection) {
+      tuple_id = visible_tuples[tuple_id];
+    }
+    visible_tuples.swap(selection);
+  }
+
+  // Read all the tuples that qualify
+  for (oid_t tuple_id : visible_tuples) {
+    ItemPointer location(tile_group->GetTileGroupId(), tuple_id);
+    auto res =
+        transaction_manager.PerformRead(current_txn, location, acquire_owner);
+    if (!res) {
+      transaction_manager.SetTransactionResult(current_txn,
+                                               ResultType::FAILURE);
+      return false;
+    }
+  }
+
+  position_list = std::move(visible_tuples);
+  return true;
+}
+
 // Update Predicate expression
 // this is used in the NLJoin executor
 void SeqScanExecutor::UpdatePredicate(const std::vector<oid_t> &column_ids,
@@ -19,6 +19,7 @@
 #include "common/container_tuple.h"
 #include "concurrency/transaction.h"
 #include "concurrency/transaction_manager_factory.h"
+#include "configuration/configuration.h"
 #include "storage/data_table.h"
 #include "storage/tile_group_header.h"
 #include "storage/tile.h"
@@ -51,9 +52,26 @@ bool UpdateExecutor::DInit() {
   PL_ASSERT(target_table_);
   PL_ASSERT(project_info_);
 
+  copy_version_ = FLAGS_shared_version_columns;
+  for (auto &direct_map : project_info_->GetDirectMapList()) {
+    if (direct_map.second.first != 0 ||
+        direct_map.first != direct_map.second.second) {
+      copy_version_ = false;
+    }
+  }
+
   return true;
 }
 
+void UpdateExecutor::EvaluateTargetList(const AbstractTuple *old_tuple,
+                                        AbstractTuple *new_tuple) {
+  for (auto &target : project_info_->GetTargetList()) {
+    auto value =
+        target.second.expr->Evaluate(old_tuple, nullptr, executor_context_);
+    new_tuple->SetValue(target.first, value);
+  }
+}
+
 bool UpdateExecutor::PerformUpdatePrimaryKey(bool is_owner, oid_t tile_group_id,
                                              oid_t physical_tuple_id,
                                              ItemPointer &old_location,
@@ -196,8 +214,13 @@ bool UpdateExecutor::DExecute() {
         expression::ContainerTuple<storage::TileGroup> old_tuple(
             tile_group, physical_tuple_id);
         // Execute the projections
-        project_info_->Evaluate(&old_tuple, &old_tuple, nullptr,
-                                executor_context_);
+        if (copy_version_ == true) {
+          // keep the varlen data shared with the committed version
+          EvaluateTargetList(&old_tuple, &old_tuple);
+        } else {
+          project_info_->Evaluate(&old_tuple, &old_tuple, nullptr,
+                                  executor_context_);
+        }
 
         transaction_manager.PerformUpdate(current_txn, old_location);
       }
@@ -262,8 +285,16 @@ bool UpdateExecutor::DExecute() {
           // this triggers in-place update, and we do not need to allocate
           // another
           // version.
-          project_info_->Evaluate(&new_tuple, &old_tuple, nullptr,
-                                  executor_context_);
+          if (copy_version_ == true) {
+            // the new version shares the unmodified varlen columns with the
+            // old version, see TileGroup::CopyVersion()
+            new_tile_group->CopyVersion(tile_group, physical_tuple_id,
+                                        new_location.offset);
+            EvaluateTargetList(&old_tuple, &new_tuple);
+          } else {
+            project_info_->Evaluate(&new_tuple, &old_tuple, nullptr,
+                                    executor_context_);
+          }
 
           // get indirection.
           ItemPointer *indirection =
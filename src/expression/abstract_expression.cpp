@@ -12,12 +12,27 @@
 
 #include <string>
 #include "expression/abstract_expression.h"
+#include "common/container_tuple.h"
+#include "executor/logical_tile.h"
 #include "util/hash_util.h"
 #include "expression/expression_util.h"
 
 namespace peloton {
 namespace expression {
 
+void AbstractExpression::EvaluateBatch(
+    executor::LogicalTile *tile, std::vector<oid_t> &selection,
+    executor::ExecutorContext *context) const {
+  size_t num_selected = 0;
+  for (oid_t tuple_id : selection) {
+    ContainerTuple<executor::LogicalTile> tuple(tile, tuple_id);
+    if (Evaluate(&tuple, nullptr, context).IsTrue()) {
+      selection[num_selected++] = tuple_id;
+    }
+  }
+  selection.resize(num_selected);
+}
+
 void AbstractExpression::DeduceExpressionName() {
   // If alias exists, it will be used in TrafficCop
   if (!alias.empty()) return;
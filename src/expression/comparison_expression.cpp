@@ -0,0 +1,222 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// comparison_expression.cpp
+//
+// Identification: src/expression/comparison_expression.cpp
+//
+// Copyright (c) 2015-2017, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "expression/comparison_expression.h"
+
+#include <cstring>
+#include <functional>
+
+#include "catalog/schema.h"
+#include "executor/logical_tile.h"
+#include "expression/constant_value_expression.h"
+#include "expression/expression_util.h"
+#include "expression/tuple_value_expression.h"
+#include "storage/tile.h"
+
+namespace peloton {
+namespace expression {
+
+namespace {
+
+// Keep the tuples whose column value compares true with the given value. The
+// column values are stored as T, or packed, and compared as W. Null values
+// (and missing tuples of outer joins) never compare true.
+template <typename T, typename W, typename Cmp>
+void FilterColumn(const executor::LogicalTile::ColumnChunk &chunk,
+                  T null_value, W value, std::vector<oid_t> &selection) {
+  const auto &positions = *chunk.positions;
+  Cmp cmp;
+  size_t num_selected = 0;
+  for (oid_t tuple_id : selection) {
+    oid_t position = positions[tuple_id];
+    if (position == NULL_OID) {
+      continue;
+    }
+    T col_value;
+    if (chunk.packed != nullptr) {
+      col_value = static_cast<T>(chunk.packed->GetValue(position));
+    } else {
+      std::memcpy(&col_value, chunk.data + position * chunk.stride,
+                  sizeof(T));
+    }
+    selection[num_selected] = tuple_id;
+    num_selected +=
+        (col_value != null_value) & cmp(static_cast<W>(col_value), value);
+  }
+  selection.resize(num_selected);
+}
+
+template <typename T, typename W>
+void FilterColumn(const executor::LogicalTile::ColumnChunk &chunk,
+                  ExpressionType comparison, T null_value, W value,
+                  std::vector<oid_t> &selection) {
+  switch (comparison) {
+    case (ExpressionType::COMPARE_EQUAL):
+      FilterColumn<T, W, std::equal_to<W>>(chunk, null_value, value,
+                                           selection);
+      break;
+    case (ExpressionType::COMPARE_NOTEQUAL):
+      FilterColumn<T, W, std::not_equal_to<W>>(chunk, null_value, value,
+                                               selection);
+      break;
+    case (ExpressionType::COMPARE_LESSTHAN):
+      FilterColumn<T, W, std::less<W>>(chunk, null_value, value, selection);
+      break;
+    case (ExpressionType::COMPARE_LESSTHANOREQUALTO):
+      FilterColumn<T, W, std::less_equal<W>>(chunk, null_value, value,
+                                             selection);
+      break;
+    case (ExpressionType::COMPARE_GREATERTHAN):
+      FilterColumn<T, W, std::greater<W>>(chunk, null_value, value,
+                                          selection);
+      break;
+    case (ExpressionType::COMPARE_GREATERTHANOREQUALTO):
+      FilterColumn<T, W, std::greater_equal<W>>(chunk, null_value, value,
+                                                selection);
+      break;
+    default:
+      throw Exception("Invalid comparison expression type.");
+  }
+}
+
+// Compare the raw column values with the constant, if the comparison and the
+// types of both sides are ones the loops above handle. Integers are compared
+// as 64-bit integers, and as doubles when either side is a decimal, like
+// type::Value does.
+bool FilterColumn(const executor::LogicalTile::ColumnChunk &chunk,
+                  ExpressionType comparison, const type::Value &constant,
+                  std::vector<oid_t> &selection) {
+  switch (comparison) {
+    case (ExpressionType::COMPARE_EQUAL):
+    case (ExpressionType::COMPARE_NOTEQUAL):
+    case (ExpressionType::COMPARE_LESSTHAN):
+    case (ExpressionType::COMPARE_LESSTHANOREQUALTO):
+    case (ExpressionType::COMPARE_GREATERTHAN):
+    case (ExpressionType::COMPARE_GREATERTHANOREQUALTO):
+      break;
+    default:
+      return false;
+  }
+
+  auto const_type = constant.GetTypeId();
+  bool const_is_integer = const_type == type::Type::TINYINT ||
+                          const_type == type::Type::SMALLINT ||
+                          const_type == type::Type::INTEGER ||
+                          const_type == type::Type::BIGINT;
+  if (!const_is_integer && const_type != type::Type::DECIMAL) {
+    return false;
+  }
+
+  switch (chunk.type) {
+    case type::Type::TINYINT:
+    case type::Type::SMALLINT:
+    case type::Type::INTEGER:
+    case type::Type::BIGINT:
+    case type::Type::DECIMAL:
+      break;
+    default:
+      return false;
+  }
+
+  // Nothing compares true with null
+  if (constant.IsNull()) {
+    selection.clear();
+    return true;
+  }
+
+  if (const_is_integer && chunk.type != type::Type::DECIMAL) {
+    auto value = constant.CastAs(type::Type::BIGINT).GetAs<int64_t>();
+    switch (chunk.type) {
+      case type::Type::TINYINT:
+        FilterColumn(chunk, comparison, type::PELOTON_INT8_NULL, value,
+                     selection);
+        break;
+      case type::Type::SMALLINT:
+        FilterColumn(chunk, comparison, type::PELOTON_INT16_NULL, value,
+                     selection);
+        break;
+      case type::Type::INTEGER:
+        FilterColumn(chunk, comparison, type::PELOTON_INT32_NULL, value,
+                     selection);
+        break;
+      default:
+        FilterColumn(chunk, comparison, type::PELOTON_INT64_NULL, value,
+                     selection);
+        break;
+    }
+    return true;
+  }
+
+  auto value = constant.CastAs(type::Type::DECIMAL).GetAs<double>();
+  switch (chunk.type) {
+    case type::Type::TINYINT:
+      FilterColumn(chunk, comparison, type::PELOTON_INT8_NULL, value,
+                   selection);
+      break;
+    case type::Type::SMALLINT:
+      FilterColumn(chunk, comparison, type::PELOTON_INT16_NULL, value,
+                   selection);
+      break;
+    case type::Type::INTEGER:
+      FilterColumn(chunk, comparison, type::PELOTON_INT32_NULL, value,
+                   selection);
+      break;
+    case type::Type::BIGINT:
+      FilterColumn(chunk, comparison, type::PELOTON_INT64_NULL, value,
+                   selection);
+      break;
+    default:
+      FilterColumn(chunk, comparison, type::PELOTON_DECIMAL_NULL, value,
+                   selection);
+      break;
+  }
+  return true;
+}
+
+}  // anonymous namespace
+
+void ComparisonExpression::EvaluateBatch(
+    executor::LogicalTile *tile, std::vector<oid_t> &selection,
+    executor::ExecutorContext *context) const {
+  PL_ASSERT(children_.size() == 2);
+  const AbstractExpression *column = children_[0].get();
+  const AbstractExpression *constant = children_[1].get();
+  ExpressionType comparison = exp_type_;
+  if (column->GetExpressionType() == ExpressionType::VALUE_CONSTANT &&
+      constant->GetExpressionType() == ExpressionType::VALUE_TUPLE) {
+    std::swap(column, constant);
+    comparison = ExpressionUtil::FlipComparison(comparison);
+  }
+
+  if (column->GetExpressionType() == ExpressionType::VALUE_TUPLE &&
+      constant->GetExpressionType() == ExpressionType::VALUE_CONSTANT) {
+    auto *tuple_value = static_cast<const TupleValueExpression *>(column);
+    auto column_id = static_cast<oid_t>(tuple_value->GetColumnId());
+    if (tuple_value->GetTupleId() == 0 && column_id < tile->GetColumnCount()) {
+      const auto &column_info = tile->GetColumnInfo(column_id);
+      const auto *base_schema = column_info.base_tile->GetSchema();
+      if (base_schema->IsInlined(column_info.origin_column_id) &&
+          FilterColumn(tile->GetColumnChunk(column_id), comparison,
+                       static_cast<const ConstantValueExpression *>(constant)
+                           ->GetValue(),
+                       selection)) {
+        return;
+      }
+    }
+  }
+
+  // Everything else is evaluated one tuple at a time
+  AbstractExpression::EvaluateBatch(tile, selection, context);
+}
+
+}  // End expression namespace
+}  // End peloton namespace
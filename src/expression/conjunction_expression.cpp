@@ -0,0 +1,60 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// conjunction_expression.cpp
+//
+// Identification: src/expression/conjunction_expression.cpp
+//
+// Copyright (c) 2015-2017, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "expression/conjunction_expression.h"
+
+#include <algorithm>
+#include <iterator>
+
+namespace peloton {
+namespace expression {
+
+void ConjunctionExpression::EvaluateBatch(
+    executor::LogicalTile *tile, std::vector<oid_t> &selection,
+    executor::ExecutorContext *context) const {
+  PL_ASSERT(children_.size() == 2);
+  switch (exp_type_) {
+    case (ExpressionType::CONJUNCTION_AND): {
+      // The right side only needs to see the tuples the left side is true for
+      children_[0]->EvaluateBatch(tile, selection, context);
+      if (!selection.empty()) {
+        children_[1]->EvaluateBatch(tile, selection, context);
+      }
+      break;
+    }
+    case (ExpressionType::CONJUNCTION_OR): {
+      // The right side only needs to see the tuples the left side isn't true
+      // for. Both results stay sorted, so they can be merged.
+      std::vector<oid_t> left_selection = selection;
+      children_[0]->EvaluateBatch(tile, left_selection, context);
+
+      std::vector<oid_t> right_selection;
+      std::set_difference(selection.begin(), selection.end(),
+                          left_selection.begin(), left_selection.end(),
+                          std::back_inserter(right_selection));
+      if (!right_selection.empty()) {
+        children_[1]->EvaluateBatch(tile, right_selection, context);
+      }
+
+      selection.clear();
+      std::merge(left_selection.begin(), left_selection.end(),
+                 right_selection.begin(), right_selection.end(),
+                 std::back_inserter(selection));
+      break;
+    }
+    default:
+      throw Exception("Invalid conjunction expression type.");
+  }
+}
+
+}  // End expression namespace
+}  // End peloton namespace
@@ -22,40 +22,29 @@ namespace peloton {
 namespace gc {
 
 // Check a tuple and reclaim all varlen field
-void GCManager::CheckAndReclaimVarlenColumns(storage::TileGroup *tg, oid_t tuple_id) {
-    oid_t tile_count = tg->tile_count;
-    oid_t tile_col_count;
-    type::Type::TypeId type_id;
-    char *tuple_location;
-    char *field_location;
-    char *varlen_ptr;
-
-      for (oid_t tile_itr = 0; tile_itr < tile_count; tile_itr++) {
-        const catalog::Schema &schema = tg->tile_schemas[tile_itr];
-
-          tile_col_count = schema.GetColumnCount();
-
-          storage::Tile *tile = tg->GetTile(tile_itr);
-        PL_ASSERT(tile);
-        for (oid_t tile_col_itr = 0; tile_col_itr < tile_col_count; ++tile_col_itr) {
-            type_id = schema.GetType(tile_col_itr);
-
-              if ((type_id != type::Type::TypeId::VARCHAR && type_id != type::Type::TypeId::VARBINARY)
-                             || (schema.IsInlined(tile_col_itr) == true)) {
-                // Not of varlen type, or is inlined, skip
-                  continue;
-              }
-            // Get the raw varlen pointer
-              tuple_location = tile->GetTupleLocation(tuple_id);
-            field_location = tuple_location + schema.GetOffset(tile_col_itr);
-            varlen_ptr = type::Value::GetDataFromStorage(type_id, field_location);
-            // Call the corresponding varlen pool free
-              if (varlen_ptr != nullptr) {
-                tile->pool->Free(varlen_ptr);
-              }
-          }
-      }
+void GCManager::CheckAndReclaimVarlenColumns(storage::TileGroup *tg,
+                                             oid_t tuple_id,
+                                             uint64_t shared_columns) {
+  for (auto &varlen_column : tg->varlen_columns) {
+    if (varlen_column.column_id < 64 &&
+        (shared_columns & (1ul << varlen_column.column_id)) != 0) {
+      // another version owns the data
+      continue;
+    }
+
+    storage::Tile *tile = tg->GetTile(varlen_column.tile_offset);
+    PL_ASSERT(tile);
+    // Get the raw varlen pointer
+    char **field_location = reinterpret_cast<char **>(
+        tile->GetTupleLocation(tuple_id) + varlen_column.field_offset);
+    // Call the corresponding varlen pool free, and forget the pointer so a
+    // version later placed in this slot does not free it again
+    if (*field_location != nullptr) {
+      tile->pool->Free(*field_location);
+      *field_location = nullptr;
+    }
   }
+}
 
 }
 }
@@ -11,19 +11,49 @@
 //===----------------------------------------------------------------------===//
 
 #include "gc/transaction_level_gc_manager.h"
+
+#include <algorithm>
+
+#include "gc/gc_manager_factory.h"
+#include "statistics/backend_stats_context.h"
 #include "storage/tuple.h"
 #include "storage/database.h"
 #include "storage/tile_group.h"
 #include "catalog/manager.h"
+#include "concurrency/epoch_manager_factory.h"
 #include "concurrency/transaction_manager_factory.h"
 #include "common/container_tuple.h"
 
 namespace peloton {
 namespace gc {
 
-bool TransactionLevelGCManager::ResetTuple(const ItemPointer &location) {
+namespace {
+
+// The garbage batch of the calling worker. The gc threads drop the batch
+// once the worker exited and its garbage is handed over.
+struct GarbageBatchOwner {
+  ~GarbageBatchOwner() {
+    if (batch != nullptr) {
+      batch->lock.Lock();
+      batch->exited = true;
+      batch->lock.Unlock();
+    }
+  }
+
+  std::shared_ptr<GarbageBatch> batch;
+};
+
+thread_local GarbageBatchOwner garbage_batch_owner;
+
+}  // anonymous namespace
+
+bool TransactionLevelGCManager::ResetTuple(const ItemPointer &location,
+                                           const uint64_t shared_columns) {
   auto &manager = catalog::Manager::GetInstance();
-  auto tile_group = manager.GetTileGroup(location.block).get();
+  auto tile_group = manager.GetTileGroupPtr(location.block);
+  if (tile_group == nullptr) {
+    return false;
+  }
 
   auto tile_group_header = tile_group->GetHeader();
 
@@ -37,8 +67,12 @@ bool TransactionLevelGCManager::ResetTuple(const ItemPointer &location) {
   PL_MEMSET(tile_group_header->GetReservedFieldRef(location.offset), 0,
             storage::TileGroupHeader::GetReservedSize());
 
-  // Reclaim the varlen pool
-  CheckAndReclaimVarlenColumns(tile_group, location.offset);
+  // Reclaim the varlen pool. the data of an immutable tile group is kept
+  // until the tile group is freed, as it may be copied meanwhile.
+  if (tile_group_header->IsImmutable() == false) {
+    CheckAndReclaimVarlenColumns(tile_group, location.offset,
+                                 shared_columns);
+  }
 
   LOG_TRACE("Garbage tuple(%u, %u) is reset", location.block, location.offset);
   return true;
@@ -57,10 +91,32 @@ void TransactionLevelGCManager::Running(const int &thread_id) {
       continue;
     }
 
+    // the first gc thread hands over the garbage the workers batched, which
+    // an idle worker would keep otherwise
+    if (thread_id == 0) {
+      FlushGarbageBatches();
+    }
+
+    gc_thread_locks_[thread_id].Lock();
+
+    // the tile groups are looked up by raw pointer, the epoch keeps the ones
+    // dropped meanwhile alive
+    auto &epoch_manager = concurrency::EpochManagerFactory::GetInstance();
+    cid_t epoch_cid = epoch_manager.EnterEpoch(GC_EPOCH_THREAD_ID);
+
     int reclaimed_count = Reclaim(thread_id, max_cid);
 
     int unlinked_count = Unlink(thread_id, max_cid);
 
+    epoch_manager.ExitEpoch(GC_EPOCH_THREAD_ID, epoch_cid);
+
+    gc_thread_locks_[thread_id].Unlock();
+
+    // the first gc thread also frees the tile groups of dropped tables
+    if (thread_id == 0) {
+      catalog::Manager::GetInstance().ReclaimDroppedTileGroups(max_cid);
+    }
+
     if (is_running_ == false) {
       return;
     }
@@ -80,14 +136,121 @@ void TransactionLevelGCManager::Running(const int &thread_id) {
 
 void TransactionLevelGCManager::RecycleTransaction(
     std::shared_ptr<GCSet> gc_set, const cid_t &timestamp) {
+  if (GCManagerFactory::GetGCType() != GarbageCollectionType::COOPERATIVE) {
+    EnqueueGarbage(std::make_shared<GarbageContext>(gc_set, timestamp));
+    return;
+  }
+
+  // The transaction does not touch its gc set anymore, so the first one
+  // of a batch collects the garbage of the others
+  auto &batch = GetGarbageBatch();
+  batch.lock.Lock();
+  if (batch.txn_count == 0) {
+    batch.gc_set = gc_set;
+    batch.timestamp = timestamp;
+    batch.recycle_time = std::chrono::steady_clock::now();
+  } else {
+    batch.gc_set->insert(batch.gc_set->end(), gc_set->begin(), gc_set->end());
+    batch.timestamp = std::max(batch.timestamp, timestamp);
+  }
+  batch.txn_count++;
+
+  bool full = batch.txn_count >= COOPERATIVE_GC_BATCH_SIZE;
+  auto batch_timestamp = batch.timestamp;
+  batch.lock.Unlock();
+
+  if (full == true) {
+    CooperativeCollect(HashToThread(batch_timestamp));
+  }
+}
+
+void TransactionLevelGCManager::VersionChainTraversed(
+    const size_t &worker_id, const size_t &chain_length) {
+  if (chain_length >= COOPERATIVE_GC_CHAIN_LENGTH &&
+      GCManagerFactory::GetGCType() == GarbageCollectionType::COOPERATIVE) {
+    CooperativeCollect(worker_id);
+  }
+}
+
+void TransactionLevelGCManager::CooperativeCollect(const size_t &worker_id) {
+  FlushGarbageBatch();
+
+  int thread_id = worker_id % gc_thread_count_;
+  // the gc thread or another worker is already on it
+  if (gc_thread_locks_[thread_id].TryLock() == false) {
+    return;
+  }
+
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto max_cid = txn_manager.GetMaxCommittedCid();
+  if (max_cid != MAX_CID) {
+    // a worker may collect after its transaction has left its epoch
+    auto &epoch_manager = concurrency::EpochManagerFactory::GetInstance();
+    cid_t epoch_cid = epoch_manager.EnterEpoch(GC_EPOCH_THREAD_ID);
+    Reclaim(thread_id, max_cid);
+    Unlink(thread_id, max_cid, COOPERATIVE_GC_ATTEMPT_COUNT);
+    epoch_manager.ExitEpoch(GC_EPOCH_THREAD_ID, epoch_cid);
+  }
+
+  gc_thread_locks_[thread_id].Unlock();
+}
+
+void TransactionLevelGCManager::EnqueueGarbage(
+    std::shared_ptr<GarbageContext> gc_context) {
   // Add the garbage context to the lock-free queue
-  std::shared_ptr<GarbageContext> gc_context(
-      new GarbageContext(gc_set, timestamp));
   unlink_queues_[HashToThread(gc_context->timestamp_)]->Enqueue(gc_context);
 }
 
+GarbageBatch &TransactionLevelGCManager::GetGarbageBatch() {
+  auto &owner = garbage_batch_owner;
+  if (owner.batch == nullptr) {
+    owner.batch = std::make_shared<GarbageBatch>();
+    std::lock_guard<std::mutex> lock(garbage_batches_lock_);
+    garbage_batches_.push_back(owner.batch);
+  }
+  return *owner.batch;
+}
+
+void TransactionLevelGCManager::FlushGarbageBatch(GarbageBatch &batch) {
+  if (batch.txn_count == 0) {
+    return;
+  }
+  EnqueueGarbage(std::make_shared<GarbageContext>(
+      std::move(batch.gc_set), batch.timestamp, batch.recycle_time));
+  batch.gc_set.reset();
+  batch.txn_count = 0;
+}
+
+void TransactionLevelGCManager::FlushGarbageBatch() {
+  auto &owner = garbage_batch_owner;
+  if (owner.batch == nullptr) {
+    return;
+  }
+  owner.batch->lock.Lock();
+  FlushGarbageBatch(*owner.batch);
+  owner.batch->lock.Unlock();
+}
+
+void TransactionLevelGCManager::FlushGarbageBatches() {
+  std::lock_guard<std::mutex> lock(garbage_batches_lock_);
+  auto batch = garbage_batches_.begin();
+  while (batch != garbage_batches_.end()) {
+    (*batch)->lock.Lock();
+    FlushGarbageBatch(**batch);
+    bool exited = (*batch)->exited;
+    (*batch)->lock.Unlock();
+
+    if (exited == true) {
+      batch = garbage_batches_.erase(batch);
+    } else {
+      ++batch;
+    }
+  }
+}
+
 int TransactionLevelGCManager::Unlink(const int &thread_id,
-                                      const cid_t &max_cid) {
+                                      const cid_t &max_cid,
+                                      const size_t &max_attempt_count) {
   int tuple_counter = 0;
 
   // check if any garbage can be unlinked from indexes.
@@ -109,7 +272,7 @@ int TransactionLevelGCManager::Unlink(const int &thread_id,
         return res;
       });
 
-  for (size_t i = 0; i < MAX_ATTEMPT_COUNT; ++i) {
+  for (size_t i = 0; i < max_attempt_count; ++i) {
     std::shared_ptr<GarbageContext> garbage_ctx;
     // if there's no more tuples in the queue, then break.
     if (unlink_queues_[thread_id]->Dequeue(garbage_ctx) == false) {
@@ -148,6 +311,8 @@ int TransactionLevelGCManager::Reclaim(const int &thread_id,
                                        const cid_t &max_cid) {
   int gc_counter = 0;
 
+  RecycleFrozenGarbage(thread_id);
+
   // we delete garbage in the free list
   auto garbage_ctx_entry = reclaim_maps_[thread_id].begin();
   while (garbage_ctx_entry != reclaim_maps_[thread_id].end()) {
@@ -157,7 +322,7 @@ int TransactionLevelGCManager::Reclaim(const int &thread_id,
     // if the timestamp of the garbage is older than the current max_cid,
     // recycle it
     if (garbage_ts < max_cid) {
-      AddToRecycleMap(garbage_ctx);
+      AddToRecycleMap(thread_id, garbage_ctx);
 
       // Remove from the original map
       garbage_ctx_entry = reclaim_maps_[thread_id].erase(garbage_ctx_entry);
@@ -173,39 +338,103 @@ int TransactionLevelGCManager::Reclaim(const int &thread_id,
 
 // Multiple GC thread share the same recycle map
 void TransactionLevelGCManager::AddToRecycleMap(
-    std::shared_ptr<GarbageContext> garbage_ctx) {
+    const int &thread_id, std::shared_ptr<GarbageContext> garbage_ctx) {
+  auto &manager = catalog::Manager::GetInstance();
+
+  // the locations of a tile group are usually next to each other in the set
+  oid_t tile_group_id = INVALID_OID;
+  oid_t table_id = INVALID_OID;
+  bool immutable = false;
   for (auto &entry : *(garbage_ctx->gc_set_.get())) {
-    auto &manager = catalog::Manager::GetInstance();
-    auto tile_group = manager.GetTileGroup(entry.first);
+    // as this transaction has been committed, we should reclaim older
+    // versions.
+    ItemPointer location = entry.location;
 
-    // During the resetting, a table may be deconstructed because of the DROP
-    // TABLE request
-    if (tile_group == nullptr) {
-      return;
+    if (location.block != tile_group_id) {
+      tile_group_id = location.block;
+      table_id = INVALID_OID;
+
+      auto tile_group = manager.GetTileGroupPtr(tile_group_id);
+
+      // During the resetting, a table may be deconstructed because of the DROP
+      // TABLE request
+      if (tile_group == nullptr) {
+        continue;
+      }
+
+      storage::DataTable *table =
+          dynamic_cast<storage::DataTable *>(tile_group->GetAbstractTable());
+      PL_ASSERT(table != nullptr);
+
+      table_id = table->GetOid();
+      immutable = tile_group->GetHeader()->IsImmutable();
+    }
+
+    if (table_id == INVALID_OID) {
+      continue;
+    }
+
+    // the garbage of an immutable tile group may still be copied, it is
+    // recycled once the tile group is mutable again
+    if (immutable == true) {
+      frozen_garbage_maps_[thread_id][tile_group_id].push_back(entry);
+      continue;
     }
 
-    PL_ASSERT(tile_group != nullptr);
+    RecycleTuple(table_id, entry);
+  }
+
+  if (FLAGS_stats_mode != STATS_TYPE_INVALID) {
+    auto latency_us = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - garbage_ctx->recycle_time_);
+    stats::BackendStatsContext::GetInstance()->IncrementGCReclaims(
+        garbage_ctx->gc_set_->size(), latency_us.count());
+  }
+}
+
+void TransactionLevelGCManager::RecycleFrozenGarbage(const int &thread_id) {
+  auto &manager = catalog::Manager::GetInstance();
+  auto &frozen_garbage_map = frozen_garbage_maps_[thread_id];
+  auto frozen_garbage = frozen_garbage_map.begin();
+  while (frozen_garbage != frozen_garbage_map.end()) {
+    auto tile_group = manager.GetTileGroupPtr(frozen_garbage->first);
+    // the tile group was dropped with its garbage
+    if (tile_group == nullptr) {
+      frozen_garbage = frozen_garbage_map.erase(frozen_garbage);
+      continue;
+    }
+    if (tile_group->GetHeader()->IsImmutable() == true) {
+      ++frozen_garbage;
+      continue;
+    }
 
     storage::DataTable *table =
         dynamic_cast<storage::DataTable *>(tile_group->GetAbstractTable());
     PL_ASSERT(table != nullptr);
+    for (auto &entry : frozen_garbage->second) {
+      RecycleTuple(table->GetOid(), entry);
+    }
+    frozen_garbage = frozen_garbage_map.erase(frozen_garbage);
+  }
+}
 
-    oid_t table_id = table->GetOid();
-
-    for (auto &element : entry.second) {
-      // as this transaction has been committed, we should reclaim older
-      // versions.
-      ItemPointer location(entry.first, element.first);
+void TransactionLevelGCManager::RecycleTuple(const oid_t &table_id,
+                                             const GCEntry &entry) {
+  // If the tuple being reset no longer exists, just skip it
+  if (ResetTuple(entry.location, entry.shared_varlen_columns) == false) {
+    return;
+  }
+  // if the entry for table_id exists.
+  if (recycle_queue_map_.find(table_id) != recycle_queue_map_.end()) {
+    recycle_queue_map_[table_id]->Enqueue(entry.location);
+  }
+}
 
-      // If the tuple being reset no longer exists, just skip it
-      if (ResetTuple(location) == false) {
-        continue;
-      }
-      // if the entry for table_id exists.
-      if (recycle_queue_map_.find(table_id) != recycle_queue_map_.end()) {
-        recycle_queue_map_[table_id]->Enqueue(location);
-      }
-    }
+void TransactionLevelGCManager::RecycleTupleSlot(const oid_t &table_id,
+                                                 const ItemPointer &location) {
+  auto recycle_queue_itr = recycle_queue_map_.find(table_id);
+  if (recycle_queue_itr != recycle_queue_map_.end()) {
+    recycle_queue_itr->second->Enqueue(location);
   }
 }
 
@@ -228,7 +457,24 @@ ItemPointer TransactionLevelGCManager::ReturnFreeSlot(const oid_t &table_id) {
   return INVALID_ITEMPOINTER;
 }
 
+// this function returns up to max_count free tuple slots, so that
+// data_table only goes to the shared queue once per batch of inserts.
+size_t TransactionLevelGCManager::ReturnFreeSlots(const oid_t &table_id,
+                                                  ItemPointer *locations,
+                                                  const size_t &max_count) {
+  auto recycle_queue_itr = recycle_queue_map_.find(table_id);
+  // for catalog tables, there is nothing to reuse.
+  if (recycle_queue_itr == recycle_queue_map_.end()) {
+    return 0;
+  }
+  return recycle_queue_itr->second->DequeueBulk(locations, max_count);
+}
+
 void TransactionLevelGCManager::ClearGarbage(int thread_id) {
+  FlushGarbageBatches();
+
+  gc_thread_locks_[thread_id].Lock();
+
   while (!unlink_queues_[thread_id]->IsEmpty() ||
          !local_unlink_queues_[thread_id].empty()) {
     Unlink(thread_id, MAX_CID);
@@ -238,27 +484,24 @@ void TransactionLevelGCManager::ClearGarbage(int thread_id) {
     Reclaim(thread_id, MAX_CID);
   }
 
+  gc_thread_locks_[thread_id].Unlock();
+
   return;
 }
 
 void TransactionLevelGCManager::DeleteFromIndexes(
     const std::shared_ptr<GarbageContext> &garbage_ctx) {
-  for (auto entry : *(garbage_ctx->gc_set_.get())) {
-    for (auto &element : entry.second) {
-      if (element.second == true) {
-        // only old versions are stored in the gc set.
-        // so we can safely get indirection from the indirection array.
-        auto tile_group =
-            catalog::Manager::GetInstance().GetTileGroup(entry.first);
-        if (tile_group != nullptr) {
-          auto tile_group_header = catalog::Manager::GetInstance()
-                                       .GetTileGroup(entry.first)
-                                       ->GetHeader();
-          ItemPointer *indirection =
-              tile_group_header->GetIndirection(element.first);
-
-          DeleteTupleFromIndexes(indirection);
-        }
+  auto &manager = catalog::Manager::GetInstance();
+  for (auto &entry : *(garbage_ctx->gc_set_.get())) {
+    if (entry.delete_from_indexes == true) {
+      // only old versions are stored in the gc set.
+      // so we can safely get indirection from the indirection array.
+      auto tile_group_header = manager.GetTileGroupHeader(entry.location.block);
+      if (tile_group_header != nullptr) {
+        ItemPointer *indirection =
+            tile_group_header->GetIndirection(entry.location.offset);
+
+        DeleteTupleFromIndexes(indirection);
       }
     }
   }
@@ -276,7 +519,7 @@ void TransactionLevelGCManager::DeleteTupleFromIndexes(
   ItemPointer location = *indirection;
 
   auto &manager = catalog::Manager::GetInstance();
-  auto tile_group = manager.GetTileGroup(location.block);
+  auto tile_group = manager.GetTileGroupPtr(location.block);
 
   PL_ASSERT(tile_group != nullptr);
 
@@ -285,7 +528,7 @@ void TransactionLevelGCManager::DeleteTupleFromIndexes(
   PL_ASSERT(table != nullptr);
 
   // construct the expired version.
-  expression::ContainerTuple<storage::TileGroup> expired_tuple(tile_group.get(),
+  expression::ContainerTuple<storage::TileGroup> expired_tuple(tile_group,
                                                                location.offset);
 
   // unlink the version from all the indexes.
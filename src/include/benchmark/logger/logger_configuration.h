@@ -31,7 +31,8 @@ enum ExperimentType {
   EXPERIMENT_TYPE_THROUGHPUT = 1,
   EXPERIMENT_TYPE_RECOVERY = 2,
   EXPERIMENT_TYPE_STORAGE = 3,
-  EXPERIMENT_TYPE_LATENCY = 4
+  EXPERIMENT_TYPE_LATENCY = 4,
+  EXPERIMENT_TYPE_GROUP_COMMIT = 5
 };
 
 enum BenchmarkType {
@@ -70,6 +71,12 @@ class configuration {
   // frequency with which the logger flushes
   int wait_timeout;
 
+  // group commit window (in us)
+  int group_commit_window;
+
+  // group commit window (in bytes, 0 is no limit)
+  int group_commit_bytes;
+
   // Benchmark type
   BenchmarkType benchmark_type;
 
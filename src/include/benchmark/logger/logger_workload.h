@@ -42,6 +42,9 @@ bool SetupLoggingOnFollower();
 
 bool PrepareLogFile();
 
+// Append the commit throughput under the group commit window to the summary
+void WriteGroupCommitOutput();
+
 //===--------------------------------------------------------------------===//
 // CHECK RECOVERY
 //===--------------------------------------------------------------------===//
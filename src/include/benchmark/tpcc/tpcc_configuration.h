@@ -158,6 +158,9 @@ class configuration {
   // epoch type
   EpochType epoch;
 
+  // isolation level
+  IsolationLevelType isolation;
+
   // scale factor
   double scale_factor;
 
@@ -194,6 +197,9 @@ class configuration {
   // number of gc threads
   bool gc_backend_count;
 
+  // let the workers help the gc
+  bool gc_cooperative;
+
   // number of loaders
   int loader_count;
 
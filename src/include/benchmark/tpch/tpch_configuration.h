@@ -15,6 +15,7 @@
 #include <cstdint>
 #include <cstring>
 #include <string>
+#include <vector>
 
 #include "type/types.h"
 
@@ -85,6 +86,10 @@ struct Configuration {
   // The number of runs to average over
   uint32_t num_runs = 10;
 
+  // The maximum number of threads to run queries with. Queries are run with
+  // one thread and every power of two up to (and including) this number.
+  uint32_t max_threads = 1;
+
   // The directory where all the data files are
   std::string data_dir;
 
@@ -113,6 +118,8 @@ struct Configuration {
   void SetRunnableQueries(char *query_list);
 
   bool ShouldRunQuery(QueryId qid) const;
+
+  std::vector<uint32_t> GetThreadCounts() const;
 };
 
 }  // namespace tpch
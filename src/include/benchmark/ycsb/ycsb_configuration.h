@@ -43,6 +43,9 @@ class configuration {
   // epoch type
   EpochType epoch;
 
+  // isolation level
+  IsolationLevelType isolation;
+
   // size of the table
   int scale_factor;
 
@@ -79,6 +82,9 @@ class configuration {
   // number of gc threads
   int gc_backend_count;
 
+  // let the workers help the gc
+  bool gc_cooperative;
+
   // number of loaders
   int loader_count;
 
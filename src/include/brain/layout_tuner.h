@@ -72,6 +72,9 @@ class LayoutTuner {
   // Tables whose layout must be tuned
   std::vector<storage::DataTable *> tables;
 
+  // The offset of the tile group last visited in each table
+  std::vector<oid_t> last_tile_group_offsets;
+
   std::mutex layout_tuner_mutex;
 
   // Stop signal
@@ -105,6 +108,9 @@ class LayoutTuner {
   // Desired layout tile count
   oid_t tile_count = 2;
 
+  // Tile groups of a table visited in one round
+  oid_t tile_group_batch_size = 8;
+
 };
 
 }  // End brain namespace
@@ -13,6 +13,7 @@
 #pragma once
 
 #include <atomic>
+#include <deque>
 #include <utility>
 #include <mutex>
 #include <vector>
@@ -27,6 +28,7 @@ namespace peloton {
 
 namespace storage {
 class TileGroup;
+class TileGroupHeader;
 class IndirectionArray;
 }
 
@@ -60,8 +62,31 @@ class Manager {
 
   void DropTileGroup(const oid_t oid);
 
+  // Replace a tile group by another one with the same id. The old tile group
+  // is freed like a dropped one.
+  void ReplaceTileGroup(const oid_t oid,
+                        std::shared_ptr<storage::TileGroup> location);
+
   std::shared_ptr<storage::TileGroup> GetTileGroup(const oid_t oid);
 
+  // Get the tile group without taking a reference to it. This does not touch
+  // the reference count shared by all the threads, so it is meant for hot
+  // paths. A tile group dropped meanwhile is only freed once every
+  // transaction that was running when it was dropped has ended, so the
+  // pointer stays valid until the current transaction ends. Use
+  // GetTileGroup() to hold on to a tile group beyond that.
+  storage::TileGroup *GetTileGroupPtr(const oid_t oid) const {
+    return tile_group_ptr_locator_.Find(oid);
+  }
+
+  // Get the header of the tile group, with the same guarantees as
+  // GetTileGroupPtr(). Returns nullptr if the tile group does not exist.
+  storage::TileGroupHeader *GetTileGroupHeader(const oid_t oid) const;
+
+  // Free the dropped tile groups that no transaction can access anymore,
+  // i.e., that were dropped before max_committed_cid
+  void ReclaimDroppedTileGroups(const cid_t &max_committed_cid);
+
   void ClearTileGroup(void);
 
 
@@ -83,6 +108,9 @@ class Manager {
   Manager(Manager const &) = delete;
 
  private:
+  // keep a tile group that is no longer in the catalog until no transaction
+  // can access it
+  void RetireTileGroup(std::shared_ptr<storage::TileGroup> tile_group);
   //===--------------------------------------------------------------------===//
   // Data member for tile allocation
   //===--------------------------------------------------------------------===//
@@ -96,8 +124,17 @@ class Manager {
 
   LockFreeArray<std::shared_ptr<storage::TileGroup>> tile_group_locator_;
 
+  // the same tile groups, without the reference counts
+  LockFreeArray<storage::TileGroup *> tile_group_ptr_locator_;
+
   static std::shared_ptr<storage::TileGroup> empty_tile_group_;
 
+  // dropped tile groups that may still be in use, with the commit id at
+  // which they were dropped, oldest first
+  std::deque<std::pair<cid_t, std::shared_ptr<storage::TileGroup>>>
+      dropped_tile_groups_;
+  std::mutex dropped_tile_groups_lock_;
+
   //===--------------------------------------------------------------------===//
   // Data members for indirection array allocation
   //===--------------------------------------------------------------------===//
@@ -53,6 +53,11 @@ class Aggregation {
   void AdvanceValues(CodeGen &codegen, llvm::Value *storage_space,
                      const std::vector<codegen::Value> &next) const;
 
+  // Merge the aggregates stored in the other storage space into the ones
+  // stored in the provided storage space. Both must contain initial values.
+  void MergeValues(CodeGen &codegen, llvm::Value *storage_space,
+                   llvm::Value *other_storage_space) const;
+
   // Compute the final values of all the aggregates stored in the provided
   // storage space, putting them into the final_vals vector
   void FinalizeValues(CodeGen &codegen, llvm::Value *storage_space,
@@ -106,6 +111,12 @@ class Aggregation {
     bool is_internal;
   };
 
+  // Combine the current value of a SUM, MIN or MAX aggregate with another
+  // value, taking the non-NULL side if either of them is NULL
+  codegen::Value CombineValues(CodeGen &codegen, ExpressionType aggregate_type,
+                               const codegen::Value &curr,
+                               const codegen::Value &other) const;
+
  private:
   // The list of aggregations we handle
   std::vector<AggregateInfo> aggregate_infos_;
@@ -21,6 +21,10 @@
 
 namespace peloton {
 
+namespace executor {
+class ResultSink;
+}  // namespace executor
+
 namespace planner {
 class BindingContext;
 }  // namespace planner
@@ -47,17 +51,20 @@ class WrappedTuple
 };
 
 //===----------------------------------------------------------------------===//
-// A query consumer that buffers tuples into a local memory location
+// A query consumer that buffers tuples into a local memory location, or
+// streams them into a result sink if it is given one
 //===----------------------------------------------------------------------===//
 class BufferingConsumer : public QueryResultConsumer {
  public:
   struct BufferingState {
     std::vector<WrappedTuple> *output;
+    executor::ResultSink *sink;
   };
 
   // Constructor
   BufferingConsumer(const std::vector<oid_t> &cols,
-                    planner::BindingContext &context);
+                    planner::BindingContext &context,
+                    executor::ResultSink *sink = nullptr);
 
   void Prepare(CompilationContext &compilation_context) override;
   void InitializeState(CompilationContext &) override {}
@@ -75,7 +82,7 @@ class BufferingConsumer : public QueryResultConsumer {
     static llvm::Function *GetFunction(CodeGen &codegen);
   };
 
-  // Called from compiled query code to buffer the tuple
+  // Called from compiled query code to buffer (or stream) the tuple
   static void BufferTuple(char *state, type::Value *vals, uint32_t num_vals);
 
   //===--------------------------------------------------------------------===//
@@ -63,6 +63,10 @@ class CodeContext {
   // Get the identifier for this code
   uint64_t GetID() const { return id_; }
 
+  // Get the number of bytes of machine code and data the JIT produced. This is
+  // zero until the context has been compiled.
+  uint64_t GetCodeSize() const { return code_size_; }
+
   // Get the context
   llvm::LLVMContext &GetContext() { return *context_; }
 
@@ -106,6 +110,10 @@ class CodeContext {
   // The optimization pass manager
   llvm::legacy::FunctionPassManager opt_pass_manager_;
 
+  // The size of the JITed code and data sections, maintained by the engine's
+  // memory manager
+  uint64_t code_size_;
+
   // The engine we use to ultimately JIT the code in this context
   std::string err_str_;
   std::unique_ptr<llvm::ExecutionEngine> jit_engine_;
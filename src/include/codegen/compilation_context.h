@@ -36,6 +36,8 @@ class AbstractPlan;
 
 namespace codegen {
 
+class PlanFingerprint;
+
 //===----------------------------------------------------------------------===//
 // All the state for the current compilation unit (i.e., one query). This state
 // includes translations for every operator and expression in the tree, the
@@ -48,8 +50,11 @@ class CompilationContext {
   friend class RowBatch;
 
  public:
-  // Constructor
-  CompilationContext(Query &query, QueryResultConsumer &result_consumer);
+  // Constructor. If a fingerprint of the plan is provided, the constants it
+  // turned into parameters are read from the query's parameter buffer instead
+  // of being compiled into the code.
+  CompilationContext(Query &query, QueryResultConsumer &result_consumer,
+                     const PlanFingerprint *fingerprint = nullptr);
 
   // Prepare a translator in this context
   void Prepare(const planner::AbstractPlan &op, Pipeline &pipeline);
@@ -58,10 +63,15 @@ class CompilationContext {
   // Produce the tuples for the given operator
   void Produce(const planner::AbstractPlan &op);
 
+  // Get the registered translator for the given operator. Operators that drive
+  // another operator's code (e.g., index nested-loop joins) use this.
+  OperatorTranslator *GetTranslator(const planner::AbstractPlan &op) const;
+
   // This is the main entry point into the compilation component. Callers
   // construct a compilation context, then invoke this method to compile
   // the plan and prepare the provided query statement.
-  void GeneratePlan(QueryCompiler::CompileStats *stats);
+  void GeneratePlan(const planner::AbstractPlan &root,
+                    QueryCompiler::CompileStats *stats);
 
   //===--------------------------------------------------------------------===//
   // ACCESSORS
@@ -81,6 +91,12 @@ class CompilationContext {
   // Get a pointer to the transaction object from runtime state
   llvm::Value *GetTransactionPtr();
 
+  // Get a pointer to the query's parameter buffer from runtime state
+  llvm::Value *GetQueryParametersPtr();
+
+  // The fingerprint the query is compiled for, if any
+  const PlanFingerprint *GetPlanFingerprint() const { return fingerprint_; }
+
  private:
   // Generate any auxiliary helper functions that the query needs
   void GenerateHelperFunctions();
@@ -94,10 +110,9 @@ class CompilationContext {
   // Generate the tearDown() function of the query
   llvm::Function *GenerateTearDownFunction();
 
-  // Get the registered translator for the given operator/expression
+  // Get the registered translator for the given expression
   ExpressionTranslator *GetTranslator(
       const expression::AbstractExpression &exp) const;
-  OperatorTranslator *GetTranslator(const planner::AbstractPlan &op) const;
 
  private:
   // The query we'll compile
@@ -106,6 +121,9 @@ class CompilationContext {
   // The consumer of the results of the query
   QueryResultConsumer &result_consumer_;
 
+  // The fingerprint of the plan that decides which constants are parameters
+  const PlanFingerprint *fingerprint_;
+
   // The code generator
   CodeGen codegen_;
 
@@ -115,9 +133,10 @@ class CompilationContext {
   // The factory that creates translators for operators and expressions
   TranslatorFactory translator_factory_;
 
-  // The ID for the catalog and transaction state
+  // The ID for the catalog, transaction and parameter state
   RuntimeState::StateID txn_state_id_;
   RuntimeState::StateID catalog_state_id_;
+  RuntimeState::StateID parameters_state_id_;
 
   // The mapping of an operator in the tree to its translator
   std::unordered_map<const planner::AbstractPlan *,
@@ -24,7 +24,9 @@ namespace codegen {
 
 //===----------------------------------------------------------------------===//
 // A const expression translator just produces the LLVM value version of the
-// constant value within.
+// constant value within. If the query is compiled for a plan fingerprint that
+// turned the constant into a parameter, the value is instead loaded from the
+// query's parameter buffer so the code can be reused for other values.
 //===----------------------------------------------------------------------===//
 class ConstantTranslator : public ExpressionTranslator {
  public:
@@ -34,6 +36,18 @@ class ConstantTranslator : public ExpressionTranslator {
   // Produce the value that is the result of codegen-ing the expression
   codegen::Value DeriveValue(CodeGen &codegen,
                              RowBatch::Row &row) const override;
+
+ private:
+  // Load the value of the constant from the parameter buffer
+  codegen::Value LoadParameter(CodeGen &codegen) const;
+
+ private:
+  // The context the constant is compiled in
+  CompilationContext &context_;
+
+  // Whether the constant is a parameter, and the slot it can be found in
+  bool is_parameter_;
+  uint32_t parameter_slot_;
 };
 
 }  // namespace codegen
@@ -0,0 +1,69 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// filter_runtime.h
+//
+// Identification: src/include/codegen/filter_runtime.h
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <cstdint>
+
+#include "type/types.h"
+
+namespace peloton {
+namespace codegen {
+
+//===----------------------------------------------------------------------===//
+// This class contains the vectorized filter kernels the codegen component uses
+// to evaluate simple predicates of the form "column <comparison> constant"
+// over a batch of tuples in a tile group.
+//
+// Every kernel reads the column value of each tuple whose TID is in the given
+// selection vector, compares it with the constant, and compacts the selection
+// vector in place to the TIDs of the tuples that pass. The TIDs in the
+// selection vector must be sorted. The column value of tuple 'tid' lives at
+// 'column + tid * stride', which covers both row and columnar layouts. The
+// kernels return the number of TIDs left in the selection vector.
+//
+// Kernels use AVX2 gathers and compress the selection vector through a
+// permutation table when the CPU supports AVX2, and fall back to scalar loops
+// otherwise.
+//===----------------------------------------------------------------------===//
+class FilterRuntime {
+ public:
+  // Filter a column of 32-bit integers (INTEGER and DATE)
+  static uint32_t FilterInteger(const char *column, uint32_t stride,
+                                ExpressionType comparison, int32_t value,
+                                uint32_t *selection_vector,
+                                uint32_t num_selected);
+
+  // Filter a column of 64-bit integers (BIGINT and TIMESTAMP)
+  static uint32_t FilterBigInt(const char *column, uint32_t stride,
+                               ExpressionType comparison, int64_t value,
+                               uint32_t *selection_vector,
+                               uint32_t num_selected);
+
+  // Filter a column of decimals
+  static uint32_t FilterDecimal(const char *column, uint32_t stride,
+                                ExpressionType comparison, double value,
+                                uint32_t *selection_vector,
+                                uint32_t num_selected);
+
+  // Filter a packed column of integers of any width, whose values are the
+  // base plus the offsets of the given bits stored in the words at 'column',
+  // see storage::PackedColumn. The column isn't unpacked, every value is
+  // computed from its offset when it is compared.
+  static uint32_t FilterPacked(const char *column, uint32_t bits, int64_t base,
+                               ExpressionType comparison, int64_t value,
+                               uint32_t *selection_vector,
+                               uint32_t num_selected);
+};
+
+}  // namespace codegen
+}  // namespace peloton
@@ -0,0 +1,48 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// filter_runtime_proxy.h
+//
+// Identification: src/include/codegen/filter_runtime_proxy.h
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "codegen/codegen.h"
+
+namespace peloton {
+namespace codegen {
+
+class FilterRuntimeProxy {
+ public:
+  // The proxy around FilterRuntime::FilterInteger()
+  struct _FilterInteger {
+    static const std::string &GetFunctionName();
+    static llvm::Function *GetFunction(CodeGen &codegen);
+  };
+
+  // The proxy around FilterRuntime::FilterBigInt()
+  struct _FilterBigInt {
+    static const std::string &GetFunctionName();
+    static llvm::Function *GetFunction(CodeGen &codegen);
+  };
+
+  // The proxy around FilterRuntime::FilterDecimal()
+  struct _FilterDecimal {
+    static const std::string &GetFunctionName();
+    static llvm::Function *GetFunction(CodeGen &codegen);
+  };
+
+  // The proxy around FilterRuntime::FilterPacked()
+  struct _FilterPacked {
+    static const std::string &GetFunctionName();
+    static llvm::Function *GetFunction(CodeGen &codegen);
+  };
+};
+
+}  // namespace codegen
+}  // namespace peloton
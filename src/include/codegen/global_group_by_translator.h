@@ -51,6 +51,10 @@ class GlobalGroupByTranslator : public OperatorTranslator {
   // No state to tear down
   void TearDownState() override {}
 
+  // Parallel workers aggregate into buffers of their own
+  void InitializeWorkerState() const override;
+  void MergeWorkerState(llvm::Value *worker_state) const override;
+
   std::string GetName() const override;
 
  private:
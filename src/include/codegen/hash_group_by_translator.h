@@ -55,6 +55,11 @@ class HashGroupByTranslator : public OperatorTranslator {
   // Codegen any cleanup work for this translator
   void TearDownState() override;
 
+  // Parallel workers aggregate into hash tables of their own
+  void InitializeWorkerState() const override;
+  void MergeWorkerState(llvm::Value *worker_state) const override;
+  void TearDownWorkerState() const override;
+
   // Get a stringified name for this hash-table based aggregation
   std::string GetName() const override;
 
@@ -121,6 +126,69 @@ class HashGroupByTranslator : public OperatorTranslator {
     const std::vector<codegen::Value> &initial_vals_;
   };
 
+  //===--------------------------------------------------------------------===//
+  // The callback used when merging the hash table of a parallel worker into
+  // the main hash table. Every group of the worker is looked up in the main
+  // hash table. Existing groups merge the worker's partial aggregates, while
+  // missing groups are inserted with a copy of them.
+  //===--------------------------------------------------------------------===//
+  class MergeWorkerGroups : public HashTable::IterateCallback {
+   public:
+    // Constructor
+    MergeWorkerGroups(const OAHashTable &hash_table,
+                      const Aggregation &aggregation, llvm::Value *ht_ptr);
+
+    // The callback
+    void ProcessEntry(CodeGen &codegen, const std::vector<codegen::Value> &keys,
+                      llvm::Value *values) const override;
+
+   private:
+    // The hash table
+    const OAHashTable &hash_table_;
+    // The guy that handles the computation of the aggregates
+    const Aggregation &aggregation_;
+    // The pointer to the main hash table instance
+    llvm::Value *ht_ptr_;
+  };
+
+  //===--------------------------------------------------------------------===//
+  // The callback used when a group of a worker is found in the main hash table
+  //===--------------------------------------------------------------------===//
+  class MergeProbe : public HashTable::ProbeCallback {
+   public:
+    // Constructor
+    MergeProbe(const Aggregation &aggregation, llvm::Value *worker_vals);
+
+    // The callback
+    void ProcessEntry(CodeGen &codegen, llvm::Value *data_area) const override;
+
+   private:
+    // The guy that handles the computation of the aggregates
+    const Aggregation &aggregation_;
+    // The partial aggregates of the worker
+    llvm::Value *worker_vals_;
+  };
+
+  //===--------------------------------------------------------------------===//
+  // The callback used when a group of a worker isn't in the main hash table
+  //===--------------------------------------------------------------------===//
+  class MergeInsert : public HashTable::InsertCallback {
+   public:
+    // Constructor
+    MergeInsert(const Aggregation &aggregation, llvm::Value *worker_vals);
+
+    // Copy the partial aggregates of the worker into the provided storage
+    void StoreValue(CodeGen &codegen, llvm::Value *data_space) const override;
+
+    llvm::Value *GetValueSize(CodeGen &codegen) const override;
+
+   private:
+    // The guy that handles the computation of the aggregates
+    const Aggregation &aggregation_;
+    // The partial aggregates of the worker
+    llvm::Value *worker_vals_;
+  };
+
   //===--------------------------------------------------------------------===//
   // An aggregate finalizer allows aggregations to delay the finalization of an
   // aggregate in the hash-table to a later time. This is needed when we do
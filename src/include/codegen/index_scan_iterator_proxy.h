@@ -0,0 +1,83 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// index_scan_iterator_proxy.h
+//
+// Identification: src/include/codegen/index_scan_iterator_proxy.h
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "codegen/codegen.h"
+
+namespace peloton {
+namespace codegen {
+
+class IndexScanIteratorProxy {
+ public:
+  // Get the LLVM type for peloton::codegen::utils::IndexScanIterator
+  static llvm::Type *GetType(CodeGen &codegen);
+
+  //===--------------------------------------------------------------------===//
+  // The proxy for codegen::utils::IndexScanIterator::Init()
+  //===--------------------------------------------------------------------===//
+  struct _Init {
+    static const std::string &GetFunctionName();
+    static llvm::Function *GetFunction(CodeGen &codegen);
+  };
+
+  //===--------------------------------------------------------------------===//
+  // The proxy for codegen::utils::IndexScanIterator::GetKeyValues()
+  //===--------------------------------------------------------------------===//
+  struct _GetKeyValues {
+    static const std::string &GetFunctionName();
+    static llvm::Function *GetFunction(CodeGen &codegen);
+  };
+
+  //===--------------------------------------------------------------------===//
+  // The proxy for codegen::utils::IndexScanIterator::BindKeyValues()
+  //===--------------------------------------------------------------------===//
+  struct _BindKeyValues {
+    static const std::string &GetFunctionName();
+    static llvm::Function *GetFunction(CodeGen &codegen);
+  };
+
+  //===--------------------------------------------------------------------===//
+  // The proxy for codegen::utils::IndexScanIterator::Scan()
+  //===--------------------------------------------------------------------===//
+  struct _Scan {
+    static const std::string &GetFunctionName();
+    static llvm::Function *GetFunction(CodeGen &codegen);
+  };
+
+  //===--------------------------------------------------------------------===//
+  // The proxy for codegen::utils::IndexScanIterator::GetTileGroup()
+  //===--------------------------------------------------------------------===//
+  struct _GetTileGroup {
+    static const std::string &GetFunctionName();
+    static llvm::Function *GetFunction(CodeGen &codegen);
+  };
+
+  //===--------------------------------------------------------------------===//
+  // The proxy for codegen::utils::IndexScanIterator::GetTuples()
+  //===--------------------------------------------------------------------===//
+  struct _GetTuples {
+    static const std::string &GetFunctionName();
+    static llvm::Function *GetFunction(CodeGen &codegen);
+  };
+
+  //===--------------------------------------------------------------------===//
+  // The proxy for codegen::utils::IndexScanIterator::Destroy()
+  //===--------------------------------------------------------------------===//
+  struct _Destroy {
+    static const std::string &GetFunctionName();
+    static llvm::Function *GetFunction(CodeGen &codegen);
+  };
+};
+
+}  // namespace codegen
+}  // namespace peloton
@@ -0,0 +1,122 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// index_scan_translator.h
+//
+// Identification: src/include/codegen/index_scan_translator.h
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "codegen/compilation_context.h"
+#include "codegen/consumer_context.h"
+#include "codegen/operator_translator.h"
+#include "codegen/tile_group.h"
+
+namespace peloton {
+
+namespace planner {
+class IndexScanPlan;
+}  // namespace planner
+
+namespace storage {
+class DataTable;
+}  // namespace storage
+
+namespace codegen {
+
+//===----------------------------------------------------------------------===//
+// A translator for index scans. The lookup itself is done by a runtime
+// utils::IndexScanIterator, which hands the tuples it found back to the
+// generated code in batches of TIDs in the same tile group. The generated code
+// reads the tuples straight out of the tile groups, like a table scan does.
+//
+// When the scan is the inner side of an index nested-loop join, the join sets
+// the scan's keys through BindKeyValues() before every Produce().
+//===----------------------------------------------------------------------===//
+class IndexScanTranslator : public OperatorTranslator {
+ public:
+  // Constructor
+  IndexScanTranslator(const planner::IndexScanPlan &scan,
+                      CompilationContext &context, Pipeline &pipeline);
+
+  // Construct the runtime iterator
+  void InitializeState() override;
+
+  // Index scans don't rely on any auxiliary functions
+  void DefineAuxiliaryFunctions() override {}
+
+  // The method that produces new tuples
+  void Produce() const override;
+
+  // Scans are leaves in the query plan and, hence, do not consume tuples
+  void Consume(ConsumerContext &, RowBatch &) const override {}
+  void Consume(ConsumerContext &, RowBatch::Row &) const override {}
+
+  // Destroy the runtime iterator
+  void TearDownState() override;
+
+  // Get a stringified version of this translator
+  std::string GetName() const override;
+
+  // Generate code that replaces the values of the given key columns of the
+  // scan (i.e., positions in the plan's key column IDs) with the given values
+  void BindKeyValues(CodeGen &codegen, const std::vector<uint32_t> &key_indexes,
+                     const std::vector<codegen::Value> &values) const;
+
+ private:
+  //===--------------------------------------------------------------------===//
+  // An attribute accessor that uses the backing tile group to access columns
+  //===--------------------------------------------------------------------===//
+  class AttributeAccess : public RowBatch::AttributeAccess {
+   public:
+    // Constructor
+    AttributeAccess(const TileGroup::TileGroupAccess &access,
+                    const planner::AttributeInfo *ai);
+
+    // Access an attribute in the given row
+    codegen::Value Access(CodeGen &codegen, RowBatch::Row &row) override;
+
+    const planner::AttributeInfo *GetAttributeRef() const { return ai_; }
+
+   private:
+    // The accessor we use to load column values
+    const TileGroup::TileGroupAccess &tile_group_access_;
+    // The attribute we will access
+    const planner::AttributeInfo *ai_;
+  };
+
+  // Filter the rows in the selection vector by the scan's predicate
+  void FilterRowsByPredicate(CodeGen &codegen,
+                             const TileGroup::TileGroupAccess &access,
+                             Vector &selection_vector) const;
+
+  // Plan accessor
+  const planner::IndexScanPlan &GetScanPlan() const { return scan_; }
+
+  // Table accessor
+  const storage::DataTable &GetTable() const;
+
+ private:
+  // The scan
+  const planner::IndexScanPlan &scan_;
+
+  // The ID of the runtime iterator in the runtime state
+  RuntimeState::StateID iterator_id_;
+
+  // The ID of the selection vector in runtime state
+  RuntimeState::StateID selection_vector_id_;
+
+  // The ID of the column layouts of the current tile group in runtime state
+  RuntimeState::StateID column_layouts_id_;
+
+  // The code-generating tile group, with the schema of the whole table
+  codegen::TileGroup tile_group_;
+};
+
+}  // namespace codegen
+}  // namespace peloton
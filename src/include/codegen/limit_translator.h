@@ -0,0 +1,73 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// limit_translator.h
+//
+// Identification: src/include/codegen/limit_translator.h
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "codegen/compilation_context.h"
+#include "codegen/consumer_context.h"
+#include "codegen/operator_translator.h"
+
+namespace peloton {
+
+namespace planner {
+class LimitPlan;
+}  // namespace planner
+
+namespace codegen {
+
+//===----------------------------------------------------------------------===//
+// The translator for a limit operator. The limit is pipelined with its child:
+// it counts the rows that reach it and only passes on the ones between the
+// offset and the limit. The scan feeding the pipeline stops once the limit is
+// reached.
+//===----------------------------------------------------------------------===//
+class LimitTranslator : public OperatorTranslator {
+ public:
+  // Constructor
+  LimitTranslator(const planner::LimitPlan &plan, CompilationContext &context,
+                  Pipeline &pipeline);
+
+  // Reset the counter of rows seen
+  void InitializeState() override;
+
+  // Limits don't rely on any auxiliary functions
+  void DefineAuxiliaryFunctions() override {}
+
+  // The method that produces new tuples
+  void Produce() const override;
+
+  // The method that consumes tuples from child operators
+  void Consume(ConsumerContext &context, RowBatch::Row &row) const override;
+
+  // The counter doesn't need cleaning up
+  void TearDownState() override {}
+
+  // The pipeline is done once the counter reached the end of the limit
+  llvm::Value *IsDone() const override;
+
+  // Get a stringified version of this translator
+  std::string GetName() const override;
+
+ private:
+  // Plan accessor
+  const planner::LimitPlan &GetPlan() const { return plan_; }
+
+ private:
+  // The limit plan
+  const planner::LimitPlan &plan_;
+
+  // The ID of the number of rows seen so far in the runtime state
+  RuntimeState::StateID count_id_;
+};
+
+}  // namespace codegen
+}  // namespace peloton
@@ -0,0 +1,135 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// merge_join_translator.h
+//
+// Identification: src/include/codegen/merge_join_translator.h
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "codegen/compilation_context.h"
+#include "codegen/consumer_context.h"
+#include "codegen/operator_translator.h"
+#include "codegen/sorter.h"
+
+namespace peloton {
+
+namespace planner {
+class MergeJoinPlan;
+}  // namespace planner
+
+namespace codegen {
+
+//===----------------------------------------------------------------------===//
+// The translator for a merge join. Like the interpreted merge join, it expects
+// both inputs to arrive sorted in ascending order of the join clauses. Both
+// sides are buffered, then merged in a single pass. Every left row is matched
+// with the run of right rows with equal keys, which is sent to the parent as a
+// batch.
+//
+// Only inner joins are supported.
+//===----------------------------------------------------------------------===//
+class MergeJoinTranslator : public OperatorTranslator {
+ public:
+  // Constructor
+  MergeJoinTranslator(const planner::MergeJoinPlan &join,
+                      CompilationContext &context, Pipeline &pipeline);
+
+  // Codegen any initialization work for this operator
+  void InitializeState() override;
+
+  // Define any helper functions this translator needs
+  void DefineAuxiliaryFunctions() override {}
+
+  // The method that produces new tuples
+  void Produce() const override;
+
+  // The method that consumes tuples from child operators
+  void Consume(ConsumerContext &context, RowBatch::Row &row) const override;
+
+  // Codegen any cleanup work for this translator
+  void TearDownState() override;
+
+  std::string GetName() const override;
+
+ private:
+  //===--------------------------------------------------------------------===//
+  // An attribute accessor for the rows of a buffered side of the join
+  //===--------------------------------------------------------------------===//
+  class BufferAttributeAccess : public RowBatch::AttributeAccess {
+   public:
+    BufferAttributeAccess(Sorter::SorterAccess &buffer_access,
+                          uint32_t col_index);
+
+    // Access the column in the buffered row with the row's TID
+    Value Access(CodeGen &codegen, RowBatch::Row &row) override;
+
+   private:
+    Sorter::SorterAccess &buffer_access_;
+    uint32_t col_index_;
+  };
+
+  //===--------------------------------------------------------------------===//
+  // An attribute accessor that returns the same value for every row. All the
+  // rows of a batch share the left row they are joined with.
+  //===--------------------------------------------------------------------===//
+  class ConstantAttributeAccess : public RowBatch::AttributeAccess {
+   public:
+    explicit ConstantAttributeAccess(const codegen::Value &value);
+
+    Value Access(CodeGen &, RowBatch::Row &) override { return value_; }
+
+   private:
+    codegen::Value value_;
+  };
+
+  // Compare the left keys to the keys of the right row with the given index,
+  // returning a negative, zero or positive integer
+  llvm::Value *CompareKeys(CodeGen &codegen,
+                           const std::vector<codegen::Value> &left_keys,
+                           llvm::Value *right_idx) const;
+
+  // Move forward from the given right row while the right rows have keys that
+  // are less than (or equal to, if equal is set) the left keys. Returns the
+  // index of the first right row where that's no longer true.
+  llvm::Value *AdvanceRight(CodeGen &codegen,
+                            const std::vector<codegen::Value> &left_keys,
+                            llvm::Value *num_right, llvm::Value *right_idx,
+                            bool equal) const;
+
+  // Send the right rows in [start, end) joined with the left values up
+  void ProduceMatches(CodeGen &codegen,
+                      const std::vector<codegen::Value> &left_vals,
+                      llvm::Value *start, llvm::Value *end) const;
+
+  const planner::MergeJoinPlan &GetJoinPlan() const { return join_; }
+
+ private:
+  // The merge join plan node
+  const planner::MergeJoinPlan &join_;
+
+  // The pipelines of the left and right sides
+  Pipeline left_pipeline_;
+  Pipeline right_pipeline_;
+
+  // The number of join clauses. The buffered rows of either side start with
+  // the values of their side of every clause.
+  uint32_t num_keys_;
+
+  // The buffers of both sides, and their IDs in the runtime state
+  RuntimeState::StateID left_buffer_id_;
+  RuntimeState::StateID right_buffer_id_;
+  Sorter left_buffer_;
+  Sorter right_buffer_;
+
+  // The ID of the selection vector in the runtime state
+  RuntimeState::StateID selection_vector_id_;
+};
+
+}  // namespace codegen
+}  // namespace peloton
@@ -0,0 +1,109 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// nested_loop_join_translator.h
+//
+// Identification: src/include/codegen/nested_loop_join_translator.h
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "codegen/compilation_context.h"
+#include "codegen/consumer_context.h"
+#include "codegen/operator_translator.h"
+#include "codegen/sorter.h"
+
+namespace peloton {
+
+namespace planner {
+class NestedLoopJoinPlan;
+}  // namespace planner
+
+namespace codegen {
+
+class IndexScanTranslator;
+
+//===----------------------------------------------------------------------===//
+// The translator for a nested-loop join. There are two flavours:
+//
+// 1. If the right (inner) side is an index scan on the join columns, this is
+//    an index nested-loop join. Every left tuple binds its join values to the
+//    keys of the index scan, which is then produced inside the left pipeline.
+// 2. Otherwise, the left side is buffered first. Every tuple coming from the
+//    right side is then joined with every buffered left tuple.
+//
+// Only inner joins are supported.
+//===----------------------------------------------------------------------===//
+class NestedLoopJoinTranslator : public OperatorTranslator {
+ public:
+  // Constructor
+  NestedLoopJoinTranslator(const planner::NestedLoopJoinPlan &join,
+                           CompilationContext &context, Pipeline &pipeline);
+
+  // Codegen any initialization work for this operator
+  void InitializeState() override;
+
+  // Define any helper functions this translator needs
+  void DefineAuxiliaryFunctions() override {}
+
+  // The method that produces new tuples
+  void Produce() const override;
+
+  // The method that consumes tuples from child operators
+  void Consume(ConsumerContext &context, RowBatch::Row &row) const override;
+
+  // Codegen any cleanup work for this translator
+  void TearDownState() override;
+
+  std::string GetName() const override;
+
+ private:
+  // Consume the given row from the left/outer or the right/inner side
+  void ConsumeFromLeft(ConsumerContext &context, RowBatch::Row &row) const;
+  void ConsumeFromRight(ConsumerContext &context, RowBatch::Row &row) const;
+
+  bool IsFromLeftChild(ConsumerContext &context) const {
+    return context.GetPipeline().GetChild() == left_pipeline_.GetChild();
+  }
+
+  // Is this an index nested-loop join?
+  bool IsIndexJoin() const { return index_scan_ != nullptr; }
+
+  // Put the left values into the right row, and send it to the parent if the
+  // pair of rows joins
+  void JoinRows(ConsumerContext &context, RowBatch::Row &row,
+                const std::vector<codegen::Value> &left_vals,
+                bool check_join_columns) const;
+
+  const planner::NestedLoopJoinPlan &GetJoinPlan() const { return join_; }
+
+ private:
+  // The nested-loop join plan node
+  const planner::NestedLoopJoinPlan &join_;
+
+  // The pipeline of the left side
+  Pipeline left_pipeline_;
+
+  // The (unique) set of left-side attributes the join needs. The attributes of
+  // the left join columns come first.
+  std::vector<const planner::AttributeInfo *> left_ais_;
+
+  // The translator of the inner index scan, and the positions of the join
+  // columns in the scan's keys, if this is an index nested-loop join
+  const IndexScanTranslator *index_scan_;
+  std::vector<uint32_t> key_indexes_;
+
+  // The values of the left row currently driving the inner index scan
+  mutable std::vector<codegen::Value> left_vals_;
+
+  // The ID of the buffer of left tuples in the runtime state, and its format
+  RuntimeState::StateID buffer_id_;
+  Sorter buffer_;
+};
+
+}  // namespace codegen
+}  // namespace peloton
@@ -34,6 +34,12 @@ class ConsumerContext;
 // external state should be initialized in InitializeState() and cleaned up in
 // TearDownState().
 //
+// Operators at the end of a parallel pipeline keep thread-local state for each
+// worker. The worker's copy of the state is set up in InitializeWorkerState(),
+// merged into the main state in MergeWorkerState() and cleaned up in
+// TearDownWorkerState(). Operators that don't keep thread-local state can
+// ignore these.
+//
 // Translators are also allowed to declare helper functions. These functions
 // must be defined and implemented in the DefineAuxiliaryFunctions() method, which is
 // guaranteed to be called on all operators before any other method.
@@ -62,6 +68,22 @@ class OperatorTranslator {
   // Codegen any cleanup work for this translator
   virtual void TearDownState() = 0;
 
+  // Codegen the initialization of a parallel worker's private state. The
+  // runtime state of the function is the worker's copy of the state.
+  virtual void InitializeWorkerState() const {}
+
+  // Codegen the merging of the given worker's state into the main state. The
+  // runtime state of the function is the main state.
+  virtual void MergeWorkerState(llvm::Value *) const {}
+
+  // Codegen any cleanup work of a parallel worker's private state
+  virtual void TearDownWorkerState() const {}
+
+  // Codegen a check of whether the operator needs no more rows from its
+  // pipeline. The source of the pipeline stops producing rows once it is
+  // true. Returns nullptr if the operator takes all of its input.
+  virtual llvm::Value *IsDone() const { return nullptr; }
+
   virtual std::string GetName() const = 0;
 
  protected:
@@ -40,6 +40,11 @@ class OrderByTranslator : public OperatorTranslator {
 
   void TearDownState() override;
 
+  // Parallel workers append tuples into sorters of their own
+  void InitializeWorkerState() const override;
+  void MergeWorkerState(llvm::Value *worker_state) const override;
+  void TearDownWorkerState() const override;
+
   std::string GetName() const override;
 
  private:
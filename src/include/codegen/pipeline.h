@@ -12,13 +12,19 @@
 
 #pragma once
 
+#include <atomic>
 #include <stdint.h>
 #include <string>
 #include <vector>
 
+namespace llvm {
+class Value;
+}  // namespace llvm
+
 namespace peloton {
 namespace codegen {
 
+class CodeGen;
 class OperatorTranslator;
 class CompilationContext;
 class ConsumerContext;
@@ -28,9 +34,20 @@ class ConsumerContext;
 // Peloton pipelines are decomposed further into stages. Operators in a
 // stage are fully pipelined/fused together, while whole stages communicate
 // through cache-resident vectors of TIDs.
+//
+// Pipelines are serial by default. The operator at the end of a pipeline (i.e.,
+// the pipeline breaker) can allow it to be run in parallel if it is able to
+// keep thread-local state for every worker and merge that state when all the
+// workers are done, unless an operator in the pipeline needs it to be serial.
+// The source of the pipeline then decides how to split its input across the
+// workers.
 //===----------------------------------------------------------------------===//
 class Pipeline {
  public:
+  // Global/configurable variable controlling the number of threads parallel
+  // pipelines are compiled to run with. A value of one disables parallelism.
+  static std::atomic<uint32_t> kDegreeOfParallelism;
+
   // Constructor
   Pipeline();
   Pipeline(const OperatorTranslator *translator);
@@ -52,6 +69,30 @@ class Pipeline {
   uint32_t GetNumStages() const;
   uint32_t GetTranslatorStage(const OperatorTranslator *translator) const;
 
+  // Allow the operators in this pipeline to be executed by multiple threads
+  void SetParallel();
+
+  // Force the operators in this pipeline to be executed by a single thread. An
+  // operator whose results depend on seeing all of its input in one place
+  // calls this, whatever the pipeline breaker allows.
+  void SetSerial();
+
+  // Should code for this pipeline be generated to run in parallel?
+  bool IsParallel() const;
+
+  // Get the number of threads a parallel pipeline will run with
+  uint32_t GetDegreeOfParallelism() const;
+
+  // Codegen a check of whether the operators in this pipeline need no more
+  // rows from its source, e.g. a limit that has seen enough. Returns nullptr
+  // if they take all of the rows.
+  llvm::Value *IsDone(CodeGen &codegen) const;
+
+  // All the operators in this pipeline, from the last to the first
+  const std::vector<const OperatorTranslator *> &GetTranslators() const {
+    return pipeline_;
+  }
+
   // Get a stringified version of this pipeline
   std::string GetInfo() const;
 
@@ -66,6 +107,12 @@ class Pipeline {
   // A value, i, in this list means there is a stage boundary between operators
   // i-1 and i in the pipeline.
   std::vector<uint32_t> stage_boundaries_;
+
+  // Has the pipeline breaker allowed this pipeline to run in parallel?
+  bool parallel_;
+
+  // Has an operator in this pipeline forced it to run serially?
+  bool serial_;
 };
 
 }  // namespace codegen
@@ -0,0 +1,129 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// plan_fingerprint.h
+//
+// Identification: src/include/codegen/plan_fingerprint.h
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "common/macros.h"
+#include "type/types.h"
+#include "type/value.h"
+
+namespace peloton {
+
+namespace catalog {
+class Schema;
+}  // namespace catalog
+
+namespace expression {
+class AbstractExpression;
+class ConstantValueExpression;
+}  // namespace expression
+
+namespace planner {
+class AbstractPlan;
+class ProjectInfo;
+}  // namespace planner
+
+namespace codegen {
+
+//===----------------------------------------------------------------------===//
+// A structural fingerprint of a query plan. Two plans have the same key if
+// they only differ in the values of their constants, which means the code
+// compiled for one of them can be executed for the other. To make that work,
+// constants are not compiled into the code when the query is compiled with a
+// fingerprint. Instead, every constant gets a slot in a parameter buffer that
+// is filled from the plan being executed and handed to the query at runtime.
+//
+// Every parameter takes one 8-byte slot, except VARCHAR constants which take
+// two (a pointer to the characters followed by the length).
+//
+// Only the plan nodes and expressions the code generator supports are
+// understood; plans containing anything else are not cacheable.
+//===----------------------------------------------------------------------===//
+class PlanFingerprint {
+ public:
+  // Fingerprint the given plan, whose results are produced into the given
+  // output columns
+  PlanFingerprint(const planner::AbstractPlan &plan,
+                  const std::vector<oid_t> &output_columns);
+
+  // Can compiled code for this plan be shared with other plans?
+  bool IsCacheable() const { return cacheable_; }
+
+  // The key of the plan's structure
+  const std::string &GetKey() const { return key_; }
+
+  // The tables the plan reads
+  const std::vector<oid_t> &GetTableOids() const { return table_oids_; }
+
+  // Find the parameter slot holding the value of the given constant. Returns
+  // false if the constant is not a parameter and must be compiled in.
+  bool GetParameterSlot(const expression::ConstantValueExpression &constant,
+                        uint32_t &slot) const;
+
+  // The parameter buffer holding the values of this plan's constants
+  const char *GetParameterStorage() const {
+    return reinterpret_cast<const char *>(parameter_storage_.data());
+  }
+
+ private:
+  // Append the raw bytes of a value to the key
+  template <typename T>
+  void Append(const T &val) {
+    key_.append(reinterpret_cast<const char *>(&val), sizeof(T));
+  }
+
+  void AddPlan(const planner::AbstractPlan &plan);
+
+  void AddExpression(const expression::AbstractExpression *exp);
+
+  void AddParameter(const expression::ConstantValueExpression &constant);
+
+  void AddProjectInfo(const planner::ProjectInfo *project_info);
+
+  void AddSchema(const catalog::Schema *schema);
+
+  void AddColumnIds(const std::vector<oid_t> &column_ids);
+
+  // Fill the parameter buffer once all constants have been collected
+  void BuildParameterStorage();
+
+ private:
+  // Whether everything in the plan was understood
+  bool cacheable_;
+
+  // The key of the plan's structure
+  std::string key_;
+
+  // The tables the plan reads
+  std::vector<oid_t> table_oids_;
+
+  // The values of the constants, in the order they are found in the plan
+  std::vector<type::Value> parameters_;
+
+  // The slot of every constant that was turned into a parameter
+  std::unordered_map<const expression::ConstantValueExpression *, uint32_t>
+      parameter_slots_;
+
+  // The parameter buffer. VARCHAR parameters point into parameters_.
+  std::vector<uint64_t> parameter_storage_;
+
+ private:
+  // The parameter buffer points into this object
+  DISALLOW_COPY_AND_MOVE(PlanFingerprint);
+};
+
+}  // namespace codegen
+}  // namespace peloton
@@ -21,10 +21,6 @@ namespace concurrency {
 class Transaction;
 }  // namespace concurrency
 
-namespace planner {
-class AbstractPlan;
-}  // namespace planner
-
 namespace codegen {
 
 //===----------------------------------------------------------------------===//
@@ -50,12 +46,13 @@ class Query {
   bool Prepare(const QueryFunctions &funcs);
 
   // Execute th e query given the catalog manager and runtime/consumer state
-  // that is passed along to the query execution code.
+  // that is passed along to the query execution code. Queries compiled for a
+  // plan fingerprint also need the parameter buffer of the plan to execute.
+  // Execution does not modify the query, so a compiled query can be executed
+  // by several threads at once.
   void Execute(concurrency::Transaction &txn, char *consumer_arg,
-               RuntimeStats *stats = nullptr);
-
-  // Return the query plan
-  const planner::AbstractPlan &GetPlan() const { return query_plan_; }
+               RuntimeStats *stats = nullptr,
+               const char *parameters = nullptr);
 
   // Get the holder of the code
   CodeContext &GetCodeContext() { return code_context_; }
@@ -66,19 +63,20 @@ class Query {
  private:
   friend class QueryCompiler;
 
-  // Constructor
-  Query(const planner::AbstractPlan &query_plan);
+  // Constructor. The query does not keep the plan it is compiled from, a
+  // cached query outlives that plan.
+  Query();
 
  private:
-  // The query plan
-  const planner::AbstractPlan &query_plan_;
-
   // The code context where the compiled code for the query goes
   CodeContext code_context_;
 
   // The size of the parameter the functions take
   RuntimeState runtime_state_;
 
+  // The size of the runtime state, computed once the query is prepared
+  uint64_t runtime_state_size_;
+
   // The init(), plan() and tearDown() functions
   typedef void (*compiled_function_t)(char *);
   compiled_function_t init_func_;
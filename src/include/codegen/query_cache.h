@@ -0,0 +1,119 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// query_cache.h
+//
+// Identification: src/include/codegen/query_cache.h
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "common/macros.h"
+#include "type/types.h"
+
+namespace peloton {
+namespace codegen {
+
+class PlanFingerprint;
+class Query;
+
+//===----------------------------------------------------------------------===//
+// A process-wide cache of compiled queries, keyed by the structural fingerprint
+// of the plan they were compiled for. Queries must have been compiled with
+// their fingerprint (so that constants are read from the parameter buffer) and
+// for a BufferingConsumer producing the fingerprint's output columns.
+//
+// The cache keeps the least recently used queries out once the total size of
+// their machine code exceeds the budget set by the codegen_cache_size flag.
+// Queries reading a table are dropped when the table or its indexes change.
+//===----------------------------------------------------------------------===//
+class QueryCache {
+ public:
+  // Global singleton
+  static QueryCache &GetInstance();
+
+  // Find the compiled query for the given fingerprint. Returns nullptr if it
+  // isn't cached.
+  std::shared_ptr<Query> Find(const PlanFingerprint &fingerprint);
+
+  // Add a query compiled for the given fingerprint, along with the time it
+  // took to compile it
+  void Insert(const PlanFingerprint &fingerprint,
+              const std::shared_ptr<Query> &query, double compile_ms);
+
+  // Drop all queries that read the given table
+  void InvalidateTable(oid_t table_oid);
+
+  // Drop all queries
+  void Clear();
+
+  //===--------------------------------------------------------------------===//
+  // ACCESSORS
+  //===--------------------------------------------------------------------===//
+
+  // The number of cached queries
+  size_t GetCount() const;
+
+  // The total size of the machine code of all cached queries
+  uint64_t GetCodeSize() const;
+
+  // The maximum size of the machine code of all cached queries
+  uint64_t GetCodeSizeBudget() const;
+
+  // Change the code size budget, evicting queries if needed. A budget of zero
+  // disables the cache.
+  void SetCodeSizeBudget(uint64_t budget);
+
+ private:
+  struct Entry {
+    std::string key;
+    std::shared_ptr<Query> query;
+    std::vector<oid_t> table_oids;
+    uint64_t code_size;
+    double compile_ms;
+  };
+
+  typedef std::list<Entry>::iterator EntryIterator;
+
+  QueryCache();
+
+  // Remove the given entry. The cache latch must be held.
+  void Remove(EntryIterator iter);
+
+  // Evict least recently used entries until the code size fits the budget.
+  // The cache latch must be held.
+  void EvictToBudget();
+
+ private:
+  // Protects everything below
+  mutable std::mutex latch_;
+
+  // The cached queries, most recently used first
+  std::list<Entry> entries_;
+
+  // The entries by key
+  std::unordered_map<std::string, EntryIterator> index_;
+
+  // The total code size of the cached queries
+  uint64_t code_size_;
+
+  // The maximum total code size of the cached queries
+  uint64_t code_size_budget_;
+
+ private:
+  DISALLOW_COPY_AND_MOVE(QueryCache);
+};
+
+}  // namespace codegen
+}  // namespace peloton
@@ -26,6 +26,8 @@ class AbstractPlan;
 
 namespace codegen {
 
+class PlanFingerprint;
+
 // The primary interface to JIT compile queries
 class QueryCompiler {
  public:
@@ -44,6 +46,9 @@ class QueryCompiler {
 
     // The time taken to perform JIT compilation
     double jit_ms = 0.0;
+
+    // The total time taken to compile the query
+    double TotalMs() const { return setup_ms + ir_gen_ms + jit_ms; }
   };
 
   // Constructor
@@ -52,10 +57,13 @@ class QueryCompiler {
   // Compile the provided query, returning the compiled plan that can be invoked
   // to return results. Callers can also pass in an (optional) CompileStats
   // object pointer if they want to collect statistics on the compilation
-  // process.
+  // process. If a fingerprint of the plan is provided, the compiled query reads
+  // the plan's constants from the fingerprint's parameter buffer and can be
+  // executed for any plan with the same fingerprint key.
   std::unique_ptr<Query> Compile(const planner::AbstractPlan &query_plan,
                                  QueryResultConsumer &consumer,
-                                 CompileStats *stats = nullptr);
+                                 CompileStats *stats = nullptr,
+                                 const PlanFingerprint *fingerprint = nullptr);
 
   // Get the next available query plan ID
   uint64_t NextId() { return next_id_++; }
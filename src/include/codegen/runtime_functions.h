@@ -18,6 +18,10 @@
 
 namespace peloton {
 
+namespace concurrency {
+class Transaction;
+}  // namespace concurrency
+
 namespace storage {
 class DataTable;
 class TileGroup;
@@ -50,16 +54,46 @@ class RuntimeFunctions {
   // doing strided accesses to mimic columnar storage.  In a pure row-store,
   // the stride is equivalent to the size of the tuple. In a pure column-store
   // (without compression), the stride is equivalent to the size of data type.
+  // The integer columns of compressed tile groups are packed instead: their
+  // values are the base plus the offsets of the given bits stored in the
+  // words at 'column', see storage::PackedColumn. The bits of other columns
+  // are zero.
   struct ColumnLayoutInfo {
     char *column;
     uint32_t stride;
     bool is_columnar;
+    uint32_t packed_bits;
+    int64_t packed_base;
   };
 
   // Get the column configuration for every column in the tile group
   static void GetTileGroupLayout(const storage::TileGroup *tile_group,
                                  ColumnLayoutInfo *infos, uint32_t num_cols);
 
+  // The signatures of the functions generated for a parallel table scan. The
+  // scan function scans the tile groups in the range [begin, end) of the table
+  // using the given runtime state. The others set up, merge and clean up the
+  // private state of a worker.
+  typedef void (*ScanMorselFunction)(char *state, storage::DataTable *table,
+                                     uint64_t tile_group_begin,
+                                     uint64_t tile_group_end);
+  typedef void (*WorkerStateFunction)(char *worker_state);
+  typedef void (*MergeWorkerStateFunction)(char *state, char *worker_state);
+
+  // Scan the table using the given number of threads. Every tile group of the
+  // table forms one morsel; workers grab morsels until none are left. Every
+  // worker runs on a private copy of the provided runtime state, which is
+  // merged back into the runtime state once all workers are done. All workers
+  // read on behalf of the given transaction.
+  static void ExecuteParallelScan(char *state, uint64_t state_size,
+                                  storage::DataTable *table,
+                                  concurrency::Transaction *txn,
+                                  uint32_t num_threads,
+                                  ScanMorselFunction scan_func,
+                                  WorkerStateFunction init_func,
+                                  MergeWorkerStateFunction merge_func,
+                                  WorkerStateFunction tear_down_func);
+
   static void ThrowDivideByZeroException();
 
   static void ThrowOverflowException();
@@ -45,6 +45,12 @@ class RuntimeFunctionsProxy {
     static llvm::Function *GetFunction(CodeGen &codegen);
   };
 
+  struct _ExecuteParallelScan {
+    // Get the LLVM function definition/wrapper to
+    // RuntimeFunctions::ExecuteParallelScan()
+    static llvm::Function *GetFunction(CodeGen &codegen);
+  };
+
   struct _ThrowDivideByZeroException {
     // Get the LLVM function definition/wrapper to our
     // ThrowDivideByZeroException() function
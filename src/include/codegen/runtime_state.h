@@ -35,6 +35,11 @@ namespace codegen {
 // Local state is guaranteed to be allocated once at the start of the plan()
 // function. All access to _any_ query state must go through this class.
 //
+// When a pipeline runs in parallel, every worker operates on its own private
+// copy of the runtime state, and the worker function allocates its own local
+// state. Operators that keep per-worker state reset it in their worker copy
+// and merge it back into the main runtime state when the workers are done.
+//
 // For note, the reason we construct a single struct type as the only function
 // argument to generated query functions is:
 //
@@ -61,6 +66,11 @@ class RuntimeState {
   llvm::Value *LoadStatePtr(CodeGen &codegen,
                             RuntimeState::StateID state_id) const;
 
+  // Get the pointer to the state with the given ID in the provided instance of
+  // the runtime state (e.g., the private copy of a parallel worker)
+  llvm::Value *LoadStatePtr(CodeGen &codegen, RuntimeState::StateID state_id,
+                            llvm::Value *runtime_state) const;
+
   // Get the actual value of the state information with the given ID
   llvm::Value *LoadStateValue(CodeGen &codegen,
                               RuntimeState::StateID state_id) const;
@@ -71,6 +81,12 @@ class RuntimeState {
   // Create/initialize all registered state that is stack-local
   void CreateLocalState(CodeGen &codegen);
 
+  // Local state lives in the function it was created in. Functions generated
+  // in the middle of another (e.g., the worker function of a parallel scan)
+  // create their own local state, and restore the previous values when done.
+  std::vector<llvm::Value *> SaveLocalState() const;
+  void RestoreLocalState(const std::vector<llvm::Value *> &saved);
+
  private:
   // Little struct to track information of elements in the runtime state
   struct StateInfo {
@@ -44,6 +44,10 @@ class ScanConsumer {
   // Callback for when iteration over the given tile group has completed
   virtual void TileGroupFinish(CodeGen &codegen,
                                llvm::Value *tile_group_ptr) = 0;
+
+  // Codegen a check of whether the consumer needs no more tuples, the scan
+  // ends once it is true. Returns nullptr if it takes all of them.
+  virtual llvm::Value *IsDone(CodeGen &) { return nullptr; }
 };
 
 }  // namespace codegen
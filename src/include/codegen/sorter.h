@@ -95,7 +95,8 @@ class Sorter {
   Sorter();
   Sorter(CodeGen &codegen, const std::vector<type::Type::TypeId> &row_desc);
 
-  // Initialize the given sorter instance with the comparison function
+  // Initialize the given sorter instance with the comparison function. A sorter
+  // initialized without a comparison function can only buffer tuples.
   void Init(CodeGen &codegen, llvm::Value *sorter_ptr,
             llvm::Value *comparison_func) const;
 
@@ -103,6 +104,10 @@ class Sorter {
   void Append(CodeGen &codegen, llvm::Value *sorter_ptr,
               const std::vector<codegen::Value> &tuple) const;
 
+  // Move all the tuples of the other sorter instance into the given one
+  void TransferFrom(CodeGen &codegen, llvm::Value *sorter_ptr,
+                    llvm::Value *other_sorter_ptr) const;
+
   // Sort all the data that has been inserted into the sorter instance
   void Sort(CodeGen &codegen, llvm::Value *sorter_ptr) const;
 
@@ -120,6 +125,9 @@ class Sorter {
   llvm::Value *GetNumberOfStoredTuples(CodeGen &codegen,
                                        llvm::Value *sorter_ptr) const;
 
+  // Get random access to the tuples stored in the given sorter instance
+  SorterAccess GetAccess(CodeGen &codegen, llvm::Value *sorter_ptr) const;
+
  private:
   //===--------------------------------------------------------------------===//
   // SORTER INSTANCE ACCESSORS
@@ -38,6 +38,14 @@ class SorterProxy {
     static llvm::Function *GetFunction(CodeGen &codegen);
   };
 
+  //===--------------------------------------------------------------------===//
+  // The proxy for codegen::utils::Sorter::TransferFrom()
+  //===--------------------------------------------------------------------===//
+  struct _TransferFrom {
+    static const std::string &GetFunctionName();
+    static llvm::Function *GetFunction(CodeGen &codegen);
+  };
+
   //===--------------------------------------------------------------------===//
   // The proxy for codegen::utils::Sorter::Sort()
   //===--------------------------------------------------------------------===//
@@ -46,6 +46,13 @@ class Table {
                               uint32_t vector_size,
                               ScanConsumer &consumer) const;
 
+  // Generate a vectorized scan over the tile groups of the table whose
+  // indexes are in the range [tile_group_begin, tile_group_end)
+  void GenerateVectorizedScan(CodeGen &codegen, llvm::Value *table_ptr,
+                              llvm::Value *tile_group_begin,
+                              llvm::Value *tile_group_end, uint32_t vector_size,
+                              ScanConsumer &consumer) const;
+
   // Given a table instance, return the number of tile groups in the table.
   llvm::Value *GetTileGroupCount(CodeGen &codegen,
                                  llvm::Value *table_ptr) const;
@@ -57,7 +64,9 @@ class Table {
 
  private:
   void DoGenerateScan(CodeGen &codegen, llvm::Value *table_ptr,
-                      uint32_t vector_size, ScanConsumer &consumer) const;
+                      llvm::Value *tile_group_begin,
+                      llvm::Value *tile_group_end, uint32_t vector_size,
+                      ScanConsumer &consumer) const;
 
  private:
   // The table associated with this generator
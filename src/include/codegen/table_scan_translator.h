@@ -101,6 +101,11 @@ class TableScanTranslator : public OperatorTranslator {
     // The callback when finishing iteration over a tile group
     void TileGroupFinish(CodeGen &, llvm::Value *) override {}
 
+    // The scan ends once the pipeline needs no more tuples
+    llvm::Value *IsDone(CodeGen &codegen) override {
+      return translator_.GetPipeline().IsDone(codegen);
+    }
+
    private:
     // Get the predicate, if one exists
     const expression::AbstractExpression *GetPredicate() const;
@@ -120,8 +125,14 @@ class TableScanTranslator : public OperatorTranslator {
                                llvm::Value *tid_start, llvm::Value *tid_end,
                                Vector &selection_vector) const;
 
-    llvm::Value *SIMDFilterRows(RowBatch &batch,
-                                const TileGroup::TileGroupAccess &access) const;
+    // Filter the rows in the selection vector by a single conjunct of the
+    // predicate, using the vectorized filter kernels of the runtime. This only
+    // works for comparisons between a fixed-width column and a constant. If the
+    // conjunct is anything else, no code is generated and false is returned.
+    bool SIMDFilterRows(CodeGen &codegen, RowBatch &batch,
+                        const TileGroup::TileGroupAccess &access,
+                        const expression::AbstractExpression &conjunct,
+                        Vector &selection_vector) const;
 
    private:
     // The translator instance the consumer is generating code for
@@ -134,6 +145,10 @@ class TableScanTranslator : public OperatorTranslator {
     llvm::Value *tile_group_ptr_;
   };
 
+  // Generate the functions that run the scan in parallel, and the call into
+  // the runtime that executes them
+  void ProduceParallel(llvm::Value *table_ptr) const;
+
   // Plan accessor
   const planner::SeqScanPlan &GetScanPlan() const { return scan_; }
 
@@ -56,6 +56,9 @@ class TileGroup {
     llvm::Value *col_start_ptr;
     llvm::Value *col_stride;
     llvm::Value *is_columnar;
+    // the bits and the base of a packed column, the bits are zero otherwise
+    llvm::Value *packed_bits;
+    llvm::Value *packed_base;
   };
 
   /*
@@ -150,6 +153,11 @@ class TileGroup {
     std::vector<ColumnLayout> layout_;
   };
 
+  // Get access to the columns of the provided tile group. The column layouts
+  // must point to space for the layout information of every column.
+  TileGroupAccess GetAccess(CodeGen &codegen, llvm::Value *tile_group_ptr,
+                            llvm::Value *column_layouts) const;
+
  private:
   // The schema for all tile groups. Each tile group may have a different
   // configuration of tiles (that each have a different schema), but at this
@@ -0,0 +1,138 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// index_scan_iterator.h
+//
+// Identification: src/include/codegen/utils/index_scan_iterator.h
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "common/item_pointer.h"
+#include "index/scan_optimizer.h"
+#include "type/types.h"
+#include "type/value.h"
+
+namespace peloton {
+
+namespace concurrency {
+class Transaction;
+}  // namespace concurrency
+
+namespace index {
+class Index;
+}  // namespace index
+
+namespace planner {
+class IndexScanPlan;
+}  // namespace planner
+
+namespace storage {
+class TileGroup;
+}  // namespace storage
+
+namespace codegen {
+namespace utils {
+
+//===----------------------------------------------------------------------===//
+// The runtime half of a compiled index scan. Generated code asks the iterator
+// to look up the index, which collects the visible versions of all the tuples
+// that satisfy the scan's key conditions, in index order. The tuples are then
+// handed out in batches whose TIDs all belong to the same tile group, so that
+// the generated code can access them through the tile group's column layout.
+//
+// Instances live in the query's runtime state, which is raw memory. Init()
+// constructs the iterator in place and Destroy() releases everything it holds.
+//===----------------------------------------------------------------------===//
+class IndexScanIterator {
+ public:
+  // Construct the iterator for the given plan
+  void Init(const planner::IndexScanPlan &plan);
+
+  // The array of type::Value the index is looked up with, one per key column
+  // of the plan. Index nested-loop joins overwrite these with the join values
+  // of every outer tuple.
+  char *GetKeyValues();
+
+  // Rebuild the low and high keys of the lookup from the key values
+  void BindKeyValues();
+
+  // Look up the index, and return the number of batches of tuples found. The
+  // batches have at most max_batch_size tuples each. If the transaction can't
+  // read one of the tuples, it is failed and no batches are returned.
+  uint32_t Scan(concurrency::Transaction &txn, uint32_t max_batch_size);
+
+  // The tile group all tuples of the given batch belong to
+  storage::TileGroup *GetTileGroup(uint32_t batch_idx) const;
+
+  // Write the TIDs of the tuples in the given batch into the selection vector,
+  // returning the number of tuples in the batch
+  uint32_t GetTuples(uint32_t batch_idx, uint32_t *selection_vector) const;
+
+  // Release all the resources the iterator holds
+  void Destroy();
+
+ private:
+  // A run of tuples in the same tile group
+  struct Batch {
+    std::shared_ptr<storage::TileGroup> tile_group;
+    uint32_t start;
+    uint32_t end;
+  };
+
+  // Only Init() constructs iterators
+  IndexScanIterator(const planner::IndexScanPlan &plan);
+
+  // Collect the visible version of the tuple at the given location, if it
+  // has one. Returns false if the transaction had to be failed.
+  bool CollectVisibleVersion(concurrency::Transaction &txn,
+                             ItemPointer tuple_location,
+                             std::vector<ItemPointer> &visible_locations) const;
+
+  // Drop the tuples whose keys are outside the range of the scan. The index
+  // can return more than the scan asked for for open ranges, or if it doesn't
+  // keep its keys in order.
+  void CheckOpenRanges(std::vector<ItemPointer> &tuple_locations) const;
+
+  // Check the key conditions of the scan against the tuple at the location
+  bool CheckKeyConditions(const ItemPointer &tuple_location) const;
+
+ private:
+  // The index we scan and its predicate
+  std::shared_ptr<index::Index> index_;
+  index::IndexScanPredicate index_predicate_;
+
+  // The key conditions of the scan
+  std::vector<oid_t> key_column_ids_;
+  std::vector<ExpressionType> expr_types_;
+  std::vector<type::Value> values_;
+
+  // Do the tuples have to be checked against the keys at either end?
+  bool left_open_;
+  bool right_open_;
+
+  // The limit pushed down into the scan
+  bool limit_;
+  uint64_t limit_number_;
+  uint64_t limit_offset_;
+  bool descend_;
+
+  // Is the scan part of an update?
+  bool acquire_owner_;
+
+  // The TIDs of the last lookup, and the batches they are split into
+  std::vector<uint32_t> tids_;
+  std::vector<Batch> batches_;
+};
+
+}  // namespace utils
+}  // namespace codegen
+}  // namespace peloton
@@ -58,6 +58,10 @@ class Sorter {
   // provided at initialization time.
   char *StoreInputTuple();
 
+  // Move all the tuples stored in the other sorter to the end of this one. The
+  // other sorter's resources are released.
+  void TransferFrom(Sorter &other);
+
   // Perform the sort
   void Sort();
 
@@ -47,6 +47,24 @@ struct ItemPointer {
 
 extern ItemPointer INVALID_ITEMPOINTER;
 
+// a garbage version of a transaction
+struct GCEntry {
+  GCEntry(const ItemPointer &location, const bool delete_from_indexes,
+          const uint64_t shared_varlen_columns = 0)
+      : location(location),
+        delete_from_indexes(delete_from_indexes),
+        shared_varlen_columns(shared_varlen_columns) {}
+
+  ItemPointer location;
+
+  // whether the tuple has to be deleted from the indexes
+  bool delete_from_indexes;
+
+  // the varlen columns whose data is owned by another version, one bit per
+  // column id. the garbage collector must not free them.
+  uint64_t shared_varlen_columns;
+};
+
 class ItemPointerComparator {
  public:
   bool operator()(ItemPointer *const &p1, ItemPointer *const &p2) const {
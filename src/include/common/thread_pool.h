@@ -4,7 +4,7 @@
 //
 // thread_pool.h
 //
-// Identification: src/include/common/worker_thread_pool.h
+// Identification: src/include/common/thread_pool.h
 //
 // Copyright (c) 2015-16, Carnegie Mellon University Database Group
 //
@@ -13,73 +13,148 @@
 
 #pragma once
 
-#include <vector>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
 #include <thread>
-
-#include <boost/asio/io_service.hpp>
-#include <boost/thread/thread.hpp>
-#include <boost/bind.hpp>
-#include <boost/function.hpp>
+#include <type_traits>
+#include <vector>
 
 #include "common/macros.h"
+#include "common/platform.h"
+#include "type/types.h"
 
 namespace peloton {
-// a wrapper for boost worker thread pool.
+
+//===--------------------------------------------------------------------===//
+// A work-stealing thread pool.
+//
+// Every worker owns one deque of tasks per priority. Tasks submitted from a
+// worker go to that worker's deques, and tasks submitted from any other
+// thread are spread over the workers round-robin. A worker runs its own
+// tasks first, highest priority first: the newest task it spawned, or else
+// the oldest task submitted from outside the pool, so requests run in the
+// order they arrive. When those are empty it steals the oldest task of
+// another worker. Idle workers sleep until a task is submitted.
+//
+// Some workers can be reserved for HIGH priority tasks, so that short tasks
+// never wait behind long ones when all the other workers are busy.
+//
+// Long running tasks (e.g., the GC and epoch threads) should be submitted as
+// dedicated tasks, which get a thread of their own instead of blocking a
+// worker.
+//===--------------------------------------------------------------------===//
 class ThreadPool {
  public:
-  ThreadPool() : pool_size_(0), 
-                 dedicated_thread_count_(0),
-                 work_(io_service_) { }
+  ThreadPool()
+      : pool_size_(0), dedicated_thread_count_(0), reserved_worker_count_(0) {}
 
-  ~ThreadPool() { }
+  ~ThreadPool() { StopWorkers(); }
 
-  void Initialize(const size_t &pool_size, const size_t &dedicated_thread_count) {
-    current_thread_count_ = ATOMIC_VAR_INIT(0);
-    pool_size_ = pool_size;
-    // PL_ASSERT(pool_size_ != 0);
+  // Start 'pool_size' workers, and make room for 'dedicated_thread_count'
+  // dedicated threads. If 'pin_threads' is set, worker i is pinned to core
+  // (i % number of cores). 'reserved_worker_count' of the workers only run
+  // HIGH priority tasks, there must be other workers for the rest.
+  void Initialize(const size_t &pool_size,
+                  const size_t &dedicated_thread_count,
+                  const bool pin_threads = false,
+                  const size_t &reserved_worker_count = 0);
 
-    dedicated_thread_count_ = dedicated_thread_count;
+  // Join the dedicated threads, run the tasks still queued and stop the
+  // workers
+  void Shutdown();
 
-    for (size_t i = 0; i < pool_size_; ++i) {
-      // add thread to thread pool.
-      thread_pool_.create_thread(
-          boost::bind(&boost::asio::io_service::run, &io_service_));
-    }
-
-    dedicated_threads_.resize(dedicated_thread_count_);
+  // submit task to thread pool.
+  // it accepts a function and a set of function parameters as parameters.
+  template <typename FunctionType, typename... ParamTypes>
+  void SubmitTask(FunctionType &&func, ParamTypes &&... params) {
+    Enqueue(TaskPriorityType::NORMAL,
+            std::bind(std::forward<FunctionType>(func),
+                      std::forward<ParamTypes>(params)...));
   }
 
-  void Shutdown() {
-    // always join lastly created threads first.
-    for (size_t i = 0; i < current_thread_count_; ++i) {
-      dedicated_threads_[(current_thread_count_ - 1 - i)]->join();
-    }
-    io_service_.stop();
-    thread_pool_.join_all();
+  // submit task with the given priority to thread pool.
+  template <typename FunctionType, typename... ParamTypes>
+  void SubmitTaskWithPriority(TaskPriorityType priority, FunctionType &&func,
+                              ParamTypes &&... params) {
+    Enqueue(priority, std::bind(std::forward<FunctionType>(func),
+                                std::forward<ParamTypes>(params)...));
   }
 
-  // submit task to thread pool.
-  // it accepts a function and a set of function parameters as parameters.
+  // submit task with the given priority to thread pool.
+  // it returns a future that holds the result of the task.
   template <typename FunctionType, typename... ParamTypes>
-  void SubmitTask(FunctionType &&func, const ParamTypes &&... params) {
-    // add task to thread pool.
-    io_service_.post(std::bind(func, params...));
+  std::future<typename std::result_of<typename std::decay<FunctionType>::type(
+      typename std::decay<ParamTypes>::type...)>::type>
+  SubmitTaskWithResult(TaskPriorityType priority, FunctionType &&func,
+                       ParamTypes &&... params) {
+    typedef typename std::result_of<typename std::decay<FunctionType>::type(
+        typename std::decay<ParamTypes>::type...)>::type ResultType;
+    auto task = std::make_shared<std::packaged_task<ResultType()>>(
+        std::bind(std::forward<FunctionType>(func),
+                  std::forward<ParamTypes>(params)...));
+    auto result = task->get_future();
+    Enqueue(priority, [task]() { (*task)(); });
+    return result;
   }
 
   // submit task to a dedicated thread.
   // it accepts a function and a set of function parameters as parameters.
   template <typename FunctionType, typename... ParamTypes>
-  void SubmitDedicatedTask(FunctionType &&func, const ParamTypes &&... params) {
+  void SubmitDedicatedTask(FunctionType &&func, ParamTypes &&... params) {
     size_t thread_id =
         current_thread_count_.fetch_add(1, std::memory_order_relaxed);
+    PL_ASSERT(thread_id < dedicated_thread_count_);
     // assign task to dedicated thread.
-    dedicated_threads_[thread_id].reset(new std::thread(std::thread(func, params...)));
+    dedicated_threads_[thread_id].reset(
+        new std::thread(std::forward<FunctionType>(func),
+                        std::forward<ParamTypes>(params)...));
   }
 
+  // Get the number of workers (not counting dedicated threads)
+  size_t GetPoolSize() const { return pool_size_; }
+
  private:
   ThreadPool(const ThreadPool &);
   ThreadPool &operator=(const ThreadPool &);
 
+  typedef std::function<void()> Task;
+
+  // One deque per priority, HIGH first
+  static constexpr size_t kNumPriorities = 3;
+
+  struct Worker {
+    // protects the deques
+    Spinlock lock;
+    // tasks spawned by the worker itself
+    std::deque<Task> tasks[kNumPriorities];
+    // tasks submitted from outside the pool
+    std::deque<Task> submitted[kNumPriorities];
+    // whether the worker only runs HIGH priority tasks
+    bool reserved = false;
+    std::thread thread;
+  };
+
+  // Queue a task. If there are no workers, the task runs on the caller.
+  void Enqueue(TaskPriorityType priority, Task &&task);
+
+  // Take a task of the worker's own deques
+  bool PopTask(size_t worker_id, Task &task);
+
+  // Take the oldest task of any other worker's deques
+  bool StealTask(size_t worker_id, Task &task);
+
+  // Count a task of the given priority index as taken
+  void TakeTask(size_t priority);
+
+  void RunWorker(size_t worker_id, bool pin_thread);
+
+  void StopWorkers();
+
  private:
   // number of threads in the thread pool.
   size_t pool_size_;
@@ -87,14 +162,26 @@ class ThreadPool {
   size_t dedicated_thread_count_;
   // current number of dedicated threads.
   std::atomic<size_t> current_thread_count_ = ATOMIC_VAR_INIT(0);
-
-  // real thread pool that holds a set of threads.
-  boost::thread_group thread_pool_;
-  // io_service provides IO functionality of asynchronize services.
-  boost::asio::io_service io_service_;
-  // io_service::work is responsible for starting the io_service processing
-  // loop.
-  boost::asio::io_service::work work_;
+  // number of workers reserved for HIGH priority tasks, they come last.
+  size_t reserved_worker_count_;
+
+  std::vector<std::unique_ptr<Worker>> workers_;
+
+  // number of tasks queued but not taken by a worker yet
+  std::atomic<size_t> pending_task_count_ = ATOMIC_VAR_INIT(0);
+  // number of HIGH priority tasks among them
+  std::atomic<size_t> pending_high_task_count_ = ATOMIC_VAR_INIT(0);
+  // worker the next task from outside the pool goes to
+  std::atomic<size_t> next_worker_ = ATOMIC_VAR_INIT(0);
+
+  // idle workers wait on this
+  std::mutex idle_mutex_;
+  std::condition_variable idle_cv_;
+  std::atomic<size_t> idle_worker_count_ = ATOMIC_VAR_INIT(0);
+  // idle reserved workers wait on this
+  std::condition_variable reserved_idle_cv_;
+  std::atomic<size_t> idle_reserved_worker_count_ = ATOMIC_VAR_INIT(0);
+  std::atomic<bool> is_running_ = ATOMIC_VAR_INIT(false);
 
   std::vector<std::unique_ptr<std::thread>> dedicated_threads_;
 };
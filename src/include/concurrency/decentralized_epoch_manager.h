@@ -13,6 +13,8 @@
 
 #pragma once
 
+#include <atomic>
+#include <memory>
 #include <thread>
 #include <vector>
 
@@ -22,6 +24,7 @@
 #include "common/platform.h"
 #include "common/init.h"
 #include "common/thread_pool.h"
+#include "container/lock_free_array.h"
 #include "concurrency/epoch_manager.h"
 #include "concurrency/local_epoch.h"
 
@@ -33,6 +36,7 @@ class DecentralizedEpochManager : public EpochManager {
 
 public:
   DecentralizedEpochManager() : 
+    local_epoch_count_(0),
     current_global_epoch_(1), 
     next_txn_id_(0),
     current_global_epoch_ro_(1),
@@ -69,21 +73,9 @@ public:
     this->is_running_ = false;
   }
 
-  virtual void RegisterThread(const size_t thread_id) override {
-    local_epoch_lock_.Lock();
+  virtual void RegisterThread(const size_t thread_id) override;
 
-    local_epochs_[thread_id].reset(new LocalEpoch(thread_id));
-
-    local_epoch_lock_.Unlock();
-  }
-
-  virtual void DeregisterThread(const size_t thread_id) override {
-    local_epoch_lock_.Lock();
-
-    local_epochs_.erase(thread_id);
-
-    local_epoch_lock_.Unlock();
-  }
+  virtual void DeregisterThread(const size_t thread_id) override;
 
   // a transaction enters epoch with thread id
   virtual cid_t EnterEpoch(const size_t thread_id) override;
@@ -93,6 +85,13 @@ public:
 
   virtual void ExitEpoch(const size_t thread_id, const cid_t begin_cid) override;
 
+  virtual cid_t GetCurrentEpochCommitId() override {
+    return (GetCurrentGlobalEpoch() << 32) | GetNextTransactionId();
+  }
+
+  virtual cid_t GetCurrentEpochStartCid() override {
+    return GetCurrentGlobalEpoch() << 32;
+  }
 
   virtual cid_t GetMaxCommittedCid() override {
     uint64_t max_committed_eid = GetMaxCommittedEpochId();
@@ -111,6 +110,12 @@ private:
     return current_global_epoch_.load();
   }
 
+  inline LocalEpoch *GetLocalEpoch(const size_t thread_id) {
+    auto local_epoch = local_epochs_.Find(thread_id);
+    PL_ASSERT(local_epoch != nullptr);
+    return local_epoch;
+  }
+
   inline uint32_t GetNextTransactionId() {
     return next_txn_id_.fetch_add(1, std::memory_order_relaxed);
   }
@@ -131,14 +136,23 @@ private:
 
   // each thread holds a pointer to a local epoch.
   // it updates the local epoch to report their local time.
+  // transactions and the garbage collector look the local epochs up without
+  // locking. a local epoch is never freed while the manager is alive, so a
+  // thread that deregisters concurrently leaves a valid, empty one behind.
+  LockFreeArray<LocalEpoch *> local_epochs_;
+
+  // one past the largest thread id ever registered
+  std::atomic<size_t> local_epoch_count_;
+
+  // owns the local epochs, and serializes thread registration
   Spinlock local_epoch_lock_;
-  std::unordered_map<int, std::unique_ptr<LocalEpoch>> local_epochs_;
+  std::vector<std::unique_ptr<LocalEpoch>> local_epoch_storage_;
   
   // the global epoch reflects the true time of the system.
   std::atomic<uint64_t> current_global_epoch_;
   std::atomic<uint32_t> next_txn_id_;
   
-  uint64_t current_global_epoch_ro_;
+  std::atomic<uint64_t> current_global_epoch_ro_;
 
   bool is_running_;
 
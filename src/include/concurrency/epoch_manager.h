@@ -49,6 +49,14 @@ public:
 
   virtual void ExitEpoch(const size_t thread_id, const cid_t begin_cid) = 0;
 
+  // get a fresh commit id in the current epoch, for transactions that do not
+  // commit with their begin commit id (e.g., snapshot isolation).
+  virtual cid_t GetCurrentEpochCommitId() = 0;
+
+  // get the smallest commit id of the current epoch. unlike
+  // GetCurrentEpochCommitId(), it does not take a transaction id.
+  virtual cid_t GetCurrentEpochStartCid() = 0;
+
   virtual cid_t GetMaxCommittedCid() = 0;
 
   virtual uint64_t GetMaxCommittedEpochId() = 0;
@@ -13,62 +13,77 @@
 
 #pragma once
 
-#include <thread>
-#include <queue>
-#include <vector>
-#include <unordered_map>
-#include <functional>
+#include <array>
+#include <atomic>
 #include <cstdint>
-
-#include "common/platform.h"
+#include <cstddef>
 
 namespace peloton {
 namespace concurrency {
 
-struct Epoch {
-  Epoch(const uint64_t epoch_id, const size_t txn_count):
-    epoch_id_(epoch_id),
-    txn_count_(txn_count) {}
-
-  Epoch(const Epoch& epoch) {
-    this->epoch_id_ = epoch.epoch_id_;
-    this->txn_count_ = epoch.txn_count_;
-  }
-
-  uint64_t epoch_id_;
-  size_t txn_count_;
-};
-
-struct EpochCompare {
-  bool operator()(const std::shared_ptr<Epoch> &lhs, const std::shared_ptr<Epoch> &rhs) {
-    return lhs->epoch_id_ > rhs->epoch_id_;
-  }
-};
-
+//===--------------------------------------------------------------------===//
+// LocalEpoch
+//
+// The epochs of the transactions running on one thread. Every epoch is
+// counted in a slot of a fixed ring, picked by the epoch id modulo the ring
+// size. A slot packs the epoch id and the number of transactions in a single
+// word, so entering and exiting an epoch is one compare-and-swap, without
+// locks or allocation. When two running epochs map to the same slot, the
+// slot keeps the older one, which only makes the thread look older than it
+// is to the garbage collector.
+//===--------------------------------------------------------------------===//
 class LocalEpoch {
 
 public:
-  LocalEpoch(const size_t thread_id) : 
-    epoch_lower_bound_(UINT64_MAX), 
-    thread_id_(thread_id) {}
+  LocalEpoch(const size_t thread_id) :
+    thread_id_(thread_id) {
+    Reset();
+  }
 
   bool EnterEpoch(const uint64_t epoch_id);
 
   void EnterEpochRO(const uint64_t epoch_id);
 
   void ExitEpoch(const uint64_t epoch_id);
-  
+
   uint64_t GetMaxCommittedEpochId(const uint64_t current_epoch_id);
 
+  // forget all the epochs, the thread must not be in any of them
+  void Reset();
+
+  size_t GetThreadId() const { return thread_id_; }
+
 private:
-  Spinlock epoch_lock_;
-  
-  uint64_t epoch_lower_bound_;
+  // number of slots of the ring
+  static constexpr size_t kEpochRingSize = 64;
+
+  // the low bits of a slot count the transactions, the high bits hold the
+  // epoch id
+  static constexpr size_t kTxnCountBits = 20;
+  static constexpr uint64_t kTxnCountMask = (1ul << kTxnCountBits) - 1;
+
+  static inline uint64_t GetSlotEpochId(const uint64_t slot) {
+    return slot >> kTxnCountBits;
+  }
+
+  static inline uint64_t GetSlotTxnCount(const uint64_t slot) {
+    return slot & kTxnCountMask;
+  }
 
+  inline std::atomic<uint64_t> &GetSlot(const uint64_t epoch_id) {
+    return epoch_ring_[epoch_id % kEpochRingSize];
+  }
+
+  void AddTransaction(const uint64_t epoch_id);
+
+private:
   size_t thread_id_;
-  
-  std::priority_queue<std::shared_ptr<Epoch>, std::vector<std::shared_ptr<Epoch>>, EpochCompare> epoch_queue_;
-  std::unordered_map<uint64_t, std::shared_ptr<Epoch>> epoch_map_;
+
+  // the current epoch seen by the last call of GetMaxCommittedEpochId.
+  // transactions must not enter an epoch older than this one.
+  std::atomic<uint64_t> epoch_guard_;
+
+  std::array<std::atomic<uint64_t>, kEpochRingSize> epoch_ring_;
 };
 
 }
@@ -0,0 +1,96 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// read_write_set.h
+//
+// Identification: src/include/concurrency/read_write_set.h
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "common/item_pointer.h"
+#include "type/types.h"
+
+namespace peloton {
+namespace concurrency {
+
+//===--------------------------------------------------------------------===//
+// ReadWriteSet
+//
+// The tuples a transaction has read or written, and how. The entries are
+// kept in a flat vector in the order they are recorded, and an open
+// addressing table (linear probing) maps a location to its entry. Clearing
+// the set keeps the memory of both, so a transaction object that is reused
+// does not allocate again unless it touches more tuples than before.
+//===--------------------------------------------------------------------===//
+class ReadWriteSet {
+ public:
+  struct Entry {
+    Entry(const ItemPointer &location, RWType type)
+        : location(location), type(type) {}
+
+    ItemPointer location;
+    RWType type;
+  };
+
+  typedef std::vector<Entry>::const_iterator const_iterator;
+
+  ReadWriteSet();
+
+  // Get the type recorded for the location, or nullptr if there is none
+  RWType *Find(const ItemPointer &location);
+
+  // Record a location that is not in the set yet
+  void Insert(const ItemPointer &location, RWType type);
+
+  // Remove all the entries
+  void Clear();
+
+  size_t size() const { return entries_.size(); }
+
+  bool empty() const { return entries_.empty(); }
+
+  const_iterator begin() const { return entries_.begin(); }
+
+  const_iterator end() const { return entries_.end(); }
+
+ private:
+  static constexpr uint32_t kEmptySlot = UINT32_MAX;
+
+  // Number of slots of an empty set
+  static constexpr size_t kInitialSlotCount = 64;
+
+  // Sets that grew larger than this are shrunk back when cleared, so a
+  // single large transaction does not make the following ones pay for
+  // clearing a huge table
+  static constexpr size_t kMaxRetainedSlotCount = 16 * 1024;
+
+  inline size_t GetSlot(const ItemPointer &location) const {
+    uint64_t key = (static_cast<uint64_t>(location.block) << 32) |
+                   static_cast<uint64_t>(location.offset);
+    // Fibonacci hashing, the slot count is a power of two
+    return (key * 11400714819323198485ull) >> (64 - slot_bits_);
+  }
+
+  void Grow();
+
+ private:
+  // The entries, in the order they are recorded
+  std::vector<Entry> entries_;
+
+  // Index of the entry of every slot, or kEmptySlot
+  std::vector<uint32_t> slots_;
+
+  // log2 of the number of slots
+  size_t slot_bits_;
+};
+
+}  // End concurrency namespace
+}  // End peloton namespace
@@ -13,6 +13,8 @@
 
 #pragma once
 
+#include <atomic>
+
 #include "concurrency/transaction_manager.h"
 #include "storage/tile_group.h"
 #include "statistics/stats_aggregator.h"
@@ -22,11 +24,33 @@ namespace concurrency {
 
 //===--------------------------------------------------------------------===//
 // timestamp ordering
+//
+// The isolation level configured in the TransactionManagerFactory is taken by
+// every transaction when it begins:
+//
+// FULL: every read sets the last reader commit id of the tuple and is recorded
+// in the read-write set. A transaction can not own a tuple that has been read
+// by a younger transaction. Transactions commit with their begin commit id.
+//
+// REPEATABLE_READ: like FULL, the tuples read can not be overwritten by older
+// transactions, but the reads are not recorded in the read-write set.
+//
+// SNAPSHOT: reads neither touch the tuple nor the read-write set. A
+// transaction can only own the latest version of a tuple, so the first
+// transaction that commits a new version wins and the others abort when they
+// try to write it. Writers get a fresh commit id when they commit and announce
+// it in a commit slot until all their versions are installed. A transaction
+// that takes a snapshot (the begin commit id) waits for the writers announced
+// with a smaller commit id, so a snapshot never sees part of a commit.
 //===--------------------------------------------------------------------===//
 
 class TimestampOrderingTransactionManager : public TransactionManager {
  public:
-  TimestampOrderingTransactionManager() {}
+  TimestampOrderingTransactionManager() {
+    for (auto &commit_slot : commit_slots_) {
+      commit_slot = MAX_CID;
+    }
+  }
 
   virtual ~TimestampOrderingTransactionManager() {}
 
@@ -42,6 +66,11 @@ class TimestampOrderingTransactionManager : public TransactionManager {
       const storage::TileGroupHeader *const tile_group_header,
       const oid_t &tuple_id);
 
+  virtual void GetVisibleTuples(
+      Transaction *const current_txn,
+      const storage::TileGroupHeader *const tile_group_header,
+      const oid_t tuple_count, std::vector<oid_t> &visible_tuples);
+
   // This method test whether the current transaction is the owner of a tuple.
   virtual bool IsOwner(Transaction *const current_txn,
                        const storage::TileGroupHeader *const tile_group_header,
@@ -128,6 +157,24 @@ private:
   void InitTupleReserved(
       const storage::TileGroupHeader *const tile_group_header,
       const oid_t tuple_id);
+
+
+ private:
+  // Take a commit slot and get the commit id of a SNAPSHOT writer
+  size_t EnterSnapshotCommit(const size_t thread_id, cid_t &end_commit_id);
+
+  // Release the commit slot once all the versions are installed
+  void ExitSnapshotCommit(const size_t commit_slot);
+
+  // Wait for the SNAPSHOT writers that commit before the snapshot
+  void WaitForSnapshotCommits(const cid_t snapshot_cid);
+
+  static const size_t COMMIT_SLOT_COUNT = 64;
+
+  // The commit ids of the SNAPSHOT writers installing their versions. A free
+  // slot holds MAX_CID, a slot whose writer is getting its commit id holds
+  // INVALID_CID.
+  std::atomic<cid_t> commit_slots_[COMMIT_SLOT_COUNT];
 };
 }
 }
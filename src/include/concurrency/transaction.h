@@ -20,7 +20,9 @@
 
 #include "common/exception.h"
 #include "common/item_pointer.h"
+#include "common/platform.h"
 #include "common/printable.h"
+#include "concurrency/read_write_set.h"
 #include "type/types.h"
 
 namespace peloton {
@@ -36,31 +38,42 @@ class Transaction : public Printable {
  public:
   
   Transaction() { 
-    Init(INVALID_CID, 0, false); 
+    Init(INVALID_CID, 0, false, IsolationLevelType::FULL); 
   }
 
-  Transaction(const cid_t &begin_cid, const size_t thread_id, bool ro = false) {
-    Init(begin_cid, thread_id, ro);
+  Transaction(const cid_t &begin_cid, const size_t thread_id, bool ro = false,
+              IsolationLevelType isolation_level = IsolationLevelType::FULL) {
+    Init(begin_cid, thread_id, ro, isolation_level);
   }
 
   ~Transaction() {}
 
- private:
-
-  void Init(const cid_t &begin_cid, const size_t thread_id, const bool readonly) {
+  // Reset the transaction so that the object can be reused for a new one.
+  // The read-write set keeps its memory.
+  void Init(const cid_t &begin_cid, const size_t thread_id, const bool readonly,
+            const IsolationLevelType isolation_level) {
     txn_id_ = begin_cid;
     begin_cid_ = begin_cid;
     thread_id_ = thread_id;
     
     declared_readonly_ = readonly;
+    isolation_level_ = isolation_level;
 
     end_cid_ = MAX_CID;
     is_written_ = false;
     insert_count_ = 0;
-    gc_set_.reset(new GCSet());
+    parallel_reads_ = false;
+    result_ = ResultType::SUCCESS;
+    rw_set_.Clear();
+    // the gc manager may still hold the last gc set, so only reuse it when
+    // nobody else does
+    if (gc_set_ == nullptr || gc_set_.use_count() != 1) {
+      gc_set_.reset(new GCSet());
+    } else {
+      gc_set_->clear();
+    }
   }
 
-
  public:
   //===--------------------------------------------------------------------===//
   // Mutators and Accessors
@@ -76,6 +89,13 @@ class Transaction : public Printable {
 
   inline void SetEndCommitId(cid_t eid) { end_cid_ = eid; }
 
+  // Set while multiple threads read on behalf of this transaction (e.g., the
+  // workers of a parallel scan), so that recording a read latches the
+  // read-write set
+  inline void SetParallelReads(bool parallel_reads) {
+    parallel_reads_ = parallel_reads;
+  }
+
   void RecordRead(const ItemPointer &);
 
   void RecordReadOwn(const ItemPointer &);
@@ -95,7 +115,7 @@ class Transaction : public Printable {
     return gc_set_;
   }
 
-  inline bool IsGCSetEmpty() { return gc_set_->size() == 0; }
+  inline bool IsGCSetEmpty() { return gc_set_->empty(); }
 
   // Get a string representation for debugging
   const std::string GetInfo() const;
@@ -112,6 +132,10 @@ class Transaction : public Printable {
 
   inline bool IsDeclaredReadOnly() const { return declared_readonly_; }
 
+  inline IsolationLevelType GetIsolationLevel() const {
+    return isolation_level_;
+  }
+
 
  private:
   //===--------------------------------------------------------------------===//
@@ -142,6 +166,15 @@ class Transaction : public Printable {
   size_t insert_count_;
 
   bool declared_readonly_;
+
+  IsolationLevelType isolation_level_;
+
+  // whether multiple threads currently read on behalf of this transaction
+  bool parallel_reads_;
+
+  // Protects the read-write set while a read is recorded by one of the threads
+  // reading in parallel
+  Spinlock read_latch_;
 };
 
 }  // End concurrency namespace
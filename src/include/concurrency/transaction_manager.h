@@ -69,6 +69,20 @@ class TransactionManager {
       const storage::TileGroupHeader *const tile_group_header,
       const oid_t &tuple_id) = 0;
 
+  // This method collects the ids of all the tuples in the range
+  // [0, tuple_count) of a tile group that are visible to the transaction.
+  virtual void GetVisibleTuples(
+      Transaction *const current_txn,
+      const storage::TileGroupHeader *const tile_group_header,
+      const oid_t tuple_count, std::vector<oid_t> &visible_tuples) {
+    for (oid_t tuple_id = 0; tuple_id < tuple_count; tuple_id++) {
+      if (IsVisible(current_txn, tile_group_header, tuple_id) ==
+          VisibilityType::OK) {
+        visible_tuples.push_back(tuple_id);
+      }
+    }
+  }
+
   // This method test whether the current transaction is the owner of a tuple.
   virtual bool IsOwner(
       Transaction *const current_txn, 
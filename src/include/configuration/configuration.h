@@ -31,6 +31,9 @@ DECLARE_uint64(max_connections);
 // Socket family
 DECLARE_string(socket_family);
 
+// Policy to spread new connections over the worker threads
+DECLARE_string(connection_dispatch);
+
 //===----------------------------------------------------------------------===//
 // RESOURCE USAGE
 //===----------------------------------------------------------------------===//
@@ -67,12 +70,31 @@ DECLARE_bool(index_tuner);
 // Enable or disable layout tuner
 DECLARE_bool(layout_tuner);
 
+// Compress the tile groups frozen by the layout tuner
+DECLARE_bool(compress_frozen_tile_groups);
+
 //===----------------------------------------------------------------------===//
 // CODEGEN
 //===----------------------------------------------------------------------===//
 
 DECLARE_bool(codegen);
 
+// Code size budget of the compiled query cache
+DECLARE_uint64(codegen_cache_size);
+
+//===----------------------------------------------------------------------===//
+// EXECUTION
+//===----------------------------------------------------------------------===//
+
+// Evaluate scans in the interpreted executors a tile group at a time
+DECLARE_bool(vectorized_execution);
+
+// Share the unmodified varlen columns between the versions of a tuple
+DECLARE_bool(shared_version_columns);
+
+// Run the statements on the thread pool instead of the network threads
+DECLARE_bool(execution_pool);
+
 //===----------------------------------------------------------------------===//
 // GENERAL
 //===----------------------------------------------------------------------===//
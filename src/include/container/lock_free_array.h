@@ -22,14 +22,20 @@
 
 namespace peloton {
 
-#define LOCK_FREE_ARRAY_MAX_SIZE 1024 * 1024
-
 // LOCK_FREE_ARRAY_TEMPLATE_ARGUMENTS
 #define LOCK_FREE_ARRAY_TEMPLATE_ARGUMENTS template <typename ValueType>
 
 // LOCK_FREE_ARRAY_TYPE
 #define LOCK_FREE_ARRAY_TYPE LockFreeArray<ValueType>
 
+//===--------------------------------------------------------------------===//
+// A growable array with lock-free append and constant time lookup.
+//
+// The entries are stored in segments that are allocated on first write.
+// Segment k holds (64 << k) entries, so the array doubles its capacity with
+// every new segment, and an entry never moves once it is written. Reads of
+// entries whose segment does not exist yet return a default value.
+//===--------------------------------------------------------------------===//
 LOCK_FREE_ARRAY_TEMPLATE_ARGUMENTS
 class LockFreeArray {
  public:
@@ -61,18 +67,40 @@ class LockFreeArray {
   // Clear all elements and reset them to default value
   void Clear(const ValueType& invalid_value);
 
-  // Exists ?
+  // Exists ? (linear in the number of appended items)
   bool Contains(const ValueType& value);
 
+  // Returns the number of bytes allocated for the segments
+  size_t GetMemoryFootprint() const;
+
  private:
 
-  // lock free array type
-  typedef std::array<ValueType, LOCK_FREE_ARRAY_MAX_SIZE> lock_free_array_t;
+  // log2 of the size of the first segment
+  static constexpr std::size_t kFirstSegmentBits = 6;
+
+  // enough segments for 2^32 entries
+  static constexpr std::size_t kMaxSegmentCount = 27;
+
+  // Get the segment of an entry, and the position of the entry in it
+  static inline void Locate(const std::size_t &offset, std::size_t &segment,
+                            std::size_t &position) {
+    std::size_t index = offset + (1ul << kFirstSegmentBits);
+    std::size_t top_bit = 63 - __builtin_clzl(index);
+    segment = top_bit - kFirstSegmentBits;
+    position = index - (1ul << top_bit);
+  }
+
+  static inline std::size_t GetSegmentSize(const std::size_t &segment) {
+    return 1ul << (segment + kFirstSegmentBits);
+  }
+
+  // Get the segment, allocating it if it does not exist yet
+  ValueType *GetOrAllocateSegment(const std::size_t &segment);
 
   std::atomic<std::size_t> lock_free_array_offset {0};
 
-  // lock free array
-  std::unique_ptr<lock_free_array_t> lock_free_array;
+  // the segments, nullptr until their first entry is written
+  std::array<std::atomic<ValueType *>, kMaxSegmentCount> segments_;
 };
 
 }  // namespace peloton
@@ -47,6 +47,11 @@ class LockFreeQueue {
     return queue_.try_dequeue(item);
   }
 
+  // Dequeues up to max_count items into items, returning how many were found
+  size_t DequeueBulk(T* items, const size_t &max_count) {
+    return queue_.try_dequeue_bulk(items, max_count);
+  }
+
   bool IsEmpty() {
     return queue_.size_approx() == 0;
   }
@@ -46,6 +46,10 @@ class AbstractScanExecutor : public AbstractExecutor {
 
   virtual bool DExecute() = 0;
 
+  // Report the number of versions visited to find the visible version of a
+  // tuple, to the stats and the garbage collector
+  void VersionChainTraversed(size_t chain_length);
+
  protected:
   //===--------------------------------------------------------------------===//
   // Plan Info
@@ -59,7 +59,8 @@ class IndexScanExecutor : public AbstractScanExecutor {
   // When the required scan range has open boundaries, the tuples found by the
   // index might not be exact since the index can only give back tuples in a
   // close range. This function prune the head and the tail of the returned
-  // tuple list to get the correct result.
+  // tuple list to get the correct result. Hash indexes have no order, so
+  // all tuples they return for a non-point query are checked instead.
   void CheckOpenRangeWithReturnedTuples(
       std::vector<ItemPointer> &tuple_locations);
 
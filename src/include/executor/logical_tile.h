@@ -29,6 +29,7 @@ class Schema;
 }
 
 namespace storage {
+class PackedColumn;
 class Tile;
 class TileGroup;
 }
@@ -94,6 +95,10 @@ class LogicalTile : public Printable {
 
   const ColumnInfo &GetColumnInfo(const oid_t column_id) const;
 
+  struct ColumnChunk;
+
+  ColumnChunk GetColumnChunk(const oid_t column_id) const;
+
   catalog::Schema *GetPhysicalSchema() const;
 
   void SetSchema(std::vector<LogicalTile::ColumnInfo> &&schema);
@@ -175,6 +180,35 @@ class LogicalTile : public Printable {
     oid_t origin_column_id;
   };
 
+  //===--------------------------------------------------------------------===//
+  // Column Chunk
+  //===--------------------------------------------------------------------===//
+
+  /**
+   * @brief A view of the raw values of one inlined column of the logical tile,
+   * for evaluating expressions over many tuples at once.
+   *
+   * The value of the tuple with id tuple_id starts at
+   * data + positions[tuple_id] * stride, unless the position is NULL_OID.
+   * The values of a packed column are read from the packed column instead.
+   */
+  struct ColumnChunk {
+    /** @brief The value of the first tuple of the base tile. */
+    const char *data;
+
+    /** @brief The distance between the values of two tuples. */
+    size_t stride;
+
+    /** @brief The position list of the column. */
+    const PositionList *positions;
+
+    /** @brief The type of the values. */
+    type::Type::TypeId type;
+
+    /** @brief The packed column, if the base tile is packed. */
+    const storage::PackedColumn *packed;
+  };
+
   //===--------------------------------------------------------------------===//
   // Position Lists Builder
   //===--------------------------------------------------------------------===//
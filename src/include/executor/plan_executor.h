@@ -14,6 +14,7 @@
 
 #include "common/statement.h"
 #include "executor/abstract_executor.h"
+#include "executor/result_sink.h"
 #include "type/types.h"
 #include "concurrency/transaction_manager_factory.h"
 
@@ -73,6 +74,15 @@ class PlanExecutor {
                                     std::vector<StatementResult> &result,
                                     const std::vector<int> &result_format);
 
+  /*
+   * @brief Execute the plan and push the output rows into the sink as they
+   * are produced, instead of materializing them
+   */
+  static ExecuteResult ExecutePlan(const planner::AbstractPlan *plan,
+                                   concurrency::Transaction *txn,
+                                   const std::vector<type::Value> &params,
+                                   ResultSink &sink);
+
   /*
    * @brief When a peloton node recvs a query plan, this function is invoked
    * @param plan and params
@@ -0,0 +1,73 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// result_sink.h
+//
+// Identification: src/include/executor/result_sink.h
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <vector>
+
+#include "common/statement.h"
+#include "type/value.h"
+
+namespace peloton {
+namespace executor {
+
+//===----------------------------------------------------------------------===//
+// Result Sink
+//
+// Receives the output rows of a query while the executors produce them, so
+// that they can be sent to the client without materializing the whole result.
+//===----------------------------------------------------------------------===//
+class ResultSink {
+ public:
+  virtual ~ResultSink() {}
+
+  // Called for every output row, in order. The values only live during the
+  // call.
+  virtual void AddRow(const type::Value *values, uint32_t num_values) = 0;
+
+  // The format a column of the given Postgres type is sent in when the client
+  // asks for the given one. Only the types SerializeValue() has a binary
+  // encoding for are sent in binary (1), all the others in text (0).
+  static int GetResultFormat(oid_t field_type, int format);
+
+  // Append a value in the text (0) or binary (1) format of the wire
+  // protocol, as a value of the Postgres type the column is described as. A
+  // NULL value is serialized as no bytes. Throws if the value can't be
+  // represented in the binary format of the type.
+  static void SerializeValue(const type::Value &value, oid_t field_type,
+                             int format, std::vector<unsigned char> &output);
+
+  // Same as above, for a column described as the type of the value
+  static void SerializeValue(const type::Value &value, int format,
+                             std::vector<unsigned char> &output);
+};
+
+//===----------------------------------------------------------------------===//
+// A sink that materializes the rows, one StatementResult per value
+//===----------------------------------------------------------------------===//
+class BufferingResultSink : public ResultSink {
+ public:
+  BufferingResultSink(const std::vector<int> &result_format,
+                      std::vector<StatementResult> &result)
+      : result_format_(result_format), result_(result) {}
+
+  void AddRow(const type::Value *values, uint32_t num_values) override;
+
+ private:
+  // The format of each column
+  const std::vector<int> &result_format_;
+
+  std::vector<StatementResult> &result_;
+};
+
+}  // namespace executor
+}  // namespace peloton
@@ -50,6 +50,16 @@ class SeqScanExecutor : public AbstractScanExecutor {
   expression::AbstractExpression *ColumnValueToCmpExpr(
       const oid_t column_id, const type::Value &value);
 
+  // Invalidate the tuples of the logical tile that don't satisfy the
+  // predicate, evaluating it over all the tuples at once
+  void FilterTileBatch(LogicalTile *tile);
+
+  // Collect the visible tuples of the tile group that satisfy the predicate,
+  // checking visibility and evaluating the predicate over the whole tile
+  // group at once. Returns false if reading one of the tuples fails.
+  bool ScanTileGroupBatch(const std::shared_ptr<storage::TileGroup> &tile_group,
+                          std::vector<oid_t> &position_list);
+
   //===--------------------------------------------------------------------===//
   // Executor State
   //===--------------------------------------------------------------------===//
@@ -66,6 +76,9 @@ class SeqScanExecutor : public AbstractScanExecutor {
 
   bool index_done_ = false;
 
+  /** @brief Evaluate the scan a tile group (or logical tile) at a time. */
+  bool vectorized_ = false;
+
   /** @brief Pointer to table to scan from. */
   storage::DataTable *target_table_ = nullptr;
 
@@ -39,9 +39,18 @@ class UpdateExecutor : public AbstractExecutor {
 
   bool DExecute();
 
+  // write only the columns of the target list into a version, the other
+  // columns already hold the values of the old version
+  void EvaluateTargetList(const AbstractTuple *old_tuple,
+                          AbstractTuple *new_tuple);
+
  private:
   storage::DataTable *target_table_ = nullptr;
   const planner::ProjectInfo *project_info_ = nullptr;
+
+  // whether the projection keeps every column that it does not compute, so
+  // a new version can be copied from the old one and share its varlen data
+  bool copy_version_ = false;
 };
 
 }  // namespace executor
@@ -30,6 +30,7 @@ enum class ExpressionType;
 
 namespace executor {
 class ExecutorContext;
+class LogicalTile;
 }
 
 namespace planner {
@@ -62,6 +63,14 @@ class AbstractExpression : public Printable {
                                const AbstractTuple *tuple2,
                                executor::ExecutorContext *context) const = 0;
 
+  // Evaluate this expression as a predicate over a batch of tuples of the
+  // given logical tile. The selection vector holds the ids of the tuples to
+  // evaluate in ascending order, and is reduced to the ones the expression is
+  // true for. By default, the tuples are evaluated one at a time.
+  virtual void EvaluateBatch(executor::LogicalTile *tile,
+                             std::vector<oid_t> &selection,
+                             executor::ExecutorContext *context) const;
+
   /**
    * Return true if this expression or any descendent has a value that should be
    * substituted with a parameter.
@@ -71,6 +71,11 @@ class ComparisonExpression : public AbstractExpression {
     }
   }
 
+  // Comparisons of an inlined column with a constant are evaluated directly on
+  // the raw values of the column
+  void EvaluateBatch(executor::LogicalTile *tile, std::vector<oid_t> &selection,
+                     executor::ExecutorContext *context) const override;
+
   AbstractExpression *Copy() const override {
     return new ComparisonExpression(*this);
   }
@@ -57,6 +57,10 @@ class ConjunctionExpression : public AbstractExpression {
     }
   }
 
+  // Each side only evaluates the tuples whose result it can still change
+  void EvaluateBatch(executor::LogicalTile *tile, std::vector<oid_t> &selection,
+                     executor::ExecutorContext *context) const override;
+
   AbstractExpression *Copy() const override {
     return new ConjunctionExpression(*this);
   }
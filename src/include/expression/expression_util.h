@@ -285,6 +285,25 @@ class ExpressionUtil {
     }
   }
 
+  /**
+   * Get the comparison that gives the same result when the operands of the
+   * given comparison are swapped
+   */
+  inline static ExpressionType FlipComparison(ExpressionType comparison) {
+    switch (comparison) {
+      case ExpressionType::COMPARE_LESSTHAN:
+        return ExpressionType::COMPARE_GREATERTHAN;
+      case ExpressionType::COMPARE_LESSTHANOREQUALTO:
+        return ExpressionType::COMPARE_GREATERTHANOREQUALTO;
+      case ExpressionType::COMPARE_GREATERTHAN:
+        return ExpressionType::COMPARE_LESSTHAN;
+      case ExpressionType::COMPARE_GREATERTHANOREQUALTO:
+        return ExpressionType::COMPARE_LESSTHANOREQUALTO;
+      default:
+        return comparison;
+    }
+  }
+
   /**
    * Generate a pretty-printed string representation of the entire
    * Expresssion tree for the given root node
@@ -64,6 +64,17 @@ class GCManager {
     return INVALID_ITEMPOINTER;
   }
 
+  // return up to max_count recycled slots of the table at once
+  virtual size_t ReturnFreeSlots(const oid_t &table_id UNUSED_ATTRIBUTE,
+                                 ItemPointer *locations UNUSED_ATTRIBUTE,
+                                 const size_t &max_count UNUSED_ATTRIBUTE) {
+    return 0;
+  }
+
+  // hand back a recycled slot that can not be used yet
+  virtual void RecycleTupleSlot(const oid_t &table_id UNUSED_ATTRIBUTE,
+                                const ItemPointer &location UNUSED_ATTRIBUTE) {}
+
   virtual void RegisterTable(const oid_t &table_id UNUSED_ATTRIBUTE) {}
 
   virtual void DeregisterTable(const oid_t &table_id UNUSED_ATTRIBUTE) {}
@@ -73,8 +84,17 @@ class GCManager {
   virtual void RecycleTransaction(std::shared_ptr<GCSet> gc_set UNUSED_ATTRIBUTE, 
                                    const cid_t &timestamp UNUSED_ATTRIBUTE) {}
 
+  // Called by a worker after it walked a version chain to find the version
+  // it can see. Long chains are a sign that garbage piles up.
+  virtual void VersionChainTraversed(
+      const size_t &worker_id UNUSED_ATTRIBUTE,
+      const size_t &chain_length UNUSED_ATTRIBUTE) {}
+
  protected:
-  void CheckAndReclaimVarlenColumns(storage::TileGroup *tg, oid_t tuple_id);
+  // frees the varlen data of a garbage tuple, except for the shared columns
+  // whose data is owned by another version
+  void CheckAndReclaimVarlenColumns(storage::TileGroup *tg, oid_t tuple_id,
+                                    uint64_t shared_columns = 0);
 
  protected:
   volatile bool is_running_;
@@ -26,6 +26,7 @@ class GCManagerFactory {
     switch (gc_type_) {
 
       case GarbageCollectionType::ON:
+      case GarbageCollectionType::COOPERATIVE:
         return TransactionLevelGCManager::GetInstance(gc_thread_count_);
 
       default:
@@ -33,11 +34,14 @@ class GCManagerFactory {
     }
   }
 
-  static void Configure(const int thread_count = 1) { 
+  // If cooperative is set, the workers help the gc threads
+  static void Configure(const int thread_count = 1,
+                        const bool cooperative = false) {
     if (thread_count == 0) {
       gc_type_ = GarbageCollectionType::OFF;
     } else {
-      gc_type_ = GarbageCollectionType::ON;
+      gc_type_ = cooperative ? GarbageCollectionType::COOPERATIVE
+                             : GarbageCollectionType::ON;
       gc_thread_count_ = thread_count;
     }
   }
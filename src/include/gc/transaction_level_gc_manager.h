@@ -12,16 +12,20 @@
 
 #pragma once
 
+#include <chrono>
 #include <thread>
 #include <unordered_map>
 #include <map>
 #include <vector>
 #include <list>
+#include <mutex>
 
 #include "type/types.h"
 #include "common/logger.h"
 #include "common/init.h"
+#include "common/platform.h"
 #include "common/thread_pool.h"
+#include "concurrency/epoch_manager_factory.h"
 #include "gc/gc_manager.h"
 
 #include "container/lock_free_queue.h"
@@ -32,24 +36,81 @@ namespace gc {
 #define MAX_QUEUE_LENGTH 100000
 #define MAX_ATTEMPT_COUNT 100000
 
+// the local epoch the gc threads enter while they collect. the gc manager
+// registers it above the thread ids of the workers, so that it does not share
+// a local epoch with one of them. a local epoch can be shared between the gc
+// threads.
+#define GC_EPOCH_THREAD_ID 1024
+
+// in cooperative mode, the number of transactions whose garbage a worker
+// hands to the gc threads at once
+#define COOPERATIVE_GC_BATCH_SIZE 32
+
+// in cooperative mode, the number of garbage contexts a worker unlinks when
+// it helps a gc thread
+#define COOPERATIVE_GC_ATTEMPT_COUNT 64
+
+// in cooperative mode, workers that walk a version chain at least this long
+// help the gc threads
+#define COOPERATIVE_GC_CHAIN_LENGTH 4
+
 
 struct GarbageContext {
   GarbageContext() : timestamp_(INVALID_CID) {}
   GarbageContext(std::shared_ptr<GCSet> gc_set, 
-                 const cid_t &timestamp) {
+                 const cid_t &timestamp,
+                 const std::chrono::steady_clock::time_point &recycle_time =
+                     std::chrono::steady_clock::now()) {
     gc_set_ = gc_set;
     timestamp_ = timestamp;
+    recycle_time_ = recycle_time;
   }
 
   std::shared_ptr<GCSet> gc_set_;
   cid_t timestamp_;
+  // when the garbage was handed to the gc
+  std::chrono::steady_clock::time_point recycle_time_;
+};
+
+// The garbage a worker has not handed to the gc threads yet, in cooperative
+// mode. The transactions are merged into one garbage context, which is
+// collected once the latest of them is. The batches are registered with the
+// gc manager, so that the gc threads hand over the garbage of idle or exited
+// workers.
+struct GarbageBatch {
+  // held by the worker while it adds to the batch, and by the gc thread that
+  // hands it over
+  Spinlock lock;
+  std::shared_ptr<GCSet> gc_set;
+  cid_t timestamp = 0;
+  size_t txn_count = 0;
+  std::chrono::steady_clock::time_point recycle_time;
+  // set once the worker exited, the gc threads drop the batch then
+  bool exited = false;
 };
 
+//===--------------------------------------------------------------------===//
+// Transaction level GC
+//
+// The gc threads unlink the garbage of committed and aborted transactions
+// from the indexes once no running transaction can see it, and then make
+// its slots reusable.
+//
+// In cooperative mode (GarbageCollectionType::COOPERATIVE), the workers
+// help: every worker hands its garbage over in batches of
+// COOPERATIVE_GC_BATCH_SIZE transactions, and after handing over a batch,
+// or walking a long version chain, it does a bounded share of the work of
+// one gc thread if that thread is not busy. The gc threads still run, so
+// garbage is collected when the workers are idle, and the first gc thread
+// hands over the batches of the workers at every round.
+//===--------------------------------------------------------------------===//
 class TransactionLevelGCManager : public GCManager {
 public:
   TransactionLevelGCManager(int thread_count) 
     : gc_thread_count_(thread_count),
-      reclaim_maps_(thread_count) {
+      gc_thread_locks_(new Spinlock[thread_count]),
+      reclaim_maps_(thread_count),
+      frozen_garbage_maps_(thread_count) {
 
     unlink_queues_.reserve(thread_count);
     for (int i = 0; i < gc_thread_count_; ++i) {
@@ -59,6 +120,9 @@ public:
       unlink_queues_.push_back(unlink_queue);
       local_unlink_queues_.emplace_back();
     }
+
+    concurrency::EpochManagerFactory::GetInstance().RegisterThread(
+        GC_EPOCH_THREAD_ID);
   }
 
   virtual ~TransactionLevelGCManager() { }
@@ -93,8 +157,22 @@ public:
 
   virtual void RecycleTransaction(std::shared_ptr<GCSet> gc_set, const cid_t &timestamp) override;
 
+  virtual void VersionChainTraversed(const size_t &worker_id,
+                                     const size_t &chain_length) override;
+
+  // Do a bounded share of the work of a gc thread on the calling worker,
+  // unless the gc thread is busy. Also hands over the garbage the worker
+  // batched so far.
+  void CooperativeCollect(const size_t &worker_id);
+
   virtual ItemPointer ReturnFreeSlot(const oid_t &table_id) override;
 
+  virtual size_t ReturnFreeSlots(const oid_t &table_id, ItemPointer *locations,
+                                 const size_t &max_count) override;
+
+  virtual void RecycleTupleSlot(const oid_t &table_id,
+                                const ItemPointer &location) override;
+
   virtual void RegisterTable(const oid_t &table_id) override {
     // Insert a new entry for the table
     if (recycle_queue_map_.find(table_id) == recycle_queue_map_.end()) {
@@ -124,13 +202,36 @@ private:
 
   void Running(const int &thread_id);
 
-  int Unlink(const int &thread_id, const cid_t &max_cid);
+  // Queue the garbage for the gc thread its timestamp hashes to
+  void EnqueueGarbage(std::shared_ptr<GarbageContext> gc_context);
+
+  // Returns the garbage batch of the calling worker, registered on first use
+  GarbageBatch &GetGarbageBatch();
+
+  // Hand the garbage of the batch to the gc threads. The caller holds the
+  // lock of the batch.
+  void FlushGarbageBatch(GarbageBatch &batch);
+
+  // Hand the garbage batched by the calling worker to the gc threads
+  void FlushGarbageBatch();
+
+  // Hand the garbage batched by every worker to the gc threads
+  void FlushGarbageBatches();
+
+  int Unlink(const int &thread_id, const cid_t &max_cid,
+             const size_t &max_attempt_count = MAX_ATTEMPT_COUNT);
 
   int Reclaim(const int &thread_id, const cid_t &max_cid);
 
-  void AddToRecycleMap(std::shared_ptr<GarbageContext> gc_ctx);
+  void AddToRecycleMap(const int &thread_id,
+                       std::shared_ptr<GarbageContext> gc_ctx);
 
-  bool ResetTuple(const ItemPointer &);
+  // Recycle the garbage kept for the tile groups that are mutable again
+  void RecycleFrozenGarbage(const int &thread_id);
+
+  void RecycleTuple(const oid_t &table_id, const GCEntry &entry);
+
+  bool ResetTuple(const ItemPointer &location, const uint64_t shared_columns);
 
   void DeleteFromIndexes(const std::shared_ptr<GarbageContext>& garbage_ctx);
 
@@ -143,6 +244,10 @@ private:
 
   int gc_thread_count_;
 
+  // held by whoever does the work of a gc thread, the gc thread itself or a
+  // worker in cooperative mode
+  std::unique_ptr<Spinlock[]> gc_thread_locks_;
+
   // queues for to-be-unlinked tuples.
   // # unlink_queues == # gc_threads
   std::vector<std::shared_ptr<peloton::LockFreeQueue<std::shared_ptr<GarbageContext>>>> unlink_queues_;
@@ -157,6 +262,16 @@ private:
   // # reclaim_maps == # gc_threads
   std::vector<std::multimap<cid_t, std::shared_ptr<GarbageContext>>> reclaim_maps_;
 
+  // garbage of immutable tile groups, kept until they are mutable again.
+  // The key is the id of the tile group.
+  // # frozen_garbage_maps == # gc_threads
+  std::vector<std::unordered_map<oid_t, std::vector<GCEntry>>>
+      frozen_garbage_maps_;
+
+  // the garbage batches of the workers in cooperative mode
+  std::mutex garbage_batches_lock_;
+  std::list<std::shared_ptr<GarbageBatch>> garbage_batches_;
+
   // queues for to-be-reused tuples.
   // # recycle_queue_maps == # tables
   std::unordered_map<oid_t, std::shared_ptr<peloton::LockFreeQueue<ItemPointer>>> recycle_queue_map_;
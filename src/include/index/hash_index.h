@@ -0,0 +1,114 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// hash_index.h
+//
+// Identification: src/include/index/hash_index.h
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <vector>
+#include <string>
+
+#include "catalog/manager.h"
+#include "common/platform.h"
+#include "type/types.h"
+#include "index/index.h"
+
+#include "libcuckoo/cuckoohash_map.hh"
+
+#define HASH_INDEX_TEMPLATE_ARGUMENTS                                   \
+  template <typename KeyType, typename ValueType, typename KeyHashFunc, \
+            typename KeyEqualityChecker, typename ValueEqualityChecker>
+
+#define HASH_INDEX_TYPE                                                   \
+  HashIndex<KeyType, ValueType, KeyHashFunc, KeyEqualityChecker,          \
+            ValueEqualityChecker>
+
+namespace peloton {
+namespace index {
+
+/**
+ * Cuckoo hash based index implementation.
+ *
+ * Every key maps to the list of values stored under it. All operations on a
+ * key are done while libcuckoo holds the locks of its two buckets, so
+ * duplicate checks, predicate checks and removal of an emptied list are
+ * atomic with respect to other writers of the same key.
+ *
+ * The index has no key order. Point queries are answered with a single
+ * lookup, and every other scan falls back to visiting the whole table and
+ * returning all values; the caller must re-check its predicates on them.
+ *
+ * @see Index
+ */
+HASH_INDEX_TEMPLATE_ARGUMENTS
+class HashIndex : public Index {
+  friend class IndexFactory;
+
+  using ValueList = std::vector<ValueType>;
+
+  using MapType = cuckoohash_map<KeyType, ValueList, KeyHashFunc,
+                                 KeyEqualityChecker>;
+
+  // Number of slots allocated up front. The table doubles itself when it
+  // fills up, so this only needs to be small enough to not waste memory on
+  // the many tiny indexes of catalog and test tables
+  static const size_t INITIAL_SIZE = 1024;
+
+ public:
+  HashIndex(IndexMetadata *metadata);
+
+  ~HashIndex();
+
+  bool InsertEntry(const storage::Tuple *key, ItemPointer *value);
+
+  bool DeleteEntry(const storage::Tuple *key, ItemPointer *value);
+
+  bool CondInsertEntry(const storage::Tuple *key, ItemPointer *value,
+                       std::function<bool(const void *)> predicate);
+
+  void Scan(const std::vector<type::Value> &values,
+            const std::vector<oid_t> &key_column_ids,
+            const std::vector<ExpressionType> &expr_types,
+            ScanDirectionType scan_direction, std::vector<ValueType> &result,
+            const ConjunctionScanPredicate *csp_p);
+
+  void ScanLimit(const std::vector<type::Value> &values,
+                 const std::vector<oid_t> &key_column_ids,
+                 const std::vector<ExpressionType> &expr_types,
+                 ScanDirectionType scan_direction,
+                 std::vector<ValueType> &result,
+                 const ConjunctionScanPredicate *csp_p, uint64_t limit,
+                 uint64_t offset);
+
+  void ScanAllKeys(std::vector<ValueType> &result);
+
+  void ScanKey(const storage::Tuple *key, std::vector<ValueType> &result);
+
+  std::string GetTypeName() const;
+
+  size_t GetMemoryFootprint();
+
+  // Emptied value lists are erased inline, so there is nothing to collect
+  bool NeedGC() { return false; }
+
+  void PerformGC() { return; }
+
+ protected:
+  // hash function and equality checkers
+  KeyHashFunc hasher;
+  KeyEqualityChecker equals;
+  ValueEqualityChecker value_equals;
+
+  // container
+  MapType container;
+};
+
+}  // End index namespace
+}  // End peloton namespace
@@ -12,19 +12,807 @@
 
 #pragma once
 
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <new>
+#include <vector>
+
+#include "common/macros.h"
+#include "common/platform.h"
+
 namespace peloton {
 namespace index {
 
+/*
+ * class SkipListBase - Epoch bookkeeping shared by all skip list instances
+ *
+ * Every thread that operates on a skip list owns one epoch slot. On entering
+ * an operation the thread publishes the global epoch it has observed, and on
+ * leaving it resets the slot to INACTIVE_EPOCH. A node retired in epoch e
+ * could be freed as soon as every active slot shows an epoch > e, since
+ * threads that entered after the node has been unlinked can never reach it.
+ *
+ * Slots are per thread (not per tree), so entering an epoch is a single store
+ * into a thread-private cache line and never touches shared counters.
+ */
+class SkipListBase {
+ public:
+  // Maximum number of threads that could use skip lists at the same time
+  static constexpr size_t MAX_EPOCH_SLOT_COUNT = 1024;
+
+  // Epoch value of a slot whose thread is not inside any skip list
+  static constexpr uint64_t INACTIVE_EPOCH = UINT64_MAX;
+
+  /*
+   * struct EpochSlot - Published epoch of one thread (one cache line each)
+   */
+  struct EpochSlot {
+    std::atomic<uint64_t> epoch;
+    std::atomic<bool> in_use;
+    CACHE_PADOUT;
+  };
+
+  /*
+   * class EpochGuard - Keeps the current thread inside an epoch for the
+   *                    lifetime of the guard object
+   */
+  class EpochGuard {
+   public:
+    EpochGuard() : slot_p{GetLocalSlot()} {
+      // This must be a sequentially consistent store, such that the
+      // reclaimer either sees this thread or this thread sees the unlink
+      slot_p->epoch.store(global_epoch.load());
+    }
+
+    ~EpochGuard() {
+      slot_p->epoch.store(INACTIVE_EPOCH, std::memory_order_release);
+    }
+
+   private:
+    EpochSlot *slot_p;
+  };
+
+  /*
+   * GetCurrentEpoch() - Returns the epoch nodes are currently retired into
+   */
+  static inline uint64_t GetCurrentEpoch() { return global_epoch.load(); }
+
+  /*
+   * AdvanceEpoch() - Starts a new epoch and returns the oldest epoch that may
+   *                  still be observed by an active thread
+   *
+   * Nodes retired strictly before the returned epoch could be freed
+   */
+  static uint64_t AdvanceEpoch();
+
+ private:
+  static inline EpochSlot *GetLocalSlot() {
+    if (unlikely_branch(local_slot_p == nullptr)) {
+      local_slot_p = RegisterThread();
+    }
+
+    return local_slot_p;
+  }
+
+  // Claims a free slot for the calling thread; it is released on thread exit
+  static EpochSlot *RegisterThread();
+
+  static std::atomic<uint64_t> global_epoch;
+
+  // One past the highest slot index that has ever been handed out
+  static std::atomic<size_t> slot_high_water;
+
+  static EpochSlot epoch_slots[MAX_EPOCH_SLOT_COUNT];
+
+  static thread_local EpochSlot *local_slot_p;
+};
+
 /*
  * SKIPLIST_TEMPLATE_ARGUMENTS - Save some key strokes
  */
 #define SKIPLIST_TEMPLATE_ARGUMENTS                                       \
   template <typename KeyType, typename ValueType, typename KeyComparator, \
             typename KeyEqualityChecker, typename ValueEqualityChecker>
+
+/*
+ * class SkipList - Lock-free concurrent skip list multimap
+ *
+ * This is a CAS-based skip list in the style of Fraser / Herlihy-Shavit.
+ * Each (key, value) pair is stored in its own node; pairs with equal keys
+ * form a contiguous run on the bottom level, and a new pair is always linked
+ * at the end of its run. Because of this, any two inserts of the same key
+ * compete for the same predecessor pointer on the bottom level, which is
+ * what makes duplicate detection and ConditionalInsert() atomic.
+ *
+ * A node is logically deleted when the lowest bit of its bottom level
+ * successor pointer is set. Marked nodes are unlinked by any traversal that
+ * runs into them, and freed by the epoch-based reclamation scheme in
+ * SkipListBase once no thread could possibly hold a reference.
+ */
 template <typename KeyType, typename ValueType, typename KeyComparator,
           typename KeyEqualityChecker, typename ValueEqualityChecker>
-class SkipList {
-  // TODO: Add your declarations here
+class SkipList : public SkipListBase {
+ public:
+  // Highest tower. With a 1/4 promotion probability this is enough for
+  // 4^16 (about 4 billion) entries
+  static constexpr int MAX_LEVEL = 16;
+
+  // Number of nodes a thread retires before it tries to run the GC
+  static constexpr size_t GC_RETIRE_THRESHOLD = 1024;
+
+ private:
+  // Lowest bit of a successor pointer marks the owning node as deleted
+  static constexpr uintptr_t DELETE_MARK = 0x1;
+
+  // Set by the inserting thread once it stops linking the node
+  static constexpr uint32_t INSERT_DONE = 0x1;
+  // Set by the deleting thread once the node is marked on all levels
+  static constexpr uint32_t DELETE_DONE = 0x2;
+
+  /*
+   * class SkipListNode - A tower holding one key-value pair
+   *
+   * The successor array is allocated right after the node object, with
+   * exactly height entries
+   */
+  class SkipListNode {
+   public:
+    KeyType key;
+    ValueType value;
+
+    // Number of levels this node is part of
+    int height;
+
+    // INSERT_DONE / DELETE_DONE handshake. Whoever of the inserter and the
+    // deleter finishes last is responsible for unlinking and retiring
+    std::atomic<uint32_t> state;
+
+    // Epoch in which this node has been retired, and the garbage list link
+    uint64_t retire_epoch;
+    SkipListNode *garbage_next_p;
+
+    std::atomic<uintptr_t> *next;
+  };
+
+  using Node = SkipListNode;
+
+ public:
+  SkipList(KeyComparator p_key_cmp_obj = KeyComparator{},
+           KeyEqualityChecker p_key_eq_obj = KeyEqualityChecker{},
+           ValueEqualityChecker p_value_eq_obj = ValueEqualityChecker{})
+      : key_cmp_obj{p_key_cmp_obj},
+        key_eq_obj{p_key_eq_obj},
+        value_eq_obj{p_value_eq_obj},
+        garbage_list_p{nullptr} {
+    head_p = AllocateNode(KeyType{}, ValueType{}, MAX_LEVEL);
+    gc_flag.clear();
+  }
+
+  /*
+   * Destructor - Frees all nodes, linked or retired
+   *
+   * No thread may be operating on the skip list at this point
+   */
+  ~SkipList() {
+    Node *node_p = head_p;
+    while (node_p != nullptr) {
+      Node *next_p = GetPointer(node_p->next[0].load());
+      FreeNode(node_p);
+      node_p = next_p;
+    }
+
+    node_p = garbage_list_p.load();
+    while (node_p != nullptr) {
+      Node *next_p = node_p->garbage_next_p;
+      FreeNode(node_p);
+      node_p = next_p;
+    }
+  }
+
+  /*
+   * Insert() - Inserts a key-value pair
+   *
+   * Returns false if the exact same key-value pair is already present
+   */
+  bool Insert(const KeyType &key, const ValueType &value) {
+    EpochGuard guard;
+
+    return InsertInternal(key, value, nullptr, nullptr);
+  }
+
+  /*
+   * ConditionalInsert() - Inserts a key-value pair unless the predicate
+   *                       holds for a value already mapped by the key
+   *
+   * If the predicate is satisfied, *predicate_satisfied is set to true and
+   * nothing is inserted. The check and the insert are atomic with respect to
+   * other inserts of the same key.
+   */
+  bool ConditionalInsert(const KeyType &key, const ValueType &value,
+                         std::function<bool(const void *)> predicate,
+                         bool *predicate_satisfied) {
+    EpochGuard guard;
+
+    *predicate_satisfied = false;
+
+    return InsertInternal(key, value, &predicate, predicate_satisfied);
+  }
+
+  /*
+   * Delete() - Removes a key-value pair
+   *
+   * Returns false if the pair does not exist
+   */
+  bool Delete(const KeyType &key, const ValueType &value) {
+    EpochGuard guard;
+
+    Node *lower_preds[MAX_LEVEL];
+    Node *preds[MAX_LEVEL];
+    Node *succs[MAX_LEVEL];
+
+    while (true) {
+      FindPosition(key, lower_preds, preds, succs);
+
+      Node *victim_p = nullptr;
+      for (Node *curr_p = GetPointer(lower_preds[0]->next[0].load());
+           curr_p != nullptr && !KeyCmpLess(key, curr_p->key);
+           curr_p = GetPointer(curr_p->next[0].load())) {
+        // A smaller key may have been linked in front of the run since the
+        // position was found
+        if (KeyCmpLess(curr_p->key, key) == true) {
+          continue;
+        }
+
+        if (IsLive(curr_p) && ValueCmpEqual(curr_p->value, value)) {
+          victim_p = curr_p;
+          break;
+        }
+      }
+
+      if (victim_p == nullptr) {
+        return false;
+      }
+
+      // Mark upper levels top-down; whoever marks the bottom level owns
+      // the deletion
+      for (int level = victim_p->height - 1; level >= 1; level--) {
+        uintptr_t succ = victim_p->next[level].load();
+        while (IsMarked(succ) == false) {
+          victim_p->next[level].compare_exchange_weak(succ,
+                                                      succ | DELETE_MARK);
+        }
+      }
+
+      uintptr_t succ = victim_p->next[0].load();
+      bool owner = false;
+      while (IsMarked(succ) == false) {
+        if (victim_p->next[0].compare_exchange_weak(succ,
+                                                    succ | DELETE_MARK)) {
+          owner = true;
+          break;
+        }
+      }
+
+      // Another thread deleted the same pair; check again for a live copy
+      if (owner == false) {
+        continue;
+      }
+
+      uint32_t prev_state = victim_p->state.fetch_or(DELETE_DONE);
+      if ((prev_state & INSERT_DONE) != 0) {
+        UnlinkAndRetire(victim_p);
+      }
+
+      return true;
+    }
+  }
+
+  /*
+   * GetValue() - Appends all values mapped by the key
+   */
+  void GetValue(const KeyType &key, std::vector<ValueType> &value_list) {
+    EpochGuard guard;
+
+    CollectRun(FindLowerBound(key), key, value_list);
+  }
+
+  /*
+   * ScanRange() - Appends values whose key lies within [low, high]
+   *
+   * A nullptr bound means that side of the range is open. Values are
+   * produced in ascending key order, or descending order if reverse is set.
+   * If limit is not zero the scan stops after at least limit values have
+   * been produced (entries with equal keys are not split).
+   */
+  void ScanRange(const KeyType *low_key_p, const KeyType *high_key_p,
+                 bool reverse, size_t limit,
+                 std::vector<ValueType> &value_list) {
+    EpochGuard guard;
+
+    if (reverse == false || limit == 0) {
+      size_t start = value_list.size();
+
+      Node *pred_p = (low_key_p == nullptr) ? head_p
+                                            : FindLowerBound(*low_key_p);
+      for (Node *curr_p = GetPointer(pred_p->next[0].load());
+           curr_p != nullptr; curr_p = GetPointer(curr_p->next[0].load())) {
+        if (high_key_p != nullptr && KeyCmpLess(*high_key_p, curr_p->key)) {
+          break;
+        }
+
+        // Skip smaller keys linked after the lower bound has been found
+        if (low_key_p != nullptr && KeyCmpLess(curr_p->key, *low_key_p)) {
+          continue;
+        }
+
+        if (IsLive(curr_p)) {
+          value_list.push_back(curr_p->value);
+
+          if (reverse == false && limit != 0 &&
+              value_list.size() - start >= limit) {
+            break;
+          }
+        }
+      }
+
+      // Without a limit, one forward pass and reversing the output is much
+      // cheaper than searching for each predecessor
+      if (reverse == true) {
+        std::reverse(value_list.begin() + start, value_list.end());
+      }
+
+      return;
+    }
+
+    // Reverse scan with a limit: walk predecessors starting from the high
+    // key, each step being a single O(log n) search
+    size_t start = value_list.size();
+    KeyType bound_key{};
+    const KeyType *bound_key_p = high_key_p;
+    bool inclusive = true;
+
+    while (value_list.size() - start < limit) {
+      Node *node_p = FindLast(bound_key_p, inclusive);
+      if (node_p == head_p ||
+          (low_key_p != nullptr && KeyCmpLess(node_p->key, *low_key_p))) {
+        break;
+      }
+
+      bound_key = node_p->key;
+      bound_key_p = &bound_key;
+      inclusive = false;
+
+      CollectRun(FindLowerBound(bound_key), bound_key, value_list);
+    }
+  }
+
+  /*
+   * NeedGarbageCollection() - Whether there are retired nodes to free
+   */
+  bool NeedGarbageCollection() const {
+    return garbage_list_p.load() != nullptr;
+  }
+
+  /*
+   * PerformGarbageCollection() - Frees retired nodes no thread could see
+   *
+   * Only one thread runs the GC of a given skip list at a time; concurrent
+   * callers return immediately
+   */
+  void PerformGarbageCollection() {
+    if (gc_flag.test_and_set(std::memory_order_acquire) == true) {
+      return;
+    }
+
+    uint64_t safe_epoch = AdvanceEpoch();
+
+    Node *node_p = garbage_list_p.exchange(nullptr);
+    while (node_p != nullptr) {
+      Node *next_p = node_p->garbage_next_p;
+
+      if (node_p->retire_epoch < safe_epoch) {
+        FreeNode(node_p);
+      } else {
+        PushGarbage(node_p);
+      }
+
+      node_p = next_p;
+    }
+
+    gc_flag.clear(std::memory_order_release);
+  }
+
+  /*
+   * GetMemoryFootprint() - Approximate number of bytes used by live nodes
+   *
+   * This walks the bottom level and is meant for statistics only
+   */
+  size_t GetMemoryFootprint() {
+    EpochGuard guard;
+
+    size_t footprint = GetNodeSize(head_p->height);
+    for (Node *curr_p = GetPointer(head_p->next[0].load()); curr_p != nullptr;
+         curr_p = GetPointer(curr_p->next[0].load())) {
+      footprint += GetNodeSize(curr_p->height);
+    }
+
+    return footprint;
+  }
+
+  /*
+   * KeyCmpLess() - Compare two keys for "less than" relation
+   */
+  inline bool KeyCmpLess(const KeyType &key1, const KeyType &key2) const {
+    return key_cmp_obj(key1, key2);
+  }
+
+  /*
+   * KeyCmpLessEqual() - Compare two keys for "less than or equal" relation
+   */
+  inline bool KeyCmpLessEqual(const KeyType &key1, const KeyType &key2) const {
+    return !KeyCmpLess(key2, key1);
+  }
+
+  /*
+   * KeyCmpEqual() - Compare a pair of keys for equality
+   */
+  inline bool KeyCmpEqual(const KeyType &key1, const KeyType &key2) const {
+    return key_eq_obj(key1, key2);
+  }
+
+  /*
+   * ValueCmpEqual() - Compare a pair of values for equality
+   */
+  inline bool ValueCmpEqual(const ValueType &v1, const ValueType &v2) const {
+    return value_eq_obj(v1, v2);
+  }
+
+ private:
+  static inline bool IsMarked(uintptr_t word) {
+    return (word & DELETE_MARK) != 0;
+  }
+
+  static inline Node *GetPointer(uintptr_t word) {
+    return reinterpret_cast<Node *>(word & ~DELETE_MARK);
+  }
+
+  static inline uintptr_t GetWord(Node *node_p) {
+    return reinterpret_cast<uintptr_t>(node_p);
+  }
+
+  static inline bool IsLive(Node *node_p) {
+    return IsMarked(node_p->next[0].load()) == false;
+  }
+
+  static inline size_t GetNodeSize(int height) {
+    return sizeof(Node) + height * sizeof(std::atomic<uintptr_t>);
+  }
+
+  static Node *AllocateNode(const KeyType &key, const ValueType &value,
+                            int height) {
+    void *mem_p = ::operator new(GetNodeSize(height));
+
+    Node *node_p = static_cast<Node *>(mem_p);
+    new (&node_p->key) KeyType(key);
+    new (&node_p->value) ValueType(value);
+    node_p->height = height;
+    new (&node_p->state) std::atomic<uint32_t>(0);
+    node_p->retire_epoch = 0;
+    node_p->garbage_next_p = nullptr;
+
+    node_p->next = reinterpret_cast<std::atomic<uintptr_t> *>(node_p + 1);
+    for (int level = 0; level < height; level++) {
+      new (&node_p->next[level]) std::atomic<uintptr_t>(0);
+    }
+
+    return node_p;
+  }
+
+  static void FreeNode(Node *node_p) {
+    node_p->key.~KeyType();
+    node_p->value.~ValueType();
+    ::operator delete(node_p);
+  }
+
+  /*
+   * GetRandomHeight() - Draws a tower height with promotion probability 1/4
+   */
+  static int GetRandomHeight() {
+    static thread_local uint64_t seed =
+        reinterpret_cast<uintptr_t>(&seed) * 0x9E3779B97F4A7C15ULL | 1;
+
+    // xorshift64
+    seed ^= seed << 13;
+    seed ^= seed >> 7;
+    seed ^= seed << 17;
+
+    uint64_t bits = seed;
+    int height = 1;
+    while (height < MAX_LEVEL && (bits & 0x3) == 0) {
+      height++;
+      bits >>= 2;
+    }
+
+    return height;
+  }
+
+  /*
+   * AdvanceLevel() - Moves (pred, curr) forward on one level while curr is
+   *                  smaller than the key (or not larger if inclusive)
+   *
+   * Marked nodes met on the way are unlinked. Returns false if an unlink
+   * CAS failed, in which case the whole traversal has to restart.
+   */
+  inline bool AdvanceLevel(Node *&pred_p, Node *&curr_p, int level,
+                           const KeyType &key, bool inclusive) {
+    while (curr_p != nullptr) {
+      uintptr_t succ = curr_p->next[level].load();
+
+      if (IsMarked(succ) == true) {
+        uintptr_t expected = GetWord(curr_p);
+        if (pred_p->next[level].compare_exchange_strong(
+                expected, succ & ~DELETE_MARK) == false) {
+          return false;
+        }
+
+        curr_p = GetPointer(succ);
+        continue;
+      }
+
+      bool advance = inclusive ? KeyCmpLessEqual(curr_p->key, key)
+                               : KeyCmpLess(curr_p->key, key);
+      if (advance == false) {
+        break;
+      }
+
+      pred_p = curr_p;
+      curr_p = GetPointer(succ);
+    }
+
+    return true;
+  }
+
+  /*
+   * FindPosition() - Locates the run of the key on every level
+   *
+   * On return, for every level:
+   *   lower_preds - last node whose key < key
+   *   preds       - last node whose key <= key
+   *   succs       - first node whose key > key
+   *
+   * The descent always continues from lower_preds, so every node with an
+   * equal key is visited on every level it is linked into, and marked ones
+   * are unlinked along the way.
+   */
+  void FindPosition(const KeyType &key, Node **lower_preds, Node **preds,
+                    Node **succs) {
+  retry:
+    Node *pred_p = head_p;
+
+    for (int level = MAX_LEVEL - 1; level >= 0; level--) {
+      Node *curr_p = GetPointer(pred_p->next[level].load());
+
+      if (AdvanceLevel(pred_p, curr_p, level, key, false) == false) {
+        goto retry;
+      }
+
+      lower_preds[level] = pred_p;
+
+      Node *upper_pred_p = pred_p;
+      if (AdvanceLevel(upper_pred_p, curr_p, level, key, true) == false) {
+        goto retry;
+      }
+
+      preds[level] = upper_pred_p;
+      succs[level] = curr_p;
+    }
+  }
+
+  /*
+   * FindLowerBound() - Returns the last bottom level node with key < key
+   *
+   * This is a read-only traversal that does not help unlinking
+   */
+  Node *FindLowerBound(const KeyType &key) const {
+    Node *pred_p = head_p;
+
+    for (int level = MAX_LEVEL - 1; level >= 0; level--) {
+      Node *curr_p = GetPointer(pred_p->next[level].load());
+      while (curr_p != nullptr && KeyCmpLess(curr_p->key, key)) {
+        pred_p = curr_p;
+        curr_p = GetPointer(curr_p->next[level].load());
+      }
+    }
+
+    return pred_p;
+  }
+
+  /*
+   * FindLast() - Returns the last bottom level node whose key is <= (or <
+   *              if not inclusive) the bound, or head_p if there is none
+   *
+   * A nullptr bound returns the last node of the list
+   */
+  Node *FindLast(const KeyType *bound_p, bool inclusive) const {
+    Node *pred_p = head_p;
+
+    for (int level = MAX_LEVEL - 1; level >= 0; level--) {
+      Node *curr_p = GetPointer(pred_p->next[level].load());
+      while (curr_p != nullptr &&
+             (bound_p == nullptr ||
+              (inclusive ? KeyCmpLessEqual(curr_p->key, *bound_p)
+                         : KeyCmpLess(curr_p->key, *bound_p)))) {
+        pred_p = curr_p;
+        curr_p = GetPointer(curr_p->next[level].load());
+      }
+    }
+
+    return pred_p;
+  }
+
+  /*
+   * CollectRun() - Appends live values of the run of the key that starts
+   *                right after pred_p on the bottom level
+   */
+  void CollectRun(Node *pred_p, const KeyType &key,
+                  std::vector<ValueType> &value_list) const {
+    for (Node *curr_p = GetPointer(pred_p->next[0].load());
+         curr_p != nullptr && !KeyCmpLess(key, curr_p->key);
+         curr_p = GetPointer(curr_p->next[0].load())) {
+      if (IsLive(curr_p) && KeyCmpLess(curr_p->key, key) == false) {
+        value_list.push_back(curr_p->value);
+      }
+    }
+  }
+
+  /*
+   * InsertInternal() - Inserts at the end of the run of the key
+   *
+   * The caller must be inside an epoch
+   */
+  bool InsertInternal(const KeyType &key, const ValueType &value,
+                      std::function<bool(const void *)> *predicate_p,
+                      bool *predicate_satisfied) {
+    Node *lower_preds[MAX_LEVEL];
+    Node *preds[MAX_LEVEL];
+    Node *succs[MAX_LEVEL];
+
+    Node *node_p = nullptr;
+
+    while (true) {
+      FindPosition(key, lower_preds, preds, succs);
+
+      // Check the existing run on the bottom level. Any insert into this run
+      // after the check has to CAS preds[0] too, so it would make ours fail
+      for (Node *curr_p = GetPointer(lower_preds[0]->next[0].load());
+           curr_p != nullptr && !KeyCmpLess(key, curr_p->key);
+           curr_p = GetPointer(curr_p->next[0].load())) {
+        if (IsLive(curr_p) == false || KeyCmpLess(curr_p->key, key) == true) {
+          continue;
+        }
+
+        bool conflict = false;
+        if (predicate_p != nullptr && (*predicate_p)(curr_p->value) == true) {
+          *predicate_satisfied = true;
+          conflict = true;
+        } else if (ValueCmpEqual(curr_p->value, value) == true) {
+          conflict = true;
+        }
+
+        if (conflict == true) {
+          if (node_p != nullptr) {
+            FreeNode(node_p);
+          }
+
+          return false;
+        }
+      }
+
+      if (node_p == nullptr) {
+        node_p = AllocateNode(key, value, GetRandomHeight());
+      }
+
+      // The node is not visible yet, so plain stores are fine here
+      for (int level = 0; level < node_p->height; level++) {
+        node_p->next[level].store(GetWord(succs[level]),
+                                  std::memory_order_relaxed);
+      }
+
+      uintptr_t expected = GetWord(succs[0]);
+      if (preds[0]->next[0].compare_exchange_strong(expected,
+                                                    GetWord(node_p))) {
+        break;
+      }
+    }
+
+    // The pair is now logically inserted; link the upper levels. If the
+    // node gets deleted in the meantime we stop linking
+    for (int level = 1; level < node_p->height; level++) {
+      bool stop = false;
+
+      while (true) {
+        Node *succ_p = succs[level];
+
+        uintptr_t old_succ = node_p->next[level].load();
+        if (IsMarked(old_succ) == true) {
+          stop = true;
+          break;
+        }
+
+        if (GetPointer(old_succ) != succ_p &&
+            node_p->next[level].compare_exchange_strong(
+                old_succ, GetWord(succ_p)) == false) {
+          stop = true;
+          break;
+        }
+
+        uintptr_t expected = GetWord(succ_p);
+        if (preds[level]->next[level].compare_exchange_strong(
+                expected, GetWord(node_p))) {
+          break;
+        }
+
+        FindPosition(key, lower_preds, preds, succs);
+      }
+
+      if (stop == true) {
+        break;
+      }
+    }
+
+    uint32_t prev_state = node_p->state.fetch_or(INSERT_DONE);
+    if ((prev_state & DELETE_DONE) != 0) {
+      UnlinkAndRetire(node_p);
+    }
+
+    return true;
+  }
+
+  /*
+   * UnlinkAndRetire() - Physically removes a node marked on all levels and
+   *                     hands it over to the GC
+   *
+   * Must be called only after both the inserter and the deleter are done
+   * with the node, such that no new link to it could appear afterwards
+   */
+  void UnlinkAndRetire(Node *node_p) {
+    Node *lower_preds[MAX_LEVEL];
+    Node *preds[MAX_LEVEL];
+    Node *succs[MAX_LEVEL];
+
+    FindPosition(node_p->key, lower_preds, preds, succs);
+
+    node_p->retire_epoch = GetCurrentEpoch();
+    PushGarbage(node_p);
+
+    static thread_local size_t retire_count = 0;
+    if (++retire_count % GC_RETIRE_THRESHOLD == 0) {
+      PerformGarbageCollection();
+    }
+  }
+
+  void PushGarbage(Node *node_p) {
+    Node *head = garbage_list_p.load();
+    do {
+      node_p->garbage_next_p = head;
+    } while (garbage_list_p.compare_exchange_weak(head, node_p) == false);
+  }
+
+ private:
+  // Sentinel tower of MAX_LEVEL levels; its key is never compared
+  Node *head_p;
+
+  const KeyComparator key_cmp_obj;
+  const KeyEqualityChecker key_eq_obj;
+  const ValueEqualityChecker value_eq_obj;
+
+  // Retired nodes waiting for their epoch to expire
+  std::atomic<Node *> garbage_list_p;
+
+  // Makes sure only one thread runs the GC of this list
+  std::atomic_flag gc_flag;
 };
 
 }  // End index namespace
@@ -57,6 +57,9 @@ class FrontendLogger : public Logger {
   // Flush collected LogRecords
   virtual void FlushLogRecords(void) = 0;
 
+  // Wait until the flushed LogRecords are durable
+  virtual void SyncLogRecords(void) {}
+
   // Restore database
   virtual void DoRecovery(void) = 0;
 
@@ -125,10 +128,10 @@ class FrontendLogger : public Logger {
   // period with which it collects log records from backend loggers
   int wait_timeout;
 
-  // stats
-  size_t fsync_count = 0;
+  // stats, also bumped by the sync thread
+  std::atomic<size_t> fsync_count{0};
 
-  cid_t max_flushed_commit_id = 0;
+  std::atomic<cid_t> max_flushed_commit_id{0};
 
   cid_t max_collected_commit_id = 0;
 
@@ -12,6 +12,7 @@
 
 #pragma once
 
+#include <future>
 #include <map>
 #include <mutex>
 #include <vector>
@@ -107,6 +108,9 @@ class LogManager {
   // wait for the flush of a frontend logger (for worker thread)
   void WaitForFlush(cid_t cid);
 
+  // get a future that is ready once the logs up to cid are persistent
+  std::future<void> GetFlushFuture(cid_t cid);
+
   // get the current persistent flushed commit
   cid_t GetPersistentFlushedCommitId();
 
@@ -279,9 +283,10 @@ class LogManager {
   std::mutex logging_status_mutex;
   std::condition_variable logging_status_cv;
 
-  // To wait for flush
+  // To wait for flush, the promises of the commits that are not persistent
+  // yet keyed by commit id
   std::mutex flush_notify_mutex;
-  std::condition_variable flush_notify_cv;
+  std::multimap<cid_t, std::promise<void>> flush_promises;
 
   // To update catalog and txn managers
   std::mutex update_managers_mutex;
@@ -19,12 +19,18 @@
 #include "executor/executors.h"
 
 #include <dirent.h>
+#include <deque>
 #include <vector>
 #include <set>
 #include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
 
 extern int peloton_flush_frequency_micros;
 
+extern int peloton_group_commit_bytes;
+
 namespace peloton {
 
 namespace concurrency {
@@ -54,6 +60,8 @@ class WriteAheadFrontendLogger : public FrontendLogger {
 
   void FlushLogRecords(void);
 
+  void SyncLogRecords(void);
+
   //===--------------------------------------------------------------------===//
   // Recovery
   //===--------------------------------------------------------------------===//
@@ -66,12 +74,6 @@ class WriteAheadFrontendLogger : public FrontendLogger {
 
   void CommitTransactionRecovery(cid_t commit_id);
 
-  void InsertTuple(TupleRecord *recovery_txn);
-
-  void DeleteTuple(TupleRecord *recovery_txn);
-
-  void UpdateTuple(TupleRecord *recovery_txn);
-
   void AbortActiveTransactions();
 
   void InitLogFilesList();
@@ -104,7 +106,27 @@ class WriteAheadFrontendLogger : public FrontendLogger {
 
   static constexpr auto wal_directory_path = "wal_log";
 
+  // size of the chunks the serialized tuples are read into during recovery
+  static constexpr size_t recovery_arena_chunk_size = 4 * 1024 * 1024;
+
  private:
+  // A tuple record read during recovery, with its serialized tuple (if any)
+  struct RecoveryRecord {
+    RecoveryRecord(LogRecordType log_record_type) : record(log_record_type) {}
+
+    TupleRecord record;
+
+    const char *body = nullptr;
+
+    size_t body_size = 0;
+  };
+
+  // Read the serialized tuple of the record into the recovery arena
+  bool ReadRecoveryRecordBody(RecoveryRecord &recovery_record);
+
+  // Replay the committed records, each table on its own thread
+  void ReplayCommittedRecords();
+
   std::string GetLogFileName(void);
 
   bool RecoverTableIndexHelper(storage::DataTable *target_table,
@@ -113,6 +135,21 @@ class WriteAheadFrontendLogger : public FrontendLogger {
   void InsertIndexEntry(storage::Tuple *tuple, storage::DataTable *table,
                         ItemPointer target_location);
 
+  //===--------------------------------------------------------------------===//
+  // Group Commit
+  //===--------------------------------------------------------------------===//
+
+  // Whether the records written since the last flush should be made durable
+  bool GroupCommitIsDue();
+
+  // Hand the records written so far to the sync thread
+  void RequestSync();
+
+  // fsync the log file whenever a sync is requested
+  void SyncLoop();
+
+  void StopSyncThread();
+
   //===--------------------------------------------------------------------===//
   // Member Variables
   //===--------------------------------------------------------------------===//
@@ -121,7 +158,22 @@ class WriteAheadFrontendLogger : public FrontendLogger {
   FileHandle cur_file_handle;
 
   // Txn table during recovery
-  std::map<txn_id_t, std::vector<TupleRecord *>> recovery_txn_table;
+  std::map<txn_id_t, std::vector<RecoveryRecord *>> recovery_txn_table;
+
+  // The records read during recovery
+  std::deque<RecoveryRecord> recovery_records;
+
+  // The serialized tuples of the records read during recovery
+  std::vector<std::unique_ptr<char[]>> recovery_arena;
+
+  // free space left in the last chunk
+  char *recovery_arena_cursor = nullptr;
+
+  size_t recovery_arena_left = 0;
+
+  // The records of the committed txns, in commit order, per (database, table)
+  std::map<std::pair<oid_t, oid_t>, std::vector<RecoveryRecord *>>
+      replay_queues;
 
   // Keep tracking max oid for setting next_oid in manager
   // For active processing after recovery
@@ -160,7 +212,41 @@ class WriteAheadFrontendLogger : public FrontendLogger {
 
   TimePoint last_flush = Clock::now();
 
+  // group commit window: records are made durable once this much time has
+  // passed since the last flush ...
   Micros flush_frequency{peloton_flush_frequency_micros};
+
+  // ... or this many bytes were written since the last flush (0 is no limit)
+  size_t group_commit_bytes = peloton_group_commit_bytes;
+
+  // bytes written since the last flush
+  size_t unsynced_bytes = 0;
+
+  // max commit id whose delimiter is written to the log file
+  cid_t max_written_commit_id = 0;
+
+  // max commit id handed to the sync thread (or flushed, in test mode)
+  cid_t flush_requested_commit_id = 0;
+
+  // the sync thread fsyncs the log file while the next batch is collected
+  std::thread sync_thread;
+
+  // protects the sync_* fields below
+  std::mutex sync_mutex;
+
+  // wakes up the sync thread
+  std::condition_variable sync_cv;
+
+  // wakes up those waiting for the sync thread to catch up
+  std::condition_variable synced_cv;
+
+  cid_t sync_requested_commit_id = 0;
+
+  cid_t synced_commit_id = 0;
+
+  int sync_fd = -1;
+
+  bool stop_sync_thread = false;
 };
 
 }  // namespace logging
@@ -59,6 +59,10 @@ class LoggingUtil {
                                              type::AbstractPool *pool,
                                              FileHandle &file_handle);
 
+  static storage::Tuple *DeserializeTupleRecordBody(
+      const catalog::Schema *schema, type::AbstractPool *pool,
+      const char *body, size_t body_size);
+
   static void SkipTupleRecordBody(FileHandle &file_handle);
 
   static int GetFileSizeFromFileName(const char *);
@@ -14,7 +14,9 @@
 
 #include <cstdlib>
 #include <algorithm>
+#include <set>
 #include <string>
+#include <vector>
 
 #include "expression/abstract_expression.h"
 
@@ -24,6 +26,10 @@ namespace catalog {
 class Schema;
 }
 
+namespace index {
+class Index;
+}
+
 namespace storage {
 class DataTable;
 }
@@ -43,6 +49,12 @@ void GetPredicateColumns(const catalog::Schema *schema,
                                 std::vector<type::Value> &values,
                                 bool &index_searchable);
 
+// check whether an index can answer the predicates on its columns; a hash
+// index is only usable when every one of its columns is compared by equality
+bool IsIndexUsable(index::Index *index, const std::set<oid_t> &index_columns,
+                   const std::vector<oid_t> &column_ids,
+                   const std::vector<ExpressionType> &expr_types);
+
 bool CheckIndexSearchable(storage::DataTable *target_table,
                                  expression::AbstractExpression *expression,
                                  std::vector<oid_t> &key_column_ids,
@@ -39,9 +39,9 @@ class NestedLoopJoinPlan : public AbstractJoinPlan {
       std::vector<oid_t> &join_column_ids_left,
       std::vector<oid_t> &join_column_ids_right);
 
-  // Nested loops don't need to perform any attribute binding
-  void HandleSubplanBinding(UNUSED_ATTRIBUTE bool,
-                            UNUSED_ATTRIBUTE const BindingContext &) override {}
+  // Find the attributes the join columns of each side refer to
+  void HandleSubplanBinding(bool from_left,
+                            const BindingContext &input) override;
 
   inline PlanNodeType GetPlanNodeType() const { return PlanNodeType::NESTLOOP; }
 
@@ -68,6 +68,14 @@ class NestedLoopJoinPlan : public AbstractJoinPlan {
     return join_column_ids_right_;
   }
 
+  // The attributes of the join columns, available after binding
+  const std::vector<const AttributeInfo *> &GetJoinAttributesLeft() const {
+    return join_ais_left_;
+  }
+  const std::vector<const AttributeInfo *> &GetJoinAttributesRight() const {
+    return join_ais_right_;
+  }
+
  private:
   // columns in left table for join predicate. Note: this is columns in the
   // result. For example, you want to find column id 5 in the table, but the
@@ -83,6 +91,10 @@ class NestedLoopJoinPlan : public AbstractJoinPlan {
   // to update the corresponding column in the index predicate
   std::vector<oid_t> join_column_ids_right_;
 
+  // The attributes produced by the children for the join columns above
+  std::vector<const AttributeInfo *> join_ais_left_;
+  std::vector<const AttributeInfo *> join_ais_right_;
+
  private:
   DISALLOW_COPY_AND_MOVE(NestedLoopJoinPlan);
 };
@@ -23,6 +23,9 @@
 #include "statistics/latency_metric.h"
 #include "statistics/database_metric.h"
 #include "statistics/query_metric.h"
+#include "statistics/gc_metric.h"
+#include "statistics/connection_metric.h"
+#include "statistics/query_cache_metric.h"
 #include "container/cuckoo_map.h"
 #include "container/lock_free_queue.h"
 
@@ -80,6 +83,15 @@ class BackendStatsContext {
   // Returns the latency metric
   LatencyMetric& GetTxnLatencyMetric();
 
+  // Returns the metric of the compiled query cache
+  QueryCacheMetric& GetQueryCacheMetric();
+
+  // Returns the metric of the version chains and the garbage collector
+  GCMetric& GetGCMetric();
+
+  // Returns the metric of the connections of the libevent workers
+  ConnectionMetric& GetConnectionMetric();
+
   // Increment the read stat for given tile group
   void IncrementTableReads(oid_t tile_group_id);
 
@@ -111,6 +123,33 @@ class BackendStatsContext {
   // Increment the abortion stat for given database
   void IncrementTxnAborted(oid_t database_id);
 
+  // Increment the hit stat of the compiled query cache
+  void IncrementQueryCacheHits(int64_t saved_compile_us);
+
+  // Increment the miss stat of the compiled query cache
+  void IncrementQueryCacheMisses();
+
+  // Increment the eviction stat of the compiled query cache
+  void IncrementQueryCacheEvictions();
+
+  // Record the number of versions visited to find the visible one
+  void IncrementVersionChainTraversals(int64_t chain_length);
+
+  // Record a garbage batch whose slots became reusable
+  void IncrementGCReclaims(int64_t version_count, int64_t latency_us);
+
+  // Increment the stat of connections handed to the given worker
+  void IncrementConnectionsDispatched(int worker_id);
+
+  // Increment the stat of connections the given worker picked up
+  void IncrementConnectionsDequeued(int worker_id);
+
+  // Increment the stat of connections the given worker started serving
+  void IncrementConnectionsOpened(int worker_id);
+
+  // Increment the stat of connections the given worker closed
+  void IncrementConnectionsClosed(int worker_id);
+
   // Initialize the query stat
   void InitQueryMetric(const std::shared_ptr<Statement> statement,
                        const std::shared_ptr<QueryMetric::QueryParams> params);
@@ -174,6 +213,15 @@ class BackendStatsContext {
   // Latencies recorded by this worker
   LatencyMetric txn_latencies_;
 
+  // Compiled query cache lookups done by this worker
+  QueryCacheMetric query_cache_metric_{QUERY_CACHE_METRIC};
+
+  // Version chains traversed, and garbage reclaimed, by this worker
+  GCMetric gc_metric_{GC_METRIC};
+
+  // Connections dispatched, or served, by this thread
+  ConnectionMetric connection_metric_{CONNECTION_METRIC};
+
   // Whether this context is registered to the global aggregator
   bool is_registered_to_aggregator_;
 
@@ -0,0 +1,111 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// connection_metric.h
+//
+// Identification: src/include/statistics/connection_metric.h
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <atomic>
+#include <string>
+#include <sstream>
+#include <vector>
+
+#include "type/types.h"
+#include "statistics/abstract_metric.h"
+
+namespace peloton {
+namespace stats {
+
+/**
+ * Metrics of the client connections of every libevent worker thread,
+ * including how many connections a worker serves and how many were handed
+ * to it but not picked up yet. The counters of a worker may be recorded by
+ * different threads (the master dispatches, the worker dequeues), they add
+ * up once aggregated. The counters are allocated for CONNECTION_THREAD_COUNT
+ * workers up front, so recording never changes the layout the aggregator
+ * iterates over.
+ */
+class ConnectionMetric : public AbstractMetric {
+ public:
+  ConnectionMetric(MetricType type,
+                   size_t worker_count = CONNECTION_THREAD_COUNT);
+
+  //===--------------------------------------------------------------------===//
+  // ACCESSORS
+  //===--------------------------------------------------------------------===//
+
+  inline void IncrementDispatched(int worker_id) {
+    if (HasWorker(worker_id)) workers_[worker_id].dispatched++;
+  }
+
+  inline void IncrementDequeued(int worker_id) {
+    if (HasWorker(worker_id)) workers_[worker_id].dequeued++;
+  }
+
+  inline void IncrementOpened(int worker_id) {
+    if (HasWorker(worker_id)) workers_[worker_id].opened++;
+  }
+
+  inline void IncrementClosed(int worker_id) {
+    if (HasWorker(worker_id)) workers_[worker_id].closed++;
+  }
+
+  // Returns the number of connections the worker is serving
+  int64_t GetActiveConnections(int worker_id) const;
+
+  // Returns the number of connections waiting in the queue of the worker
+  int64_t GetQueueDepth(int worker_id) const;
+
+  //===--------------------------------------------------------------------===//
+  // HELPER METHODS
+  //===--------------------------------------------------------------------===//
+
+  void Reset();
+
+  bool operator==(const ConnectionMetric &other);
+
+  inline bool operator!=(const ConnectionMetric &other) {
+    return !(*this == other);
+  }
+
+  void Aggregate(AbstractMetric &source);
+
+  const std::string GetInfo() const;
+
+ private:
+  //===--------------------------------------------------------------------===//
+  // MEMBERS
+  //===--------------------------------------------------------------------===//
+
+  inline bool HasWorker(int worker_id) const {
+    return worker_id >= 0 && static_cast<size_t>(worker_id) < workers_.size();
+  }
+
+  struct WorkerConnections {
+    // Connections the master handed to the worker
+    std::atomic<int64_t> dispatched{0};
+
+    // Connections the worker picked up from its queue
+    std::atomic<int64_t> dequeued{0};
+
+    // Connections the worker started serving
+    std::atomic<int64_t> opened{0};
+
+    // Connections the worker closed
+    std::atomic<int64_t> closed{0};
+  };
+
+  // Counters of each worker, indexed by the id of the worker thread. Sized
+  // once in the constructor and never resized.
+  std::vector<WorkerConnections> workers_;
+};
+
+}  // namespace stats
+}  // namespace peloton
@@ -0,0 +1,110 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// gc_metric.h
+//
+// Identification: src/include/statistics/gc_metric.h
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <string>
+#include <sstream>
+
+#include "type/types.h"
+#include "statistics/counter_metric.h"
+#include "statistics/abstract_metric.h"
+
+namespace peloton {
+namespace stats {
+
+/**
+ * Metrics of the version chains and the garbage collector, including the
+ * length of the version chains traversed by the readers and how long garbage
+ * waits until its slots can be reused.
+ */
+class GCMetric : public AbstractMetric {
+ public:
+  GCMetric(MetricType type);
+
+  //===--------------------------------------------------------------------===//
+  // ACCESSORS
+  //===--------------------------------------------------------------------===//
+
+  inline void IncrementVersionChainTraversals(int64_t chain_length) {
+    chain_traversals_.Increment();
+    chain_length_.Increment(chain_length);
+  }
+
+  inline void IncrementReclaims(int64_t version_count, int64_t latency_us) {
+    reclaims_.Increment();
+    reclaimed_versions_.Increment(version_count);
+    reclaim_latency_us_.Increment(latency_us);
+  }
+
+  inline CounterMetric &GetVersionChainTraversals() {
+    return chain_traversals_;
+  }
+
+  inline CounterMetric &GetVersionChainLength() { return chain_length_; }
+
+  inline CounterMetric &GetReclaims() { return reclaims_; }
+
+  inline CounterMetric &GetReclaimedVersions() { return reclaimed_versions_; }
+
+  inline CounterMetric &GetReclaimLatency() { return reclaim_latency_us_; }
+
+  //===--------------------------------------------------------------------===//
+  // HELPER METHODS
+  //===--------------------------------------------------------------------===//
+
+  inline void Reset() {
+    chain_traversals_.Reset();
+    chain_length_.Reset();
+    reclaims_.Reset();
+    reclaimed_versions_.Reset();
+    reclaim_latency_us_.Reset();
+  }
+
+  inline bool operator==(const GCMetric &other) {
+    return chain_traversals_ == other.chain_traversals_ &&
+           chain_length_ == other.chain_length_ &&
+           reclaims_ == other.reclaims_ &&
+           reclaimed_versions_ == other.reclaimed_versions_ &&
+           reclaim_latency_us_ == other.reclaim_latency_us_;
+  }
+
+  inline bool operator!=(const GCMetric &other) { return !(*this == other); }
+
+  void Aggregate(AbstractMetric &source);
+
+  const std::string GetInfo() const;
+
+ private:
+  //===--------------------------------------------------------------------===//
+  // MEMBERS
+  //===--------------------------------------------------------------------===//
+
+  // Count of the version chains traversed from the index
+  CounterMetric chain_traversals_{MetricType::COUNTER_METRIC};
+
+  // Total number of versions visited in these traversals
+  CounterMetric chain_length_{MetricType::COUNTER_METRIC};
+
+  // Count of the garbage batches whose slots were made reusable
+  CounterMetric reclaims_{MetricType::COUNTER_METRIC};
+
+  // Total number of versions in these batches
+  CounterMetric reclaimed_versions_{MetricType::COUNTER_METRIC};
+
+  // Total time (in microseconds) from handing a batch to the garbage
+  // collector until its slots were reusable
+  CounterMetric reclaim_latency_us_{MetricType::COUNTER_METRIC};
+};
+
+}  // namespace stats
+}  // namespace peloton
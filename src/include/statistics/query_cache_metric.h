@@ -0,0 +1,98 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// query_cache_metric.h
+//
+// Identification: src/include/statistics/query_cache_metric.h
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <string>
+#include <sstream>
+
+#include "type/types.h"
+#include "statistics/counter_metric.h"
+#include "statistics/abstract_metric.h"
+
+namespace peloton {
+namespace stats {
+
+/**
+ * Metrics of the compiled query cache, including the number of hits and misses
+ * and the compilation time the hits saved.
+ */
+class QueryCacheMetric : public AbstractMetric {
+ public:
+  QueryCacheMetric(MetricType type);
+
+  //===--------------------------------------------------------------------===//
+  // ACCESSORS
+  //===--------------------------------------------------------------------===//
+
+  inline void IncrementHits(int64_t saved_compile_us) {
+    hits_.Increment();
+    saved_compile_us_.Increment(saved_compile_us);
+  }
+
+  inline void IncrementMisses() { misses_.Increment(); }
+
+  inline void IncrementEvictions() { evictions_.Increment(); }
+
+  inline CounterMetric &GetHits() { return hits_; }
+
+  inline CounterMetric &GetMisses() { return misses_; }
+
+  inline CounterMetric &GetEvictions() { return evictions_; }
+
+  inline CounterMetric &GetSavedCompileTime() { return saved_compile_us_; }
+
+  //===--------------------------------------------------------------------===//
+  // HELPER METHODS
+  //===--------------------------------------------------------------------===//
+
+  inline void Reset() {
+    hits_.Reset();
+    misses_.Reset();
+    evictions_.Reset();
+    saved_compile_us_.Reset();
+  }
+
+  inline bool operator==(const QueryCacheMetric &other) {
+    return hits_ == other.hits_ && misses_ == other.misses_ &&
+           evictions_ == other.evictions_ &&
+           saved_compile_us_ == other.saved_compile_us_;
+  }
+
+  inline bool operator!=(const QueryCacheMetric &other) {
+    return !(*this == other);
+  }
+
+  void Aggregate(AbstractMetric &source);
+
+  const std::string GetInfo() const;
+
+ private:
+  //===--------------------------------------------------------------------===//
+  // MEMBERS
+  //===--------------------------------------------------------------------===//
+
+  // Count of the lookups that found a compiled query
+  CounterMetric hits_{MetricType::COUNTER_METRIC};
+
+  // Count of the lookups that had to compile the query
+  CounterMetric misses_{MetricType::COUNTER_METRIC};
+
+  // Count of the compiled queries dropped to stay in the code size budget
+  CounterMetric evictions_{MetricType::COUNTER_METRIC};
+
+  // Total compilation time (in microseconds) the hits did not have to spend
+  CounterMetric saved_compile_us_{MetricType::COUNTER_METRIC};
+};
+
+}  // namespace stats
+}  // namespace peloton
@@ -31,6 +31,14 @@
 
 extern std::vector<peloton::oid_t> sdbench_column_ids;
 
+// Number of insert partitions of a table. When a table has more than one
+// active tile group, every inserting thread is mapped to one of them, so that
+// threads mostly touch their own state.
+#define INSERT_PARTITION_COUNT 32
+
+// Number of recycled tuple slots an insert partition takes from the gc at once
+#define FREE_SLOT_BATCH_SIZE 32
+
 namespace peloton {
 
 namespace brain {
@@ -90,6 +98,11 @@ class DataTable : public AbstractTable {
 
   ~DataTable();
 
+  // The insert partitions are aligned to cache lines, which the global
+  // operator new does not guarantee
+  static void *operator new(size_t size);
+  static void operator delete(void *location);
+
   //===--------------------------------------------------------------------===//
   // TUPLE OPERATIONS
   //===--------------------------------------------------------------------===//
@@ -184,9 +197,46 @@ class DataTable : public AbstractTable {
   // TRANSFORMERS
   //===--------------------------------------------------------------------===//
 
+  // Convert a cold tile group to the default layout, and compress it with
+  // --compress_frozen_tile_groups. Called repeatedly by the layout tuner:
+  // the first call makes the tile group immutable, and a call after the
+  // running transactions have ended replaces it by a converted copy, which
+  // is returned. Later calls make the copy mutable again once no
+  // transaction can read the original, and thaw a tile group whose
+  // transformation is abandoned. A compressed copy stays frozen while it is
+  // cold. Once it is written again, it is replaced by a plain copy, which is
+  // returned and thawed like the others.
+  //
+  // Compression dictionary encodes the uninlined varlen columns, and moves
+  // every integer column to a tile of its own, which is packed, see
+  // storage::PackedColumn. Readers unpack the values of packed tiles, and
+  // compiled scans filter them without unpacking. Other fixed-width columns
+  // are copied as they are.
   storage::TileGroup *TransformTileGroup(const oid_t &tile_group_offset,
                                          const double &theta);
 
+  size_t GetTransformedTileGroupCount() const {
+    return transformed_tile_group_count_;
+  }
+
+  // the bytes that scans of the column groups of the default layout read
+  // from the transformed tile groups before, over the bytes they read after.
+  // this is not a measured speedup, scans also pay for other things.
+  double GetTransformScanBytesRatio() const;
+
+  size_t GetCompressedTileGroupCount() const {
+    return compressed_tile_group_count_;
+  }
+
+  size_t GetDecompressedTileGroupCount() const {
+    return decompressed_tile_group_count_;
+  }
+
+  // the size of the encoded columns of the compressed tile groups before,
+  // over their size after: the varlen data over the dictionaries, and the
+  // integer columns over the packed ones
+  double GetCompressionRatio() const;
+
   //===--------------------------------------------------------------------===//
   // STATS
   //===--------------------------------------------------------------------===//
@@ -273,6 +323,12 @@ class DataTable : public AbstractTable {
   // Claim a tuple slot in a tile group
   ItemPointer GetEmptyTupleSlot(const storage::Tuple *tuple);
 
+  // Take a tuple slot recycled by the gc, or return an invalid item pointer
+  ItemPointer GetFreeTupleSlot();
+
+  // The insert partition of the calling thread
+  size_t GetInsertPartitionId() const;
+
   // add a tile group to the table
   oid_t AddDefaultTileGroup();
   // add a tile group to the table. replace the active_tile_group_id-th active
@@ -346,9 +402,21 @@ class DataTable : public AbstractTable {
   // # of unique constraints
   std::atomic<oid_t> unique_constraint_count_ = ATOMIC_VAR_INIT(START_OID);
 
-  // # of tuples. must be atomic as multiple transactions can perform insert
-  // concurrently.
-  std::atomic<size_t> number_of_tuples_ = ATOMIC_VAR_INIT(0);
+  // the state an inserting thread keeps for itself. the partitions are
+  // aligned so that threads do not share cache lines.
+  struct alignas(CACHELINE_SIZE) InsertPartition {
+    // # of tuples inserted (minus deleted) through this partition. the
+    // table's count is the sum over the partitions, and a single partition
+    // may wrap around below zero.
+    std::atomic<size_t> tuple_count = ATOMIC_VAR_INIT(0);
+
+    // slots recycled by the gc, used from next_free_slot onwards
+    Spinlock free_slot_lock;
+    size_t next_free_slot = 0;
+    std::vector<ItemPointer> free_slots;
+  };
+
+  InsertPartition insert_partitions_[INSERT_PARTITION_COUNT];
 
   // dirty flag. for detecting whether the tile group has been used.
   bool dirty_ = false;
@@ -363,6 +431,18 @@ class DataTable : public AbstractTable {
   // default partition map for table
   column_map_type default_partition_;
 
+  // tile groups converted to the default layout
+  std::atomic<size_t> transformed_tile_group_count_ = ATOMIC_VAR_INIT(0);
+  std::atomic<size_t> scan_bytes_before_transform_ = ATOMIC_VAR_INIT(0);
+  std::atomic<size_t> scan_bytes_after_transform_ = ATOMIC_VAR_INIT(0);
+
+  // tile groups whose varlen columns have been dictionary encoded
+  std::atomic<size_t> compressed_tile_group_count_ = ATOMIC_VAR_INIT(0);
+  std::atomic<size_t> bytes_before_compression_ = ATOMIC_VAR_INIT(0);
+  std::atomic<size_t> bytes_after_compression_ = ATOMIC_VAR_INIT(0);
+  // compressed tile groups replaced by a plain copy to be written again
+  std::atomic<size_t> decompressed_tile_group_count_ = ATOMIC_VAR_INIT(0);
+
   // samples for layout tuning
   std::vector<brain::Sample> layout_samples_;
 
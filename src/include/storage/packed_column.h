@@ -0,0 +1,105 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// packed_column.h
+//
+// Identification: src/include/storage/packed_column.h
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+
+#include "type/types.h"
+
+namespace peloton {
+namespace storage {
+
+//===--------------------------------------------------------------------===//
+// Packed Column
+//===--------------------------------------------------------------------===//
+
+/**
+ * A column of integers stored as the offsets of the values from the smallest
+ * one (frame of reference), each in the fewest bits that hold the largest
+ * offset (bit-packing).
+ *
+ * The offset of the value of slot i is found in bits [i * bits, i * bits +
+ * bits) of an array of 64-bit words, least significant bits first. A value
+ * may straddle two words, and one word more is allocated, so the two words of
+ * any slot can always be read. Scans read the packed words directly, see
+ * codegen::RuntimeFunctions::GetTileGroupLayout().
+ */
+class PackedColumn {
+  PackedColumn() = delete;
+  PackedColumn(PackedColumn const &) = delete;
+
+ public:
+  PackedColumn(type::Type::TypeId type, oid_t count, int64_t base,
+               uint32_t bits);
+
+  /**
+   * Pack the values of the given type found every stride bytes from data.
+   * Returns nullptr if the type is not an integer type, or the values don't
+   * fit into fewer bits than the type has.
+   */
+  static std::unique_ptr<PackedColumn> Pack(const char *data, size_t stride,
+                                            type::Type::TypeId type,
+                                            oid_t count);
+
+  static bool IsPackable(type::Type::TypeId type);
+
+  // The offset from the base stored in the given bits of the given slot
+  static inline uint64_t GetOffset(const uint64_t *words, uint32_t bits,
+                                   oid_t slot) {
+    uint64_t bit = static_cast<uint64_t>(slot) * bits;
+    uint64_t shift = bit & 63;
+    const uint64_t *word = words + (bit >> 6);
+    // shifting by 64 is undefined, so the high word is shifted twice
+    uint64_t offset = (word[0] >> shift) | ((word[1] << 1) << (63 - shift));
+    return offset & ((uint64_t{1} << bits) - 1);
+  }
+
+  inline int64_t GetValue(oid_t slot) const {
+    return base_ + static_cast<int64_t>(GetOffset(words_.get(), bits_, slot));
+  }
+
+  // Write the value of the given slot the way the tile stores it
+  void Unpack(oid_t slot, char *field) const;
+
+  type::Type::TypeId GetType() const { return type_; }
+
+  oid_t GetCount() const { return count_; }
+
+  int64_t GetBase() const { return base_; }
+
+  uint32_t GetBits() const { return bits_; }
+
+  const uint64_t *GetWords() const { return words_.get(); }
+
+  // The size of the packed words in bytes
+  size_t GetSize() const { return word_count_ * sizeof(uint64_t); }
+
+ private:
+  type::Type::TypeId type_;
+
+  oid_t count_;
+
+  // the smallest value of the column
+  int64_t base_;
+
+  // the bits of every offset, at least one
+  uint32_t bits_;
+
+  size_t word_count_;
+
+  std::unique_ptr<uint64_t[]> words_;
+};
+
+}  // End storage namespace
+}  // End peloton namespace
@@ -12,12 +12,15 @@
 
 #pragma once
 
+#include <memory>
 #include <mutex>
+#include <vector>
 
 #include "catalog/manager.h"
 #include "catalog/schema.h"
 #include "common/item_pointer.h"
 #include "common/printable.h"
+#include "storage/packed_column.h"
 #include "type/abstract_pool.h"
 #include "type/serializeio.h"
 #include "type/serializer.h"
@@ -117,6 +120,29 @@ class Tile : public Printable {
   // Copy current tile in given backend and return new tile
   Tile *CopyTile(BackendType backend_type);
 
+  // Write the tuple at the given slot to the given location in the layout of
+  // the tile schema, whether the tile is packed or not
+  void CopyTupleTo(const oid_t tuple_offset, char *location) const;
+
+  //===--------------------------------------------------------------------===//
+  // Packing
+  //===--------------------------------------------------------------------===//
+
+  /**
+   * Pack the columns of the tile, and free its tuple slots. A tile is only
+   * packed if all its columns are integer columns whose values fit into
+   * fewer bits, and can not be written afterwards. Returns true if the tile
+   * is packed.
+   */
+  bool Pack();
+
+  bool IsPacked() const { return packed_columns.empty() == false; }
+
+  // The packed column, if the tile is packed
+  const PackedColumn *GetPackedColumn(const oid_t column_id) const {
+    return IsPacked() ? packed_columns[column_id].get() : nullptr;
+  }
+
   //===--------------------------------------------------------------------===//
   // Size Stats
   //===--------------------------------------------------------------------===//
@@ -194,9 +220,12 @@ class Tile : public Printable {
   // tile schema
   catalog::Schema schema;
 
-  // set of fixed-length tuple slots
+  // set of fixed-length tuple slots, freed once the tile is packed
   char *data;
 
+  // the columns of a packed tile
+  std::vector<std::unique_ptr<PackedColumn>> packed_columns;
+
   // relevant tile group
   TileGroup *tile_group;
 
@@ -242,6 +271,7 @@ inline char *Tile::GetTupleLocation(const oid_t tuple_offset) const {
 // Returns -1 if no matching tuple was found
 inline int Tile::GetTupleOffset(const char *tuple_address) const {
   // check if address within tile bounds
+  if (data == nullptr) return -1;
   if ((tuple_address < data) || (tuple_address >= (data + tile_size)))
     return -1;
 
@@ -74,7 +74,8 @@ class TileGroup : public Printable {
 
  public:
   // Tile group constructor
-  TileGroup(BackendType backend_type, TileGroupHeader *tile_group_header,
+  TileGroup(BackendType backend_type,
+            std::shared_ptr<TileGroupHeader> tile_group_header,
             AbstractTable *table, const std::vector<catalog::Schema> &schemas,
             const column_map_type &column_map, int tuple_count);
 
@@ -87,6 +88,24 @@ class TileGroup : public Printable {
   // copy tuple in place.
   void CopyTuple(const Tuple *tuple, const oid_t &tuple_slot_id);
 
+  // copy a version of a tuple into a slot of this tile group. the uninlined
+  // varlen columns are not copied, the new version points to the data of the
+  // source version. only the first 64 columns are shared, and none of an
+  // immutable source.
+  void CopyVersion(const TileGroup *source, const oid_t source_slot_id,
+                   const oid_t tuple_slot_id);
+
+  // the varlen columns whose data a tuple shares with a tuple of another
+  // tile group of the same table, one bit per column id
+  uint64_t GetSharedVarlenColumns(const oid_t tuple_slot_id,
+                                  const TileGroup *other,
+                                  const oid_t other_slot_id) const;
+
+  // move the data of the given shared varlen columns of a tuple from the
+  // pools of the source tile group into the pools of this tile group
+  void AdoptVarlenColumns(const oid_t tuple_slot_id, const TileGroup *source,
+                          const uint64_t columns);
+
   // insert tuple at next available slot in tile if a slot exists
   oid_t InsertTuple(const Tuple *tuple);
 
@@ -123,9 +142,13 @@ class TileGroup : public Printable {
 
   oid_t GetAllocatedTupleCount() const { return num_tuple_slots; }
 
-  TileGroupHeader *GetHeader() const { return tile_group_header; }
+  TileGroupHeader *GetHeader() const { return tile_group_header.get(); }
+
+  // whether the varlen columns are dictionary encoded, see
+  // DataTable::TransformTileGroup()
+  bool IsCompressed() const { return compressed; }
 
-  void SetHeader(TileGroupHeader *header) { tile_group_header = header; }
+  void SetCompressed() { compressed = true; }
 
   unsigned int NumTiles() const { return tiles.size(); }
 
@@ -204,8 +227,9 @@ class TileGroup : public Printable {
   // set of tiles
   std::vector<std::shared_ptr<Tile>> tiles;
 
-  // associated tile group
-  TileGroupHeader *tile_group_header;
+  // associated tile group header. a transformed tile group shares the header
+  // of the tile group it replaces, see DataTable::TransformTileGroup()
+  std::shared_ptr<TileGroupHeader> tile_group_header;
 
   // associated table
   AbstractTable *table;  // this design is fantastic!!!
@@ -221,6 +245,20 @@ class TileGroup : public Printable {
   // column to tile mapping :
   // <column offset> to <tile offset, tile column offset>
   column_map_type column_map;
+
+  // an uninlined varlen column and the offset of its pointer in the tuple
+  struct VarlenColumn {
+    oid_t column_id;
+    oid_t tile_offset;
+    size_t field_offset;
+  };
+
+  // the uninlined varlen columns, ordered by column id
+  std::vector<VarlenColumn> varlen_columns;
+
+  // the distinct values of each varlen column are stored once, in a single
+  // allocation of the pool of the tile
+  bool compressed = false;
 };
 
 }  // End storage namespace
@@ -34,6 +34,12 @@ class TileGroupFactory {
                                  const std::vector<catalog::Schema> &schemas,
                                  const column_map_type &column_map,
                                  int tuple_count);
+
+  // Get a tile group with another layout that shares the header, and so the
+  // versions, of the given tile group. The tiles are left empty.
+  static TileGroup *GetTransformedTileGroup(
+      const TileGroup *tile_group, const std::vector<catalog::Schema> &schemas,
+      const column_map_type &column_map);
 };
 
 }  // End storage namespace
@@ -81,6 +81,8 @@ class TileGroupHeader : public Printable {
     num_tuple_slots = other.num_tuple_slots;
     oid_t val = other.next_tuple_slot;
     next_tuple_slot = val;
+    immutable_cid = other.immutable_cid.load();
+    thaw_cid = other.thaw_cid.load();
 
     return *this;
   }
@@ -133,6 +135,32 @@ class TileGroupHeader : public Printable {
 
   oid_t GetActiveTupleCount() const;
 
+  // A tile group is made immutable once it is full and cold. No version is
+  // placed in its slots afterwards, and the gc keeps its garbage versions
+  // until it is mutable again. Its tiles no longer change once every
+  // transaction that was running at immutable_cid has ended, while the
+  // header keeps tracking the versions.
+  void SetImmutable(const cid_t &immutable_cid) {
+    this->thaw_cid = immutable_cid;
+    this->immutable_cid = immutable_cid;
+  }
+
+  bool IsImmutable() const { return immutable_cid != MAX_CID; }
+
+  cid_t GetImmutableCommitId() const { return immutable_cid; }
+
+  // The tile group may be made mutable again once every transaction that
+  // was running at thaw_cid has ended. Moved forward when the tile group is
+  // replaced by a copy, as the original must not change while it is read.
+  void SetThawCommitId(const cid_t &thaw_cid) { this->thaw_cid = thaw_cid; }
+
+  cid_t GetThawCommitId() const { return thaw_cid; }
+
+  void SetMutable() {
+    immutable_cid = MAX_CID;
+    thaw_cid = MAX_CID;
+  }
+
   //===--------------------------------------------------------------------===//
   // MVCC utilities
   //===--------------------------------------------------------------------===//
@@ -284,6 +312,14 @@ class TileGroupHeader : public Printable {
   std::atomic<oid_t> next_tuple_slot;
 
   Spinlock tile_header_lock;
+
+  // the commit id at which the tile group became immutable, MAX_CID if it
+  // is not
+  std::atomic<cid_t> immutable_cid;
+
+  // the commit id after which the tile group can be made mutable again,
+  // MAX_CID if it is not immutable
+  std::atomic<cid_t> thaw_cid;
 };
 
 }  // End storage namespace
@@ -63,6 +63,15 @@ class TrafficCop {
       int &rows_change, std::string &error_message,
       const size_t thread_id = 0);
 
+  // ExecPrepStmt - Execute a prepared and bound statement, streaming the
+  // result rows into the sink
+  ResultType ExecuteStatement(
+      const std::shared_ptr<Statement> &statement,
+      const std::vector<type::Value> &params, const bool unnamed,
+      std::shared_ptr<stats::QueryMetric::QueryParams> param_stats,
+      executor::ResultSink &sink, int &rows_change, std::string &error_message,
+      const size_t thread_id = 0);
+
   // ExecutePrepStmt - Helper to handle txn-specifics for the plan-tree of a
   // statement
   executor::ExecuteResult ExecuteStatementPlan(
@@ -70,6 +79,10 @@ class TrafficCop {
       std::vector<StatementResult> &result, const std::vector<int> &result_format,
       const size_t thread_id = 0);
 
+  executor::ExecuteResult ExecuteStatementPlan(
+      const planner::AbstractPlan *plan, const std::vector<type::Value> &params,
+      executor::ResultSink &sink, const size_t thread_id = 0);
+
   // InitBindPrepStmt - Prepare and bind a query from a query string
   std::shared_ptr<Statement> PrepareStatement(const std::string &statement_name,
                                               const std::string &query_string,
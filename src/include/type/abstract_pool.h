@@ -33,6 +33,13 @@ public:
   // Returns the provided chunk of memory back into the pool
   virtual void Free(void *ptr) = 0;
 
+  // Hands the provided chunk of memory over to another pool without freeing
+  // it. The other pool must Adopt() it.
+  virtual void Release(void *ptr) = 0;
+
+  // Takes over a chunk of memory released by another pool
+  virtual void Adopt(void *ptr) = 0;
+
 };
 
 }  // namespace type
@@ -66,6 +66,22 @@ public:
     delete [] cptr;
   }
 
+  // Hands the provided chunk of memory over to another pool
+  void Release(void *ptr) {
+    char *cptr = (char *) ptr;
+    pool_lock_.Lock();
+    locations_.erase(cptr);
+    pool_lock_.Unlock();
+  }
+
+  // Takes over a chunk of memory released by another pool
+  void Adopt(void *ptr) {
+    char *cptr = (char *) ptr;
+    pool_lock_.Lock();
+    locations_.insert(cptr);
+    pool_lock_.Unlock();
+  }
+
 public:
 
   // Location list
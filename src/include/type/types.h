@@ -85,7 +85,8 @@ extern int TEST_TUPLES_PER_TILEGROUP;
 enum class GarbageCollectionType {
   INVALID = INVALID_TYPE_ID,
   OFF = 1,  // turn off GC
-  ON = 2    // turn on GC
+  ON = 2,   // turn on GC
+  COOPERATIVE = 3  // turn on GC, and let workers help the gc threads
 };
 
 //===--------------------------------------------------------------------===//
@@ -958,6 +959,12 @@ enum MetricType {
   QUERY_METRIC = 9,
   // Statistics for CPU
   PROCESSOR_METRIC = 10,
+  // Statistics for the compiled query cache
+  QUERY_CACHE_METRIC = 11,
+  // Statistics for version chains and garbage collection
+  GC_METRIC = 12,
+  // Statistics for the connections of the libevent workers
+  CONNECTION_METRIC = 13,
 };
 
 static const int INVALID_FILE_DESCRIPTOR = -1;
@@ -1077,12 +1084,11 @@ std::ostream &operator<<(std::ostream &os, const RWType &type);
 
 enum class GCSetType { COMMITTED, ABORTED };
 
-// block -> offset -> type
-typedef std::unordered_map<oid_t, std::unordered_map<oid_t, RWType>>
-    ReadWriteSet;
+struct GCEntry;
 
-// block -> offset -> is_index_deletion
-typedef std::unordered_map<oid_t, std::unordered_map<oid_t, bool>> GCSet;
+// the garbage versions of a transaction, see GCEntry. the read-write set of a
+// transaction is concurrency::ReadWriteSet
+typedef std::vector<GCEntry> GCSet;
 
 //===--------------------------------------------------------------------===//
 // File Handle
@@ -1181,6 +1187,14 @@ std::string PropertyTypeToString(PropertyType type);
 //===--------------------------------------------------------------------===//
 #define SOCKET_BUFFER_SIZE 8192
 
+// The bytes of result rows buffered before they are written to the socket,
+// while the query is still running
+#define RESULT_BATCH_SIZE (8 * SOCKET_BUFFER_SIZE)
+
+// The milliseconds a query waits for the client to read its result rows
+// before it fails
+#define RESULT_STREAM_TIMEOUT_MS (60 * 1000)
+
 /* byte type */
 typedef unsigned char uchar;
 
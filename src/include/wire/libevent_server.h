@@ -53,6 +53,7 @@ enum ConnState {
   CONN_WRITE,      // State the writes data to the network
   CONN_WAIT,       // State for waiting for some event to happen
   CONN_PROCESS,    // State that runs the wire protocol on received data
+  CONN_EXECUTING,  // State while the execution pool runs a statement
   CONN_CLOSING,    // State for closing the client connection
   CONN_CLOSED,     // State for closed connection
   CONN_INVALID,    // Invalid STate
@@ -73,7 +74,8 @@ enum WriteState {
 /* Libevent Callbacks */
 
 /* Used by a worker thread to receive a new connection from the main thread and
- * launch the event handler */
+ * launch the event handler, or to resume a connection whose packet the
+ * execution pool has executed */
 void WorkerHandleNewConn(evutil_socket_t local_fd, short ev_flags, void *arg);
 
 /* Used by a worker to execute the main event loop for a connection */
@@ -162,6 +164,9 @@ class LibeventSocket {
   Buffer rbuf_;                     // Socket's read buffer
   Buffer wbuf_;                     // Socket's write buffer
   unsigned int next_response_ = 0;  // The next response in the response buffer
+  short listen_flags_ = 0;          // The flags the event is registered with
+  bool execution_status_ = true;    // The result of the packet executed by
+                                    // the execution pool
 
  private:
   // Is the requested amount of data available from the current position in
@@ -171,6 +176,10 @@ class LibeventSocket {
   // Parses out packet size from its header
   void GetSizeFromPktHeader(size_t start_index);
 
+  // Is the whole next packet already in the read buffer? True when the
+  // client pipelines its messages.
+  bool IsPacketAvailable();
+
  public:
   inline LibeventSocket(int sock_fd, short event_flags, LibeventThread *thread,
                         ConnState init_state)
@@ -202,8 +211,21 @@ class LibeventSocket {
 
   WriteState WritePackets();
 
+  // Writes the buffered responses while a query is still running, and waits
+  // until the socket takes them all. Returns false on a write error, or if
+  // the client doesn't read them within RESULT_STREAM_TIMEOUT_MS.
+  bool StreamPackets();
+
   void PrintWriteBuffer();
 
+  // Hands the current packet to the execution pool. The connection is parked
+  // without an event until the worker resumes it.
+  void ExecutePacket(TaskPriorityType priority);
+
+  // Re-arms the event of a parked connection once its packet was executed,
+  // and moves on to writing the responses. Runs on the worker.
+  void ResumeExecution();
+
   void CloseSocket();
 
   void Reset();
@@ -218,6 +240,10 @@ class LibeventSocket {
   // Used to invoke a write into the Socket, returns false if the socket is not
   // ready for write
   WriteState FlushWriteBuffer();
+
+  // Writes the write buffer and the rest of a large packet with one writev,
+  // so the packet isn't copied through the buffer
+  WriteState FlushWriteBufferWithContent(OutputPacket *pkt);
 };
 
 struct LibeventServer {
@@ -265,6 +291,10 @@ struct LibeventServer {
   event_base *GetEventBase() { return base_; }
 
  private:
+  /* Create a socket listening on the port of the server, with SO_REUSEPORT
+   * so that several sockets can share the port */
+  int CreateListenSocket(bool reuse_port);
+
   /* Maintain a global list of connections.
    * Helps reuse connection objects when possible
    */
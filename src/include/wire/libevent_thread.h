@@ -42,6 +42,7 @@ namespace wire {
 
 // Forward Declarations
 struct NewConnQueueItem;
+class LibeventSocket;
 
 class LibeventThread {
  protected:
@@ -98,13 +99,45 @@ class LibeventWorkerThread : public LibeventThread {
   // Notify new connection pipe(receive end)
   int new_conn_receive_fd_;
 
+  // Connections handed to this worker that it has not picked up yet
+  std::atomic<int> queued_connections_;
+
+  // Connections this worker is serving
+  std::atomic<int> active_connections_;
+
+  // Listening socket of this worker, when it accepts its own connections
+  int listen_fd_ = -1;
+
  public:
   /* The queue for new connection requests */
   LockFreeQueue<std::shared_ptr<NewConnQueueItem>> new_conn_queue;
 
+  /* The connections whose packet the execution pool has executed */
+  LockFreeQueue<LibeventSocket *> executed_conn_queue;
+
  public:
   LibeventWorkerThread(const int thread_id);
 
+  // Hand a new connection request to this worker and wake it up,
+  // called by the master thread
+  void EnqueueConnection(std::shared_ptr<NewConnQueueItem> item);
+
+  // Pick up the next connection request handed to this worker
+  bool DequeueConnection(std::shared_ptr<NewConnQueueItem> &item);
+
+  // Start serving an accepted connection on this worker
+  void AddConnection(int conn_fd, short event_flags);
+
+  // Account for a connection of this worker that was closed
+  void RemoveConnection();
+
+  // Start accepting connections on a listening socket of this worker
+  void AddListener(int listen_fd, short event_flags);
+
+  // Hand a connection back to this worker once the execution pool is done
+  // with its packet, called by the execution pool
+  void NotifyExecutionDone(LibeventSocket *conn);
+
   // Getters and setters
   event *GetNewConnEvent() { return this->new_conn_event_; }
 
@@ -113,6 +146,15 @@ class LibeventWorkerThread : public LibeventThread {
   int GetNewConnSendFd() { return this->new_conn_send_fd_; }
 
   int GetNewConnReceiveFd() { return this->new_conn_receive_fd_; }
+
+  int GetListenFd() { return this->listen_fd_; }
+
+  int GetQueuedConnections() { return queued_connections_; }
+
+  int GetActiveConnections() { return active_connections_; }
+
+  // Connections waiting for, or served by, this worker
+  int GetLoad() { return queued_connections_ + active_connections_; }
 };
 
 // a master thread contains multiple worker threads.
@@ -120,14 +162,21 @@ class LibeventMasterThread : public LibeventThread {
  private:
   const int num_threads_;
 
-  // TODO: have a smarter dispatch scheduler
   std::atomic<int> next_thread_id_;  // next thread we dispatched to
 
+  // Dispatch to the worker with the fewest connections instead of
+  // round robin
+  bool least_loaded_;
+
  public:
   LibeventMasterThread(const int num_threads, struct event_base *libevent_base);
 
   void DispatchConnection(int new_conn_fd, short event_flags);
 
+  // Hand a listening socket to a worker, which then accepts its connections
+  // without going through the master
+  void DispatchListener(int thread_id, int listen_fd, short event_flags);
+
   void CloseConnection();
 
   std::vector<std::shared_ptr<LibeventWorkerThread>> &GetWorkerThreads();
@@ -13,6 +13,7 @@
 #pragma once
 
 #include <boost/assign/list_of.hpp>
+#include <functional>
 #include <iostream>
 #include <mutex>
 #include <string>
@@ -22,6 +23,7 @@
 #include "common/cache.h"
 #include "common/portal.h"
 #include "common/statement.h"
+#include "executor/result_sink.h"
 #include "tcop/tcop.h"
 #include "wire/marshal.h"
 
@@ -34,6 +36,43 @@ namespace wire {
 
 typedef std::vector<std::unique_ptr<OutputPacket>> ResponseBuffer;
 
+class PacketManager;
+
+// Encodes the result rows of a query into DATA_ROW packets while the
+// executors produce them, and streams them to the client in batches of
+// RESULT_BATCH_SIZE bytes
+class DataRowSink : public executor::ResultSink {
+ public:
+  DataRowSink(PacketManager &pkt_manager,
+              const std::vector<FieldInfo> &tuple_descriptor,
+              const std::vector<int> &result_format);
+
+  void AddRow(const type::Value *values, uint32_t num_values) override;
+
+  int GetRowCount() const { return row_count_; }
+
+  // Whether the rows could not all be sent, so the query has to fail
+  bool IsFailed() const { return failed_; }
+
+ private:
+  PacketManager &pkt_manager_;
+
+  // The Postgres type each column is described as
+  std::vector<oid_t> field_types_;
+
+  // The format each column is sent in, which is text for the types that
+  // have no binary encoding, whatever the client asked for
+  std::vector<int> result_format_;
+
+  // The bytes of the rows not handed to the socket yet
+  size_t batch_size_ = 0;
+
+  int row_count_ = 0;
+
+  // Set when the rows can't be sent anymore, the rest is dropped
+  bool failed_ = false;
+};
+
 class PacketManager {
  public:
   PacketManager();
@@ -47,6 +86,12 @@ class PacketManager {
    * packet. Avoid flushing the response for extended protocols. */
   bool ProcessPacket(InputPacket* pkt, const size_t thread_id);
 
+  /* Returns the priority to run the packet with on the execution pool, or
+   * INVALID if the packet doesn't run a statement. Doesn't consume the
+   * packet. The statements of a simple query are prepared to look at their
+   * plans, and the execution of the packet runs them. */
+  TaskPriorityType GetExecutionPriority(InputPacket* pkt);
+
   /* Manage the startup packet */
   //  bool ManageStartupPacket();
   void Reset();
@@ -103,6 +148,11 @@ class PacketManager {
   // so that we don't have to new packet each time
   ResponseBuffer responses;
 
+  // Set by the socket to write out the buffered responses while a query is
+  // still running. It waits for the client to read them, and returns false
+  // if the connection failed.
+  std::function<bool()> stream_responses;
+
  private:
   //===--------------------------------------------------------------------===//
   // PROTOCOL HANDLING FUNCTIONS
@@ -115,12 +165,11 @@ class PacketManager {
   // Sends ready for query packet to the frontend
   void SendReadyForQuery(NetworkTransactionStateType txn_status);
 
-  // Sends the attribute headers required by SELECT queries
-  void PutTupleDescriptor(const std::vector<FieldInfo>& tuple_descriptor);
+  // Sends the attribute headers required by SELECT queries, with the format
+  // of each column (text by default)
+  void PutTupleDescriptor(const std::vector<FieldInfo>& tuple_descriptor,
+                          const std::vector<int>& result_format = {});
 
-  // Send each row, one packet at a time, used by SELECT queries
-  void SendDataRows(std::vector<StatementResult>& results, int colcount,
-                    int& rows_affected);
 
   // Used to send a packet that indicates the completion of a query. Also has
   // txn state mgmt
@@ -141,6 +190,12 @@ class PacketManager {
    */
   bool HardcodedExecuteFilter(std::string query_type);
 
+  /* Prepare the statements of a Simple query protocol message ahead of its
+   * execution, up to the first one that isn't a SELECT, INSERT, UPDATE or
+   * DELETE and may change what the statements behind it refer to. Returns
+   * whether all of them were prepared. */
+  bool PrepareQueryStatements(const std::string& query);
+
   /* Execute a Simple query protocol message */
   void ExecQueryMessage(InputPacket* pkt, const size_t thread_id);
 
@@ -166,6 +221,11 @@ class PacketManager {
   // Manage standalone queries
   std::shared_ptr<Statement> unnamed_statement_;
 
+  // The statements of the simple query prepared by GetExecutionPriority(),
+  // one per statement of the query, for ExecQueryMessage() to run
+  std::string prepared_query_;
+  std::vector<std::shared_ptr<Statement>> prepared_query_statements_;
+
   // The result-column format code
   std::vector<int> result_format_;
 
@@ -0,0 +1,301 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// hash_index.cpp
+//
+// Identification: src/index/hash_index.cpp
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "index/hash_index.h"
+
+#include "common/logger.h"
+#include "index/index_key.h"
+#include "index/scan_optimizer.h"
+#include "statistics/stats_aggregator.h"
+#include "storage/tuple.h"
+
+namespace peloton {
+namespace index {
+
+HASH_INDEX_TEMPLATE_ARGUMENTS
+HASH_INDEX_TYPE::HashIndex(IndexMetadata *metadata)
+    :  // Base class
+      Index{metadata},
+      // Key hash function
+      hasher{},
+      // Key equality checker
+      equals{},
+      // Value equality checker
+      value_equals{},
+      container{INITIAL_SIZE, DEFAULT_MINIMUM_LOAD_FACTOR,
+                NO_MAXIMUM_HASHPOWER, hasher, equals} {
+  return;
+}
+
+HASH_INDEX_TEMPLATE_ARGUMENTS
+HASH_INDEX_TYPE::~HashIndex() {}
+
+/*
+ * InsertEntry() - insert a key-value pair into the map
+ *
+ * If the key value pair already exists in the map, just return false
+ */
+HASH_INDEX_TEMPLATE_ARGUMENTS
+bool HASH_INDEX_TYPE::InsertEntry(const storage::Tuple *key,
+                                  ItemPointer *value) {
+  KeyType index_key;
+  index_key.SetFromKey(key);
+
+  bool ret = true;
+
+  // The updater only runs when the key is already there, with its buckets
+  // locked, so the duplicate check and the append are one atomic step
+  container.upsert(index_key, [this, value, &ret](ValueList &value_list) {
+    for (auto existing_value : value_list) {
+      if (value_equals(existing_value, value) == true) {
+        ret = false;
+        return;
+      }
+    }
+
+    value_list.push_back(value);
+  }, ValueList{value});
+
+  if (FLAGS_stats_mode != STATS_TYPE_INVALID) {
+    stats::BackendStatsContext::GetInstance()->IncrementIndexInserts(metadata);
+  }
+
+  return ret;
+}
+
+/*
+ * DeleteEntry() - Removes a key-value pair
+ *
+ * If the key-value pair does not exists yet in the map return false. The key
+ * itself is erased together with its last value.
+ */
+HASH_INDEX_TEMPLATE_ARGUMENTS
+bool HASH_INDEX_TYPE::DeleteEntry(const storage::Tuple *key,
+                                  ItemPointer *value) {
+  KeyType index_key;
+  index_key.SetFromKey(key);
+
+  bool ret = false;
+
+  container.erase_fn(index_key, [this, value, &ret](ValueList &value_list) {
+    for (auto it = value_list.begin(); it != value_list.end(); ++it) {
+      if (value_equals(*it, value) == true) {
+        value_list.erase(it);
+        ret = true;
+        break;
+      }
+    }
+
+    return value_list.empty();
+  });
+
+  if (FLAGS_stats_mode != STATS_TYPE_INVALID) {
+    stats::BackendStatsContext::GetInstance()->IncrementIndexDeletes(
+        ret ? 1 : 0, metadata);
+  }
+
+  return ret;
+}
+
+HASH_INDEX_TEMPLATE_ARGUMENTS
+bool HASH_INDEX_TYPE::CondInsertEntry(
+    const storage::Tuple *key, ItemPointer *value,
+    std::function<bool(const void *)> predicate) {
+  KeyType index_key;
+  index_key.SetFromKey(key);
+
+  bool predicate_satisfied = false;
+  bool ret = true;
+
+  // The predicate test and the insert are done in one atomic step
+  container.upsert(index_key, [this, value, &predicate, &predicate_satisfied,
+                               &ret](ValueList &value_list) {
+    for (auto existing_value : value_list) {
+      if (predicate(existing_value) == true) {
+        predicate_satisfied = true;
+        ret = false;
+        return;
+      }
+    }
+
+    for (auto existing_value : value_list) {
+      if (value_equals(existing_value, value) == true) {
+        ret = false;
+        return;
+      }
+    }
+
+    value_list.push_back(value);
+  }, ValueList{value});
+
+  if (predicate_satisfied == true) {
+    PL_ASSERT(ret == false);
+  }
+
+  if (FLAGS_stats_mode != STATS_TYPE_INVALID) {
+    stats::BackendStatsContext::GetInstance()->IncrementIndexInserts(metadata);
+  }
+
+  return ret;
+}
+
+/*
+ * Scan() - Scans the index using index scan optimizer
+ *
+ * Only point queries can be answered by a lookup. Since a hash index has no
+ * key order, full scans and interval scans return every value in the index
+ * and the scan direction is ignored
+ */
+HASH_INDEX_TEMPLATE_ARGUMENTS
+void HASH_INDEX_TYPE::Scan(
+    UNUSED_ATTRIBUTE const std::vector<type::Value> &value_list,
+    UNUSED_ATTRIBUTE const std::vector<oid_t> &tuple_column_id_list,
+    UNUSED_ATTRIBUTE const std::vector<ExpressionType> &expr_list,
+    ScanDirectionType scan_direction, std::vector<ValueType> &result,
+    const ConjunctionScanPredicate *csp_p) {
+  if (scan_direction == ScanDirectionType::INVALID) {
+    throw Exception("Invalid scan direction \n");
+  }
+
+  LOG_TRACE("Scan() Point Query = %d; Full Scan = %d ", csp_p->IsPointQuery(),
+            csp_p->IsFullIndexScan());
+
+  if (csp_p->IsPointQuery() == true) {
+    KeyType point_query_key;
+    point_query_key.SetFromKey(csp_p->GetPointQueryKey());
+
+    ValueList values;
+    if (container.find(point_query_key, values) == true) {
+      result.insert(result.end(), values.begin(), values.end());
+    }
+
+    if (FLAGS_stats_mode != STATS_TYPE_INVALID) {
+      stats::BackendStatsContext::GetInstance()->IncrementIndexReads(
+          result.size(), metadata);
+    }
+  } else {
+    LOG_TRACE("Hash index %s cannot answer a range scan; scanning all keys",
+              GetName().c_str());
+
+    ScanAllKeys(result);
+  }
+
+  return;
+}
+
+/*
+ * ScanLimit() - Scan the index with predicate and limit/offset
+ *
+ * Without any key order there is no "first" value to push down, so this is
+ * always a normal scan and the caller applies the limit
+ */
+HASH_INDEX_TEMPLATE_ARGUMENTS
+void HASH_INDEX_TYPE::ScanLimit(
+    const std::vector<type::Value> &value_list,
+    const std::vector<oid_t> &tuple_column_id_list,
+    const std::vector<ExpressionType> &expr_list,
+    ScanDirectionType scan_direction, std::vector<ValueType> &result,
+    const ConjunctionScanPredicate *csp_p, UNUSED_ATTRIBUTE uint64_t limit,
+    UNUSED_ATTRIBUTE uint64_t offset) {
+  Scan(value_list, tuple_column_id_list, expr_list, scan_direction, result,
+       csp_p);
+
+  return;
+}
+
+HASH_INDEX_TEMPLATE_ARGUMENTS
+void HASH_INDEX_TYPE::ScanAllKeys(std::vector<ValueType> &result) {
+  {
+    // Holds every bucket lock until the end of the scope
+    auto locked_table = container.lock_table();
+
+    for (const auto &key_values : locked_table) {
+      result.insert(result.end(), key_values.second.begin(),
+                    key_values.second.end());
+    }
+  }
+
+  if (FLAGS_stats_mode != STATS_TYPE_INVALID) {
+    stats::BackendStatsContext::GetInstance()->IncrementIndexReads(
+        result.size(), metadata);
+  }
+
+  return;
+}
+
+HASH_INDEX_TEMPLATE_ARGUMENTS
+void HASH_INDEX_TYPE::ScanKey(const storage::Tuple *key,
+                              std::vector<ValueType> &result) {
+  KeyType index_key;
+  index_key.SetFromKey(key);
+
+  ValueList values;
+  if (container.find(index_key, values) == true) {
+    result.insert(result.end(), values.begin(), values.end());
+  }
+
+  if (FLAGS_stats_mode != STATS_TYPE_INVALID) {
+    stats::BackendStatsContext::GetInstance()->IncrementIndexReads(
+        result.size(), metadata);
+  }
+
+  return;
+}
+
+HASH_INDEX_TEMPLATE_ARGUMENTS
+std::string HASH_INDEX_TYPE::GetTypeName() const { return "Hash"; }
+
+/*
+ * GetMemoryFootprint() - Estimates the memory used by the slots of the table
+ *
+ * Overflow values of keys with more than one value are not included
+ */
+HASH_INDEX_TEMPLATE_ARGUMENTS
+size_t HASH_INDEX_TYPE::GetMemoryFootprint() {
+  return container.bucket_count() * MapType::slot_per_bucket *
+             sizeof(typename MapType::value_type) +
+         container.size() * sizeof(ValueType);
+}
+
+// IMPORTANT: Make sure you don't exceed CompactIntegerKey_MAX_SLOTS
+
+template class HashIndex<CompactIntsKey<1>, ItemPointer *,
+                         CompactIntsHasher<1>, CompactIntsEqualityChecker<1>,
+                         ItemPointerComparator>;
+template class HashIndex<CompactIntsKey<2>, ItemPointer *,
+                         CompactIntsHasher<2>, CompactIntsEqualityChecker<2>,
+                         ItemPointerComparator>;
+template class HashIndex<CompactIntsKey<3>, ItemPointer *,
+                         CompactIntsHasher<3>, CompactIntsEqualityChecker<3>,
+                         ItemPointerComparator>;
+template class HashIndex<CompactIntsKey<4>, ItemPointer *,
+                         CompactIntsHasher<4>, CompactIntsEqualityChecker<4>,
+                         ItemPointerComparator>;
+
+// Generic key
+template class HashIndex<GenericKey<4>, ItemPointer *, GenericHasher<4>,
+                         GenericEqualityChecker<4>, ItemPointerComparator>;
+template class HashIndex<GenericKey<8>, ItemPointer *, GenericHasher<8>,
+                         GenericEqualityChecker<8>, ItemPointerComparator>;
+template class HashIndex<GenericKey<16>, ItemPointer *, GenericHasher<16>,
+                         GenericEqualityChecker<16>, ItemPointerComparator>;
+template class HashIndex<GenericKey<64>, ItemPointer *, GenericHasher<64>,
+                         GenericEqualityChecker<64>, ItemPointerComparator>;
+template class HashIndex<GenericKey<256>, ItemPointer *, GenericHasher<256>,
+                         GenericEqualityChecker<256>, ItemPointerComparator>;
+
+// Tuple key
+template class HashIndex<TupleKey, ItemPointer *, TupleKeyHasher,
+                         TupleKeyEqualityChecker, ItemPointerComparator>;
+
+}  // End index namespace
+}  // End peloton namespace
@@ -12,10 +12,73 @@
 
 #include "index/skiplist.h"
 
+#include "common/exception.h"
+
 namespace peloton {
 namespace index {
 
-// Add your function definitions here
+std::atomic<uint64_t> SkipListBase::global_epoch{1};
+
+std::atomic<size_t> SkipListBase::slot_high_water{0};
+
+SkipListBase::EpochSlot SkipListBase::epoch_slots[MAX_EPOCH_SLOT_COUNT];
+
+thread_local SkipListBase::EpochSlot *SkipListBase::local_slot_p = nullptr;
+
+namespace {
+
+/*
+ * struct EpochSlotReleaser - Gives the slot of a thread back on thread exit
+ */
+struct EpochSlotReleaser {
+  SkipListBase::EpochSlot *slot_p = nullptr;
+
+  ~EpochSlotReleaser() {
+    if (slot_p != nullptr) {
+      slot_p->epoch.store(SkipListBase::INACTIVE_EPOCH);
+      slot_p->in_use.store(false);
+    }
+  }
+};
+
+thread_local EpochSlotReleaser slot_releaser;
+
+}  // End anonymous namespace
+
+SkipListBase::EpochSlot *SkipListBase::RegisterThread() {
+  for (size_t i = 0; i < MAX_EPOCH_SLOT_COUNT; i++) {
+    bool expected = false;
+    if (epoch_slots[i].in_use.compare_exchange_strong(expected, true)) {
+      epoch_slots[i].epoch.store(INACTIVE_EPOCH);
+
+      // Raise the high water mark so that the GC scans this slot
+      size_t high_water = slot_high_water.load();
+      while (high_water < i + 1 &&
+             slot_high_water.compare_exchange_weak(high_water, i + 1) ==
+                 false) {
+      }
+
+      slot_releaser.slot_p = &epoch_slots[i];
+      return &epoch_slots[i];
+    }
+  }
+
+  throw IndexException("Too many threads are using skip list indexes");
+}
+
+uint64_t SkipListBase::AdvanceEpoch() {
+  uint64_t safe_epoch = global_epoch.fetch_add(1) + 1;
+
+  size_t high_water = slot_high_water.load();
+  for (size_t i = 0; i < high_water; i++) {
+    uint64_t epoch = epoch_slots[i].epoch.load();
+    if (epoch < safe_epoch) {
+      safe_epoch = epoch;
+    }
+  }
+
+  return safe_epoch;
+}
 
 }  // End index namespace
 }  // End peloton namespace
@@ -158,6 +158,8 @@ void FrontendLogger::MainLoop(void) {
   // flush any remaining log records
   CollectLogRecordsFromBackendLoggers();
   FlushLogRecords();
+  SyncLogRecords();
+  UpdateGlobalMaxFlushId();
 
   /////////////////////////////////////////////////////////////////////
   // SLEEP MODE
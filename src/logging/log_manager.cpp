@@ -475,26 +475,41 @@ cid_t LogManager::GetPersistentFlushedCommitId() {
 
 void LogManager::FrontendLoggerFlushed() {
   {
-    std::unique_lock<std::mutex> wait_lock(flush_notify_mutex);
-    flush_notify_cv.notify_all();
+    std::lock_guard<std::mutex> wait_lock(flush_notify_mutex);
+
+    // Wake up the commits that are persistent now
+    auto persistent_flushed_commit_id = this->GetPersistentFlushedCommitId();
+    auto end = flush_promises.upper_bound(persistent_flushed_commit_id);
+    for (auto itr = flush_promises.begin(); itr != end; ++itr) {
+      itr->second.set_value();
+    }
+    flush_promises.erase(flush_promises.begin(), end);
   }
 }
 
-void LogManager::WaitForFlush(cid_t cid) {
-  LOG_TRACE("Waiting for flush with %d", (int)cid);
+std::future<void> LogManager::GetFlushFuture(cid_t cid) {
+  std::promise<void> promise;
+  auto future = promise.get_future();
   {
-    std::unique_lock<std::mutex> wait_lock(flush_notify_mutex);
+    std::lock_guard<std::mutex> wait_lock(flush_notify_mutex);
 
-    while (this->GetPersistentFlushedCommitId() < cid) {
+    if (this->GetPersistentFlushedCommitId() >= cid) {
+      promise.set_value();
+    } else {
       LOG_TRACE(
           "Logs up to %lu cid is flushed. %lu cid is not flushed yet. Wait...",
           this->GetPersistentFlushedCommitId(), cid);
-      flush_notify_cv.wait(wait_lock);
+      flush_promises.emplace(cid, std::move(promise));
     }
-    LOG_TRACE(
-        "Flushes done! Can return! Got persistent flushed commit id as %d",
-        (int)this->GetPersistentFlushedCommitId());
   }
+  return future;
+}
+
+void LogManager::WaitForFlush(cid_t cid) {
+  LOG_TRACE("Waiting for flush with %d", (int)cid);
+  GetFlushFuture(cid).wait();
+  LOG_TRACE("Flushes done! Can return! Got persistent flushed commit id as %d",
+            (int)this->GetPersistentFlushedCommitId());
 }
 
 void LogManager::NotifyRecoveryDone() {
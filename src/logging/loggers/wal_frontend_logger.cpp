@@ -14,8 +14,13 @@
 #include <sys/types.h>
 #include <sys/mman.h>
 #include <algorithm>
+#include <condition_variable>
+#include <cstdlib>
 #include <dirent.h>
+#include <memory>
+#include <mutex>
 #include <numeric>
+#include <thread>
 
 #include "catalog/catalog.h"
 #include "catalog/manager.h"
@@ -39,6 +44,7 @@
 #include "storage/tile_group.h"
 #include "storage/tuple.h"
 #include "common/logger.h"
+#include "common/thread_pool.h"
 #include "index/index.h"
 #include "executor/executor_context.h"
 #include "planner/seq_scan_plan.h"
@@ -97,6 +103,9 @@ void WriteAheadFrontendLogger::InitSelf() {
  * @brief close logfile
  */
 WriteAheadFrontendLogger::~WriteAheadFrontendLogger() {
+  // finish the pending syncs
+  StopSyncThread();
+
   // close the log file
   if (cur_file_handle.file != nullptr) {
     int ret = fclose(cur_file_handle.file);
@@ -120,7 +129,7 @@ void WriteAheadFrontendLogger::FlushLogRecords(void) {
 
   // check if we will end up writing something to disk
   will_write_to_file =
-      ((max_collected_commit_id != max_flushed_commit_id) || global_queue_size);
+      ((max_collected_commit_id != max_written_commit_id) || global_queue_size);
 
   if (will_write_to_file) {
     if (cur_file_handle.fd == -1) {
@@ -143,6 +152,7 @@ void WriteAheadFrontendLogger::FlushLogRecords(void) {
     if (!test_mode_ && !no_write_) {
       fwrite(log_buffer->GetData(), sizeof(char), log_buffer->GetSize(),
              cur_file_handle.file);
+      unsynced_bytes += log_buffer->GetSize();
     }
 
     LOG_TRACE("Log buffer get max log id returned %d",
@@ -153,40 +163,25 @@ void WriteAheadFrontendLogger::FlushLogRecords(void) {
       LOG_TRACE("Max log id file so far is %d", (int)this->max_log_id_file);
     }
 
-    // return empty buffer
+    // return empty buffer, the backend logger can refill it while the
+    // records are synced
     auto backend_logger = log_buffer->GetBackendLogger();
     log_buffer->ResetData();
     backend_logger->GrantEmptyBuffer(std::move(log_buffer));
   }
 
-  bool flushed = false;
-
-  if (max_collected_commit_id != max_flushed_commit_id) {
+  if (max_collected_commit_id != max_written_commit_id) {
     if (!test_mode_) {
       PL_ASSERT(cur_file_handle.fd != -1);
       if (cur_file_handle.fd != -1) {
         if (!no_write_) {
           fwrite(delimiter_rec.GetMessage(), sizeof(char),
                  delimiter_rec.GetMessageLength(), cur_file_handle.file);
+          unsynced_bytes += delimiter_rec.GetMessageLength();
         }
         LOG_TRACE("Wrote delimiter to log file with commit_id %ld",
                   this->max_collected_commit_id);
 
-        // by moving the fflush and sync here, we ensure that this file will
-        // have at least 1 delimiter
-        if (Clock::now() > last_flush + flush_frequency) {
-          if (!no_write_) {
-            LoggingUtil::FFlushFsync(cur_file_handle);
-          }
-          last_flush = Clock::now();
-          if (this->max_collected_commit_id > max_flushed_commit_id) {
-            max_flushed_commit_id = this->max_collected_commit_id;
-          }
-
-          fsync_count++;
-          flushed = true;
-        }
-
         if (this->max_collected_commit_id > max_delimiter_file) {
           max_delimiter_file = this->max_collected_commit_id;
           LOG_TRACE("Max_delimiter_file is now %d", (int)max_delimiter_file);
@@ -194,26 +189,140 @@ void WriteAheadFrontendLogger::FlushLogRecords(void) {
 
         if (FileSwitchCondIsTrue()) should_create_new_file = true;
       }
-    } else {
-      if (Clock::now() > last_flush + flush_frequency) {
-        last_flush = Clock::now();
-        if (this->max_collected_commit_id > max_flushed_commit_id) {
-          max_flushed_commit_id = this->max_collected_commit_id;
-        }
-
-        flushed = true;
-      }
     }
+    max_written_commit_id = max_collected_commit_id;
   }
 
-  /* For now, fflush after every iteration of collecting buffers */
   // Clean up the frontend logger's queue
   global_queue.clear();
 
-  if (flushed) {
+  // Only flush after a delimiter, so that the file has at least 1 delimiter
+  if (max_written_commit_id == flush_requested_commit_id ||
+      !GroupCommitIsDue()) {
+    return;
+  }
+
+  last_flush = Clock::now();
+  unsynced_bytes = 0;
+  flush_requested_commit_id = max_written_commit_id;
+
+  if (test_mode_ || no_write_) {
+    if (max_written_commit_id > max_flushed_commit_id) {
+      max_flushed_commit_id = max_written_commit_id;
+    }
+    if (!test_mode_) {
+      fsync_count++;
+    }
+
     // signal that we have flushed
     LogManager::GetInstance().FrontendLoggerFlushed();
+    return;
+  }
+
+  // The sync thread makes the records durable while we collect the next batch
+  RequestSync();
+}
+
+/**
+ * @brief wait until all the records flushed to the file are durable
+ */
+void WriteAheadFrontendLogger::SyncLogRecords(void) {
+  if (test_mode_ || no_write_ || cur_file_handle.fd == -1) {
+    return;
+  }
+
+  // Close the group commit window early
+  if (max_written_commit_id != flush_requested_commit_id) {
+    last_flush = Clock::now();
+    unsynced_bytes = 0;
+    flush_requested_commit_id = max_written_commit_id;
+    RequestSync();
+  }
+
+  std::unique_lock<std::mutex> lock(sync_mutex);
+  synced_cv.wait(lock, [this] {
+    return synced_commit_id == sync_requested_commit_id;
+  });
+}
+
+bool WriteAheadFrontendLogger::GroupCommitIsDue() {
+  if (group_commit_bytes != 0 && unsynced_bytes >= group_commit_bytes) {
+    return true;
+  }
+  return Clock::now() > last_flush + flush_frequency;
+}
+
+void WriteAheadFrontendLogger::RequestSync() {
+  // fsync only covers what reached the file. If the records can't be written,
+  // the commits waiting for them must never be acknowledged.
+  int ret = fflush(cur_file_handle.file);
+  if (ret != 0) {
+    LOG_ERROR("Error occured in fflush(%s)", strerror(errno));
+    exit(EXIT_FAILURE);
+  }
+
+  if (!sync_thread.joinable()) {
+    sync_thread = std::thread(&WriteAheadFrontendLogger::SyncLoop, this);
   }
+
+  {
+    std::lock_guard<std::mutex> lock(sync_mutex);
+    sync_requested_commit_id = flush_requested_commit_id;
+    sync_fd = cur_file_handle.fd;
+  }
+  sync_cv.notify_one();
+}
+
+void WriteAheadFrontendLogger::SyncLoop() {
+  auto &log_manager = LogManager::GetInstance();
+
+  std::unique_lock<std::mutex> lock(sync_mutex);
+  while (true) {
+    sync_cv.wait(lock, [this] {
+      return stop_sync_thread ||
+             sync_requested_commit_id != synced_commit_id;
+    });
+    if (sync_requested_commit_id == synced_commit_id) {
+      break;
+    }
+
+    // Requests made while we sync are served together by the next fsync
+    cid_t commit_id = sync_requested_commit_id;
+    int fd = sync_fd;
+    lock.unlock();
+
+    // A failed fsync leaves it unknown which records are durable, and retrying
+    // may report success for pages the kernel already dropped. The commits
+    // waiting for this fsync must never be acknowledged, so give up.
+    int ret = fsync(fd);
+    if (ret != 0) {
+      LOG_ERROR("Error occured in fsync(%s)", strerror(errno));
+      exit(EXIT_FAILURE);
+    }
+    fsync_count++;
+    if (commit_id > max_flushed_commit_id) {
+      max_flushed_commit_id = commit_id;
+    }
+
+    // signal that we have flushed
+    log_manager.FrontendLoggerFlushed();
+
+    lock.lock();
+    synced_commit_id = commit_id;
+    synced_cv.notify_all();
+  }
+}
+
+void WriteAheadFrontendLogger::StopSyncThread() {
+  if (!sync_thread.joinable()) {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(sync_mutex);
+    stop_sync_thread = true;
+  }
+  sync_cv.notify_one();
+  sync_thread.join();
 }
 
 //===--------------------------------------------------------------------===//
@@ -248,7 +357,7 @@ void WriteAheadFrontendLogger::DoRecovery() {
     // If that is not possible, then wrap up recovery
     auto record_type = GetNextLogRecordTypeForRecovery();
     cid_t log_id = INVALID_CID;
-    TupleRecord *tuple_record;
+    RecoveryRecord *recovery_record = nullptr;
 
     switch (record_type) {
       case LOGRECORD_TYPE_TRANSACTION_BEGIN:
@@ -258,8 +367,8 @@ void WriteAheadFrontendLogger::DoRecovery() {
         TransactionRecord txn_rec(record_type);
         if (LoggingUtil::ReadTransactionRecordHeader(
                 txn_rec, cur_file_handle) == false) {
-          cur_file_handle = INVALID_FILE_HANDLE;
-          return;
+          reached_end_of_log = true;
+          break;
         }
         log_id = txn_rec.GetTransactionId();
         if (log_id <= start_commit_id ||
@@ -271,59 +380,67 @@ void WriteAheadFrontendLogger::DoRecovery() {
       }
       case LOGRECORD_TYPE_WAL_TUPLE_INSERT:
       case LOGRECORD_TYPE_WAL_TUPLE_UPDATE: {
-        tuple_record = new TupleRecord(record_type);
+        recovery_records.emplace_back(record_type);
+        recovery_record = &recovery_records.back();
+        auto &tuple_record = recovery_record->record;
         // Check for torn log write
-        if (LoggingUtil::ReadTupleRecordHeader(*tuple_record,
+        if (LoggingUtil::ReadTupleRecordHeader(tuple_record,
                                                cur_file_handle) == false) {
           LOG_ERROR("Could not read tuple record header.");
-          cur_file_handle = INVALID_FILE_HANDLE;
-          return;
+          reached_end_of_log = true;
+          break;
         }
 
-        log_id = tuple_record->GetTransactionId();
-        auto table = LoggingUtil::GetTable(*tuple_record);
+        log_id = tuple_record.GetTransactionId();
+        auto table = LoggingUtil::GetTable(tuple_record);
 
         if (!table || log_id <= start_commit_id ||
             log_id > global_max_flushed_id_for_recovery) {
           LoggingUtil::SkipTupleRecordBody(cur_file_handle);
           LOG_TRACE("Skip a tuple, log id is %d", (int)log_id);
-          delete tuple_record;
+          recovery_records.pop_back();
           continue;
         }
 
         if (recovery_txn_table.find(log_id) == recovery_txn_table.end()) {
           LOG_ERROR("Insert txd id %d not found in recovery txn table",
                     (int)log_id);
-          cur_file_handle = INVALID_FILE_HANDLE;
-          return;
+          reached_end_of_log = true;
+          break;
         }
 
-        // Read off the tuple record body from the log
-        tuple_record->SetTuple(LoggingUtil::ReadTupleRecordBody(
-            table->GetSchema(), recovery_pool, cur_file_handle));
+        // Only copy the tuple record body off the log, it is deserialized
+        // when the record is replayed
+        if (ReadRecoveryRecordBody(*recovery_record) == false) {
+          LOG_ERROR("Could not read tuple record body.");
+          reached_end_of_log = true;
+          break;
+        }
         num_inserts++;
         break;
       }
       case LOGRECORD_TYPE_WAL_TUPLE_DELETE: {
-        tuple_record = new TupleRecord(record_type);
+        recovery_records.emplace_back(record_type);
+        recovery_record = &recovery_records.back();
+        auto &tuple_record = recovery_record->record;
         // Check for torn log write
-        if (LoggingUtil::ReadTupleRecordHeader(*tuple_record,
+        if (LoggingUtil::ReadTupleRecordHeader(tuple_record,
                                                cur_file_handle) == false) {
-          cur_file_handle = INVALID_FILE_HANDLE;
-          return;
+          reached_end_of_log = true;
+          break;
         }
 
-        log_id = tuple_record->GetTransactionId();
+        log_id = tuple_record.GetTransactionId();
         if (log_id <= start_commit_id ||
             log_id > global_max_flushed_id_for_recovery) {
-          delete tuple_record;
+          recovery_records.pop_back();
           continue;
         }
         if (recovery_txn_table.find(log_id) == recovery_txn_table.end()) {
           LOG_TRACE("Delete txd id %d not found in recovery txn table",
                     (int)log_id);
-          cur_file_handle = INVALID_FILE_HANDLE;
-          return;
+          reached_end_of_log = true;
+          break;
         }
         break;
       }
@@ -341,7 +458,7 @@ void WriteAheadFrontendLogger::DoRecovery() {
         case LOGRECORD_TYPE_TRANSACTION_COMMIT:
           PL_ASSERT(log_id != INVALID_CID);
 
-          // Now directly commit this transaction. This is safe because we
+          // Now queue this transaction for replay. This is safe because we
           // reject commit ids that appear
           // after the persistent commit id before coming here (in the switch
           // case above).
@@ -351,8 +468,7 @@ void WriteAheadFrontendLogger::DoRecovery() {
         case LOGRECORD_TYPE_WAL_TUPLE_INSERT:
         case LOGRECORD_TYPE_WAL_TUPLE_DELETE:
         case LOGRECORD_TYPE_WAL_TUPLE_UPDATE:
-          recovery_txn_table[tuple_record->GetTransactionId()].push_back(
-              tuple_record);
+          recovery_txn_table[log_id].push_back(recovery_record);
           break;
         case LOGRECORD_TYPE_ITERATION_DELIMITER: {
           // Do nothing if we hit the delimiter, because the delimiters help
@@ -369,6 +485,10 @@ void WriteAheadFrontendLogger::DoRecovery() {
     }
   }
 
+  // Replay the committed transactions, one table per thread. A torn record
+  // ends the log, the transactions committed before it are still replayed.
+  ReplayCommittedRecords();
+
   // Finally, abort ACTIVE transactions in recovery_txn_table
   AbortActiveTransactions();
 
@@ -416,6 +536,7 @@ bool WriteAheadFrontendLogger::RecoverTableIndexHelper(
   std::vector<oid_t> column_ids;
   column_ids.resize(schema->GetColumnCount());
   std::iota(column_ids.begin(), column_ids.end(), 0);
+  size_t visible_tuple_count = 0;
 
   oid_t current_tile_group_offset = START_OID;
   auto table_tile_group_count = target_table->GetTileGroupCount();
@@ -436,31 +557,24 @@ bool WriteAheadFrontendLogger::RecoverTableIndexHelper(
       continue;
     }
 
-    auto tile_group_id = logical_tile->GetColumnInfo(0)
-                             .base_tile->GetTileGroup()
-                             ->GetTileGroupId();
-    LOG_TRACE("Retrieved tile group %u", tile_group_id);
+    LOG_TRACE("Retrieved tile group %u",
+              logical_tile->GetColumnInfo(0)
+                  .base_tile->GetTileGroup()
+                  ->GetTileGroupId());
 
-    // Go over the logical tile
-    for (oid_t tuple_id : *logical_tile) {
-      expression::ContainerTuple<executor::LogicalTile> cur_tuple(
-          logical_tile.get(), tuple_id);
-
-      // Index update
-      {
-        // construct a physical tuple from the logical tuple
-        std::unique_ptr<storage::Tuple> tuple(new storage::Tuple(schema, true));
-        for (auto column_id : column_ids) {
-          type::Value val = cur_tuple.GetValue(column_id);
-          tuple->SetValue(column_id, val, recovery_pool);
-        }
-
-        ItemPointer location(tile_group_id, tuple_id);
-        InsertIndexEntry(tuple.get(), target_table, location);
-      }
-    }
+    // The index entries themselves are not inserted (see InsertIndexEntry),
+    // so only count the visible tuples instead of materializing them
+    visible_tuple_count += logical_tile->GetTupleCount();
     current_tile_group_offset++;
   }
+
+  // Bump the indexes' number of tuples once for the whole table
+  auto index_count = target_table->GetIndexCount();
+  for (oid_t index_itr = 0; index_itr < index_count; index_itr++) {
+    auto index = target_table->GetIndex(index_itr);
+    if (index == nullptr) continue;
+    index->IncreaseNumberOfTuplesBy(visible_tuple_count);
+  }
   return true;
 }
 
@@ -494,47 +608,36 @@ void WriteAheadFrontendLogger::InsertIndexEntry(storage::Tuple *tuple,
  * @brief Add new txn to recovery table
  */
 void WriteAheadFrontendLogger::AbortActiveTransactions() {
-  for (auto it = recovery_txn_table.begin(); it != recovery_txn_table.end();
-       it++) {
+  // The records of active transactions are released with the other recovery
+  // records, there is nothing to undo
+  if (!recovery_txn_table.empty()) {
     LOG_TRACE("Aborting some active transactions!");
-    for (auto it2 = it->second.begin(); it2 != it->second.end(); it2++) {
-      delete *it2;
-    }
   }
   recovery_txn_table.clear();
+  recovery_records.clear();
+  recovery_arena.clear();
+  recovery_arena_cursor = nullptr;
+  recovery_arena_left = 0;
 }
 
 /**
  * @brief Add new txn to recovery table
  */
 void WriteAheadFrontendLogger::StartTransactionRecovery(cid_t commit_id) {
-  std::vector<TupleRecord *> tuple_recs;
-  recovery_txn_table[commit_id] = tuple_recs;
+  recovery_txn_table[commit_id].clear();
 }
 
 /**
- * @brief move tuples from current txn to recovery txn so that we can commit
- * them later
+ * @brief move the records of the committed txn to the replay queues of their
+ * tables, so that we can replay them later in commit order
  * @param recovery txn
  */
 void WriteAheadFrontendLogger::CommitTransactionRecovery(cid_t commit_id) {
-  std::vector<TupleRecord *> &tuple_records = recovery_txn_table[commit_id];
-  for (auto it = tuple_records.begin(); it != tuple_records.end(); it++) {
-    TupleRecord *curr = *it;
-    switch (curr->GetType()) {
-      case LOGRECORD_TYPE_WAL_TUPLE_INSERT:
-        InsertTuple(curr);
-        break;
-      case LOGRECORD_TYPE_WAL_TUPLE_UPDATE:
-        UpdateTuple(curr);
-        break;
-      case LOGRECORD_TYPE_WAL_TUPLE_DELETE:
-        DeleteTuple(curr);
-        break;
-      default:
-        continue;
-    }
-    delete curr;
+  auto &recovery_txn_records = recovery_txn_table[commit_id];
+  for (auto recovery_record : recovery_txn_records) {
+    auto &record = recovery_record->record;
+    replay_queues[std::make_pair(record.GetDatabaseOid(), record.GetTableId())]
+        .push_back(recovery_record);
   }
   max_cid = commit_id + 1;
   recovery_txn_table.erase(commit_id);
@@ -642,35 +745,152 @@ void UpdateTupleHelper(oid_t &max_tg, cid_t commit_id, oid_t db_id,
 }
 
 /**
- * @brief read tuple record from log file and add them tuples to recovery txn
- * @param recovery txn
+ * @brief copy the serialized tuple of the record from the log file into the
+ * recovery arena
+ * @param recovery record
  */
-void WriteAheadFrontendLogger::InsertTuple(TupleRecord *record) {
-  InsertTupleHelper(max_oid, record->GetTransactionId(),
-                    record->GetDatabaseOid(), record->GetTableId(),
-                    record->GetInsertLocation(), record->GetTuple());
-}
+bool WriteAheadFrontendLogger::ReadRecoveryRecordBody(
+    RecoveryRecord &recovery_record) {
+  // Check if the frame is broken
+  size_t body_size = LoggingUtil::GetNextFrameSize(cur_file_handle);
+  if (body_size == 0) {
+    return false;
+  }
 
-/**
- * @brief read tuple record from log file and add them tuples to recovery txn
- * @param recovery txn
- */
-void WriteAheadFrontendLogger::DeleteTuple(TupleRecord *record) {
-  DeleteTupleHelper(max_oid, record->GetTransactionId(),
-                    record->GetDatabaseOid(), record->GetTableId(),
-                    record->GetDeleteLocation());
+  // Start a new chunk if the body does not fit in the current one. Bodies
+  // larger than a chunk get a chunk of their own.
+  if (body_size > recovery_arena_left) {
+    size_t chunk_size = std::max(body_size, recovery_arena_chunk_size);
+    recovery_arena.emplace_back(new char[chunk_size]);
+    recovery_arena_cursor = recovery_arena.back().get();
+    recovery_arena_left = chunk_size;
+  }
+
+  size_t ret =
+      fread(recovery_arena_cursor, 1, body_size, cur_file_handle.file);
+  if (ret != body_size) {
+    LOG_ERROR("Error occured in fread ");
+    return false;
+  }
+
+  recovery_record.body = recovery_arena_cursor;
+  recovery_record.body_size = body_size;
+  recovery_arena_cursor += body_size;
+  recovery_arena_left -= body_size;
+  return true;
 }
 
 /**
- * @brief read tuple record from log file and add them tuples to recovery txn
- * @param recovery txn
+ * @brief replay the records of the committed txns. The records of a table are
+ * replayed in commit order by a single thread, and the tables are spread over
+ * the workers of the global thread pool.
  */
+void WriteAheadFrontendLogger::ReplayCommittedRecords() {
+  if (replay_queues.empty()) {
+    return;
+  }
+
+  std::vector<std::vector<RecoveryRecord *> *> queues;
+  for (auto &entry : replay_queues) {
+    queues.push_back(&entry.second);
+  }
+
+  std::atomic<size_t> next_queue(0);
+  std::mutex max_oid_mutex;
+  auto replay = [this, &queues, &next_queue, &max_oid_mutex]() {
+    auto catalog = catalog::Catalog::GetInstance();
+    oid_t max_tg = 0;
+    size_t queue_itr;
+    while ((queue_itr = next_queue.fetch_add(1)) < queues.size()) {
+      auto &queue = *queues[queue_itr];
+      auto &first_record = queue.front()->record;
+      auto db = catalog->GetDatabaseWithOid(first_record.GetDatabaseOid());
+      PL_ASSERT(db);
+      auto table = db->GetTableWithOid(first_record.GetTableId());
+      if (!table) {
+        continue;
+      }
+      auto schema = table->GetSchema();
+
+      for (auto recovery_record : queue) {
+        auto &record = recovery_record->record;
+        switch (record.GetType()) {
+          case LOGRECORD_TYPE_WAL_TUPLE_INSERT:
+            InsertTupleHelper(max_tg, record.GetTransactionId(),
+                              record.GetDatabaseOid(), record.GetTableId(),
+                              record.GetInsertLocation(),
+                              LoggingUtil::DeserializeTupleRecordBody(
+                                  schema, recovery_pool, recovery_record->body,
+                                  recovery_record->body_size));
+            break;
+          case LOGRECORD_TYPE_WAL_TUPLE_UPDATE:
+            UpdateTupleHelper(max_tg, record.GetTransactionId(),
+                              record.GetDatabaseOid(), record.GetTableId(),
+                              record.GetDeleteLocation(),
+                              record.GetInsertLocation(),
+                              LoggingUtil::DeserializeTupleRecordBody(
+                                  schema, recovery_pool, recovery_record->body,
+                                  recovery_record->body_size));
+            break;
+          case LOGRECORD_TYPE_WAL_TUPLE_DELETE:
+            DeleteTupleHelper(max_tg, record.GetTransactionId(),
+                              record.GetDatabaseOid(), record.GetTableId(),
+                              record.GetDeleteLocation());
+            break;
+          default:
+            break;
+        }
+      }
+    }
+
+    std::lock_guard<std::mutex> lock(max_oid_mutex);
+    if (max_oid < max_tg) {
+      max_oid = max_tg;
+    }
+  };
+
+  // The calling thread replays tables too, the others are tasks of the global
+  // thread pool. A task that only starts once the calling thread ran out of
+  // tables has nothing left to do, so the calling thread doesn't wait for it.
+  struct ReplayProgress {
+    std::mutex mutex;
+    std::condition_variable done_cv;
+    // the tasks that are replaying on a thread of the pool
+    size_t running_tasks = 0;
+    // set once the calling thread is done, tasks that start later quit
+    bool closed = false;
+  };
+  auto progress = std::make_shared<ReplayProgress>();
+
+  size_t task_count =
+      std::min<size_t>(thread_pool.GetPoolSize(), queues.size() - 1);
+  LOG_TRACE("Replaying %lu tables with %lu pool tasks", queues.size(),
+            task_count);
+  for (size_t task_itr = 0; task_itr < task_count; task_itr++) {
+    thread_pool.SubmitTask([progress, &replay] {
+      {
+        std::lock_guard<std::mutex> lock(progress->mutex);
+        if (progress->closed) {
+          return;
+        }
+        progress->running_tasks++;
+      }
+      replay();
+      std::lock_guard<std::mutex> lock(progress->mutex);
+      progress->running_tasks--;
+      progress->done_cv.notify_all();
+    });
+  }
+  replay();
 
-void WriteAheadFrontendLogger::UpdateTuple(TupleRecord *record) {
-  UpdateTupleHelper(max_oid, record->GetTransactionId(),
-                    record->GetDatabaseOid(), record->GetTableId(),
-                    record->GetDeleteLocation(), record->GetInsertLocation(),
-                    record->GetTuple());
+  {
+    std::unique_lock<std::mutex> lock(progress->mutex);
+    progress->closed = true;
+    progress->done_cv.wait(
+        lock, [&progress] { return progress->running_tasks == 0; });
+  }
+
+  replay_queues.clear();
 }
 
 //===--------------------------------------------------------------------===//
@@ -884,6 +1104,9 @@ void WriteAheadFrontendLogger::CreateNewLogFile(bool close_old_file) {
     LogFile *cur_log_file_object = log_files_[file_list_size - 1];
 
     if (file_list_size != 0) {
+      // the sync thread must be done with the old file
+      SyncLogRecords();
+
       // TODO check return values of all these operations!
       fseek(cur_file_handle.file, 0, SEEK_SET);
 
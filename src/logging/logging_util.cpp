@@ -278,6 +278,12 @@ storage::Tuple *LoggingUtil::ReadTupleRecordBody(const catalog::Schema *schema,
     LOG_ERROR("Error occured in fread ");
   }
 
+  return DeserializeTupleRecordBody(schema, pool, body, body_size);
+}
+
+storage::Tuple *LoggingUtil::DeserializeTupleRecordBody(
+    const catalog::Schema *schema, type::AbstractPool *pool, const char *body,
+    size_t body_size) {
   CopySerializeInput tuple_body(body, body_size);
 
   // We create a tuple based on the message
@@ -31,6 +31,11 @@ extern size_t peloton_data_file_size;
 
 extern int64_t peloton_wait_timeout;
 
+// Group commit window
+extern int peloton_flush_frequency_micros;
+
+extern int peloton_group_commit_bytes;
+
 // Flush mode (for NVM WBL)
 extern int peloton_flush_mode;
 
@@ -63,11 +68,23 @@ void RunBenchmark() {
   peloton_wait_timeout = state.wait_timeout;
   peloton_flush_mode = state.flush_mode;
   peloton_pcommit_latency = state.pcommit_latency;
+  peloton_flush_frequency_micros = state.group_commit_window;
+  peloton_group_commit_bytes = state.group_commit_bytes;
 
+  //===--------------------------------------------------------------------===//
+  // GROUP COMMIT
+  //===--------------------------------------------------------------------===//
+  if (state.experiment_type == EXPERIMENT_TYPE_GROUP_COMMIT) {
+    // Only measure the commit throughput under the given window
+    PrepareLogFile();
+
+    WriteGroupCommitOutput();
+  }
   //===--------------------------------------------------------------------===//
   // WAL
   //===--------------------------------------------------------------------===//
-  if (logging::LoggingUtil::IsBasedOnWriteAheadLogging(peloton_logging_mode)) {
+  else if (logging::LoggingUtil::IsBasedOnWriteAheadLogging(
+               peloton_logging_mode)) {
     // Prepare a simple log file
     PrepareLogFile();
 
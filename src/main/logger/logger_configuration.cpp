@@ -41,6 +41,8 @@ void Usage(FILE* out) {
           "   -q --pcommit-latency   :  pcommit latency \n"
           "   -v --flush-mode        :  Flush mode \n"
           "   -r --commit-interval   :  Group commit interval \n"
+          "   -W --group-commit-window :  Group commit window (us) \n"
+          "   -Z --group-commit-bytes  :  Group commit window (bytes) \n"
           "   -j --log-dir           :  Log directory\n"
           "   -y --benchmark-type    :  Benchmark type \n");
 }
@@ -54,6 +56,8 @@ static struct option opts[] = {
     {"pcommit-latency", optional_argument, NULL, 'q'},
     {"flush-mode", optional_argument, NULL, 'v'},
     {"commit-interval", optional_argument, NULL, 'r'},
+    {"group-commit-window", optional_argument, NULL, 'W'},
+    {"group-commit-bytes", optional_argument, NULL, 'Z'},
     {"benchmark-type", optional_argument, NULL, 'y'},
     {"log-dir", optional_argument, NULL, 'j'},
     {NULL, 0, NULL, 0}};
@@ -98,6 +102,8 @@ std::string ExperimentTypeToString(ExperimentType type) {
       return "STORAGE";
     case EXPERIMENT_TYPE_LATENCY:
       return "LATENCY";
+    case EXPERIMENT_TYPE_GROUP_COMMIT:
+      return "GROUP_COMMIT";
 
     default:
       LOG_ERROR("Invalid experiment_type :: %d", type);
@@ -149,7 +155,7 @@ static void ValidateDataFileSize(const configuration& state) {
 }
 
 static void ValidateExperimentType(const configuration& state) {
-  if (state.experiment_type < 0 || state.experiment_type > 4) {
+  if (state.experiment_type < 0 || state.experiment_type > 5) {
     LOG_ERROR("Invalid experiment_type :: %d", state.experiment_type);
     exit(EXIT_FAILURE);
   }
@@ -167,6 +173,21 @@ static void ValidateWaitTimeout(const configuration& state) {
   LOG_INFO("wait_timeout :: %d", state.wait_timeout);
 }
 
+static void ValidateGroupCommitWindow(const configuration& state) {
+  if (state.group_commit_window < 0) {
+    LOG_ERROR("Invalid group_commit_window :: %d", state.group_commit_window);
+    exit(EXIT_FAILURE);
+  }
+
+  if (state.group_commit_bytes < 0) {
+    LOG_ERROR("Invalid group_commit_bytes :: %d", state.group_commit_bytes);
+    exit(EXIT_FAILURE);
+  }
+
+  LOG_INFO("group_commit_window :: %d us, %d bytes", state.group_commit_window,
+           state.group_commit_bytes);
+}
+
 static void ValidateFlushMode(const configuration& state) {
   if (state.flush_mode <= 0 || state.flush_mode >= 3) {
     LOG_ERROR("Invalid flush_mode :: %d", state.flush_mode);
@@ -227,6 +248,8 @@ void ParseArguments(int argc, char* argv[], configuration& state) {
 
   state.experiment_type = EXPERIMENT_TYPE_THROUGHPUT;
   state.wait_timeout = 200;
+  state.group_commit_window = 0;
+  state.group_commit_bytes = 0;
   state.benchmark_type = BENCHMARK_TYPE_YCSB;
   state.flush_mode = 2;
   state.nvm_latency = 0;
@@ -265,10 +288,11 @@ void ParseArguments(int argc, char* argv[], configuration& state) {
   // Parse args
   while (1) {
     int idx = 0;
-    // logger - hs:x:f:l:t:q:v:r:y:
+    // logger - hs:x:f:l:t:q:v:r:y:j:W:Z:
     // ycsb   - hemgi:k:d:p:b:c:o:u:z:n:
     // tpcc   - heagi:k:d:p:b:w:n:
-    int c = getopt_long(argc, argv, "hs:x:f:l:t:q:v:r:y:emgi:k:d:p:b:c:o:u:z:n:aw:j:",
+    int c = getopt_long(argc, argv,
+                        "hs:x:f:l:t:q:v:r:y:emgi:k:d:p:b:c:o:u:z:n:aw:j:W:Z:",
                         opts, &idx);
 
     if (c == -1) break;
@@ -301,6 +325,12 @@ void ParseArguments(int argc, char* argv[], configuration& state) {
       case 'r':
         state.wait_timeout = atoi(optarg);
         break;
+      case 'W':
+        state.group_commit_window = atoi(optarg);
+        break;
+      case 'Z':
+        state.group_commit_bytes = atoi(optarg);
+        break;
       case 'y':
         state.benchmark_type = (BenchmarkType)atoi(optarg);
         break;
@@ -401,6 +431,7 @@ void ParseArguments(int argc, char* argv[], configuration& state) {
   ValidateDataFileSize(state);
   ValidateLogFileDir(state);
   ValidateWaitTimeout(state);
+  ValidateGroupCommitWindow(state);
   ValidateFlushMode(state);
   ValidateNVMLatency(state);
   ValidatePCOMMITLatency(state);
@@ -81,6 +81,34 @@ void WriteOutput() {
   out.flush();
 }
 
+void WriteGroupCommitOutput() {
+  double throughput = 0;
+  if (state.benchmark_type == BENCHMARK_TYPE_YCSB) {
+    throughput = ycsb::state.throughput;
+  } else if (state.benchmark_type == BENCHMARK_TYPE_TPCC) {
+    throughput = tpcc::state.throughput;
+  }
+
+  auto &log_manager = logging::LogManager::GetInstance();
+  size_t fsync_count = 0;
+  if (log_manager.ContainsFrontendLogger()) {
+    fsync_count = log_manager.GetFrontendLogger(0)->GetFsyncCount();
+  }
+
+  LOG_INFO("----------------------------------------------------------");
+  LOG_INFO("group commit window: %d us %d bytes :: %lf commits/sec, %lu fsyncs",
+           state.group_commit_window, state.group_commit_bytes, throughput,
+           fsync_count);
+
+  // One line per run, so that runs with different windows can be compared
+  std::ofstream out("outputfile-group-commit.summary", std::ofstream::app);
+  out << state.group_commit_window << " ";
+  out << state.group_commit_bytes << " ";
+  out << throughput << " ";
+  out << fsync_count << "\n";
+  out.flush();
+}
+
 std::string GetFilePath(std::string directory_path, std::string file_name) {
   std::string file_path = directory_path;
 
@@ -219,6 +247,27 @@ finish:
   return ret;
 }
 
+// Get the total size (in bytes) of the regular files under the directory
+size_t GetDirectorySize(const char* dir) {
+  size_t size = 0;
+  char* files[] = {(char*)dir, NULL};
+
+  FTS* ftsp = fts_open(files, FTS_NOCHDIR | FTS_PHYSICAL | FTS_XDEV, NULL);
+  if (!ftsp) {
+    return 0;
+  }
+
+  FTSENT* curr;
+  while ((curr = fts_read(ftsp))) {
+    if (curr->fts_info == FTS_F) {
+      size += curr->fts_statp->st_size;
+    }
+  }
+
+  fts_close(ftsp);
+  return size;
+}
+
 void CleanUpLogDirectory() {
   if (chdir(state.log_file_dir.c_str())) {
     LOG_ERROR("Could not change directory");
@@ -363,6 +412,15 @@ void DoRecovery() {
   std::thread thread;
   std::thread cp_thread;
 
+  // Size of the log that is replayed
+  size_t log_size = 0;
+  if (logging::LoggingUtil::IsBasedOnWriteAheadLogging(peloton_logging_mode)) {
+    std::string wal_directory_path =
+        state.log_file_dir + "/" +
+        logging::WriteAheadFrontendLogger::wal_directory_path;
+    log_size = GetDirectorySize(wal_directory_path.c_str());
+  }
+
   timer.Start();
 
   // Do recovery
@@ -394,6 +452,12 @@ void DoRecovery() {
 
   // Recovery time (in ms)
   LOG_INFO("recovery time: %lf", timer.GetDuration());
+
+  // Recovery throughput (in MB/s)
+  if (log_size > 0 && timer.GetDuration() > 0) {
+    LOG_INFO("recovery throughput: %lf MB/s",
+             (log_size / (1024.0 * 1024.0)) / (timer.GetDuration() / 1000.0));
+  }
 }
 
 //===--------------------------------------------------------------------===//
@@ -21,6 +21,7 @@
 
 #include "gc/gc_manager_factory.h"
 #include "concurrency/epoch_manager_factory.h"
+#include "concurrency/transaction_manager_factory.h"
 
 namespace peloton {
 namespace benchmark {
@@ -34,11 +35,15 @@ void RunBenchmark() {
   if (state.gc_mode == false) {
     gc::GCManagerFactory::Configure(0);
   } else {
-    gc::GCManagerFactory::Configure(state.gc_backend_count);
+    gc::GCManagerFactory::Configure(state.gc_backend_count,
+                                    state.gc_cooperative);
   }
   
   concurrency::EpochManagerFactory::Configure(state.epoch);
 
+  concurrency::TransactionManagerFactory::Configure(
+      ConcurrencyType::TIMESTAMP_ORDERING, state.isolation);
+
   std::unique_ptr<std::thread> epoch_thread;
   std::vector<std::unique_ptr<std::thread>> gc_threads;
 
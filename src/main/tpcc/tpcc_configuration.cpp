@@ -36,8 +36,10 @@ void Usage(FILE *out) {
           "   -a --affinity          :  enable client affinity \n"
           "   -g --gc_mode           :  enable garbage collection \n"
           "   -n --gc_backend_count  :  # of gc backends \n"
+          "   -r --gc_cooperative    :  let workers help the gc (with -g) \n"
           "   -l --loader_count      :  # of loaders \n"
           "   -y --epoch             :  epoch type: centralized or decentralized \n"
+          "   -s --isolation         :  full (default), snapshot, repeatable_read \n"
   );
 }
 
@@ -52,8 +54,10 @@ static struct option opts[] = {
     { "affinity", no_argument, NULL, 'a' },
     { "gc_mode", no_argument, NULL, 'g' },
     { "gc_backend_count", optional_argument, NULL, 'n' },
+    { "gc_cooperative", no_argument, NULL, 'r' },
     { "loader_count", optional_argument, NULL, 'n' },
     { "epoch", optional_argument, NULL, 'y' },
+    { "isolation", optional_argument, NULL, 's' },
     { NULL, 0, NULL, 0 }
 };
 
@@ -123,6 +127,7 @@ void ParseArguments(int argc, char *argv[], configuration &state) {
   // Default Values
   state.index = IndexType::BWTREE;
   state.epoch = EpochType::DECENTRALIZED_EPOCH;
+  state.isolation = IsolationLevelType::FULL;
   state.scale_factor = 1;
   state.duration = 10;
   state.profile_duration = 1;
@@ -132,13 +137,14 @@ void ParseArguments(int argc, char *argv[], configuration &state) {
   state.affinity = false;
   state.gc_mode = false;
   state.gc_backend_count = 1;
+  state.gc_cooperative = false;
   state.loader_count = 1;
 
 
   // Parse args
   while (1) {
     int idx = 0;
-    int c = getopt_long(argc, argv, "heagi:k:d:p:b:w:n:l:y:", opts, &idx);
+    int c = getopt_long(argc, argv, "heagri:k:d:p:b:w:n:l:y:s:", opts, &idx);
 
     if (c == -1) break;
 
@@ -163,6 +169,20 @@ void ParseArguments(int argc, char *argv[], configuration &state) {
         }
         break;
       }
+      case 's': {
+        char *isolation = optarg;
+        if (strcmp(isolation, "full") == 0) {
+          state.isolation = IsolationLevelType::FULL;
+        } else if (strcmp(isolation, "snapshot") == 0) {
+          state.isolation = IsolationLevelType::SNAPSHOT;
+        } else if (strcmp(isolation, "repeatable_read") == 0) {
+          state.isolation = IsolationLevelType::REPEATABLE_READ;
+        } else {
+          LOG_ERROR("Unknown isolation level: %s", isolation);
+          exit(EXIT_FAILURE);
+        }
+        break;
+      }
       case 'l':
         state.loader_count = atoi(optarg);
         break;
@@ -190,6 +210,9 @@ void ParseArguments(int argc, char *argv[], configuration &state) {
       case 'g':
         state.gc_mode = true;
         break;
+      case 'r':
+        state.gc_cooperative = true;
+        break;
       case 'n':
         state.gc_backend_count = atoi(optarg);
         break;
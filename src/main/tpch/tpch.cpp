@@ -31,13 +31,15 @@ void Usage(FILE *out) {
           "   -n --num-runs          :  the number of runs to execute for each query \n"
           "   -s --suffix            :  input file suffix \n"
           "   -d --dict-encode       :  dictionary encode \n"
-          "   -q --queries           :  comma-separated list of queries to run (i.g., 1,14 for Q1 and Q14) \n");
+          "   -q --queries           :  comma-separated list of queries to run (i.g., 1,14 for Q1 and Q14) \n"
+          "   -t --threads           :  maximum number of threads to scale queries up to \n");
 }
 
 static struct option opts[] = {
     {"input-dir", required_argument, NULL, 'i'},
     {"dict-encode", optional_argument, NULL, 'd'},
     {"queries", optional_argument, NULL, 'q'},
+    {"threads", optional_argument, NULL, 't'},
     {NULL, 0, NULL, 0}};
 
 void ParseArguments(int argc, char **argv, Configuration &config) {
@@ -46,7 +48,7 @@ void ParseArguments(int argc, char **argv, Configuration &config) {
   // Parse args
   while (1) {
     int idx = 0;
-    int c = getopt_long(argc, argv, "hi:nsdq:", opts, &idx);
+    int c = getopt_long(argc, argv, "hi:nsdq:t:", opts, &idx);
 
     if (c == -1) break;
 
@@ -69,6 +71,11 @@ void ParseArguments(int argc, char **argv, Configuration &config) {
         config.SetRunnableQueries(csv_queries);
         break;
       }
+      case 't': {
+        char *input = optarg;
+        config.max_threads = static_cast<uint32_t>(std::atoi(input));
+        break;
+      }
       case 'h': {
         Usage(stderr);
         exit(EXIT_FAILURE);
@@ -89,6 +96,7 @@ void ParseArguments(int argc, char **argv, Configuration &config) {
   LOG_INFO("Input directory   : '%s'", config.data_dir.c_str());
   LOG_INFO("Dictionary encode : %s",
            config.dictionary_encode ? "true" : "false");
+  LOG_INFO("Max threads       : %u", config.max_threads);
   for (uint32_t i = 0; i < 22; i++) {
     LOG_INFO("Run query %u : %s", i + 1,
              config.queries_to_run[i] ? "true" : "false");
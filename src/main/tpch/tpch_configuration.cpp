@@ -14,6 +14,8 @@
 
 #include <sys/stat.h>
 
+#include <algorithm>
+
 #include "common/logger.h"
 
 namespace peloton {
@@ -112,6 +114,15 @@ bool Configuration::ShouldRunQuery(QueryId qid) const {
   return queries_to_run[static_cast<uint32_t>(qid)];
 }
 
+std::vector<uint32_t> Configuration::GetThreadCounts() const {
+  std::vector<uint32_t> thread_counts;
+  for (uint32_t num_threads = 1; num_threads < max_threads; num_threads *= 2) {
+    thread_counts.push_back(num_threads);
+  }
+  thread_counts.push_back(std::max(max_threads, 1u));
+  return thread_counts;
+}
+
 }  // namespace tpch
 }  // namespace benchmark
 }  // namespace peloton
\ No newline at end of file
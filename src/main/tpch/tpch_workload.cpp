@@ -12,6 +12,7 @@
 
 #include "benchmark/tpch/tpch_workload.h"
 
+#include "codegen/pipeline.h"
 #include "codegen/query.h"
 #include "concurrency/transaction_manager_factory.h"
 #include "planner/abstract_plan.h"
@@ -163,44 +164,70 @@ void TPCHBenchmark::RunQuery(const TPCHBenchmark::QueryConfig &query_config) {
   // The consumer
   CountingConsumer counter;
 
-  // Compile
-  codegen::QueryCompiler::CompileStats compile_stats;
-  codegen::QueryCompiler compiler;
-  auto compiled_query = compiler.Compile(*plan, counter, &compile_stats);
-
-  codegen::Query::RuntimeStats overall_stats = {0.0, 0.0, 0.0};
-  for (uint32_t i = 0; i < config_.num_runs; i++) {
-    // Reset the counter for this run
-    counter.ResetCount();
-
-    // Begin a transaction
-    auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
-    auto *txn = txn_manager.BeginTransaction();
-
-    // Execute query in a transaction
-    codegen::Query::RuntimeStats runtime_stats;
-    compiled_query->Execute(*txn, counter.GetCountAsState(), &runtime_stats);
-
-    // Commit transaction
-    txn_manager.CommitTransaction(txn);
+  // Run the query with every thread count we're asked to measure, recording
+  // the average plan (i.e., scan and processing) time of each
+  std::vector<std::pair<uint32_t, double>> plan_ms_by_threads;
+  for (uint32_t num_threads : config_.GetThreadCounts()) {
+    // Parallelism is decided when the query is compiled
+    codegen::Pipeline::kDegreeOfParallelism = num_threads;
+
+    // Compile
+    codegen::QueryCompiler::CompileStats compile_stats;
+    codegen::QueryCompiler compiler;
+    auto compiled_query = compiler.Compile(*plan, counter, &compile_stats);
+
+    codegen::Query::RuntimeStats overall_stats = {0.0, 0.0, 0.0};
+    for (uint32_t i = 0; i < config_.num_runs; i++) {
+      // Reset the counter for this run
+      counter.ResetCount();
+
+      // Begin a transaction
+      auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+      auto *txn = txn_manager.BeginTransaction();
+
+      // Execute query in a transaction
+      codegen::Query::RuntimeStats runtime_stats;
+      compiled_query->Execute(*txn, counter.GetCountAsState(), &runtime_stats);
+
+      // Commit transaction
+      txn_manager.CommitTransaction(txn);
+
+      // Collect stats
+      overall_stats.init_ms += runtime_stats.init_ms;
+      overall_stats.plan_ms += runtime_stats.plan_ms;
+      overall_stats.tear_down_ms += runtime_stats.tear_down_ms;
+    }
 
-    // Collect stats
-    overall_stats.init_ms += runtime_stats.init_ms;
-    overall_stats.plan_ms += runtime_stats.plan_ms;
-    overall_stats.tear_down_ms += runtime_stats.tear_down_ms;
+    LOG_INFO("%s: ==============================================",
+             query_config.query_name.c_str());
+    LOG_INFO("# Threads: %u, # Runs: %u, # Result tuples: %lu", num_threads,
+             config_.num_runs, counter.GetCount());
+    LOG_INFO("Setup: %.2lf, IR Gen: %.2lf, Compile: %.2lf",
+             compile_stats.setup_ms, compile_stats.ir_gen_ms,
+             compile_stats.jit_ms);
+    LOG_INFO("Init: %.2lf ms, Plan: %.2lf ms, TearDown: %.2lf ms",
+             overall_stats.init_ms / config_.num_runs,
+             overall_stats.plan_ms / config_.num_runs,
+             overall_stats.tear_down_ms / config_.num_runs);
+
+    plan_ms_by_threads.emplace_back(num_threads,
+                                    overall_stats.plan_ms / config_.num_runs);
   }
 
-  LOG_INFO("%s: ==============================================",
-           query_config.query_name.c_str());
-  LOG_INFO("# Runs: %u, # Result tuples: %lu", config_.num_runs,
-           counter.GetCount());
-  LOG_INFO("Setup: %.2lf, IR Gen: %.2lf, Compile: %.2lf",
-           compile_stats.setup_ms, compile_stats.ir_gen_ms,
-           compile_stats.jit_ms);
-  LOG_INFO("Init: %.2lf ms, Plan: %.2lf ms, TearDown: %.2lf ms",
-           overall_stats.init_ms / config_.num_runs,
-           overall_stats.plan_ms / config_.num_runs,
-           overall_stats.tear_down_ms / config_.num_runs);
+  // Restore the default
+  codegen::Pipeline::kDegreeOfParallelism = 1;
+
+  // Report how the query scales with the number of threads
+  if (plan_ms_by_threads.size() > 1) {
+    double base_plan_ms = plan_ms_by_threads[0].second;
+    LOG_INFO("%s scaling: ==============================================",
+             query_config.query_name.c_str());
+    for (const auto &threads_and_plan_ms : plan_ms_by_threads) {
+      LOG_INFO("Threads: %u, Plan: %.2lf ms, Speedup: %.2lfx",
+               threads_and_plan_ms.first, threads_and_plan_ms.second,
+               base_plan_ms / threads_and_plan_ms.second);
+    }
+  }
 }
 
 //===----------------------------------------------------------------------===//
@@ -27,7 +27,7 @@ void Usage(FILE *out) {
   fprintf(out,
           "Command line options : ycsb <options> \n"
           "   -h --help              :  print help message \n"
-          "   -i --index             :  index type: bwtree (default) \n"
+          "   -i --index             :  index type: bwtree (default), hash \n"
           "   -k --scale_factor      :  # of K tuples \n"
           "   -d --duration          :  execution duration \n"
           "   -p --profile_duration  :  profile duration \n"
@@ -40,8 +40,10 @@ void Usage(FILE *out) {
           "   -m --string_mode       :  store strings \n"
           "   -g --gc_mode           :  enable garbage collection \n"
           "   -n --gc_backend_count  :  # of gc backends \n"
+          "   -r --gc_cooperative    :  let workers help the gc (with -g) \n"
           "   -l --loader_count      :  # of loaders \n"
           "   -y --epoch             :  epoch type: centralized or decentralized \n"
+          "   -s --isolation         :  full (default), snapshot, repeatable_read \n"
   );
 }
 
@@ -59,13 +61,15 @@ static struct option opts[] = {
     { "string_mode", no_argument, NULL, 'm' },
     { "gc_mode", no_argument, NULL, 'g' },
     { "gc_backend_count", optional_argument, NULL, 'n' },
+    { "gc_cooperative", no_argument, NULL, 'r' },
     { "loader_count", optional_argument, NULL, 'n' },
     { "epoch", optional_argument, NULL, 'y' },
+    { "isolation", optional_argument, NULL, 's' },
     { NULL, 0, NULL, 0 }
 };
 
 void ValidateIndex(const configuration &state) {
-  if (state.index != IndexType::BWTREE && state.index != IndexType::BWTREE) {
+  if (state.index != IndexType::BWTREE && state.index != IndexType::HASH) {
     LOG_ERROR("Invalid index");
     exit(EXIT_FAILURE);
   }
@@ -156,6 +160,7 @@ void ParseArguments(int argc, char *argv[], configuration &state) {
   // Default Values
   state.index = IndexType::BWTREE;
   state.epoch = EpochType::DECENTRALIZED_EPOCH;
+  state.isolation = IsolationLevelType::FULL;
   state.scale_factor = 1;
   state.duration = 10;
   state.profile_duration = 1;
@@ -168,12 +173,13 @@ void ParseArguments(int argc, char *argv[], configuration &state) {
   state.string_mode = false;
   state.gc_mode = false;
   state.gc_backend_count = 1;
+  state.gc_cooperative = false;
   state.loader_count = 1;
 
   // Parse args
   while (1) {
     int idx = 0;
-    int c = getopt_long(argc, argv, "hemgi:k:d:p:b:c:o:u:z:n:l:y:", opts, &idx);
+    int c = getopt_long(argc, argv, "hemgri:k:d:p:b:c:o:u:z:n:l:y:s:", opts, &idx);
 
     if (c == -1) break;
 
@@ -182,6 +188,8 @@ void ParseArguments(int argc, char *argv[], configuration &state) {
         char *index = optarg;
         if (strcmp(index, "bwtree") == 0) {
           state.index = IndexType::BWTREE;
+        } else if (strcmp(index, "hash") == 0) {
+          state.index = IndexType::HASH;
         } else {
           LOG_ERROR("Unknown index: %s", index);
           exit(EXIT_FAILURE);
@@ -198,6 +206,20 @@ void ParseArguments(int argc, char *argv[], configuration &state) {
         }
         break;
       }
+      case 's': {
+        char *isolation = optarg;
+        if (strcmp(isolation, "full") == 0) {
+          state.isolation = IsolationLevelType::FULL;
+        } else if (strcmp(isolation, "snapshot") == 0) {
+          state.isolation = IsolationLevelType::SNAPSHOT;
+        } else if (strcmp(isolation, "repeatable_read") == 0) {
+          state.isolation = IsolationLevelType::REPEATABLE_READ;
+        } else {
+          LOG_ERROR("Unknown isolation level: %s", isolation);
+          exit(EXIT_FAILURE);
+        }
+        break;
+      }
       case 'l':
         state.loader_count = atoi(optarg);
         break;
@@ -234,6 +256,9 @@ void ParseArguments(int argc, char *argv[], configuration &state) {
       case 'g':
         state.gc_mode = true;
         break;
+      case 'r':
+        state.gc_cooperative = true;
+        break;
       case 'n':
         state.gc_backend_count = atoi(optarg);
         break;
@@ -11,6 +11,7 @@
 //===----------------------------------------------------------------------===//
 
 #include "optimizer/simple_optimizer.h"
+#include "optimizer/util.h"
 
 #include "parser/abstract_parse.h"
 
@@ -809,7 +810,10 @@ bool SimpleOptimizer::CheckIndexSearchable(
         int matched_columns = 0;
         for (auto column_id : predicate_column_ids)
           if (column_set.find(column_id) != column_set.end()) matched_columns++;
-        if (matched_columns == (int)column_set.size()) {
+        if (matched_columns == (int)column_set.size() &&
+            util::IsIndexUsable(target_table->GetIndex(index_index).get(),
+                                column_set, predicate_column_ids,
+                                predicate_expr_types)) {
           index_searchable = true;
           index_id = index_index;
         }
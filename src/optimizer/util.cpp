@@ -12,6 +12,7 @@
 
 #include "optimizer/util.h"
 #include "storage/data_table.h"
+#include "index/index.h"
 #include "expression/tuple_value_expression.h"
 #include "type/value_factory.h"
 #include "expression/parameter_value_expression.h"
@@ -21,6 +22,28 @@
 namespace peloton {
 namespace optimizer {
 namespace util {
+// Checks whether the index can serve the predicates on the given columns
+bool IsIndexUsable(index::Index* index, const std::set<oid_t>& index_columns,
+                   const std::vector<oid_t>& column_ids,
+                   const std::vector<ExpressionType>& expr_types) {
+  if (index == nullptr) return false;
+
+  if (index->GetIndexMethodType() != IndexType::HASH) return true;
+
+  // A hash index can only look up a complete key
+  std::set<oid_t> equal_columns;
+  for (size_t i = 0; i < column_ids.size(); i++) {
+    if (expr_types[i] == ExpressionType::COMPARE_EQUAL)
+      equal_columns.insert(column_ids[i]);
+  }
+
+  for (auto column_id : index_columns) {
+    if (equal_columns.find(column_id) == equal_columns.end()) return false;
+  }
+
+  return true;
+}
+
 /**
  * This function checks whether the current expression can enable index
  * scan for the statement. If it is index searchable, returns true and
@@ -60,7 +83,9 @@ bool CheckIndexSearchable(
         int matched_columns = 0;
         for (auto column_id : predicate_column_ids)
           if (column_set.find(column_id) != column_set.end()) matched_columns++;
-        if (matched_columns > max_columns) {
+        if (matched_columns > max_columns &&
+            IsIndexUsable(target_table->GetIndex(index_index).get(), column_set,
+                          predicate_column_ids, predicate_expr_types)) {
           index_searchable = true;
           index_id = index_index;
           max_columns = matched_columns;
@@ -992,7 +992,14 @@ parser::SQLStatement* PostgresParser::CreateIndexTransform(IndexStmt* root) {
     char* index_attr = reinterpret_cast<IndexElem*>(cell->data.ptr_value)->name;
     result->index_attrs->push_back(cstrdup(index_attr));
   }
-  result->index_type = IndexType::BWTREE;
+  // CREATE INDEX ... USING HASH builds a hash index; every other access
+  // method (btree by default) is served by the BwTree
+  if (root->accessMethod != nullptr &&
+      strcmp(root->accessMethod, "hash") == 0) {
+    result->index_type = IndexType::HASH;
+  } else {
+    result->index_type = IndexType::BWTREE;
+  }
   result->table_info_ = new TableInfo();
   result->table_info_->table_name = cstrdup(root->relation->relname);
   result->index_name = cstrdup(root->idxname);
@@ -19,6 +19,7 @@
 
 #include "type/types.h"
 #include "expression/abstract_expression.h"
+#include "planner/binding_context.h"
 #include "planner/project_info.h"
 
 namespace peloton {
@@ -44,5 +45,19 @@ NestedLoopJoinPlan::NestedLoopJoinPlan(
   join_column_ids_left_ = join_column_ids_left;
   join_column_ids_right_ = join_column_ids_right;
 }
+
+void NestedLoopJoinPlan::HandleSubplanBinding(bool from_left,
+                                              const BindingContext &input) {
+  const auto &col_ids =
+      from_left ? join_column_ids_left_ : join_column_ids_right_;
+  auto &ais = from_left ? join_ais_left_ : join_ais_right_;
+  ais.clear();
+  for (oid_t col_id : col_ids) {
+    const auto *ai = input.Find(col_id);
+    PL_ASSERT(ai != nullptr);
+    ais.push_back(ai);
+  }
 }
-}
+
+}  // namespace planner
+}  // namespace peloton
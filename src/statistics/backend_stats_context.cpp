@@ -106,6 +106,16 @@ LatencyMetric& BackendStatsContext::GetTxnLatencyMetric() {
   return txn_latencies_;
 }
 
+QueryCacheMetric& BackendStatsContext::GetQueryCacheMetric() {
+  return query_cache_metric_;
+}
+
+GCMetric& BackendStatsContext::GetGCMetric() { return gc_metric_; }
+
+ConnectionMetric& BackendStatsContext::GetConnectionMetric() {
+  return connection_metric_;
+}
+
 void BackendStatsContext::IncrementTableReads(oid_t tile_group_id) {
   oid_t table_id =
       catalog::Manager::GetInstance().GetTileGroup(tile_group_id)->GetTableId();
@@ -216,6 +226,44 @@ void BackendStatsContext::IncrementTxnAborted(oid_t database_id) {
   CompleteQueryMetric();
 }
 
+void BackendStatsContext::IncrementQueryCacheHits(int64_t saved_compile_us) {
+  query_cache_metric_.IncrementHits(saved_compile_us);
+}
+
+void BackendStatsContext::IncrementQueryCacheMisses() {
+  query_cache_metric_.IncrementMisses();
+}
+
+void BackendStatsContext::IncrementQueryCacheEvictions() {
+  query_cache_metric_.IncrementEvictions();
+}
+
+void BackendStatsContext::IncrementVersionChainTraversals(
+    int64_t chain_length) {
+  gc_metric_.IncrementVersionChainTraversals(chain_length);
+}
+
+void BackendStatsContext::IncrementGCReclaims(int64_t version_count,
+                                              int64_t latency_us) {
+  gc_metric_.IncrementReclaims(version_count, latency_us);
+}
+
+void BackendStatsContext::IncrementConnectionsDispatched(int worker_id) {
+  connection_metric_.IncrementDispatched(worker_id);
+}
+
+void BackendStatsContext::IncrementConnectionsDequeued(int worker_id) {
+  connection_metric_.IncrementDequeued(worker_id);
+}
+
+void BackendStatsContext::IncrementConnectionsOpened(int worker_id) {
+  connection_metric_.IncrementOpened(worker_id);
+}
+
+void BackendStatsContext::IncrementConnectionsClosed(int worker_id) {
+  connection_metric_.IncrementClosed(worker_id);
+}
+
 void BackendStatsContext::InitQueryMetric(
     const std::shared_ptr<Statement> statement,
     const std::shared_ptr<QueryMetric::QueryParams> params) {
@@ -232,6 +280,9 @@ void BackendStatsContext::Aggregate(BackendStatsContext& source) {
   // Aggregate all global metrics
   txn_latencies_.Aggregate(source.txn_latencies_);
   txn_latencies_.ComputeLatencies();
+  query_cache_metric_.Aggregate(source.query_cache_metric_);
+  gc_metric_.Aggregate(source.gc_metric_);
+  connection_metric_.Aggregate(source.connection_metric_);
 
   // Aggregate all per-database metrics
   for (auto& database_item : source.database_metrics_) {
@@ -266,6 +317,9 @@ void BackendStatsContext::Aggregate(BackendStatsContext& source) {
 
 void BackendStatsContext::Reset() {
   txn_latencies_.Reset();
+  query_cache_metric_.Reset();
+  gc_metric_.Reset();
+  connection_metric_.Reset();
 
   for (auto& database_item : database_metrics_) {
     database_item.second->Reset();
@@ -322,6 +376,9 @@ std::string BackendStatsContext::ToString() const {
   std::stringstream ss;
 
   ss << txn_latencies_.GetInfo() << std::endl;
+  ss << query_cache_metric_.GetInfo() << std::endl;
+  ss << gc_metric_.GetInfo() << std::endl;
+  ss << connection_metric_.GetInfo() << std::endl;
 
   for (auto& database_item : database_metrics_) {
     oid_t database_id = database_item.second->GetDatabaseId();
@@ -0,0 +1,99 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// connection_metric.cpp
+//
+// Identification: src/statistics/connection_metric.cpp
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <algorithm>
+
+#include "statistics/connection_metric.h"
+#include "common/macros.h"
+
+namespace peloton {
+namespace stats {
+
+ConnectionMetric::ConnectionMetric(MetricType type, size_t worker_count)
+    : AbstractMetric(type), workers_(worker_count) {}
+
+int64_t ConnectionMetric::GetActiveConnections(int worker_id) const {
+  if (!HasWorker(worker_id)) {
+    return 0;
+  }
+  return workers_[worker_id].opened - workers_[worker_id].closed;
+}
+
+int64_t ConnectionMetric::GetQueueDepth(int worker_id) const {
+  if (!HasWorker(worker_id)) {
+    return 0;
+  }
+  return workers_[worker_id].dispatched - workers_[worker_id].dequeued;
+}
+
+void ConnectionMetric::Reset() {
+  for (auto &worker : workers_) {
+    worker.dispatched = 0;
+    worker.dequeued = 0;
+    worker.opened = 0;
+    worker.closed = 0;
+  }
+}
+
+bool ConnectionMetric::operator==(const ConnectionMetric& other) {
+  if (workers_.size() != other.workers_.size()) {
+    return false;
+  }
+  for (size_t worker_id = 0; worker_id < workers_.size(); worker_id++) {
+    auto &worker = workers_[worker_id];
+    auto &other_worker = other.workers_[worker_id];
+    if (worker.dispatched != other_worker.dispatched ||
+        worker.dequeued != other_worker.dequeued ||
+        worker.opened != other_worker.opened ||
+        worker.closed != other_worker.closed) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void ConnectionMetric::Aggregate(AbstractMetric& source) {
+  PL_ASSERT(source.GetType() == CONNECTION_METRIC);
+
+  ConnectionMetric& connection_metric = static_cast<ConnectionMetric&>(source);
+  size_t worker_count =
+      std::min(workers_.size(), connection_metric.workers_.size());
+  for (size_t worker_id = 0; worker_id < worker_count; worker_id++) {
+    auto &counters = workers_[worker_id];
+    auto &source_counters = connection_metric.workers_[worker_id];
+    counters.dispatched += source_counters.dispatched;
+    counters.dequeued += source_counters.dequeued;
+    counters.opened += source_counters.opened;
+    counters.closed += source_counters.closed;
+  }
+}
+
+const std::string ConnectionMetric::GetInfo() const {
+  std::stringstream ss;
+  ss << "//"
+        "===-----------------------------------------------------------------"
+        "---===//" << std::endl;
+  ss << "// CONNECTIONS" << std::endl;
+  ss << "//"
+        "===-----------------------------------------------------------------"
+        "---===//" << std::endl;
+  for (size_t worker_id = 0; worker_id < workers_.size(); worker_id++) {
+    ss << "worker " << worker_id
+       << ": active=" << GetActiveConnections(worker_id)
+       << " queued=" << GetQueueDepth(worker_id)
+       << " opened=" << workers_[worker_id].opened << std::endl;
+  }
+  return ss.str();
+}
+
+}  // namespace stats
+}  // namespace peloton
@@ -0,0 +1,62 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// gc_metric.cpp
+//
+// Identification: src/statistics/gc_metric.cpp
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "statistics/gc_metric.h"
+#include "common/macros.h"
+
+namespace peloton {
+namespace stats {
+
+GCMetric::GCMetric(MetricType type) : AbstractMetric(type) {}
+
+void GCMetric::Aggregate(AbstractMetric& source) {
+  PL_ASSERT(source.GetType() == GC_METRIC);
+
+  GCMetric& gc_metric = static_cast<GCMetric&>(source);
+  chain_traversals_.Aggregate(gc_metric.GetVersionChainTraversals());
+  chain_length_.Aggregate(gc_metric.GetVersionChainLength());
+  reclaims_.Aggregate(gc_metric.GetReclaims());
+  reclaimed_versions_.Aggregate(gc_metric.GetReclaimedVersions());
+  reclaim_latency_us_.Aggregate(gc_metric.GetReclaimLatency());
+}
+
+const std::string GCMetric::GetInfo() const {
+  double avg_chain_length = 0;
+  if (chain_traversals_.GetCounter() > 0) {
+    avg_chain_length = (double)chain_length_.GetCounter() /
+                       chain_traversals_.GetCounter();
+  }
+  double avg_reclaim_latency_us = 0;
+  if (reclaims_.GetCounter() > 0) {
+    avg_reclaim_latency_us =
+        (double)reclaim_latency_us_.GetCounter() / reclaims_.GetCounter();
+  }
+
+  std::stringstream ss;
+  ss << "//"
+        "===-----------------------------------------------------------------"
+        "---===//" << std::endl;
+  ss << "// GARBAGE COLLECTION" << std::endl;
+  ss << "//"
+        "===-----------------------------------------------------------------"
+        "---===//" << std::endl;
+  ss << "# chain traversals:       " << chain_traversals_.GetInfo()
+     << std::endl;
+  ss << "avg chain length:         " << avg_chain_length << std::endl;
+  ss << "# reclaimed versions:     " << reclaimed_versions_.GetInfo()
+     << std::endl;
+  ss << "avg reclaim latency (us): " << avg_reclaim_latency_us << std::endl;
+  return ss.str();
+}
+
+}  // namespace stats
+}  // namespace peloton
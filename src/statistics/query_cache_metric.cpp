@@ -0,0 +1,49 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// query_cache_metric.cpp
+//
+// Identification: src/statistics/query_cache_metric.cpp
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "statistics/query_cache_metric.h"
+#include "common/macros.h"
+
+namespace peloton {
+namespace stats {
+
+QueryCacheMetric::QueryCacheMetric(MetricType type) : AbstractMetric(type) {}
+
+void QueryCacheMetric::Aggregate(AbstractMetric& source) {
+  PL_ASSERT(source.GetType() == QUERY_CACHE_METRIC);
+
+  QueryCacheMetric& cache_metric = static_cast<QueryCacheMetric&>(source);
+  hits_.Aggregate(cache_metric.GetHits());
+  misses_.Aggregate(cache_metric.GetMisses());
+  evictions_.Aggregate(cache_metric.GetEvictions());
+  saved_compile_us_.Aggregate(cache_metric.GetSavedCompileTime());
+}
+
+const std::string QueryCacheMetric::GetInfo() const {
+  std::stringstream ss;
+  ss << "//"
+        "===-----------------------------------------------------------------"
+        "---===//" << std::endl;
+  ss << "// QUERY CACHE" << std::endl;
+  ss << "//"
+        "===-----------------------------------------------------------------"
+        "---===//" << std::endl;
+  ss << "# hits:                   " << hits_.GetInfo() << std::endl;
+  ss << "# misses:                 " << misses_.GetInfo() << std::endl;
+  ss << "# evictions:              " << evictions_.GetInfo() << std::endl;
+  ss << "saved compile time (us):  " << saved_compile_us_.GetInfo()
+     << std::endl;
+  return ss.str();
+}
+
+}  // namespace stats
+}  // namespace peloton
@@ -10,7 +10,11 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <cstdlib>
 #include <mutex>
+#include <new>
+#include <string>
+#include <unordered_map>
 #include <utility>
 
 #include "brain/clusterer.h"
@@ -20,14 +24,17 @@
 #include "common/exception.h"
 #include "common/logger.h"
 #include "common/platform.h"
+#include "concurrency/epoch_manager_factory.h"
 #include "concurrency/transaction.h"
 #include "concurrency/transaction_manager_factory.h"
+#include "configuration/configuration.h"
 #include "gc/gc_manager_factory.h"
 #include "index/index.h"
 #include "logging/log_manager.h"
 #include "storage/abstract_table.h"
 #include "storage/data_table.h"
 #include "storage/database.h"
+#include "storage/packed_column.h"
 #include "storage/tile.h"
 #include "storage/tile_group.h"
 #include "storage/tile_group_factory.h"
@@ -47,6 +54,39 @@ int peloton_num_groups;
 namespace peloton {
 namespace storage {
 
+namespace {
+
+// Threads are assigned insert partitions round-robin when they first insert,
+// so up to INSERT_PARTITION_COUNT threads never share a partition
+std::atomic<size_t> next_insert_partition_id(0);
+thread_local size_t insert_partition_id = SIZE_MAX;
+
+inline size_t GetThreadInsertPartitionId() {
+  if (insert_partition_id == SIZE_MAX) {
+    insert_partition_id = next_insert_partition_id.fetch_add(1) %
+                          INSERT_PARTITION_COUNT;
+  }
+  return insert_partition_id;
+}
+
+// Returns whether a slot recycled by the gc can be reused now. A slot of a
+// tile group frozen after the slot was freed goes back to the gc, it is
+// reused once the tile group is thawed.
+bool IsReusableTupleSlot(const oid_t table_oid, const ItemPointer &location) {
+  auto tile_group_header =
+      catalog::Manager::GetInstance().GetTileGroupHeader(location.block);
+  if (tile_group_header == nullptr) {
+    return false;
+  }
+  if (tile_group_header->IsImmutable() == false) {
+    return true;
+  }
+  gc::GCManagerFactory::GetInstance().RecycleTupleSlot(table_oid, location);
+  return false;
+}
+
+}  // anonymous namespace
+
 oid_t DataTable::invalid_tile_group_id = -1;
 
 size_t DataTable::default_active_tilegroup_count_ = 1;
@@ -120,6 +160,16 @@ DataTable::~DataTable() {
   // AbstractTable cleans up the schema
 }
 
+void *DataTable::operator new(size_t size) {
+  void *location = nullptr;
+  if (posix_memalign(&location, CACHELINE_SIZE, size) != 0) {
+    throw std::bad_alloc();
+  }
+  return location;
+}
+
+void DataTable::operator delete(void *location) { free(location); }
+
 //===--------------------------------------------------------------------===//
 // TUPLE HELPER OPERATIONS
 //===--------------------------------------------------------------------===//
@@ -152,6 +202,52 @@ bool DataTable::CheckConstraints(const storage::Tuple *tuple) const {
   return true;
 }
 
+// inserts are only partitioned across threads when the table has several
+// active tile groups to spread them over. otherwise every thread uses
+// partition 0, which is the same single shared state as before.
+size_t DataTable::GetInsertPartitionId() const {
+  if (active_tilegroup_count_ == 1) {
+    return 0;
+  }
+  return GetThreadInsertPartitionId();
+}
+
+ItemPointer DataTable::GetFreeTupleSlot() {
+  auto &gc_manager = gc::GCManagerFactory::GetInstance();
+
+  // without partitions, take the slots from the gc one at a time
+  if (active_tilegroup_count_ == 1) {
+    auto location = gc_manager.ReturnFreeSlot(table_oid);
+    if (location.IsNull() || IsReusableTupleSlot(table_oid, location)) {
+      return location;
+    }
+    return INVALID_ITEMPOINTER;
+  }
+
+  auto &partition = insert_partitions_[GetInsertPartitionId()];
+  ItemPointer location = INVALID_ITEMPOINTER;
+
+  partition.free_slot_lock.Lock();
+  // refill the partition from the gc once it has used up its slots
+  if (partition.next_free_slot == partition.free_slots.size()) {
+    partition.free_slots.resize(FREE_SLOT_BATCH_SIZE);
+    size_t free_slot_count = gc_manager.ReturnFreeSlots(
+        table_oid, partition.free_slots.data(), FREE_SLOT_BATCH_SIZE);
+    partition.free_slots.resize(free_slot_count);
+    partition.next_free_slot = 0;
+  }
+  while (partition.next_free_slot < partition.free_slots.size()) {
+    location = partition.free_slots[partition.next_free_slot++];
+    if (IsReusableTupleSlot(table_oid, location)) {
+      break;
+    }
+    location = INVALID_ITEMPOINTER;
+  }
+  partition.free_slot_lock.Unlock();
+
+  return location;
+}
+
 // this function is called when update/delete/insert is performed.
 // this function first checks whether there's available slot.
 // if yes, then directly return the available slot.
@@ -169,20 +265,21 @@ bool DataTable::CheckConstraints(const storage::Tuple *tuple) const {
 ItemPointer DataTable::GetEmptyTupleSlot(const storage::Tuple *tuple) {
   //=============== garbage collection==================
   // check if there are recycled tuple slots
-  auto &gc_manager = gc::GCManagerFactory::GetInstance();
-  auto free_item_pointer = gc_manager.ReturnFreeSlot(this->table_oid);
+  auto free_item_pointer = GetFreeTupleSlot();
   if (free_item_pointer.IsNull() == false) {
     // when inserting a tuple
     if (tuple != nullptr) {
-      auto tile_group =
-          catalog::Manager::GetInstance().GetTileGroup(free_item_pointer.block);
+      auto tile_group = catalog::Manager::GetInstance().GetTileGroupPtr(
+          free_item_pointer.block);
       tile_group->CopyTuple(tuple, free_item_pointer.offset);
     }
     return free_item_pointer;
   }
   //====================================================
 
-  size_t active_tile_group_id = number_of_tuples_ % active_tilegroup_count_;
+  // every thread keeps inserting into its own active tile group
+  size_t active_tile_group_id =
+      GetInsertPartitionId() % active_tilegroup_count_;
   std::shared_ptr<storage::TileGroup> tile_group;
   oid_t tuple_slot = INVALID_OID;
   oid_t tile_group_id = INVALID_OID;
@@ -341,7 +438,7 @@ bool DataTable::InsertInIndexes(const storage::Tuple *tuple,
   int index_count = GetIndexCount();
 
   size_t active_indirection_array_id =
-      number_of_tuples_ % active_indirection_array_count_;
+      GetInsertPartitionId() % active_indirection_array_count_;
 
   size_t indirection_offset = INVALID_INDIRECTION_OFFSET;
 
@@ -550,8 +647,12 @@ bool DataTable::CheckForeignKeyConstraints(const storage::Tuple *tuple
  * @param amount amount to increase
  */
 void DataTable::IncreaseTupleCount(const size_t &amount) {
-  number_of_tuples_ += amount;
-  dirty_ = true;
+  insert_partitions_[GetInsertPartitionId()].tuple_count.fetch_add(
+      amount, std::memory_order_relaxed);
+  // avoid writing a line that all the inserting threads read
+  if (dirty_ == false) {
+    dirty_ = true;
+  }
 }
 
 /**
@@ -559,8 +660,11 @@ void DataTable::IncreaseTupleCount(const size_t &amount) {
  * @param amount amount to decrease
  */
 void DataTable::DecreaseTupleCount(const size_t &amount) {
-  number_of_tuples_ -= amount;
-  dirty_ = true;
+  insert_partitions_[GetInsertPartitionId()].tuple_count.fetch_sub(
+      amount, std::memory_order_relaxed);
+  if (dirty_ == false) {
+    dirty_ = true;
+  }
 }
 
 /**
@@ -568,7 +672,10 @@ void DataTable::DecreaseTupleCount(const size_t &amount) {
  * @param num_tuples number of tuples
  */
 void DataTable::SetTupleCount(const size_t &num_tuples) {
-  number_of_tuples_ = num_tuples;
+  insert_partitions_[0].tuple_count = num_tuples;
+  for (size_t i = 1; i < INSERT_PARTITION_COUNT; ++i) {
+    insert_partitions_[i].tuple_count = 0;
+  }
   dirty_ = true;
 }
 
@@ -576,7 +683,14 @@ void DataTable::SetTupleCount(const size_t &num_tuples) {
  * @brief Get the number of tuples in this table
  * @return number of tuples
  */
-size_t DataTable::GetTupleCount() const { return number_of_tuples_; }
+size_t DataTable::GetTupleCount() const {
+  // the partitions may wrap around individually, their sum does not
+  size_t tuple_count = 0;
+  for (auto &partition : insert_partitions_) {
+    tuple_count += partition.tuple_count.load(std::memory_order_relaxed);
+  }
+  return tuple_count;
+}
 
 /**
  * @brief return dirty flag
@@ -617,7 +731,8 @@ oid_t DataTable::AddDefaultIndirectionArray(
 }
 
 oid_t DataTable::AddDefaultTileGroup() {
-  size_t active_tile_group_id = number_of_tuples_ % active_tilegroup_count_;
+  size_t active_tile_group_id =
+      GetInsertPartitionId() % active_tilegroup_count_;
   return AddDefaultTileGroup(active_tile_group_id);
 }
 
@@ -658,6 +773,14 @@ oid_t DataTable::AddDefaultTileGroup(const size_t &active_tile_group_id) {
 void DataTable::AddTileGroupWithOidForRecovery(const oid_t &tile_group_id) {
   PL_ASSERT(tile_group_id);
 
+  // the tile group was already added by an earlier log record. tile group
+  // ids are global, so the catalog answers this without scanning the tile
+  // groups of the table.
+  auto &catalog_manager = catalog::Manager::GetInstance();
+  if (catalog_manager.GetTileGroupPtr(tile_group_id) != nullptr) {
+    return;
+  }
+
   std::vector<catalog::Schema> schemas;
   schemas.push_back(*schema);
 
@@ -672,29 +795,26 @@ void DataTable::AddTileGroupWithOidForRecovery(const oid_t &tile_group_id) {
       database_oid, table_oid, tile_group_id, this, schemas, column_map,
       tuples_per_tilegroup_));
 
-  auto tile_groups_exists = tile_groups_.Contains(tile_group_id);
-
-  if (tile_groups_exists == false) {
-    tile_groups_.Append(tile_group_id);
+  tile_groups_.Append(tile_group_id);
 
-    LOG_TRACE("Added a tile group ");
+  LOG_TRACE("Added a tile group ");
 
-    // add tile group metadata in locator
-    catalog::Manager::GetInstance().AddTileGroup(tile_group_id, tile_group);
+  // add tile group metadata in locator
+  catalog_manager.AddTileGroup(tile_group_id, tile_group);
 
-    // we must guarantee that the compiler always add tile group before adding
-    // tile_group_count_.
-    COMPILER_MEMORY_FENCE;
+  // we must guarantee that the compiler always add tile group before adding
+  // tile_group_count_.
+  COMPILER_MEMORY_FENCE;
 
-    tile_group_count_++;
+  tile_group_count_++;
 
-    LOG_TRACE("Recording tile group : %u ", tile_group_id);
-  }
+  LOG_TRACE("Recording tile group : %u ", tile_group_id);
 }
 
 // NOTE: This function is only used in test cases.
 void DataTable::AddTileGroup(const std::shared_ptr<TileGroup> &tile_group) {
-  size_t active_tile_group_id = number_of_tuples_ % active_tilegroup_count_;
+  size_t active_tile_group_id =
+      GetInsertPartitionId() % active_tilegroup_count_;
 
   active_tile_groups_[active_tile_group_id] = tile_group;
 
@@ -939,9 +1059,122 @@ std::vector<catalog::Schema> TransformTileGroupSchema(
   return new_schema;
 }
 
-// Set the transformed tile group column-at-a-time
+// A tile group is cold when all its slots hold the latest version of a tuple
+// and none of its versions is being written. A slot freed by the gc waits to
+// be reused, and an updated or deleted version waits for the gc.
+bool IsColdTileGroup(storage::TileGroup *tile_group) {
+  auto header = tile_group->GetHeader();
+  auto tuple_count = tile_group->GetAllocatedTupleCount();
+  if (header->GetCurrentNextTupleSlot() < tuple_count) {
+    return false;
+  }
+  for (oid_t tuple_itr = 0; tuple_itr < tuple_count; tuple_itr++) {
+    if (header->GetTransactionId(tuple_itr) != INITIAL_TXN_ID ||
+        header->GetEndCommitId(tuple_itr) != MAX_CID) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// The bytes per tuple that scans of the column groups of the given layout
+// read from a tile group. A scan reads every tile holding one of the columns
+// it accesses.
+size_t GetScanTupleLength(storage::TileGroup *tile_group,
+                          const column_map_type &layout) {
+  std::map<oid_t, std::set<oid_t>> column_group_tiles;
+  for (auto &entry : layout) {
+    oid_t tile_offset, tile_column_offset;
+    tile_group->LocateTileAndColumn(entry.first, tile_offset,
+                                    tile_column_offset);
+    column_group_tiles[entry.second.first].insert(tile_offset);
+  }
+
+  auto &tile_schemas = tile_group->GetTileSchemas();
+  size_t tuple_length = 0;
+  for (auto &column_group : column_group_tiles) {
+    for (auto tile_offset : column_group.second) {
+      tuple_length += tile_schemas[tile_offset].GetLength();
+    }
+  }
+  return tuple_length;
+}
+
+// Copy an uninlined varlen column into a dictionary of its distinct values.
+// The dictionary is a single allocation of the pool of the new tile, and the
+// tuples point to its entries, so readers see ordinary varlen fields. The
+// entries must never be freed one by one, which holds as the tile group is
+// immutable. Returns the size of the dictionary, and adds the size of the
+// copied values to value_size.
+size_t SetDictionaryColumn(storage::TileGroupHeader *header,
+                           storage::Tile *orig_tile,
+                           const oid_t orig_tile_column_offset,
+                           storage::Tile *new_tile,
+                           const oid_t new_tile_column_offset,
+                           const oid_t tuple_count, size_t &value_size) {
+  auto orig_field_offset =
+      orig_tile->GetSchema()->GetOffset(orig_tile_column_offset);
+  auto new_field_offset =
+      new_tile->GetSchema()->GetOffset(new_tile_column_offset);
+
+  // the offset of every distinct value in the dictionary, and of the value
+  // of every tuple
+  std::unordered_map<std::string, size_t> entry_offsets;
+  std::vector<size_t> tuple_entry_offsets(tuple_count, SIZE_MAX);
+  size_t dictionary_size = 0;
+  for (oid_t tuple_itr = 0; tuple_itr < tuple_count; tuple_itr++) {
+    if (header->GetTransactionId(tuple_itr) == INVALID_TXN_ID) {
+      continue;
+    }
+    const char *data = *reinterpret_cast<char **>(
+        orig_tile->GetTupleLocation(tuple_itr) + orig_field_offset);
+    if (data == nullptr) {
+      continue;
+    }
+    // [length][data], see VarlenType::SerializeTo()
+    size_t entry_size = *reinterpret_cast<const uint32_t *>(data) +
+                        sizeof(uint32_t);
+    value_size += entry_size;
+
+    auto ret = entry_offsets.emplace(std::string(data, entry_size),
+                                     dictionary_size);
+    if (ret.second == true) {
+      // keep the lengths aligned
+      dictionary_size += (entry_size + sizeof(uint32_t) - 1) &
+                         ~(sizeof(uint32_t) - 1);
+    }
+    tuple_entry_offsets[tuple_itr] = ret.first->second;
+  }
+
+  if (dictionary_size == 0) {
+    return 0;
+  }
+
+  char *dictionary =
+      reinterpret_cast<char *>(new_tile->GetPool()->Allocate(dictionary_size));
+  for (auto &entry : entry_offsets) {
+    PL_MEMCPY(dictionary + entry.second, entry.first.data(),
+              entry.first.size());
+  }
+  for (oid_t tuple_itr = 0; tuple_itr < tuple_count; tuple_itr++) {
+    if (tuple_entry_offsets[tuple_itr] == SIZE_MAX) {
+      continue;
+    }
+    *reinterpret_cast<char **>(new_tile->GetTupleLocation(tuple_itr) +
+                               new_field_offset) =
+        dictionary + tuple_entry_offsets[tuple_itr];
+  }
+  return dictionary_size;
+}
+
+// Set the transformed tile group column-at-a-time. If compress is set, the
+// varlen columns are dictionary encoded and the tiles of integer columns are
+// packed, and the sizes of the encoded columns before and after are added to
+// value_size and compressed_size.
 void SetTransformedTileGroup(storage::TileGroup *orig_tile_group,
-                             storage::TileGroup *new_tile_group) {
+                             storage::TileGroup *new_tile_group,
+                             const bool compress, size_t &value_size,
+                             size_t &compressed_size) {
   // Check the schema of the two tile groups
   auto new_column_map = new_tile_group->GetColumnMap();
   auto orig_column_map = orig_tile_group->GetColumnMap();
@@ -952,6 +1185,8 @@ void SetTransformedTileGroup(storage::TileGroup *orig_tile_group,
 
   auto column_count = new_column_map.size();
   auto tuple_count = orig_tile_group->GetAllocatedTupleCount();
+  // both tile groups share the header
+  auto header = orig_tile_group->GetHeader();
   // Go over each column copying onto the new tile group
   for (oid_t column_itr = 0; column_itr < column_count; column_itr++) {
     // Locate the original base tile and tile column offset
@@ -964,18 +1199,100 @@ void SetTransformedTileGroup(storage::TileGroup *orig_tile_group,
     auto orig_tile = orig_tile_group->GetTile(orig_tile_offset);
     auto new_tile = new_tile_group->GetTile(new_tile_offset);
 
-    // Copy the column over to the new tile group
+    auto &schema = *new_tile->GetSchema();
+    auto type_id = schema.GetType(new_tile_column_offset);
+    if (compress == true &&
+        (type_id == type::Type::TypeId::VARCHAR ||
+         type_id == type::Type::TypeId::VARBINARY) &&
+        schema.IsInlined(new_tile_column_offset) == false) {
+      compressed_size += SetDictionaryColumn(
+          header, orig_tile, orig_tile_column_offset, new_tile,
+          new_tile_column_offset, tuple_count, value_size);
+      continue;
+    }
+
+    // Copy the column over to the new tile group, the empty slots stay empty
     for (oid_t tuple_itr = 0; tuple_itr < tuple_count; tuple_itr++) {
+      if (header->GetTransactionId(tuple_itr) == INVALID_TXN_ID) {
+        continue;
+      }
       type::Value val =
           (orig_tile->GetValue(tuple_itr, orig_tile_column_offset));
       new_tile->SetValue(val, tuple_itr, new_tile_column_offset);
     }
   }
 
-  // Finally, copy over the tile header
-  auto header = orig_tile_group->GetHeader();
-  auto new_header = new_tile_group->GetHeader();
-  *new_header = *header;
+  if (compress == false) {
+    return;
+  }
+  for (oid_t tile_itr = 0; tile_itr < new_tile_group->GetTileCount();
+       tile_itr++) {
+    auto new_tile = new_tile_group->GetTile(tile_itr);
+    size_t tile_size = new_tile->GetInlinedSize();
+    if (new_tile->Pack() == true) {
+      value_size += tile_size;
+      compressed_size += new_tile->GetInlinedSize();
+    }
+  }
+}
+
+// The layout of the compressed copies of tile groups in the given layout.
+// Every integer column gets a tile of its own to be packed, and the other
+// columns keep their column groups. The tiles are numbered in the order of
+// their first column, so a compressed layout maps to itself.
+column_map_type GetCompressedLayout(const column_map_type &layout,
+                                    const catalog::Schema *schema) {
+  column_map_type compressed_layout;
+  // the new tile and the next tile column of every column group
+  std::map<oid_t, std::pair<oid_t, oid_t>> column_groups;
+  oid_t tile_count = 0;
+  for (auto &entry : layout) {
+    if (PackedColumn::IsPackable(schema->GetType(entry.first)) == true) {
+      compressed_layout[entry.first] = std::make_pair(tile_count++, 0);
+      continue;
+    }
+    auto ret = column_groups.emplace(entry.second.first,
+                                     std::make_pair(tile_count, 0));
+    if (ret.second == true) {
+      tile_count++;
+    }
+    auto &column_group = ret.first->second;
+    compressed_layout[entry.first] =
+        std::make_pair(column_group.first, column_group.second++);
+  }
+  return compressed_layout;
+}
+
+// Replace the tile group by a copy in the given layout, compressed or not.
+// The copy tracks its versions in the header of the tile group, and is
+// thawed once no transaction can read the tile group anymore.
+std::shared_ptr<storage::TileGroup> CopyTileGroup(
+    storage::TileGroup *tile_group, const column_map_type &column_map,
+    const bool compress, size_t &value_size, size_t &compressed_size) {
+  // Get the schema for the new transformed tile group
+  auto new_schema = TransformTileGroupSchema(tile_group, column_map);
+
+  // Allocate space for the transformed tile group
+  std::shared_ptr<storage::TileGroup> new_tile_group(
+      TileGroupFactory::GetTransformedTileGroup(tile_group, new_schema,
+                                                column_map));
+
+  // Set the transformed tile group column-at-a-time
+  SetTransformedTileGroup(tile_group, new_tile_group.get(), compress,
+                          value_size, compressed_size);
+  if (compress == true) {
+    new_tile_group->SetCompressed();
+  }
+
+  // Set the location of the new tile group. the orig tile group is freed
+  // once the transactions that may read it have ended
+  auto tile_group_header = tile_group->GetHeader();
+  catalog::Manager::GetInstance().ReplaceTileGroup(
+      tile_group->GetTileGroupId(), new_tile_group);
+  tile_group_header->SetTileGroup(new_tile_group.get());
+  auto &epoch_manager = concurrency::EpochManagerFactory::GetInstance();
+  tile_group_header->SetThawCommitId(epoch_manager.GetCurrentEpochCommitId());
+  return new_tile_group;
 }
 
 storage::TileGroup *DataTable::TransformTileGroup(
@@ -992,37 +1309,122 @@ storage::TileGroup *DataTable::TransformTileGroup(
   // Get orig tile group from catalog
   auto &catalog_manager = catalog::Manager::GetInstance();
   auto tile_group = catalog_manager.GetTileGroup(tile_group_id);
-  auto diff = tile_group->GetSchemaDifference(default_partition_);
-
-  // Check threshold for transformation
-  if (diff < theta) {
+  if (tile_group == nullptr) {
     return nullptr;
   }
+  bool compress = FLAGS_compress_frozen_tile_groups;
+  auto layout = (compress == true)
+                    ? GetCompressedLayout(default_partition_, schema)
+                    : default_partition_;
+  auto diff = tile_group->GetSchemaDifference(layout);
+  bool transform = diff >= theta;
+
+  auto tile_group_header = tile_group->GetHeader();
+  auto &epoch_manager = concurrency::EpochManagerFactory::GetInstance();
+  auto max_committed_cid = epoch_manager.GetMaxCommittedCid();
+
+  // A compressed tile group that is written again is decompressed. Its
+  // dictionary entries can not be freed one by one and its packed tiles can
+  // not be written, so only the plain copy is thawed, once no transaction
+  // can read the compressed one. The frozen tiles do not change meanwhile,
+  // so the copy is made right away.
+  if (tile_group->IsCompressed() == true &&
+      tile_group_header->IsImmutable() == true &&
+      IsColdTileGroup(tile_group.get()) == false) {
+    LOG_TRACE("Decompressing tile group : %u", tile_group_offset);
+    size_t value_size = 0;
+    size_t compressed_size = 0;
+    auto new_tile_group =
+        CopyTileGroup(tile_group.get(), tile_group->GetColumnMap(), false,
+                      value_size, compressed_size);
+    decompressed_tile_group_count_++;
+    return new_tile_group.get();
+  }
 
-  LOG_TRACE("Transforming tile group : %u", tile_group_offset);
+  // Check threshold for transformation. a tile group in the default layout,
+  // or the one of the compressed copies, is still copied to be compressed.
+  if (transform == false &&
+      (compress == false || tile_group->IsCompressed() == true)) {
+    // Thaw a tile group frozen for a transformation that is abandoned, or a
+    // copy once no transaction can read the original. A compressed tile
+    // group stays frozen until it is written again, see above.
+    if (tile_group_header->IsImmutable() == true &&
+        tile_group->IsCompressed() == false &&
+        tile_group_header->GetThawCommitId() < max_committed_cid) {
+      tile_group_header->SetMutable();
+    }
+    return nullptr;
+  }
 
-  // Get the schema for the new transformed tile group
-  auto new_schema =
-      TransformTileGroupSchema(tile_group.get(), default_partition_);
+  // Only cold tile groups are transformed. The tile group is made immutable
+  // first, and copied once the transactions that may still write into its
+  // tiles have ended. Readers keep using the old tile group meanwhile.
+  if (tile_group_header->IsImmutable() == false) {
+    if (IsColdTileGroup(tile_group.get()) == true) {
+      tile_group_header->SetImmutable(
+          epoch_manager.GetCurrentEpochCommitId());
+    }
+    return nullptr;
+  }
+  if (tile_group_header->GetImmutableCommitId() >= max_committed_cid) {
+    return nullptr;
+  }
 
-  // Allocate space for the transformed tile group
-  std::shared_ptr<storage::TileGroup> new_tile_group(
-      TileGroupFactory::GetTileGroup(
-          tile_group->GetDatabaseId(), tile_group->GetTableId(),
-          tile_group->GetTileGroupId(), tile_group->GetAbstractTable(),
-          new_schema, default_partition_,
-          tile_group->GetAllocatedTupleCount()));
+  // The tile group is written again, give up on it
+  if (IsColdTileGroup(tile_group.get()) == false) {
+    if (tile_group_header->GetThawCommitId() < max_committed_cid) {
+      tile_group_header->SetMutable();
+    }
+    return nullptr;
+  }
 
-  // Set the transformed tile group column-at-a-time
-  SetTransformedTileGroup(tile_group.get(), new_tile_group.get());
+  LOG_TRACE("Transforming tile group : %u", tile_group_offset);
 
-  // Set the location of the new tile group
-  // and clean up the orig tile group
-  catalog_manager.AddTileGroup(tile_group_id, new_tile_group);
+  auto column_map =
+      (transform == true) ? layout : tile_group->GetColumnMap();
+  if (compress == true) {
+    column_map = GetCompressedLayout(column_map, schema);
+  }
+  size_t value_size = 0;
+  size_t compressed_size = 0;
+  auto new_tile_group = CopyTileGroup(tile_group.get(), column_map, compress,
+                                      value_size, compressed_size);
+
+  if (transform == true) {
+    auto tuple_count = tile_group->GetAllocatedTupleCount();
+    transformed_tile_group_count_++;
+    scan_bytes_before_transform_ +=
+        GetScanTupleLength(tile_group.get(), default_partition_) *
+        tuple_count;
+    scan_bytes_after_transform_ +=
+        GetScanTupleLength(new_tile_group.get(), default_partition_) *
+        tuple_count;
+  }
+  if (compress == true && tile_group->IsCompressed() == false) {
+    compressed_tile_group_count_++;
+    bytes_before_compression_ += value_size;
+    bytes_after_compression_ += compressed_size;
+  }
 
   return new_tile_group.get();
 }
 
+double DataTable::GetCompressionRatio() const {
+  size_t bytes_after_compression = bytes_after_compression_;
+  if (bytes_after_compression == 0) {
+    return 1.0;
+  }
+  return (double)bytes_before_compression_ / bytes_after_compression;
+}
+
+double DataTable::GetTransformScanBytesRatio() const {
+  size_t scan_bytes_after_transform = scan_bytes_after_transform_;
+  if (scan_bytes_after_transform == 0) {
+    return 1.0;
+  }
+  return (double)scan_bytes_before_transform_ / scan_bytes_after_transform;
+}
+
 void DataTable::RecordLayoutSample(const brain::Sample &sample) {
   // Add layout sample
   {
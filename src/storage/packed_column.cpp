@@ -0,0 +1,155 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// packed_column.cpp
+//
+// Identification: src/storage/packed_column.cpp
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "storage/packed_column.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "common/macros.h"
+#include "type/type.h"
+
+namespace peloton {
+namespace storage {
+
+namespace {
+
+// Read an integer field as a signed 64-bit integer. DATE and TIMESTAMP are
+// read like INTEGER and BIGINT, which keeps their order as the scans compare
+// them.
+int64_t ReadField(const char *field, type::Type::TypeId type) {
+  switch (type) {
+    case type::Type::TINYINT: {
+      int8_t value;
+      PL_MEMCPY(&value, field, sizeof(value));
+      return value;
+    }
+    case type::Type::SMALLINT: {
+      int16_t value;
+      PL_MEMCPY(&value, field, sizeof(value));
+      return value;
+    }
+    case type::Type::INTEGER:
+    case type::Type::DATE: {
+      int32_t value;
+      PL_MEMCPY(&value, field, sizeof(value));
+      return value;
+    }
+    default: {
+      int64_t value;
+      PL_MEMCPY(&value, field, sizeof(value));
+      return value;
+    }
+  }
+}
+
+}  // anonymous namespace
+
+PackedColumn::PackedColumn(type::Type::TypeId type, oid_t count, int64_t base,
+                           uint32_t bits)
+    : type_(type),
+      count_(count),
+      base_(base),
+      bits_(bits),
+      word_count_((static_cast<uint64_t>(count) * bits + 63) / 64 + 1),
+      words_(new uint64_t[word_count_]()) {
+  PL_ASSERT(bits > 0 && bits < 64);
+}
+
+bool PackedColumn::IsPackable(type::Type::TypeId type) {
+  switch (type) {
+    case type::Type::TINYINT:
+    case type::Type::SMALLINT:
+    case type::Type::INTEGER:
+    case type::Type::BIGINT:
+    case type::Type::DATE:
+    case type::Type::TIMESTAMP:
+      return true;
+    default:
+      return false;
+  }
+}
+
+std::unique_ptr<PackedColumn> PackedColumn::Pack(const char *data,
+                                                 size_t stride,
+                                                 type::Type::TypeId type,
+                                                 oid_t count) {
+  if (IsPackable(type) == false || count == 0) {
+    return nullptr;
+  }
+
+  // The null value is the smallest one of the type, so a column with nulls
+  // only packs if all its values are small
+  int64_t min_value = ReadField(data, type);
+  int64_t max_value = min_value;
+  for (oid_t slot = 1; slot < count; slot++) {
+    int64_t value = ReadField(data + slot * stride, type);
+    min_value = std::min(min_value, value);
+    max_value = std::max(max_value, value);
+  }
+
+  uint64_t range =
+      static_cast<uint64_t>(max_value) - static_cast<uint64_t>(min_value);
+  uint32_t bits = 1;
+  while (bits < 64 && (range >> bits) != 0) {
+    bits++;
+  }
+  if (bits >= 8 * type::Type::GetTypeSize(type)) {
+    return nullptr;
+  }
+
+  std::unique_ptr<PackedColumn> column(
+      new PackedColumn(type, count, min_value, bits));
+  uint64_t *words = column->words_.get();
+  for (oid_t slot = 0; slot < count; slot++) {
+    uint64_t offset = static_cast<uint64_t>(ReadField(data + slot * stride,
+                                                      type)) -
+                      static_cast<uint64_t>(min_value);
+    uint64_t bit = static_cast<uint64_t>(slot) * bits;
+    uint64_t shift = bit & 63;
+    words[bit >> 6] |= offset << shift;
+    if (shift + bits > 64) {
+      words[(bit >> 6) + 1] |= offset >> (64 - shift);
+    }
+  }
+  return column;
+}
+
+void PackedColumn::Unpack(oid_t slot, char *field) const {
+  PL_ASSERT(slot < count_);
+  int64_t value = GetValue(slot);
+  switch (type_) {
+    case type::Type::TINYINT: {
+      int8_t narrow = static_cast<int8_t>(value);
+      PL_MEMCPY(field, &narrow, sizeof(narrow));
+      break;
+    }
+    case type::Type::SMALLINT: {
+      int16_t narrow = static_cast<int16_t>(value);
+      PL_MEMCPY(field, &narrow, sizeof(narrow));
+      break;
+    }
+    case type::Type::INTEGER:
+    case type::Type::DATE: {
+      int32_t narrow = static_cast<int32_t>(value);
+      PL_MEMCPY(field, &narrow, sizeof(narrow));
+      break;
+    }
+    default: {
+      PL_MEMCPY(field, &value, sizeof(value));
+      break;
+    }
+  }
+}
+
+}  // End storage namespace
+}  // End peloton namespace
@@ -94,6 +94,7 @@ Tile::~Tile() {
  */
 void Tile::InsertTuple(const oid_t tuple_offset, Tuple *tuple) {
   PL_ASSERT(tuple_offset < GetAllocatedTupleCount());
+  PL_ASSERT(IsPacked() == false);
 
   // Find slot location
   char *location = tuple_offset * tuple_length + data;
@@ -112,6 +113,12 @@ type::Value Tile::GetValue(const oid_t tuple_offset, const oid_t column_id) {
 
   const type::Type::TypeId column_type = schema.GetType(column_id);
 
+  if (IsPacked() == true) {
+    char field[sizeof(int64_t)];
+    packed_columns[column_id]->Unpack(tuple_offset, field);
+    return type::Value::DeserializeFrom(field, column_type, true);
+  }
+
   const char *tuple_location = GetTupleLocation(tuple_offset);
   const char *field_location = tuple_location + schema.GetOffset(column_id);
   const bool is_inlined = schema.IsInlined(column_id);
@@ -132,6 +139,14 @@ type::Value Tile::GetValueFast(const oid_t tuple_offset,
   PL_ASSERT(tuple_offset < GetAllocatedTupleCount());
   PL_ASSERT(column_offset < schema.GetLength());
 
+  if (IsPacked() == true) {
+    for (oid_t column_itr = 0; column_itr < column_count; column_itr++) {
+      if (schema.GetOffset(column_itr) == column_offset) {
+        return GetValue(tuple_offset, column_itr);
+      }
+    }
+  }
+
   const char *tuple_location = GetTupleLocation(tuple_offset);
   const char *field_location = tuple_location + column_offset;
 
@@ -147,6 +162,7 @@ void Tile::SetValue(const type::Value &value, const oid_t tuple_offset,
                     const oid_t column_id) {
   PL_ASSERT(tuple_offset < num_tuple_slots);
   PL_ASSERT(column_id < schema.GetColumnCount());
+  PL_ASSERT(IsPacked() == false);
 
   char *tuple_location = GetTupleLocation(tuple_offset);
   char *field_location = tuple_location + schema.GetOffset(column_id);
@@ -176,6 +192,7 @@ void Tile::SetValueFast(const type::Value &value, const oid_t tuple_offset,
                         UNUSED_ATTRIBUTE const size_t column_length) {
   PL_ASSERT(tuple_offset < num_tuple_slots);
   PL_ASSERT(column_offset < schema.GetLength());
+  PL_ASSERT(IsPacked() == false);
 
   char *tuple_location = GetTupleLocation(tuple_offset);
   char *field_location = tuple_location + column_offset;
@@ -196,6 +213,14 @@ Tile *Tile::CopyTile(BackendType backend_type) {
       backend_type, INVALID_OID, INVALID_OID, INVALID_OID, INVALID_OID,
       new_header, *schema, tile_group, allocated_tuple_count);
 
+  if (IsPacked() == true) {
+    for (oid_t tuple_itr = 0; tuple_itr < allocated_tuple_count;
+         tuple_itr++) {
+      CopyTupleTo(tuple_itr, new_tile->GetTupleLocation(tuple_itr));
+    }
+    return new_tile;
+  }
+
   PL_MEMCPY(static_cast<void *>(new_tile->data), static_cast<void *>(data),
             tile_size);
 
@@ -221,6 +246,53 @@ Tile *Tile::CopyTile(BackendType backend_type) {
   return new_tile;
 }
 
+void Tile::CopyTupleTo(const oid_t tuple_offset, char *location) const {
+  PL_ASSERT(tuple_offset < num_tuple_slots);
+
+  if (IsPacked() == false) {
+    PL_MEMCPY(location, GetTupleLocation(tuple_offset), tuple_length);
+    return;
+  }
+
+  for (oid_t column_itr = 0; column_itr < column_count; column_itr++) {
+    packed_columns[column_itr]->Unpack(tuple_offset,
+                                       location + schema.GetOffset(column_itr));
+  }
+}
+
+//===--------------------------------------------------------------------===//
+// Packing
+//===--------------------------------------------------------------------===//
+
+bool Tile::Pack() {
+  if (IsPacked() == true) {
+    return true;
+  }
+
+  std::vector<std::unique_ptr<PackedColumn>> columns;
+  size_t packed_size = 0;
+  for (oid_t column_itr = 0; column_itr < column_count; column_itr++) {
+    auto column =
+        PackedColumn::Pack(data + schema.GetOffset(column_itr), tuple_length,
+                           schema.GetType(column_itr), num_tuple_slots);
+    if (column == nullptr) {
+      return false;
+    }
+    packed_size += column->GetSize();
+    columns.push_back(std::move(column));
+  }
+  if (packed_size >= tile_size) {
+    return false;
+  }
+
+  packed_columns = std::move(columns);
+  auto &storage_manager = storage::StorageManager::GetInstance();
+  storage_manager.Release(backend_type, data);
+  data = nullptr;
+  tile_size = packed_size;
+  return true;
+}
+
 //===--------------------------------------------------------------------===//
 // Utilities
 //===--------------------------------------------------------------------===//
@@ -236,6 +308,11 @@ const std::string Tile::GetInfo() const {
   // Tuples
   os << GETINFO_SINGLE_LINE << std::endl;
 
+  if (IsPacked() == true) {
+    os << "Packed into " << tile_size << " bytes";
+    return os.str();
+  }
+
   TupleIterator tile_itr(this);
   Tuple tuple(&schema);
 
@@ -28,7 +28,8 @@ namespace peloton {
 namespace storage {
 
 TileGroup::TileGroup(BackendType backend_type,
-                     TileGroupHeader *tile_group_header, AbstractTable *table,
+                     std::shared_ptr<TileGroupHeader> tile_group_header,
+                     AbstractTable *table,
                      const std::vector<catalog::Schema> &schemas,
                      const column_map_type &column_map, int tuple_count)
     : database_id(INVALID_OID),
@@ -48,18 +49,26 @@ TileGroup::TileGroup(BackendType backend_type,
 
     std::shared_ptr<Tile> tile(storage::TileFactory::GetTile(
         backend_type, database_id, table_id, tile_group_id, tile_id,
-        tile_group_header, tile_schemas[tile_itr], this, tuple_count));
+        tile_group_header.get(), tile_schemas[tile_itr], this, tuple_count));
 
     // Add a reference to the tile in the tile group
     tiles.push_back(tile);
   }
+
+  for (auto &entry : column_map) {
+    const catalog::Schema &schema = tile_schemas[entry.second.first];
+    auto type_id = schema.GetType(entry.second.second);
+    if ((type_id == type::Type::TypeId::VARCHAR ||
+         type_id == type::Type::TypeId::VARBINARY) &&
+        schema.IsInlined(entry.second.second) == false) {
+      varlen_columns.push_back({entry.first, entry.second.first,
+                                schema.GetOffset(entry.second.second)});
+    }
+  }
 }
 
 TileGroup::~TileGroup() {
-  // Drop references on all tiles
-
-  // clean up tile group header
-  delete tile_group_header;
+  // Drop references on all tiles, and on the tile group header
 }
 
 oid_t TileGroup::GetTileId(const oid_t tile_id) const {
@@ -123,6 +132,130 @@ void TileGroup::CopyTuple(const Tuple *tuple, const oid_t &tuple_slot_id) {
   }
 }
 
+/**
+ * Copy a version, sharing the varlen data with the source version.
+ */
+void TileGroup::CopyVersion(const TileGroup *source,
+                            const oid_t source_slot_id,
+                            const oid_t tuple_slot_id) {
+  // the varlen data of an immutable tile group is not moved to other pools,
+  // as the tile group may be replaced by a copy, see
+  // DataTable::TransformTileGroup()
+  oid_t shared_column_count = 64;
+  if (source->GetHeader()->IsImmutable() == true) {
+    shared_column_count = 0;
+  }
+
+  if (source->column_map == column_map) {
+    // same layout, copy the tuples of the tiles as they are, unpacking the
+    // packed tiles of a compressed tile group
+    for (oid_t tile_itr = 0; tile_itr < tile_count; tile_itr++) {
+      source->GetTile(tile_itr)->CopyTupleTo(
+          source_slot_id, GetTile(tile_itr)->GetTupleLocation(tuple_slot_id));
+    }
+
+    // the columns that can not be shared get their own copy
+    for (auto &varlen_column : varlen_columns) {
+      if (varlen_column.column_id < shared_column_count) {
+        continue;
+      }
+      oid_t tile_offset, tile_column_offset;
+      LocateTileAndColumn(varlen_column.column_id, tile_offset,
+                          tile_column_offset);
+      Tile *tile = GetTile(tile_offset);
+      type::Value value = source->GetTile(tile_offset)->GetValue(
+          source_slot_id, tile_column_offset);
+      tile->SetValue(value, tuple_slot_id, tile_column_offset);
+    }
+    return;
+  }
+
+  // different layouts, copy column by column
+  for (auto &entry : column_map) {
+    oid_t column_id = entry.first;
+    Tile *tile = GetTile(entry.second.first);
+    const catalog::Schema &schema = tile_schemas[entry.second.first];
+
+    oid_t source_tile_offset, source_tile_column_offset;
+    source->LocateTileAndColumn(column_id, source_tile_offset,
+                                source_tile_column_offset);
+    Tile *source_tile = source->GetTile(source_tile_offset);
+
+    auto type_id = schema.GetType(entry.second.second);
+    if (column_id < shared_column_count &&
+        (type_id == type::Type::TypeId::VARCHAR ||
+         type_id == type::Type::TypeId::VARBINARY) &&
+        schema.IsInlined(entry.second.second) == false) {
+      const catalog::Schema &source_schema =
+          source->tile_schemas[source_tile_offset];
+      *reinterpret_cast<char **>(tile->GetTupleLocation(tuple_slot_id) +
+                                 schema.GetOffset(entry.second.second)) =
+          *reinterpret_cast<char **>(
+              source_tile->GetTupleLocation(source_slot_id) +
+              source_schema.GetOffset(source_tile_column_offset));
+      continue;
+    }
+
+    type::Value value =
+        source_tile->GetValue(source_slot_id, source_tile_column_offset);
+    tile->SetValue(value, tuple_slot_id, entry.second.second);
+  }
+}
+
+uint64_t TileGroup::GetSharedVarlenColumns(const oid_t tuple_slot_id,
+                                           const TileGroup *other,
+                                           const oid_t other_slot_id) const {
+  PL_ASSERT(varlen_columns.size() == other->varlen_columns.size());
+
+  uint64_t shared_columns = 0;
+  for (size_t itr = 0; itr < varlen_columns.size(); itr++) {
+    auto &varlen_column = varlen_columns[itr];
+    if (varlen_column.column_id >= 64) {
+      break;
+    }
+    auto &other_column = other->varlen_columns[itr];
+
+    char *data = *reinterpret_cast<char **>(
+        GetTile(varlen_column.tile_offset)->GetTupleLocation(tuple_slot_id) +
+        varlen_column.field_offset);
+    char *other_data = *reinterpret_cast<char **>(
+        other->GetTile(other_column.tile_offset)
+            ->GetTupleLocation(other_slot_id) +
+        other_column.field_offset);
+    if (data != nullptr && data == other_data) {
+      shared_columns |= 1ul << varlen_column.column_id;
+    }
+  }
+  return shared_columns;
+}
+
+void TileGroup::AdoptVarlenColumns(const oid_t tuple_slot_id,
+                                   const TileGroup *source,
+                                   const uint64_t columns) {
+  PL_ASSERT(varlen_columns.size() == source->varlen_columns.size());
+
+  for (size_t itr = 0; itr < varlen_columns.size(); itr++) {
+    auto &varlen_column = varlen_columns[itr];
+    if (varlen_column.column_id >= 64) {
+      break;
+    }
+    if ((columns & (1ul << varlen_column.column_id)) == 0) {
+      continue;
+    }
+
+    Tile *tile = GetTile(varlen_column.tile_offset);
+    auto source_pool =
+        source->GetTile(source->varlen_columns[itr].tile_offset)->GetPool();
+    if (source_pool == tile->GetPool()) {
+      continue;
+    }
+    char *data = *reinterpret_cast<char **>(
+        tile->GetTupleLocation(tuple_slot_id) + varlen_column.field_offset);
+    source_pool->Release(data);
+    tile->GetPool()->Adopt(data);
+  }
+}
+
 /**
  * Grab next slot (thread-safe) and fill in the tuple if tuple != nullptr
  *
@@ -32,7 +32,8 @@ TileGroup *TileGroupFactory::GetTileGroup(
   BackendType backend_type =
       logging::LoggingUtil::GetBackendType(peloton_logging_mode);
 
-  TileGroupHeader *tile_header = new TileGroupHeader(backend_type, tuple_count);
+  std::shared_ptr<TileGroupHeader> tile_header(
+      new TileGroupHeader(backend_type, tuple_count));
   TileGroup *tile_group = new TileGroup(backend_type, tile_header, table,
                                         schemas, column_map, tuple_count);
 
@@ -45,5 +46,19 @@ TileGroup *TileGroupFactory::GetTileGroup(
   return tile_group;
 }
 
+TileGroup *TileGroupFactory::GetTransformedTileGroup(
+    const TileGroup *tile_group, const std::vector<catalog::Schema> &schemas,
+    const column_map_type &column_map) {
+  TileGroup *new_tile_group = new TileGroup(
+      tile_group->backend_type, tile_group->tile_group_header,
+      tile_group->table, schemas, column_map, tile_group->num_tuple_slots);
+
+  new_tile_group->database_id = tile_group->database_id;
+  new_tile_group->tile_group_id = tile_group->tile_group_id;
+  new_tile_group->table_id = tile_group->table_id;
+
+  return new_tile_group;
+}
+
 }  // End storage namespace
 }  // End peloton namespace
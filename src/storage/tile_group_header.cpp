@@ -35,7 +35,9 @@ TileGroupHeader::TileGroupHeader(const BackendType &backend_type,
       data(nullptr),
       num_tuple_slots(tuple_count),
       next_tuple_slot(0),
-      tile_header_lock() {
+      tile_header_lock(),
+      immutable_cid(MAX_CID),
+      thaw_cid(MAX_CID) {
   header_size = num_tuple_slots * header_entry_size;
 
   // allocate storage space for header
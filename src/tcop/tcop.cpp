@@ -175,10 +175,21 @@ ResultType TrafficCop::ExecuteStatement(
 
 ResultType TrafficCop::ExecuteStatement(
     const std::shared_ptr<Statement> &statement,
-    const std::vector<type::Value> &params, UNUSED_ATTRIBUTE const bool unnamed,
+    const std::vector<type::Value> &params, const bool unnamed,
     std::shared_ptr<stats::QueryMetric::QueryParams> param_stats,
     const std::vector<int> &result_format, std::vector<StatementResult> &result,
-    int &rows_changed, UNUSED_ATTRIBUTE std::string &error_message,
+    int &rows_changed, std::string &error_message, const size_t thread_id) {
+  executor::BufferingResultSink sink{result_format, result};
+  return ExecuteStatement(statement, params, unnamed, param_stats, sink,
+                          rows_changed, error_message, thread_id);
+}
+
+ResultType TrafficCop::ExecuteStatement(
+    const std::shared_ptr<Statement> &statement,
+    const std::vector<type::Value> &params, UNUSED_ATTRIBUTE const bool unnamed,
+    std::shared_ptr<stats::QueryMetric::QueryParams> param_stats,
+    executor::ResultSink &sink, int &rows_changed,
+    UNUSED_ATTRIBUTE std::string &error_message,
     const size_t thread_id UNUSED_ATTRIBUTE) {
   if (FLAGS_stats_mode != STATS_TYPE_INVALID) {
     stats::BackendStatsContext::GetInstance()->InitQueryMetric(statement,
@@ -200,8 +211,7 @@ ResultType TrafficCop::ExecuteStatement(
       return AbortQueryHelper();
     else {
       auto status = ExecuteStatementPlan(statement->GetPlanTree().get(), params,
-                                         result, result_format,
-                                         thread_id);
+                                         sink, thread_id);
       LOG_TRACE("Statement executed. Result: %s",
                 ResultTypeToString(status.m_result).c_str());
       rows_changed = status.m_processed;
@@ -217,6 +227,14 @@ executor::ExecuteResult TrafficCop::ExecuteStatementPlan(
     const planner::AbstractPlan *plan, const std::vector<type::Value> &params,
     std::vector<StatementResult> &result, const std::vector<int> &result_format,
     const size_t thread_id) {
+  result.clear();
+  executor::BufferingResultSink sink{result_format, result};
+  return ExecuteStatementPlan(plan, params, sink, thread_id);
+}
+
+executor::ExecuteResult TrafficCop::ExecuteStatementPlan(
+    const planner::AbstractPlan *plan, const std::vector<type::Value> &params,
+    executor::ResultSink &sink, const size_t thread_id) {
   concurrency::Transaction *txn;
   bool single_statement_txn = false, init_failure = false;
   executor::ExecuteResult p_status;
@@ -237,8 +255,7 @@ executor::ExecuteResult TrafficCop::ExecuteStatementPlan(
   // skip if already aborted
   if (curr_state.second != ResultType::ABORTED) {
     PL_ASSERT(txn);
-    p_status = executor::PlanExecutor::ExecutePlan(plan, txn, params, result,
-                                                 result_format);
+    p_status = executor::PlanExecutor::ExecutePlan(plan, txn, params, sink);
 
     if (p_status.m_result == ResultType::FAILURE) {
       // only possible if init failed
@@ -24,7 +24,6 @@ void WorkerHandleNewConn(evutil_socket_t new_conn_recv_fd,
   // buffer used to receive messages from the main thread
   char m_buf[1];
   std::shared_ptr<NewConnQueueItem> item;
-  LibeventSocket *conn;
   LibeventWorkerThread *thread = static_cast<LibeventWorkerThread *>(arg);
 
   // pipe fds should match
@@ -40,21 +39,27 @@ void WorkerHandleNewConn(evutil_socket_t new_conn_recv_fd,
     /* new connection case */
     case 'c': {
       // fetch the new connection fd from the queue
-      thread->new_conn_queue.Dequeue(item);
-      conn = LibeventServer::GetConn(item->new_conn_fd);
-      if (conn == nullptr) {
-        LOG_DEBUG("Creating new socket fd:%d", item->new_conn_fd);
-        /* create a new connection object */
-        LibeventServer::CreateNewConn(item->new_conn_fd, item->event_flags,
-                                      static_cast<LibeventThread *>(thread),
-                                      CONN_READ);
+      if (thread->DequeueConnection(item) == false) {
+        LOG_ERROR("Notified of a new connection but the queue is empty");
+        break;
+      }
+      if (item->init_state == CONN_LISTENING) {
+        thread->AddListener(item->new_conn_fd, item->event_flags);
       } else {
-        LOG_DEBUG("Reusing socket fd:%d", item->new_conn_fd);
-        /* otherwise reset and reuse the existing conn object */
-        conn->Reset();
-        conn->Init(item->event_flags, static_cast<LibeventThread *>(thread),
-                   CONN_READ);
+        thread->AddConnection(item->new_conn_fd, item->event_flags);
+      }
+      break;
+    }
+
+    /* the execution pool is done with a packet */
+    case 'e': {
+      LibeventSocket *conn;
+      if (thread->executed_conn_queue.Dequeue(conn) == false) {
+        LOG_ERROR("Notified of an executed packet but the queue is empty");
+        break;
       }
+      conn->ResumeExecution();
+      StateMachine(conn);
       break;
     }
 
@@ -85,9 +90,18 @@ void StateMachine(LibeventSocket *conn) {
             accept(conn->sock_fd, (struct sockaddr *)&addr, &addrlen);
         if (new_conn_fd == -1) {
           LOG_ERROR("Failed to accept");
+          done = true;
+          break;
+        }
+        if (conn->thread_id == MASTER_THREAD_ID) {
+          (static_cast<LibeventMasterThread *>(conn->thread))
+              ->DispatchConnection(new_conn_fd, EV_READ | EV_PERSIST);
+        } else {
+          // the kernel picked the listening socket of this worker, so the
+          // connection is served here without going through the master
+          (static_cast<LibeventWorkerThread *>(conn->thread))
+              ->AddConnection(new_conn_fd, EV_READ | EV_PERSIST);
         }
-        (static_cast<LibeventMasterThread *>(conn->thread))
-            ->DispatchConnection(new_conn_fd, EV_READ | EV_PERSIST);
         done = true;
         break;
       }
@@ -147,6 +161,17 @@ void StateMachine(LibeventSocket *conn) {
         }
         PL_ASSERT(conn->rpkt.is_initialized == true);
 
+        if (FLAGS_execution_pool && conn->pkt_manager.is_started == true) {
+          auto priority = conn->pkt_manager.GetExecutionPriority(&conn->rpkt);
+          if (priority != TaskPriorityType::INVALID) {
+            // Run the statement on the execution pool, this worker serves
+            // its other connections meanwhile
+            conn->ExecutePacket(priority);
+            done = true;
+            break;
+          }
+        }
+
         if (conn->pkt_manager.is_started == false) {
           // We need to handle startup packet first
           status = conn->pkt_manager.ProcessStartupPacket(&conn->rpkt);
@@ -200,6 +225,7 @@ void StateMachine(LibeventSocket *conn) {
         break;
       }
 
+      case CONN_EXECUTING:
       case CONN_CLOSED: {
         done = true;
         break;
@@ -58,6 +58,13 @@ void LibeventServer::CreateNewConn(const int &connfd, short ev_flags,
 }
 
 LibeventServer::LibeventServer() {
+  if (FLAGS_connection_dispatch != "round_robin" &&
+      FLAGS_connection_dispatch != "least_loaded" &&
+      FLAGS_connection_dispatch != "reuseport") {
+    throw ConnectionException("Unsupported connection dispatch: " +
+                              FLAGS_connection_dispatch);
+  }
+
   base_ = event_base_new();
 
   // Create our event base
@@ -96,49 +103,77 @@ LibeventServer::LibeventServer() {
   signal(SIGPIPE, SIG_IGN);
 }
 
-void LibeventServer::StartServer() {
-  if (FLAGS_socket_family == "AF_INET") {
-    struct sockaddr_in sin;
-    PL_MEMSET(&sin, 0, sizeof(sin));
-    sin.sin_family = AF_INET;
-    sin.sin_addr.s_addr = INADDR_ANY;
-    sin.sin_port = htons(port_);
+int LibeventServer::CreateListenSocket(bool reuse_port) {
+  struct sockaddr_in sin;
+  PL_MEMSET(&sin, 0, sizeof(sin));
+  sin.sin_family = AF_INET;
+  sin.sin_addr.s_addr = INADDR_ANY;
+  sin.sin_port = htons(port_);
 
-    int listen_fd;
+  int listen_fd;
 
-    listen_fd = socket(AF_INET, SOCK_STREAM, 0);
+  listen_fd = socket(AF_INET, SOCK_STREAM, 0);
 
-    if (listen_fd < 0) {
-      throw ConnectionException("Failed to create listen socket");
-    }
+  if (listen_fd < 0) {
+    throw ConnectionException("Failed to create listen socket");
+  }
 
-    int reuse = 1;
-    setsockopt(listen_fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+  int reuse = 1;
+  setsockopt(listen_fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
 
-    if (bind(listen_fd, (struct sockaddr *)&sin, sizeof(sin)) < 0) {
-      throw ConnectionException("Failed to bind socket to port: " +
-                                std::to_string(port_));
-    }
+  // every socket bound with SO_REUSEPORT gets its own accept queue, and the
+  // kernel spreads the incoming connections over them
+  if (reuse_port &&
+      setsockopt(listen_fd, SOL_SOCKET, SO_REUSEPORT, &reuse,
+                 sizeof(reuse)) < 0) {
+    throw ConnectionException("Failed to set SO_REUSEPORT on listen socket");
+  }
 
-    int conn_backlog = 12;
-    if (listen(listen_fd, conn_backlog) < 0) {
-      throw ConnectionException("Failed to listen to socket");
-    }
+  if (bind(listen_fd, (struct sockaddr *)&sin, sizeof(sin)) < 0) {
+    throw ConnectionException("Failed to bind socket to port: " +
+                              std::to_string(port_));
+  }
 
-    LibeventServer::CreateNewConn(listen_fd, EV_READ | EV_PERSIST,
-                                  master_thread_.get(), CONN_LISTENING);
+  int conn_backlog = 12;
+  if (listen(listen_fd, conn_backlog) < 0) {
+    throw ConnectionException("Failed to listen to socket");
+  }
+
+  return listen_fd;
+}
+
+void LibeventServer::StartServer() {
+  if (FLAGS_socket_family == "AF_INET") {
+    auto master_thread =
+        static_cast<LibeventMasterThread *>(master_thread_.get());
+    int listen_fd = -1;
+
+    if (FLAGS_connection_dispatch == "reuseport") {
+      // every worker accepts on a socket of its own, the master only
+      // handles the signals and the timeouts
+      size_t num_threads = master_thread->GetWorkerThreads().size();
+      for (size_t thread_id = 0; thread_id < num_threads; thread_id++) {
+        master_thread->DispatchListener(thread_id, CreateListenSocket(true),
+                                        EV_READ | EV_PERSIST);
+      }
+    } else {
+      listen_fd = CreateListenSocket(false);
+      LibeventServer::CreateNewConn(listen_fd, EV_READ | EV_PERSIST,
+                                    master_thread, CONN_LISTENING);
+    }
 
     LOG_INFO("Listening on port %lu", port_);
     event_base_dispatch(base_);
-    LibeventServer::GetConn(listen_fd)->CloseSocket();
+    if (listen_fd != -1) {
+      LibeventServer::GetConn(listen_fd)->CloseSocket();
+      event_free(LibeventServer::GetConn(listen_fd)->event);
+    }
 
     // Free events and event base
-    event_free(LibeventServer::GetConn(listen_fd)->event);
     event_free(ev_stop_);
     event_free(ev_timeout_);
     event_base_free(base_);
-    static_cast<LibeventMasterThread *>(master_thread_.get())
-        ->CloseConnection();
+    master_thread->CloseConnection();
 
     LOG_INFO("Server Closed");
   }
@@ -10,8 +10,13 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <poll.h>
+#include <chrono>
+#include <sys/uio.h>
 #include <unistd.h>
 #include "wire/libevent_server.h"
+#include "common/init.h"
+#include "common/thread_pool.h"
 
 namespace peloton {
 namespace wire {
@@ -22,6 +27,7 @@ void LibeventSocket::Init(short event_flags, LibeventThread *thread,
   SetTCPNoDelay(sock_fd);
 
   this->event_flags = event_flags;
+  this->listen_flags_ = event_flags;
   this->thread = thread;
   this->state = init_state;
 
@@ -29,6 +35,9 @@ void LibeventSocket::Init(short event_flags, LibeventThread *thread,
 
   // clear out packet
   rpkt.Reset();
+
+  // let long results be written out while they are produced
+  pkt_manager.stream_responses = [this]() { return StreamPackets(); };
   if (event == nullptr) {
     event = event_new(thread->GetEventBase(), sock_fd, event_flags,
                       EventHandler, this);
@@ -58,6 +67,18 @@ void LibeventSocket::TransitState(ConnState next_state) {
 
 // Update event
 bool LibeventSocket::UpdateEvent(short flags) {
+  // the event of a parked connection belongs to the worker, which re-arms it
+  // when the execution pool is done
+  if (state == CONN_EXECUTING) {
+    return true;
+  }
+
+  // the state machine asks for reads after every packet, skip the syscalls
+  // when the event already listens to them
+  if (flags == listen_flags_) {
+    return true;
+  }
+
   auto base = thread->GetEventBase();
   if (event_del(event) == -1) {
     LOG_ERROR("Failed to delete event");
@@ -75,8 +96,10 @@ bool LibeventSocket::UpdateEvent(short flags) {
 
   if (event_add(event, nullptr) == -1) {
     LOG_ERROR("Failed to add event");
+    listen_flags_ = 0;
     return false;
   }
+  listen_flags_ = flags;
 
   return true;
 }
@@ -95,6 +118,22 @@ bool LibeventSocket::IsReadDataAvailable(size_t bytes) {
   return ((rbuf_.buf_ptr - 1) + bytes < rbuf_.buf_size);
 }
 
+bool LibeventSocket::IsPacketAvailable() {
+  // the startup packet is never pipelined
+  size_t header_size = 1 + sizeof(int32_t);
+  if (pkt_manager.is_started == false ||
+      IsReadDataAvailable(header_size) == false) {
+    return false;
+  }
+
+  // the length includes itself but not the type
+  size_t len = 0;
+  for (size_t i = rbuf_.buf_ptr + 1; i < rbuf_.buf_ptr + header_size; i++) {
+    len = (len << 8) | rbuf_.GetByte(i);
+  }
+  return IsReadDataAvailable(1 + len);
+}
+
 // The function tries to do a preliminary read to fetch the size value and
 // then reads the rest of the packet.
 // Assume: Packet length field is always 32-bit int
@@ -190,11 +229,58 @@ WriteState LibeventSocket::WritePackets() {
   next_response_ = 0;
 
   if (pkt_manager.force_flush == true) {
+    // The client pipelines its messages. Process the ones already received
+    // first, so that all their responses go out in a single write.
+    if (IsPacketAvailable() == true) {
+      return WRITE_COMPLETE;
+    }
     return FlushWriteBuffer();
   }
   return WRITE_COMPLETE;
 }
 
+bool LibeventSocket::StreamPackets() {
+  // keep the flush requested for the end of the query
+  bool force_flush = pkt_manager.force_flush;
+  pkt_manager.force_flush = false;
+
+  auto deadline = std::chrono::steady_clock::now() +
+                  std::chrono::milliseconds(RESULT_STREAM_TIMEOUT_MS);
+  WriteState result;
+  for (;;) {
+    result = WritePackets();
+    if (result == WRITE_COMPLETE) {
+      result = FlushWriteBuffer();
+    }
+    if (result != WRITE_NOT_READY) {
+      break;
+    }
+
+    // The client is not reading fast enough. Hold the query until the socket
+    // drains, so the result doesn't pile up in memory, but not for longer
+    // than RESULT_STREAM_TIMEOUT_MS in all.
+    auto timeout = std::chrono::duration_cast<std::chrono::milliseconds>(
+                       deadline - std::chrono::steady_clock::now()).count();
+    if (timeout <= 0) {
+      LOG_ERROR("Timed out waiting for the client to read the result");
+      result = WRITE_ERROR;
+      break;
+    }
+    struct pollfd poll_fd;
+    poll_fd.fd = sock_fd;
+    poll_fd.events = POLLOUT;
+    poll_fd.revents = 0;
+    if (poll(&poll_fd, 1, static_cast<int>(timeout)) < 0 && errno != EINTR) {
+      LOG_ERROR("Failed to wait for the socket to drain");
+      result = WRITE_ERROR;
+      break;
+    }
+  }
+
+  pkt_manager.force_flush = force_flush;
+  return result == WRITE_COMPLETE;
+}
+
 ReadState LibeventSocket::FillReadBuffer() {
   ReadState result = READ_NO_DATA_RECEIVED;
   ssize_t bytes_read = 0;
@@ -422,7 +508,7 @@ WriteState LibeventSocket::BufferWriteBytesHeader(OutputPacket *pkt) {
 
   // move the write buffer pointer and update size of the socket buffer
   wbuf_.buf_ptr += sizeof(int32_t);
-  wbuf_.buf_size = wbuf_.buf_ptr;
+  wbuf_.buf_size += (type != 0) ? 1 + sizeof(int32_t) : sizeof(int32_t);
 
   // Header is written to socket buf. No need to write it in the future
   pkt->skip_header_write = true;
@@ -435,7 +521,7 @@ WriteState LibeventSocket::BufferWriteBytesContent(OutputPacket *pkt) {
   // the packet content to write
   ByteBuf &pkt_buf = pkt->buf;
   // the length of remaining content to write
-  size_t len = pkt->len;
+  size_t len = pkt->len - pkt->write_ptr;
   // window is the size of remaining space in socket's wbuf
   size_t window = 0;
 
@@ -450,14 +536,18 @@ WriteState LibeventSocket::BufferWriteBytesContent(OutputPacket *pkt) {
                 std::begin(wbuf_.buf) + wbuf_.buf_ptr);
 
       // Move the cursor and update size of socket buffer
+      pkt->write_ptr += len;
       wbuf_.buf_ptr += len;
-      wbuf_.buf_size = wbuf_.buf_ptr;
+      wbuf_.buf_size += len;
       LOG_TRACE("Content fit in window. Write content successful");
       return WRITE_COMPLETE;
+    } else if (len >= wbuf_.GetMaxSize()) {
+      // contents longer than socket buffer size, write them out together
+      // with the buffered bytes instead of copying them through the buffer
+      LOG_TRACE("Content doesn't fit in buffer. Write it directly");
+      return FlushWriteBufferWithContent(pkt);
     } else {
-      // contents longer than socket buffer size, fill up the socket buffer
-      // with "window" bytes
-
+      // fill up the socket buffer with "window" bytes
       std::copy(std::begin(pkt_buf) + pkt->write_ptr,
                 std::begin(pkt_buf) + pkt->write_ptr + window,
                 std::begin(wbuf_.buf) + wbuf_.buf_ptr);
@@ -466,7 +556,8 @@ WriteState LibeventSocket::BufferWriteBytesContent(OutputPacket *pkt) {
       pkt->write_ptr += window;
       len -= window;
       // Now the wbuf is full
-      wbuf_.buf_size = wbuf_.GetMaxSize();
+      wbuf_.buf_ptr += window;
+      wbuf_.buf_size += window;
 
       LOG_TRACE("Content doesn't fit in window. Try flushing");
       auto result = FlushWriteBuffer();
@@ -480,12 +571,88 @@ WriteState LibeventSocket::BufferWriteBytesContent(OutputPacket *pkt) {
   return WRITE_COMPLETE;
 }
 
+WriteState LibeventSocket::FlushWriteBufferWithContent(OutputPacket *pkt) {
+  while (wbuf_.buf_size > 0 || pkt->write_ptr < pkt->len) {
+    // the buffered bytes, then the rest of the packet, in one syscall
+    struct iovec iov[2];
+    int iov_count = 0;
+    if (wbuf_.buf_size > 0) {
+      iov[iov_count].iov_base = wbuf_.GetPtr(wbuf_.buf_flush_ptr);
+      iov[iov_count].iov_len = wbuf_.buf_size;
+      iov_count++;
+    }
+    iov[iov_count].iov_base = &pkt->buf[pkt->write_ptr];
+    iov[iov_count].iov_len = pkt->len - pkt->write_ptr;
+    iov_count++;
+
+    ssize_t written_bytes = writev(sock_fd, iov, iov_count);
+    if (written_bytes < 0) {
+      if (errno == EINTR) {
+        // interrupts are ok, try again
+        continue;
+      } else if (errno == EAGAIN || errno == EWOULDBLOCK) {
+        // Listen for socket being enabled for write
+        UpdateEvent(EV_WRITE | EV_PERSIST);
+        return WRITE_NOT_READY;
+      } else {
+        LOG_ERROR("Fatal error during write");
+        return WRITE_ERROR;
+      }
+    }
+
+    // update book keeping, the buffered bytes go first
+    size_t buffered_bytes =
+        std::min(static_cast<size_t>(written_bytes), wbuf_.buf_size);
+    wbuf_.buf_flush_ptr += buffered_bytes;
+    wbuf_.buf_size -= buffered_bytes;
+    if (wbuf_.buf_size == 0) {
+      wbuf_.Reset();
+    }
+    pkt->write_ptr += written_bytes - buffered_bytes;
+  }
+  return WRITE_COMPLETE;
+}
+
+void LibeventSocket::ExecutePacket(TaskPriorityType priority) {
+  // the worker must not run the state machine of this connection while the
+  // packet executes
+  event_del(event);
+  TransitState(CONN_EXECUTING);
+
+  thread_pool.SubmitTaskWithPriority(priority, [this]() {
+    execution_status_ =
+        pkt_manager.ProcessPacket(&rpkt, static_cast<size_t>(thread_id));
+    static_cast<LibeventWorkerThread *>(thread)->NotifyExecutionDone(this);
+  });
+}
+
+void LibeventSocket::ResumeExecution() {
+  PL_ASSERT(state == CONN_EXECUTING);
+  if (event_add(event, nullptr) == -1) {
+    LOG_ERROR("Failed to add event");
+    TransitState(CONN_CLOSING);
+    return;
+  }
+
+  if (execution_status_ == false) {
+    // packet processing can't proceed further
+    TransitState(CONN_CLOSING);
+  } else {
+    // We should have responses ready to send
+    TransitState(CONN_WRITE);
+  }
+}
+
 void LibeventSocket::CloseSocket() {
   LOG_DEBUG("Attempt to close the connection %d", sock_fd);
   // Remove listening event
   event_del(event);
   // event_free(event);
 
+  // a closed connection is reset to CONN_INVALID, count it only once
+  if (state != CONN_LISTENING && state != CONN_INVALID) {
+    static_cast<LibeventWorkerThread *>(thread)->RemoveConnection();
+  }
   TransitState(CONN_CLOSED);
   Reset();
   for (;;) {
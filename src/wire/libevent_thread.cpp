@@ -18,6 +18,7 @@
 #include "common/thread_pool.h"
 #include "wire/libevent_server.h"
 #include "concurrency/epoch_manager_factory.h"
+#include "statistics/backend_stats_context.h"
 
 namespace peloton {
 namespace wire {
@@ -39,7 +40,8 @@ LibeventMasterThread::LibeventMasterThread(const int num_threads,
                                            struct event_base *libevent_base)
     : LibeventThread(MASTER_THREAD_ID, libevent_base),
       num_threads_(num_threads),
-      next_thread_id_(0) {
+      next_thread_id_(0),
+      least_loaded_(FLAGS_connection_dispatch == "least_loaded") {
   auto &threads = GetWorkerThreads();
   threads.clear();
 
@@ -75,6 +77,11 @@ void LibeventMasterThread::StartWorker(LibeventWorkerThread *worker_thread) {
   // Set worker thread's close flag to false to indicate loop has exited
   worker_thread->SetThreadIsClosed(false);
 
+  // Stop accepting on the listening socket of the worker
+  if (worker_thread->GetListenFd() != -1) {
+    LibeventServer::GetConn(worker_thread->GetListenFd())->CloseSocket();
+  }
+
   // Free events and event base
   if (worker_thread->GetThreadSockFd() != -1) {
     event_free(
@@ -90,7 +97,11 @@ void LibeventMasterThread::StartWorker(LibeventWorkerThread *worker_thread) {
 * constructor.
 */
 LibeventWorkerThread::LibeventWorkerThread(const int thread_id)
-    : LibeventThread(thread_id, event_base_new()), new_conn_queue(QUEUE_SIZE) {
+    : LibeventThread(thread_id, event_base_new()),
+      queued_connections_(0),
+      active_connections_(0),
+      new_conn_queue(QUEUE_SIZE),
+      executed_conn_queue(QUEUE_SIZE) {
   int fds[2];
   if (pipe(fds)) {
     LOG_ERROR("Can't create notify pipe to accept connections");
@@ -118,31 +129,127 @@ LibeventWorkerThread::LibeventWorkerThread(const int thread_id)
 }
 
 /*
-* Dispatch a new connection event to a random worker thread by
-* writing to the worker's pipe
+* Queue a new connection request and wake up the worker by writing to its
+* pipe
 */
-void LibeventMasterThread::DispatchConnection(int new_conn_fd,
-                                              short event_flags) {
+void LibeventWorkerThread::EnqueueConnection(
+    std::shared_ptr<NewConnQueueItem> item) {
   char buf[1];
   buf[0] = 'c';
+
+  queued_connections_++;
+  new_conn_queue.Enqueue(item);
+  if (FLAGS_stats_mode != STATS_TYPE_INVALID) {
+    stats::BackendStatsContext::GetInstance()->IncrementConnectionsDispatched(
+        thread_id_);
+  }
+
+  if (write(GetNewConnSendFd(), buf, 1) != 1) {
+    LOG_ERROR("Failed to write to thread notify pipe");
+  }
+}
+
+bool LibeventWorkerThread::DequeueConnection(
+    std::shared_ptr<NewConnQueueItem> &item) {
+  if (new_conn_queue.Dequeue(item) == false) {
+    return false;
+  }
+  queued_connections_--;
+  if (FLAGS_stats_mode != STATS_TYPE_INVALID) {
+    stats::BackendStatsContext::GetInstance()->IncrementConnectionsDequeued(
+        thread_id_);
+  }
+  return true;
+}
+
+void LibeventWorkerThread::AddConnection(int conn_fd, short event_flags) {
+  LibeventSocket *conn = LibeventServer::GetConn(conn_fd);
+  if (conn == nullptr) {
+    LOG_DEBUG("Creating new socket fd:%d", conn_fd);
+    /* create a new connection object */
+    LibeventServer::CreateNewConn(conn_fd, event_flags,
+                                  static_cast<LibeventThread *>(this),
+                                  CONN_READ);
+  } else {
+    LOG_DEBUG("Reusing socket fd:%d", conn_fd);
+    /* otherwise reset and reuse the existing conn object */
+    conn->Reset();
+    conn->Init(event_flags, static_cast<LibeventThread *>(this), CONN_READ);
+  }
+
+  active_connections_++;
+  if (FLAGS_stats_mode != STATS_TYPE_INVALID) {
+    stats::BackendStatsContext::GetInstance()->IncrementConnectionsOpened(
+        thread_id_);
+  }
+}
+
+void LibeventWorkerThread::RemoveConnection() {
+  active_connections_--;
+  if (FLAGS_stats_mode != STATS_TYPE_INVALID) {
+    stats::BackendStatsContext::GetInstance()->IncrementConnectionsClosed(
+        thread_id_);
+  }
+}
+
+void LibeventWorkerThread::AddListener(int listen_fd, short event_flags) {
+  LOG_DEBUG("Worker %d listening on socket fd:%d", thread_id_, listen_fd);
+  LibeventServer::CreateNewConn(listen_fd, event_flags,
+                                static_cast<LibeventThread *>(this),
+                                CONN_LISTENING);
+  listen_fd_ = listen_fd;
+}
+
+void LibeventWorkerThread::NotifyExecutionDone(LibeventSocket *conn) {
+  char buf[1];
+  buf[0] = 'e';
+
+  executed_conn_queue.Enqueue(conn);
+  if (write(GetNewConnSendFd(), buf, 1) != 1) {
+    LOG_ERROR("Failed to write to thread notify pipe");
+  }
+}
+
+/*
+* Dispatch a new connection event to a worker thread, either the next one
+* in round robin order or the one with the fewest connections
+*/
+void LibeventMasterThread::DispatchConnection(int new_conn_fd,
+                                              short event_flags) {
   auto &threads = GetWorkerThreads();
 
-  // Dispatch by rand number
   int thread_id = next_thread_id_;
 
   // update next threadID
   next_thread_id_ = (next_thread_id_ + 1) % num_threads_;
 
+  // start the scan at the round robin pick, so that ties are spread evenly
+  if (least_loaded_) {
+    int first_id = thread_id;
+    int min_load = threads[first_id]->GetLoad();
+    for (int offset = 1; offset < num_threads_ && min_load > 0; offset++) {
+      int candidate_id = (first_id + offset) % num_threads_;
+      int load = threads[candidate_id]->GetLoad();
+      if (load < min_load) {
+        min_load = load;
+        thread_id = candidate_id;
+      }
+    }
+  }
+
   std::shared_ptr<LibeventWorkerThread> worker_thread = threads[thread_id];
   LOG_DEBUG("Dispatching connection to worker %d", thread_id);
 
   std::shared_ptr<NewConnQueueItem> item(
       new NewConnQueueItem(new_conn_fd, event_flags, CONN_READ));
-  worker_thread->new_conn_queue.Enqueue(item);
+  worker_thread->EnqueueConnection(item);
+}
 
-  if (write(worker_thread->GetNewConnSendFd(), buf, 1) != 1) {
-    LOG_ERROR("Failed to write to thread notify pipe");
-  }
+void LibeventMasterThread::DispatchListener(int thread_id, int listen_fd,
+                                            short event_flags) {
+  std::shared_ptr<NewConnQueueItem> item(
+      new NewConnQueueItem(listen_fd, event_flags, CONN_LISTENING));
+  GetWorkerThreads()[thread_id]->EnqueueConnection(item);
 }
 
 /*
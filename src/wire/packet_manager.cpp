@@ -183,14 +183,17 @@ bool PacketManager::ProcessStartupPacket(InputPacket *pkt) {
 }
 
 void PacketManager::PutTupleDescriptor(
-    const std::vector<FieldInfo> &tuple_descriptor) {
+    const std::vector<FieldInfo> &tuple_descriptor,
+    const std::vector<int> &result_format) {
   if (tuple_descriptor.empty()) return;
 
   std::unique_ptr<OutputPacket> pkt(new OutputPacket());
   pkt->msg_type = NetworkMessageType::ROW_DESCRIPTION;
   PacketPutInt(pkt.get(), tuple_descriptor.size(), 2);
 
-  for (auto col : tuple_descriptor) {
+  for (size_t column_itr = 0; column_itr < tuple_descriptor.size();
+       column_itr++) {
+    auto &col = tuple_descriptor[column_itr];
     PacketPutString(pkt.get(), std::get<0>(col));
     // TODO: Table Oid (int32)
     PacketPutInt(pkt.get(), 0, 4);
@@ -202,39 +205,75 @@ void PacketManager::PutTupleDescriptor(
     PacketPutInt(pkt.get(), std::get<2>(col), 2);
     // Type modifier (int32)
     PacketPutInt(pkt.get(), -1, 4);
-    // Format code for text
-    PacketPutInt(pkt.get(), 0, 2);
+    // Format code, text unless the client asked for binary and the type has
+    // a binary encoding, see DataRowSink
+    int format = (column_itr < result_format.size())
+                     ? result_format[column_itr]
+                     : 0;
+    format = executor::ResultSink::GetResultFormat(std::get<1>(col), format);
+    PacketPutInt(pkt.get(), format, 2);
   }
   responses.push_back(std::move(pkt));
 }
 
-void PacketManager::SendDataRows(std::vector<StatementResult> &results,
-                                 int colcount, int &rows_affected) {
-  if (results.empty() || colcount == 0) return;
+DataRowSink::DataRowSink(PacketManager &pkt_manager,
+                         const std::vector<FieldInfo> &tuple_descriptor,
+                         const std::vector<int> &result_format)
+    : pkt_manager_(pkt_manager) {
+  for (size_t column_itr = 0; column_itr < tuple_descriptor.size();
+       column_itr++) {
+    oid_t field_type = std::get<1>(tuple_descriptor[column_itr]);
+    int format = (column_itr < result_format.size())
+                     ? result_format[column_itr]
+                     : 0;
+    field_types_.push_back(field_type);
+    result_format_.push_back(GetResultFormat(field_type, format));
+  }
+}
 
-  size_t numrows = results.size() / colcount;
+void DataRowSink::AddRow(const type::Value *values, uint32_t num_values) {
+  if (failed_ == true) return;
 
   // 1 packet per row
-  for (size_t i = 0; i < numrows; i++) {
-    std::unique_ptr<OutputPacket> pkt(new OutputPacket());
-    pkt->msg_type = NetworkMessageType::DATA_ROW;
-    PacketPutInt(pkt.get(), colcount, 2);
-    for (int j = 0; j < colcount; j++) {
-      auto content = results[i * colcount + j].second;
-      if (content.size() == 0) {
-        // content is NULL
-        PacketPutInt(pkt.get(), NULL_CONTENT_SIZE, 4);
-        // no value bytes follow
-      } else {
-        // length of the row attribute
-        PacketPutInt(pkt.get(), content.size(), 4);
-        // contents of the row attribute
-        PacketPutBytes(pkt.get(), content);
-      }
+  std::unique_ptr<OutputPacket> pkt(new OutputPacket());
+  pkt->msg_type = NetworkMessageType::DATA_ROW;
+  PacketPutInt(pkt.get(), num_values, 2);
+  for (uint32_t column_itr = 0; column_itr < num_values; column_itr++) {
+    if (values[column_itr].IsNull() == true) {
+      // no value bytes follow
+      PacketPutInt(pkt.get(), NULL_CONTENT_SIZE, 4);
+      continue;
+    }
+    // length of the row attribute, known once its contents are written
+    PacketPutInt(pkt.get(), 0, 4);
+    size_t length_offset = pkt->buf.size() - sizeof(int32_t);
+
+    // contents of the row attribute, encoded right into the packet. The
+    // columns the descriptor doesn't cover are sent as text.
+    if (column_itr < field_types_.size()) {
+      SerializeValue(values[column_itr], field_types_[column_itr],
+                     result_format_[column_itr], pkt->buf);
+    } else {
+      SerializeValue(values[column_itr], 0, pkt->buf);
+    }
+    int32_t length = pkt->buf.size() - length_offset - sizeof(int32_t);
+    pkt->len += length;
+    length = htonl(length);
+    PL_MEMCPY(&pkt->buf[length_offset], &length, sizeof(int32_t));
+  }
+  batch_size_ += pkt->len;
+  pkt_manager_.responses.push_back(std::move(pkt));
+  row_count_++;
+
+  // Write out the batch, which blocks the query until the client has read
+  // enough of the result
+  if (batch_size_ >= RESULT_BATCH_SIZE && pkt_manager_.stream_responses) {
+    batch_size_ = 0;
+    if (pkt_manager_.stream_responses() == false) {
+      LOG_ERROR("Failed to send the result rows, dropping the rest");
+      failed_ = true;
     }
-    responses.push_back(std::move(pkt));
   }
-  rows_affected = numrows;
 }
 
 void PacketManager::CompleteCommand(const std::string &query_type, int rows) {
@@ -293,11 +332,55 @@ bool PacketManager::HardcodedExecuteFilter(std::string query_type) {
   return true;
 }
 
+bool PacketManager::PrepareQueryStatements(const std::string &query) {
+  prepared_query_ = query;
+  prepared_query_statements_.clear();
+
+  std::vector<std::string> queries;
+  boost::split(queries, query, boost::is_any_of(";"));
+  for (size_t query_itr = 0; query_itr < queries.size(); query_itr++) {
+    if (queries[query_itr].empty()) {
+      prepared_query_statements_.emplace_back();
+      continue;
+    }
+
+    // the execution prepares the statement again to report the error
+    std::string error_message;
+    auto statement = traffic_cop_->PrepareStatement(
+        "unnamed", queries[query_itr], error_message);
+    if (statement.get() == nullptr) {
+      return false;
+    }
+    prepared_query_statements_.push_back(statement);
+
+    std::string query_type = statement->GetQueryType();
+    boost::to_upper(query_type);
+    if (query_type != "SELECT" && query_type != "INSERT" &&
+        query_type != "UPDATE" && query_type != "DELETE") {
+      // the statements behind it are prepared when they run
+      for (query_itr++; query_itr < queries.size(); query_itr++) {
+        if (queries[query_itr].empty() == false) {
+          return false;
+        }
+      }
+    }
+  }
+  return true;
+}
+
 // The Simple Query Protocol
 void PacketManager::ExecQueryMessage(InputPacket *pkt, const size_t thread_id) {
   std::string q_str;
   PacketGetString(pkt, pkt->len, q_str);
 
+  // the statements GetExecutionPriority() prepared for this query
+  std::vector<std::shared_ptr<Statement>> prepared_statements;
+  if (prepared_query_ == q_str) {
+    prepared_statements = std::move(prepared_query_statements_);
+  }
+  prepared_query_.clear();
+  prepared_query_statements_.clear();
+
   std::vector<std::string> queries;
   boost::split(queries, q_str, boost::is_any_of(";"));
 
@@ -313,18 +396,38 @@ void PacketManager::ExecQueryMessage(InputPacket *pkt, const size_t thread_id) {
     return;
   }
 
-  for (auto query : queries) {
+  for (size_t query_itr = 0; query_itr < queries.size(); query_itr++) {
+    auto &query = queries[query_itr];
     // iterate till before the empty string after the last ';'
     if (!query.empty()) {
-      std::vector<StatementResult> result;
-      std::vector<FieldInfo> tuple_descriptor;
       std::string error_message;
       int rows_affected;
 
-      // execute the query using tcop
+      std::shared_ptr<Statement> statement;
+      if (query_itr < prepared_statements.size()) {
+        statement = prepared_statements[query_itr];
+      }
+      if (statement.get() == nullptr) {
+        statement =
+            traffic_cop_->PrepareStatement("unnamed", query, error_message);
+      }
+      if (statement.get() == nullptr) {
+        SendErrorResponse(
+            {{NetworkMessageType::HUMAN_READABLE_ERROR, error_message}});
+        break;
+      }
+
+      // send the attribute names, ahead of the rows
+      auto tuple_descriptor = statement->GetTupleDescriptor();
+      PutTupleDescriptor(tuple_descriptor);
+
+      // execute the query using tcop, which streams the result rows
+      std::vector<int> result_format(tuple_descriptor.size(), 0);
+      std::vector<type::Value> params;
+      DataRowSink sink{*this, tuple_descriptor, result_format};
       auto status = traffic_cop_->ExecuteStatement(
-          query, result, tuple_descriptor, rows_affected, error_message,
-          thread_id);
+          statement, params, true, nullptr, sink, rows_affected,
+          error_message, thread_id);
 
       // check status
       if (status == ResultType::FAILURE) {
@@ -332,12 +435,15 @@ void PacketManager::ExecQueryMessage(InputPacket *pkt, const size_t thread_id) {
             {{NetworkMessageType::HUMAN_READABLE_ERROR, error_message}});
         break;
       }
+      if (sink.IsFailed() == true) {
+        SendErrorResponse({{NetworkMessageType::HUMAN_READABLE_ERROR,
+                            "Failed to send the result rows"}});
+        break;
+      }
 
-      // send the attribute names
-      PutTupleDescriptor(tuple_descriptor);
-
-      // send the result rows
-      SendDataRows(result, tuple_descriptor.size(), rows_affected);
+      if (sink.GetRowCount() != 0) {
+        rows_affected = sink.GetRowCount();
+      }
 
       // TODO: should change to query_type
       CompleteCommand(query, rows_affected);
@@ -763,8 +869,9 @@ bool PacketManager::ExecDescribeMessage(InputPacket *pkt) {
       return false;
     }
 
+    // the rows of the portal are sent in the formats of its bind
     auto statement = portal->GetStatement();
-    PutTupleDescriptor(statement->GetTupleDescriptor());
+    PutTupleDescriptor(statement->GetTupleDescriptor(), result_format_);
   } else {
     LOG_TRACE("Describe a prepared statement");
   }
@@ -774,7 +881,6 @@ bool PacketManager::ExecDescribeMessage(InputPacket *pkt) {
 void PacketManager::ExecExecuteMessage(InputPacket *pkt,
                                        const size_t thread_id) {
   // EXECUTE message
-  std::vector<StatementResult> results;
   std::string error_message, portal_name;
   int rows_affected = 0;
   GetStringToken(pkt, portal_name);
@@ -816,9 +922,13 @@ void PacketManager::ExecExecuteMessage(InputPacket *pkt,
   bool unnamed = statement_name.empty();
   auto param_values = portal->GetParameters();
 
+  // the result rows are streamed while the statement runs, in the formats
+  // the Describe of the portal advertised
+  auto tuple_descriptor = statement->GetTupleDescriptor();
+  DataRowSink sink{*this, tuple_descriptor, result_format_};
   auto status = traffic_cop_->ExecuteStatement(
-      statement, param_values, unnamed, param_stat, result_format_, results,
-      rows_affected, error_message, thread_id);
+      statement, param_values, unnamed, param_stat, sink, rows_affected,
+      error_message, thread_id);
 
   switch (status) {
     case ResultType::FAILURE:
@@ -836,8 +946,14 @@ void PacketManager::ExecExecuteMessage(InputPacket *pkt,
       }
       return;
     default: {
-      auto tuple_descriptor = statement->GetTupleDescriptor();
-      SendDataRows(results, tuple_descriptor.size(), rows_affected);
+      if (sink.IsFailed() == true) {
+        SendErrorResponse({{NetworkMessageType::HUMAN_READABLE_ERROR,
+                            "Failed to send the result rows"}});
+        return;
+      }
+      if (sink.GetRowCount() != 0) {
+        rows_affected = sink.GetRowCount();
+      }
       CompleteCommand(query_type, rows_affected);
       return;
     }
@@ -938,6 +1054,100 @@ bool PacketManager::ProcessPacket(InputPacket *pkt, const size_t thread_id) {
   return true;
 }
 
+/*
+ * InspectPlan - Looks for the nodes that make a statement long running: a
+ *  sequential scan, or a join or an aggregation
+ */
+static void InspectPlan(const planner::AbstractPlan *plan, bool &has_seq_scan,
+                        bool &is_analytical) {
+  switch (plan->GetPlanNodeType()) {
+    case PlanNodeType::SEQSCAN:
+      has_seq_scan = true;
+      break;
+    case PlanNodeType::NESTLOOP:
+    case PlanNodeType::NESTLOOPINDEX:
+    case PlanNodeType::MERGEJOIN:
+    case PlanNodeType::HASHJOIN:
+    case PlanNodeType::AGGREGATE:
+    case PlanNodeType::AGGREGATE_V2:
+    case PlanNodeType::ORDERBY:
+      is_analytical = true;
+      break;
+    default:
+      break;
+  }
+  for (auto &child : plan->GetChildren()) {
+    InspectPlan(child.get(), has_seq_scan, is_analytical);
+  }
+}
+
+TaskPriorityType PacketManager::GetExecutionPriority(InputPacket *pkt) {
+  std::string query_type;
+  bool has_seq_scan = false;
+  bool is_analytical = false;
+  size_t ptr = pkt->ptr;
+
+  switch (pkt->msg_type) {
+    case NetworkMessageType::SIMPLE_QUERY_COMMAND: {
+      std::string query;
+      PacketGetString(pkt, pkt->len, query);
+      Statement::ParseQueryType(query, query_type);
+      // the plans are kept for the execution, which doesn't prepare the
+      // statements again. the ones that aren't planned yet may scan anything.
+      has_seq_scan = (PrepareQueryStatements(query) == false);
+      for (auto &statement : prepared_query_statements_) {
+        if (statement.get() != nullptr &&
+            statement->GetPlanTree().get() != nullptr) {
+          InspectPlan(statement->GetPlanTree().get(), has_seq_scan,
+                      is_analytical);
+        }
+      }
+      break;
+    }
+    case NetworkMessageType::EXECUTE_COMMAND: {
+      // skipped statements only send their completion
+      if (skipped_stmt_) {
+        return TaskPriorityType::INVALID;
+      }
+      std::string portal_name;
+      GetStringToken(pkt, portal_name);
+      auto portal = portals_.find(portal_name);
+      if (portal == portals_.end() || portal->second.get() == nullptr ||
+          portal->second->GetStatement().get() == nullptr) {
+        pkt->ptr = ptr;
+        return TaskPriorityType::INVALID;
+      }
+      auto statement = portal->second->GetStatement();
+      query_type = statement->GetQueryType();
+      if (statement->GetPlanTree().get() != nullptr) {
+        InspectPlan(statement->GetPlanTree().get(), has_seq_scan,
+                    is_analytical);
+      }
+      break;
+    }
+    default:
+      return TaskPriorityType::INVALID;
+  }
+  pkt->ptr = ptr;
+
+  // joins and aggregations go behind everything else
+  if (is_analytical) {
+    return TaskPriorityType::LOW;
+  }
+
+  // short OLTP statements take the fast lane
+  boost::to_upper(query_type);
+  if (has_seq_scan == false &&
+      (query_type == "SELECT" || query_type == "INSERT" ||
+       query_type == "UPDATE" || query_type == "DELETE" ||
+       query_type == "BEGIN" || query_type == "COMMIT" ||
+       query_type == "ROLLBACK" || query_type == "SET" ||
+       query_type == "SHOW")) {
+    return TaskPriorityType::HIGH;
+  }
+  return TaskPriorityType::NORMAL;
+}
+
 /*
  * send_error_response - Sends the passed string as an error response.
  *    For now, it only supports the human readable 'M' message body
@@ -975,6 +1185,8 @@ void PacketManager::Reset() {
 
   responses.clear();
   unnamed_statement_.reset();
+  prepared_query_.clear();
+  prepared_query_statements_.clear();
   result_format_.clear();
   txn_state_ = NetworkTransactionStateType::IDLE;
   skipped_stmt_ = false;
@@ -70,5 +70,42 @@ TEST_F(ManagerTests, TransactionTest) {
   // EXPECT_EQ(catalog::Manager::GetInstance().GetCurrentTileGroupId(), 800);
 }
 
+TEST_F(ManagerTests, TileGroupPtrTest) {
+  auto &manager = catalog::Manager::GetInstance();
+
+  std::vector<catalog::Column> columns;
+  columns.push_back(catalog::Column(
+      type::Type::INTEGER, type::Type::GetTypeSize(type::Type::INTEGER), "A",
+      true));
+  std::vector<catalog::Schema> schemas;
+  schemas.push_back(catalog::Schema(columns));
+
+  std::map<oid_t, std::pair<oid_t, oid_t>> column_map;
+  column_map[0] = std::make_pair(0, 0);
+
+  oid_t tile_group_id = manager.GetNextTileGroupId();
+  std::shared_ptr<storage::TileGroup> tile_group(
+      storage::TileGroupFactory::GetTileGroup(INVALID_OID, INVALID_OID,
+                                              tile_group_id, nullptr, schemas,
+                                              column_map, 3));
+  manager.AddTileGroup(tile_group_id, tile_group);
+
+  EXPECT_EQ(tile_group.get(), manager.GetTileGroupPtr(tile_group_id));
+  EXPECT_EQ(tile_group->GetHeader(),
+            manager.GetTileGroupHeader(tile_group_id));
+
+  // a dropped tile group is no longer found, but it is only freed once no
+  // transaction can access it anymore
+  std::weak_ptr<storage::TileGroup> dropped = tile_group;
+  tile_group.reset();
+  manager.DropTileGroup(tile_group_id);
+  EXPECT_TRUE(manager.GetTileGroupPtr(tile_group_id) == nullptr);
+  EXPECT_TRUE(manager.GetTileGroupHeader(tile_group_id) == nullptr);
+  EXPECT_TRUE(manager.GetTileGroup(tile_group_id) == nullptr);
+
+  manager.ReclaimDroppedTileGroups(MAX_CID);
+  EXPECT_TRUE(dropped.expired());
+}
+
 }  // End test namespace
 }  // End peloton namespace
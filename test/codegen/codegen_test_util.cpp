@@ -13,6 +13,7 @@
 #include "codegen/codegen_test_util.h"
 
 #include "type/value_factory.h"
+#include "index/index_factory.h"
 #include "codegen/runtime_functions_proxy.h"
 #include "codegen/values_runtime_proxy.h"
 #include "codegen/value_proxy.h"
@@ -107,6 +108,23 @@ void PelotonCodeGenTest::LoadTestTable(uint32_t table_id, uint32_t num_rows) {
   txn_manager.CommitTransaction(txn);
 }
 
+void PelotonCodeGenTest::CreatePrimaryKeyIndex(uint32_t table_id) {
+  auto &test_table = GetTestTable(table_id);
+  const auto *tuple_schema = test_table.GetSchema();
+
+  std::vector<oid_t> key_attrs = {0};
+  auto *key_schema = catalog::Schema::CopySchema(tuple_schema, key_attrs);
+  key_schema->SetIndexedColumns(key_attrs);
+
+  auto *index_metadata = new index::IndexMetadata(
+      "pkey_index", table_id * 100, table_id, test_db_id, IndexType::BWTREE,
+      IndexConstraintType::PRIMARY_KEY, tuple_schema, key_schema, key_attrs,
+      true);
+  std::shared_ptr<index::Index> pkey_index{
+      index::IndexFactory::GetIndex(index_metadata)};
+  test_table.AddIndex(pkey_index);
+}
+
 codegen::QueryCompiler::CompileStats PelotonCodeGenTest::CompileAndExecute(
     const planner::AbstractPlan &plan, codegen::QueryResultConsumer &consumer,
     char *consumer_state) {
@@ -0,0 +1,232 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// filter_runtime_test.cpp
+//
+// Identification: test/codegen/filter_runtime_test.cpp
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <cstring>
+#include <functional>
+#include <vector>
+
+#include "codegen/filter_runtime.h"
+#include "common/harness.h"
+#include "storage/packed_column.h"
+
+namespace peloton {
+namespace test {
+
+//===----------------------------------------------------------------------===//
+// This class contains code to test the vectorized filter kernels. All the tests
+// filter the columns of a row-major buffer holding the following rows:
+//
+// +------------+--------------+----------------+
+// | DATE (int) | BIGINT (int) | DECIMAL (dbl)  |
+// +------------+--------------+----------------+
+//
+// Each test picks the column, and compares the kernel's result with the one of
+// a plain loop over the selection vector. The selection vector skips every
+// third tuple, so the TIDs the kernels gather are not consecutive.
+//===----------------------------------------------------------------------===//
+class FilterRuntimeTest : public PelotonTest {
+ public:
+  static constexpr uint32_t kNumRows = 100;
+  static constexpr uint32_t kDateOffset = 0;
+  static constexpr uint32_t kBigIntOffset = 8;
+  static constexpr uint32_t kDecimalOffset = 16;
+  static constexpr uint32_t kStride = 24;
+
+  FilterRuntimeTest() : rows_(kNumRows * kStride) {
+    for (uint32_t tid = 0; tid < kNumRows; tid++) {
+      int32_t date = 2457000 + static_cast<int32_t>(tid % 10);
+      int64_t bigint = (static_cast<int64_t>(tid) - 50) * (int64_t{1} << 40);
+      double decimal = (static_cast<double>(tid) - 50) * 0.25;
+      std::memcpy(Column(kDateOffset) + tid * kStride, &date, sizeof(date));
+      std::memcpy(Column(kBigIntOffset) + tid * kStride, &bigint,
+                  sizeof(bigint));
+      std::memcpy(Column(kDecimalOffset) + tid * kStride, &decimal,
+                  sizeof(decimal));
+    }
+    for (uint32_t tid = 0; tid < kNumRows; tid++) {
+      if (tid % 3 != 2) {
+        selection_.push_back(tid);
+      }
+    }
+  }
+
+  char *Column(uint32_t offset) { return rows_.data() + offset; }
+
+  // The TIDs of the selection vector whose value in the column at the given
+  // offset compares true with the given value
+  template <typename T>
+  std::vector<uint32_t> Expected(uint32_t offset, ExpressionType comparison,
+                                 T value) {
+    std::vector<uint32_t> expected;
+    for (uint32_t tid : selection_) {
+      T col_val;
+      std::memcpy(&col_val, Column(offset) + tid * kStride, sizeof(T));
+      if (Compare(comparison, col_val, value)) {
+        expected.push_back(tid);
+      }
+    }
+    return expected;
+  }
+
+  template <typename T>
+  static bool Compare(ExpressionType comparison, T l, T r) {
+    switch (comparison) {
+      case ExpressionType::COMPARE_LESSTHAN:
+        return l < r;
+      case ExpressionType::COMPARE_LESSTHANOREQUALTO:
+        return l <= r;
+      case ExpressionType::COMPARE_EQUAL:
+        return l == r;
+      case ExpressionType::COMPARE_NOTEQUAL:
+        return l != r;
+      case ExpressionType::COMPARE_GREATERTHAN:
+        return l > r;
+      case ExpressionType::COMPARE_GREATERTHANOREQUALTO:
+        return l >= r;
+      default:
+        return false;
+    }
+  }
+
+  // Run the kernel on a copy of the selection vector, in batches of the
+  // given size, and return the TIDs that passed
+  std::vector<uint32_t> Filter(
+      std::function<uint32_t(uint32_t *, uint32_t)> kernel,
+      uint32_t batch_size) {
+    std::vector<uint32_t> result;
+    for (uint32_t start = 0; start < selection_.size(); start += batch_size) {
+      uint32_t end = std::min<uint32_t>(start + batch_size, selection_.size());
+      std::vector<uint32_t> batch{selection_.begin() + start,
+                                  selection_.begin() + end};
+      uint32_t num_passed = kernel(batch.data(), batch.size());
+      result.insert(result.end(), batch.begin(), batch.begin() + num_passed);
+    }
+    return result;
+  }
+
+  const std::vector<ExpressionType> comparisons = {
+      ExpressionType::COMPARE_LESSTHAN,
+      ExpressionType::COMPARE_LESSTHANOREQUALTO,
+      ExpressionType::COMPARE_EQUAL,
+      ExpressionType::COMPARE_NOTEQUAL,
+      ExpressionType::COMPARE_GREATERTHAN,
+      ExpressionType::COMPARE_GREATERTHANOREQUALTO};
+
+ private:
+  std::vector<char> rows_;
+  std::vector<uint32_t> selection_;
+};
+
+TEST_F(FilterRuntimeTest, DateFilter) {
+  // DATE columns are filtered as 32-bit integers
+  const int32_t value = 2457004;
+  for (auto comparison : comparisons) {
+    auto result = Filter([&](uint32_t *sel, uint32_t num) {
+      return codegen::FilterRuntime::FilterInteger(
+          Column(kDateOffset), kStride, comparison, value, sel, num);
+    }, kNumRows);
+    EXPECT_EQ(Expected(kDateOffset, comparison, value), result)
+        << ExpressionTypeToString(comparison);
+  }
+}
+
+TEST_F(FilterRuntimeTest, BigIntFilter) {
+  // The values don't fit into 32 bits, and half of them are negative
+  const int64_t value = -7 * (int64_t{1} << 40);
+  for (auto comparison : comparisons) {
+    auto result = Filter([&](uint32_t *sel, uint32_t num) {
+      return codegen::FilterRuntime::FilterBigInt(
+          Column(kBigIntOffset), kStride, comparison, value, sel, num);
+    }, kNumRows);
+    EXPECT_EQ(Expected(kBigIntOffset, comparison, value), result)
+        << ExpressionTypeToString(comparison);
+  }
+}
+
+TEST_F(FilterRuntimeTest, DecimalFilter) {
+  const double value = 3.25;
+  for (auto comparison : comparisons) {
+    auto result = Filter([&](uint32_t *sel, uint32_t num) {
+      return codegen::FilterRuntime::FilterDecimal(
+          Column(kDecimalOffset), kStride, comparison, value, sel, num);
+    }, kNumRows);
+    EXPECT_EQ(Expected(kDecimalOffset, comparison, value), result)
+        << ExpressionTypeToString(comparison);
+  }
+}
+
+TEST_F(FilterRuntimeTest, PackedFilter) {
+  // The dates and the bigints of the buffer, packed like the integer columns
+  // of a compressed tile group
+  auto dates = storage::PackedColumn::Pack(Column(kDateOffset), kStride,
+                                           type::Type::DATE, kNumRows);
+  auto bigints = storage::PackedColumn::Pack(Column(kBigIntOffset), kStride,
+                                             type::Type::BIGINT, kNumRows);
+  ASSERT_NE(nullptr, dates);
+  ASSERT_NE(nullptr, bigints);
+
+  // The values below, inside and above the range of the packed values
+  const std::vector<int32_t> date_values = {2456000, 2457004, 2458000};
+  const std::vector<int64_t> bigint_values = {
+      -60 * (int64_t{1} << 40), -7 * (int64_t{1} << 40),
+      60 * (int64_t{1} << 40)};
+  for (auto comparison : comparisons) {
+    for (auto value : date_values) {
+      auto result = Filter([&](uint32_t *sel, uint32_t num) {
+        return codegen::FilterRuntime::FilterPacked(
+            reinterpret_cast<const char *>(dates->GetWords()),
+            dates->GetBits(), dates->GetBase(), comparison, value, sel, num);
+      }, kNumRows);
+      EXPECT_EQ(Expected(kDateOffset, comparison, value), result)
+          << ExpressionTypeToString(comparison) << " " << value;
+    }
+    for (auto value : bigint_values) {
+      auto result = Filter([&](uint32_t *sel, uint32_t num) {
+        return codegen::FilterRuntime::FilterPacked(
+            reinterpret_cast<const char *>(bigints->GetWords()),
+            bigints->GetBits(), bigints->GetBase(), comparison, value, sel,
+            num);
+      }, kNumRows);
+      EXPECT_EQ(Expected(kBigIntOffset, comparison, value), result)
+          << ExpressionTypeToString(comparison) << " " << value;
+    }
+  }
+}
+
+TEST_F(FilterRuntimeTest, ScalarFallback) {
+  // Selection vectors with fewer than eight TIDs are always filtered by the
+  // scalar loop, whether the CPU supports AVX2 or not. Filtering in batches of
+  // seven must still pass the right TIDs.
+  const uint32_t batch_size = 7;
+  for (auto comparison : comparisons) {
+    auto dates = Filter([&](uint32_t *sel, uint32_t num) {
+      return codegen::FilterRuntime::FilterInteger(
+          Column(kDateOffset), kStride, comparison, 2457004, sel, num);
+    }, batch_size);
+    EXPECT_EQ(Expected<int32_t>(kDateOffset, comparison, 2457004), dates);
+
+    auto bigints = Filter([&](uint32_t *sel, uint32_t num) {
+      return codegen::FilterRuntime::FilterBigInt(
+          Column(kBigIntOffset), kStride, comparison, 0, sel, num);
+    }, batch_size);
+    EXPECT_EQ(Expected<int64_t>(kBigIntOffset, comparison, 0), bigints);
+
+    auto decimals = Filter([&](uint32_t *sel, uint32_t num) {
+      return codegen::FilterRuntime::FilterDecimal(
+          Column(kDecimalOffset), kStride, comparison, -1.5, sel, num);
+    }, batch_size);
+    EXPECT_EQ(Expected<double>(kDecimalOffset, comparison, -1.5), decimals);
+  }
+}
+
+}  // namespace test
+}  // namespace peloton
@@ -11,11 +11,16 @@
 //===----------------------------------------------------------------------===//
 
 #include "catalog/catalog.h"
+#include "codegen/pipeline.h"
 #include "codegen/runtime_functions_proxy.h"
 #include "codegen/query_compiler.h"
 #include "common/harness.h"
+#include "common/init.h"
+#include "common/thread_pool.h"
+#include "concurrency/transaction_manager_factory.h"
 #include "expression/conjunction_expression.h"
 #include "planner/aggregate_plan.h"
+#include "storage/table_factory.h"
 
 #include "codegen/codegen_test_util.h"
 
@@ -465,5 +470,276 @@ TEST_F(GroupByTranslatorTest, MinAndMax) {
                   type::ValueFactory::GetBigIntValue(1)) == type::CMP_TRUE);
 }
 
+TEST_F(GroupByTranslatorTest, ParallelSingleColumnGrouping) {
+  //
+  // SELECT a, count(*), max(b) FROM table GROUP BY a;
+  //
+  // Same as SingleColumnGrouping, but the scan feeding the hash table runs
+  // on several threads whose partial tables are merged at the end. Every row
+  // is loaded twice, and the copies land in different tile groups, so the
+  // partial groups of the workers overlap.
+  //
+  const uint32_t num_rows = 100;
+  LoadTestTable(test_table2_id, num_rows);
+  LoadTestTable(test_table2_id, num_rows);
+  ASSERT_LT(2u, GetTestTable(test_table2_id).GetTileGroupCount());
+
+  // 1) Set up projection (just a direct map)
+  DirectMapList direct_map_list = {{0, {0, 0}}, {1, {1, 0}}, {2, {1, 1}}};
+  std::unique_ptr<planner::ProjectInfo> proj_info{
+      new planner::ProjectInfo(TargetList{}, std::move(direct_map_list))};
+
+  // 2) Setup the aggregations
+  auto* tve_expr =
+      new expression::TupleValueExpression(type::Type::TypeId::INTEGER, 0, 0);
+  auto* b_col =
+      new expression::TupleValueExpression(type::Type::TypeId::INTEGER, 0, 1);
+  std::vector<planner::AggregatePlan::AggTerm> agg_terms = {
+      {ExpressionType::AGGREGATE_COUNT_STAR, tve_expr},
+      {ExpressionType::AGGREGATE_MAX, b_col}};
+  agg_terms[0].agg_ai.type = type::Type::TypeId::BIGINT;
+  agg_terms[1].agg_ai.type = type::Type::TypeId::INTEGER;
+
+  // 3) The grouping column
+  std::vector<oid_t> gb_cols = {0};
+
+  // 4) The output schema
+  std::shared_ptr<const catalog::Schema> output_schema{
+      new catalog::Schema({{type::Type::TypeId::INTEGER, 4, "COL_A"},
+                           {type::Type::TypeId::BIGINT, 8, "COUNT_A"},
+                           {type::Type::TypeId::INTEGER, 4, "MAX_B"}})};
+
+  // 5) Finally, the aggregation node
+  std::unique_ptr<planner::AbstractPlan> agg_plan{new planner::AggregatePlan(
+      std::move(proj_info), nullptr, std::move(agg_terms), std::move(gb_cols),
+      output_schema, AggregateType::HASH)};
+
+  // 6) The scan that feeds the aggregation
+  std::unique_ptr<planner::AbstractPlan> scan_plan{new planner::SeqScanPlan(
+      &GetTestTable(test_table2_id), nullptr, {0, 1})};
+
+  agg_plan->AddChild(std::move(scan_plan));
+
+  // Do binding
+  planner::BindingContext context;
+  agg_plan->PerformBinding(context);
+
+  // We collect the results of the query into an in-memory buffer
+  codegen::BufferingConsumer buffer{{0, 1, 2}, context};
+
+  // Compile and run with four scan workers, three of them on the pool
+  thread_pool.Initialize(3, 0);
+  codegen::Pipeline::kDegreeOfParallelism = 4;
+  CompileAndExecute(*agg_plan, buffer,
+                    reinterpret_cast<char*>(buffer.GetState()));
+  codegen::Pipeline::kDegreeOfParallelism = 1;
+  thread_pool.Shutdown();
+
+  // Check results
+  const auto& results = buffer.GetOutputTuples();
+  EXPECT_EQ(num_rows, results.size());
+
+  // Every group holds both copies of a row. The value of 'b' is the value of
+  // 'a' plus one.
+  type::Value const_two = type::ValueFactory::GetBigIntValue(2);
+  for (const auto& tuple : results) {
+    EXPECT_TRUE(tuple.GetValue(1).CompareEquals(const_two) == type::CMP_TRUE);
+    auto a = tuple.GetValue(0).GetAs<int32_t>();
+    EXPECT_TRUE(tuple.GetValue(2).CompareEquals(
+                    type::ValueFactory::GetIntegerValue(a + 1)) ==
+                type::CMP_TRUE);
+  }
+}
+
+TEST_F(GroupByTranslatorTest, ParallelMinAndMax) {
+  //
+  // SELECT COUNT(*), MAX(a), MIN(b) FROM table;
+  //
+  // Same as MinAndMax, but the scan feeding the aggregation runs on several
+  // threads whose partial aggregates are merged at the end.
+  //
+  const uint32_t num_rows = 200;
+  LoadTestTable(test_table2_id, num_rows);
+  ASSERT_LT(4u, GetTestTable(test_table2_id).GetTileGroupCount());
+
+  // 1) Set up projection (just a direct map)
+  DirectMapList direct_map_list = {{0, {1, 0}}, {1, {1, 1}}, {2, {1, 2}}};
+  std::unique_ptr<planner::ProjectInfo> proj_info{
+      new planner::ProjectInfo(TargetList{}, std::move(direct_map_list))};
+
+  // 2) Setup COUNT(*), MAX() on column 'a' and MIN() on 'b'
+  auto* a_col =
+      new expression::TupleValueExpression(type::Type::TypeId::INTEGER, 0, 0);
+  auto* max_a_col =
+      new expression::TupleValueExpression(type::Type::TypeId::INTEGER, 0, 0);
+  auto* b_col =
+      new expression::TupleValueExpression(type::Type::TypeId::INTEGER, 0, 1);
+  std::vector<planner::AggregatePlan::AggTerm> agg_terms = {
+      {ExpressionType::AGGREGATE_COUNT_STAR, a_col},
+      {ExpressionType::AGGREGATE_MAX, max_a_col},
+      {ExpressionType::AGGREGATE_MIN, b_col}};
+  agg_terms[0].agg_ai.type = type::Type::TypeId::BIGINT;
+  agg_terms[1].agg_ai.type = type::Type::TypeId::INTEGER;
+  agg_terms[2].agg_ai.type = type::Type::TypeId::INTEGER;
+
+  // 3) No grouping
+  std::vector<oid_t> gb_cols = {};
+
+  // 4) The output schema
+  std::shared_ptr<const catalog::Schema> output_schema{
+      new catalog::Schema({{type::Type::TypeId::BIGINT, 8, "COUNT_STAR"},
+                           {type::Type::TypeId::INTEGER, 4, "MAX_A"},
+                           {type::Type::TypeId::INTEGER, 4, "MIN_B"}})};
+
+  // 5) Finally, the aggregation node
+  std::unique_ptr<planner::AbstractPlan> agg_plan{new planner::AggregatePlan(
+      std::move(proj_info), nullptr, std::move(agg_terms), std::move(gb_cols),
+      output_schema, AggregateType::HASH)};
+
+  // 6) The scan that feeds the aggregation
+  std::unique_ptr<planner::AbstractPlan> scan_plan{new planner::SeqScanPlan(
+      &GetTestTable(test_table2_id), nullptr, {0, 1})};
+
+  agg_plan->AddChild(std::move(scan_plan));
+
+  // Do binding
+  planner::BindingContext context;
+  agg_plan->PerformBinding(context);
+
+  // We collect the results of the query into an in-memory buffer
+  codegen::BufferingConsumer buffer{{0, 1, 2}, context};
+
+  // Compile and run with four scan workers, three of them on the pool
+  thread_pool.Initialize(3, 0);
+  codegen::Pipeline::kDegreeOfParallelism = 4;
+  CompileAndExecute(*agg_plan, buffer,
+                    reinterpret_cast<char*>(buffer.GetState()));
+  codegen::Pipeline::kDegreeOfParallelism = 1;
+  thread_pool.Shutdown();
+
+  // There should only be a single output row, aggregating all the rows
+  const auto& results = buffer.GetOutputTuples();
+  ASSERT_EQ(1u, results.size());
+  EXPECT_TRUE(results[0].GetValue(0).CompareEquals(
+                  type::ValueFactory::GetBigIntValue(num_rows)) ==
+              type::CMP_TRUE);
+
+  // MAX(a) = (# inserted - 1) * 10 and MIN(b) = 0 * 10 + 1, as in MinAndMax
+  EXPECT_TRUE(results[0].GetValue(1).CompareEquals(
+                  type::ValueFactory::GetIntegerValue((num_rows - 1) * 10)) ==
+              type::CMP_TRUE);
+  EXPECT_TRUE(results[0].GetValue(2).CompareEquals(
+                  type::ValueFactory::GetIntegerValue(1)) == type::CMP_TRUE);
+}
+
+TEST_F(GroupByTranslatorTest, ParallelAggregationWithNulls) {
+  //
+  // SELECT SUM(b), MIN(b), MAX(b) FROM nullable_table;
+  //
+  // Every other tile group of the table only holds NULLs in column 'b', so
+  // workers that scan only those end up with NULL partial aggregates that must
+  // not affect the merged result.
+  //
+  const uint32_t tuples_per_tilegroup = 32;
+  const uint32_t num_rows = 4 * tuples_per_tilegroup;
+
+  auto* schema = new catalog::Schema(
+      {{type::Type::TypeId::INTEGER, 4, "COL_A"},
+       {type::Type::TypeId::INTEGER, 4, "COL_B"}});
+  auto* table = storage::TableFactory::GetDataTable(
+      GetDatabase().GetOid(), test_table4_id + 1, schema, "nullable_table",
+      tuples_per_tilegroup, true, false);
+  GetDatabase().AddTable(table, false);
+
+  auto& txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto* txn = txn_manager.BeginTransaction();
+  auto* pool = TestingHarness::GetInstance().GetTestingPool();
+  int32_t sum = 0;
+  for (uint32_t row = 0; row < num_rows; row++) {
+    storage::Tuple tuple{schema, true};
+    tuple.SetValue(0, type::ValueFactory::GetIntegerValue(row), pool);
+    if ((row / tuples_per_tilegroup) % 2 == 0) {
+      tuple.SetValue(1, type::ValueFactory::GetNullValueByType(
+                            type::Type::TypeId::INTEGER),
+                     pool);
+    } else {
+      tuple.SetValue(1, type::ValueFactory::GetIntegerValue(row), pool);
+      sum += row;
+    }
+    ItemPointer* index_entry_ptr = nullptr;
+    ItemPointer slot = table->InsertTuple(&tuple, txn, &index_entry_ptr);
+    ASSERT_NE(INVALID_OID, slot.block);
+    txn_manager.PerformInsert(txn, slot, index_entry_ptr);
+  }
+  txn_manager.CommitTransaction(txn);
+  ASSERT_LT(2u, table->GetTileGroupCount());
+
+  // 1) Set up projection (just a direct map)
+  DirectMapList direct_map_list = {{0, {1, 0}}, {1, {1, 1}}, {2, {1, 2}}};
+  std::unique_ptr<planner::ProjectInfo> proj_info{
+      new planner::ProjectInfo(TargetList{}, std::move(direct_map_list))};
+
+  // 2) Setup SUM(), MIN() and MAX() on column 'b'
+  std::vector<planner::AggregatePlan::AggTerm> agg_terms = {
+      {ExpressionType::AGGREGATE_SUM,
+       new expression::TupleValueExpression(type::Type::TypeId::INTEGER, 0, 1)},
+      {ExpressionType::AGGREGATE_MIN,
+       new expression::TupleValueExpression(type::Type::TypeId::INTEGER, 0, 1)},
+      {ExpressionType::AGGREGATE_MAX,
+       new expression::TupleValueExpression(type::Type::TypeId::INTEGER, 0,
+                                            1)}};
+  agg_terms[0].agg_ai.type = type::Type::TypeId::INTEGER;
+  agg_terms[1].agg_ai.type = type::Type::TypeId::INTEGER;
+  agg_terms[2].agg_ai.type = type::Type::TypeId::INTEGER;
+
+  // 3) No grouping
+  std::vector<oid_t> gb_cols = {};
+
+  // 4) The output schema
+  std::shared_ptr<const catalog::Schema> output_schema{
+      new catalog::Schema({{type::Type::TypeId::INTEGER, 4, "SUM_B"},
+                           {type::Type::TypeId::INTEGER, 4, "MIN_B"},
+                           {type::Type::TypeId::INTEGER, 4, "MAX_B"}})};
+
+  // 5) Finally, the aggregation node
+  std::unique_ptr<planner::AbstractPlan> agg_plan{new planner::AggregatePlan(
+      std::move(proj_info), nullptr, std::move(agg_terms), std::move(gb_cols),
+      output_schema, AggregateType::HASH)};
+
+  // 6) The scan that feeds the aggregation
+  std::unique_ptr<planner::AbstractPlan> scan_plan{
+      new planner::SeqScanPlan(table, nullptr, {0, 1})};
+
+  agg_plan->AddChild(std::move(scan_plan));
+
+  // Do binding
+  planner::BindingContext context;
+  agg_plan->PerformBinding(context);
+
+  // We collect the results of the query into an in-memory buffer
+  codegen::BufferingConsumer buffer{{0, 1, 2}, context};
+
+  // Compile and run with four scan workers, three of them on the pool
+  thread_pool.Initialize(3, 0);
+  codegen::Pipeline::kDegreeOfParallelism = 4;
+  CompileAndExecute(*agg_plan, buffer,
+                    reinterpret_cast<char*>(buffer.GetState()));
+  codegen::Pipeline::kDegreeOfParallelism = 1;
+  thread_pool.Shutdown();
+
+  // The NULLs are ignored. The smallest non-NULL value is the first row of the
+  // second tile group, the largest one is the last row of the table.
+  const auto& results = buffer.GetOutputTuples();
+  ASSERT_EQ(1u, results.size());
+  EXPECT_TRUE(results[0].GetValue(0).CompareEquals(
+                  type::ValueFactory::GetIntegerValue(sum)) == type::CMP_TRUE);
+  EXPECT_TRUE(results[0].GetValue(1).CompareEquals(
+                  type::ValueFactory::GetIntegerValue(tuples_per_tilegroup)) ==
+              type::CMP_TRUE);
+  EXPECT_TRUE(results[0].GetValue(2).CompareEquals(
+                  type::ValueFactory::GetIntegerValue(num_rows - 1)) ==
+              type::CMP_TRUE);
+}
+
 }  // namespace test
 }  // namespace peloton
\ No newline at end of file
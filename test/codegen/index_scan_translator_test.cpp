@@ -0,0 +1,141 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// index_scan_translator_test.cpp
+//
+// Identification: test/codegen/index_scan_translator_test.cpp
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "codegen/query_compiler.h"
+#include "common/harness.h"
+#include "expression/comparison_expression.h"
+#include "expression/tuple_value_expression.h"
+#include "planner/index_scan_plan.h"
+#include "type/value_factory.h"
+
+#include "codegen/codegen_test_util.h"
+
+namespace peloton {
+namespace test {
+
+//===----------------------------------------------------------------------===//
+// This class contains code to test code generation and compilation of index
+// scan plans. All the tests use a single table with the following schema,
+// with a primary key index on column A. The table is loaded with 64 rows.
+// Column A of the i-th row holds the value i * 10, column B holds i * 10 + 1.
+//
+// +---------+---------+---------+-------------+
+// | A (int) | B (int) | C (int) | D (varchar) |
+// +---------+---------+---------+-------------+
+//===----------------------------------------------------------------------===//
+
+class IndexScanTranslatorTest : public PelotonCodeGenTest {
+ public:
+  IndexScanTranslatorTest() : PelotonCodeGenTest() {
+    CreatePrimaryKeyIndex(TestTableId());
+    LoadTestTable(TestTableId(), num_rows_to_insert);
+  }
+
+  uint32_t NumRowsInTestTable() const { return num_rows_to_insert; }
+
+  uint32_t TestTableId() { return test_table1_id; }
+
+  // SELECT a, b FROM table WHERE a <op> <val> AND <predicate>, using the index
+  std::unique_ptr<planner::IndexScanPlan> IndexScan(
+      ExpressionType op, int32_t val,
+      expression::AbstractExpression *predicate) {
+    auto &table = GetTestTable(TestTableId());
+    planner::IndexScanPlan::IndexScanDesc index_scan_desc{
+        table.GetIndex(0), {0}, {op},
+        {type::ValueFactory::GetIntegerValue(val)}, {}};
+    return std::unique_ptr<planner::IndexScanPlan>{
+        new planner::IndexScanPlan(&table, predicate, {0, 1},
+                                   index_scan_desc)};
+  }
+
+ private:
+  uint32_t num_rows_to_insert = 64;
+};
+
+TEST_F(IndexScanTranslatorTest, RangeScan) {
+  //
+  // SELECT a, b FROM table WHERE a >= 200;
+  //
+  auto scan_plan =
+      IndexScan(ExpressionType::COMPARE_GREATERTHANOREQUALTO, 200, nullptr);
+
+  // Do binding
+  planner::BindingContext context;
+  scan_plan->PerformBinding(context);
+
+  // We collect the results of the query into an in-memory buffer
+  codegen::BufferingConsumer buffer{{0, 1}, context};
+
+  // COMPILE and execute
+  CompileAndExecute(*scan_plan, buffer,
+                    reinterpret_cast<char *>(buffer.GetState()));
+
+  // The rows come back in key order
+  const auto &results = buffer.GetOutputTuples();
+  ASSERT_EQ(NumRowsInTestTable() - 20, results.size());
+  for (uint32_t i = 0; i < results.size(); i++) {
+    EXPECT_EQ(type::CMP_TRUE, results[i].GetValue(0).CompareEquals(
+                                  type::ValueFactory::GetIntegerValue(
+                                      static_cast<int32_t>((i + 20) * 10))));
+  }
+}
+
+TEST_F(IndexScanTranslatorTest, PointLookupWithPredicate) {
+  //
+  // SELECT a, b FROM table WHERE a = 310 AND b = 311;
+  //
+  auto *b_col_exp =
+      new expression::TupleValueExpression(type::Type::TypeId::INTEGER, 0, 1);
+  auto *const_311_exp = CodegenTestUtils::ConstIntExpression(311);
+  auto *b_eq_311 = new expression::ComparisonExpression(
+      ExpressionType::COMPARE_EQUAL, b_col_exp, const_311_exp);
+  auto scan_plan = IndexScan(ExpressionType::COMPARE_EQUAL, 310, b_eq_311);
+
+  // Do binding
+  planner::BindingContext context;
+  scan_plan->PerformBinding(context);
+
+  // We collect the results of the query into an in-memory buffer
+  codegen::BufferingConsumer buffer{{0, 1}, context};
+
+  // COMPILE and execute
+  CompileAndExecute(*scan_plan, buffer,
+                    reinterpret_cast<char *>(buffer.GetState()));
+
+  const auto &results = buffer.GetOutputTuples();
+  ASSERT_EQ(1, results.size());
+  EXPECT_EQ(type::CMP_TRUE, results[0].GetValue(1).CompareEquals(
+                                type::ValueFactory::GetIntegerValue(311)));
+
+  //
+  // SELECT a, b FROM table WHERE a = 310 AND b = 321;
+  //
+  auto *other_b_col_exp =
+      new expression::TupleValueExpression(type::Type::TypeId::INTEGER, 0, 1);
+  auto *const_321_exp = CodegenTestUtils::ConstIntExpression(321);
+  auto *b_eq_321 = new expression::ComparisonExpression(
+      ExpressionType::COMPARE_EQUAL, other_b_col_exp, const_321_exp);
+  auto other_scan_plan =
+      IndexScan(ExpressionType::COMPARE_EQUAL, 310, b_eq_321);
+
+  planner::BindingContext other_context;
+  other_scan_plan->PerformBinding(other_context);
+  codegen::BufferingConsumer other_buffer{{0, 1}, other_context};
+  CompileAndExecute(*other_scan_plan, other_buffer,
+                    reinterpret_cast<char *>(other_buffer.GetState()));
+
+  // The predicate filters out the only row the index finds
+  EXPECT_EQ(0, other_buffer.GetOutputTuples().size());
+}
+
+}  // namespace test
+}  // namespace peloton
@@ -0,0 +1,142 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// limit_translator_test.cpp
+//
+// Identification: test/codegen/limit_translator_test.cpp
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "codegen/query_compiler.h"
+#include "common/harness.h"
+#include "concurrency/transaction_manager_factory.h"
+#include "planner/limit_plan.h"
+#include "planner/seq_scan_plan.h"
+#include "storage/data_table.h"
+#include "storage/tile_group.h"
+#include "type/value_factory.h"
+
+#include "codegen/codegen_test_util.h"
+
+namespace peloton {
+namespace test {
+
+//===----------------------------------------------------------------------===//
+// This class contains code to test code generation and compilation of limit
+// plans. All tests use a test table with the following schema, loaded with 64
+// rows. Column A of the i-th row holds the value i * 10.
+//
+// +---------+---------+---------+-------------+
+// | A (int) | B (int) | C (int) | D (varchar) |
+// +---------+---------+---------+-------------+
+//===----------------------------------------------------------------------===//
+
+class LimitTranslatorTest : public PelotonCodeGenTest {
+ public:
+  LimitTranslatorTest() : PelotonCodeGenTest() {
+    LoadTestTable(TestTableId(), num_rows_to_insert);
+  }
+
+  uint32_t NumRowsInTestTable() const { return num_rows_to_insert; }
+
+  uint32_t TestTableId() { return test_table1_id; }
+
+  // SELECT a, b FROM table LIMIT <limit> OFFSET <offset>;
+  std::unique_ptr<planner::LimitPlan> LimitScan(size_t limit, size_t offset) {
+    std::unique_ptr<planner::LimitPlan> limit_plan{
+        new planner::LimitPlan(limit, offset)};
+    std::unique_ptr<planner::SeqScanPlan> seq_scan_plan{
+        new planner::SeqScanPlan(&GetTestTable(TestTableId()), nullptr,
+                                 {0, 1})};
+    limit_plan->AddChild(std::move(seq_scan_plan));
+    return limit_plan;
+  }
+
+ private:
+  uint32_t num_rows_to_insert = 64;
+};
+
+TEST_F(LimitTranslatorTest, LimitWithOffset) {
+  //
+  // SELECT a, b FROM table LIMIT 10 OFFSET 5;
+  //
+  auto limit_plan = LimitScan(10, 5);
+
+  // Do binding
+  planner::BindingContext context;
+  limit_plan->PerformBinding(context);
+
+  // We collect the results of the query into an in-memory buffer
+  codegen::BufferingConsumer buffer{{0, 1}, context};
+
+  // COMPILE and execute
+  CompileAndExecute(*limit_plan, buffer,
+                    reinterpret_cast<char *>(buffer.GetState()));
+
+  // The scan produces the rows in order, so we get rows 5 to 14
+  const auto &results = buffer.GetOutputTuples();
+  ASSERT_EQ(10, results.size());
+  for (uint32_t i = 0; i < results.size(); i++) {
+    EXPECT_EQ(type::CMP_TRUE, results[i].GetValue(0).CompareEquals(
+                                  type::ValueFactory::GetIntegerValue(
+                                      static_cast<int32_t>((i + 5) * 10))));
+  }
+}
+
+TEST_F(LimitTranslatorTest, LimitPastEnd) {
+  //
+  // SELECT a, b FROM table LIMIT 100 OFFSET 60;
+  //
+  auto limit_plan = LimitScan(100, 60);
+
+  // Do binding
+  planner::BindingContext context;
+  limit_plan->PerformBinding(context);
+
+  // We collect the results of the query into an in-memory buffer
+  codegen::BufferingConsumer buffer{{0, 1}, context};
+
+  // COMPILE and execute
+  CompileAndExecute(*limit_plan, buffer,
+                    reinterpret_cast<char *>(buffer.GetState()));
+
+  // Only the rows after the offset are left
+  EXPECT_EQ(NumRowsInTestTable() - 60, buffer.GetOutputTuples().size());
+}
+
+TEST_F(LimitTranslatorTest, LimitStopsScan) {
+  //
+  // SELECT a, b FROM table LIMIT 10 OFFSET 5;
+  //
+  auto limit_plan = LimitScan(10, 5);
+
+  // Do binding
+  planner::BindingContext context;
+  limit_plan->PerformBinding(context);
+
+  // We collect the results of the query into an in-memory buffer
+  codegen::BufferingConsumer buffer{{0, 1}, context};
+
+  // COMPILE and execute in a transaction we can look at
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto *txn = txn_manager.BeginTransaction();
+  codegen::QueryCompiler compiler;
+  auto compiled_query = compiler.Compile(*limit_plan, buffer);
+  compiled_query->Execute(*txn, reinterpret_cast<char *>(buffer.GetState()));
+
+  // The first tile group holds enough rows, so the scan never reads the
+  // second one
+  auto &table = GetTestTable(TestTableId());
+  size_t tile_group_size = table.GetTileGroup(0)->GetAllocatedTupleCount();
+  ASSERT_LT(tile_group_size, NumRowsInTestTable());
+  EXPECT_EQ(10, buffer.GetOutputTuples().size());
+  EXPECT_EQ(tile_group_size, txn->GetReadWriteSet().size());
+
+  txn_manager.CommitTransaction(txn);
+}
+
+}  // namespace test
+}  // namespace peloton
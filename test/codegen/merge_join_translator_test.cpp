@@ -0,0 +1,134 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// merge_join_translator_test.cpp
+//
+// Identification: test/codegen/merge_join_translator_test.cpp
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "codegen/query_compiler.h"
+#include "common/harness.h"
+#include "expression/comparison_expression.h"
+#include "expression/tuple_value_expression.h"
+#include "planner/merge_join_plan.h"
+#include "planner/seq_scan_plan.h"
+
+#include "codegen/codegen_test_util.h"
+
+namespace peloton {
+namespace test {
+
+//===----------------------------------------------------------------------===//
+// This class contains code to test code generation and compilation of merge
+// join plans. All the tests use two test tables with the following schema:
+//
+// +---------+---------+---------+-------------+
+// | A (int) | B (int) | C (int) | D (varchar) |
+// +---------+---------+---------+-------------+
+//
+// The left table is loaded with 20 rows, and the right table with 80 rows.
+// Column A of the i-th row of either table holds the value i * 10, so scans
+// produce both tables sorted on column A.
+//===----------------------------------------------------------------------===//
+
+class MergeJoinTranslatorTest : public PelotonCodeGenTest {
+ public:
+  MergeJoinTranslatorTest() : PelotonCodeGenTest() {
+    uint32_t num_rows = 10;
+    LoadTestTable(LeftTableId(), 2 * num_rows);
+    LoadTestTable(RightTableId(), 8 * num_rows);
+  }
+
+  uint32_t LeftTableId() const { return test_table1_id; }
+
+  uint32_t RightTableId() const { return test_table2_id; }
+
+  storage::DataTable& GetLeftTable() const {
+    return GetTestTable(LeftTableId());
+  }
+
+  storage::DataTable& GetRightTable() const {
+    return GetTestTable(RightTableId());
+  }
+};
+
+TEST_F(MergeJoinTranslatorTest, SingleJoinClauseTest) {
+  //
+  // SELECT
+  //   left_table.a, right_table.a, left_table.b, right_table.c,
+  // FROM
+  //   left_table
+  // JOIN
+  //   right_table ON left_table.a = right_table.a
+  //
+
+  // Projection:  [left_table.a, right_table.a, left_table.b, right_table.c]
+  DirectMap dm1 = std::make_pair(0, std::make_pair(0, 0));
+  DirectMap dm2 = std::make_pair(1, std::make_pair(1, 0));
+  DirectMap dm3 = std::make_pair(2, std::make_pair(0, 1));
+  DirectMap dm4 = std::make_pair(3, std::make_pair(1, 2));
+  DirectMapList direct_map_list = {dm1, dm2, dm3, dm4};
+  std::unique_ptr<planner::ProjectInfo> projection{
+      new planner::ProjectInfo(TargetList{}, std::move(direct_map_list))};
+
+  // Output schema
+  auto schema = std::shared_ptr<const catalog::Schema>(
+      new catalog::Schema({TestingExecutorUtil::GetColumnInfo(0),
+                           TestingExecutorUtil::GetColumnInfo(0),
+                           TestingExecutorUtil::GetColumnInfo(1),
+                           TestingExecutorUtil::GetColumnInfo(2)}));
+
+  // The join clause
+  std::vector<planner::MergeJoinPlan::JoinClause> join_clauses;
+  join_clauses.emplace_back(
+      new expression::TupleValueExpression(type::Type::TypeId::INTEGER, 0, 0),
+      new expression::TupleValueExpression(type::Type::TypeId::INTEGER, 1, 0),
+      false);
+
+  // Only the pairs with b < 100 on the left side
+  auto* left_b_exp =
+      new expression::TupleValueExpression(type::Type::TypeId::INTEGER, 0, 2);
+  auto* const_100_exp = CodegenTestUtils::ConstIntExpression(100);
+  std::unique_ptr<const expression::AbstractExpression> predicate{
+      new expression::ComparisonExpression(ExpressionType::COMPARE_LESSTHAN,
+                                           left_b_exp, const_100_exp)};
+
+  std::unique_ptr<planner::MergeJoinPlan> mj_plan{new planner::MergeJoinPlan(
+      JoinType::INNER, std::move(predicate), std::move(projection), schema,
+      join_clauses)};
+
+  std::unique_ptr<planner::AbstractPlan> left_scan{
+      new planner::SeqScanPlan(&GetLeftTable(), nullptr, {0, 1, 2})};
+  std::unique_ptr<planner::AbstractPlan> right_scan{
+      new planner::SeqScanPlan(&GetRightTable(), nullptr, {0, 1, 2})};
+  mj_plan->AddChild(std::move(left_scan));
+  mj_plan->AddChild(std::move(right_scan));
+
+  // Do binding
+  planner::BindingContext context;
+  mj_plan->PerformBinding(context);
+
+  // We collect the results of the query into an in-memory buffer
+  codegen::BufferingConsumer buffer{{0, 1, 2, 3}, context};
+
+  // COMPILE and run
+  CompileAndExecute(*mj_plan, buffer,
+                    reinterpret_cast<char*>(buffer.GetState()));
+
+  // All 20 left rows have a partner, but only the ones in the first ten rows
+  // have b < 100
+  const auto& results = buffer.GetOutputTuples();
+  EXPECT_EQ(10, results.size());
+  for (const auto& tuple : results) {
+    // Check that the joins keys are actually equal
+    EXPECT_EQ(tuple.GetValue(0).CompareEquals(tuple.GetValue(1)),
+              type::CMP_TRUE);
+  }
+}
+
+}  // namespace test
+}  // namespace peloton
@@ -0,0 +1,154 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// nested_loop_join_translator_test.cpp
+//
+// Identification: test/codegen/nested_loop_join_translator_test.cpp
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "codegen/query_compiler.h"
+#include "common/harness.h"
+#include "planner/index_scan_plan.h"
+#include "planner/nested_loop_join_plan.h"
+#include "planner/seq_scan_plan.h"
+#include "type/value_factory.h"
+
+#include "codegen/codegen_test_util.h"
+
+namespace peloton {
+namespace test {
+
+//===----------------------------------------------------------------------===//
+// This class contains code to test code generation and compilation of nested
+// loop join plans. All the tests use two test tables with the following
+// schema. The right table has a primary key index on column A.
+//
+// +---------+---------+---------+-------------+
+// | A (int) | B (int) | C (int) | D (varchar) |
+// +---------+---------+---------+-------------+
+//
+// The left table is loaded with 20 rows, and the right table with 80 rows.
+// Column A of the i-th row of either table holds the value i * 10.
+//===----------------------------------------------------------------------===//
+
+class NestedLoopJoinTranslatorTest : public PelotonCodeGenTest {
+ public:
+  NestedLoopJoinTranslatorTest() : PelotonCodeGenTest() {
+    CreatePrimaryKeyIndex(RightTableId());
+    uint32_t num_rows = 10;
+    LoadTestTable(LeftTableId(), 2 * num_rows);
+    LoadTestTable(RightTableId(), 8 * num_rows);
+  }
+
+  uint32_t LeftTableId() const { return test_table1_id; }
+
+  uint32_t RightTableId() const { return test_table2_id; }
+
+  storage::DataTable& GetLeftTable() const {
+    return GetTestTable(LeftTableId());
+  }
+
+  storage::DataTable& GetRightTable() const {
+    return GetTestTable(RightTableId());
+  }
+
+  //
+  // SELECT
+  //   left_table.a, right_table.a, left_table.b, right_table.c,
+  // FROM
+  //   left_table
+  // JOIN
+  //   right_table ON left_table.a = right_table.a
+  //
+  std::unique_ptr<planner::NestedLoopJoinPlan> JoinOnColumnA(
+      std::unique_ptr<planner::AbstractPlan> right_plan) {
+    // Projection:  [left_table.a, right_table.a, left_table.b, right_table.c]
+    DirectMap dm1 = std::make_pair(0, std::make_pair(0, 0));
+    DirectMap dm2 = std::make_pair(1, std::make_pair(1, 0));
+    DirectMap dm3 = std::make_pair(2, std::make_pair(0, 1));
+    DirectMap dm4 = std::make_pair(3, std::make_pair(1, 2));
+    DirectMapList direct_map_list = {dm1, dm2, dm3, dm4};
+    std::unique_ptr<planner::ProjectInfo> projection{
+        new planner::ProjectInfo(TargetList{}, std::move(direct_map_list))};
+
+    // Output schema
+    auto schema = std::shared_ptr<const catalog::Schema>(
+        new catalog::Schema({TestingExecutorUtil::GetColumnInfo(0),
+                             TestingExecutorUtil::GetColumnInfo(0),
+                             TestingExecutorUtil::GetColumnInfo(1),
+                             TestingExecutorUtil::GetColumnInfo(2)}));
+
+    // Column A is the first output column of both children
+    std::vector<oid_t> join_columns_left = {0};
+    std::vector<oid_t> join_columns_right = {0};
+    std::unique_ptr<planner::NestedLoopJoinPlan> nlj_plan{
+        new planner::NestedLoopJoinPlan(JoinType::INNER, nullptr,
+                                        std::move(projection), schema,
+                                        join_columns_left, join_columns_right)};
+
+    std::unique_ptr<planner::AbstractPlan> left_scan{
+        new planner::SeqScanPlan(&GetLeftTable(), nullptr, {0, 1, 2})};
+    nlj_plan->AddChild(std::move(left_scan));
+    nlj_plan->AddChild(std::move(right_plan));
+    return nlj_plan;
+  }
+
+  void CheckJoinResults(const std::vector<codegen::WrappedTuple>& results) {
+    // The left table has 20 rows, the right has 80, all of them match
+    EXPECT_EQ(20, results.size());
+    for (const auto& tuple : results) {
+      // Check that the joins keys are actually equal
+      EXPECT_EQ(tuple.GetValue(0).CompareEquals(tuple.GetValue(1)),
+                type::CMP_TRUE);
+    }
+  }
+};
+
+TEST_F(NestedLoopJoinTranslatorTest, BufferedJoin) {
+  std::unique_ptr<planner::AbstractPlan> right_scan{
+      new planner::SeqScanPlan(&GetRightTable(), nullptr, {0, 1, 2})};
+  auto nlj_plan = JoinOnColumnA(std::move(right_scan));
+
+  // Do binding
+  planner::BindingContext context;
+  nlj_plan->PerformBinding(context);
+
+  // We collect the results of the query into an in-memory buffer
+  codegen::BufferingConsumer buffer{{0, 1, 2, 3}, context};
+
+  // COMPILE and run
+  CompileAndExecute(*nlj_plan, buffer,
+                    reinterpret_cast<char*>(buffer.GetState()));
+
+  CheckJoinResults(buffer.GetOutputTuples());
+}
+
+TEST_F(NestedLoopJoinTranslatorTest, IndexJoin) {
+  // The value of the key is replaced by the value of every left row
+  planner::IndexScanPlan::IndexScanDesc index_scan_desc{
+      GetRightTable().GetIndex(0), {0}, {ExpressionType::COMPARE_EQUAL},
+      {type::ValueFactory::GetIntegerValue(0)}, {}};
+  std::unique_ptr<planner::AbstractPlan> right_scan{new planner::IndexScanPlan(
+      &GetRightTable(), nullptr, {0, 1, 2}, index_scan_desc)};
+  auto nlj_plan = JoinOnColumnA(std::move(right_scan));
+
+  // Do binding
+  planner::BindingContext context;
+  nlj_plan->PerformBinding(context);
+
+  // We collect the results of the query into an in-memory buffer
+  codegen::BufferingConsumer buffer{{0, 1, 2, 3}, context};
+
+  // COMPILE and run
+  CompileAndExecute(*nlj_plan, buffer,
+                    reinterpret_cast<char*>(buffer.GetState()));
+
+  CheckJoinResults(buffer.GetOutputTuples());
+}
+
+}  // namespace test
+}  // namespace peloton
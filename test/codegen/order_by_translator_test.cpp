@@ -10,8 +10,10 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include "codegen/pipeline.h"
 #include "codegen/query_compiler.h"
 #include "common/harness.h"
+#include "common/thread_pool.h"
 #include "planner/order_by_plan.h"
 #include "planner/seq_scan_plan.h"
 
@@ -206,5 +208,51 @@ TEST_F(OrderByTranslatorTest, MultiIntColMixedTest) {
       }));
 }
 
+TEST_F(OrderByTranslatorTest, ParallelSingleIntColDescTest) {
+  //
+  // SELECT * FROM test_table ORDER BY a DESC;
+  //
+  // Same as SingleIntColDescTest, but the scan feeding the sort runs on
+  // several threads, each collecting its part of the table in a sorter of its
+  // own.
+  //
+
+  // Load table with enough rows for several tile groups
+  uint32_t num_test_rows = 200;
+  LoadTestTable(TestTableId(), num_test_rows);
+  ASSERT_LT(4u, GetTestTable(TestTableId()).GetTileGroupCount());
+
+  std::unique_ptr<planner::OrderByPlan> order_by_plan{
+      new planner::OrderByPlan({0}, {true}, {0, 1, 2, 3})};
+  std::unique_ptr<planner::SeqScanPlan> seq_scan_plan{new planner::SeqScanPlan(
+      &GetTestTable(TestTableId()), nullptr, {0, 1, 2, 3})};
+
+  order_by_plan->AddChild(std::move(seq_scan_plan));
+
+  // Do binding
+  planner::BindingContext context;
+  order_by_plan->PerformBinding(context);
+
+  // We collect the results of the query into an in-memory buffer
+  codegen::BufferingConsumer buffer{{0, 1}, context};
+
+  // COMPILE and execute with four scan workers, three of them on the pool
+  thread_pool.Initialize(3, 0);
+  codegen::Pipeline::kDegreeOfParallelism = 4;
+  CompileAndExecute(*order_by_plan, buffer,
+                    reinterpret_cast<char *>(buffer.GetState()));
+  codegen::Pipeline::kDegreeOfParallelism = 1;
+  thread_pool.Shutdown();
+
+  // Every row comes out exactly once, in descending order of 'a'. The values
+  // of 'a' are unique, so they must be strictly decreasing.
+  auto &results = buffer.GetOutputTuples();
+  ASSERT_EQ(results.size(), num_test_rows);
+  for (uint32_t i = 1; i < results.size(); i++) {
+    EXPECT_TRUE(results[i - 1].GetValue(0).CompareGreaterThan(
+                    results[i].GetValue(0)) == type::CMP_TRUE);
+  }
+}
+
 }  // namespace test
 }  // namespace peloton
\ No newline at end of file
@@ -0,0 +1,243 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// query_cache_test.cpp
+//
+// Identification: test/codegen/query_cache_test.cpp
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "catalog/catalog.h"
+#include "codegen/plan_fingerprint.h"
+#include "codegen/query_cache.h"
+#include "codegen/query_compiler.h"
+#include "common/harness.h"
+#include "concurrency/transaction_manager_factory.h"
+#include "expression/comparison_expression.h"
+#include "expression/constant_value_expression.h"
+#include "expression/tuple_value_expression.h"
+#include "planner/seq_scan_plan.h"
+
+#include "codegen/codegen_test_util.h"
+
+namespace peloton {
+namespace test {
+
+//===----------------------------------------------------------------------===//
+// This class contains code to test the cache of compiled queries. All the
+// tests use a single table with the same schema as the other codegen tests,
+// loaded with 64 rows. Column A of the i-th row holds the value i * 10.
+//===----------------------------------------------------------------------===//
+
+class QueryCacheTest : public PelotonCodeGenTest {
+ public:
+  QueryCacheTest() : PelotonCodeGenTest() {
+    LoadTestTable(TestTableId(), num_rows_to_insert);
+    codegen::QueryCache::GetInstance().Clear();
+  }
+
+  ~QueryCacheTest() { codegen::QueryCache::GetInstance().Clear(); }
+
+  uint32_t NumRowsInTestTable() const { return num_rows_to_insert; }
+
+  uint32_t TestTableId() { return test_table1_id; }
+
+  // SELECT a, b FROM table WHERE <col> >= <val>;
+  std::unique_ptr<planner::SeqScanPlan> ScanWithPredicate(uint32_t col,
+                                                          int64_t val) {
+    auto* col_exp = new expression::TupleValueExpression(
+        type::Type::TypeId::INTEGER, 0, col);
+    auto* const_exp = CodegenTestUtils::ConstIntExpression(val);
+    auto* col_gte_val = new expression::ComparisonExpression(
+        ExpressionType::COMPARE_GREATERTHANOREQUALTO, col_exp, const_exp);
+    return std::unique_ptr<planner::SeqScanPlan>{new planner::SeqScanPlan(
+        &GetTestTable(TestTableId()), col_gte_val, {0, 1})};
+  }
+
+  // Run the plan through the cache, returning the query that was executed
+  std::shared_ptr<codegen::Query> CacheAndExecute(
+      const planner::AbstractPlan& plan, codegen::BufferingConsumer& consumer,
+      const std::vector<oid_t>& columns) {
+    codegen::PlanFingerprint fingerprint{plan, columns};
+    auto& query_cache = codegen::QueryCache::GetInstance();
+
+    auto query = query_cache.Find(fingerprint);
+    if (query == nullptr) {
+      codegen::QueryCompiler compiler;
+      codegen::QueryCompiler::CompileStats stats;
+      query = compiler.Compile(plan, consumer, &stats, &fingerprint);
+      query_cache.Insert(fingerprint, query, stats.TotalMs());
+    }
+
+    auto& txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+    auto* txn = txn_manager.BeginTransaction();
+    query->Execute(*txn, reinterpret_cast<char*>(consumer.GetState()), nullptr,
+                   fingerprint.GetParameterStorage());
+    txn_manager.CommitTransaction(txn);
+
+    return query;
+  }
+
+ private:
+  uint32_t num_rows_to_insert = 64;
+};
+
+TEST_F(QueryCacheTest, ReuseWithDifferentConstants) {
+  std::vector<oid_t> columns = {0, 1};
+
+  //
+  // SELECT a, b FROM table WHERE a >= 20;
+  //
+  auto scan1 = ScanWithPredicate(0, 20);
+  planner::BindingContext context1;
+  scan1->PerformBinding(context1);
+  codegen::BufferingConsumer buffer1{columns, context1};
+
+  auto query1 = CacheAndExecute(*scan1, buffer1, columns);
+  EXPECT_EQ(NumRowsInTestTable() - 2, buffer1.GetOutputTuples().size());
+  EXPECT_EQ(1, codegen::QueryCache::GetInstance().GetCount());
+
+  //
+  // SELECT a, b FROM table WHERE a >= 40;
+  //
+  auto scan2 = ScanWithPredicate(0, 40);
+  planner::BindingContext context2;
+  scan2->PerformBinding(context2);
+  codegen::BufferingConsumer buffer2{columns, context2};
+
+  // The second plan must run the code compiled for the first one, but with
+  // its own constant
+  auto query2 = CacheAndExecute(*scan2, buffer2, columns);
+  EXPECT_EQ(query1.get(), query2.get());
+  EXPECT_EQ(NumRowsInTestTable() - 4, buffer2.GetOutputTuples().size());
+  EXPECT_EQ(1, codegen::QueryCache::GetInstance().GetCount());
+}
+
+TEST_F(QueryCacheTest, DifferentStructureIsNotShared) {
+  std::vector<oid_t> columns = {0, 1};
+
+  auto scan_a = ScanWithPredicate(0, 20);
+  planner::BindingContext context_a;
+  scan_a->PerformBinding(context_a);
+
+  auto scan_b = ScanWithPredicate(1, 20);
+  planner::BindingContext context_b;
+  scan_b->PerformBinding(context_b);
+
+  codegen::PlanFingerprint fingerprint_a{*scan_a, columns};
+  codegen::PlanFingerprint fingerprint_b{*scan_b, columns};
+  codegen::PlanFingerprint fingerprint_a_col{*scan_a, {0}};
+
+  EXPECT_TRUE(fingerprint_a.IsCacheable());
+  EXPECT_TRUE(fingerprint_b.IsCacheable());
+  EXPECT_NE(fingerprint_a.GetKey(), fingerprint_b.GetKey());
+  EXPECT_NE(fingerprint_a.GetKey(), fingerprint_a_col.GetKey());
+
+  // The predicate's constant is a parameter of both plans
+  EXPECT_EQ(ExpressionType::VALUE_CONSTANT,
+            scan_a->GetPredicate()->GetChild(1)->GetExpressionType());
+  uint32_t slot = 1;
+  EXPECT_TRUE(fingerprint_a.GetParameterSlot(
+      *static_cast<const expression::ConstantValueExpression*>(
+          scan_a->GetPredicate()->GetChild(1)),
+      slot));
+  EXPECT_EQ(0, slot);
+}
+
+TEST_F(QueryCacheTest, NullVarcharConstant) {
+  std::vector<oid_t> columns = {0, 1};
+
+  //
+  // SELECT a, b FROM table WHERE d = NULL;
+  //
+  auto* col_exp = new expression::TupleValueExpression(
+      type::Type::TypeId::VARCHAR, 0, 3);
+  auto* const_exp = new expression::ConstantValueExpression(
+      type::ValueFactory::GetNullValueByType(type::Type::TypeId::VARCHAR));
+  auto* col_eq_null = new expression::ComparisonExpression(
+      ExpressionType::COMPARE_EQUAL, col_exp, const_exp);
+  planner::SeqScanPlan scan{&GetTestTable(TestTableId()), col_eq_null,
+                            {0, 1}};
+  planner::BindingContext context;
+  scan.PerformBinding(context);
+
+  // The NULL string is passed as a null pointer with a length of zero
+  codegen::PlanFingerprint fingerprint{scan, columns};
+  EXPECT_TRUE(fingerprint.IsCacheable());
+  uint32_t slot = 1;
+  ASSERT_TRUE(fingerprint.GetParameterSlot(*const_exp, slot));
+  EXPECT_EQ(0, slot);
+
+  const char* storage = fingerprint.GetParameterStorage();
+  const char* str = reinterpret_cast<const char*>(1);
+  int32_t len = 1;
+  PL_MEMCPY(&str, storage, sizeof(str));
+  PL_MEMCPY(&len, storage + sizeof(uint64_t), sizeof(len));
+  EXPECT_EQ(nullptr, str);
+  EXPECT_EQ(0, len);
+}
+
+TEST_F(QueryCacheTest, InvalidateOnTableChange) {
+  std::vector<oid_t> columns = {0, 1};
+
+  auto scan = ScanWithPredicate(0, 20);
+  planner::BindingContext context;
+  scan->PerformBinding(context);
+  codegen::BufferingConsumer buffer{columns, context};
+
+  CacheAndExecute(*scan, buffer, columns);
+  EXPECT_EQ(1, codegen::QueryCache::GetInstance().GetCount());
+
+  // Queries on other tables stay
+  codegen::QueryCache::GetInstance().InvalidateTable(test_table2_id);
+  EXPECT_EQ(1, codegen::QueryCache::GetInstance().GetCount());
+
+  codegen::QueryCache::GetInstance().InvalidateTable(TestTableId());
+  EXPECT_EQ(0, codegen::QueryCache::GetInstance().GetCount());
+  EXPECT_EQ(0, codegen::QueryCache::GetInstance().GetCodeSize());
+
+  codegen::PlanFingerprint fingerprint{*scan, columns};
+  EXPECT_EQ(nullptr, codegen::QueryCache::GetInstance().Find(fingerprint));
+}
+
+TEST_F(QueryCacheTest, EvictToCodeSizeBudget) {
+  std::vector<oid_t> columns = {0, 1};
+  auto& query_cache = codegen::QueryCache::GetInstance();
+  uint64_t budget = query_cache.GetCodeSizeBudget();
+
+  auto scan_a = ScanWithPredicate(0, 20);
+  planner::BindingContext context_a;
+  scan_a->PerformBinding(context_a);
+  codegen::BufferingConsumer buffer_a{columns, context_a};
+  CacheAndExecute(*scan_a, buffer_a, columns);
+
+  auto scan_b = ScanWithPredicate(1, 20);
+  planner::BindingContext context_b;
+  scan_b->PerformBinding(context_b);
+  codegen::BufferingConsumer buffer_b{columns, context_b};
+  CacheAndExecute(*scan_b, buffer_b, columns);
+
+  EXPECT_EQ(2, query_cache.GetCount());
+  EXPECT_GT(query_cache.GetCodeSize(), 0);
+
+  // Shrinking the budget below the size of both queries drops the least
+  // recently used one, which is the first
+  query_cache.SetCodeSizeBudget(query_cache.GetCodeSize() - 1);
+  EXPECT_EQ(1, query_cache.GetCount());
+  codegen::PlanFingerprint fingerprint_a{*scan_a, columns};
+  codegen::PlanFingerprint fingerprint_b{*scan_b, columns};
+  EXPECT_EQ(nullptr, query_cache.Find(fingerprint_a));
+  EXPECT_NE(nullptr, query_cache.Find(fingerprint_b));
+
+  // No budget, no cache
+  query_cache.SetCodeSizeBudget(0);
+  EXPECT_EQ(0, query_cache.GetCount());
+
+  query_cache.SetCodeSizeBudget(budget);
+}
+
+}  // namespace test
+}  // namespace peloton
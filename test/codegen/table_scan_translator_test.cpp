@@ -13,9 +13,13 @@
 #include "catalog/catalog.h"
 #include "codegen/query_compiler.h"
 #include "common/harness.h"
+#include "concurrency/epoch_manager_factory.h"
+#include "configuration/configuration.h"
 #include "expression/conjunction_expression.h"
 #include "expression/operator_expression.h"
 #include "planner/seq_scan_plan.h"
+#include "storage/tile.h"
+#include "storage/tile_group.h"
 
 #include "codegen/codegen_test_util.h"
 
@@ -471,5 +475,162 @@ TEST_F(TableScanTranslatorTest, ScanWithModuloPredicate) {
                                 type::ValueFactory::GetIntegerValue(1)));
 }
 
+TEST_F(TableScanTranslatorTest, ScanWithMixedConjunctionPredicate) {
+  //
+  // SELECT a, b FROM table where 20 <= a AND a < 300 AND b = a + 1;
+  //
+  // The comparisons with constants are evaluated by the vectorized filter
+  // kernels. The last comparison is left for the scalar loop.
+  //
+
+  // 20 <= a
+  auto* const_20_exp = CodegenTestUtils::ConstIntExpression(20);
+  auto* a_col_exp =
+      new expression::TupleValueExpression(type::Type::TypeId::INTEGER, 0, 0);
+  auto* const_20_lte_a = new expression::ComparisonExpression(
+      ExpressionType::COMPARE_LESSTHANOREQUALTO, const_20_exp, a_col_exp);
+
+  // a < 300
+  auto* other_a_col_exp =
+      new expression::TupleValueExpression(type::Type::TypeId::INTEGER, 0, 0);
+  auto* const_300_exp = CodegenTestUtils::ConstIntExpression(300);
+  auto* a_lt_300 = new expression::ComparisonExpression(
+      ExpressionType::COMPARE_LESSTHAN, other_a_col_exp, const_300_exp);
+
+  // b = a + 1
+  auto* rhs_a_col_exp =
+      new expression::TupleValueExpression(type::Type::TypeId::INTEGER, 0, 0);
+  auto* const_1_exp = CodegenTestUtils::ConstIntExpression(1);
+  auto* a_plus_1 = new expression::OperatorExpression(
+      ExpressionType::OPERATOR_PLUS, type::Type::TypeId::INTEGER, rhs_a_col_exp,
+      const_1_exp);
+  auto* b_col_exp =
+      new expression::TupleValueExpression(type::Type::TypeId::INTEGER, 0, 1);
+  auto* b_eq_a_plus_1 = new expression::ComparisonExpression(
+      ExpressionType::COMPARE_EQUAL, b_col_exp, a_plus_1);
+
+  // 20 <= a AND a < 300 AND b = a + 1
+  auto* a_range = new expression::ConjunctionExpression(
+      ExpressionType::CONJUNCTION_AND, const_20_lte_a, a_lt_300);
+  auto* conj = new expression::ConjunctionExpression(
+      ExpressionType::CONJUNCTION_AND, a_range, b_eq_a_plus_1);
+
+  // Setup the scan plan node
+  planner::SeqScanPlan scan{&GetTestTable(TestTableId()), conj, {0, 1}};
+
+  // Do binding
+  planner::BindingContext context;
+  scan.PerformBinding(context);
+
+  // We collect the results of the query into an in-memory buffer
+  codegen::BufferingConsumer buffer{{0, 1}, context};
+
+  // COMPILE and execute
+  CompileAndExecute(scan, buffer, reinterpret_cast<char*>(buffer.GetState()));
+
+  // Rows 2 to 29 pass, in order
+  const auto& results = buffer.GetOutputTuples();
+  ASSERT_EQ(28, results.size());
+  for (uint32_t i = 0; i < results.size(); i++) {
+    EXPECT_EQ(type::CMP_TRUE, results[i].GetValue(0).CompareEquals(
+                                  type::ValueFactory::GetIntegerValue(
+                                      static_cast<int32_t>((i + 2) * 10))));
+  }
+}
+
+TEST_F(TableScanTranslatorTest, CompressedTileGroupScan) {
+  //
+  // SELECT a, b FROM table where 20 <= a AND a < 300 AND b = a + 1;
+  //
+  // over the compressed tile groups of the table. The comparisons of a run
+  // through the kernel of packed columns, and b = a + 1 loads the packed
+  // values of both columns.
+  //
+
+  // Compress the full tile groups of the table, see CreateTestTables() for
+  // their size
+  const uint32_t tuples_per_tile_group = 32;
+  bool compress_frozen_tile_groups = FLAGS_compress_frozen_tile_groups;
+  FLAGS_compress_frozen_tile_groups = true;
+  auto &table = GetTestTable(TestTableId());
+  auto &epoch_manager = concurrency::EpochManagerFactory::GetInstance();
+  uint32_t compressed_tile_group_count = 0;
+  for (oid_t tile_group_offset = 0;
+       tile_group_offset < table.GetTileGroupCount(); tile_group_offset++) {
+    if (table.GetTileGroup(tile_group_offset)->GetNextTupleSlot() !=
+        tuples_per_tile_group) {
+      continue;
+    }
+    EXPECT_EQ(nullptr, table.TransformTileGroup(tile_group_offset, 1.0));
+    epoch_manager.Reset((epoch_manager.GetCurrentEpochCommitId() >> 32) + 2);
+    auto *tile_group = table.TransformTileGroup(tile_group_offset, 1.0);
+    ASSERT_NE(nullptr, tile_group);
+    oid_t tile_offset, tile_column_offset;
+    tile_group->LocateTileAndColumn(0, tile_offset, tile_column_offset);
+    EXPECT_TRUE(tile_group->GetTile(tile_offset)->IsPacked());
+    compressed_tile_group_count++;
+  }
+  FLAGS_compress_frozen_tile_groups = compress_frozen_tile_groups;
+  EXPECT_EQ(NumRowsInTestTable() / tuples_per_tile_group,
+            compressed_tile_group_count);
+
+  // 20 <= a
+  auto* const_20_exp = CodegenTestUtils::ConstIntExpression(20);
+  auto* a_col_exp =
+      new expression::TupleValueExpression(type::Type::TypeId::INTEGER, 0, 0);
+  auto* const_20_lte_a = new expression::ComparisonExpression(
+      ExpressionType::COMPARE_LESSTHANOREQUALTO, const_20_exp, a_col_exp);
+
+  // a < 300
+  auto* other_a_col_exp =
+      new expression::TupleValueExpression(type::Type::TypeId::INTEGER, 0, 0);
+  auto* const_300_exp = CodegenTestUtils::ConstIntExpression(300);
+  auto* a_lt_300 = new expression::ComparisonExpression(
+      ExpressionType::COMPARE_LESSTHAN, other_a_col_exp, const_300_exp);
+
+  // b = a + 1
+  auto* rhs_a_col_exp =
+      new expression::TupleValueExpression(type::Type::TypeId::INTEGER, 0, 0);
+  auto* const_1_exp = CodegenTestUtils::ConstIntExpression(1);
+  auto* a_plus_1 = new expression::OperatorExpression(
+      ExpressionType::OPERATOR_PLUS, type::Type::TypeId::INTEGER, rhs_a_col_exp,
+      const_1_exp);
+  auto* b_col_exp =
+      new expression::TupleValueExpression(type::Type::TypeId::INTEGER, 0, 1);
+  auto* b_eq_a_plus_1 = new expression::ComparisonExpression(
+      ExpressionType::COMPARE_EQUAL, b_col_exp, a_plus_1);
+
+  // 20 <= a AND a < 300 AND b = a + 1
+  auto* a_range = new expression::ConjunctionExpression(
+      ExpressionType::CONJUNCTION_AND, const_20_lte_a, a_lt_300);
+  auto* conj = new expression::ConjunctionExpression(
+      ExpressionType::CONJUNCTION_AND, a_range, b_eq_a_plus_1);
+
+  // Setup the scan plan node
+  planner::SeqScanPlan scan{&table, conj, {0, 1}};
+
+  // Do binding
+  planner::BindingContext context;
+  scan.PerformBinding(context);
+
+  // We collect the results of the query into an in-memory buffer
+  codegen::BufferingConsumer buffer{{0, 1}, context};
+
+  // COMPILE and execute
+  CompileAndExecute(scan, buffer, reinterpret_cast<char*>(buffer.GetState()));
+
+  // Rows 2 to 29 pass, in order, like from the plain tile groups
+  const auto& results = buffer.GetOutputTuples();
+  ASSERT_EQ(28, results.size());
+  for (uint32_t i = 0; i < results.size(); i++) {
+    EXPECT_EQ(type::CMP_TRUE, results[i].GetValue(0).CompareEquals(
+                                  type::ValueFactory::GetIntegerValue(
+                                      static_cast<int32_t>((i + 2) * 10))));
+    EXPECT_EQ(type::CMP_TRUE, results[i].GetValue(1).CompareEquals(
+                                  type::ValueFactory::GetIntegerValue(
+                                      static_cast<int32_t>((i + 2) * 10 + 1))));
+  }
+}
+
 }  // namespace test
 }  // namespace peloton
\ No newline at end of file
@@ -74,5 +74,137 @@ TEST_F(ThreadPoolTests, BasicTest) {
   thread_pool.Shutdown();
 }
 
+TEST_F(ThreadPoolTests, ResultTest) {
+  ThreadPool thread_pool;
+  thread_pool.Initialize(4, 0);
+
+  std::vector<std::future<int>> results;
+  for (int i = 0; i < 100; i++) {
+    results.push_back(thread_pool.SubmitTaskWithResult(
+        TaskPriorityType::NORMAL, [](int value) { return value * value; }, i));
+  }
+  for (int i = 0; i < 100; i++) {
+    EXPECT_EQ(i * i, results[i].get());
+  }
+
+  thread_pool.Shutdown();
+}
+
+TEST_F(ThreadPoolTests, NestedTaskTest) {
+  ThreadPool thread_pool;
+  thread_pool.Initialize(4, 0);
+
+  // Every task spawns its subtasks on its own worker, the other workers have
+  // to steal them
+  std::atomic<int> counter(0);
+  std::function<void(int)> spawn = [&](int depth) {
+    counter.fetch_add(1);
+    if (depth == 0) {
+      return;
+    }
+    for (int i = 0; i < 2; i++) {
+      thread_pool.SubmitTask(spawn, depth - 1);
+    }
+  };
+  thread_pool.SubmitTask(spawn, 10);
+
+  // Wait for all the test to finish
+  while (counter.load() != (1 << 11) - 1) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+
+  thread_pool.Shutdown();
+}
+
+TEST_F(ThreadPoolTests, PriorityTest) {
+  ThreadPool thread_pool;
+  thread_pool.Initialize(1, 0);
+
+  // Keep the only worker busy until all the tasks are queued
+  std::promise<void> start;
+  std::shared_future<void> started(start.get_future());
+  thread_pool.SubmitTask([started]() { started.wait(); });
+
+  std::mutex order_mutex;
+  std::vector<TaskPriorityType> order;
+  std::vector<std::future<void>> results;
+  for (auto priority : {TaskPriorityType::LOW, TaskPriorityType::NORMAL,
+                        TaskPriorityType::HIGH}) {
+    results.push_back(thread_pool.SubmitTaskWithResult(
+        priority, [&order, &order_mutex, priority]() {
+          std::lock_guard<std::mutex> lock(order_mutex);
+          order.push_back(priority);
+        }));
+  }
+  start.set_value();
+  for (auto &result : results) {
+    result.wait();
+  }
+
+  std::vector<TaskPriorityType> expected_order(
+      {TaskPriorityType::HIGH, TaskPriorityType::NORMAL,
+       TaskPriorityType::LOW});
+  EXPECT_EQ(expected_order, order);
+
+  thread_pool.Shutdown();
+}
+
+TEST_F(ThreadPoolTests, SubmissionOrderTest) {
+  ThreadPool thread_pool;
+  thread_pool.Initialize(1, 0);
+
+  // Keep the only worker busy until all the tasks are queued
+  std::promise<void> start;
+  std::shared_future<void> started(start.get_future());
+  thread_pool.SubmitTask([started]() { started.wait(); });
+
+  // Tasks submitted from outside the pool run in the order they arrive
+  std::mutex order_mutex;
+  std::vector<int> order;
+  std::vector<std::future<void>> results;
+  for (int i = 0; i < 10; i++) {
+    results.push_back(thread_pool.SubmitTaskWithResult(
+        TaskPriorityType::NORMAL, [&order, &order_mutex, i]() {
+          std::lock_guard<std::mutex> lock(order_mutex);
+          order.push_back(i);
+        }));
+  }
+  start.set_value();
+  for (auto &result : results) {
+    result.wait();
+  }
+
+  std::vector<int> expected_order({0, 1, 2, 3, 4, 5, 6, 7, 8, 9});
+  EXPECT_EQ(expected_order, order);
+
+  thread_pool.Shutdown();
+}
+
+TEST_F(ThreadPoolTests, ReservedWorkerTest) {
+  ThreadPool thread_pool;
+  thread_pool.Initialize(2, 0, false, 1);
+
+  // Keep the only unreserved worker busy
+  std::promise<void> start;
+  std::shared_future<void> started(start.get_future());
+  thread_pool.SubmitTask([started]() { started.wait(); });
+
+  // The reserved worker never runs the normal tasks...
+  auto normal_result = thread_pool.SubmitTaskWithResult(
+      TaskPriorityType::NORMAL, []() { return 1; });
+  EXPECT_EQ(std::future_status::timeout,
+            normal_result.wait_for(std::chrono::milliseconds(100)));
+
+  // ...but it runs the high priority tasks while the other worker is busy
+  auto high_result = thread_pool.SubmitTaskWithResult(
+      TaskPriorityType::HIGH, []() { return 2; });
+  EXPECT_EQ(2, high_result.get());
+
+  start.set_value();
+  EXPECT_EQ(1, normal_result.get());
+
+  thread_pool.Shutdown();
+}
+
 }  // End test namespace
 }  // End peloton namespace
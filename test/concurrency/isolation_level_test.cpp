@@ -337,6 +337,73 @@ void ReadSkewTest() {
   }
 }
 
+void LostUpdateTest() {
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  storage::DataTable *table = TestingTransactionUtil::CreateTable();
+  {
+    TransactionScheduler scheduler(3, table, &txn_manager);
+    // T0 reads (0, ?)
+    // T1 updates (0, ?) to (0, 1) and commits
+    // T0 updates (0, ?) to (0, 2) and commits
+    scheduler.Txn(0).Read(0);
+    scheduler.Txn(1).Update(0, 1);
+    scheduler.Txn(1).Commit();
+    scheduler.Txn(0).Update(0, 2);
+    scheduler.Txn(0).Commit();
+    scheduler.Txn(2).Read(0);
+    scheduler.Txn(2).Commit();
+
+    scheduler.Run();
+    auto &schedules = scheduler.schedules;
+
+    // The update of T1 can't be overwritten by T0
+    EXPECT_EQ(ResultType::SUCCESS, schedules[1].txn_result);
+    EXPECT_EQ(ResultType::ABORTED, schedules[0].txn_result);
+    EXPECT_EQ(ResultType::SUCCESS, schedules[2].txn_result);
+    EXPECT_EQ(1, schedules[2].results[0]);
+  }
+}
+
+// A reader that neither blocks nor is blocked by a concurrent writer, and
+// keeps reading the versions that were committed before it began
+void ConcurrentReadWriteTest() {
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  storage::DataTable *table = TestingTransactionUtil::CreateTable();
+  {
+    TransactionScheduler scheduler(3, table, &txn_manager);
+    // T0 reads (0, ?)
+    // T1 updates (0, ?) and (1, ?) to (0, 1) and (1, 1) and commits
+    // T0 reads (0, ?) and (1, ?) and commits
+    // T2 reads (0, ?) and (1, ?) and commits
+    scheduler.Txn(0).Read(0);
+    scheduler.Txn(1).Update(0, 1);
+    scheduler.Txn(1).Update(1, 1);
+    scheduler.Txn(1).Commit();
+    scheduler.Txn(0).Read(0);
+    scheduler.Txn(0).Read(1);
+    scheduler.Txn(0).Commit();
+    scheduler.Txn(2).Read(0);
+    scheduler.Txn(2).Read(1);
+    scheduler.Txn(2).Commit();
+
+    scheduler.Run();
+    auto &schedules = scheduler.schedules;
+
+    EXPECT_EQ(ResultType::SUCCESS, schedules[0].txn_result);
+    EXPECT_EQ(ResultType::SUCCESS, schedules[1].txn_result);
+    EXPECT_EQ(ResultType::SUCCESS, schedules[2].txn_result);
+
+    // T0 keeps its snapshot
+    EXPECT_EQ(0, schedules[0].results[0]);
+    EXPECT_EQ(0, schedules[0].results[1]);
+    EXPECT_EQ(0, schedules[0].results[2]);
+
+    // T2 sees the whole update of T1
+    EXPECT_EQ(1, schedules[2].results[0]);
+    EXPECT_EQ(1, schedules[2].results[1]);
+  }
+}
+
 // Look at the SSI paper (http://drkp.net/papers/ssi-vldb12.pdf).
 // This is an anomaly involving three transactions (one of them is a readonly
 // transaction).
@@ -390,7 +457,39 @@ TEST_F(IsolationLevelTests, SerializableTest) {
     ReadSkewTest();
     PhantomTest();
     SIAnomalyTest1();
+    LostUpdateTest();
+  }
+}
+
+TEST_F(IsolationLevelTests, SnapshotIsolationTest) {
+  for (auto test_type : TEST_TYPES) {
+    concurrency::TransactionManagerFactory::Configure(
+        test_type, IsolationLevelType::SNAPSHOT);
+    DirtyWriteTest();
+    DirtyReadTest();
+    FuzzyReadTest();
+    ReadSkewTest();
+    PhantomTest();
+    LostUpdateTest();
+    ConcurrentReadWriteTest();
+  }
+  concurrency::TransactionManagerFactory::Configure(
+      ConcurrencyType::TIMESTAMP_ORDERING, IsolationLevelType::FULL);
+}
+
+TEST_F(IsolationLevelTests, RepeatableReadTest) {
+  for (auto test_type : TEST_TYPES) {
+    concurrency::TransactionManagerFactory::Configure(
+        test_type, IsolationLevelType::REPEATABLE_READ);
+    DirtyWriteTest();
+    DirtyReadTest();
+    FuzzyReadTest();
+    ReadSkewTest();
+    LostUpdateTest();
+    ConcurrentReadWriteTest();
   }
+  concurrency::TransactionManagerFactory::Configure(
+      ConcurrencyType::TIMESTAMP_ORDERING, IsolationLevelType::FULL);
 }
 
 TEST_F(IsolationLevelTests, StressTest) {
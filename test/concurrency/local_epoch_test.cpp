@@ -2,7 +2,7 @@
 //
 //                         Peloton
 //
-// decentralized_epoch_manager_test.cpp
+// local_epoch_test.cpp
 //
 // Identification: test/concurrency/local_epoch_test.cpp
 //
@@ -24,21 +24,6 @@ namespace test {
 class LocalEpochTests : public PelotonTest {};
 
 
-TEST_F(LocalEpochTests, EpochCompareTest) {
-  concurrency::EpochCompare comp;
-  
-  std::shared_ptr<concurrency::Epoch> epoch0(new concurrency::Epoch(10, 20));
-  std::shared_ptr<concurrency::Epoch> epoch1(new concurrency::Epoch(10, 20));
-  bool rt = comp(epoch0, epoch1);
-  EXPECT_EQ(rt, false);
-
-  std::shared_ptr<concurrency::Epoch> epoch2(new concurrency::Epoch(11, 21));
-  std::shared_ptr<concurrency::Epoch> epoch3(new concurrency::Epoch(12, 20));
-  rt = comp(epoch2, epoch3);
-  EXPECT_EQ(rt, false);
-}
-
-
 TEST_F(LocalEpochTests, TransactionTest) {
   concurrency::LocalEpoch local_epoch(0);
   
@@ -92,6 +77,70 @@ TEST_F(LocalEpochTests, TransactionTest) {
 }
 
 
+TEST_F(LocalEpochTests, SharedSlotTest) {
+  concurrency::LocalEpoch local_epoch(0);
+
+  // epochs 10 and 74 are counted in the same slot of the ring
+  bool rt = local_epoch.EnterEpoch(74);
+  EXPECT_EQ(rt, true);
+
+  rt = local_epoch.EnterEpoch(10);
+  EXPECT_EQ(rt, true);
+
+  // the slot keeps the oldest epoch.
+  uint64_t max_eid = local_epoch.GetMaxCommittedEpochId(80);
+  EXPECT_EQ(max_eid, 9);
+
+  // the slot is conservative until all its transactions have left.
+  local_epoch.ExitEpoch(10);
+  max_eid = local_epoch.GetMaxCommittedEpochId(81);
+  EXPECT_EQ(max_eid, 9);
+
+  local_epoch.ExitEpoch(74);
+  max_eid = local_epoch.GetMaxCommittedEpochId(82);
+  EXPECT_EQ(max_eid, 81);
+
+  // the slot can be used again.
+  rt = local_epoch.EnterEpoch(138);
+  EXPECT_EQ(rt, true);
+  max_eid = local_epoch.GetMaxCommittedEpochId(140);
+  EXPECT_EQ(max_eid, 137);
+  local_epoch.ExitEpoch(138);
+}
+
+
+void RunTransactions(concurrency::LocalEpoch *local_epoch,
+                     std::atomic<uint64_t> *current_epoch,
+                     uint64_t thread_itr) {
+  for (size_t txn_itr = 0; txn_itr < 10000; txn_itr++) {
+    uint64_t epoch_id;
+    do {
+      epoch_id = current_epoch->load();
+    } while (local_epoch->EnterEpoch(epoch_id) == false);
+
+    // the epoch of a running transaction is never reported as committed
+    EXPECT_LT(local_epoch->GetMaxCommittedEpochId(current_epoch->load()),
+              epoch_id);
+
+    if (thread_itr == 0 && txn_itr % 100 == 0) {
+      current_epoch->fetch_add(1);
+    }
+    local_epoch->ExitEpoch(epoch_id);
+  }
+}
+
+TEST_F(LocalEpochTests, ConcurrentTransactionTest) {
+  concurrency::LocalEpoch local_epoch(0);
+  std::atomic<uint64_t> current_epoch(1);
+
+  LaunchParallelTest(4, RunTransactions, &local_epoch, &current_epoch);
+
+  // all the transactions have left.
+  uint64_t max_eid = local_epoch.GetMaxCommittedEpochId(current_epoch.load());
+  EXPECT_EQ(max_eid, current_epoch.load() - 1);
+}
+
+
 }  // End test namespace
 }  // End peloton namespace
 
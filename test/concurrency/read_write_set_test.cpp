@@ -0,0 +1,93 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// read_write_set_test.cpp
+//
+// Identification: test/concurrency/read_write_set_test.cpp
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "common/harness.h"
+#include "concurrency/read_write_set.h"
+#include "concurrency/transaction.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Read Write Set Tests
+//===--------------------------------------------------------------------===//
+
+class ReadWriteSetTests : public PelotonTest {};
+
+TEST_F(ReadWriteSetTests, InsertFindTest) {
+  concurrency::ReadWriteSet rw_set;
+  EXPECT_TRUE(rw_set.empty());
+
+  // enough entries to grow the table several times
+  const oid_t tile_group_count = 10;
+  const oid_t tuple_count = 1000;
+  for (oid_t block = 0; block < tile_group_count; block++) {
+    for (oid_t offset = 0; offset < tuple_count; offset++) {
+      EXPECT_TRUE(rw_set.Find(ItemPointer(block, offset)) == nullptr);
+      rw_set.Insert(ItemPointer(block, offset), RWType::READ);
+    }
+  }
+  EXPECT_EQ(tile_group_count * tuple_count, rw_set.size());
+
+  for (oid_t block = 0; block < tile_group_count; block++) {
+    for (oid_t offset = 0; offset < tuple_count; offset++) {
+      auto type = rw_set.Find(ItemPointer(block, offset));
+      ASSERT_TRUE(type != nullptr);
+      EXPECT_EQ(RWType::READ, *type);
+    }
+  }
+  EXPECT_TRUE(rw_set.Find(ItemPointer(tile_group_count, 0)) == nullptr);
+
+  // the entries are iterated in the order they were recorded
+  oid_t entry_id = 0;
+  for (auto &entry : rw_set) {
+    EXPECT_EQ(entry_id / tuple_count, entry.location.block);
+    EXPECT_EQ(entry_id % tuple_count, entry.location.offset);
+    entry_id++;
+  }
+
+  // the type can be changed in place
+  *rw_set.Find(ItemPointer(3, 7)) = RWType::UPDATE;
+  EXPECT_EQ(RWType::UPDATE, *rw_set.Find(ItemPointer(3, 7)));
+
+  rw_set.Clear();
+  EXPECT_TRUE(rw_set.empty());
+  EXPECT_TRUE(rw_set.Find(ItemPointer(3, 7)) == nullptr);
+
+  rw_set.Insert(ItemPointer(3, 7), RWType::INSERT);
+  EXPECT_EQ(1, rw_set.size());
+  EXPECT_EQ(RWType::INSERT, *rw_set.Find(ItemPointer(3, 7)));
+}
+
+TEST_F(ReadWriteSetTests, TransactionReuseTest) {
+  concurrency::Transaction txn(1, 0);
+  txn.RecordRead(ItemPointer(1, 1));
+  txn.RecordInsert(ItemPointer(1, 2));
+  txn.RecordUpdate(ItemPointer(1, 1));
+  EXPECT_EQ(RWType::UPDATE, txn.GetRWType(ItemPointer(1, 1)));
+  EXPECT_EQ(RWType::INSERT, txn.GetRWType(ItemPointer(1, 2)));
+  EXPECT_FALSE(txn.IsReadOnly());
+  txn.SetResult(ResultType::ABORTED);
+
+  // reusing the transaction starts from a clean state
+  txn.Init(2, 0, false, IsolationLevelType::FULL);
+  EXPECT_EQ(2, txn.GetBeginCommitId());
+  EXPECT_EQ(MAX_CID, txn.GetEndCommitId());
+  EXPECT_EQ(ResultType::SUCCESS, txn.GetResult());
+  EXPECT_TRUE(txn.IsReadOnly());
+  EXPECT_TRUE(txn.GetReadWriteSet().empty());
+  EXPECT_TRUE(txn.IsGCSetEmpty());
+  EXPECT_EQ(RWType::INVALID, txn.GetRWType(ItemPointer(1, 1)));
+}
+
+}  // End test namespace
+}  // End peloton namespace
@@ -65,5 +65,76 @@ TEST_F(LockFreeArrayTests, SharedPointerTest) {
 
 }
 
+// Test growing the array past several segments
+TEST_F(LockFreeArrayTests, GrowTest) {
+
+  typedef oid_t value_type;
+
+  {
+    LockFreeArray<value_type> array;
+    EXPECT_TRUE(array.IsEmpty());
+    EXPECT_EQ(0, array.GetMemoryFootprint());
+
+    size_t const element_count = 100000;
+    for (size_t element = 0; element < element_count; ++element ) {
+      auto status = array.Append(element);
+      EXPECT_TRUE(status);
+    }
+    EXPECT_FALSE(array.IsEmpty());
+    EXPECT_EQ(element_count, array.GetSize());
+
+    for (size_t element = 0; element < element_count; ++element ) {
+      EXPECT_EQ(element, array.Find(element));
+    }
+    EXPECT_TRUE(array.Contains(element_count - 1));
+    EXPECT_FALSE(array.Contains(element_count));
+
+    // the capacity at most doubles the number of entries
+    EXPECT_LE(array.GetMemoryFootprint(),
+              2 * (element_count + 64) * sizeof(value_type));
+
+    // entries far beyond the appended ones can be updated directly
+    size_t const far_offset = 10 * 1024 * 1024;
+    EXPECT_EQ(0, array.Find(far_offset));
+    array.Update(far_offset, 42);
+    EXPECT_EQ(42, array.Find(far_offset));
+    EXPECT_EQ(element_count, array.GetSize());
+
+    array.Erase(far_offset, INVALID_OID);
+    EXPECT_EQ(INVALID_OID, array.Find(far_offset));
+    EXPECT_EQ(1, array.FindValid(1, INVALID_OID));
+
+    array.Clear(INVALID_OID);
+    EXPECT_TRUE(array.IsEmpty());
+    EXPECT_EQ(INVALID_OID, array.Find(0));
+  }
+
+}
+
+// Test appending from several threads at once
+TEST_F(LockFreeArrayTests, ConcurrentAppendTest) {
+
+  typedef oid_t value_type;
+
+  LockFreeArray<value_type> array;
+  size_t const thread_count = 4;
+  size_t const element_count = 10000;
+  LaunchParallelTest(thread_count, [&array](uint64_t thread_id) {
+    for (size_t element = 0; element < element_count; ++element) {
+      array.Append(thread_id * element_count + element);
+    }
+  });
+
+  EXPECT_EQ(thread_count * element_count, array.GetSize());
+
+  std::vector<bool> found(thread_count * element_count, false);
+  for (size_t offset = 0; offset < array.GetSize(); ++offset) {
+    auto value = array.Find(offset);
+    ASSERT_LT(value, found.size());
+    EXPECT_FALSE(found[value]);
+    found[value] = true;
+  }
+}
+
 }  // End test namespace
 }  // End peloton namespace
@@ -0,0 +1,122 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// result_sink_test.cpp
+//
+// Identification: test/executor/result_sink_test.cpp
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <vector>
+
+#include "common/harness.h"
+
+#include "common/exception.h"
+#include "executor/result_sink.h"
+#include "type/value_factory.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Result Sink Tests
+//===--------------------------------------------------------------------===//
+
+class ResultSinkTests : public PelotonTest {};
+
+TEST_F(ResultSinkTests, BufferingTest) {
+  std::vector<type::Value> row = {
+      type::ValueFactory::GetIntegerValue(42),
+      type::ValueFactory::GetVarcharValue("peloton"),
+      type::ValueFactory::GetNullValueByType(type::Type::INTEGER)};
+
+  // text for the first two columns, binary for the last one
+  std::vector<int> result_format = {0, 0, 1};
+  std::vector<StatementResult> result;
+  executor::BufferingResultSink sink{result_format, result};
+  sink.AddRow(row.data(), row.size());
+  sink.AddRow(row.data(), row.size());
+
+  ASSERT_EQ(2 * row.size(), result.size());
+  EXPECT_EQ("42",
+            std::string(result[0].second.begin(), result[0].second.end()));
+  EXPECT_EQ("peloton",
+            std::string(result[1].second.begin(), result[1].second.end()));
+  // NULL is materialized as no bytes
+  EXPECT_TRUE(result[2].second.empty());
+  EXPECT_EQ(result[0].second, result[3].second);
+}
+
+TEST_F(ResultSinkTests, BinaryFormatTest) {
+  // the binary format is big endian
+  std::vector<unsigned char> output;
+  executor::ResultSink::SerializeValue(
+      type::ValueFactory::GetIntegerValue(0x01020304), 1, output);
+  std::vector<unsigned char> expected = {0x01, 0x02, 0x03, 0x04};
+  EXPECT_EQ(expected, output);
+
+  // timestamps count the microseconds since 2000-01-01
+  uint64_t timestamp = 1 * 32 + 2;           // month, day
+  timestamp = timestamp * 27 + 12;           // time zone +00
+  timestamp = timestamp * 10000 + 2000;      // year
+  timestamp = timestamp * 100000 + 1;        // seconds of the day
+  timestamp = timestamp * 1000000 + 5;       // microseconds
+  output.clear();
+  executor::ResultSink::SerializeValue(
+      type::ValueFactory::GetTimestampValue(timestamp), 1, output);
+  int64_t postgres_timestamp = 0;
+  for (auto byte : output) {
+    postgres_timestamp = (postgres_timestamp << 8) | byte;
+  }
+  EXPECT_EQ(8, output.size());
+  EXPECT_EQ((86400 + 1) * 1000000l + 5, postgres_timestamp);
+
+  // varlen values are sent as text in both formats
+  output.clear();
+  executor::ResultSink::SerializeValue(
+      type::ValueFactory::GetVarcharValue("abc"), 1, output);
+  EXPECT_EQ("abc", std::string(output.begin(), output.end()));
+}
+
+TEST_F(ResultSinkTests, AggregateFormatTest) {
+  // COUNT(*) is described as an INTEGER, but produces BIGINT values
+  FieldInfo count_field = std::make_tuple(
+      "COUNT(*)", static_cast<oid_t>(PostgresValueType::INTEGER), 4);
+  // SUM is described as TEXT
+  FieldInfo sum_field = std::make_tuple(
+      "sum", static_cast<oid_t>(PostgresValueType::TEXT), 255);
+
+  // the binary format is only advertised for the type that has one
+  EXPECT_EQ(1, executor::ResultSink::GetResultFormat(std::get<1>(count_field),
+                                                     1));
+  EXPECT_EQ(0, executor::ResultSink::GetResultFormat(std::get<1>(sum_field),
+                                                     1));
+
+  // the count is sent as the 4 bytes of an int4
+  std::vector<unsigned char> output;
+  executor::ResultSink::SerializeValue(
+      type::ValueFactory::GetBigIntValue(0x01020304),
+      std::get<1>(count_field), 1, output);
+  std::vector<unsigned char> expected = {0x01, 0x02, 0x03, 0x04};
+  EXPECT_EQ(expected, output);
+
+  // the sum is sent as text, although the client asked for binary
+  output.clear();
+  executor::ResultSink::SerializeValue(
+      type::ValueFactory::GetBigIntValue(1234567890123l),
+      std::get<1>(sum_field), 1, output);
+  EXPECT_EQ("1234567890123", std::string(output.begin(), output.end()));
+
+  // a count that doesn't fit into an int4 can't be sent as one
+  output.clear();
+  EXPECT_THROW(executor::ResultSink::SerializeValue(
+                   type::ValueFactory::GetBigIntValue(1l << 40),
+                   std::get<1>(count_field), 1, output),
+               Exception);
+}
+
+}  // namespace test
+}  // namespace peloton
@@ -24,6 +24,7 @@
 #include "type/value_factory.h"
 #include "concurrency/transaction.h"
 #include "concurrency/transaction_manager_factory.h"
+#include "configuration/configuration.h"
 #include "executor/abstract_executor.h"
 #include "executor/executor_context.h"
 #include "executor/logical_tile.h"
@@ -269,6 +270,34 @@ TEST_F(SeqScanTests, TwoTileGroupsWithPredicateTest) {
   txn_manager.CommitTransaction(txn);
 }
 
+// Same as above, but filters whole tile groups at a time.
+TEST_F(SeqScanTests, VectorizedTwoTileGroupsWithPredicateTest) {
+  bool vectorized_execution = FLAGS_vectorized_execution;
+  FLAGS_vectorized_execution = true;
+
+  // Create table.
+  std::unique_ptr<storage::DataTable> table(CreateTable());
+
+  // Column ids to be added to logical tile after scan.
+  std::vector<oid_t> column_ids({0, 1, 3});
+
+  // Create plan node.
+  planner::SeqScanPlan node(table.get(), CreatePredicate(g_tuple_ids),
+                            column_ids);
+
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  std::unique_ptr<executor::ExecutorContext> context(
+      new executor::ExecutorContext(txn));
+
+  executor::SeqScanExecutor executor(&node, context.get());
+  RunTest(executor, table->GetTileGroupCount(), column_ids.size());
+
+  txn_manager.CommitTransaction(txn);
+
+  FLAGS_vectorized_execution = vectorized_execution;
+}
+
 // Sequential scan of logical tile with predicate.
 TEST_F(SeqScanTests, NonLeafNodePredicateTest) {
   // No table for this case as seq scan is not a leaf node.
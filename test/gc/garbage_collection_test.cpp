@@ -16,6 +16,7 @@
 #include "gc/gc_manager.h"
 #include "gc/gc_manager_factory.h"
 #include "concurrency/epoch_manager.h"
+#include "configuration/configuration.h"
 
 
 #include "catalog/catalog.h"
@@ -198,5 +199,191 @@ TEST_F(GarbageCollectionTests, SimpleTest) {
 }
 
 
+TEST_F(GarbageCollectionTests, CooperativeIdleWorkerTest) {
+  std::vector<std::unique_ptr<std::thread>> gc_threads;
+
+  gc::GCManagerFactory::Configure(1, true);
+  EXPECT_TRUE(gc::GCManagerFactory::GetGCType() ==
+              GarbageCollectionType::COOPERATIVE);
+  auto &gc_manager = gc::GCManagerFactory::GetInstance();
+
+  auto &epoch_manager = concurrency::EpochManagerFactory::GetInstance();
+  epoch_manager.Reset(1);
+
+  auto catalog = catalog::Catalog::GetInstance();
+  auto database = TestingExecutorUtil::InitializeDatabase(DEFAULT_DB_NAME);
+  oid_t db_id = database->GetOid();
+  EXPECT_TRUE(catalog->HasDatabase(db_id));
+
+  const int num_key = 1;
+  std::unique_ptr<storage::DataTable> table(TestingTransactionUtil::CreateTable(
+      num_key, "TEST_TABLE", db_id, INVALID_OID, 1234, true));
+
+  gc_manager.StartGC(gc_threads);
+
+  // the worker batches the garbage of a single transaction, far less than
+  // COOPERATIVE_GC_BATCH_SIZE, and never runs another one
+  auto succ_num = UpdateTuple(table.get(), 1, num_key, 1);
+  EXPECT_EQ(succ_num, 1);
+  EXPECT_EQ(1, GarbageNum(table.get()));
+
+  // the gc threads collect the garbage of the worker anyway
+  for (size_t i = 2; i < 12; ++i) {
+    epoch_manager.Reset(i);
+    SelectTuple(table.get(), num_key);
+  }
+  std::this_thread::sleep_for(std::chrono::seconds(1));
+
+  for (size_t i = 12; i < 22; ++i) {
+    epoch_manager.Reset(i);
+    SelectTuple(table.get(), num_key);
+  }
+  std::this_thread::sleep_for(std::chrono::seconds(1));
+
+  EXPECT_EQ(0, GarbageNum(table.get()));
+  EXPECT_EQ(1, RecycledNum(table.get()));
+
+  gc_manager.StopGC();
+
+  table.release();
+
+  TestingExecutorUtil::DeleteDatabase(DEFAULT_DB_NAME);
+  EXPECT_FALSE(catalog->HasDatabase(db_id));
+
+  gc::GCManagerFactory::Configure(0);
+
+  for (auto &gc_thread : gc_threads) {
+    gc_thread->join();
+  }
+}
+
+// the value of the given column in the visible version of the tuple whose
+// first column holds the given key
+type::Value VisibleValue(storage::DataTable *table, const int key,
+                         const oid_t column_id) {
+  auto tile_group_count = table->GetTileGroupCount();
+  for (oid_t offset = START_OID; offset < tile_group_count; offset++) {
+    auto tile_group = table->GetTileGroup(offset);
+    auto tile_group_header = tile_group->GetHeader();
+    oid_t active_tuple_count = tile_group->GetNextTupleSlot();
+
+    for (oid_t tuple_id = 0; tuple_id < active_tuple_count; tuple_id++) {
+      if (tile_group_header->GetTransactionId(tuple_id) != INITIAL_TXN_ID ||
+          tile_group_header->GetEndCommitId(tuple_id) != MAX_CID) {
+        continue;
+      }
+      auto value = tile_group->GetValue(tuple_id, 0);
+      if (value.CompareEquals(type::ValueFactory::GetIntegerValue(key)) ==
+          type::CMP_TRUE) {
+        return tile_group->GetValue(tuple_id, column_id);
+      }
+    }
+  }
+  return type::ValueFactory::GetNullValueByType(type::Type::INTEGER);
+}
+
+// advance the epochs, and give the gc threads the time to collect the garbage
+// of the transactions that ended before
+void AdvanceEpochs(size_t &epoch) {
+  auto &epoch_manager = concurrency::EpochManagerFactory::GetInstance();
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  for (int round = 0; round < 2; round++) {
+    for (int i = 0; i < 10; i++) {
+      epoch_manager.Reset(++epoch);
+      auto txn = txn_manager.BeginTransaction();
+      txn_manager.CommitTransaction(txn);
+    }
+    std::this_thread::sleep_for(std::chrono::seconds(1));
+  }
+}
+
+TEST_F(GarbageCollectionTests, SharedVersionColumnsTest) {
+  std::vector<std::unique_ptr<std::thread>> gc_threads;
+
+  // the updates share the varlen data of the columns they do not modify
+  FLAGS_shared_version_columns = true;
+
+  gc::GCManagerFactory::Configure(1);
+  auto &gc_manager = gc::GCManagerFactory::GetInstance();
+
+  size_t epoch = 1;
+  auto &epoch_manager = concurrency::EpochManagerFactory::GetInstance();
+  epoch_manager.Reset(epoch);
+
+  auto catalog = catalog::Catalog::GetInstance();
+  auto database = TestingExecutorUtil::InitializeDatabase(DEFAULT_DB_NAME);
+  oid_t db_id = database->GetOid();
+  EXPECT_TRUE(catalog->HasDatabase(db_id));
+
+  // the last column of the table is a varchar
+  auto table =
+      TestingExecutorUtil::CreateTable(TESTS_TUPLES_PER_TILEGROUP, true, 1235);
+  database->AddTable(table);
+
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  TestingExecutorUtil::PopulateTable(table, 2, false, false, false, txn);
+  EXPECT_EQ(ResultType::SUCCESS, txn_manager.CommitTransaction(txn));
+
+  gc_manager.StartGC(gc_threads);
+
+  const int committed_key = TestingExecutorUtil::PopulatedValue(0, 0);
+  const int aborted_key = TestingExecutorUtil::PopulatedValue(1, 0);
+  auto committed_name = type::ValueFactory::GetVarcharValue(
+      std::to_string(TestingExecutorUtil::PopulatedValue(0, 3)));
+  auto aborted_name = type::ValueFactory::GetVarcharValue(
+      std::to_string(TestingExecutorUtil::PopulatedValue(1, 3)));
+
+  // the new version of a committed update takes over the varchar of the old
+  // one, and the varchar of the aborted version stays with the old one
+  txn = txn_manager.BeginTransaction();
+  EXPECT_TRUE(
+      TestingTransactionUtil::ExecuteUpdate(txn, table, committed_key, 100));
+  EXPECT_EQ(ResultType::SUCCESS, txn_manager.CommitTransaction(txn));
+
+  txn = txn_manager.BeginTransaction();
+  EXPECT_TRUE(
+      TestingTransactionUtil::ExecuteUpdate(txn, table, aborted_key, 200));
+  txn_manager.AbortTransaction(txn);
+
+  EXPECT_EQ(1, GarbageNum(table));
+  AdvanceEpochs(epoch);
+  EXPECT_EQ(0, GarbageNum(table));
+
+  // the versions that are left still see their varchars
+  EXPECT_TRUE(VisibleValue(table, committed_key, 1).CompareEquals(
+                  type::ValueFactory::GetIntegerValue(100)) == type::CMP_TRUE);
+  EXPECT_TRUE(VisibleValue(table, committed_key, 3).CompareEquals(
+                  committed_name) == type::CMP_TRUE);
+  EXPECT_TRUE(VisibleValue(table, aborted_key, 1).CompareEquals(
+                  type::ValueFactory::GetIntegerValue(
+                      TestingExecutorUtil::PopulatedValue(1, 1))) ==
+              type::CMP_TRUE);
+  EXPECT_TRUE(VisibleValue(table, aborted_key, 3).CompareEquals(
+                  aborted_name) == type::CMP_TRUE);
+
+  // deleting the tuples frees their varchars. had the gc freed one of them
+  // already, it would be freed twice.
+  txn = txn_manager.BeginTransaction();
+  EXPECT_TRUE(TestingTransactionUtil::ExecuteDelete(txn, table, committed_key));
+  EXPECT_TRUE(TestingTransactionUtil::ExecuteDelete(txn, table, aborted_key));
+  EXPECT_EQ(ResultType::SUCCESS, txn_manager.CommitTransaction(txn));
+
+  AdvanceEpochs(epoch);
+  EXPECT_EQ(0, GarbageNum(table));
+
+  gc_manager.StopGC();
+
+  TestingExecutorUtil::DeleteDatabase(DEFAULT_DB_NAME);
+  EXPECT_FALSE(catalog->HasDatabase(db_id));
+
+  gc::GCManagerFactory::Configure(0);
+  FLAGS_shared_version_columns = false;
+
+  for (auto &gc_thread : gc_threads) {
+    gc_thread->join();
+  }
+}
+
 }  // End test namespace
 }  // End peloton namespace
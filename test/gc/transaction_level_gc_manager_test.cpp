@@ -15,6 +15,7 @@
 #include "catalog/catalog.h"
 #include "common/harness.h"
 #include "gc/gc_manager_factory.h"
+#include "gc/transaction_level_gc_manager.h"
 
 #include "storage/data_table.h"
 #include "storage/tile_group.h"
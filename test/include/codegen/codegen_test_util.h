@@ -64,6 +64,10 @@ class PelotonCodeGenTest : public PelotonTest {
   // Load the given table with the given number of rows
   void LoadTestTable(uint32_t table_id, uint32_t num_rows);
 
+  // Add a BwTree primary key index on column A of the given table. This must
+  // be done before the table is loaded.
+  void CreatePrimaryKeyIndex(uint32_t table_id);
+
   // Compile and execute the given plan
   codegen::QueryCompiler::CompileStats CompileAndExecute(
       const planner::AbstractPlan &plan, codegen::QueryResultConsumer &consumer,
@@ -26,45 +26,44 @@ namespace test {
 class SkipListIndexTests : public PelotonTest {};
 
 TEST_F(SkipListIndexTests, BasicTest) {
-  // TestingIndexUtil::BasicTest(IndexType::SKIPLIST);
-  EXPECT_EQ(2, 1+1);
+  TestingIndexUtil::BasicTest(IndexType::SKIPLIST);
+}
+
+TEST_F(SkipListIndexTests, MultiMapInsertTest) {
+  TestingIndexUtil::MultiMapInsertTest(IndexType::SKIPLIST);
+}
+
+TEST_F(SkipListIndexTests, UniqueKeyInsertTest) {
+  TestingIndexUtil::UniqueKeyInsertTest(IndexType::SKIPLIST);
 }
 
-//TEST_F(SkipListIndexTests, MultiMapInsertTest) {
-//  TestingIndexUtil::MultiMapInsertTest(IndexType::SKIPLIST);
-//}
-//
-//TEST_F(SkipListIndexTests, UniqueKeyInsertTest) {
-//  TestingIndexUtil::UniqueKeyInsertTest(IndexType::SKIPLIST);
-//}
-//
 //TEST_F(SkipListIndexTests, UniqueKeyDeleteTest) {
 //  TestingIndexUtil::UniqueKeyDeleteTest(IndexType::SKIPLIST);
 //}
-//
-//TEST_F(SkipListIndexTests, NonUniqueKeyDeleteTest) {
-//  TestingIndexUtil::NonUniqueKeyDeleteTest(IndexType::SKIPLIST);
-//}
-//
-//TEST_F(SkipListIndexTests, MultiThreadedInsertTest) {
-//  TestingIndexUtil::MultiThreadedInsertTest(IndexType::SKIPLIST);
-//}
-//
+
+TEST_F(SkipListIndexTests, NonUniqueKeyDeleteTest) {
+  TestingIndexUtil::NonUniqueKeyDeleteTest(IndexType::SKIPLIST);
+}
+
+TEST_F(SkipListIndexTests, MultiThreadedInsertTest) {
+  TestingIndexUtil::MultiThreadedInsertTest(IndexType::SKIPLIST);
+}
+
 //TEST_F(SkipListIndexTests, UniqueKeyMultiThreadedTest) {
 //  TestingIndexUtil::UniqueKeyMultiThreadedTest(IndexType::SKIPLIST);
 //}
-//
-//TEST_F(SkipListIndexTests, NonUniqueKeyMultiThreadedTest) {
-//  TestingIndexUtil::NonUniqueKeyMultiThreadedTest(IndexType::SKIPLIST);
-//}
-//
-//TEST_F(SkipListIndexTests, NonUniqueKeyMultiThreadedStressTest) {
-//  TestingIndexUtil::NonUniqueKeyMultiThreadedStressTest(IndexType::SKIPLIST);
-//}
-//
-//TEST_F(SkipListIndexTests, NonUniqueKeyMultiThreadedStressTest2) {
-//  TestingIndexUtil::NonUniqueKeyMultiThreadedStressTest2(IndexType::SKIPLIST);
-//}
+
+TEST_F(SkipListIndexTests, NonUniqueKeyMultiThreadedTest) {
+  TestingIndexUtil::NonUniqueKeyMultiThreadedTest(IndexType::SKIPLIST);
+}
+
+TEST_F(SkipListIndexTests, NonUniqueKeyMultiThreadedStressTest) {
+  TestingIndexUtil::NonUniqueKeyMultiThreadedStressTest(IndexType::SKIPLIST);
+}
+
+TEST_F(SkipListIndexTests, NonUniqueKeyMultiThreadedStressTest2) {
+  TestingIndexUtil::NonUniqueKeyMultiThreadedStressTest2(IndexType::SKIPLIST);
+}
 
 }  // End test namespace
 }  // End peloton namespace
@@ -323,6 +323,41 @@ TEST_F(LoggingTests, InsertUpdateDeleteTest) {
   scheduler.Cleanup();
 }
 
+TEST_F(LoggingTests, FlushFutureTest) {
+  auto &log_manager = logging::LogManager::GetInstance();
+  log_manager.DropFrontendLoggers();
+  log_manager.Configure(LoggingType::NVM_WAL, true);
+  log_manager.InitFrontendLoggers();
+
+  auto frontend_logger = log_manager.GetFrontendLogger(0);
+  frontend_logger->SetMaxFlushedCommitId(2);
+
+  // Txns up to cid = 2 are persistent already
+  auto future2 = log_manager.GetFlushFuture(2);
+  EXPECT_EQ(std::future_status::ready,
+            future2.wait_for(std::chrono::seconds(0)));
+
+  auto future3 = log_manager.GetFlushFuture(3);
+  auto future5 = log_manager.GetFlushFuture(5);
+  EXPECT_EQ(std::future_status::timeout,
+            future3.wait_for(std::chrono::seconds(0)));
+
+  // Only the commits covered by the flush are woken up
+  frontend_logger->SetMaxFlushedCommitId(4);
+  log_manager.FrontendLoggerFlushed();
+  EXPECT_EQ(std::future_status::ready,
+            future3.wait_for(std::chrono::seconds(0)));
+  EXPECT_EQ(std::future_status::timeout,
+            future5.wait_for(std::chrono::seconds(0)));
+
+  frontend_logger->SetMaxFlushedCommitId(5);
+  log_manager.FrontendLoggerFlushed();
+  EXPECT_EQ(std::future_status::ready,
+            future5.wait_for(std::chrono::seconds(0)));
+
+  log_manager.DropFrontendLoggers();
+}
+
 TEST_F(LoggingTests, BasicLogManagerTest) {
   peloton_logging_mode = LoggingType::INVALID;
   auto &log_manager = logging::LogManager::GetInstance();
@@ -16,7 +16,9 @@
 #include <sys/types.h>
 
 #include "catalog/catalog.h"
+#include "catalog/manager.h"
 #include "common/harness.h"
+#include "common/thread_pool.h"
 #include "executor/testing_executor_util.h"
 #include "logging/testing_logging_util.h"
 
@@ -98,6 +100,68 @@ std::vector<storage::Tuple *> BuildLoggingTuples(storage::DataTable *table,
   return tuples;
 }
 
+// Create an empty WAL directory for the log files of the test
+void ResetLogDirectory() {
+  std::string dir_name = logging::WriteAheadFrontendLogger::wal_directory_path;
+  logging::LoggingUtil::RemoveDirectory(dir_name.c_str(), false);
+  auto status = logging::LoggingUtil::CreateDirectory(dir_name.c_str(), 0700);
+  EXPECT_EQ(status, true);
+  logging::LogManager::GetInstance().SetLogDirectoryName("./");
+}
+
+// Create the log file with the given number, and write its header
+FILE *CreateLogFile(int file_num) {
+  std::string dir_name = logging::WriteAheadFrontendLogger::wal_directory_path;
+  std::string file_name = dir_name + "/" + std::string("peloton_log_") +
+                          std::to_string(file_num) + std::string(".log");
+  FILE *fp = fopen(file_name.c_str(), "wb");
+  PL_ASSERT(fp != nullptr);
+
+  // the max log id and the max delimiter in this file
+  cid_t default_commit_id = INVALID_CID;
+  cid_t default_delimiter = INVALID_CID;
+  fwrite((void *)&default_commit_id, sizeof(default_commit_id), 1, fp);
+  fwrite((void *)&default_delimiter, sizeof(default_delimiter), 1, fp);
+  return fp;
+}
+
+// Serialize the record and append it to the log file. When a length is
+// given, only that many bytes of the record are written, which tears it.
+void WriteLogRecord(FILE *fp, logging::LogRecord &record, size_t length = 0) {
+  CopySerializeOutput output_buffer;
+  record.Serialize(output_buffer);
+  if (length == 0 || length > record.GetMessageLength()) {
+    length = record.GetMessageLength();
+  }
+  fwrite(record.GetMessage(), sizeof(char), length, fp);
+}
+
+// Append a committed transaction holding the given tuple records to the log
+void WriteCommittedTransaction(
+    FILE *fp, cid_t commit_id,
+    const std::vector<logging::TupleRecord *> &records) {
+  logging::TransactionRecord record_begin(LOGRECORD_TYPE_TRANSACTION_BEGIN,
+                                          commit_id);
+  WriteLogRecord(fp, record_begin);
+  for (auto record : records) {
+    WriteLogRecord(fp, *record);
+  }
+  logging::TransactionRecord record_commit(LOGRECORD_TYPE_TRANSACTION_COMMIT,
+                                           commit_id);
+  WriteLogRecord(fp, record_commit);
+  logging::TransactionRecord record_delim(LOGRECORD_TYPE_ITERATION_DELIMITER,
+                                          commit_id);
+  WriteLogRecord(fp, record_delim);
+}
+
+// Recover the transactions in the log files, up to the given commit id
+void RecoverFromLog(cid_t max_flushed_id) {
+  logging::LogManager::GetInstance().SetGlobalMaxFlushedIdForRecovery(
+      max_flushed_id);
+  logging::WriteAheadFrontendLogger wal_fel;
+  wal_fel.DoRecovery();
+}
+
 TEST_F(RecoveryTests, RestartTest) {
   auto catalog = catalog::Catalog::GetInstance();
   LOG_TRACE("Finish creating catalog");
@@ -290,20 +354,22 @@ TEST_F(RecoveryTests, BasicInsertTest) {
   EXPECT_EQ(recovery_table->GetTupleCount(), 0);
   EXPECT_EQ(recovery_table->GetTileGroupCount(), 1);
   EXPECT_EQ(tuples.size(), 1);
-  logging::WriteAheadFrontendLogger fel(true);
-  //  auto bel = logging::WriteAheadBackendLogger::GetInstance();
   cid_t test_commit_id = 10;
 
   type::Value val0 = (tuples[0]->GetValue(0));
   type::Value val1 = (tuples[0]->GetValue(1));
   type::Value val2 = (tuples[0]->GetValue(2));
   type::Value val3 = (tuples[0]->GetValue(3));
-  auto curr_rec = new logging::TupleRecord(
-      LOGRECORD_TYPE_TUPLE_INSERT, test_commit_id, recovery_table->GetOid(),
+  logging::TupleRecord insert_rec(
+      LOGRECORD_TYPE_WAL_TUPLE_INSERT, test_commit_id, recovery_table->GetOid(),
       ItemPointer(100, 5), INVALID_ITEMPOINTER, tuples[0], DEFAULT_DB_ID);
-  curr_rec->SetTuple(tuples[0]);
-  fel.InsertTuple(curr_rec);
-  delete curr_rec;
+  insert_rec.SetTuple(tuples[0]);
+
+  ResetLogDirectory();
+  FILE *fp = CreateLogFile(0);
+  WriteCommittedTransaction(fp, test_commit_id, {&insert_rec});
+  fclose(fp);
+  RecoverFromLog(test_commit_id);
 
   auto tg_header = recovery_table->GetTileGroupById(100)->GetHeader();
   EXPECT_TRUE(tg_header->GetBeginCommitId(5) <= test_commit_id);
@@ -325,6 +391,8 @@ TEST_F(RecoveryTests, BasicInsertTest) {
   EXPECT_EQ(recovery_table->GetTupleCount(), 1);
   EXPECT_EQ(recovery_table->GetTileGroupCount(), 2);
 
+  logging::LoggingUtil::RemoveDirectory(
+      logging::WriteAheadFrontendLogger::wal_directory_path, false);
   auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
   auto txn = txn_manager.BeginTransaction();
   catalog->DropDatabaseWithOid(DEFAULT_DB_ID, txn);
@@ -342,8 +410,6 @@ TEST_F(RecoveryTests, BasicUpdateTest) {
   EXPECT_EQ(recovery_table->GetTupleCount(), 0);
   EXPECT_EQ(recovery_table->GetTileGroupCount(), 1);
   EXPECT_EQ(tuples.size(), 1);
-  logging::WriteAheadFrontendLogger fel(true);
-  //  auto bel = logging::WriteAheadBackendLogger::GetInstance();
   cid_t test_commit_id = 10;
 
   type::Value val0 = (tuples[0]->GetValue(0));
@@ -351,12 +417,16 @@ TEST_F(RecoveryTests, BasicUpdateTest) {
   type::Value val2 = (tuples[0]->GetValue(2));
   type::Value val3 = (tuples[0]->GetValue(3));
 
-  auto curr_rec = new logging::TupleRecord(
-      LOGRECORD_TYPE_TUPLE_UPDATE, test_commit_id, recovery_table->GetOid(),
+  logging::TupleRecord update_rec(
+      LOGRECORD_TYPE_WAL_TUPLE_UPDATE, test_commit_id, recovery_table->GetOid(),
       ItemPointer(100, 5), ItemPointer(100, 4), tuples[0], DEFAULT_DB_ID);
-  curr_rec->SetTuple(tuples[0]);
-  fel.UpdateTuple(curr_rec);
-  delete curr_rec;
+  update_rec.SetTuple(tuples[0]);
+
+  ResetLogDirectory();
+  FILE *fp = CreateLogFile(0);
+  WriteCommittedTransaction(fp, test_commit_id, {&update_rec});
+  fclose(fp);
+  RecoverFromLog(test_commit_id);
 
   auto tg_header = recovery_table->GetTileGroupById(100)->GetHeader();
   EXPECT_TRUE(tg_header->GetBeginCommitId(5) <= test_commit_id);
@@ -379,6 +449,8 @@ TEST_F(RecoveryTests, BasicUpdateTest) {
   EXPECT_EQ(recovery_table->GetTupleCount(), 0);
   EXPECT_EQ(recovery_table->GetTileGroupCount(), 2);
 
+  logging::LoggingUtil::RemoveDirectory(
+      logging::WriteAheadFrontendLogger::wal_directory_path, false);
   auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
   auto txn = txn_manager.BeginTransaction();
   catalog->DropDatabaseWithOid(DEFAULT_DB_ID, txn);
@@ -424,32 +496,177 @@ TEST_F(RecoveryTests, OutOfOrderCommitTest) {
   EXPECT_EQ(recovery_table->GetTupleCount(), 0);
   EXPECT_EQ(recovery_table->GetTileGroupCount(), 1);
   EXPECT_EQ(tuples.size(), 1);
-  logging::WriteAheadFrontendLogger fel(true);
-  //  auto bel = logging::WriteAheadBackendLogger::GetInstance();
   cid_t test_commit_id = 10;
 
-  auto curr_rec = new logging::TupleRecord(
-      LOGRECORD_TYPE_TUPLE_UPDATE, test_commit_id + 1, recovery_table->GetOid(),
-      INVALID_ITEMPOINTER, ItemPointer(100, 5), nullptr, DEFAULT_DB_ID);
-  fel.DeleteTuple(curr_rec);
-  delete curr_rec;
-
-  EXPECT_EQ(recovery_table->GetTileGroupCount(), 2);
-
-  curr_rec = new logging::TupleRecord(
-      LOGRECORD_TYPE_TUPLE_INSERT, test_commit_id, recovery_table->GetOid(),
+  // The delete commits after the insert, but it is logged first
+  logging::TupleRecord delete_rec(
+      LOGRECORD_TYPE_WAL_TUPLE_DELETE, test_commit_id + 1,
+      recovery_table->GetOid(), INVALID_ITEMPOINTER, ItemPointer(100, 5),
+      nullptr, DEFAULT_DB_ID);
+  logging::TupleRecord insert_rec(
+      LOGRECORD_TYPE_WAL_TUPLE_INSERT, test_commit_id, recovery_table->GetOid(),
       ItemPointer(100, 5), INVALID_ITEMPOINTER, tuples[0], DEFAULT_DB_ID);
+  insert_rec.SetTuple(tuples[0]);
 
-  curr_rec->SetTuple(tuples[0]);
-  fel.InsertTuple(curr_rec);
-
-  delete curr_rec;
+  ResetLogDirectory();
+  FILE *fp = CreateLogFile(0);
+  WriteCommittedTransaction(fp, test_commit_id + 1, {&delete_rec});
+  WriteCommittedTransaction(fp, test_commit_id, {&insert_rec});
+  fclose(fp);
+  RecoverFromLog(test_commit_id + 1);
 
   auto tg_header = recovery_table->GetTileGroupById(100)->GetHeader();
   EXPECT_EQ(tg_header->GetEndCommitId(5), test_commit_id + 1);
 
   EXPECT_EQ(recovery_table->GetTupleCount(), 0);
   EXPECT_EQ(recovery_table->GetTileGroupCount(), 2);
+
+  logging::LoggingUtil::RemoveDirectory(
+      logging::WriteAheadFrontendLogger::wal_directory_path, false);
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  catalog->DropDatabaseWithOid(DEFAULT_DB_ID, txn);
+  txn_manager.CommitTransaction(txn);
+}
+
+TEST_F(RecoveryTests, ParallelReplayTest) {
+  // The two tables are replayed at the same time, one by the recovering thread
+  // and one by a worker of the pool
+  thread_pool.Initialize(2, 0);
+
+  auto catalog = catalog::Catalog::GetInstance();
+  auto table_a = TestingExecutorUtil::CreateTable(1024, false, 101);
+  auto table_b = TestingExecutorUtil::CreateTable(1024, false, 102);
+  storage::Database *db = new storage::Database(DEFAULT_DB_ID);
+  catalog->AddDatabase(db);
+  db->AddTable(table_a);
+  db->AddTable(table_b);
+
+  const int num_rows = 8;
+  auto tuples_a = BuildLoggingTuples(table_a, num_rows, false, false);
+  auto tuples_b = BuildLoggingTuples(table_b, num_rows, false, false);
+  auto new_tuples_b = BuildLoggingTuples(table_b, 2, true, false);
+  auto &manager = catalog::Manager::GetInstance();
+  oid_t tile_group_a = manager.GetNextTileGroupId() + 1;
+  oid_t tile_group_b = tile_group_a + 1;
+  cid_t test_commit_id = 10;
+
+  // The first transaction inserts the rows of both tables, interleaved
+  std::vector<std::unique_ptr<logging::TupleRecord>> insert_recs;
+  for (int row = 0; row < num_rows; row++) {
+    insert_recs.emplace_back(new logging::TupleRecord(
+        LOGRECORD_TYPE_WAL_TUPLE_INSERT, test_commit_id, table_a->GetOid(),
+        ItemPointer(tile_group_a, row), INVALID_ITEMPOINTER, tuples_a[row],
+        DEFAULT_DB_ID));
+    insert_recs.back()->SetTuple(tuples_a[row]);
+    insert_recs.emplace_back(new logging::TupleRecord(
+        LOGRECORD_TYPE_WAL_TUPLE_INSERT, test_commit_id, table_b->GetOid(),
+        ItemPointer(tile_group_b, row), INVALID_ITEMPOINTER, tuples_b[row],
+        DEFAULT_DB_ID));
+    insert_recs.back()->SetTuple(tuples_b[row]);
+  }
+  std::vector<logging::TupleRecord *> first_txn;
+  for (auto &record : insert_recs) {
+    first_txn.push_back(record.get());
+  }
+
+  // The second one deletes the first row of table a, and updates the second
+  // row of table b
+  logging::TupleRecord delete_rec(
+      LOGRECORD_TYPE_WAL_TUPLE_DELETE, test_commit_id + 1, table_a->GetOid(),
+      INVALID_ITEMPOINTER, ItemPointer(tile_group_a, 0), nullptr,
+      DEFAULT_DB_ID);
+  logging::TupleRecord update_rec(
+      LOGRECORD_TYPE_WAL_TUPLE_UPDATE, test_commit_id + 1, table_b->GetOid(),
+      ItemPointer(tile_group_b, num_rows), ItemPointer(tile_group_b, 1),
+      new_tuples_b[1], DEFAULT_DB_ID);
+  update_rec.SetTuple(new_tuples_b[1]);
+
+  ResetLogDirectory();
+  FILE *fp = CreateLogFile(0);
+  WriteCommittedTransaction(fp, test_commit_id, first_txn);
+  WriteCommittedTransaction(fp, test_commit_id + 1, {&delete_rec, &update_rec});
+  fclose(fp);
+  RecoverFromLog(test_commit_id + 1);
+
+  EXPECT_EQ(table_a->GetTupleCount(), num_rows - 1);
+  EXPECT_EQ(table_b->GetTupleCount(), num_rows);
+
+  auto tg_a = table_a->GetTileGroupById(tile_group_a);
+  auto tg_b = table_b->GetTileGroupById(tile_group_b);
+  EXPECT_EQ(tg_a->GetHeader()->GetEndCommitId(0), test_commit_id + 1);
+  EXPECT_EQ(tg_b->GetHeader()->GetEndCommitId(1), test_commit_id + 1);
+  EXPECT_EQ(tg_b->GetHeader()->GetEndCommitId(num_rows), MAX_CID);
+  for (int row = 1; row < num_rows; row++) {
+    EXPECT_EQ(tg_a->GetHeader()->GetEndCommitId(row), MAX_CID);
+    type::CmpBool cmp =
+        tuples_a[row]->GetValue(0).CompareEquals(tg_a->GetValue(row, 0));
+    EXPECT_TRUE(cmp == type::CMP_TRUE);
+    cmp = tuples_b[row]->GetValue(0).CompareEquals(tg_b->GetValue(row, 0));
+    EXPECT_TRUE(cmp == type::CMP_TRUE);
+  }
+  type::CmpBool cmp =
+      new_tuples_b[1]->GetValue(0).CompareEquals(tg_b->GetValue(num_rows, 0));
+  EXPECT_TRUE(cmp == type::CMP_TRUE);
+
+  logging::LoggingUtil::RemoveDirectory(
+      logging::WriteAheadFrontendLogger::wal_directory_path, false);
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  catalog->DropDatabaseWithOid(DEFAULT_DB_ID, txn);
+  txn_manager.CommitTransaction(txn);
+
+  thread_pool.Shutdown();
+}
+
+TEST_F(RecoveryTests, TornRecordTest) {
+  auto recovery_table = TestingExecutorUtil::CreateTable(1024);
+  auto catalog = catalog::Catalog::GetInstance();
+  storage::Database *db = new storage::Database(DEFAULT_DB_ID);
+  catalog->AddDatabase(db);
+  db->AddTable(recovery_table);
+
+  auto tuples = BuildLoggingTuples(recovery_table, 2, false, false);
+  cid_t test_commit_id = 10;
+
+  logging::TupleRecord first_rec(
+      LOGRECORD_TYPE_WAL_TUPLE_INSERT, test_commit_id, recovery_table->GetOid(),
+      ItemPointer(100, 0), INVALID_ITEMPOINTER, tuples[0], DEFAULT_DB_ID);
+  first_rec.SetTuple(tuples[0]);
+  logging::TupleRecord second_rec(
+      LOGRECORD_TYPE_WAL_TUPLE_INSERT, test_commit_id + 1,
+      recovery_table->GetOid(), ItemPointer(100, 1), INVALID_ITEMPOINTER,
+      tuples[1], DEFAULT_DB_ID);
+  second_rec.SetTuple(tuples[1]);
+
+  // The commit record of the second transaction is torn, so the log ends
+  // right before it
+  ResetLogDirectory();
+  FILE *fp = CreateLogFile(0);
+  WriteCommittedTransaction(fp, test_commit_id, {&first_rec});
+  logging::TransactionRecord record_begin(LOGRECORD_TYPE_TRANSACTION_BEGIN,
+                                          test_commit_id + 1);
+  WriteLogRecord(fp, record_begin);
+  WriteLogRecord(fp, second_rec);
+  logging::TransactionRecord record_commit(LOGRECORD_TYPE_TRANSACTION_COMMIT,
+                                           test_commit_id + 1);
+  WriteLogRecord(fp, record_commit, 3);
+  fclose(fp);
+  RecoverFromLog(test_commit_id + 1);
+
+  // Only the first transaction is replayed
+  auto tg_header = recovery_table->GetTileGroupById(100)->GetHeader();
+  EXPECT_TRUE(tg_header->GetBeginCommitId(0) <= test_commit_id);
+  EXPECT_EQ(tg_header->GetEndCommitId(0), MAX_CID);
+  EXPECT_EQ(tg_header->GetBeginCommitId(1), MAX_CID);
+  EXPECT_EQ(recovery_table->GetTupleCount(), 1);
+
+  logging::LoggingUtil::RemoveDirectory(
+      logging::WriteAheadFrontendLogger::wal_directory_path, false);
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  catalog->DropDatabaseWithOid(DEFAULT_DB_ID, txn);
+  txn_manager.CommitTransaction(txn);
 }
 
 }  // End test namespace
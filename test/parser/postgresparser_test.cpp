@@ -679,6 +679,21 @@ TEST_F(PostgresParserTests, CreateIndexTest) {
   EXPECT_TRUE(create_stmt->unique);
   EXPECT_EQ("o_w_id", std::string(create_stmt->index_attrs->at(0)));
   EXPECT_EQ("o_d_id", std::string(create_stmt->index_attrs->at(1)));
+  EXPECT_EQ(IndexType::BWTREE, create_stmt->index_type);
+
+  delete stmt_list;
+
+  // USING HASH picks the hash index
+  query = "CREATE INDEX IDX_CUSTOMER ON customer USING HASH (C_ID);";
+
+  stmt_list = parser.BuildParseTree(query).release();
+  EXPECT_TRUE(stmt_list->is_valid);
+  create_stmt = (parser::CreateStatement *)stmt_list->GetStatement(0);
+  EXPECT_EQ(parser::CreateStatement::kIndex, create_stmt->type);
+  EXPECT_EQ("idx_customer", std::string(create_stmt->index_name));
+  EXPECT_FALSE(create_stmt->unique);
+  EXPECT_EQ("c_id", std::string(create_stmt->index_attrs->at(0)));
+  EXPECT_EQ(IndexType::HASH, create_stmt->index_type);
 
   delete stmt_list;
 }
@@ -364,10 +364,64 @@ static void TestIndexPerformance(const IndexType &index_type) {
   return;
 }
 
+/*
+ * InsertScalabilityTest() - Compares insert throughput of index types
+ *
+ * For each thread count, every index type gets a fresh index and the same
+ * interleaved insert workload (InsertTest2), which has the highest
+ * contention. Throughput is reported in million inserts per second.
+ */
+static void InsertScalabilityTest(const std::vector<IndexType> &index_types,
+                                  const std::vector<size_t> &thread_counts) {
+  // Total number of keys inserted per run, independent of thread count
+  size_t total_key = 1024 * 1024;
+
+  Timer<> timer;
+
+  for (auto num_thread : thread_counts) {
+    size_t num_key = total_key / num_thread;
+
+    for (auto index_type : index_types) {
+      std::vector<ItemPointer *> location_ptrs;
+      std::unique_ptr<index::Index> index(BuildIndex(false, index_type));
+
+      timer.Reset();
+      timer.Start();
+
+      LaunchParallelTest(num_thread, InsertTest2, index.get(), num_thread,
+                         num_key);
+
+      timer.Stop();
+
+      index->ScanAllKeys(location_ptrs);
+      EXPECT_EQ(num_thread * num_key, location_ptrs.size());
+
+      LOG_INFO("InsertScalability :: Type=%s; Threads=%lu; Duration=%.2lf; "
+               "Throughput=%.2lf M/s",
+               IndexTypeToString(index_type).c_str(), num_thread,
+               timer.GetDuration(),
+               (num_thread * num_key) / timer.GetDuration() / 1000000);
+
+      delete tuple_schema;
+    }
+  }
+
+  return;
+}
+
 TEST_F(IndexPerformanceTests, BwTreeMultiThreadedTest) {
   TestIndexPerformance(IndexType::BWTREE);
 }
 
+TEST_F(IndexPerformanceTests, SkipListMultiThreadedTest) {
+  TestIndexPerformance(IndexType::SKIPLIST);
+}
+
+TEST_F(IndexPerformanceTests, InsertScalabilityTest) {
+  InsertScalabilityTest({IndexType::BWTREE, IndexType::SKIPLIST},
+                        {1, 4, 8, 16, 32, 48});
+}
+
 // TEST_F(IndexPerformanceTests, BTreeMultiThreadedTest) {
 //  TestIndexPerformance(IndexType::BTREE);
 //}
@@ -116,35 +116,59 @@ TEST_F(InsertPerformanceTests, LoadingTest) {
 
   LOG_INFO("Duration: %.2lf", duration);
 
-  auto expected_tile_group_count = 0;
-
-  int total_tuple_count = loader_threads_count * tilegroup_count_per_loader * TEST_TUPLES_PER_TILEGROUP;
-  int max_cached_tuple_count = TEST_TUPLES_PER_TILEGROUP * storage::DataTable::default_active_tilegroup_count_;
-  int max_unfill_cached_tuple_count = (TEST_TUPLES_PER_TILEGROUP - 1) * storage::DataTable::default_active_tilegroup_count_;
-
-  if (total_tuple_count - max_cached_tuple_count <= 0) {
-    if (total_tuple_count <= max_unfill_cached_tuple_count) {
-      expected_tile_group_count = storage::DataTable::default_active_tilegroup_count_;
-    } else {
-      expected_tile_group_count = storage::DataTable::default_active_tilegroup_count_ + total_tuple_count - max_unfill_cached_tuple_count; 
-    }
-  } else {
-    int filled_tile_group_count = total_tuple_count / max_cached_tuple_count * storage::DataTable::default_active_tilegroup_count_;
-    
-    if (total_tuple_count - filled_tile_group_count * TEST_TUPLES_PER_TILEGROUP - max_unfill_cached_tuple_count <= 0) {
-      expected_tile_group_count = filled_tile_group_count + storage::DataTable::default_active_tilegroup_count_;
-    } else {
-      expected_tile_group_count = filled_tile_group_count + storage::DataTable::default_active_tilegroup_count_ + (total_tuple_count - filled_tile_group_count - max_unfill_cached_tuple_count); 
-    }
-  }
+  // every tile group but the active ones is full
+  size_t total_tuple_count = loader_threads_count * tilegroup_count_per_loader *
+                             TEST_TUPLES_PER_TILEGROUP;
+  size_t active_tile_group_count =
+      storage::DataTable::default_active_tilegroup_count_;
+  size_t full_tile_group_count = data_table->GetTileGroupCount() -
+                                 active_tile_group_count;
 
   UNUSED_ATTRIBUTE auto bytes_to_megabytes_converter = (1024 * 1024);
 
-  EXPECT_EQ(data_table->GetTileGroupCount(), expected_tile_group_count);
+  EXPECT_EQ(total_tuple_count, data_table->GetTupleCount());
+  EXPECT_LE(full_tile_group_count * TEST_TUPLES_PER_TILEGROUP,
+            total_tuple_count);
+  EXPECT_GE(full_tile_group_count * TEST_TUPLES_PER_TILEGROUP +
+                active_tile_group_count * (TEST_TUPLES_PER_TILEGROUP - 1),
+            total_tuple_count);
+
+  LOG_INFO("Dataset size : %lu MB \n",
+           (data_table->GetTileGroupCount() * tuples_per_tilegroup *
+            tuple_size) / bytes_to_megabytes_converter);
+}
+
+TEST_F(InsertPerformanceTests, ScalingTest) {
+  // Every loader inserts into its own active tile group, so the throughput
+  // should grow with the number of loaders up to the number of cores
+  oid_t tilegroup_count_per_loader = 100;
+  size_t original_active_tile_group_count =
+      storage::DataTable::default_active_tilegroup_count_;
+  auto testing_pool = TestingHarness::GetInstance().GetTestingPool();
+
+  for (oid_t loader_threads_count = 1; loader_threads_count <= 32;
+       loader_threads_count *= 2) {
+    storage::DataTable::SetActiveTileGroupCount(loader_threads_count);
+    std::unique_ptr<storage::DataTable> data_table(
+        TestingExecutorUtil::CreateTable(TEST_TUPLES_PER_TILEGROUP, false));
+
+    Timer<> timer;
+    timer.Start();
+    LaunchParallelTest(loader_threads_count, InsertTuple, data_table.get(),
+                       testing_pool, tilegroup_count_per_loader);
+    timer.Stop();
+
+    size_t total_tuple_count = loader_threads_count *
+                               tilegroup_count_per_loader *
+                               TEST_TUPLES_PER_TILEGROUP;
+    EXPECT_EQ(total_tuple_count, data_table->GetTupleCount());
+    LOG_INFO("Loaders: %u, Throughput: %.2lf K inserts/s",
+             loader_threads_count,
+             total_tuple_count / timer.GetDuration() / 1000);
+  }
 
-  LOG_INFO("Dataset size : %u MB \n",
-           (expected_tile_group_count * tuples_per_tilegroup * tuple_size) /
-               bytes_to_megabytes_converter);
+  storage::DataTable::SetActiveTileGroupCount(
+      original_active_tile_group_count);
 }
 
 }  // namespace test
@@ -0,0 +1,112 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// lock_free_array_performance_test.cpp
+//
+// Identification: test/performance/lock_free_array_performance_test.cpp
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <atomic>
+#include <memory>
+
+#include "common/harness.h"
+#include "common/timer.h"
+#include "container/lock_free_array.h"
+
+namespace peloton {
+
+namespace storage {
+class TileGroup;
+}
+
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// LockFreeArray Performance Tests
+//===--------------------------------------------------------------------===//
+
+class LockFreeArrayPerformanceTests : public PelotonTest {};
+
+// The number of tile groups a large deployment may reach
+static const size_t tile_group_count = 10 * 1000 * 1000;
+
+void AppendTileGroupIds(LockFreeArray<oid_t> *array, size_t count_per_thread,
+                        uint64_t thread_itr) {
+  for (size_t itr = 0; itr < count_per_thread; itr++) {
+    array->Append(thread_itr * count_per_thread + itr);
+  }
+}
+
+// 7919 is coprime with tile_group_count, so the threads together visit every
+// position once, in a scattered order
+void FindTileGroupIds(LockFreeArray<oid_t> *array, size_t count_per_thread,
+                      std::atomic<uint64_t> *total, uint64_t thread_itr) {
+  uint64_t sum = 0;
+  for (size_t itr = 0; itr < count_per_thread; itr++) {
+    sum += array->Find((thread_itr * count_per_thread + itr) * 7919 %
+                       tile_group_count);
+  }
+  *total += sum;
+}
+
+TEST_F(LockFreeArrayPerformanceTests, AppendFindTest) {
+  size_t thread_count = 4;
+  size_t count_per_thread = tile_group_count / thread_count;
+
+  LockFreeArray<oid_t> array;
+  Timer<> timer;
+
+  timer.Start();
+  LaunchParallelTest(thread_count, AppendTileGroupIds, &array,
+                     count_per_thread);
+  timer.Stop();
+  EXPECT_EQ(tile_group_count, array.GetSize());
+  LOG_INFO("Append: %.2lf M/s",
+           tile_group_count / timer.GetDuration() / 1000000);
+
+  timer.Reset();
+  timer.Start();
+  std::atomic<uint64_t> total(0);
+  LaunchParallelTest(thread_count, FindTileGroupIds, &array,
+                     count_per_thread, &total);
+  timer.Stop();
+  // the appended ids are 0 .. tile_group_count - 1, each found once
+  EXPECT_EQ(tile_group_count * (tile_group_count - 1) / 2, total.load());
+  LOG_INFO("Find: %.2lf M/s",
+           tile_group_count / timer.GetDuration() / 1000000);
+
+  LOG_INFO("Footprint of %lu tile group ids: %.2lf MB", tile_group_count,
+           array.GetMemoryFootprint() / 1024.0 / 1024.0);
+  // the capacity at most doubles the number of entries
+  EXPECT_LE(array.GetMemoryFootprint(), 2 * tile_group_count * sizeof(oid_t));
+}
+
+TEST_F(LockFreeArrayPerformanceTests, LocatorFootprintTest) {
+  // the locator of the catalog is indexed by tile group id, and a table
+  // with few tile groups only allocates the first segment
+  LockFreeArray<std::shared_ptr<storage::TileGroup>> small_locator;
+  small_locator.Update(1, nullptr);
+  LOG_INFO("Footprint of a small locator: %lu B",
+           small_locator.GetMemoryFootprint());
+  EXPECT_LE(small_locator.GetMemoryFootprint(),
+            64 * sizeof(std::shared_ptr<storage::TileGroup>));
+
+  LockFreeArray<std::shared_ptr<storage::TileGroup>> locator;
+  Timer<> timer;
+  timer.Start();
+  for (size_t itr = 0; itr < tile_group_count; itr++) {
+    locator.Update(itr, nullptr);
+  }
+  timer.Stop();
+  LOG_INFO("Update: %.2lf M/s",
+           tile_group_count / timer.GetDuration() / 1000000);
+  LOG_INFO("Footprint of a locator of %lu tile groups: %.2lf MB",
+           tile_group_count, locator.GetMemoryFootprint() / 1024.0 / 1024.0);
+}
+
+}  // End test namespace
+}  // End peloton namespace
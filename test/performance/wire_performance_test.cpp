@@ -0,0 +1,125 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// wire_performance_test.cpp
+//
+// Identification: test/performance/wire_performance_test.cpp
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <arpa/inet.h>
+#include <libpq-fe.h> /* libpq is used to ask for binary results */
+
+#include "common/harness.h"
+#include "common/logger.h"
+#include "common/timer.h"
+#include "util/string_util.h"
+#include "wire/libevent_server.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Wire Performance Tests
+//===--------------------------------------------------------------------===//
+
+class WirePerformanceTests : public PelotonTest {};
+
+static const size_t wire_row_count = 10000;
+static const size_t wire_select_count = 10;
+
+static void *LaunchServer(peloton::wire::LibeventServer libeventserver,
+                          int port) {
+  try {
+    libeventserver.SetPort(port);
+    libeventserver.StartServer();
+  } catch (peloton::ConnectionException &exception) {
+    LOG_INFO("[LaunchServer] exception in thread");
+  }
+  return NULL;
+}
+
+// Select the whole table in the given result format, returns rows/sec
+static double SelectRows(PGconn *conn, int result_format) {
+  size_t row_count = 0;
+  Timer<> timer;
+  timer.Start();
+  for (size_t select_itr = 0; select_itr < wire_select_count; select_itr++) {
+    PGresult *result =
+        PQexecParams(conn, "SELECT a, b, c FROM wire_perf;", 0, nullptr,
+                     nullptr, nullptr, nullptr, result_format);
+    EXPECT_EQ(PGRES_TUPLES_OK, PQresultStatus(result));
+    row_count += PQntuples(result);
+
+    // the rows decode the same in both formats
+    if (PQntuples(result) > 0) {
+      EXPECT_EQ(result_format, PQfformat(result, 0));
+      int32_t a;
+      if (result_format == 0) {
+        a = std::stoi(PQgetvalue(result, 0, 0));
+      } else {
+        EXPECT_EQ(4, PQgetlength(result, 0, 0));
+        PL_MEMCPY(&a, PQgetvalue(result, 0, 0), sizeof(a));
+        a = ntohl(a);
+      }
+      EXPECT_LE(0, a);
+      EXPECT_GT((int32_t)wire_row_count, a);
+    }
+    PQclear(result);
+  }
+  timer.Stop();
+
+  EXPECT_EQ(wire_row_count * wire_select_count, row_count);
+  return row_count / timer.GetDuration();
+}
+
+TEST_F(WirePerformanceTests, ResultFormatTest) {
+  peloton::PelotonInit::Initialize();
+  peloton::wire::LibeventServer libeventserver;
+  int port = 15731;
+  std::thread serverThread(LaunchServer, libeventserver, port);
+  while (!libeventserver.GetIsStarted()) {
+    sleep(1);
+  }
+
+  PGconn *conn = PQconnectdb(
+      StringUtil::Format(
+          "host=127.0.0.1 port=%d user=postgres sslmode=disable", port)
+          .c_str());
+  ASSERT_EQ(CONNECTION_OK, PQstatus(conn));
+
+  PQclear(PQexec(conn, "DROP TABLE IF EXISTS wire_perf;"));
+  PQclear(
+      PQexec(conn, "CREATE TABLE wire_perf(a INT, b BIGINT, c DECIMAL);"));
+
+  // Load the table, a batch of inserts per query
+  const size_t batch_size = 100;
+  for (size_t row_itr = 0; row_itr < wire_row_count; row_itr += batch_size) {
+    std::string query;
+    for (size_t batch_itr = row_itr; batch_itr < row_itr + batch_size;
+         batch_itr++) {
+      query += StringUtil::Format(
+          "INSERT INTO wire_perf VALUES (%lu, %lu, %lu.5);", batch_itr,
+          batch_itr * 1000000007, batch_itr);
+    }
+    PGresult *result = PQexec(conn, query.c_str());
+    EXPECT_EQ(PGRES_COMMAND_OK, PQresultStatus(result));
+    PQclear(result);
+  }
+
+  double text_rate = SelectRows(conn, 0);
+  double binary_rate = SelectRows(conn, 1);
+  LOG_INFO("Text results: %.0lf rows/sec", text_rate);
+  LOG_INFO("Binary results: %.0lf rows/sec", binary_rate);
+
+  PQfinish(conn);
+  libeventserver.CloseServer();
+  serverThread.join();
+  peloton::PelotonInit::Shutdown();
+}
+
+}  // namespace test
+}  // namespace peloton
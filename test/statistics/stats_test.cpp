@@ -194,6 +194,49 @@ TEST_F(StatsTests, MultiThreadStatsTest) {
   catalog->DropDatabaseWithName("emp_db", txn);
   txn_manager.CommitTransaction(txn);
 }
+
+TEST_F(StatsTests, ConnectionMetricTest) {
+  // the counters are allocated for every worker when the context is created
+  size_t old_thread_count = CONNECTION_THREAD_COUNT;
+  CONNECTION_THREAD_COUNT = 3;
+
+  // the master dispatches, the worker picks up and serves the connections
+  stats::BackendStatsContext master_context(LATENCY_MAX_HISTORY_THREAD,
+                                            false);
+  stats::BackendStatsContext worker_context(LATENCY_MAX_HISTORY_THREAD,
+                                            false);
+  for (int i = 0; i < 3; i++) {
+    master_context.IncrementConnectionsDispatched(0);
+  }
+  master_context.IncrementConnectionsDispatched(1);
+  for (int i = 0; i < 2; i++) {
+    worker_context.IncrementConnectionsDequeued(0);
+    worker_context.IncrementConnectionsOpened(0);
+  }
+  worker_context.IncrementConnectionsClosed(0);
+
+  stats::BackendStatsContext aggregated_stats(LATENCY_MAX_HISTORY_AGGREGATOR,
+                                              false);
+  aggregated_stats.Aggregate(master_context);
+  aggregated_stats.Aggregate(worker_context);
+
+  auto &connection_metric = aggregated_stats.GetConnectionMetric();
+  EXPECT_EQ(1, connection_metric.GetActiveConnections(0));
+  EXPECT_EQ(1, connection_metric.GetQueueDepth(0));
+  EXPECT_EQ(0, connection_metric.GetActiveConnections(1));
+  EXPECT_EQ(1, connection_metric.GetQueueDepth(1));
+  EXPECT_EQ(0, connection_metric.GetQueueDepth(2));
+
+  // workers beyond the configured count are not tracked
+  master_context.IncrementConnectionsDispatched(3);
+  EXPECT_EQ(0, master_context.GetConnectionMetric().GetQueueDepth(3));
+
+  aggregated_stats.Reset();
+  EXPECT_EQ(1, master_context.GetConnectionMetric().GetQueueDepth(1));
+  EXPECT_EQ(0, connection_metric.GetQueueDepth(1));
+
+  CONNECTION_THREAD_COUNT = old_thread_count;
+}
 //
 // TEST_F(StatsTests, PerThreadStatsTest) {
 //  FLAGS_stats_mode = STATS_TYPE_ENABLE;
@@ -15,10 +15,13 @@
 #include "storage/data_table.h"
 
 #include "executor/testing_executor_util.h"
+#include "storage/tile.h"
 #include "storage/tile_group.h"
 #include "storage/database.h"
 
+#include "concurrency/epoch_manager_factory.h"
 #include "concurrency/transaction_manager_factory.h"
+#include "configuration/configuration.h"
 
 namespace peloton {
 namespace test {
@@ -41,35 +44,201 @@ TEST_F(DataTableTests, TransformTileGroupTest) {
                                    true, txn);
   txn_manager.CommitTransaction(txn);
 
+  // Find the tile group filled by the inserts
+  oid_t tile_group_offset = 0;
+  while (data_table->GetTileGroup(tile_group_offset)->GetNextTupleSlot() !=
+         tuple_count) {
+    tile_group_offset++;
+  }
+  auto tile_group = data_table->GetTileGroup(tile_group_offset);
+
   // Create the new column map
   storage::column_map_type column_map;
   column_map[0] = std::make_pair(0, 0);
   column_map[1] = std::make_pair(0, 1);
   column_map[2] = std::make_pair(1, 0);
   column_map[3] = std::make_pair(1, 1);
+  data_table->SetDefaultLayout(column_map);
 
   auto theta = 0.0;
 
-  // Transform the tile group
-  data_table->TransformTileGroup(0, theta);
+  // The first transformation makes the cold tile group immutable
+  EXPECT_EQ(nullptr, data_table->TransformTileGroup(tile_group_offset, theta));
+  EXPECT_TRUE(tile_group->GetHeader()->IsImmutable());
+  EXPECT_EQ(nullptr, data_table->TransformTileGroup(tile_group_offset, theta));
+
+  // The tile group is transformed once the running transactions have ended
+  auto &epoch_manager = concurrency::EpochManagerFactory::GetInstance();
+  epoch_manager.Reset((epoch_manager.GetCurrentEpochCommitId() >> 32) + 2);
+  auto new_tile_group =
+      data_table->TransformTileGroup(tile_group_offset, theta);
+  ASSERT_NE(nullptr, new_tile_group);
+  EXPECT_EQ(column_map, new_tile_group->GetColumnMap());
+  EXPECT_EQ(tile_group->GetHeader(), new_tile_group->GetHeader());
+  EXPECT_EQ(new_tile_group, data_table->GetTileGroup(tile_group_offset).get());
+
+  for (oid_t tuple_itr = 0; tuple_itr < tuple_count; tuple_itr++) {
+    for (oid_t column_itr = 0; column_itr < column_map.size(); column_itr++) {
+      EXPECT_TRUE(new_tile_group->GetValue(tuple_itr, column_itr)
+                      .CompareEquals(tile_group->GetValue(
+                          tuple_itr, column_itr)) == type::CMP_TRUE);
+    }
+  }
+
+  // The copy is thawed once no transaction can read the original
+  EXPECT_EQ(nullptr, data_table->TransformTileGroup(tile_group_offset, 1.1));
+  EXPECT_TRUE(new_tile_group->GetHeader()->IsImmutable());
+  epoch_manager.Reset((epoch_manager.GetCurrentEpochCommitId() >> 32) + 2);
+  EXPECT_EQ(nullptr, data_table->TransformTileGroup(tile_group_offset, 1.1));
+  EXPECT_FALSE(new_tile_group->GetHeader()->IsImmutable());
 
   // Create the another column map
   column_map[0] = std::make_pair(0, 0);
   column_map[1] = std::make_pair(0, 1);
   column_map[2] = std::make_pair(0, 2);
   column_map[3] = std::make_pair(1, 0);
+  data_table->SetDefaultLayout(column_map);
 
-  // Transform the tile group
-  data_table->TransformTileGroup(0, theta);
+  // The tile group is frozen and copied again
+  EXPECT_EQ(nullptr, data_table->TransformTileGroup(tile_group_offset, theta));
+  epoch_manager.Reset((epoch_manager.GetCurrentEpochCommitId() >> 32) + 2);
+  new_tile_group = data_table->TransformTileGroup(tile_group_offset, theta);
+  ASSERT_NE(nullptr, new_tile_group);
+  EXPECT_EQ(column_map, new_tile_group->GetColumnMap());
 
-  // Create the another column map
-  column_map[0] = std::make_pair(0, 0);
-  column_map[1] = std::make_pair(1, 0);
-  column_map[2] = std::make_pair(1, 1);
-  column_map[3] = std::make_pair(1, 2);
+  // A transformation that is no longer needed thaws the frozen tile group
+  epoch_manager.Reset((epoch_manager.GetCurrentEpochCommitId() >> 32) + 2);
+  EXPECT_EQ(nullptr, data_table->TransformTileGroup(tile_group_offset, 1.1));
+  EXPECT_FALSE(new_tile_group->GetHeader()->IsImmutable());
+  EXPECT_EQ(nullptr, data_table->TransformTileGroup(tile_group_offset, theta));
+  EXPECT_TRUE(new_tile_group->GetHeader()->IsImmutable());
+  epoch_manager.Reset((epoch_manager.GetCurrentEpochCommitId() >> 32) + 2);
+  EXPECT_EQ(nullptr, data_table->TransformTileGroup(tile_group_offset, 1.1));
+  EXPECT_FALSE(new_tile_group->GetHeader()->IsImmutable());
+
+  EXPECT_EQ(2, data_table->GetTransformedTileGroupCount());
+  // The scans of the default layout read no more than before
+  EXPECT_GE(data_table->GetTransformScanBytesRatio(), 1.0);
+}
+
+class DataTableCompressionTests : public PelotonTest {
+ protected:
+  virtual void SetUp() override {
+    // Call parent virtual function first
+    PelotonTest::SetUp();
+
+    compress_frozen_tile_groups_ = FLAGS_compress_frozen_tile_groups;
+    FLAGS_compress_frozen_tile_groups = true;
+  }
+
+  virtual void TearDown() override {
+    // Restore the flag, even when an assertion failed
+    FLAGS_compress_frozen_tile_groups = compress_frozen_tile_groups_;
+
+    // Call parent virtual function
+    PelotonTest::TearDown();
+  }
+
+  bool compress_frozen_tile_groups_;
+};
+
+TEST_F(DataTableCompressionTests, CompressTileGroupTest) {
+  const int tuple_count = TESTS_TUPLES_PER_TILEGROUP;
+
+  // Create a table whose varlen column has duplicated values
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  std::unique_ptr<storage::DataTable> data_table(
+      TestingExecutorUtil::CreateTable(tuple_count, false));
+  TestingExecutorUtil::PopulateTable(data_table.get(), tuple_count, false, true,
+                                   true, txn);
+  txn_manager.CommitTransaction(txn);
+
+  oid_t tile_group_offset = 0;
+  while (data_table->GetTileGroup(tile_group_offset)->GetNextTupleSlot() !=
+         tuple_count) {
+    tile_group_offset++;
+  }
+  auto tile_group = data_table->GetTileGroup(tile_group_offset);
+  auto column_map = tile_group->GetColumnMap();
+  data_table->SetDefaultLayout(column_map);
+
+  // The tile group is close enough to the default layout, but is still copied
+  // to be compressed
+  auto theta = 1.0;
+  EXPECT_EQ(nullptr, data_table->TransformTileGroup(tile_group_offset, theta));
+  auto &epoch_manager = concurrency::EpochManagerFactory::GetInstance();
+  epoch_manager.Reset((epoch_manager.GetCurrentEpochCommitId() >> 32) + 2);
+  auto new_tile_group =
+      data_table->TransformTileGroup(tile_group_offset, theta);
+  ASSERT_NE(nullptr, new_tile_group);
+  EXPECT_TRUE(new_tile_group->IsCompressed());
+
+  // The integer columns are packed in tiles of their own, the decimal and
+  // varchar columns are not
+  auto compressed_column_map = new_tile_group->GetColumnMap();
+  for (oid_t column_itr = 0; column_itr < column_map.size(); column_itr++) {
+    oid_t tile_offset, tile_column_offset;
+    new_tile_group->LocateTileAndColumn(column_itr, tile_offset,
+                                        tile_column_offset);
+    auto tile = new_tile_group->GetTile(tile_offset);
+    bool is_integer = column_itr < 2;
+    EXPECT_EQ(is_integer, tile->IsPacked());
+    if (is_integer == true) {
+      EXPECT_EQ(1, tile->GetColumnCount());
+      EXPECT_LT(tile->GetInlinedSize(), tuple_count * sizeof(int32_t));
+    }
+  }
+
+  for (oid_t tuple_itr = 0; tuple_itr < tuple_count; tuple_itr++) {
+    for (oid_t column_itr = 0; column_itr < column_map.size(); column_itr++) {
+      EXPECT_TRUE(new_tile_group->GetValue(tuple_itr, column_itr)
+                      .CompareEquals(tile_group->GetValue(
+                          tuple_itr, column_itr)) == type::CMP_TRUE);
+    }
+  }
+
+  // A compressed tile group in the default layout is left alone, and stays
+  // frozen
+  epoch_manager.Reset((epoch_manager.GetCurrentEpochCommitId() >> 32) + 2);
+  EXPECT_EQ(nullptr, data_table->TransformTileGroup(tile_group_offset, theta));
+  EXPECT_TRUE(new_tile_group->GetHeader()->IsImmutable());
+
+  // A tuple is deleted, so the compressed tile group is replaced by a plain
+  // copy
+  auto header = new_tile_group->GetHeader();
+  header->SetEndCommitId(0, header->GetBeginCommitId(0) + 1);
+  auto plain_tile_group =
+      data_table->TransformTileGroup(tile_group_offset, theta);
+  ASSERT_NE(nullptr, plain_tile_group);
+  EXPECT_FALSE(plain_tile_group->IsCompressed());
+  EXPECT_EQ(header, plain_tile_group->GetHeader());
+  EXPECT_EQ(compressed_column_map, plain_tile_group->GetColumnMap());
+  for (oid_t tile_itr = 0; tile_itr < plain_tile_group->GetTileCount();
+       tile_itr++) {
+    EXPECT_FALSE(plain_tile_group->GetTile(tile_itr)->IsPacked());
+  }
+
+  for (oid_t tuple_itr = 0; tuple_itr < tuple_count; tuple_itr++) {
+    for (oid_t column_itr = 0; column_itr < column_map.size(); column_itr++) {
+      EXPECT_TRUE(plain_tile_group->GetValue(tuple_itr, column_itr)
+                      .CompareEquals(tile_group->GetValue(
+                          tuple_itr, column_itr)) == type::CMP_TRUE);
+    }
+  }
+
+  // The plain copy is thawed once no transaction can read the compressed one
+  EXPECT_EQ(nullptr, data_table->TransformTileGroup(tile_group_offset, theta));
+  EXPECT_TRUE(header->IsImmutable());
+  epoch_manager.Reset((epoch_manager.GetCurrentEpochCommitId() >> 32) + 2);
+  EXPECT_EQ(nullptr, data_table->TransformTileGroup(tile_group_offset, theta));
+  EXPECT_FALSE(header->IsImmutable());
 
-  // Transform the tile group
-  data_table->TransformTileGroup(0, theta);
+  EXPECT_EQ(0, data_table->GetTransformedTileGroupCount());
+  EXPECT_EQ(1, data_table->GetCompressedTileGroupCount());
+  EXPECT_EQ(1, data_table->GetDecompressedTileGroupCount());
+  EXPECT_LT(1.0, data_table->GetCompressionRatio());
+  LOG_INFO("Compression ratio: %.2lf", data_table->GetCompressionRatio());
 }
 
 std::unique_ptr<storage::DataTable> data_table_test_table;
@@ -0,0 +1,106 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// packed_column_test.cpp
+//
+// Identification: test/storage/packed_column_test.cpp
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <cstring>
+#include <vector>
+
+#include "common/harness.h"
+
+#include "storage/packed_column.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Packed Column Tests
+//===--------------------------------------------------------------------===//
+
+class PackedColumnTests : public PelotonTest {};
+
+TEST_F(PackedColumnTests, RoundTripTest) {
+  // Every stride of 7 bits makes the values straddle the words
+  const oid_t count = 100;
+  std::vector<int64_t> values;
+  for (oid_t slot = 0; slot < count; slot++) {
+    values.push_back(-1000000 + static_cast<int64_t>(slot * 37 % 101));
+  }
+
+  auto column =
+      storage::PackedColumn::Pack(reinterpret_cast<const char *>(values.data()),
+                                  sizeof(int64_t), type::Type::BIGINT, count);
+  ASSERT_NE(nullptr, column);
+  EXPECT_EQ(-1000000, column->GetBase());
+  EXPECT_EQ(7, column->GetBits());
+  EXPECT_EQ((count * 7 + 63) / 64 + 1, column->GetSize() / sizeof(uint64_t));
+
+  for (oid_t slot = 0; slot < count; slot++) {
+    EXPECT_EQ(values[slot], column->GetValue(slot));
+
+    int64_t field = 0;
+    column->Unpack(slot, reinterpret_cast<char *>(&field));
+    EXPECT_EQ(values[slot], field);
+  }
+}
+
+TEST_F(PackedColumnTests, StrideTest) {
+  // The values of a row tile, an integer followed by a tinyint
+  const oid_t count = 10;
+  const size_t stride = sizeof(int32_t) + sizeof(int8_t);
+  std::vector<char> rows(count * stride);
+  for (oid_t slot = 0; slot < count; slot++) {
+    int32_t value = static_cast<int32_t>(slot) * 3 - 10;
+    int8_t other = -1;
+    std::memcpy(rows.data() + slot * stride, &value, sizeof(value));
+    std::memcpy(rows.data() + slot * stride + sizeof(value), &other,
+                sizeof(other));
+  }
+
+  auto column = storage::PackedColumn::Pack(rows.data(), stride,
+                                            type::Type::INTEGER, count);
+  ASSERT_NE(nullptr, column);
+  EXPECT_EQ(-10, column->GetBase());
+  EXPECT_EQ(5, column->GetBits());
+  for (oid_t slot = 0; slot < count; slot++) {
+    int32_t field = 0;
+    column->Unpack(slot, reinterpret_cast<char *>(&field));
+    EXPECT_EQ(static_cast<int32_t>(slot) * 3 - 10, field);
+  }
+
+  // All the values are the same, which takes a bit
+  auto other_column = storage::PackedColumn::Pack(
+      rows.data() + sizeof(int32_t), stride, type::Type::TINYINT, count);
+  ASSERT_NE(nullptr, other_column);
+  EXPECT_EQ(1, other_column->GetBits());
+  for (oid_t slot = 0; slot < count; slot++) {
+    EXPECT_EQ(-1, other_column->GetValue(slot));
+  }
+}
+
+TEST_F(PackedColumnTests, NotPackedTest) {
+  const oid_t count = 4;
+
+  // The range of the values takes all the bits of the type
+  std::vector<int16_t> wide_values = {INT16_MIN + 1, 0, 1, INT16_MAX};
+  EXPECT_EQ(nullptr, storage::PackedColumn::Pack(
+                         reinterpret_cast<const char *>(wide_values.data()),
+                         sizeof(int16_t), type::Type::SMALLINT, count));
+
+  // Decimals are never packed
+  std::vector<double> decimals = {0.0, 1.0, 2.0, 3.0};
+  EXPECT_FALSE(storage::PackedColumn::IsPackable(type::Type::DECIMAL));
+  EXPECT_EQ(nullptr, storage::PackedColumn::Pack(
+                         reinterpret_cast<const char *>(decimals.data()),
+                         sizeof(double), type::Type::DECIMAL, count));
+}
+
+}  // End test namespace
+}  // End peloton namespace
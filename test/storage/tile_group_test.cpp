@@ -543,5 +543,87 @@ TEST_F(TileGroupTests, TileCopyTest) {
   delete schema;
 }
 
+TEST_F(TileGroupTests, CopyVersionTest) {
+  catalog::Column column1(type::Type::INTEGER,
+                          type::Type::GetTypeSize(type::Type::INTEGER), "A",
+                          true);
+  catalog::Column column2(type::Type::VARCHAR, 25, "B", false);
+  catalog::Column column3(type::Type::VARCHAR, 25, "C", false);
+  catalog::Column column4(type::Type::INTEGER,
+                          type::Type::GetTypeSize(type::Type::INTEGER), "D",
+                          true);
+
+  // two tiles in the first tile group, one tile in the second
+  std::vector<catalog::Schema> schemas;
+  schemas.push_back(catalog::Schema({column1, column2}));
+  schemas.push_back(catalog::Schema({column3, column4}));
+  storage::column_map_type column_map;
+  column_map[0] = std::make_pair(0, 0);
+  column_map[1] = std::make_pair(0, 1);
+  column_map[2] = std::make_pair(1, 0);
+  column_map[3] = std::make_pair(1, 1);
+
+  std::vector<catalog::Schema> row_schemas;
+  row_schemas.push_back(catalog::Schema({column1, column2, column3, column4}));
+  storage::column_map_type row_column_map;
+  for (oid_t col_itr = 0; col_itr < 4; col_itr++) {
+    row_column_map[col_itr] = std::make_pair(0, col_itr);
+  }
+
+  std::unique_ptr<storage::TileGroup> tile_group(
+      storage::TileGroupFactory::GetTileGroup(
+          INVALID_OID, INVALID_OID,
+          TestingHarness::GetInstance().GetNextTileGroupId(), nullptr, schemas,
+          column_map, 4));
+  std::unique_ptr<storage::TileGroup> row_tile_group(
+      storage::TileGroupFactory::GetTileGroup(
+          INVALID_OID, INVALID_OID,
+          TestingHarness::GetInstance().GetNextTileGroupId(), nullptr,
+          row_schemas, row_column_map, 4));
+
+  std::unique_ptr<catalog::Schema> schema(
+      new catalog::Schema({column1, column2, column3, column4}));
+  storage::Tuple tuple(schema.get(), true);
+  auto pool = tile_group->GetTilePool(1);
+  tuple.SetValue(0, type::ValueFactory::GetIntegerValue(1), pool);
+  tuple.SetValue(1, type::ValueFactory::GetVarcharValue("ming fang"), pool);
+  tuple.SetValue(2, type::ValueFactory::GetVarcharValue("jinwoong kim"), pool);
+  tuple.SetValue(3, type::ValueFactory::GetIntegerValue(2), pool);
+
+  auto old_slot = tile_group->InsertTuple(&tuple);
+
+  // a version in the same tile group shares both varlen columns
+  auto new_slot = tile_group->InsertTuple(nullptr);
+  tile_group->CopyVersion(tile_group.get(), old_slot, new_slot);
+  EXPECT_EQ(0b110ul, tile_group->GetSharedVarlenColumns(
+                       new_slot, tile_group.get(), old_slot));
+  for (oid_t col_itr = 0; col_itr < 4; col_itr++) {
+    EXPECT_TRUE(tile_group->GetValue(new_slot, col_itr)
+                    .CompareEquals(tuple.GetValue(col_itr)) ==
+                type::CMP_TRUE);
+  }
+
+  // an updated column gets its own data
+  auto value = type::ValueFactory::GetVarcharValue("vivek sengupta");
+  tile_group->SetValue(value, new_slot, 2);
+  EXPECT_EQ(0b010ul, tile_group->GetSharedVarlenColumns(
+                       new_slot, tile_group.get(), old_slot));
+
+  // a version in a tile group with another layout
+  auto row_slot = row_tile_group->InsertTuple(nullptr);
+  row_tile_group->CopyVersion(tile_group.get(), new_slot, row_slot);
+  EXPECT_EQ(0b110ul, row_tile_group->GetSharedVarlenColumns(
+                       row_slot, tile_group.get(), new_slot));
+  EXPECT_TRUE(row_tile_group->GetValue(row_slot, 2).CompareEquals(value) ==
+              type::CMP_TRUE);
+
+  // the new version takes over the data of the shared columns
+  row_tile_group->AdoptVarlenColumns(row_slot, tile_group.get(), 0b110);
+  EXPECT_EQ(0b110ul, row_tile_group->GetSharedVarlenColumns(
+                       row_slot, tile_group.get(), new_slot));
+  EXPECT_TRUE(row_tile_group->GetValue(row_slot, 1).CompareEquals(
+                  tuple.GetValue(1)) == type::CMP_TRUE);
+}
+
 }  // End test namespace
 }  // End peloton namespace
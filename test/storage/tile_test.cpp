@@ -103,5 +103,61 @@ TEST_F(TileTests, BasicTest) {
   delete schema;
 }
 
+TEST_F(TileTests, PackTest) {
+  std::vector<catalog::Column> columns = {
+      catalog::Column(type::Type::INTEGER,
+                      type::Type::GetTypeSize(type::Type::INTEGER), "A", true),
+      catalog::Column(type::Type::BIGINT,
+                      type::Type::GetTypeSize(type::Type::BIGINT), "B", true)};
+  catalog::Schema schema(columns);
+
+  const int tuple_count = 100;
+  storage::TileGroupHeader header(BackendType::MM, tuple_count);
+  std::unique_ptr<storage::Tile> tile(storage::TileFactory::GetTile(
+      BackendType::MM, INVALID_OID, INVALID_OID, INVALID_OID, INVALID_OID,
+      &header, schema, nullptr, tuple_count));
+  for (int tuple_itr = 0; tuple_itr < tuple_count; tuple_itr++) {
+    tile->SetValue(type::ValueFactory::GetIntegerValue(tuple_itr * 2 - 50),
+                   tuple_itr, 0);
+    tile->SetValue(
+        type::ValueFactory::GetBigIntValue(1000000000000 + tuple_itr),
+        tuple_itr, 1);
+  }
+  auto plain_size = tile->GetInlinedSize();
+
+  EXPECT_TRUE(tile->Pack());
+  EXPECT_TRUE(tile->IsPacked());
+  EXPECT_LT(tile->GetInlinedSize(), plain_size / 4);
+
+  // The values are unpacked when they are read
+  std::unique_ptr<storage::Tile> copy(tile->CopyTile(BackendType::MM));
+  EXPECT_FALSE(copy->IsPacked());
+  std::vector<char> tuple(schema.GetLength());
+  for (int tuple_itr = 0; tuple_itr < tuple_count; tuple_itr++) {
+    EXPECT_EQ(tuple_itr * 2 - 50,
+              tile->GetValue(tuple_itr, 0).GetAs<int32_t>());
+    EXPECT_EQ(1000000000000 + tuple_itr,
+              tile->GetValueFast(tuple_itr, schema.GetOffset(1),
+                                 type::Type::BIGINT, true)
+                  .GetAs<int64_t>());
+    EXPECT_EQ(tuple_itr * 2 - 50,
+              copy->GetValue(tuple_itr, 0).GetAs<int32_t>());
+
+    tile->CopyTupleTo(tuple_itr, tuple.data());
+    storage::Tuple plain_tuple(&schema, tuple.data());
+    EXPECT_EQ(1000000000000 + tuple_itr,
+              plain_tuple.GetValue(1).GetAs<int64_t>());
+  }
+
+  // A tile with a varchar column is not packed
+  columns.push_back(catalog::Column(type::Type::VARCHAR, 25, "C", false));
+  catalog::Schema varchar_schema(columns);
+  std::unique_ptr<storage::Tile> varchar_tile(storage::TileFactory::GetTile(
+      BackendType::MM, INVALID_OID, INVALID_OID, INVALID_OID, INVALID_OID,
+      &header, varchar_schema, nullptr, tuple_count));
+  EXPECT_FALSE(varchar_tile->Pack());
+  EXPECT_FALSE(varchar_tile->IsPacked());
+}
+
 }  // End test namespace
 }  // End peloton namespace
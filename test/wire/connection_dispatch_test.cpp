@@ -0,0 +1,156 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// connection_dispatch_test.cpp
+//
+// Identification: test/wire/connection_dispatch_test.cpp
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <set>
+
+#include "common/harness.h"
+#include "gtest/gtest.h"
+#include "common/logger.h"
+#include "wire/libevent_server.h"
+#include "util/string_util.h"
+#include <pqxx/pqxx> /* libpqxx is used to instantiate C++ client */
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Connection Dispatch Tests
+//===--------------------------------------------------------------------===//
+
+class ConnectionDispatchTests : public PelotonTest {};
+
+static void *LaunchServer(peloton::wire::LibeventServer libeventserver,
+                          int port) {
+  try {
+    libeventserver.SetPort(port);
+    libeventserver.StartServer();
+  } catch (peloton::ConnectionException &exception) {
+    LOG_INFO("[LaunchServer] exception in thread");
+  }
+  return NULL;
+}
+
+// Open a connection, and return the worker the server handed it to
+static wire::LibeventWorkerThread *Connect(
+    int port, std::unique_ptr<pqxx::connection> &connection) {
+  connection.reset(new pqxx::connection(StringUtil::Format(
+      "host=127.0.0.1 port=%d user=postgres sslmode=disable", port)));
+  auto conn =
+      wire::LibeventServer::GetConn(wire::LibeventServer::recent_connfd);
+  EXPECT_NE(nullptr, conn);
+  EXPECT_NE(MASTER_THREAD_ID, conn->thread_id);
+  return static_cast<wire::LibeventWorkerThread *>(conn->thread);
+}
+
+/**
+ * The connections go to the worker with the fewest connections, which is not
+ * the next one in round robin order once a connection has been closed
+ */
+TEST_F(ConnectionDispatchTests, LeastLoadedTest) {
+  peloton::PelotonInit::Initialize();
+  FLAGS_connection_dispatch = "least_loaded";
+  peloton::wire::LibeventServer libeventserver;
+  int port = 15723;
+  std::thread serverThread(LaunchServer, libeventserver, port);
+  while (!libeventserver.GetIsStarted()) {
+    sleep(1);
+  }
+
+  try {
+    // one connection per worker
+    size_t num_workers = CONNECTION_THREAD_COUNT;
+    std::vector<std::unique_ptr<pqxx::connection>> connections(num_workers);
+    std::vector<wire::LibeventWorkerThread *> workers;
+    for (auto &connection : connections) {
+      workers.push_back(Connect(port, connection));
+    }
+    std::set<wire::LibeventWorkerThread *> distinct_workers(workers.begin(),
+                                                            workers.end());
+    EXPECT_EQ(num_workers, distinct_workers.size());
+
+    if (num_workers > 1) {
+      // close the connection of the second worker, round robin would give
+      // the next connection to the first one
+      connections[1].reset();
+      for (int retry = 0; retry < 100 && workers[1]->GetLoad() != 0;
+           retry++) {
+        usleep(10000);
+      }
+      EXPECT_EQ(0, workers[1]->GetLoad());
+
+      std::unique_ptr<pqxx::connection> connection;
+      EXPECT_EQ(workers[1], Connect(port, connection));
+      EXPECT_EQ(1, workers[0]->GetLoad());
+      EXPECT_EQ(1, workers[1]->GetLoad());
+    }
+  } catch (const std::exception &e) {
+    LOG_INFO("[LeastLoadedTest] Exception occurred: %s", e.what());
+    EXPECT_TRUE(false);
+  }
+
+  libeventserver.CloseServer();
+  serverThread.join();
+  FLAGS_connection_dispatch = "round_robin";
+  peloton::PelotonInit::Shutdown();
+  LOG_INFO("Peloton has shut down");
+}
+
+/**
+ * Every worker accepts the connections on a listening socket of its own, and
+ * serves them without going through the master
+ */
+TEST_F(ConnectionDispatchTests, ReusePortTest) {
+  peloton::PelotonInit::Initialize();
+  FLAGS_connection_dispatch = "reuseport";
+  peloton::wire::LibeventServer libeventserver;
+  int port = 15723;
+  std::thread serverThread(LaunchServer, libeventserver, port);
+  while (!libeventserver.GetIsStarted()) {
+    sleep(1);
+  }
+
+  try {
+    std::unique_ptr<pqxx::connection> connection;
+    Connect(port, connection);
+    pqxx::work txn1(*connection);
+    txn1.exec("DROP TABLE IF EXISTS dispatch_test;");
+    txn1.exec("CREATE TABLE dispatch_test(id INT);");
+    txn1.commit();
+
+    // the kernel picks the socket, so the spread of the connections over
+    // the workers is not known
+    size_t num_connections = 2 * CONNECTION_THREAD_COUNT;
+    std::vector<std::unique_ptr<pqxx::connection>> connections(
+        num_connections);
+    for (auto &connection : connections) {
+      auto worker = Connect(port, connection);
+      EXPECT_NE(-1, worker->GetListenFd());
+
+      pqxx::work txn(*connection);
+      pqxx::result R = txn.exec("SELECT id FROM dispatch_test;");
+      txn.commit();
+      EXPECT_EQ(0, R.size());
+    }
+  } catch (const std::exception &e) {
+    LOG_INFO("[ReusePortTest] Exception occurred: %s", e.what());
+    EXPECT_TRUE(false);
+  }
+
+  libeventserver.CloseServer();
+  serverThread.join();
+  FLAGS_connection_dispatch = "round_robin";
+  peloton::PelotonInit::Shutdown();
+  LOG_INFO("Peloton has shut down");
+}
+
+}  // End test namespace
+}  // End peloton namespace
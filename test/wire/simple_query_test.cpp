@@ -14,6 +14,7 @@
 #include "gtest/gtest.h"
 #include "common/logger.h"
 #include "wire/libevent_server.h"
+#include "sql/testing_sql_util.h"
 #include "util/string_util.h"
 #include <pqxx/pqxx> /* libpqxx is used to instantiate C++ client */
 
@@ -172,6 +173,114 @@ TEST_F(SimpleQueryTests, SimpleQueryTest) {
   LOG_INFO("Peloton has shut down");
 }
 
+/**
+ * Same as the simple query test, with the statements running on the
+ * execution pool instead of the libevent worker
+ */
+TEST_F(SimpleQueryTests, ExecutionPoolTest) {
+  FLAGS_execution_pool = true;
+  peloton::PelotonInit::Initialize();
+  LOG_INFO("Server initialized");
+  peloton::wire::LibeventServer libeventserver;
+
+  int port = 15722;
+  std::thread serverThread(LaunchServer, libeventserver, port);
+  while (!libeventserver.GetIsStarted()) {
+    sleep(1);
+  }
+
+  SimpleQueryTest(port);
+
+  libeventserver.CloseServer();
+  serverThread.join();
+  peloton::PelotonInit::Shutdown();
+  FLAGS_execution_pool = false;
+  LOG_INFO("Peloton has shut down");
+}
+
+/**
+ * Short statements take the fast lane of the execution pool, and the packets
+ * that don't run a statement stay on the libevent worker. The priority of a
+ * simple query comes from the plans of its statements.
+ */
+TEST_F(SimpleQueryTests, ExecutionPriorityTest) {
+  peloton::PelotonInit::Initialize();
+  TestingSQLUtil::ExecuteSQLQuery(
+      "CREATE TABLE employee(id INT, name VARCHAR(100));");
+  peloton::wire::PacketManager pkt_manager;
+
+  std::string insert_query = "INSERT INTO employee VALUES (1, 'Han LI');";
+  peloton::wire::InputPacket insert_pkt(insert_query.size() + 1,
+                                        insert_query);
+  insert_pkt.msg_type = NetworkMessageType::SIMPLE_QUERY_COMMAND;
+  EXPECT_EQ(TaskPriorityType::HIGH,
+            pkt_manager.GetExecutionPriority(&insert_pkt));
+  // the packet is left for the execution
+  EXPECT_EQ(0u, insert_pkt.ptr);
+
+  std::string select_query = "select name from employee;";
+  peloton::wire::InputPacket select_pkt(select_query.size() + 1,
+                                        select_query);
+  select_pkt.msg_type = NetworkMessageType::SIMPLE_QUERY_COMMAND;
+  EXPECT_EQ(TaskPriorityType::NORMAL,
+            pkt_manager.GetExecutionPriority(&select_pkt));
+
+  // the table has no index, so the update scans it
+  std::string update_query = "UPDATE employee SET name = 'Han' WHERE id = 1;";
+  peloton::wire::InputPacket update_pkt(update_query.size() + 1,
+                                        update_query);
+  update_pkt.msg_type = NetworkMessageType::SIMPLE_QUERY_COMMAND;
+  EXPECT_EQ(TaskPriorityType::NORMAL,
+            pkt_manager.GetExecutionPriority(&update_pkt));
+
+  // joins and aggregations go behind everything else
+  std::string count_query = "select count(*) from employee;";
+  peloton::wire::InputPacket count_pkt(count_query.size() + 1, count_query);
+  count_pkt.msg_type = NetworkMessageType::SIMPLE_QUERY_COMMAND;
+  EXPECT_EQ(TaskPriorityType::LOW,
+            pkt_manager.GetExecutionPriority(&count_pkt));
+
+  std::string join_query =
+      "select a.name from employee a join employee b on a.id = b.id;";
+  peloton::wire::InputPacket join_pkt(join_query.size() + 1, join_query);
+  join_pkt.msg_type = NetworkMessageType::SIMPLE_QUERY_COMMAND;
+  EXPECT_EQ(TaskPriorityType::LOW,
+            pkt_manager.GetExecutionPriority(&join_pkt));
+
+  std::string empty;
+  peloton::wire::InputPacket sync_pkt(0, empty);
+  sync_pkt.msg_type = NetworkMessageType::SYNC_COMMAND;
+  EXPECT_EQ(TaskPriorityType::INVALID,
+            pkt_manager.GetExecutionPriority(&sync_pkt));
+
+  // the insert runs the plan its priority came from
+  EXPECT_EQ(TaskPriorityType::HIGH,
+            pkt_manager.GetExecutionPriority(&insert_pkt));
+  EXPECT_TRUE(pkt_manager.ProcessPacket(&insert_pkt, 0));
+  ASSERT_EQ(2u, pkt_manager.responses.size());
+  EXPECT_EQ(NetworkMessageType::COMMAND_COMPLETE,
+            pkt_manager.responses[0]->msg_type);
+  pkt_manager.responses.clear();
+
+  // the insert can't be planned before the table is created, it is prepared
+  // when it runs
+  std::string create_query =
+      "CREATE TABLE manager(id INT); INSERT INTO manager VALUES (1);";
+  peloton::wire::InputPacket create_pkt(create_query.size() + 1,
+                                        create_query);
+  create_pkt.msg_type = NetworkMessageType::SIMPLE_QUERY_COMMAND;
+  EXPECT_EQ(TaskPriorityType::NORMAL,
+            pkt_manager.GetExecutionPriority(&create_pkt));
+  EXPECT_TRUE(pkt_manager.ProcessPacket(&create_pkt, 0));
+  ASSERT_EQ(3u, pkt_manager.responses.size());
+  EXPECT_EQ(NetworkMessageType::COMMAND_COMPLETE,
+            pkt_manager.responses[0]->msg_type);
+  EXPECT_EQ(NetworkMessageType::COMMAND_COMPLETE,
+            pkt_manager.responses[1]->msg_type);
+
+  peloton::PelotonInit::Shutdown();
+}
+
 ///**
 // * Scalability test
 // * Open 2 servers in threads concurrently
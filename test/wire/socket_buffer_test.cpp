@@ -0,0 +1,300 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// socket_buffer_test.cpp
+//
+// Identification: test/wire/socket_buffer_test.cpp
+//
+// Copyright (c) 2015-17, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "common/harness.h"
+#include "common/logger.h"
+#include "util/string_util.h"
+#include "wire/libevent_server.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Socket Buffer Tests
+//
+// The client speaks the wire protocol over a plain socket, so that the tests
+// decide how the messages are batched into the writes, and where they fall
+// in the read buffer of the server.
+//===--------------------------------------------------------------------===//
+
+class SocketBufferTests : public PelotonTest {};
+
+static void *LaunchServer(peloton::wire::LibeventServer libeventserver,
+                          int port) {
+  try {
+    libeventserver.SetPort(port);
+    libeventserver.StartServer();
+  } catch (peloton::ConnectionException &exception) {
+    LOG_INFO("[LaunchServer] exception in thread");
+  }
+  return NULL;
+}
+
+static void PutInt(std::string &msg, uint32_t value, size_t size) {
+  for (size_t byte_itr = size; byte_itr > 0; byte_itr--) {
+    msg.push_back(static_cast<char>((value >> (8 * (byte_itr - 1))) & 0xff));
+  }
+}
+
+static void PutString(std::string &msg, const std::string &str) {
+  msg += str;
+  msg.push_back('\0');
+}
+
+static std::string Message(char type, const std::string &body) {
+  std::string msg(1, type);
+  PutInt(msg, body.size() + sizeof(int32_t), 4);
+  return msg + body;
+}
+
+static std::string StartupMessage() {
+  std::string body;
+  PutInt(body, 3 << 16, 4);
+  PutString(body, "user");
+  PutString(body, "postgres");
+  body.push_back('\0');
+  std::string msg;
+  PutInt(msg, body.size() + sizeof(int32_t), 4);
+  return msg + body;
+}
+
+static std::string QueryMessage(const std::string &query) {
+  std::string body;
+  PutString(body, query);
+  return Message('Q', body);
+}
+
+// Parse, Bind and Execute the query as the unnamed statement and portal,
+// then Sync
+static std::string ExtendedMessages(const std::string &query,
+                                    bool sync = true) {
+  std::string parse;
+  PutString(parse, "");
+  PutString(parse, query);
+  PutInt(parse, 0, 2);
+
+  std::string bind;
+  PutString(bind, "");
+  PutString(bind, "");
+  PutInt(bind, 0, 2);
+  PutInt(bind, 0, 2);
+  PutInt(bind, 0, 2);
+
+  std::string execute;
+  PutString(execute, "");
+  PutInt(execute, 0, 4);
+
+  std::string msgs =
+      Message('P', parse) + Message('B', bind) + Message('E', execute);
+  return sync ? msgs + Message('S', "") : msgs;
+}
+
+class WireClient {
+ public:
+  WireClient(int port) {
+    socket_fd_ = socket(AF_INET, SOCK_STREAM, 0);
+    struct sockaddr_in addr;
+    PL_MEMSET(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    addr.sin_addr.s_addr = inet_addr("127.0.0.1");
+    connected_ = connect(socket_fd_, reinterpret_cast<struct sockaddr *>(&addr),
+                         sizeof(addr)) == 0;
+
+    // a server that gets stuck fails the test instead of hanging it
+    struct timeval timeout = {30, 0};
+    setsockopt(socket_fd_, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+  }
+
+  ~WireClient() { close(socket_fd_); }
+
+  bool IsConnected() const { return connected_; }
+
+  // Write the bytes in a single write, if the socket takes them
+  bool Send(const std::string &bytes) {
+    size_t written = 0;
+    while (written < bytes.size()) {
+      auto result =
+          write(socket_fd_, bytes.data() + written, bytes.size() - written);
+      if (result <= 0) return false;
+      written += result;
+    }
+    return true;
+  }
+
+  // The types of the messages up to the next ReadyForQuery, the values of
+  // the first column of the data rows are appended to the given vector
+  std::string ReceiveResponses(std::vector<std::string> &values) {
+    std::string types;
+    for (;;) {
+      std::string header;
+      if (Receive(header, 1 + sizeof(int32_t)) == false) return types;
+      size_t len = 0;
+      for (size_t byte_itr = 1; byte_itr < header.size(); byte_itr++) {
+        len = (len << 8) | static_cast<unsigned char>(header[byte_itr]);
+      }
+      std::string body;
+      if (Receive(body, len - sizeof(int32_t)) == false) return types;
+
+      types.push_back(header[0]);
+      if (header[0] == 'D') {
+        // number of columns, then the length of the first one
+        size_t value_len = 0;
+        for (size_t byte_itr = 2; byte_itr < 6; byte_itr++) {
+          value_len =
+              (value_len << 8) | static_cast<unsigned char>(body[byte_itr]);
+        }
+        values.push_back(body.substr(6, value_len));
+      }
+      if (header[0] == 'Z') return types;
+    }
+  }
+
+  std::string ReceiveResponses() {
+    std::vector<std::string> values;
+    return ReceiveResponses(values);
+  }
+
+ private:
+  bool Receive(std::string &bytes, size_t size) {
+    bytes.resize(size);
+    size_t received = 0;
+    while (received < size) {
+      auto result = read(socket_fd_, &bytes[received], size - received);
+      if (result <= 0) return false;
+      received += result;
+    }
+    return true;
+  }
+
+  int socket_fd_;
+
+  bool connected_;
+};
+
+/**
+ * All the statements of a batch are sent in one write. The server runs them
+ * one after the other, and answers them all.
+ */
+void PipelineTest(WireClient &client) {
+  const int batch_size = 100;
+  std::string batch;
+  for (int row_itr = 0; row_itr < batch_size; row_itr++) {
+    batch += ExtendedMessages(StringUtil::Format(
+        "INSERT INTO buffer_test VALUES (%d, 'row %d');", row_itr, row_itr));
+  }
+  // the batch takes a few read buffers
+  EXPECT_LT(2 * SOCKET_BUFFER_SIZE, batch.size());
+  ASSERT_TRUE(client.Send(batch));
+  for (int row_itr = 0; row_itr < batch_size; row_itr++) {
+    EXPECT_EQ("12CZ", client.ReceiveResponses());
+  }
+
+  // three statements with a single Sync, whose responses are all sent with it
+  std::string select_batch;
+  for (int row_itr = 0; row_itr < 3; row_itr++) {
+    select_batch += ExtendedMessages(
+        StringUtil::Format("SELECT name FROM buffer_test WHERE id = %d;",
+                           row_itr * 10),
+        false);
+  }
+  select_batch += Message('S', "");
+  ASSERT_TRUE(client.Send(select_batch));
+  std::vector<std::string> values;
+  EXPECT_EQ("12DC12DC12DCZ", client.ReceiveResponses(values));
+  std::vector<std::string> expected = {"row 0", "row 10", "row 20"};
+  EXPECT_EQ(expected, values);
+}
+
+/**
+ * The header of the second statement starts two bytes before the end of the
+ * read buffer, so the server has to read it in two parts
+ */
+void StraddleTest(WireClient &client) {
+  std::string query = "SELECT name FROM buffer_test WHERE id = 1";
+  auto first = ExtendedMessages(query);
+  // pad the first statement to fill the buffer but for two bytes
+  first = ExtendedMessages(
+      query + std::string(SOCKET_BUFFER_SIZE - 2 - first.size(), ' '));
+  ASSERT_EQ(SOCKET_BUFFER_SIZE - 2, first.size());
+
+  auto second = ExtendedMessages("SELECT name FROM buffer_test WHERE id = 2");
+  ASSERT_TRUE(client.Send(first + second));
+  std::vector<std::string> values;
+  EXPECT_EQ("12DCZ", client.ReceiveResponses(values));
+  EXPECT_EQ("12DCZ", client.ReceiveResponses(values));
+  std::vector<std::string> expected = {"row 1", "row 2"};
+  EXPECT_EQ(expected, values);
+}
+
+/**
+ * The row doesn't fit into the write buffer, so it is written right from the
+ * packet. The query that inserts it doesn't fit into the read buffer either.
+ */
+void LargeRowTest(WireClient &client) {
+  std::string name(3 * SOCKET_BUFFER_SIZE + 1, 'x');
+  ASSERT_TRUE(client.Send(QueryMessage(
+      "INSERT INTO buffer_test VALUES (1000, '" + name + "');")));
+  EXPECT_EQ("CZ", client.ReceiveResponses());
+
+  // in the extended and the simple protocol, behind a short row
+  std::string query = "SELECT name FROM buffer_test WHERE id >= 99 ORDER BY id";
+  ASSERT_TRUE(client.Send(ExtendedMessages(query) + QueryMessage(query)));
+  std::vector<std::string> values;
+  EXPECT_EQ("12DDCZ", client.ReceiveResponses(values));
+  EXPECT_EQ("TDDCZ", client.ReceiveResponses(values));
+  std::vector<std::string> expected = {"row 99", name, "row 99", name};
+  EXPECT_EQ(expected, values);
+}
+
+TEST_F(SocketBufferTests, PipelineTest) {
+  peloton::PelotonInit::Initialize();
+  LOG_INFO("Server initialized");
+  peloton::wire::LibeventServer libeventserver;
+  int port = 15722;
+  std::thread serverThread(LaunchServer, libeventserver, port);
+  while (!libeventserver.GetIsStarted()) {
+    sleep(1);
+  }
+
+  {
+    WireClient client(port);
+    ASSERT_TRUE(client.IsConnected());
+    ASSERT_TRUE(client.Send(StartupMessage()));
+    auto startup_responses = client.ReceiveResponses();
+    EXPECT_EQ('R', startup_responses.front());
+    EXPECT_EQ('Z', startup_responses.back());
+
+    ASSERT_TRUE(client.Send(QueryMessage("DROP TABLE IF EXISTS buffer_test;")));
+    client.ReceiveResponses();
+    ASSERT_TRUE(client.Send(QueryMessage(
+        "CREATE TABLE buffer_test(id INT, name VARCHAR(32768));")));
+    EXPECT_EQ("CZ", client.ReceiveResponses());
+
+    PipelineTest(client);
+    StraddleTest(client);
+    LargeRowTest(client);
+  }
+
+  libeventserver.CloseServer();
+  serverThread.join();
+  peloton::PelotonInit::Shutdown();
+  LOG_INFO("Peloton has shut down");
+}
+
+}  // End test namespace
+}  // End peloton namespace